@@ -0,0 +1,32 @@
+#pragma once
+
+#include <async/concepts.hpp>
+#include <async/tags.hpp>
+
+#include <nanobench.h>
+
+#include <cstddef>
+
+namespace bench {
+// Queue depths used by the scheduler benchmarks.
+constexpr std::size_t queue_sizes[] = {1, 16, 256};
+
+struct sink {
+    using is_receiver = void;
+    int *count;
+
+  private:
+    friend auto tag_invoke(async::set_value_t, sink const &s, auto &&...)
+        -> void {
+        ++*s.count;
+    }
+    friend auto tag_invoke(async::channel_tag auto, sink const &, auto &&...)
+        -> void {}
+};
+
+auto latency() -> void;
+auto scaling(ankerl::nanobench::Bench &b) -> void;
+auto senders(ankerl::nanobench::Bench &b) -> void;
+auto task_manager(ankerl::nanobench::Bench &b) -> void;
+auto timer_manager(ankerl::nanobench::Bench &b) -> void;
+} // namespace bench
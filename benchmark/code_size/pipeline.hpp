@@ -0,0 +1,40 @@
+#pragma once
+
+#include <async/concepts.hpp>
+#include <async/tags.hpp>
+
+#include <utility>
+
+namespace code_size {
+// Written through so that the compiler cannot discard a pipeline's result.
+inline volatile int result{};
+
+struct sink {
+    using is_receiver = void;
+
+  private:
+    friend auto tag_invoke(async::set_value_t, sink const &, auto &&...)
+        -> void {
+        result = 0;
+    }
+    friend auto tag_invoke(async::set_error_t, sink const &, auto &&...)
+        -> void {
+        result = 1;
+    }
+    friend auto tag_invoke(async::set_stopped_t, sink const &) -> void {
+        result = 2;
+    }
+};
+
+template <async::sender S> auto run(S &&s) -> void {
+    auto op = async::connect(std::forward<S>(s), sink{});
+    async::start(op);
+}
+} // namespace code_size
+
+// Each pipeline is its own translation unit that defines:
+//  - async_size_pipeline: connects and starts the pipeline; every text symbol
+//    in the object counts towards the pipeline's code size
+//  - async_size_op_state: an array whose size is the size of the pipeline's
+//    operation state, so that it can be read from the symbol table of a
+//    cross-compiled object
@@ -0,0 +1,18 @@
+#include "../pipeline.hpp"
+
+#include <async/just.hpp>
+#include <async/op_state_size.hpp>
+#include <async/then.hpp>
+
+namespace {
+auto make() {
+    return async::just_error(42) |
+           async::upon_error([](int i) { return i + 1; });
+}
+} // namespace
+
+extern "C" {
+// NOLINTNEXTLINE(*-avoid-c-arrays, *-avoid-non-const-global-variables)
+char async_size_op_state[async::op_state_size_of_v<decltype(make())>];
+auto async_size_pipeline() -> void { code_size::run(make()); }
+}
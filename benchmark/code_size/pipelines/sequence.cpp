@@ -0,0 +1,17 @@
+#include "../pipeline.hpp"
+
+#include <async/just.hpp>
+#include <async/op_state_size.hpp>
+#include <async/sequence.hpp>
+
+namespace {
+auto make() {
+    return async::just() | async::seq(async::just(42));
+}
+} // namespace
+
+extern "C" {
+// NOLINTNEXTLINE(*-avoid-c-arrays, *-avoid-non-const-global-variables)
+char async_size_op_state[async::op_state_size_of_v<decltype(make())>];
+auto async_size_pipeline() -> void { code_size::run(make()); }
+}
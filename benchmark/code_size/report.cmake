@@ -0,0 +1,44 @@
+# Writes a JSON report of the code size and operation state size of each
+# pipeline. Expects:
+#   NM          - the nm for the target toolchain
+#   OBJECT_LIST - a file naming one pipeline object per line
+#   OUTPUT      - the report to write
+#
+# A pipeline's code size is the sum of the sizes of all the text symbols in its
+# object; its operation state size is the size of async_size_op_state.
+
+file(STRINGS "${OBJECT_LIST}" objects)
+list(SORT objects)
+
+set(entries "")
+foreach(object ${objects})
+    get_filename_component(name "${object}" NAME)
+    string(REGEX REPLACE "\\..*$" "" name "${name}")
+
+    execute_process(
+        COMMAND "${NM}" --print-size --radix=d "${object}"
+        OUTPUT_VARIABLE symbols
+        COMMAND_ERROR_IS_FATAL ANY)
+    string(REPLACE "\n" ";" symbols "${symbols}")
+
+    set(text 0)
+    set(op_state 0)
+    foreach(line ${symbols})
+        if(line MATCHES "^[0-9]+ ([0-9]+) ([A-Za-z]) (.+)$")
+            set(type "${CMAKE_MATCH_2}")
+            set(symbol "${CMAKE_MATCH_3}")
+            string(REGEX REPLACE "^0+([0-9])" "\\1" size "${CMAKE_MATCH_1}")
+            if(symbol STREQUAL "async_size_op_state")
+                set(op_state ${size})
+            elseif(type MATCHES "^[TtWw]$")
+                math(EXPR text "${text} + ${size}")
+            endif()
+        endif()
+    endforeach()
+
+    list(APPEND entries
+         "    {\"name\": \"${name}\", \"text\": ${text}, \"op_state\": ${op_state}}")
+endforeach()
+
+list(JOIN entries ",\n" body)
+file(WRITE "${OUTPUT}" "{\n  \"pipelines\": [\n${body}\n  ]\n}\n")
@@ -0,0 +1,21 @@
+// A deep pipeline: 20 let_value adaptors, each of which computes the
+// completion signatures of everything before it.
+#include "../code_size/pipeline.hpp"
+
+#include <async/just.hpp>
+#include <async/let_value.hpp>
+
+namespace {
+template <int N> auto nest(auto s) {
+    if constexpr (N == 0) {
+        return s;
+    } else {
+        return nest<N - 1>(
+            s | async::let_value([](int i) { return async::just(i + 1); }));
+    }
+}
+} // namespace
+
+extern "C" auto async_compile_time_deep() -> void {
+    code_size::run(nest<20>(async::just(0)));
+}
@@ -0,0 +1,21 @@
+// A wide pipeline: when_all of 32 senders, each sending a distinct type, so
+// that every completion signature set is 32 entries long.
+#include "../code_size/pipeline.hpp"
+
+#include <async/just.hpp>
+#include <async/when_all.hpp>
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace {
+template <std::size_t... Is> auto make(std::index_sequence<Is...>) {
+    return async::when_all(
+        async::just(std::integral_constant<std::size_t, Is>{})...);
+}
+} // namespace
+
+extern "C" auto async_compile_time_wide() -> void {
+    code_size::run(make(std::make_index_sequence<32>{}));
+}
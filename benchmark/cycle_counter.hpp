@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+
+#if defined(__x86_64__) or defined(__i386__)
+#include <x86intrin.h>
+#elif not(defined(__ARM_ARCH_PROFILE) and __ARM_ARCH_PROFILE == 'M')
+#include <chrono>
+#endif
+
+namespace bench {
+// A free-running cycle counter: the TSC on x86, and DWT_CYCCNT on an Arm
+// M-profile core (where the DWT must already be enabled, and the count wraps
+// every 2^32 cycles). Elsewhere, it counts nanoseconds of a steady clock.
+struct cycle_counter {
+    using time_point_t = std::uint64_t;
+
+    static auto now() -> time_point_t {
+#if defined(__x86_64__) or defined(__i386__)
+        return __rdtsc();
+#elif defined(__ARM_ARCH_PROFILE) and __ARM_ARCH_PROFILE == 'M'
+        constexpr auto dwt_cyccnt = std::uintptr_t{0xe000'1004};
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast, performance-no-int-to-ptr)
+        return *reinterpret_cast<std::uint32_t const volatile *>(dwt_cyccnt);
+#else
+        return static_cast<time_point_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch())
+                .count());
+#endif
+    }
+};
+} // namespace bench
@@ -0,0 +1,186 @@
+#include "benchmarks.hpp"
+#include "cycle_counter.hpp"
+
+#include <async/schedulers/task_manager.hpp>
+#include <async/schedulers/timer_manager.hpp>
+#include <async/stop_token.hpp>
+
+#include <stdx/functional.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Latencies are measured in cycles of bench::cycle_counter:
+//  - for priority_task_manager, from the call to enqueue_task to the start of
+//    the task
+//  - for generic_timer_manager, from the timer's expiration time to the start
+//    of the task, with the timer interrupt simulated by polling the counter
+//  - for inplace_stop_source, from the call to request_stop to the end of the
+//    last stop callback
+namespace {
+using samples_t = std::vector<std::uint64_t>;
+
+auto report(char const *name, samples_t &samples) -> void {
+    if (samples.empty()) {
+        return;
+    }
+    std::sort(std::begin(samples), std::end(samples));
+    auto const pct = [&](std::size_t p) {
+        return samples[(samples.size() - 1) * p / 100];
+    };
+    std::printf("| %-44s | %8llu | %8llu | %8llu | %8llu |\n", name,
+                static_cast<unsigned long long>(pct(50)),
+                static_cast<unsigned long long>(pct(90)),
+                static_cast<unsigned long long>(pct(99)),
+                static_cast<unsigned long long>(samples.back()));
+    samples.clear();
+}
+
+struct task_hal {
+    static auto schedule(async::priority_t) -> void {}
+};
+
+constexpr auto num_priorities = 8u;
+constexpr auto num_tasks = std::size_t{64};
+constexpr auto rounds = 1'000u;
+
+using task_manager_t = async::priority_task_manager<task_hal, num_priorities>;
+
+auto task_manager_latency() -> void {
+    samples_t samples{};
+    std::vector<std::uint64_t> enqueued(num_tasks);
+
+    auto const make = [&](std::size_t i) {
+        return task_manager_t::create_task([&, i] {
+            samples.push_back(bench::cycle_counter::now() - enqueued[i]);
+        });
+    };
+    using task_t = decltype(make(0));
+    auto tasks = std::vector<std::optional<task_t>>(num_tasks);
+    for (auto i = std::size_t{}; i < num_tasks; ++i) {
+        tasks[i].emplace(stdx::with_result_of{[&] { return make(i); }});
+    }
+
+    auto m = task_manager_t{};
+    auto const enqueue = [&](std::size_t i) {
+        enqueued[i] = bench::cycle_counter::now();
+        m.enqueue_task(*tasks[i],
+                       static_cast<async::priority_t>(i % num_priorities));
+    };
+
+    // uniform: one task at a time, each serviced before the next arrives
+    for (auto r = 0u; r < rounds; ++r) {
+        enqueue(r % num_tasks);
+        m.service_highest();
+    }
+    report("priority_task_manager uniform", samples);
+
+    // bursty: every task arrives at once, then the queues are drained
+    for (auto r = 0u; r < rounds / 10; ++r) {
+        for (auto i = std::size_t{}; i < num_tasks; ++i) {
+            enqueue(i);
+        }
+        while (m.service_highest()) {
+        }
+    }
+    report("priority_task_manager bursty", samples);
+}
+
+struct timer_hal {
+    using time_point_t = bench::cycle_counter::time_point_t;
+    using task_t = async::timer_task<time_point_t>;
+
+    static inline time_point_t next_event{};
+
+    static auto enable() -> void {}
+    static auto disable() -> void {}
+    static auto set_event_time(time_point_t tp) -> void { next_event = tp; }
+    static auto now() -> time_point_t { return bench::cycle_counter::now(); }
+};
+
+using timer_manager_t = async::generic_timer_manager<timer_hal>;
+
+auto timer_manager_latency() -> void {
+    samples_t samples{};
+    std::vector<std::uint64_t> expiry(num_tasks);
+
+    auto const make = [&](std::size_t i) {
+        return timer_manager_t::create_task([&, i] {
+            samples.push_back(bench::cycle_counter::now() - expiry[i]);
+        });
+    };
+    using task_t = decltype(make(0));
+    auto tasks = std::vector<std::optional<task_t>>(num_tasks);
+    for (auto i = std::size_t{}; i < num_tasks; ++i) {
+        tasks[i].emplace(stdx::with_result_of{[&] { return make(i); }});
+    }
+
+    auto m = timer_manager_t{};
+    // Each task i runs after delay(i) cycles; the timer interrupt is
+    // simulated by spinning until the next event and then servicing it.
+    auto const run_profile = [&](char const *name, auto delay) {
+        for (auto r = 0u; r < rounds / 10; ++r) {
+            for (auto i = std::size_t{}; i < num_tasks; ++i) {
+                m.run_after(*tasks[i], delay(i));
+                expiry[i] = tasks[i]->expiration_time;
+            }
+            while (not m.is_idle()) {
+                while (timer_hal::now() < timer_hal::next_event) {
+                }
+                m.service_task();
+            }
+        }
+        report(name, samples);
+    };
+
+    run_profile("generic_timer_manager uniform",
+                [](std::size_t i) { return 2'000 * (i + 1); });
+    run_profile("generic_timer_manager bursty", [](std::size_t i) {
+        return 20'000 * (i / 8 + 1) + 50 * (i % 8);
+    });
+    run_profile("generic_timer_manager equal deadlines",
+                [](std::size_t) { return 20'000u; });
+}
+
+auto stop_source_latency() -> void {
+    samples_t samples{};
+    for (auto const n : bench::queue_sizes) {
+        auto stopped = std::size_t{};
+        auto all_stopped = std::uint64_t{};
+        auto const f = [&] {
+            if (++stopped == n) {
+                all_stopped = bench::cycle_counter::now();
+            }
+        };
+        using callback_t = async::inplace_stop_callback<decltype(f)>;
+
+        for (auto r = 0u; r < rounds; ++r) {
+            async::inplace_stop_source source{};
+            auto callbacks = std::vector<std::optional<callback_t>>(n);
+            for (auto &cb : callbacks) {
+                cb.emplace(source.get_token(), f);
+            }
+            stopped = 0;
+            auto const requested = bench::cycle_counter::now();
+            source.request_stop();
+            samples.push_back(all_stopped - requested);
+        }
+        auto const name = "inplace_stop_source request_stop, " +
+                          std::to_string(n) + " callbacks";
+        report(name.c_str(), samples);
+    }
+}
+} // namespace
+
+auto bench::latency() -> void {
+    std::printf("\n| %-44s | %8s | %8s | %8s | %8s |\n", "latency (cycles)",
+                "p50", "p90", "p99", "max");
+    task_manager_latency();
+    timer_manager_latency();
+    stop_source_latency();
+}
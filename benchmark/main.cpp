@@ -0,0 +1,14 @@
+#include "benchmarks.hpp"
+
+#include <nanobench.h>
+
+auto main() -> int {
+    auto b = ankerl::nanobench::Bench{};
+    b.warmup(100);
+
+    bench::senders(b.title("connect + start"));
+    bench::task_manager(b.title("priority_task_manager"));
+    bench::timer_manager(b.title("generic_timer_manager"));
+    bench::scaling(b.title("scaling with threads"));
+    bench::latency();
+}
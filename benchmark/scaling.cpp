@@ -0,0 +1,169 @@
+#include "benchmarks.hpp"
+
+#include <async/schedulers/runloop_scheduler.hpp>
+#include <async/schedulers/task_manager.hpp>
+#include <async/schedulers/timer_manager.hpp>
+#include <async/stop_token.hpp>
+
+#include <stdx/functional.hpp>
+
+#include <nanobench.h>
+
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+// Thread counts for the scaling curves: each measurement does the same work
+// per thread, so ideal scaling keeps the time per operation constant.
+constexpr int thread_counts[] = {1, 2, 4, 8};
+constexpr auto ops_per_thread = 10'000;
+
+template <typename F> auto on_threads(int n, F const &f) -> void {
+    std::vector<std::thread> threads{};
+    for (auto i = 0; i < n; ++i) {
+        threads.emplace_back(f, i);
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+}
+
+template <typename T, typename F>
+auto make_all(std::size_t n, F &&make) -> std::vector<std::optional<T>> {
+    auto v = std::vector<std::optional<T>>(n);
+    for (auto &x : v) {
+        x.emplace(stdx::with_result_of{make});
+    }
+    return v;
+}
+
+auto name(char const *what, int threads) -> std::string {
+    return std::string{what} + " on " + std::to_string(threads) + " threads";
+}
+
+struct task_hal {
+    static auto schedule(async::priority_t) -> void {}
+};
+using task_manager_t = async::priority_task_manager<task_hal, 8>;
+
+std::atomic<int> ticks{};
+
+struct timer_hal {
+    using time_point_t = int;
+    using task_t = async::timer_task<time_point_t>;
+
+    static auto enable() -> void {}
+    static auto disable() -> void {}
+    static auto set_event_time(time_point_t) -> void {}
+    static auto now() -> time_point_t { return ticks.load(); }
+};
+using timer_manager_t = async::generic_timer_manager<timer_hal>;
+
+// Each thread enqueues its own task and services the queue, so the threads
+// contend only on the task manager.
+auto task_manager(ankerl::nanobench::Bench &b, int n) -> void {
+    auto m = task_manager_t{};
+    std::atomic<int> runs{};
+    auto const f = [&] { ++runs; };
+    auto tasks = make_all<decltype(task_manager_t::create_task(f))>(
+        static_cast<std::size_t>(n),
+        [&] { return task_manager_t::create_task(f); });
+
+    b.batch(n * ops_per_thread)
+        .run(name("priority_task_manager enqueue + service", n), [&] {
+            on_threads(n, [&](int i) {
+                auto &t = *tasks[static_cast<std::size_t>(i)];
+                for (auto j = 0; j < ops_per_thread; ++j) {
+                    m.enqueue_task(t, 0);
+                    m.service_tasks<0>();
+                }
+            });
+        });
+}
+
+auto timer_manager(ankerl::nanobench::Bench &b, int n) -> void {
+    auto m = timer_manager_t{};
+    auto const f = [] {};
+    auto tasks = make_all<decltype(timer_manager_t::create_task(f))>(
+        static_cast<std::size_t>(n),
+        [&] { return timer_manager_t::create_task(f); });
+
+    b.batch(n * ops_per_thread)
+        .run(name("generic_timer_manager run_after + cancel", n), [&] {
+            on_threads(n, [&](int i) {
+                auto &t = *tasks[static_cast<std::size_t>(i)];
+                for (auto j = 0; j < ops_per_thread; ++j) {
+                    m.run_after(t, 1 + i);
+                    m.cancel(t);
+                }
+            });
+        });
+}
+
+auto stop_source(ankerl::nanobench::Bench &b, int n) -> void {
+    async::inplace_stop_source source{};
+    b.batch(n * ops_per_thread)
+        .run(name("inplace_stop_callback register + unregister", n), [&] {
+            on_threads(n, [&](int) {
+                for (auto j = 0; j < ops_per_thread; ++j) {
+                    async::inplace_stop_callback cb{source.get_token(),
+                                                    [] {}};
+                }
+            });
+        });
+}
+
+template <typename RunLoop> struct finish_after {
+    using is_receiver = void;
+    std::atomic<int> *runs;
+    RunLoop *rl;
+    int total;
+
+  private:
+    friend auto tag_invoke(async::set_value_t, finish_after const &r,
+                           auto &&...) -> void {
+        if (++*r.runs == r.total) {
+            r.rl->finish();
+        }
+    }
+    friend auto tag_invoke(async::channel_tag auto, finish_after const &,
+                           auto &&...) -> void {}
+};
+
+// n threads schedule onto one run loop, which runs on its own thread.
+auto run_loop(ankerl::nanobench::Bench &b, int n) -> void {
+    auto const total = n * ops_per_thread;
+    b.batch(total).run(name("run_loop schedule", n), [&] {
+        async::run_loop rl{};
+        std::atomic<int> runs{};
+        auto const r = finish_after<decltype(rl)>{&runs, &rl, total};
+        auto const make = [&] {
+            return async::connect(rl.get_scheduler().schedule(), r);
+        };
+        auto ops = make_all<decltype(make())>(static_cast<std::size_t>(total),
+                                             make);
+        auto consumer = std::thread{[&] { rl.run(); }};
+        on_threads(n, [&](int i) {
+            for (auto j = 0; j < ops_per_thread; ++j) {
+                async::start(*ops[static_cast<std::size_t>(
+                    i * ops_per_thread + j)]);
+            }
+        });
+        consumer.join();
+    });
+}
+} // namespace
+
+auto bench::scaling(ankerl::nanobench::Bench &b) -> void {
+    b.epochs(5).epochIterations(1);
+    for (auto const n : thread_counts) {
+        task_manager(b, n);
+        timer_manager(b, n);
+        stop_source(b, n);
+        run_loop(b, n);
+    }
+}
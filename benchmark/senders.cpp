@@ -0,0 +1,42 @@
+#include "benchmarks.hpp"
+
+#include <async/concepts.hpp>
+#include <async/just.hpp>
+#include <async/repeat.hpp>
+#include <async/split.hpp>
+#include <async/then.hpp>
+#include <async/when_all.hpp>
+#include <async/when_any.hpp>
+
+#include <nanobench.h>
+
+namespace {
+// The sender is made inside the measured loop, so that adaptors which keep
+// state in the sender (like split) are measured from scratch every time.
+template <typename F>
+auto connect_start(ankerl::nanobench::Bench &b, char const *name, F make)
+    -> void {
+    int count{};
+    b.run(name, [&] {
+        auto s = make();
+        auto op = async::connect(s, bench::sink{&count});
+        async::start(op);
+    });
+    ankerl::nanobench::doNotOptimizeAway(count);
+}
+} // namespace
+
+auto bench::senders(ankerl::nanobench::Bench &b) -> void {
+    connect_start(b, "just | then", [] {
+        return async::just(42) | async::then([](int i) { return i + 1; });
+    });
+    connect_start(b, "when_all", [] {
+        return async::when_all(async::just(1), async::just(2), async::just(3));
+    });
+    connect_start(b, "when_any", [] {
+        return async::when_any(async::just(1), async::just(2), async::just(3));
+    });
+    connect_start(b, "split", [] { return async::split(async::just(42)); });
+    connect_start(b, "repeat_n(16)",
+                  [] { return async::just() | async::repeat_n(16); });
+}
@@ -0,0 +1,55 @@
+#include "benchmarks.hpp"
+
+#include <async/schedulers/task_manager.hpp>
+
+#include <stdx/functional.hpp>
+
+#include <nanobench.h>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace {
+struct hal {
+    static auto schedule(async::priority_t) -> void {}
+};
+
+constexpr auto num_priorities = 8u;
+using task_manager_t = async::priority_task_manager<hal, num_priorities>;
+} // namespace
+
+auto bench::task_manager(ankerl::nanobench::Bench &b) -> void {
+    int count{};
+    auto const f = [&] { ++count; };
+    using task_t = decltype(task_manager_t::create_task(f));
+
+    for (auto const n : queue_sizes) {
+        auto m = task_manager_t{};
+        auto tasks = std::vector<std::optional<task_t>>(n);
+        for (auto &t : tasks) {
+            t.emplace(stdx::with_result_of{
+                [&] { return task_manager_t::create_task(f); }});
+        }
+
+        b.batch(n).run("enqueue + service " + std::to_string(n), [&] {
+            for (auto &t : tasks) {
+                m.enqueue_task(*t, 0);
+            }
+            m.service_tasks<0>();
+        });
+
+        b.batch(n).run("enqueue + service_highest " + std::to_string(n) +
+                           " over all priorities",
+                       [&] {
+                           auto p = async::priority_t{};
+                           for (auto &t : tasks) {
+                               m.enqueue_task(*t, p);
+                               p = static_cast<async::priority_t>((p + 1) % num_priorities);
+                           }
+                           while (m.service_highest()) {
+                           }
+                       });
+    }
+    ankerl::nanobench::doNotOptimizeAway(count);
+}
@@ -0,0 +1,68 @@
+#include "benchmarks.hpp"
+
+#include <async/schedulers/timer_manager.hpp>
+
+#include <stdx/functional.hpp>
+
+#include <nanobench.h>
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace {
+struct hal {
+    using time_point_t = int;
+    using task_t = async::timer_task<time_point_t>;
+
+    static auto enable() -> void {}
+    static auto disable() -> void {}
+    static auto set_event_time(time_point_t) -> void {}
+    static auto now() -> time_point_t { return 0; }
+};
+
+using timer_manager_t = async::generic_timer_manager<hal>;
+} // namespace
+
+// Each measurement runs against a queue that already holds n timers, all
+// expiring after the timer being measured.
+auto bench::timer_manager(ankerl::nanobench::Bench &b) -> void {
+    int count{};
+    auto const f = [&] { ++count; };
+    using task_t = decltype(timer_manager_t::create_task(f));
+
+    auto const make = [&] {
+        return stdx::with_result_of{
+            [&] { return timer_manager_t::create_task(f); }};
+    };
+
+    for (auto const n : queue_sizes) {
+        auto m = timer_manager_t{};
+        auto queued = std::vector<std::optional<task_t>>(n);
+        auto d = 1'000;
+        for (auto &t : queued) {
+            t.emplace(make());
+            m.run_after(*t, d++);
+        }
+
+        auto t = std::optional<task_t>{};
+        t.emplace(make());
+        auto const mid = 1'000 + static_cast<int>(n / 2);
+
+        b.batch(1).run("insert + cancel at depth " + std::to_string(n), [&] {
+            m.run_after(*t, mid);
+            m.cancel(*t);
+        });
+
+        b.batch(1).run("insert + service at depth " + std::to_string(n), [&] {
+            m.run_after(*t, 0);
+            m.service_task();
+        });
+
+        for (auto &q : queued) {
+            m.cancel(*q);
+        }
+    }
+    ankerl::nanobench::doNotOptimizeAway(count);
+}
@@ -0,0 +1,325 @@
+#pragma once
+
+#include <async/concepts.hpp>
+#include <async/env.hpp>
+#include <async/stop_token.hpp>
+#include <async/tags.hpp>
+#include <async/type_traits.hpp>
+
+#include <stdx/concepts.hpp>
+#include <stdx/functional.hpp>
+
+#include <boost/mp11/algorithm.hpp>
+#include <boost/mp11/bind.hpp>
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace async {
+namespace _any_sender {
+template <typename Sig> struct channel_fn;
+template <typename Tag, typename... Args> struct channel_fn<Tag(Args...)> {
+    using fn_t = auto (*)(void *, Args...) -> void;
+    fn_t fn;
+
+    template <typename R> constexpr static auto make() -> channel_fn {
+        return {[](void *r, Args... args) -> void {
+            Tag{}(std::move(*static_cast<R *>(r)), std::forward<Args>(args)...);
+        }};
+    }
+};
+
+// One function pointer per completion signature, in flash.
+template <typename... Sigs> struct receiver_vtable : channel_fn<Sigs>... {};
+
+template <typename R, typename... Sigs>
+constexpr inline auto receiver_vtable_for =
+    receiver_vtable<Sigs...>{channel_fn<Sigs>::template make<R>()...};
+
+// Each signature contributes an overload for its channel, so that the usual
+// conversions apply to the arguments that a sender completes with.
+template <typename Self, typename Sig> struct channel;
+template <typename Self, typename Tag, typename... Args>
+struct channel<Self, Tag(Args...)> {
+  private:
+    friend auto tag_invoke(Tag, Self const &self, Args... args) -> void {
+        self.template complete<Tag(Args...)>(std::forward<Args>(args)...);
+    }
+};
+
+template <typename... Sigs>
+constexpr auto accepts_stopped = (std::same_as<Sigs, set_stopped_t()> or ...);
+
+template <typename... Sigs>
+using env_t = std::conditional_t<
+    accepts_stopped<Sigs...>,
+    detail::singleton_env<get_stop_token_t, inplace_stop_token>, empty_env>;
+
+template <typename R>
+constexpr auto stop_token_of(R const &r) -> inplace_stop_token {
+    if constexpr (std::same_as<stop_token_of_t<env_of_t<R>>,
+                               inplace_stop_token>) {
+        return get_stop_token(get_env(r));
+    } else {
+        return {};
+    }
+}
+} // namespace _any_sender
+
+// A non-owning reference to a receiver of any type that accepts Sigs. If Sigs
+// includes set_stopped_t(), its environment answers get_stop_token with an
+// inplace_stop_token (by default, the receiver's own, if it has one). No other
+// query is forwarded through the erasure.
+template <typename... Sigs>
+class any_receiver_ref
+    : public _any_sender::channel<any_receiver_ref<Sigs...>, Sigs>... {
+    using env_t = _any_sender::env_t<Sigs...>;
+
+    void *rcvr;
+    _any_sender::receiver_vtable<Sigs...> const *vtable;
+    [[no_unique_address]] env_t env{};
+
+    [[nodiscard]] friend constexpr auto tag_invoke(get_env_t,
+                                                   any_receiver_ref const &self)
+        -> env_t {
+        return self.env;
+    }
+
+  public:
+    using is_receiver = void;
+
+    template <receiver R>
+        requires(not std::same_as<R, any_receiver_ref>)
+    constexpr explicit(true) any_receiver_ref(R &r)
+        : any_receiver_ref{r, _any_sender::stop_token_of(r)} {}
+
+    template <receiver R>
+        requires(not std::same_as<R, any_receiver_ref>)
+    constexpr any_receiver_ref(R &r, inplace_stop_token token)
+        : rcvr{std::addressof(r)},
+          vtable{std::addressof(_any_sender::receiver_vtable_for<R, Sigs...>)} {
+        if constexpr (_any_sender::accepts_stopped<Sigs...>) {
+            env.value = token;
+        }
+    }
+
+    template <typename Sig, typename... Args>
+    auto complete(Args &&...args) const -> void {
+        static_cast<_any_sender::channel_fn<Sig> const &>(*vtable).fn(
+            rcvr, std::forward<Args>(args)...);
+    }
+};
+
+namespace _any_sender {
+struct op_vtable {
+    auto (*start)(void *) -> void;
+    auto (*destroy)(void *) -> void;
+};
+
+template <typename Op>
+constexpr inline auto op_vtable_for = op_vtable{
+    [](void *op) -> void { async::start(*static_cast<Op *>(op)); },
+    [](void *op) -> void { std::destroy_at(static_cast<Op *>(op)); }};
+
+// A stop token that is not an inplace_stop_token is bridged to one: a stop
+// request on it is passed on to a stop source that the operation owns.
+template <typename Token, bool Forwarded> struct stop_bridge {
+    auto token(Token) -> inplace_stop_token { return {}; }
+    auto start(Token) -> void {}
+};
+
+template <typename Token>
+    requires(not unstoppable_token<Token> and
+             not std::same_as<Token, inplace_stop_token>)
+struct stop_bridge<Token, true> {
+    struct forward_stop_request {
+        auto operator()() -> void { source->request_stop(); }
+        inplace_stop_source *source;
+    };
+
+    auto token(Token) -> inplace_stop_token { return source.get_token(); }
+    auto start(Token t) -> void {
+        cb.emplace(t, forward_stop_request{std::addressof(source)});
+    }
+
+    inplace_stop_source source{};
+    std::optional<stop_callback_for_t<Token, forward_stop_request>> cb{};
+};
+
+template <bool Forwarded> struct stop_bridge<inplace_stop_token, Forwarded> {
+    auto token(inplace_stop_token t) -> inplace_stop_token { return t; }
+    auto start(inplace_stop_token) -> void {}
+};
+
+template <typename Rcvr, std::size_t OpSize, typename... Sigs>
+// NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+struct op_state {
+    template <typename Sndr, stdx::same_as_unqualified<Rcvr> R>
+    op_state(Sndr &&s, R &&r) : rcvr{std::forward<R>(r)} {
+        vtable = std::forward<Sndr>(s).connect_into(
+            storage.data(),
+            any_receiver_ref<Sigs...>{
+                rcvr, bridge.token(get_stop_token(get_env(rcvr)))});
+    }
+    constexpr op_state(op_state &&) = delete;
+    ~op_state() { vtable->destroy(storage.data()); }
+
+    [[no_unique_address]] Rcvr rcvr;
+    [[no_unique_address]] stop_bridge<stop_token_of_t<env_of_t<Rcvr>>,
+                                      accepts_stopped<Sigs...>> bridge{};
+    alignas(std::max_align_t) std::array<std::byte, OpSize> storage{};
+    op_vtable const *vtable{};
+
+  private:
+    template <stdx::same_as_unqualified<op_state> O>
+    friend auto tag_invoke(start_t, O &&o) -> void {
+        o.bridge.start(get_stop_token(get_env(o.rcvr)));
+        o.vtable->start(o.storage.data());
+    }
+};
+
+template <typename Sigs, typename S, typename Env> struct accepts_all_of {
+    template <typename Sig> using fn = boost::mp11::mp_contains<Sigs, Sig>;
+    constexpr static auto value = boost::mp11::mp_all_of_q<
+        completion_signatures_of_t<S, Env>, accepts_all_of>::value;
+};
+
+template <typename... Sigs> struct sender_vtable {
+    using rcvr_t = any_receiver_ref<Sigs...>;
+
+    auto (*copy)(void *, void const *) -> void;
+    auto (*move)(void *, void *) -> void;
+    auto (*destroy)(void *) -> void;
+    auto (*connect_copy)(void const *, void *, rcvr_t) -> op_vtable const *;
+    auto (*connect_move)(void *, void *, rcvr_t) -> op_vtable const *;
+};
+
+template <typename S, typename... Sigs>
+constexpr inline auto sender_vtable_for = [] {
+    using rcvr_t = any_receiver_ref<Sigs...>;
+    using copy_op_t = connect_result_t<S const &, rcvr_t>;
+    using move_op_t = connect_result_t<S, rcvr_t>;
+    return sender_vtable<Sigs...>{
+        [](void *dst, void const *src) -> void {
+            std::construct_at(static_cast<S *>(dst),
+                              *static_cast<S const *>(src));
+        },
+        [](void *dst, void *src) -> void {
+            std::construct_at(static_cast<S *>(dst),
+                              std::move(*static_cast<S *>(src)));
+        },
+        [](void *s) -> void { std::destroy_at(static_cast<S *>(s)); },
+        [](void const *s, void *op, rcvr_t r) -> op_vtable const * {
+            ::new (op) copy_op_t(stdx::with_result_of{
+                [&] { return connect(*static_cast<S const *>(s), r); }});
+            return std::addressof(op_vtable_for<copy_op_t>);
+        },
+        [](void *s, void *op, rcvr_t r) -> op_vtable const * {
+            ::new (op) move_op_t(stdx::with_result_of{
+                [&] { return connect(std::move(*static_cast<S *>(s)), r); }});
+            return std::addressof(op_vtable_for<move_op_t>);
+        }};
+}();
+} // namespace _any_sender
+
+// A sender of any type that completes with (a subset of) Sigs, stored inline
+// in Size bytes. Its operation state is stored inline too, in OpSize bytes,
+// in the operation state that connecting it returns, so nothing is
+// allocated. Both sizes are checked when a sender is erased. The functions
+// that copy, move, destroy and connect the sender, and start and destroy its
+// operation, are dispatched through tables in flash, one per erased type.
+template <std::size_t Size, std::size_t OpSize, typename... Sigs>
+class basic_any_sender {
+    using vtable_t = _any_sender::sender_vtable<Sigs...>;
+    template <typename Op>
+    constexpr static auto fits =
+        sizeof(Op) <= OpSize and alignof(Op) <= alignof(std::max_align_t);
+    template <typename, std::size_t, typename...>
+    friend struct _any_sender::op_state;
+
+    alignas(std::max_align_t) std::array<std::byte, Size> storage{};
+    vtable_t const *vtable;
+
+    auto connect_into(void *op, any_receiver_ref<Sigs...> r) const &
+        -> _any_sender::op_vtable const * {
+        return vtable->connect_copy(storage.data(), op, r);
+    }
+    auto connect_into(void *op, any_receiver_ref<Sigs...> r) &&
+        -> _any_sender::op_vtable const * {
+        return vtable->connect_move(storage.data(), op, r);
+    }
+
+    template <stdx::same_as_unqualified<basic_any_sender> Self, receiver R>
+    [[nodiscard]] friend auto tag_invoke(connect_t, Self &&self, R &&r)
+        -> _any_sender::op_state<std::remove_cvref_t<R>, OpSize, Sigs...> {
+        check_connect<Self, R>();
+        return {std::forward<Self>(self), std::forward<R>(r)};
+    }
+
+  public:
+    using is_sender = void;
+    using completion_signatures = async::completion_signatures<Sigs...>;
+
+    template <sender S>
+        requires(not std::same_as<std::remove_cvref_t<S>, basic_any_sender>)
+    explicit(true) basic_any_sender(S &&s)
+        : vtable{std::addressof(
+              _any_sender::sender_vtable_for<std::remove_cvref_t<S>, Sigs...>)} {
+        using sndr_t = std::remove_cvref_t<S>;
+        using rcvr_t = any_receiver_ref<Sigs...>;
+        static_assert(sizeof(sndr_t) <= Size and
+                          alignof(sndr_t) <= alignof(std::max_align_t),
+                      "The sender does not fit in the any_sender's storage");
+        static_assert(fits<connect_result_t<sndr_t const &, rcvr_t>> and
+                          fits<connect_result_t<sndr_t, rcvr_t>>,
+                      "The sender's operation state does not fit in the "
+                      "any_sender's operation storage");
+        static_assert(std::copy_constructible<sndr_t> and
+                          multishot_sender<sndr_t>,
+                      "An any_sender can only hold a multishot sender");
+        static_assert(
+            _any_sender::accepts_all_of<completion_signatures, sndr_t,
+                                        env_of_t<rcvr_t>>::value,
+            "The sender completes in a way the any_sender does not accept");
+        ::new (storage.data()) sndr_t(std::forward<S>(s));
+    }
+
+    basic_any_sender(basic_any_sender const &other) : vtable{other.vtable} {
+        vtable->copy(storage.data(), other.storage.data());
+    }
+    basic_any_sender(basic_any_sender &&other) noexcept
+        : vtable{other.vtable} {
+        vtable->move(storage.data(), other.storage.data());
+    }
+    auto operator=(basic_any_sender const &other) -> basic_any_sender & {
+        if (this != std::addressof(other)) {
+            vtable->destroy(storage.data());
+            vtable = other.vtable;
+            vtable->copy(storage.data(), other.storage.data());
+        }
+        return *this;
+    }
+    auto operator=(basic_any_sender &&other) noexcept -> basic_any_sender & {
+        if (this != std::addressof(other)) {
+            vtable->destroy(storage.data());
+            vtable = other.vtable;
+            vtable->move(storage.data(), other.storage.data());
+        }
+        return *this;
+    }
+    ~basic_any_sender() { vtable->destroy(storage.data()); }
+};
+
+constexpr inline auto default_any_sender_size = 4 * sizeof(void *);
+constexpr inline auto default_any_op_size = 16 * sizeof(void *);
+
+template <typename... Sigs>
+using any_sender_of =
+    basic_any_sender<default_any_sender_size, default_any_op_size, Sigs...>;
+} // namespace async
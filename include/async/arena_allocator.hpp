@@ -0,0 +1,75 @@
+#pragma once
+
+#include <stdx/bit.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace async {
+// An allocator that bump-allocates out of a buffer provided at runtime. An
+// allocation is a pointer increment; destruct runs the destructor but never
+// gives the memory back. Instead, the whole arena is reset at once when every
+// operation that was allocated in it has completed.
+//
+// Every allocation domain that uses arena_allocator<Arena> shares the arena.
+template <typename Arena> struct arena_allocator {
+  private:
+    static inline std::byte *buffer{};
+    static inline std::size_t capacity{};
+    static inline std::atomic<std::size_t> used{};
+
+    template <typename T> static auto allocate() -> void * {
+        auto const base = stdx::bit_cast<std::uintptr_t>(buffer);
+        auto offset = used.load(std::memory_order_relaxed);
+        std::size_t start{};
+        do {
+            constexpr auto mask = std::uintptr_t{alignof(T) - 1};
+            start = static_cast<std::size_t>(((base + offset + mask) & ~mask) -
+                                             base);
+            if (start + sizeof(T) > capacity) {
+                return nullptr;
+            }
+        } while (not used.compare_exchange_weak(offset, start + sizeof(T),
+                                                std::memory_order_relaxed));
+        return buffer + start;
+    }
+
+  public:
+    // Provide the memory for the arena. This also resets it.
+    static auto set_buffer(std::span<std::byte> b) -> void {
+        buffer = std::data(b);
+        capacity = std::size(b);
+        reset();
+    }
+
+    // Make the whole arena available again. Every object allocated in it
+    // must have been destructed.
+    static auto reset() -> void { used.store(0, std::memory_order_relaxed); }
+
+    [[nodiscard]] static auto bytes_used() -> std::size_t {
+        return used.load(std::memory_order_relaxed);
+    }
+
+    template <typename, typename T, typename F, typename... Args>
+        requires std::is_constructible_v<T, Args...>
+    static auto construct(F &&f, Args &&...args) -> bool {
+        if (auto p = allocate<T>(); p != nullptr) {
+            auto t = std::construct_at(static_cast<T *>(p),
+                                       std::forward<Args>(args)...);
+            std::forward<F>(f)(std::move(*t));
+            return true;
+        }
+        return false;
+    }
+
+    template <typename, typename T> static auto destruct(T const *t) -> void {
+        std::destroy_at(t);
+    }
+};
+} // namespace async
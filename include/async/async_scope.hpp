@@ -0,0 +1,196 @@
+#pragma once
+
+#include <async/allocator.hpp>
+#include <async/concepts.hpp>
+#include <async/env.hpp>
+#include <async/stop_token.hpp>
+#include <async/tags.hpp>
+#include <async/type_traits.hpp>
+
+#include <conc/concurrency.hpp>
+#include <stdx/concepts.hpp>
+#include <stdx/intrusive_list.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace async {
+namespace _async_scope {
+template <typename Ops> struct receiver {
+    using is_receiver = void;
+
+    Ops *ops;
+
+  private:
+    friend auto tag_invoke(channel_tag auto, receiver const &r, auto &&...)
+        -> void {
+        r.ops->die();
+    }
+
+    [[nodiscard]] friend constexpr auto tag_invoke(get_env_t,
+                                                   receiver const &self)
+        -> detail::singleton_env<get_stop_token_t, inplace_stop_token> {
+        return singleton_env<get_stop_token_t>(self.ops->scope->get_token());
+    }
+};
+
+template <typename Uniq, typename Sndr, typename Alloc, typename Scope>
+// NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+struct op_state {
+    using receiver_t = receiver<op_state>;
+    using Ops = connect_result_t<Sndr, receiver_t>;
+
+    template <typename S>
+    constexpr op_state(Scope *sc, S &&s)
+        : scope{sc}, ops{connect(std::forward<S>(s), receiver_t{this})} {}
+    constexpr op_state(op_state &&) = delete;
+
+    auto die() {
+        auto const sc = scope;
+        Alloc::template destruct<Uniq>(this);
+        sc->release();
+    }
+
+    Scope *scope;
+    Ops ops;
+
+  private:
+    template <stdx::same_as_unqualified<op_state> O>
+    friend constexpr auto tag_invoke(start_t, O &&o) -> void {
+        start(std::forward<O>(o).ops);
+    }
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-virtual-class-destructor)
+struct join_base {
+    virtual auto complete() -> void = 0;
+
+    join_base *prev{};
+    join_base *next{};
+};
+
+template <typename Scope, typename Rcvr>
+// NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+struct join_op_state final : join_base {
+    template <stdx::same_as_unqualified<Rcvr> R>
+    constexpr join_op_state(Scope *sc, R &&r)
+        : scope{sc}, rcvr{std::forward<R>(r)} {}
+    constexpr join_op_state(join_op_state &&) = delete;
+
+    auto complete() -> void final { set_value(std::move(rcvr)); }
+
+    Scope *scope;
+    [[no_unique_address]] Rcvr rcvr;
+
+  private:
+    template <stdx::same_as_unqualified<join_op_state> O>
+    friend constexpr auto tag_invoke(start_t, O &&o) -> void {
+        if (o.scope->add_joiner(std::addressof(o))) {
+            return;
+        }
+        std::forward<O>(o).complete();
+    }
+};
+
+template <typename Scope> struct join_sender {
+    using is_sender = void;
+    using completion_signatures = async::completion_signatures<set_value_t()>;
+
+    Scope *scope;
+
+  private:
+    template <stdx::same_as_unqualified<join_sender> Self, receiver R>
+    [[nodiscard]] friend constexpr auto tag_invoke(connect_t, Self &&self,
+                                                   R &&r)
+        -> join_op_state<Scope, std::remove_cvref_t<R>> {
+        check_connect<Self, R>();
+        return {self.scope, std::forward<R>(r)};
+    }
+};
+} // namespace _async_scope
+
+// A counting scope for detached work. Every sender spawned into the scope
+// shares the scope's stop source, so one request_stop cancels all of them.
+// The join sender completes when nothing spawned into the scope is still
+// outstanding.
+class async_scope {
+  public:
+    template <typename Uniq = decltype([] {}), sender S>
+    [[nodiscard]] auto spawn(S &&s) -> bool {
+        using Sndr = std::remove_cvref_t<S>;
+        using A = allocator_of_t<env_of_t<Sndr>>;
+        using O = _async_scope::op_state<Uniq, Sndr, A, async_scope>;
+        outstanding.fetch_add(1, std::memory_order_acq_rel);
+        if (A::template construct<Uniq, O>(
+                [](O &&ops) { async::start(std::move(ops)); }, this,
+                std::forward<S>(s))) {
+            return true;
+        }
+        release();
+        return false;
+    }
+
+    [[nodiscard]] auto join() -> sender auto {
+        return _async_scope::join_sender<async_scope>{this};
+    }
+
+    auto request_stop() -> bool { return stop_src.request_stop(); }
+
+    [[nodiscard]] auto get_stop_source() -> inplace_stop_source & {
+        return stop_src;
+    }
+
+    [[nodiscard]] auto get_token() const -> inplace_stop_token {
+        return stop_src.get_token();
+    }
+
+    [[nodiscard]] auto outstanding_count() const -> std::size_t {
+        return outstanding.load(std::memory_order_acquire);
+    }
+
+  private:
+    template <typename, typename, typename, typename>
+    friend struct _async_scope::op_state;
+    template <typename, typename> friend struct _async_scope::join_op_state;
+
+    struct mutex;
+
+    auto release() -> void {
+        if (outstanding.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+            return;
+        }
+        auto get_next_joiner = [&] {
+            return conc::call_in_critical_section<mutex>(
+                [&]() -> _async_scope::join_base * {
+                    if (outstanding.load(std::memory_order_acquire) != 0 or
+                        joiners.empty()) {
+                        return nullptr;
+                    }
+                    auto j = joiners.pop_front();
+                    j->prev = j->next = nullptr;
+                    return j;
+                });
+        };
+        for (auto j = get_next_joiner(); j != nullptr; j = get_next_joiner()) {
+            j->complete();
+        }
+    }
+
+    auto add_joiner(_async_scope::join_base *j) -> bool {
+        return conc::call_in_critical_section<mutex>([&] {
+            if (outstanding.load(std::memory_order_acquire) == 0) {
+                return false;
+            }
+            joiners.push_back(j);
+            return true;
+        });
+    }
+
+    std::atomic<std::size_t> outstanding{};
+    inplace_stop_source stop_src{};
+    stdx::intrusive_list<_async_scope::join_base> joiners{};
+};
+} // namespace async
@@ -0,0 +1,284 @@
+#pragma once
+
+#include <async/concepts.hpp>
+#include <async/env.hpp>
+#include <async/stop_token.hpp>
+#include <async/tags.hpp>
+#include <async/type_traits.hpp>
+#include <conc/concurrency.hpp>
+
+#include <stdx/concepts.hpp>
+#include <stdx/intrusive_list.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace async {
+namespace _semaphore {
+// NOLINTNEXTLINE(cppcoreguidelines-virtual-class-destructor)
+struct waiter {
+    virtual auto complete() -> void = 0;
+
+    waiter *prev{};
+    waiter *next{};
+    bool linked{};
+    // set if a stop request arrives before the operation is linked, so that
+    // it is not linked afterwards
+    bool stopping{};
+};
+
+enum struct outcome { acquired, waiting, stopped };
+
+template <typename Rcvr, typename F>
+using stop_callback_t =
+    optional_stop_callback_t<stop_token_of_t<env_of_t<Rcvr>>, F>;
+
+template <typename Rcvr> auto stop_requested(Rcvr const &r) -> bool {
+    if constexpr (unstoppable_token<stop_token_of_t<env_of_t<Rcvr>>>) {
+        return false;
+    } else {
+        return get_stop_token(get_env(r)).stop_requested();
+    }
+}
+
+// The number of free permits, or contended when there are none and
+// operations are waiting. While permits are free, acquiring and releasing are
+// each one compare-and-swap. Only a critical section moves the count to or
+// from contended, and the list of waiting operations is changed only in a
+// critical section, so a release never misses a waiter.
+template <typename Uniq> class state {
+    constexpr static std::ptrdiff_t contended = -1;
+
+    struct mutex;
+
+    std::atomic<std::ptrdiff_t> count;
+    stdx::intrusive_list<waiter> waiters{};
+
+    auto try_take(std::ptrdiff_t &c) -> bool {
+        while (c > 0) {
+            if (count.compare_exchange_weak(c, c - 1,
+                                            std::memory_order_acquire,
+                                            std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+  public:
+    constexpr explicit state(std::ptrdiff_t n) : count{n} {}
+
+    // Takes a permit, or links the operation to wait for one, unless a stop
+    // request has already tried to unlink it.
+    auto acquire(waiter &w) -> outcome {
+        auto c = count.load(std::memory_order_relaxed);
+        if (try_take(c)) {
+            return outcome::acquired;
+        }
+        return conc::call_in_critical_section<mutex>([&] {
+            if (w.stopping) {
+                return outcome::stopped;
+            }
+            c = count.load(std::memory_order_relaxed);
+            while (true) {
+                if (try_take(c)) {
+                    return outcome::acquired;
+                }
+                if (count.compare_exchange_weak(c, contended,
+                                                std::memory_order_relaxed)) {
+                    break;
+                }
+            }
+            waiters.push_back(std::addressof(w));
+            w.linked = true;
+            return outcome::waiting;
+        });
+    }
+
+    // A permit is handed straight to the first waiting operation, which is
+    // completed outside the critical section.
+    auto release() -> void {
+        auto c = count.load(std::memory_order_relaxed);
+        while (c != contended) {
+            if (count.compare_exchange_weak(c, c + 1,
+                                            std::memory_order_release,
+                                            std::memory_order_relaxed)) {
+                return;
+            }
+        }
+        auto const w = conc::call_in_critical_section<mutex>([&]() -> waiter * {
+            // the last waiter may have gone since the count was read
+            if (count.load(std::memory_order_relaxed) != contended) {
+                count.fetch_add(1, std::memory_order_release);
+                return nullptr;
+            }
+            auto const first = waiters.pop_front();
+            first->prev = first->next = nullptr;
+            first->linked = false;
+            if (waiters.empty()) {
+                count.store(0, std::memory_order_relaxed);
+            }
+            return first;
+        });
+        if (w != nullptr) {
+            w->complete();
+        }
+    }
+
+    // Returns false if the operation was already given a permit, or is not
+    // yet linked (in which case it will not be).
+    auto unlink(waiter &w) -> bool {
+        return conc::call_in_critical_section<mutex>([&] {
+            if (not w.linked) {
+                w.stopping = true;
+                return false;
+            }
+            waiters.remove(std::addressof(w));
+            w.linked = false;
+            if (waiters.empty()) {
+                count.store(0, std::memory_order_relaxed);
+            }
+            return true;
+        });
+    }
+
+    [[nodiscard]] auto available() const -> std::size_t {
+        auto const c = count.load(std::memory_order_relaxed);
+        return c == contended ? 0 : static_cast<std::size_t>(c);
+    }
+};
+
+template <typename State, typename Rcvr>
+// NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+struct op_state final : waiter {
+    template <stdx::same_as_unqualified<Rcvr> R>
+    constexpr op_state(State *s, R &&r) : st{s}, rcvr{std::forward<R>(r)} {}
+    constexpr op_state(op_state &&) = delete;
+
+    auto complete() -> void override {
+        stop_cb.reset();
+        set_value(std::move(rcvr));
+    }
+
+    struct stop_callback_fn {
+        auto operator()() -> void {
+            if (ops->st->unlink(*ops)) {
+                set_stopped(std::move(ops->rcvr));
+            }
+        }
+        op_state *ops;
+    };
+
+    State *st;
+    [[no_unique_address]] Rcvr rcvr;
+    [[no_unique_address]] stop_callback_t<Rcvr, stop_callback_fn> stop_cb{};
+
+  private:
+    template <stdx::same_as_unqualified<op_state> O>
+    friend constexpr auto tag_invoke(start_t, O &&o) -> void {
+        if (stop_requested(o.rcvr)) {
+            set_stopped(std::forward<O>(o).rcvr);
+            return;
+        }
+        // Once the operation is linked, a release may complete it at once, so
+        // the stop callback is registered first and nothing is touched after.
+        o.stop_cb.emplace(get_stop_token(get_env(o.rcvr)),
+                          stop_callback_fn{std::addressof(o)});
+        switch (o.st->acquire(o)) {
+        case outcome::acquired:
+            o.complete();
+            break;
+        case outcome::stopped:
+            o.stop_cb.reset();
+            set_stopped(std::forward<O>(o).rcvr);
+            break;
+        case outcome::waiting:
+            break;
+        }
+    }
+};
+
+template <typename State> struct sender {
+    using is_sender = void;
+
+    State *st;
+
+  private:
+    template <stdx::same_as_unqualified<sender> S, receiver R>
+    [[nodiscard]] friend constexpr auto tag_invoke(connect_t, S &&s, R &&r)
+        -> op_state<State, std::remove_cvref_t<R>> {
+        check_connect<S, R>();
+        return {s.st, std::forward<R>(r)};
+    }
+
+    template <typename Env>
+    [[nodiscard]] friend constexpr auto
+    tag_invoke(get_completion_signatures_t, sender, Env const &) noexcept
+        -> completion_signatures<set_value_t(), set_stopped_t()> {
+        return {};
+    }
+
+    template <typename Env>
+        requires unstoppable_token<stop_token_of_t<Env>>
+    [[nodiscard]] friend constexpr auto
+    tag_invoke(get_completion_signatures_t, sender, Env const &) noexcept
+        -> completion_signatures<set_value_t()> {
+        return {};
+    }
+};
+} // namespace _semaphore
+
+// A counting semaphore whose acquire() sender completes once it has taken one
+// of N permits, and waits while none is free. Waiting operations are linked
+// into a list in their operation states, so nothing is allocated, and they
+// are served in the order in which they started. release() hands a permit to
+// the first waiting operation and completes it, in the releasing context.
+//
+// Nothing blocks or spins on a lock: with permits free, acquire and release
+// are each one compare-and-swap; under contention, the list of waiting
+// operations is changed in a short critical section.
+template <std::size_t N> class async_semaphore {
+    static_assert(N > 0, "A semaphore must have at least one permit");
+
+    using state_t = _semaphore::state<async_semaphore>;
+    state_t st{static_cast<std::ptrdiff_t>(N)};
+
+  public:
+    async_semaphore() = default;
+    async_semaphore(async_semaphore &&) = delete;
+
+    [[nodiscard]] auto acquire() -> _semaphore::sender<state_t> {
+        return {std::addressof(st)};
+    }
+
+    auto release() -> void { st.release(); }
+
+    [[nodiscard]] auto available() const -> std::size_t {
+        return st.available();
+    }
+};
+
+// A mutex whose lock() sender completes once it holds the lock, and waits
+// while another operation holds it. It is a semaphore with one permit.
+class async_mutex {
+    using state_t = _semaphore::state<async_mutex>;
+    state_t st{1};
+
+  public:
+    async_mutex() = default;
+    async_mutex(async_mutex &&) = delete;
+
+    [[nodiscard]] auto lock() -> _semaphore::sender<state_t> {
+        return {std::addressof(st)};
+    }
+
+    auto unlock() -> void { st.release(); }
+
+    [[nodiscard]] auto is_locked() const -> bool {
+        return st.available() == 0;
+    }
+};
+} // namespace async
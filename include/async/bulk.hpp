@@ -0,0 +1,315 @@
+#pragma once
+
+#include <async/completion_scheduler.hpp>
+#include <async/compose.hpp>
+#include <async/concepts.hpp>
+#include <async/env.hpp>
+#include <async/tags.hpp>
+#include <async/type_traits.hpp>
+
+#include <stdx/concepts.hpp>
+#include <stdx/functional.hpp>
+#include <stdx/type_traits.hpp>
+
+#include <boost/mp11/algorithm.hpp>
+
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace async {
+namespace _bulk {
+struct no_scheduler {};
+
+template <typename S> struct scheduler_of {
+    using type = no_scheduler;
+};
+template <typename S>
+    requires requires(S const &s) {
+        get_completion_scheduler<set_value_t>(get_env(s));
+    }
+struct scheduler_of<S> {
+    using type = std::remove_cvref_t<decltype(get_completion_scheduler<
+                                              set_value_t>(
+        get_env(std::declval<S const &>())))>;
+};
+
+// The work is divided into as many chunks as the scheduler on which the
+// sender completes can run at once, as it reports with a static
+// concurrency(). Without that (or without a completion scheduler), there is
+// one chunk, run where the sender completes.
+template <typename Sched> constexpr auto chunks() -> std::size_t {
+    if constexpr (requires { Sched::concurrency(); }) {
+        return Sched::concurrency();
+    } else {
+        return 1;
+    }
+}
+
+template <typename Sched>
+using schedule_sender_t = decltype(std::declval<Sched &>().schedule());
+
+template <typename Rcvr, typename Shape, typename F> struct seq_receiver {
+    using is_receiver = void;
+
+    [[no_unique_address]] Rcvr r;
+    Shape shape;
+    [[no_unique_address]] F f;
+
+  private:
+    template <stdx::same_as_unqualified<seq_receiver> Self, typename... Args>
+    friend auto tag_invoke(set_value_t, Self &&self, Args &&...args) -> void {
+        for (auto i = Shape{}; i < self.shape; ++i) {
+            std::invoke(self.f, i, args...);
+        }
+        set_value(std::forward<Self>(self).r, std::forward<Args>(args)...);
+    }
+    template <stdx::same_as_unqualified<seq_receiver> Self, typename... Args>
+    friend auto tag_invoke(set_error_t, Self &&self, Args &&...args) -> void {
+        set_error(std::forward<Self>(self).r, std::forward<Args>(args)...);
+    }
+    template <stdx::same_as_unqualified<seq_receiver> Self>
+    friend auto tag_invoke(set_stopped_t, Self &&self) -> void {
+        set_stopped(std::forward<Self>(self).r);
+    }
+
+    [[nodiscard]] friend constexpr auto tag_invoke(async::get_env_t,
+                                                   seq_receiver const &self)
+        -> ::async::detail::forwarding_env<env_of_t<Rcvr>> {
+        return forward_env_of(self.r);
+    }
+};
+
+template <typename Ops> struct receiver {
+    using is_receiver = void;
+
+    Ops *ops;
+
+  private:
+    template <typename... Args>
+    friend auto tag_invoke(set_value_t, receiver const &r, Args &&...args)
+        -> void {
+        r.ops->fork(std::forward<Args>(args)...);
+    }
+    template <typename... Args>
+    friend auto tag_invoke(set_error_t, receiver const &r, Args &&...args)
+        -> void {
+        set_error(std::move(r.ops->rcvr), std::forward<Args>(args)...);
+    }
+    friend auto tag_invoke(set_stopped_t, receiver const &r) -> void {
+        set_stopped(std::move(r.ops->rcvr));
+    }
+
+    [[nodiscard]] friend constexpr auto tag_invoke(async::get_env_t,
+                                                   receiver const &self)
+        -> ::async::detail::forwarding_env<env_of_t<typename Ops::rcvr_t>> {
+        return forward_env_of(self.ops->rcvr);
+    }
+};
+
+template <typename Ops> struct chunk_receiver {
+    using is_receiver = void;
+
+    Ops *ops;
+    std::size_t index;
+
+  private:
+    friend auto tag_invoke(set_value_t, chunk_receiver const &r) -> void {
+        r.ops->run_chunk(r.index);
+    }
+    friend auto tag_invoke(set_stopped_t, chunk_receiver const &r) -> void {
+        r.ops->skip_chunk();
+    }
+
+    [[nodiscard]] friend constexpr auto tag_invoke(async::get_env_t,
+                                                   chunk_receiver const &self)
+        -> ::async::detail::forwarding_env<env_of_t<typename Ops::rcvr_t>> {
+        return forward_env_of(self.ops->rcvr);
+    }
+};
+
+// When the sender completes, its values are stored and one operation per
+// chunk beyond the first is scheduled; the completing context runs the first
+// chunk itself. Whichever chunk finishes last completes the bulk operation.
+template <typename Sndr, typename Rcvr, typename Shape, typename F,
+          typename Sched>
+// NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+struct op_state {
+    using rcvr_t = Rcvr;
+    using receiver_t = receiver<op_state>;
+    using chunk_receiver_t = chunk_receiver<op_state>;
+    constexpr static auto num_chunks = chunks<Sched>();
+
+    template <stdx::same_as_unqualified<Sndr> S,
+              stdx::same_as_unqualified<Rcvr> R>
+    constexpr op_state(S &&s, R &&r, Shape n, F const &fn)
+        : sched{get_completion_scheduler<set_value_t>(get_env(s))},
+          rcvr{std::forward<R>(r)}, shape{n}, f{fn},
+          ops{connect(std::forward<S>(s), receiver_t{this})} {}
+    constexpr op_state(op_state &&) = delete;
+
+    template <typename... Args> auto fork(Args &&...args) -> void {
+        values.template emplace<value_holder<Args...>>(
+            std::forward<Args>(args)...);
+        remaining.store(num_chunks, std::memory_order_relaxed);
+        for (auto i = std::size_t{1}; i < num_chunks; ++i) {
+            auto &op = chunk_ops[i - 1].emplace(stdx::with_result_of{[&] {
+                return connect(sched.schedule(), chunk_receiver_t{this, i});
+            }});
+            start(op);
+        }
+        run_chunk(0);
+    }
+
+    auto run_chunk(std::size_t i) -> void {
+        auto const n = static_cast<std::size_t>(shape);
+        auto const first = n * i / num_chunks;
+        auto const last = n * (i + 1) / num_chunks;
+        std::visit(
+            [&]<typename V>(V &v) {
+                if constexpr (not std::same_as<V, std::monostate>) {
+                    v.apply([&](auto &...args) {
+                        for (auto j = first; j != last; ++j) {
+                            std::invoke(f, static_cast<Shape>(j), args...);
+                        }
+                    });
+                }
+            },
+            values);
+        arrive();
+    }
+
+    auto skip_chunk() -> void {
+        stopped.store(true, std::memory_order_relaxed);
+        arrive();
+    }
+
+    auto arrive() -> void {
+        if (remaining.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+            return;
+        }
+        if (stopped.load(std::memory_order_relaxed)) {
+            set_stopped(std::move(rcvr));
+            return;
+        }
+        std::visit(
+            [&]<typename V>(V &&v) {
+                if constexpr (not std::same_as<std::remove_cvref_t<V>,
+                                               std::monostate>) {
+                    std::forward<V>(v)(std::move(rcvr));
+                }
+            },
+            std::move(values));
+    }
+
+    using values_t = boost::mp11::mp_push_front<
+        value_types_of_t<Sndr, env_of_t<receiver_t>, value_holder,
+                         std::variant>,
+        std::monostate>;
+    using chunk_op_t =
+        connect_result_t<schedule_sender_t<Sched>, chunk_receiver_t>;
+
+    [[no_unique_address]] Sched sched;
+    [[no_unique_address]] Rcvr rcvr;
+    Shape shape;
+    [[no_unique_address]] F f;
+    values_t values{};
+    std::atomic<std::size_t> remaining{};
+    std::atomic<bool> stopped{};
+    std::array<std::optional<chunk_op_t>, num_chunks - 1> chunk_ops{};
+    connect_result_t<Sndr, receiver_t> ops;
+
+  private:
+    template <stdx::same_as_unqualified<op_state> O>
+    friend constexpr auto tag_invoke(start_t, O &&o) -> void {
+        start(std::forward<O>(o).ops);
+    }
+};
+
+template <typename Sndr, typename Shape, typename F> struct sender {
+    using is_sender = void;
+    using sched_t = typename scheduler_of<Sndr>::type;
+
+    [[no_unique_address]] Sndr sndr;
+    Shape shape;
+    [[no_unique_address]] F f;
+
+  private:
+    template <typename Env>
+    [[nodiscard]] friend constexpr auto
+    tag_invoke(get_completion_signatures_t, sender const &, Env const &) {
+        if constexpr (chunks<sched_t>() == 1) {
+            return completion_signatures_of_t<Sndr, Env>{};
+        } else {
+            constexpr auto may_stop = boost::mp11::mp_contains<
+                completion_signatures_of_t<schedule_sender_t<sched_t>, Env>,
+                set_stopped_t()>::value;
+            return transform_completion_signatures_of<
+                Sndr, Env,
+                stdx::conditional_t<may_stop,
+                                    completion_signatures<set_stopped_t()>,
+                                    completion_signatures<>>>{};
+        }
+    }
+
+    [[nodiscard]] friend constexpr auto tag_invoke(async::get_env_t,
+                                                   sender const &self) {
+        return forward_env_of(self.sndr);
+    }
+
+    template <stdx::same_as_unqualified<sender> Self, receiver R>
+    [[nodiscard]] friend constexpr auto tag_invoke(connect_t, Self &&self,
+                                                   R &&r) {
+        check_connect<Self, R>();
+        if constexpr (chunks<sched_t>() == 1) {
+            return connect(
+                std::forward<Self>(self).sndr,
+                seq_receiver<std::remove_cvref_t<R>, Shape, F>{
+                    std::forward<R>(r), self.shape,
+                    std::forward<Self>(self).f});
+        } else {
+            return op_state<Sndr, std::remove_cvref_t<R>, Shape, F, sched_t>{
+                std::forward<Self>(self).sndr, std::forward<R>(r), self.shape,
+                self.f};
+        }
+    }
+};
+
+template <std::integral Shape, typename F> struct pipeable {
+    Shape shape;
+    F f;
+
+  private:
+    template <async::sender S, stdx::same_as_unqualified<pipeable> Self>
+    friend constexpr auto operator|(S &&s, Self &&self) -> async::sender auto {
+        return sender<std::remove_cvref_t<S>, Shape, F>{
+            std::forward<S>(s), self.shape, std::forward<Self>(self).f};
+    }
+};
+} // namespace _bulk
+
+// Calls f(i, values...) for each i in [0, shape) with the values that the
+// sender completes with, then completes with those values. The calls are
+// divided into chunks according to the scheduler on which the sender
+// completes: on a scheduler that runs one thing at a time (or when there is
+// no completion scheduler), they run in order where the sender completes; on
+// one that reports its concurrency, they are spread over that many scheduled
+// operations.
+template <std::integral Shape, typename F>
+[[nodiscard]] constexpr auto bulk(Shape shape, F &&f) {
+    return _compose::adaptor{stdx::tuple{
+        _bulk::pipeable<Shape, std::remove_cvref_t<F>>{shape,
+                                                       std::forward<F>(f)}}};
+}
+
+template <sender S, std::integral Shape, typename F>
+[[nodiscard]] constexpr auto bulk(S &&s, Shape shape, F &&f) -> sender auto {
+    return std::forward<S>(s) | bulk(shape, std::forward<F>(f));
+}
+} // namespace async
@@ -0,0 +1,373 @@
+#pragma once
+
+#include <async/concepts.hpp>
+#include <async/env.hpp>
+#include <async/stop_token.hpp>
+#include <async/tags.hpp>
+#include <async/type_traits.hpp>
+#include <conc/concurrency.hpp>
+
+#include <stdx/concepts.hpp>
+#include <stdx/intrusive_list.hpp>
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace async {
+namespace _channel {
+// NOLINTNEXTLINE(cppcoreguidelines-virtual-class-destructor)
+template <typename T> struct send_waiter {
+    explicit send_waiter(T v) : value{std::move(v)} {}
+
+    virtual auto complete() -> void = 0;
+
+    send_waiter *prev{};
+    send_waiter *next{};
+    bool linked{};
+    // set if a stop request finds the operation not waiting, so that it does
+    // not start waiting afterwards
+    bool stopping{};
+    T value;
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-virtual-class-destructor)
+template <typename T> struct receive_waiter {
+    virtual auto complete() -> void = 0;
+
+    receive_waiter *prev{};
+    receive_waiter *next{};
+    bool linked{};
+    bool stopping{};
+    std::optional<T> value{};
+};
+
+enum struct outcome { done, waiting, stopped };
+
+template <typename Rcvr, typename F>
+using stop_callback_t =
+    optional_stop_callback_t<stop_token_of_t<env_of_t<Rcvr>>, F>;
+
+template <typename Rcvr> auto stop_requested(Rcvr const &r) -> bool {
+    if constexpr (unstoppable_token<stop_token_of_t<env_of_t<Rcvr>>>) {
+        return false;
+    } else {
+        return get_stop_token(get_env(r)).stop_requested();
+    }
+}
+
+template <typename Chan, typename Rcvr>
+// NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+struct send_op_state final : send_waiter<typename Chan::value_type> {
+    using value_type = typename Chan::value_type;
+
+    template <stdx::same_as_unqualified<Rcvr> R>
+    constexpr send_op_state(Chan *c, R &&r, value_type v)
+        : send_waiter<value_type>{std::move(v)}, chan{c},
+          rcvr{std::forward<R>(r)} {}
+    constexpr send_op_state(send_op_state &&) = delete;
+
+    auto complete() -> void override {
+        stop_cb.reset();
+        set_value(std::move(rcvr));
+    }
+
+    struct stop_callback_fn {
+        auto operator()() -> void {
+            if (ops->chan->unlink(*ops)) {
+                set_stopped(std::move(ops->rcvr));
+            }
+        }
+        send_op_state *ops;
+    };
+
+    Chan *chan;
+    [[no_unique_address]] Rcvr rcvr;
+    [[no_unique_address]] stop_callback_t<Rcvr, stop_callback_fn> stop_cb{};
+
+  private:
+    template <stdx::same_as_unqualified<send_op_state> O>
+    friend constexpr auto tag_invoke(start_t, O &&o) -> void {
+        if (stop_requested(o.rcvr)) {
+            set_stopped(std::forward<O>(o).rcvr);
+            return;
+        }
+        // Once the operation is linked, another operation may complete it at
+        // once, so the stop callback is registered first and nothing is
+        // touched after.
+        o.stop_cb.emplace(get_stop_token(get_env(o.rcvr)),
+                          stop_callback_fn{std::addressof(o)});
+        switch (o.chan->start_send(o)) {
+        case outcome::done:
+            o.complete();
+            break;
+        case outcome::stopped:
+            o.stop_cb.reset();
+            set_stopped(std::forward<O>(o).rcvr);
+            break;
+        case outcome::waiting:
+            break;
+        }
+    }
+};
+
+template <typename Chan, typename Rcvr>
+// NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+struct receive_op_state final : receive_waiter<typename Chan::value_type> {
+    template <stdx::same_as_unqualified<Rcvr> R>
+    constexpr receive_op_state(Chan *c, R &&r)
+        : chan{c}, rcvr{std::forward<R>(r)} {}
+    constexpr receive_op_state(receive_op_state &&) = delete;
+
+    auto complete() -> void override {
+        stop_cb.reset();
+        set_value(std::move(rcvr), std::move(*this->value));
+    }
+
+    struct stop_callback_fn {
+        auto operator()() -> void {
+            if (ops->chan->unlink(*ops)) {
+                set_stopped(std::move(ops->rcvr));
+            }
+        }
+        receive_op_state *ops;
+    };
+
+    Chan *chan;
+    [[no_unique_address]] Rcvr rcvr;
+    [[no_unique_address]] stop_callback_t<Rcvr, stop_callback_fn> stop_cb{};
+
+  private:
+    template <stdx::same_as_unqualified<receive_op_state> O>
+    friend constexpr auto tag_invoke(start_t, O &&o) -> void {
+        if (stop_requested(o.rcvr)) {
+            set_stopped(std::forward<O>(o).rcvr);
+            return;
+        }
+        // Once the operation is linked, another operation may complete it at
+        // once, so the stop callback is registered first and nothing is
+        // touched after.
+        o.stop_cb.emplace(get_stop_token(get_env(o.rcvr)),
+                          stop_callback_fn{std::addressof(o)});
+        switch (o.chan->start_receive(o)) {
+        case outcome::done:
+            o.complete();
+            break;
+        case outcome::stopped:
+            o.stop_cb.reset();
+            set_stopped(std::forward<O>(o).rcvr);
+            break;
+        case outcome::waiting:
+            break;
+        }
+    }
+};
+
+template <typename Chan, typename... Vs> struct sender_base {
+    using is_sender = void;
+
+  private:
+    template <typename Env>
+    [[nodiscard]] friend constexpr auto
+    tag_invoke(get_completion_signatures_t, sender_base, Env const &) noexcept
+        -> completion_signatures<set_value_t(Vs...), set_stopped_t()> {
+        return {};
+    }
+
+    template <typename Env>
+        requires unstoppable_token<stop_token_of_t<Env>>
+    [[nodiscard]] friend constexpr auto
+    tag_invoke(get_completion_signatures_t, sender_base, Env const &) noexcept
+        -> completion_signatures<set_value_t(Vs...)> {
+        return {};
+    }
+};
+
+template <typename Chan> struct send_sender : sender_base<Chan> {
+    Chan *chan;
+    typename Chan::value_type value;
+
+  private:
+    template <stdx::same_as_unqualified<send_sender> S, receiver R>
+    [[nodiscard]] friend constexpr auto tag_invoke(connect_t, S &&s, R &&r)
+        -> send_op_state<Chan, std::remove_cvref_t<R>> {
+        check_connect<S, R>();
+        return {s.chan, std::forward<R>(r), std::forward<S>(s).value};
+    }
+};
+
+template <typename Chan>
+struct receive_sender : sender_base<Chan, typename Chan::value_type> {
+    Chan *chan;
+
+  private:
+    template <stdx::same_as_unqualified<receive_sender> S, receiver R>
+    [[nodiscard]] friend constexpr auto tag_invoke(connect_t, S &&s, R &&r)
+        -> receive_op_state<Chan, std::remove_cvref_t<R>> {
+        check_connect<S, R>();
+        return {s.chan, std::forward<R>(r)};
+    }
+};
+} // namespace _channel
+
+// A fixed-capacity queue of values between sender pipelines, for instance
+// from an interrupt handler to a task at a background priority. send(v)
+// completes once v is in the queue, and waits while the queue is full;
+// receive() completes with the oldest value, and waits while the queue is
+// empty. A waiting operation is completed by whichever operation unblocks it,
+// in that operation's context. Senders and receivers are each served in the
+// order in which they started.
+//
+// The queue and the lists of waiting operations are updated together in one
+// short critical section, so that no wakeup is lost; operations are completed
+// outside it.
+template <typename T, std::size_t N> class channel {
+    static_assert(N > 0, "A channel must have space for at least one value");
+
+  public:
+    using value_type = T;
+
+  private:
+    template <typename, typename> friend struct _channel::send_op_state;
+    template <typename, typename> friend struct _channel::receive_op_state;
+
+    using send_waiter_t = _channel::send_waiter<T>;
+    using receive_waiter_t = _channel::receive_waiter<T>;
+
+    struct mutex;
+
+    std::array<std::optional<T>, N> ring{};
+    std::size_t head{};
+    std::size_t count{};
+    stdx::intrusive_list<send_waiter_t> senders{};
+    stdx::intrusive_list<receive_waiter_t> receivers{};
+
+    auto push(T &&v) -> void {
+        ring[(head + count) % N].emplace(std::move(v));
+        ++count;
+    }
+
+    auto pop() -> T {
+        auto &slot = ring[head];
+        auto v = std::move(*slot);
+        slot.reset();
+        head = (head + 1) % N;
+        --count;
+        return v;
+    }
+
+    template <typename W>
+    static auto take_first(stdx::intrusive_list<W> &list) -> W * {
+        if (list.empty()) {
+            return nullptr;
+        }
+        auto const w = list.pop_front();
+        w->prev = w->next = nullptr;
+        w->linked = false;
+        return w;
+    }
+
+    // Returns done if the value was queued or handed straight to a waiting
+    // receiver (which is then completed); waiting if the sender must wait;
+    // stopped if a stop request came first.
+    auto start_send(send_waiter_t &s) -> _channel::outcome {
+        auto const [o, r] = conc::call_in_critical_section<mutex>(
+            [&]() -> std::pair<_channel::outcome, receive_waiter_t *> {
+                if (s.stopping) {
+                    return {_channel::outcome::stopped, nullptr};
+                }
+                if (auto const w = take_first(receivers); w != nullptr) {
+                    w->value.emplace(std::move(s.value));
+                    return {_channel::outcome::done, w};
+                }
+                if (count < N) {
+                    push(std::move(s.value));
+                    return {_channel::outcome::done, nullptr};
+                }
+                senders.push_back(std::addressof(s));
+                s.linked = true;
+                return {_channel::outcome::waiting, nullptr};
+            });
+        if (r != nullptr) {
+            r->complete();
+        }
+        return o;
+    }
+
+    // Returns done if a value was taken (a sender waiting for space is then
+    // completed); waiting if the receiver must wait; stopped if a stop
+    // request came first.
+    auto start_receive(receive_waiter_t &r) -> _channel::outcome {
+        auto const [o, s] = conc::call_in_critical_section<mutex>(
+            [&]() -> std::pair<_channel::outcome, send_waiter_t *> {
+                if (r.stopping) {
+                    return {_channel::outcome::stopped, nullptr};
+                }
+                if (count == 0) {
+                    receivers.push_back(std::addressof(r));
+                    r.linked = true;
+                    return {_channel::outcome::waiting, nullptr};
+                }
+                r.value.emplace(pop());
+                auto const w = take_first(senders);
+                if (w != nullptr) {
+                    push(std::move(w->value));
+                }
+                return {_channel::outcome::done, w};
+            });
+        if (s != nullptr) {
+            s->complete();
+        }
+        return o;
+    }
+
+    // Returns false if the operation was already taken from the list, or is
+    // not yet linked (in which case it will not be).
+    auto unlink(send_waiter_t &w) -> bool {
+        return conc::call_in_critical_section<mutex>([&] {
+            if (not w.linked) {
+                w.stopping = true;
+                return false;
+            }
+            senders.remove(std::addressof(w));
+            w.linked = false;
+            return true;
+        });
+    }
+
+    auto unlink(receive_waiter_t &w) -> bool {
+        return conc::call_in_critical_section<mutex>([&] {
+            if (not w.linked) {
+                w.stopping = true;
+                return false;
+            }
+            receivers.remove(std::addressof(w));
+            w.linked = false;
+            return true;
+        });
+    }
+
+  public:
+    channel() = default;
+    channel(channel &&) = delete;
+
+    [[nodiscard]] auto send(T v) -> _channel::send_sender<channel> {
+        return {{}, this, std::move(v)};
+    }
+
+    [[nodiscard]] auto receive() -> _channel::receive_sender<channel> {
+        return {{}, this};
+    }
+
+    [[nodiscard]] auto size() const -> std::size_t {
+        return conc::call_in_critical_section<mutex>([&] { return count; });
+    }
+
+    [[nodiscard]] constexpr static auto capacity() -> std::size_t {
+        return N;
+    }
+};
+} // namespace async
@@ -23,6 +23,12 @@ concept operation_state =
         { start(std::move(o)) } -> std::same_as<void>;
     };
 
+template <typename O>
+concept restartable_operation = operation_state<O> and requires(O &o) {
+    { restart(o) } -> std::same_as<void>;
+    { start(o) } -> std::same_as<void>;
+};
+
 namespace detail {
 template <typename T>
 concept movable_value = std::move_constructible<std::remove_cvref_t<T>> and
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <async/concepts.hpp>
+#include <async/schedulers/inline_scheduler.hpp>
+#include <async/tags.hpp>
+#include <async/type_traits.hpp>
+
+#include <stdx/concepts.hpp>
+#include <stdx/tuple.hpp>
+
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace async {
+namespace _constexpr_wait {
+struct env {
+    [[nodiscard]] friend constexpr auto tag_invoke(get_scheduler_t,
+                                                   env) noexcept
+        -> inline_scheduler {
+        return {};
+    }
+};
+
+template <typename V> struct receiver {
+    using is_receiver = void;
+
+    V *values;
+    bool *done;
+
+  private:
+    template <typename... Args>
+    friend constexpr auto tag_invoke(set_value_t, receiver const &r,
+                                     Args &&...args) -> void {
+        r.values->emplace(stdx::make_tuple(std::forward<Args>(args)...));
+        *r.done = true;
+    }
+    friend constexpr auto tag_invoke(set_error_t, receiver const &r, auto &&...)
+        -> void {
+        *r.done = true;
+    }
+    friend constexpr auto tag_invoke(set_stopped_t, receiver const &r)
+        -> void {
+        *r.done = true;
+    }
+
+    [[nodiscard]] friend constexpr auto tag_invoke(get_env_t,
+                                                   receiver const &) noexcept
+        -> env {
+        return {};
+    }
+};
+
+namespace detail {
+template <typename... Ts>
+using decayed_tuple = stdx::tuple<std::remove_cvref_t<Ts>...>;
+
+template <sender_in<env> S>
+using wait_type = value_types_of_t<S, env, decayed_tuple, std::optional>;
+} // namespace detail
+
+// Called (and so failing constant evaluation) when a sender has not completed
+// by the time start returns: there is no loop to drive it to completion.
+inline auto sender_did_not_complete_inline() -> void {}
+
+template <sender S> constexpr auto wait(S &&s) {
+    using V = detail::wait_type<S>;
+    V values{};
+    bool done{};
+
+    auto op_state =
+        connect(std::forward<S>(s), receiver<V>{std::addressof(values),
+                                                std::addressof(done)});
+    start(op_state);
+    if (std::is_constant_evaluated() and not done) {
+        sender_did_not_complete_inline();
+    }
+    return values;
+}
+
+struct pipeable {
+  private:
+    template <async::sender S, stdx::same_as_unqualified<pipeable> Self>
+    friend constexpr auto operator|(S &&s, Self &&) {
+        return wait(std::forward<S>(s));
+    }
+};
+} // namespace _constexpr_wait
+
+// Like sync_wait, but for senders that complete inline: there is no run loop,
+// so the whole pipeline can be evaluated at compile time.
+template <sender S> [[nodiscard]] constexpr auto constexpr_wait(S &&s) {
+    return _constexpr_wait::wait(std::forward<S>(s));
+}
+
+[[nodiscard]] constexpr auto constexpr_wait() -> _constexpr_wait::pipeable {
+    return {};
+}
+} // namespace async
@@ -1,30 +1,119 @@
 #pragma once
 
+#include <async/completion_scheduler.hpp>
 #include <async/concepts.hpp>
+#include <async/env.hpp>
 #include <async/just.hpp>
 #include <async/let_value.hpp>
 #include <async/start_on.hpp>
+#include <async/tags.hpp>
+#include <async/variant_sender.hpp>
 
 #include <stdx/concepts.hpp>
 
+#include <concepts>
 #include <type_traits>
 #include <utility>
 
 namespace async {
 namespace _continue_on {
+template <typename S>
+using completion_scheduler_t = std::remove_cvref_t<decltype(
+    get_completion_scheduler<set_value_t>(get_env(std::declval<S>())))>;
+
+template <typename S, typename Sched>
+concept completes_on_same_type = requires {
+    typename completion_scheduler_t<S>;
+} and std::same_as<completion_scheduler_t<S>, Sched>;
+
+// A hop to a scheduler that the sender already completes on is only skipped if
+// the scheduler says that being on it is all a hop achieves. A time_scheduler
+// hop is a delay and a priority scheduler hop is a yield, so they do not.
+template <typename Sched>
+concept elides_redundant_hops =
+    requires { typename Sched::elides_redundant_hops; };
+
+// A named type rather than a lambda, so that the scheduler hopped to is part
+// of the sender's type (see scheduler_hops.hpp).
+template <typename Sched> struct hop_fn {
+    template <typename... Args> constexpr auto operator()(Args &&...args) {
+        return start_on(sched, async::just(std::forward<Args>(args)...));
+    }
+
+    Sched sched;
+};
+
+template <typename S, typename Sched>
+using hop_t = decltype(std::declval<S>() |
+                       let_value(std::declval<hop_fn<Sched>>()));
+
+// The hop completes on the target scheduler, and its environment says so, so
+// that a later continue_on compares against where the values really are.
+template <typename S, typename Sched> struct hop_sender {
+    using is_sender = void;
+    [[no_unique_address]] S s;
+    [[no_unique_address]] Sched sched;
+
+  private:
+    template <typename Self>
+    constexpr static auto make_hop(Self &&self) -> sender auto {
+        return std::forward<Self>(self).s |
+               let_value(hop_fn<Sched>{std::forward<Self>(self).sched});
+    }
+
+    template <stdx::same_as_unqualified<hop_sender> Self, receiver R>
+    [[nodiscard]] friend constexpr auto tag_invoke(connect_t, Self &&self,
+                                                   R &&r) {
+        check_connect<Self, R>();
+        return connect(make_hop(std::forward<Self>(self)), std::forward<R>(r));
+    }
+
+    [[nodiscard]] friend constexpr auto tag_invoke(get_env_t,
+                                                   hop_sender const &self) {
+        return override_env_with<get_completion_scheduler_t<set_value_t>>(
+            self.sched, self.s);
+    }
+
+    template <typename Env>
+    [[nodiscard]] friend constexpr auto
+    tag_invoke(get_completion_signatures_t, hop_sender const &, Env const &)
+        -> completion_signatures_of_t<hop_t<S, Sched>, Env> {
+        return {};
+    }
+};
+
+template <typename S, typename Sched>
+constexpr auto hop(S &&s, Sched &&sched) -> sender auto {
+    return hop_sender<std::remove_cvref_t<S>, std::remove_cvref_t<Sched>>{
+        std::forward<S>(s), std::forward<Sched>(sched)};
+}
+
+// A sender that already completes on the target scheduler needs no hop, if
+// the scheduler elides redundant hops. When its completion scheduler has the
+// target's type and that type has no state, the two are the same scheduler,
+// and the sender is passed through; when the type has state, the schedulers
+// are compared when the sender is composed.
 template <typename Sched> struct pipeable {
     Sched sched;
 
   private:
     template <async::sender S, stdx::same_as_unqualified<pipeable> Self>
     friend constexpr auto operator|(S &&s, Self &&self) -> async::sender auto {
-        return std::forward<S>(s) |
-               let_value([sch =
-                              std::forward<Self>(self).sched]<typename... Args>(
-                             Args &&...args) mutable {
-                   return start_on(sch,
-                                   async::just(std::forward<Args>(args)...));
-               });
+        if constexpr (not elides_redundant_hops<Sched> or
+                      not completes_on_same_type<S, Sched>) {
+            return hop(std::forward<S>(s), std::forward<Self>(self).sched);
+        } else if constexpr (std::is_empty_v<Sched>) {
+            return std::forward<S>(s);
+        } else {
+            auto const here =
+                get_completion_scheduler<set_value_t>(get_env(s)) == self.sched;
+            return make_variant_sender(
+                here, [&] { return std::forward<S>(s); },
+                [&] {
+                    return hop(std::forward<S>(s),
+                               std::forward<Self>(self).sched);
+                });
+        }
     }
 };
 } // namespace _continue_on
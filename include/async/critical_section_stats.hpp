@@ -0,0 +1,121 @@
+#pragma once
+
+#include <async/schedulers/task_manager_instrumentation.hpp>
+
+#include <stdx/ct_conversions.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <utility>
+
+namespace async {
+// Time spent inside the critical sections of one mutex tag, in ticks of the
+// clock.
+struct critical_section_stats {
+    std::string_view tag{};
+    std::uint32_t count{};
+    std::uint64_t total{};
+    std::uint64_t max{};
+
+    constexpr auto record(std::uint64_t ticks) -> void {
+        ++count;
+        total += ticks;
+        if (ticks > max) {
+            max = ticks;
+        }
+    }
+};
+
+// A concurrency policy that wraps another and measures, for each distinct
+// mutex tag, how long its critical sections last. Every lock in this library
+// (task managers, timer managers, stop sources, run loops, when_any) goes
+// through conc::call_in_critical_section, so injecting this policy in place of
+// the usual one accounts for all of them:
+//
+//   template <> inline auto conc::injected_policy<> =
+//       async::timed_concurrency_policy<my_policy, my_clock>{};
+//
+// The time is measured from inside the wrapped policy's critical section, so
+// it excludes the cost of entering and leaving. Each tag's statistics are
+// updated inside that tag's own critical section; a tag is added to the list
+// that for_each walks, lock-free, the first time it is used.
+template <typename Policy, detail::clock_hal Clock>
+struct timed_concurrency_policy {
+  private:
+    struct node {
+        critical_section_stats stats{};
+        node *next{};
+        bool linked{};
+    };
+
+    static inline Policy base{};
+    static inline std::atomic<node *> head{};
+
+    template <typename Mutex> static inline node tag_node{};
+
+    template <typename Mutex> static auto get_node() -> node & {
+        auto &n = tag_node<Mutex>;
+        if (not n.linked) {
+            n.linked = true;
+            n.stats.tag = stdx::type_as_string<Mutex>();
+            n.next = head.load(std::memory_order_relaxed);
+            while (not head.compare_exchange_weak(n.next, std::addressof(n),
+                                                  std::memory_order_release,
+                                                  std::memory_order_relaxed)) {
+            }
+        }
+        return n;
+    }
+
+    template <typename Mutex> struct timer {
+        typename Clock::time_point_t start{Clock::now()};
+
+        timer() = default;
+        timer(timer &&) = delete;
+        ~timer() {
+            get_node<Mutex>().stats.record(
+                detail::to_ticks(Clock::now() - start));
+        }
+    };
+
+  public:
+    template <typename Mutex = void, typename F, typename... Pred>
+    static auto call_in_critical_section(F &&f, Pred &&...pred)
+        -> decltype(auto) {
+        return base.template call_in_critical_section<Mutex>(
+            [&]() -> decltype(auto) {
+                [[maybe_unused]] auto const t = timer<Mutex>{};
+                return std::forward<F>(f)();
+            },
+            std::forward<Pred>(pred)...);
+    }
+
+    // The statistics of one tag. A tag that has not been used yet reads as
+    // all zero.
+    template <typename Mutex>
+    [[nodiscard]] static auto stats() -> critical_section_stats const & {
+        return tag_node<Mutex>.stats;
+    }
+
+    // Calls f with the statistics of each tag that has been used, most
+    // recently added first. Reading while critical sections run may see a
+    // partly updated entry.
+    template <typename F> static auto for_each(F &&f) -> void {
+        for (auto n = head.load(std::memory_order_acquire); n != nullptr;
+             n = n->next) {
+            f(std::as_const(n->stats));
+        }
+    }
+
+    // Resets the statistics of every tag, for instance between test phases.
+    // No critical section may be running.
+    static auto reset() -> void {
+        for (auto n = head.load(std::memory_order_acquire); n != nullptr;
+             n = n->next) {
+            n->stats = {n->stats.tag, 0, 0, 0};
+        }
+    }
+};
+} // namespace async
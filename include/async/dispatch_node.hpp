@@ -0,0 +1,29 @@
+#pragma once
+
+namespace async {
+// The base of an intrusively linked node (a task or a run loop operation) that
+// is run through one function pointer given by its most derived type, rather
+// than through a vtable. Each kind of node costs no vtable in flash, and
+// dispatching a node takes one load and one indirect call.
+class dispatch_node {
+  public:
+    using fn_t = auto (*)(dispatch_node &) -> void;
+
+    constexpr explicit(true) dispatch_node(fn_t f) : fn{f} {}
+
+    auto dispatch() -> void { fn(*this); }
+
+  private:
+    fn_t fn;
+};
+
+// The function with which a node of type T is dispatched: it calls F on the
+// node as a T.
+template <typename T, auto F>
+constexpr inline dispatch_node::fn_t dispatch_to =
+    [](dispatch_node &n) -> void { (static_cast<T &>(n).*F)(); };
+
+// The function with which a node that needs no dispatch (a sentinel) is
+// dispatched.
+constexpr inline dispatch_node::fn_t dispatch_nothing = [](dispatch_node &) {};
+} // namespace async
@@ -0,0 +1,340 @@
+#pragma once
+
+#include <async/concepts.hpp>
+#include <async/env.hpp>
+#include <async/stop_token.hpp>
+#include <async/tags.hpp>
+#include <async/type_traits.hpp>
+#include <conc/concurrency.hpp>
+
+#include <stdx/concepts.hpp>
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace async {
+// What a DMA HAL calls when a transfer finishes, typically from the DMA
+// interrupt. It must call exactly one of these once for each transfer it
+// starts, unless the transfer is aborted.
+// NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+struct dma_completion {
+    virtual auto transfer_complete(std::size_t bytes) -> void = 0;
+    virtual auto transfer_error() -> void = 0;
+    virtual ~dma_completion() = default;
+};
+
+struct dma_error {
+    friend constexpr auto operator==(dma_error, dma_error) -> bool = default;
+};
+
+namespace detail {
+template <typename T>
+concept dma_hal = requires(typename T::channel_t ch, std::span<std::byte> buf,
+                           dma_completion &c) {
+    { T::start_transfer(ch, buf, c) } -> std::same_as<void>;
+    { T::abort_transfer(ch) } -> std::same_as<bool>;
+};
+} // namespace detail
+
+namespace archetypes {
+struct dma_hal {
+    using channel_t = int;
+
+    static auto start_transfer(channel_t, std::span<std::byte>,
+                               dma_completion &) -> void {}
+    // Returns true if the transfer was aborted before it finished; the HAL
+    // then does not report it. Returns false if the completion has been or
+    // will be reported (but not from within abort_transfer).
+    static auto abort_transfer(channel_t) -> bool { return true; }
+};
+} // namespace archetypes
+static_assert(detail::dma_hal<archetypes::dma_hal>);
+
+namespace _dma {
+template <typename Rcvr, typename F>
+using stop_callback_t =
+    optional_stop_callback_t<stop_token_of_t<env_of_t<Rcvr>>, F>;
+
+template <typename Rcvr> auto stop_requested(Rcvr const &r) -> bool {
+    if constexpr (unstoppable_token<stop_token_of_t<env_of_t<Rcvr>>>) {
+        return false;
+    } else {
+        return get_stop_token(get_env(r)).stop_requested();
+    }
+}
+
+template <typename H, typename Rcvr>
+// NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+struct op_state final : dma_completion {
+    using channel_t = typename H::channel_t;
+
+    template <stdx::same_as_unqualified<Rcvr> R>
+    // NOLINTNEXTLINE(bugprone-forwarding-reference-overload)
+    constexpr op_state(R &&r, channel_t ch, std::span<std::byte> b)
+        : rcvr{std::forward<R>(r)}, channel{ch}, buffer{b} {}
+    constexpr op_state(op_state &&) = delete;
+
+    // The receiver is completed as an lvalue, so that the operation can be
+    // restarted.
+    auto transfer_complete(std::size_t bytes) -> void override {
+        set_value(rcvr, buffer.first(bytes));
+    }
+    auto transfer_error() -> void override { set_error(rcvr, dma_error{}); }
+
+    struct stop_callback_fn {
+        auto operator()() -> void {
+            if (H::abort_transfer(ops->channel)) {
+                set_stopped(ops->rcvr);
+            }
+        }
+        op_state *ops;
+    };
+
+    [[no_unique_address]] Rcvr rcvr;
+    channel_t channel;
+    std::span<std::byte> buffer;
+    [[no_unique_address]] stop_callback_t<Rcvr, stop_callback_fn> stop_cb{};
+
+  private:
+    template <stdx::same_as_unqualified<op_state> O>
+    friend constexpr auto tag_invoke(start_t, O &&o) -> void {
+        if (stop_requested(o.rcvr)) {
+            set_stopped(std::forward<O>(o).rcvr);
+            return;
+        }
+        H::start_transfer(o.channel, o.buffer, o);
+        if constexpr (not unstoppable_token<
+                          stop_token_of_t<env_of_t<Rcvr>>>) {
+            o.stop_cb.emplace(get_stop_token(get_env(o.rcvr)),
+                              stop_callback_fn{std::addressof(o)});
+        }
+    }
+
+    friend constexpr auto tag_invoke(restart_t, op_state &o) -> void {
+        o.stop_cb.reset();
+    }
+};
+
+// Alternates between two buffers. When a transfer into one buffer completes
+// and the receiver is waiting for it, the next transfer is started into the
+// other buffer before the receiver is completed, so the hardware fills one
+// buffer while the receiver works on the other. The receiver owns the buffer
+// it was sent until the operation is started again. If a transfer completes
+// while the receiver still owns the other buffer, no transfer is started
+// until it is done with it.
+template <typename H, typename Rcvr>
+// NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+struct double_buffer_op_state final : dma_completion {
+    using channel_t = typename H::channel_t;
+
+    template <stdx::same_as_unqualified<Rcvr> R>
+    // NOLINTNEXTLINE(bugprone-forwarding-reference-overload)
+    constexpr double_buffer_op_state(R &&r, channel_t ch,
+                                     std::array<std::span<std::byte>, 2> bs)
+        : rcvr{std::forward<R>(r)}, channel{ch}, buffers{bs} {}
+    constexpr double_buffer_op_state(double_buffer_op_state &&) = delete;
+
+    ~double_buffer_op_state() override {
+        if (in_flight) {
+            H::abort_transfer(channel);
+        }
+    }
+
+    struct mutex;
+
+    struct completed {
+        std::uint8_t index{};
+        std::optional<std::size_t> bytes{};
+    };
+
+    // Called within the critical section: claims the next buffer to fill
+    // if no transfer is in flight.
+    auto claim() -> std::optional<std::uint8_t> {
+        if (in_flight) {
+            return std::nullopt;
+        }
+        in_flight = true;
+        filling = next;
+        next ^= 1u;
+        return filling;
+    }
+
+    auto begin(std::optional<std::uint8_t> idx) -> void {
+        if (idx) {
+            H::start_transfer(channel, buffers[*idx], *this);
+        }
+    }
+
+    auto deliver(completed c) -> void {
+        if (c.bytes) {
+            set_value(rcvr, buffers[c.index].first(*c.bytes));
+        } else {
+            set_error(rcvr, dma_error{});
+        }
+    }
+
+    // A transfer that completes while the receiver still owns the other
+    // buffer is kept until the operation is started again.
+    auto finish(std::optional<std::size_t> bytes) -> void {
+        auto const c = completed{filling, bytes};
+        auto const [deliver_now, idx] =
+            conc::call_in_critical_section<mutex>([&] {
+                in_flight = false;
+                if (not std::exchange(waiting, false)) {
+                    ready = c;
+                    return std::pair{false, std::optional<std::uint8_t>{}};
+                }
+                return std::pair{true, bytes ? claim()
+                                             : std::optional<std::uint8_t>{}};
+            });
+        if (deliver_now) {
+            begin(idx);
+            deliver(c);
+        }
+    }
+
+    auto transfer_complete(std::size_t bytes) -> void override {
+        finish(bytes);
+    }
+    auto transfer_error() -> void override { finish(std::nullopt); }
+
+    struct stop_callback_fn {
+        auto operator()() -> void {
+            // Once the receiver has been sent a buffer, the transfer in
+            // flight belongs to the next start and is left alone.
+            auto const stopped = conc::call_in_critical_section<mutex>([&] {
+                if (not ops->waiting or not H::abort_transfer(ops->channel)) {
+                    return false;
+                }
+                ops->in_flight = false;
+                ops->waiting = false;
+                return true;
+            });
+            if (stopped) {
+                set_stopped(ops->rcvr);
+            }
+        }
+        double_buffer_op_state *ops;
+    };
+
+    [[no_unique_address]] Rcvr rcvr;
+    channel_t channel;
+    std::array<std::span<std::byte>, 2> buffers;
+    [[no_unique_address]] stop_callback_t<Rcvr, stop_callback_fn> stop_cb{};
+    std::optional<completed> ready{};
+    std::uint8_t filling{};
+    std::uint8_t next{};
+    bool in_flight{};
+    bool waiting{};
+
+  private:
+    template <stdx::same_as_unqualified<double_buffer_op_state> O>
+    friend constexpr auto tag_invoke(start_t, O &&o) -> void {
+        if (stop_requested(o.rcvr)) {
+            set_stopped(std::forward<O>(o).rcvr);
+            return;
+        }
+
+        // starting again releases the buffer the receiver was sent; after
+        // an error, no further transfer is started until the next start
+        auto const [c, idx] = conc::call_in_critical_section<mutex>([&] {
+            auto r = std::exchange(o.ready, std::nullopt);
+            o.waiting = not r;
+            auto const i = r and not r->bytes ? std::optional<std::uint8_t>{}
+                                              : o.claim();
+            return std::pair{r, i};
+        });
+        o.begin(idx);
+        if (c) {
+            o.deliver(*c);
+        } else if constexpr (not unstoppable_token<
+                                 stop_token_of_t<env_of_t<Rcvr>>>) {
+            o.stop_cb.emplace(get_stop_token(get_env(o.rcvr)),
+                              stop_callback_fn{std::addressof(o)});
+        }
+    }
+
+    friend constexpr auto tag_invoke(restart_t, double_buffer_op_state &o)
+        -> void {
+        o.stop_cb.reset();
+    }
+};
+
+template <typename H> struct sender_base {
+    using is_sender = void;
+
+  private:
+    template <typename Env>
+    [[nodiscard]] friend constexpr auto
+    tag_invoke(get_completion_signatures_t, sender_base, Env const &) noexcept
+        -> completion_signatures<set_value_t(std::span<std::byte>),
+                                 set_error_t(dma_error), set_stopped_t()> {
+        return {};
+    }
+
+    template <typename Env>
+        requires unstoppable_token<stop_token_of_t<Env>>
+    [[nodiscard]] friend constexpr auto
+    tag_invoke(get_completion_signatures_t, sender_base, Env const &) noexcept
+        -> completion_signatures<set_value_t(std::span<std::byte>),
+                                 set_error_t(dma_error)> {
+        return {};
+    }
+};
+
+template <typename H> struct sender : sender_base<H> {
+    typename H::channel_t channel;
+    std::span<std::byte> buffer;
+
+  private:
+    template <stdx::same_as_unqualified<sender> S, receiver R>
+    [[nodiscard]] friend constexpr auto tag_invoke(connect_t, S &&s, R &&r)
+        -> op_state<H, std::remove_cvref_t<R>> {
+        check_connect<S, R>();
+        return {std::forward<R>(r), s.channel, s.buffer};
+    }
+};
+
+template <typename H> struct double_buffer_sender : sender_base<H> {
+    typename H::channel_t channel;
+    std::array<std::span<std::byte>, 2> buffers;
+
+  private:
+    template <stdx::same_as_unqualified<double_buffer_sender> S, receiver R>
+    [[nodiscard]] friend constexpr auto tag_invoke(connect_t, S &&s, R &&r)
+        -> double_buffer_op_state<H, std::remove_cvref_t<R>> {
+        check_connect<S, R>();
+        return {std::forward<R>(r), s.channel, s.buffers};
+    }
+};
+} // namespace _dma
+
+// Transfers into (or out of) a buffer with the DMA HAL H, and completes with
+// the part of the buffer that was transferred: the data is not copied. The
+// operation state is restartable, so repeat runs it again without
+// reconnecting.
+template <detail::dma_hal H>
+[[nodiscard]] constexpr auto dma_transfer(typename H::channel_t channel,
+                                          std::span<std::byte> buffer)
+    -> _dma::sender<H> {
+    return {{}, channel, buffer};
+}
+
+// Transfers into two buffers in turn, starting the next transfer before
+// completing with the last one. Used with repeat, each iteration is sent the
+// next buffer while the hardware fills the other.
+template <detail::dma_hal H>
+[[nodiscard]] constexpr auto dma_transfer(typename H::channel_t channel,
+                                          std::span<std::byte> front,
+                                          std::span<std::byte> back)
+    -> _dma::double_buffer_sender<H> {
+    return {{}, channel, {front, back}};
+}
+} // namespace async
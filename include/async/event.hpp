@@ -0,0 +1,311 @@
+#pragma once
+
+#include <async/concepts.hpp>
+#include <async/env.hpp>
+#include <async/stop_token.hpp>
+#include <async/tags.hpp>
+#include <async/type_traits.hpp>
+#include <conc/concurrency.hpp>
+
+#include <stdx/concepts.hpp>
+
+#include <atomic>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace async {
+namespace _event {
+// NOLINTNEXTLINE(cppcoreguidelines-virtual-class-destructor)
+struct waiter {
+    virtual auto complete() -> void = 0;
+
+    waiter *next{};
+    // set if a stop request finds the operation not waiting, so that it does
+    // not start waiting afterwards
+    bool stopping{};
+};
+
+enum struct outcome { set, waiting, stopped };
+
+struct set_link final : waiter {
+    auto complete() -> void final {}
+};
+inline constinit set_link set_sentinel{};
+
+// Completing an operation may end its lifetime, so the next link is read
+// first.
+inline auto complete_all(waiter *w) -> void {
+    while (w != nullptr) {
+        auto const next = w->next;
+        w->complete();
+        w = next;
+    }
+}
+
+// The head of a lock-free stack of waiting operations, or a sentinel when the
+// event is set. Waiting is a push; setting takes the whole stack with one
+// atomic operation and completes it. An auto-reset event consumes the set
+// state: setting it with operations waiting completes them and leaves it
+// unset, and a wait that finds it set unsets it.
+template <bool AutoReset> class state {
+    struct mutex;
+
+    std::atomic<waiter *> head{};
+
+    // Pushes a chain of waiters. Returns false if the event is set (which an
+    // auto-reset event then consumes), and the chain must be completed.
+    auto try_push(waiter *first, waiter *last) -> bool {
+        auto h = head.load(std::memory_order_acquire);
+        while (true) {
+            if (h == std::addressof(set_sentinel)) {
+                if (AutoReset and
+                    not head.compare_exchange_weak(h, nullptr,
+                                                   std::memory_order_acq_rel,
+                                                   std::memory_order_acquire)) {
+                    continue;
+                }
+                return false;
+            }
+            last->next = h;
+            if (head.compare_exchange_weak(h, first, std::memory_order_acq_rel,
+                                           std::memory_order_acquire)) {
+                return true;
+            }
+        }
+    }
+
+  public:
+    // Returns false if the event is set, so the operation need not wait.
+    auto wait(waiter &w) -> bool {
+        w.next = nullptr;
+        return try_push(std::addressof(w), std::addressof(w));
+    }
+
+    // As wait, for an operation with a stop callback. The push is serialized
+    // with unlink, so a stop request that comes first is not missed.
+    auto wait_stoppable(waiter &w) -> outcome {
+        return conc::call_in_critical_section<mutex>([&] {
+            if (w.stopping) {
+                return outcome::stopped;
+            }
+            return wait(w) ? outcome::waiting : outcome::set;
+        });
+    }
+
+    auto set() -> void {
+        if constexpr (AutoReset) {
+            auto h = head.load(std::memory_order_acquire);
+            while (h != std::addressof(set_sentinel)) {
+                auto const next =
+                    h == nullptr ? std::addressof(set_sentinel) : nullptr;
+                if (head.compare_exchange_weak(h, next,
+                                               std::memory_order_acq_rel,
+                                               std::memory_order_acquire)) {
+                    complete_all(h);
+                    return;
+                }
+            }
+        } else {
+            complete_all(head.exchange(std::addressof(set_sentinel),
+                                       std::memory_order_acq_rel));
+        }
+    }
+
+    auto reset() -> void {
+        auto h = std::addressof(set_sentinel);
+        head.compare_exchange_strong(h, nullptr, std::memory_order_acq_rel,
+                                     std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] auto is_set() const -> bool {
+        return head.load(std::memory_order_acquire) ==
+               std::addressof(set_sentinel);
+    }
+
+    // A waiter cannot be taken from the middle of a lock-free stack, so a
+    // stop request takes the whole stack, removes its operation, and pushes
+    // the rest back (or completes them, if the event was set meanwhile).
+    // Stop requests are serialized with one another, and with stoppable
+    // waits, in a critical section; setting is not. Returns false if the
+    // operation was already taken by set(), or is not yet waiting (in which
+    // case it will not wait).
+    auto unlink(waiter &w) -> bool {
+        auto const [found, rest] = conc::call_in_critical_section<mutex>(
+            [&]() -> std::pair<bool, waiter *> {
+                auto h = head.load(std::memory_order_acquire);
+                do {
+                    if (h == std::addressof(set_sentinel) or h == nullptr) {
+                        w.stopping = true;
+                        return {false, nullptr};
+                    }
+                } while (not head.compare_exchange_weak(
+                    h, nullptr, std::memory_order_acq_rel,
+                    std::memory_order_acquire));
+
+                auto removed = false;
+                waiter *first{};
+                waiter *last{};
+                for (auto p = h; p != nullptr;) {
+                    auto const next = p->next;
+                    if (p == std::addressof(w)) {
+                        removed = true;
+                    } else {
+                        p->next = nullptr;
+                        (last == nullptr ? first : last->next) = p;
+                        last = p;
+                    }
+                    p = next;
+                }
+                w.stopping = not removed;
+                if (first != nullptr and not try_push(first, last)) {
+                    return {removed, first};
+                }
+                return {removed, nullptr};
+            });
+        complete_all(rest);
+        return found;
+    }
+};
+
+template <typename Rcvr, typename F>
+using stop_callback_t =
+    optional_stop_callback_t<stop_token_of_t<env_of_t<Rcvr>>, F>;
+
+template <typename Rcvr> auto stop_requested(Rcvr const &r) -> bool {
+    if constexpr (unstoppable_token<stop_token_of_t<env_of_t<Rcvr>>>) {
+        return false;
+    } else {
+        return get_stop_token(get_env(r)).stop_requested();
+    }
+}
+
+template <typename State, typename Rcvr>
+// NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+struct op_state final : waiter {
+    template <stdx::same_as_unqualified<Rcvr> R>
+    constexpr op_state(State *s, R &&r) : st{s}, rcvr{std::forward<R>(r)} {}
+    constexpr op_state(op_state &&) = delete;
+
+    auto complete() -> void override {
+        stop_cb.reset();
+        set_value(std::move(rcvr));
+    }
+
+    struct stop_callback_fn {
+        auto operator()() -> void {
+            if (ops->st->unlink(*ops)) {
+                set_stopped(std::move(ops->rcvr));
+            }
+        }
+        op_state *ops;
+    };
+
+    State *st;
+    [[no_unique_address]] Rcvr rcvr;
+    [[no_unique_address]] stop_callback_t<Rcvr, stop_callback_fn> stop_cb{};
+
+  private:
+    template <stdx::same_as_unqualified<op_state> O>
+    friend constexpr auto tag_invoke(start_t, O &&o) -> void {
+        if (stop_requested(o.rcvr)) {
+            set_stopped(std::forward<O>(o).rcvr);
+            return;
+        }
+        if constexpr (unstoppable_token<stop_token_of_t<env_of_t<Rcvr>>>) {
+            if (not o.st->wait(o)) {
+                set_value(std::forward<O>(o).rcvr);
+            }
+        } else {
+            // Once the operation is waiting, a set may complete it at once, so
+            // the stop callback is registered first and nothing is touched
+            // after.
+            o.stop_cb.emplace(get_stop_token(get_env(o.rcvr)),
+                              stop_callback_fn{std::addressof(o)});
+            switch (o.st->wait_stoppable(o)) {
+            case outcome::set:
+                o.complete();
+                break;
+            case outcome::stopped:
+                o.stop_cb.reset();
+                set_stopped(std::forward<O>(o).rcvr);
+                break;
+            case outcome::waiting:
+                break;
+            }
+        }
+    }
+};
+
+template <typename State> struct sender {
+    using is_sender = void;
+
+    State *st;
+
+  private:
+    template <stdx::same_as_unqualified<sender> S, receiver R>
+    [[nodiscard]] friend constexpr auto tag_invoke(connect_t, S &&s, R &&r)
+        -> op_state<State, std::remove_cvref_t<R>> {
+        check_connect<S, R>();
+        return {s.st, std::forward<R>(r)};
+    }
+
+    template <typename Env>
+    [[nodiscard]] friend constexpr auto
+    tag_invoke(get_completion_signatures_t, sender, Env const &) noexcept
+        -> completion_signatures<set_value_t(), set_stopped_t()> {
+        return {};
+    }
+
+    template <typename Env>
+        requires unstoppable_token<stop_token_of_t<Env>>
+    [[nodiscard]] friend constexpr auto
+    tag_invoke(get_completion_signatures_t, sender, Env const &) noexcept
+        -> completion_signatures<set_value_t()> {
+        return {};
+    }
+};
+} // namespace _event
+
+// An event whose wait() sender completes once the event is set. set()
+// completes every waiting operation in one pass, in the setting context, and
+// the event stays set (so that a later wait completes at once) until reset().
+// Waiting operations are linked into a stack in their operation states, so
+// nothing is allocated, and waiting, setting and resetting are each one
+// atomic operation (a wait that can be stopped also takes a critical section).
+class manual_reset_event {
+    using state_t = _event::state<false>;
+    state_t st{};
+
+  public:
+    manual_reset_event() = default;
+    manual_reset_event(manual_reset_event &&) = delete;
+
+    [[nodiscard]] auto wait() -> _event::sender<state_t> {
+        return {std::addressof(st)};
+    }
+
+    auto set() -> void { st.set(); }
+    auto reset() -> void { st.reset(); }
+    [[nodiscard]] auto is_set() const -> bool { return st.is_set(); }
+};
+
+// An event that resets itself. set() completes every waiting operation and
+// leaves the event unset; with no operation waiting, the event stays set
+// until the next wait(), which completes at once and unsets it.
+class auto_reset_event {
+    using state_t = _event::state<true>;
+    state_t st{};
+
+  public:
+    auto_reset_event() = default;
+    auto_reset_event(auto_reset_event &&) = delete;
+
+    [[nodiscard]] auto wait() -> _event::sender<state_t> {
+        return {std::addressof(st)};
+    }
+
+    auto set() -> void { st.set(); }
+    [[nodiscard]] auto is_set() const -> bool { return st.is_set(); }
+};
+} // namespace async
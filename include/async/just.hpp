@@ -33,6 +33,11 @@ template <typename Tag, typename R, typename... Vs> struct op_state {
             Tag{}(std::forward<O>(o).receiver, std::forward<Ts>(ts)...);
         });
     }
+
+    // starting as an lvalue copies the values, so there is nothing to reset
+    friend constexpr auto tag_invoke(restart_t, op_state &) -> void
+        requires(... and std::copy_constructible<Vs>)
+    {}
 };
 
 template <typename Tag, typename... Vs> struct sender {
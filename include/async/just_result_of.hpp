@@ -13,7 +13,11 @@
 #include <boost/mp11/algorithm.hpp>
 #include <boost/mp11/list.hpp>
 
+#include <atomic>
 #include <concepts>
+#include <cstdint>
+#include <functional>
+#include <optional>
 #include <type_traits>
 #include <utility>
 
@@ -89,6 +93,109 @@ template <typename Tag, std::invocable... Fs> class sender : public Fs... {
 };
 } // namespace _just_result_of
 
+namespace _memoized_result_of {
+template <typename Memo, typename R> struct op_state {
+    Memo *memo;
+    [[no_unique_address]] R receiver;
+
+  private:
+    template <stdx::same_as_unqualified<op_state> O>
+    friend auto tag_invoke(start_t, O &&o) -> void {
+        o.memo->complete(std::forward<O>(o).receiver);
+    }
+
+    // the cache outlives the operation, so there is nothing to reset
+    friend constexpr auto tag_invoke(restart_t, op_state &) -> void {}
+};
+
+template <typename Memo> struct sender {
+    using is_sender = void;
+    using completion_signatures =
+        async::completion_signatures<set_value_t(typename Memo::value_type)>;
+
+    Memo *memo;
+
+  private:
+    class env {
+        [[nodiscard]] friend constexpr auto tag_invoke(get_allocator_t,
+                                                       env) noexcept
+            -> stack_allocator {
+            return {};
+        }
+    };
+
+    template <stdx::same_as_unqualified<sender> Self, receiver R>
+    [[nodiscard]] friend constexpr auto tag_invoke(connect_t, Self &&self,
+                                                   R &&r)
+        -> op_state<Memo, std::remove_cvref_t<R>> {
+        check_connect<Self, R>();
+        return {self.memo, std::forward<R>(r)};
+    }
+
+    [[nodiscard]] friend constexpr auto tag_invoke(get_env_t,
+                                                   sender const &) noexcept
+        -> env {
+        return {};
+    }
+};
+
+// Holds the result of F once it has been computed. The first operation to
+// start computes it into the cache; later operations complete with a copy of
+// the cached value. An operation that starts while another is computing does
+// not wait: it calls F itself, without caching. Invalidating empties the
+// cache, so that the next operation to start computes it again; that must not
+// race with an operation reading the cache.
+template <std::invocable F>
+    requires(not std::is_void_v<std::invoke_result_t<F &>>)
+// NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+class memo {
+    template <typename, typename> friend struct op_state;
+
+    enum struct status : std::uint8_t { empty, computing, ready };
+
+    [[no_unique_address]] F f;
+    std::optional<std::remove_cvref_t<std::invoke_result_t<F &>>> value{};
+    std::atomic<status> state{};
+
+    template <typename R> auto complete(R &&r) -> void {
+        auto s = state.load(std::memory_order_acquire);
+        if (s == status::empty and
+            state.compare_exchange_strong(s, status::computing,
+                                          std::memory_order_acq_rel,
+                                          std::memory_order_acquire)) {
+            value.emplace(std::invoke(f));
+            state.store(status::ready, std::memory_order_release);
+            s = status::ready;
+        }
+        if (s == status::ready) {
+            set_value(std::forward<R>(r), value_type{*value});
+        } else {
+            set_value(std::forward<R>(r), std::invoke(f));
+        }
+    }
+
+  public:
+    using value_type = std::remove_cvref_t<std::invoke_result_t<F &>>;
+
+    template <typename T>
+    constexpr explicit(true) memo(T &&t) : f{std::forward<T>(t)} {}
+    constexpr memo(memo &&) = delete;
+
+    [[nodiscard]] constexpr auto get() -> sender<memo> { return {this}; }
+
+    auto invalidate() -> void {
+        auto s = status::ready;
+        state.compare_exchange_strong(s, status::empty,
+                                      std::memory_order_acq_rel,
+                                      std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] auto is_cached() const -> bool {
+        return state.load(std::memory_order_acquire) == status::ready;
+    }
+};
+} // namespace _memoized_result_of
+
 template <std::invocable... Fs>
 [[nodiscard]] constexpr auto just_result_of(Fs &&...fs) -> sender auto {
     return _just_result_of::sender<set_value_t, std::remove_cvref_t<Fs>...>{
@@ -100,4 +207,14 @@ template <std::invocable... Fs>
     return _just_result_of::sender<set_error_t, std::remove_cvref_t<Fs>...>{
         std::forward<Fs>(fs)...};
 }
+
+// Returns an object that caches the result of f. Its get() gives a sender
+// that completes with that result, computing it only on the first start (or
+// the first after invalidate()). All the senders it gives, and their copies,
+// share the one cache.
+template <std::invocable F>
+[[nodiscard]] constexpr auto memoized_result_of(F &&f) {
+    return _memoized_result_of::memo<std::remove_cvref_t<F>>{
+        std::forward<F>(f)};
+}
 } // namespace async
@@ -4,6 +4,7 @@
 #include <async/env.hpp>
 #include <async/forwarding_query.hpp>
 #include <async/tags.hpp>
+#include <async/trace.hpp>
 #include <async/type_traits.hpp>
 
 #include <stdx/concepts.hpp>
@@ -12,6 +13,7 @@
 #include <boost/mp11/algorithm.hpp>
 #include <boost/mp11/list.hpp>
 
+#include <memory>
 #include <type_traits>
 #include <utility>
 #include <variant>
@@ -19,14 +21,14 @@
 namespace async::_let {
 namespace detail {
 template <channel_tag Tag, typename F, typename... Ts>
-auto invoke(F &&f, Ts &&...ts)
+constexpr auto invoke(F &&f, Ts &&...ts)
     -> decltype(std::forward<F>(f).template operator()<Tag>(
         std::forward<Ts>(ts)...)) {
     return std::forward<F>(f).template operator()<Tag>(std::forward<Ts>(ts)...);
 }
 
 template <channel_tag Tag, typename F, typename... Ts>
-auto invoke(F &&f, Ts &&...ts)
+constexpr auto invoke(F &&f, Ts &&...ts)
     -> decltype(std::forward<F>(f)(std::forward<Ts>(ts)...)) {
     return std::forward<F>(f)(std::forward<Ts>(ts)...);
 }
@@ -49,15 +51,19 @@ struct receiver {
 
   private:
     template <channel_tag OtherTag, typename... Args>
-    friend auto tag_invoke(OtherTag, receiver const &self, Args &&...args)
-        -> void {
+    friend constexpr auto tag_invoke(OtherTag, receiver const &self,
+                                     Args &&...args) -> void {
+        ::async::detail::trace<trace_kind::let, OtherTag>(self.ops->rcvr,
+                                                          self.ops);
         OtherTag{}(self.ops->rcvr, std::forward<Args>(args)...);
     }
 
     template <channel_tag Tag, stdx::same_as_unqualified<receiver> Self,
               typename... Args>
         requires(... or std::same_as<Tag, Tags>)
-    friend auto tag_invoke(Tag, Self &&self, Args &&...args) -> void {
+    friend constexpr auto tag_invoke(Tag, Self &&self, Args &&...args)
+        -> void {
+        ::async::detail::trace<trace_kind::let, Tag>(self.ops->rcvr, self.ops);
         self.ops->complete_first(detail::invoke<Tag>(
             std::forward<Self>(self).f, std::forward<Args>(args)...));
     }
@@ -84,7 +90,12 @@ struct op_state {
                 }}} {}
     constexpr op_state(op_state &&) = delete;
 
-    template <typename S> auto complete_first(S &&s) -> void {
+    // The first stage and every possible second stage share one variant, so
+    // the op state is as big as the largest of them rather than their sum.
+    // Emplacing the second stage destroys the first, so the sender returned by
+    // the function must not refer to anything owned by the first stage (such
+    // as the values it sent by reference).
+    template <typename S> constexpr auto complete_first(S &&s) -> void {
         using index =
             boost::mp11::mp_find<DependentSenders, std::remove_cvref_t<S>>;
         static_assert(index::value <
@@ -110,6 +121,8 @@ struct op_state {
   private:
     template <stdx::same_as_unqualified<op_state> O>
     friend constexpr auto tag_invoke(start_t, O &&o) -> void {
+        ::async::detail::trace<trace_kind::let, start_t>(o.rcvr,
+                                                         std::addressof(o));
         start(std::get<0>(std::forward<O>(o).state));
     }
 };
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <async/tags.hpp>
+#include <async/trace.hpp>
+
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace async {
+// One in-flight operation, as seen by a debugger.
+struct live_op {
+    std::atomic<void const *> op{};
+    char const *kind{};
+    std::uint32_t started{};
+};
+
+// A table of the operations that have started and not yet completed, for
+// finding out what a stalled program is waiting on. It is fed by its tracer:
+// inject that with async::injected_tracer in a debug build, and every traced
+// operation (start_detached, when_all, let and the schedulers) registers
+// itself on start and deregisters on completion. A release build that injects
+// nothing compiles all of this out.
+//
+// Registering claims a free slot with a compare-exchange, so it is lock-free
+// and safe from interrupts. When every slot is in use, the operation is
+// counted in dropped() instead. The table is a plain global object, so it can
+// be inspected from a debugger as well as with for_each.
+template <std::size_t N, typename Clock = void> class op_registry {
+    std::array<live_op, N> slots{};
+    std::atomic<std::uint32_t> dropped_count{};
+    std::atomic<std::uint32_t> starts{};
+
+    auto timestamp() -> std::uint32_t {
+        if constexpr (std::is_void_v<Clock>) {
+            return starts.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            return static_cast<std::uint32_t>(Clock::now());
+        }
+    }
+
+  public:
+    struct tracer {
+        template <typename Kind, typename Event>
+        auto operator()(Kind, Event, void const *op) const -> void {
+            if constexpr (std::same_as<Event, start_t>) {
+                registry->add(Kind::name, op);
+            } else {
+                registry->remove(op);
+            }
+        }
+        op_registry *registry;
+    };
+
+    [[nodiscard]] auto get_tracer() -> tracer { return {this}; }
+
+    auto add(char const *kind, void const *op) -> void {
+        auto const started = timestamp();
+        for (auto &s : slots) {
+            void const *expected = nullptr;
+            if (s.op.load(std::memory_order_relaxed) == nullptr and
+                s.op.compare_exchange_strong(expected, op,
+                                             std::memory_order_acquire,
+                                             std::memory_order_relaxed)) {
+                s.kind = kind;
+                s.started = started;
+                return;
+            }
+        }
+        dropped_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // An operation that was never added (because it was dropped, or because
+    // it traces only its completion) is ignored.
+    auto remove(void const *op) -> void {
+        for (auto &s : slots) {
+            if (s.op.load(std::memory_order_relaxed) == op) {
+                s.op.store(nullptr, std::memory_order_release);
+                return;
+            }
+        }
+    }
+
+    // Calls f with each live operation.
+    template <typename F> auto for_each(F &&f) const -> void {
+        for (auto const &s : slots) {
+            if (s.op.load(std::memory_order_acquire) != nullptr) {
+                f(s);
+            }
+        }
+    }
+
+    [[nodiscard]] auto size() const -> std::size_t {
+        auto n = std::size_t{};
+        for_each([&](live_op const &) { ++n; });
+        return n;
+    }
+
+    [[nodiscard]] auto dropped() const -> std::uint32_t {
+        return dropped_count.load(std::memory_order_relaxed);
+    }
+};
+} // namespace async
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <async/concepts.hpp>
+#include <async/env.hpp>
+#include <async/type_traits.hpp>
+
+#include <stdx/concepts.hpp>
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace async {
+// The size of the operation state that results from connecting S to a
+// receiver whose environment is E. The receiver is empty, so for a sender
+// whose own state collapses (through [[no_unique_address]]) the result is 1.
+template <typename S, typename E = empty_env>
+struct op_state_size_of
+    : std::integral_constant<
+          std::size_t,
+          sizeof(connect_result_t<S, detail::universal_receiver<E>>)> {};
+
+template <typename S, typename E = empty_env>
+constexpr inline auto op_state_size_of_v = op_state_size_of<S, E>::value;
+
+namespace _op_state_budget {
+// Instantiated with the actual size so that it shows up in the diagnostic.
+template <std::size_t Size, std::size_t Budget> constexpr auto check() -> bool {
+    static_assert(Size <= Budget, "Operation state exceeds its size budget");
+    return true;
+}
+
+template <std::size_t Budget, typename E> struct pipeable {
+  private:
+    template <async::sender S, stdx::same_as_unqualified<pipeable> Self>
+    friend constexpr auto operator|(S &&s, Self &&) -> S {
+        static_assert(
+            check<op_state_size_of_v<std::remove_cvref_t<S>, E>, Budget>());
+        return std::forward<S>(s);
+    }
+};
+} // namespace _op_state_budget
+
+template <std::size_t Budget, typename E = empty_env>
+[[nodiscard]] constexpr auto static_assert_op_state_budget()
+    -> _op_state_budget::pipeable<Budget, E> {
+    return {};
+}
+
+template <std::size_t Budget, typename E = empty_env, sender S>
+[[nodiscard]] constexpr auto static_assert_op_state_budget(S &&s) -> S {
+    return std::forward<S>(s) | static_assert_op_state_budget<Budget, E>();
+}
+} // namespace async
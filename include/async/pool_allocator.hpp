@@ -0,0 +1,136 @@
+#pragma once
+
+#include <conc/concurrency.hpp>
+
+#include <stdx/bit.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace async {
+// A pool of Count blocks, each large enough for an object of up to BlockSize
+// bytes.
+template <std::size_t BlockSize, std::size_t Count> struct pool_size_class {
+    constexpr static inline auto block_size = BlockSize;
+    constexpr static inline auto count = Count;
+};
+
+namespace detail {
+template <typename SizeClass> struct block_pool {
+    constexpr static inline auto block_size = SizeClass::block_size;
+    constexpr static inline auto alignment = alignof(std::max_align_t);
+    constexpr static inline auto stride =
+        (std::max(SizeClass::block_size, sizeof(void *)) + alignment - 1) /
+        alignment * alignment;
+
+    struct free_block {
+        free_block *next;
+    };
+
+    alignas(alignment) std::array<std::byte, stride * SizeClass::count> data{};
+    free_block *free_list{};
+    std::size_t unused{};
+
+    // called inside the allocator's critical section
+    auto allocate() -> void * {
+        if (free_list != nullptr) {
+            return std::exchange(free_list, free_list->next);
+        }
+        if (unused < SizeClass::count) {
+            return std::data(data) + stride * unused++;
+        }
+        return nullptr;
+    }
+
+    // called inside the allocator's critical section
+    auto deallocate(void *p) -> void {
+        free_list = std::construct_at(static_cast<free_block *>(p), free_list);
+    }
+
+    [[nodiscard]] auto owns(void const *p) const -> bool {
+        auto const b = static_cast<std::byte const *>(p);
+        return b >= std::data(data) and b < std::data(data) + std::size(data);
+    }
+};
+} // namespace detail
+
+// An allocator whose memory is shared by every allocation domain that uses
+// it. Each size class is a pool of fixed-size blocks with an intrusive free
+// list; an object is placed in the smallest size class that fits it, or in a
+// larger one if that is exhausted. Size classes must be given in increasing
+// order of block size.
+//
+// Unlike static_allocator, the Name passed to construct does not reserve any
+// memory, so many call sites that are rarely live at the same time can share
+// a few pools.
+template <typename... SizeClasses> struct pool_allocator {
+    static_assert(sizeof...(SizeClasses) > 0,
+                  "pool_allocator needs at least one size class");
+    static_assert([] {
+        std::array sizes{SizeClasses::block_size...};
+        for (auto i = std::size_t{1}; i < std::size(sizes); ++i) {
+            if (sizes[i - 1] >= sizes[i]) {
+                return false;
+            }
+        }
+        return true;
+    }(), "pool_allocator size classes must be in increasing order of size");
+
+  private:
+    struct mutex;
+    static inline auto pools = std::tuple<detail::block_pool<SizeClasses>...>{};
+
+    template <typename T> static auto allocate() -> void * {
+        return conc::call_in_critical_section<mutex>([] {
+            void *p{};
+            auto const try_pool = [&]<typename P>(P &pool) -> bool {
+                if constexpr (sizeof(T) <= P::block_size) {
+                    p = pool.allocate();
+                }
+                return p != nullptr;
+            };
+            std::apply([&](auto &...ps) { (void)(try_pool(ps) or ...); },
+                       pools);
+            return p;
+        });
+    }
+
+    static auto deallocate(void *p) -> void {
+        conc::call_in_critical_section<mutex>([&] {
+            std::apply(
+                [&](auto &...ps) {
+                    (void)((ps.owns(p) and (ps.deallocate(p), true)) or ...);
+                },
+                pools);
+        });
+    }
+
+  public:
+    template <typename, typename T, typename F, typename... Args>
+        requires std::is_constructible_v<T, Args...>
+    static auto construct(F &&f, Args &&...args) -> bool {
+        static_assert(alignof(T) <= alignof(std::max_align_t),
+                      "pool_allocator cannot allocate over-aligned types");
+        static_assert(((sizeof(T) <= SizeClasses::block_size) or ...),
+                      "Type is too large for any pool_allocator size class");
+        if (auto p = allocate<T>(); p != nullptr) {
+            auto t = std::construct_at(static_cast<T *>(p),
+                                       std::forward<Args>(args)...);
+            std::forward<F>(f)(std::move(*t));
+            return true;
+        }
+        return false;
+    }
+
+    template <typename, typename T> static auto destruct(T const *t) -> void {
+        std::destroy_at(t);
+        deallocate(stdx::bit_cast<void *>(t));
+    }
+};
+} // namespace async
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <async/concepts.hpp>
+#include <async/tags.hpp>
+#include <async/type_traits.hpp>
+
+#include <stdx/concepts.hpp>
+#include <stdx/functional.hpp>
+
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace async {
+namespace _prepared {
+struct nothing {};
+
+// A multishot sender is connected as an lvalue, so that it can be connected
+// again.
+template <bool Multishot, typename S, typename R> struct state {
+    using type = connect_result_t<S, R>;
+};
+template <typename S, typename R> struct state<true, S, R> {
+    using type = connect_result_t<S &, R>;
+};
+} // namespace _prepared
+
+// A sender connected to a receiver ahead of time, for instance at boot, into
+// storage with a stable address (so it cannot be moved), so that starting it
+// on the event path costs no connect.
+//
+// To run again, it is reset: an operation state that can restart itself is
+// restarted in place; otherwise a multishot sender is kept, with a copy of
+// the receiver, and reconnected by reset. A singleshot sender runs once.
+template <sender Sndr, receiver Rcvr>
+// NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+class prepared_operation {
+    constexpr static auto multishot = multishot_sender<Sndr, Rcvr>;
+    using state_t = typename _prepared::state<multishot, Sndr, Rcvr>::type;
+    constexpr static auto restartable = restartable_operation<state_t>;
+    constexpr static auto reconnectable = multishot and not restartable;
+
+    template <typename T>
+    using kept_t = std::conditional_t<reconnectable, T, _prepared::nothing>;
+
+    template <typename T, typename U>
+    constexpr static auto keep(U &&u) -> kept_t<T> {
+        if constexpr (reconnectable) {
+            return std::forward<U>(u);
+        } else {
+            return {};
+        }
+    }
+
+    [[no_unique_address]] kept_t<Sndr> sndr;
+    [[no_unique_address]] kept_t<Rcvr> rcvr;
+    std::optional<state_t> state{};
+
+  public:
+    template <stdx::same_as_unqualified<Sndr> S,
+              stdx::same_as_unqualified<Rcvr> R>
+    constexpr prepared_operation(S &&s, R &&r)
+        : sndr{keep<Sndr>(std::forward<S>(s))},
+          rcvr{keep<Rcvr>(std::forward<R>(r))} {
+        if constexpr (reconnectable) {
+            reset();
+        } else if constexpr (multishot) {
+            state.emplace(stdx::with_result_of{
+                [&] { return connect(s, std::forward<R>(r)); }});
+        } else {
+            state.emplace(stdx::with_result_of{[&] {
+                return connect(std::forward<S>(s), std::forward<R>(r));
+            }});
+        }
+    }
+    constexpr prepared_operation(prepared_operation &&) = delete;
+
+    auto start() -> void {
+        if constexpr (multishot) {
+            async::start(*state);
+        } else {
+            async::start(std::move(*state));
+        }
+    }
+
+    // Makes the operation ready to start again once it has completed.
+    auto reset() -> void
+        requires multishot
+    {
+        if constexpr (restartable) {
+            async::restart(*state);
+        } else {
+            state.emplace(
+                stdx::with_result_of{[&] { return connect(sndr, rcvr); }});
+        }
+    }
+};
+
+template <sender S, receiver R>
+prepared_operation(S, R)
+    -> prepared_operation<std::remove_cvref_t<S>, std::remove_cvref_t<R>>;
+} // namespace async
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <async/async_semaphore.hpp>
+#include <async/concepts.hpp>
+#include <async/schedulers/task.hpp>
+#include <async/schedulers/timer_manager_interface.hpp>
+#include <async/sequence.hpp>
+#include <conc/concurrency.hpp>
+
+#include <stdx/intrusive_list.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace async {
+namespace _rate_limited {
+// Tokens are refilled lazily, from the time that has passed since the last
+// refill, whenever an operation asks for one. Operations that find no token
+// are linked into a list in their operation states; one timer task, armed
+// only while operations wait, wakes at the next refill and completes as many
+// of them as there are tokens, in the order in which they started.
+template <typename Hal, typename Domain, typename Task> class state {
+    using time_point_t = decltype(Hal::now());
+    using duration_t = decltype(time_point_t{} - time_point_t{});
+    using waiter = _semaphore::waiter;
+
+    struct mutex;
+
+    // NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+    struct refill_task : Task {
+        constexpr explicit(true) refill_task(state *s)
+            : Task{run_task<refill_task>}, st{s} {}
+
+        auto run() -> void { st->on_refill(); }
+
+        state *st;
+    };
+
+    std::size_t capacity;
+    std::size_t tokens;
+    duration_t period;
+    time_point_t last{};
+    stdx::intrusive_list<waiter> waiters{};
+    bool armed{};
+    refill_task timer{this};
+
+    // Called in the critical section. A full bucket does not bank time, so
+    // the next token after a burst arrives a whole period later.
+    auto refill(time_point_t now) -> void {
+        auto const n = (now - last) / period;
+        if (n <= 0) {
+            return;
+        }
+        last += n * period;
+        tokens = std::min(capacity, tokens + static_cast<std::size_t>(n));
+        if (tokens == capacity) {
+            last = now;
+        }
+    }
+
+    auto arm(duration_t d) -> void {
+        timer_mgr::detail::run_after<Domain>(timer, d);
+    }
+
+    auto on_refill() -> void {
+        auto const now = Hal::now();
+        stdx::intrusive_list<waiter> ready{};
+        auto const next = conc::call_in_critical_section<mutex>(
+            [&]() -> std::optional<duration_t> {
+                refill(now);
+                while (tokens > 0 and not waiters.empty()) {
+                    auto const w = waiters.pop_front();
+                    w->linked = false;
+                    --tokens;
+                    ready.push_back(w);
+                }
+                if (waiters.empty()) {
+                    armed = false;
+                    return std::nullopt;
+                }
+                return last + period - now;
+            });
+        if (next) {
+            arm(*next);
+        }
+        while (not ready.empty()) {
+            ready.pop_front()->complete();
+        }
+    }
+
+  public:
+    constexpr state(std::size_t cap, duration_t per_token)
+        : capacity{cap}, tokens{cap}, period{per_token} {}
+
+    // Returns true if a token was taken; false if the operation must wait.
+    auto acquire(waiter &w) -> bool {
+        auto const now = Hal::now();
+        auto taken = false;
+        auto const next = conc::call_in_critical_section<mutex>(
+            [&]() -> std::optional<duration_t> {
+                refill(now);
+                if (tokens > 0 and waiters.empty()) {
+                    --tokens;
+                    taken = true;
+                    return std::nullopt;
+                }
+                waiters.push_back(std::addressof(w));
+                w.linked = true;
+                if (std::exchange(armed, true)) {
+                    return std::nullopt;
+                }
+                return last + period - now;
+            });
+        if (next) {
+            arm(*next);
+        }
+        return taken;
+    }
+
+    // Returns false if the operation was already given a token.
+    auto unlink(waiter &w) -> bool {
+        return conc::call_in_critical_section<mutex>([&] {
+            if (not w.linked) {
+                return false;
+            }
+            waiters.remove(std::addressof(w));
+            w.linked = false;
+            return true;
+        });
+    }
+
+    [[nodiscard]] auto available() -> std::size_t {
+        auto const now = Hal::now();
+        return conc::call_in_critical_section<mutex>([&] {
+            refill(now);
+            return waiters.empty() ? tokens : std::size_t{};
+        });
+    }
+};
+} // namespace _rate_limited
+
+// A token bucket holding up to Capacity tokens, which refills at one token
+// per period, measured with the HAL's now(). Its acquire() sender completes
+// at once while a token is available, and otherwise waits, without polling,
+// for the timer in Domain to signal the next refill. The bucket must outlive
+// the operations that wait on it.
+template <typename Hal, std::size_t Capacity,
+          typename Domain = timer_mgr::default_domain,
+          typename Task = timer_task<decltype(Hal::now())>>
+class token_bucket {
+    static_assert(Capacity > 0, "A token bucket must hold at least one token");
+
+    using state_t = _rate_limited::state<Hal, Domain, Task>;
+    state_t st;
+
+  public:
+    using duration_t = decltype(Hal::now() - Hal::now());
+
+    constexpr explicit(true) token_bucket(duration_t per_token)
+        : st{Capacity, per_token} {}
+    token_bucket(token_bucket &&) = delete;
+
+    [[nodiscard]] auto acquire() -> _semaphore::sender<state_t> {
+        return {std::addressof(st)};
+    }
+
+    [[nodiscard]] auto available() -> std::size_t { return st.available(); }
+};
+
+// Runs the sender once it has a token from the bucket: at full speed up to
+// the bucket's rate, and no faster.
+template <typename Bucket, sender S>
+[[nodiscard]] auto rate_limited(Bucket &bucket, S &&s) -> sender auto {
+    return bucket.acquire() | seq(std::forward<S>(s));
+}
+} // namespace async
@@ -56,6 +56,55 @@ template <typename Tag> struct sender {
         return {std::forward<R>(r), std::forward<Self>(self).t};
     }
 };
+
+// The value is queried when the operation is connected and kept in the
+// operation state, so starting (or restarting) it sends the same value
+// without querying the environment again.
+template <typename R, typename Tag> struct once_op_state {
+    using value_t =
+        std::remove_cvref_t<decltype(Tag{}(get_env(std::declval<R &>())))>;
+
+    template <typename Rc>
+    // NOLINTNEXTLINE(bugprone-forwarding-reference-overload)
+    constexpr explicit(true) once_op_state(Rc &&r)
+        : receiver{std::forward<Rc>(r)}, value{Tag{}(get_env(receiver))} {}
+
+    [[no_unique_address]] R receiver;
+    [[no_unique_address]] value_t value;
+
+  private:
+    template <stdx::same_as_unqualified<once_op_state> O>
+    friend constexpr auto tag_invoke(start_t, O &&o) -> void {
+        set_value(std::forward<O>(o).receiver, std::forward<O>(o).value);
+    }
+
+    // starting as an lvalue copies the value, so there is nothing to reset
+    friend constexpr auto tag_invoke(restart_t, once_op_state &) -> void {}
+};
+
+template <typename Tag> struct once_sender {
+    using is_sender = void;
+
+    template <typename Env>
+    [[nodiscard]] friend constexpr auto tag_invoke(get_completion_signatures_t,
+                                                   once_sender const &,
+                                                   Env const &)
+        -> completion_signatures<set_value_t(std::remove_cvref_t<
+                                             decltype(std::declval<Tag>()(
+                                                 std::declval<Env>()))>)> {
+        return {};
+    }
+
+    [[no_unique_address]] Tag t;
+
+  private:
+    template <stdx::same_as_unqualified<once_sender> Self, receiver R>
+    [[nodiscard]] friend constexpr auto tag_invoke(connect_t, Self &&, R &&r)
+        -> once_op_state<std::remove_cvref_t<R>, Tag> {
+        check_connect<Self, R>();
+        return once_op_state<std::remove_cvref_t<R>, Tag>{std::forward<R>(r)};
+    }
+};
 } // namespace _read_env
 
 template <typename Tag>
@@ -63,6 +112,14 @@ template <typename Tag>
     return _read_env::sender<Tag>{{std::forward<Tag>(t)}};
 }
 
+// Like read_env, but the value is read from the environment once, at connect
+// time, rather than each time the operation starts.
+template <typename Tag>
+[[nodiscard]] constexpr auto read_env_once(Tag &&t) -> sender auto {
+    return _read_env::once_sender<std::remove_cvref_t<Tag>>{
+        {std::forward<Tag>(t)}};
+}
+
 [[nodiscard]] constexpr auto get_stop_token() -> sender auto {
     return read_env(get_stop_token_t{});
 }
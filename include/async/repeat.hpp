@@ -3,6 +3,8 @@
 #include <async/compose.hpp>
 #include <async/concepts.hpp>
 #include <async/env.hpp>
+#include <async/tags.hpp>
+#include <async/trampoline.hpp>
 #include <async/type_traits.hpp>
 
 #include <stdx/concepts.hpp>
@@ -31,10 +33,10 @@ template <typename Ops, typename Rcvr> struct receiver {
     template <typename... Args>
     friend constexpr auto tag_invoke(set_error_t, receiver const &r,
                                      Args &&...args) -> void {
-        set_error(r.ops->rcvr, std::forward<Args>(args)...);
+        r.ops->finish(set_error, std::forward<Args>(args)...);
     }
     friend constexpr auto tag_invoke(set_stopped_t, receiver const &r) -> void {
-        set_stopped(r.ops->rcvr);
+        r.ops->finish(set_stopped);
     }
 
     [[nodiscard]] friend constexpr auto tag_invoke(async::get_env_t,
@@ -74,21 +76,41 @@ template <typename Sndr, typename Rcvr, stdx::callable Pred> struct op_state {
           pred{std::forward<P>(p)} {}
     constexpr op_state(op_state &&) = delete;
 
+    // An operation state that can reset itself is connected once and
+    // restarted in place on each iteration.
     auto restart() -> void {
-        auto &op = state.emplace(stdx::with_result_of{
-            [&] { return connect(sndr, receiver_t{this}); }});
-        start(std::move(op));
+        if constexpr (restartable_operation<state_t>) {
+            if (state) {
+                async::restart(*state);
+            } else {
+                state.emplace(stdx::with_result_of{
+                    [&] { return connect(sndr, receiver_t{this}); }});
+            }
+            start(*state);
+        } else {
+            auto &op = state.emplace(stdx::with_result_of{
+                [&] { return connect(sndr, receiver_t{this}); }});
+            start(std::move(op));
+        }
     }
 
     template <typename... Args> auto repeat(Args &&...args) -> void {
         if constexpr (not std::same_as<
                           Pred, std::remove_cvref_t<decltype(never_stop)>>) {
             if (pred(args...)) {
-                set_value(rcvr, std::forward<Args>(args)...);
+                finish(set_value, std::forward<Args>(args)...);
                 return;
             }
         }
-        restart();
+        if (not loop.defer()) {
+            loop.run([&] { restart(); });
+        }
+    }
+
+    template <typename Tag, typename... Args>
+    auto finish(Tag tag, Args &&...args) -> void {
+        loop.finish();
+        tag(rcvr, std::forward<Args>(args)...);
     }
 
     [[no_unique_address]] Sndr sndr;
@@ -98,10 +120,13 @@ template <typename Sndr, typename Rcvr, stdx::callable Pred> struct op_state {
     using state_t = async::connect_result_t<Sndr &, receiver_t>;
     std::optional<state_t> state{};
 
+    struct mutex;
+    detail::trampoline<mutex> loop{};
+
   private:
     template <stdx::same_as_unqualified<op_state> O>
     friend constexpr auto tag_invoke(start_t, O &&o) -> void {
-        std::forward<O>(o).restart();
+        o.loop.run([&] { o.restart(); });
     }
 };
 
@@ -4,6 +4,7 @@
 #include <async/concepts.hpp>
 #include <async/env.hpp>
 #include <async/tags.hpp>
+#include <async/trampoline.hpp>
 #include <async/type_traits.hpp>
 
 #include <stdx/concepts.hpp>
@@ -28,7 +29,7 @@ template <typename Ops, typename Rcvr> struct receiver {
     template <typename... Args>
     friend constexpr auto tag_invoke(set_value_t, receiver const &r,
                                      Args &&...args) -> void {
-        set_value(r.ops->rcvr, std::forward<Args>(args)...);
+        r.ops->finish(set_value, std::forward<Args>(args)...);
     }
     template <typename... Args>
     friend constexpr auto tag_invoke(set_error_t, receiver const &r,
@@ -36,7 +37,7 @@ template <typename Ops, typename Rcvr> struct receiver {
         r.ops->retry(std::forward<Args>(args)...);
     }
     friend constexpr auto tag_invoke(set_stopped_t, receiver const &r) -> void {
-        set_stopped(r.ops->rcvr);
+        r.ops->finish(set_stopped);
     }
 
     [[nodiscard]] friend constexpr auto tag_invoke(async::get_env_t,
@@ -86,11 +87,19 @@ template <typename Sndr, typename Rcvr, typename Pred> struct op_state {
         if constexpr (not std::same_as<
                           Pred, std::remove_cvref_t<decltype(never_stop)>>) {
             if (pred(args...)) {
-                set_error(rcvr, std::forward<Args>(args)...);
+                finish(set_error, std::forward<Args>(args)...);
                 return;
             }
         }
-        restart();
+        if (not loop.defer()) {
+            loop.run([&] { restart(); });
+        }
+    }
+
+    template <typename Tag, typename... Args>
+    auto finish(Tag tag, Args &&...args) -> void {
+        loop.finish();
+        tag(rcvr, std::forward<Args>(args)...);
     }
 
     [[no_unique_address]] Sndr sndr;
@@ -100,10 +109,13 @@ template <typename Sndr, typename Rcvr, typename Pred> struct op_state {
     using state_t = async::connect_result_t<Sndr &, receiver_t>;
     std::optional<state_t> state{};
 
+    struct mutex;
+    detail::trampoline<mutex> loop{};
+
   private:
     template <stdx::same_as_unqualified<op_state> O>
     friend constexpr auto tag_invoke(start_t, O &&o) -> void {
-        std::forward<O>(o).restart();
+        o.loop.run([&] { o.restart(); });
     }
 };
 
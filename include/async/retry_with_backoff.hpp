@@ -0,0 +1,216 @@
+#pragma once
+
+#include <async/compose.hpp>
+#include <async/concepts.hpp>
+#include <async/env.hpp>
+#include <async/schedulers/time_scheduler.hpp>
+#include <async/schedulers/timer_manager_interface.hpp>
+#include <async/stop_token.hpp>
+#include <async/tags.hpp>
+#include <async/type_traits.hpp>
+
+#include <stdx/concepts.hpp>
+#include <stdx/functional.hpp>
+
+#include <algorithm>
+#include <concepts>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace async {
+struct no_jitter {
+    template <typename Duration>
+    constexpr auto operator()(Duration d) const -> Duration {
+        return d;
+    }
+};
+
+// The delay before the first retry is initial; each subsequent delay is
+// multiplied, up to maximum. Each delay is passed through the jitter function
+// before use. max_attempts counts every run of the sender, including the
+// first; zero means no limit.
+template <typename Duration, typename Jitter = no_jitter>
+struct backoff_policy {
+    Duration initial{};
+    Duration maximum{};
+    unsigned int max_attempts{};
+    unsigned int multiplier{2};
+    [[no_unique_address]] Jitter jitter{};
+};
+
+namespace _retry_backoff {
+template <typename Ops, typename Rcvr> struct receiver {
+    using is_receiver = void;
+
+    Ops *ops;
+
+  private:
+    template <typename... Args>
+    friend constexpr auto tag_invoke(set_value_t, receiver const &r,
+                                     Args &&...args) -> void {
+        set_value(r.ops->rcvr, std::forward<Args>(args)...);
+    }
+    template <typename... Args>
+    friend constexpr auto tag_invoke(set_error_t, receiver const &r,
+                                     Args &&...args) -> void {
+        r.ops->retry(std::forward<Args>(args)...);
+    }
+    friend constexpr auto tag_invoke(set_stopped_t, receiver const &r) -> void {
+        set_stopped(r.ops->rcvr);
+    }
+
+    [[nodiscard]] friend constexpr auto tag_invoke(async::get_env_t,
+                                                   receiver const &self)
+        -> detail::forwarding_env<env_of_t<Rcvr>> {
+        return forward_env_of(self.ops->rcvr);
+    }
+};
+
+// The op state is its own timer task, so every delay between attempts uses
+// the same task node. Only the sender itself is reconnected for each attempt.
+template <typename Domain, typename Task, typename Sndr, typename Rcvr,
+          typename Policy>
+// NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+struct op_state final : Task {
+    using receiver_t = receiver<op_state, Rcvr>;
+
+    template <stdx::same_as_unqualified<Sndr> S,
+              stdx::same_as_unqualified<Rcvr> R>
+    constexpr op_state(S &&s, R &&r, Policy const &p)
+        : Task{run_task<op_state>}, sndr{std::forward<S>(s)},
+          rcvr{std::forward<R>(r)}, policy{p}, delay{p.initial} {}
+    constexpr op_state(op_state &&) = delete;
+
+    auto attempt() -> void {
+        ++attempts;
+        auto &op = state.emplace(stdx::with_result_of{
+            [&] { return connect(sndr, receiver_t{this}); }});
+        start(std::move(op));
+    }
+
+    template <typename... Args> auto retry(Args &&...args) -> void {
+        if (policy.max_attempts != 0 and attempts >= policy.max_attempts) {
+            set_error(rcvr, std::forward<Args>(args)...);
+            return;
+        }
+        auto token = get_stop_token(get_env(rcvr));
+        if (token.stop_requested()) {
+            set_stopped(rcvr);
+            return;
+        }
+
+        // registered before the timer is armed: afterwards, an expiry could
+        // already have started the next attempt
+        stop_cb.emplace(token, stop_callback_fn{this});
+        auto const d = policy.jitter(delay);
+        delay = std::min(delay * policy.multiplier, policy.maximum);
+        timer_mgr::detail::run_after<Domain>(*this, d);
+    }
+
+    auto run() -> void {
+        stop_cb.reset();
+        if (get_stop_token(get_env(rcvr)).stop_requested()) {
+            set_stopped(rcvr);
+        } else {
+            attempt();
+        }
+    }
+
+    struct stop_callback_fn {
+        auto operator()() -> void {
+            if (timer_mgr::detail::cancel<Domain>(*ops)) {
+                set_stopped(ops->rcvr);
+            }
+        }
+        op_state *ops;
+    };
+
+    using duration_t = decltype(std::declval<Policy const &>().initial);
+    using state_t = connect_result_t<Sndr &, receiver_t>;
+    using stop_callback_t = optional_stop_callback_t<
+        stop_token_of_t<env_of_t<Rcvr>>, stop_callback_fn>;
+
+    [[no_unique_address]] Sndr sndr;
+    [[no_unique_address]] Rcvr rcvr;
+    [[no_unique_address]] Policy policy;
+    duration_t delay;
+    unsigned int attempts{};
+    std::optional<state_t> state{};
+    [[no_unique_address]] stop_callback_t stop_cb{};
+
+  private:
+    template <stdx::same_as_unqualified<op_state> O>
+    friend constexpr auto tag_invoke(start_t, O &&o) -> void {
+        if (get_stop_token(get_env(o.rcvr)).stop_requested()) {
+            set_stopped(std::forward<O>(o).rcvr);
+        } else {
+            o.attempt();
+        }
+    }
+};
+
+template <typename Domain, typename Task, typename Sndr, typename Policy>
+struct sender {
+    using is_sender = void;
+    [[no_unique_address]] Sndr sndr;
+    [[no_unique_address]] Policy policy;
+
+  private:
+    template <typename Env>
+    [[nodiscard]] friend constexpr auto
+    tag_invoke(get_completion_signatures_t, sender const &, Env const &)
+        -> transform_completion_signatures_of<
+            Sndr, Env, completion_signatures<set_stopped_t()>> {
+        return {};
+    }
+
+    [[nodiscard]] friend constexpr auto tag_invoke(async::get_env_t,
+                                                   sender const &self) {
+        return forward_env_of(self.sndr);
+    }
+
+    template <stdx::same_as_unqualified<sender> Self, receiver_from<Sndr> R>
+        requires multishot_sender<Sndr, R>
+    [[nodiscard]] friend constexpr auto tag_invoke(connect_t, Self &&self,
+                                                   R &&r)
+        -> op_state<Domain, Task, Sndr, std::remove_cvref_t<R>, Policy> {
+        return {std::forward<Self>(self).sndr, std::forward<R>(r),
+                self.policy};
+    }
+};
+
+template <typename Domain, typename Task, typename Policy> struct pipeable {
+    Policy policy;
+
+  private:
+    template <async::sender S, stdx::same_as_unqualified<pipeable> Self>
+    friend constexpr auto operator|(S &&s, Self &&self) -> async::sender auto {
+        return sender<Domain, Task, std::remove_cvref_t<S>, Policy>{
+            std::forward<S>(s), std::forward<Self>(self).policy};
+    }
+};
+} // namespace _retry_backoff
+
+template <typename Domain, typename Duration, typename Task,
+          typename Cancellation, typename Policy>
+[[nodiscard]] constexpr auto
+retry_with_backoff(time_scheduler<Domain, Duration, Task, Cancellation>,
+                   Policy &&policy) {
+    return _compose::adaptor{
+        stdx::tuple{_retry_backoff::pipeable<Domain, Task,
+                                             std::remove_cvref_t<Policy>>{
+            std::forward<Policy>(policy)}}};
+}
+
+template <sender S, typename Domain, typename Duration, typename Task,
+          typename Cancellation, typename Policy>
+[[nodiscard]] auto
+retry_with_backoff(S &&s,
+                   time_scheduler<Domain, Duration, Task, Cancellation> sched,
+                   Policy &&policy) {
+    return std::forward<S>(s) |
+           retry_with_backoff(sched, std::forward<Policy>(policy));
+}
+} // namespace async
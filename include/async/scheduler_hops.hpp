@@ -0,0 +1,147 @@
+#pragma once
+
+#include <async/concepts.hpp>
+#include <async/env.hpp>
+#include <async/schedulers/priority_scheduler.hpp>
+#include <async/schedulers/task_manager_interface.hpp>
+#include <async/tags.hpp>
+
+#include <stdx/concepts.hpp>
+
+#include <boost/mp11/algorithm.hpp>
+#include <boost/mp11/list.hpp>
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace async {
+namespace _scheduler_hops {
+template <typename T>
+using completion_scheduler_t = std::remove_cvref_t<decltype(
+    get_completion_scheduler<set_value_t>(get_env(std::declval<T>())))>;
+
+// The sender returned by a scheduler's schedule().
+template <typename T>
+concept schedule_sender =
+    requires { typename completion_scheduler_t<T>; } and
+    std::same_as<T, std::remove_cvref_t<decltype(std::declval<
+                                                  completion_scheduler_t<T>>()
+                                                      .schedule())>>;
+
+// The types a type is built from, in order. Adaptors carry the senders they
+// adapt as type parameters, before the functions applied to them.
+template <typename T> struct children {
+    using type = boost::mp11::mp_list<>;
+};
+template <template <typename...> typename T, typename... Ts>
+struct children<T<Ts...>> {
+    using type = boost::mp11::mp_list<Ts...>;
+};
+
+template <typename T> struct walk;
+template <typename T> using walk_t = typename walk<T>::type;
+
+template <typename T> constexpr auto hops_of() {
+    if constexpr (not std::is_object_v<T>) {
+        return std::type_identity<boost::mp11::mp_list<>>{};
+    } else if constexpr (scheduler<T>) {
+        return std::type_identity<boost::mp11::mp_list<T>>{};
+    } else if constexpr (schedule_sender<T>) {
+        return std::type_identity<
+            boost::mp11::mp_list<completion_scheduler_t<T>>>{};
+    } else if constexpr (requires { typename T::sender_t; }) {
+        // when_all and when_any wrap each sender together with its index
+        return std::type_identity<walk_t<typename T::sender_t>>{};
+    } else {
+        return std::type_identity<boost::mp11::mp_apply<
+            boost::mp11::mp_append,
+            boost::mp11::mp_transform<walk_t,
+                                      typename children<T>::type>>>{};
+    }
+}
+
+template <typename T> struct walk {
+    using type = typename decltype(hops_of<T>())::type;
+};
+
+template <typename L> constexpr auto count_redundant() -> std::size_t {
+    constexpr auto n = boost::mp11::mp_size<L>::value;
+    if constexpr (n < 2) {
+        return 0;
+    } else {
+        return []<std::size_t... Is>(std::index_sequence<Is...>) {
+            return (std::size_t{} + ... +
+                    static_cast<std::size_t>(
+                        std::same_as<boost::mp11::mp_at_c<L, Is>,
+                                     boost::mp11::mp_at_c<L, Is + 1>>));
+        }(std::make_index_sequence<n - 1>{});
+    }
+}
+
+template <typename Sched> struct priority_of {};
+template <priority_t P, typename Task, typename Handoff>
+struct priority_of<fixed_priority_scheduler<P, Task, Handoff>>
+    : std::integral_constant<priority_t, P> {};
+
+// Instantiated with the actual count so that it shows up in the diagnostic.
+template <std::size_t Hops, std::size_t Budget> constexpr auto check() -> bool {
+    static_assert(Hops <= Budget, "Sender exceeds its scheduler hop budget");
+    return true;
+}
+
+template <std::size_t Budget> struct pipeable;
+} // namespace _scheduler_hops
+
+// The schedulers that a sender moves to, in order, as found in its type: each
+// schedule() sender, and each continue_on, is one hop. Senders that are only
+// known at runtime (those returned by the functions given to let_value or
+// sequence, for example) are not part of the type, and their hops are not
+// counted. The hops of senders that run concurrently (in when_all, for
+// example) are listed one sender after another.
+template <typename S>
+using scheduler_hops_t =
+    _scheduler_hops::walk_t<std::remove_cvref_t<S>>;
+
+template <typename S>
+constexpr inline auto scheduler_hop_count_v =
+    boost::mp11::mp_size<scheduler_hops_t<S>>::value;
+
+// The number of hops to a scheduler of the same type as the previous hop. For
+// a scheduler without state, such a hop moves to where the sender already is.
+template <typename S>
+constexpr inline auto redundant_hop_count_v =
+    _scheduler_hops::count_redundant<scheduler_hops_t<S>>();
+
+// The priorities of the hops, when every hop is to a fixed_priority_scheduler.
+template <typename S>
+constexpr inline auto hop_priorities_v =
+    []<typename... Scheds>(boost::mp11::mp_list<Scheds...>) {
+        return std::array<priority_t, sizeof...(Scheds)>{
+            _scheduler_hops::priority_of<Scheds>::value...};
+    }(scheduler_hops_t<S>{});
+
+namespace _scheduler_hops {
+template <std::size_t Budget> struct pipeable {
+  private:
+    template <async::sender S, stdx::same_as_unqualified<pipeable> Self>
+    friend constexpr auto operator|(S &&s, Self &&) -> S {
+        static_assert(check<scheduler_hop_count_v<S>, Budget>());
+        return std::forward<S>(s);
+    }
+};
+} // namespace _scheduler_hops
+
+template <std::size_t Budget>
+[[nodiscard]] constexpr auto static_assert_hop_budget()
+    -> _scheduler_hops::pipeable<Budget> {
+    return {};
+}
+
+template <std::size_t Budget, sender S>
+[[nodiscard]] constexpr auto static_assert_hop_budget(S &&s) -> S {
+    return std::forward<S>(s) | static_assert_hop_budget<Budget>();
+}
+} // namespace async
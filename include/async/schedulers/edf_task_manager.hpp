@@ -0,0 +1,161 @@
+#pragma once
+
+#include <async/schedulers/task.hpp>
+#include <async/schedulers/task_manager.hpp>
+#include <async/schedulers/task_manager_interface.hpp>
+#include <conc/concurrency.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <utility>
+
+namespace async {
+namespace detail {
+template <typename TimePoint> constexpr auto latest() -> TimePoint {
+    if constexpr (requires { TimePoint::max(); }) {
+        return TimePoint::max();
+    } else {
+        return std::numeric_limits<TimePoint>::max();
+    }
+}
+
+// A task without a deadline runs after every task that has one.
+template <typename TimePoint> struct deadline_task : task_base {
+    using task_base::task_base;
+
+    TimePoint deadline{latest<TimePoint>()};
+    std::uint32_t sequence{};
+};
+} // namespace detail
+
+// A task for an edf_task_manager. The schedulers set its deadline when they
+// start, from the get_deadline query on the receiver's environment.
+template <typename TimePoint>
+using edf_task = heap_linked_task<detail::deadline_task<TimePoint>>;
+
+// A task manager that runs the ready task with the earliest deadline first,
+// and tasks with equal deadlines in the order in which they were queued.
+// Ready tasks are kept in an intrusive pairing heap, as in
+// heap_timer_manager, so queueing a task is O(1) and taking the next one is
+// amortized O(log n).
+//
+// Priorities only choose which of the HAL's service routines is scheduled:
+// all of them service the same heap.
+template <detail::scheduler_hal S, typename TimePoint,
+          typename Task = edf_task<TimePoint>>
+struct edf_task_manager {
+    using task_t = Task;
+
+  private:
+    struct mutex;
+    task_t *root{};
+    std::uint32_t sequence{};
+    std::atomic<int> task_count{};
+
+    [[nodiscard]] static auto as_task(auto *p) -> task_t * {
+        return static_cast<task_t *>(p);
+    }
+
+    // sequence numbers are compared modulo 2^32, so they may wrap around
+    [[nodiscard]] static auto before(task_t const &a, task_t const &b)
+        -> bool {
+        if (a.deadline < b.deadline) {
+            return true;
+        }
+        if (b.deadline < a.deadline) {
+            return false;
+        }
+        return static_cast<std::int32_t>(a.sequence - b.sequence) < 0;
+    }
+
+    [[nodiscard]] static auto meld(task_t *a, task_t *b) -> task_t * {
+        if (a == nullptr) {
+            return b;
+        }
+        if (b == nullptr) {
+            return a;
+        }
+        if (before(*b, *a)) {
+            std::swap(a, b);
+        }
+        b->prev = a;
+        b->next = a->child;
+        if (a->child != nullptr) {
+            a->child->prev = b;
+        }
+        a->child = b;
+        a->next = a->prev = nullptr;
+        return a;
+    }
+
+    [[nodiscard]] static auto merge_pairs(task_t *first) -> task_t * {
+        task_t *pairs{};
+        while (first != nullptr) {
+            auto const second = as_task(first->next);
+            auto const rest =
+                second == nullptr ? nullptr : as_task(second->next);
+            first->next = first->prev = nullptr;
+            if (second != nullptr) {
+                second->next = second->prev = nullptr;
+            }
+            auto const m = meld(first, second);
+            m->next = pairs;
+            pairs = m;
+            first = rest;
+        }
+        task_t *result{};
+        while (pairs != nullptr) {
+            auto const next = as_task(pairs->next);
+            pairs->next = nullptr;
+            result = meld(result, pairs);
+            pairs = next;
+        }
+        return result;
+    }
+
+    auto pop_task() -> task_t * {
+        return conc::call_in_critical_section<mutex>([&]() -> task_t * {
+            auto const t = root;
+            if (t != nullptr) {
+                root = merge_pairs(as_task(std::exchange(t->child, nullptr)));
+                t->pending = false;
+            }
+            return t;
+        });
+    }
+
+  public:
+    constexpr static auto create_task = async::create_task<task_t>;
+
+    auto enqueue_task(task_t &t, priority_t p) -> bool {
+        return conc::call_in_critical_section<mutex>([&]() -> bool {
+            auto const added = not std::exchange(t.pending, true);
+            if (added) {
+                ++task_count;
+                t.sequence = sequence++;
+                root = meld(root, std::addressof(t));
+                S::schedule(p);
+            }
+            return added;
+        });
+    }
+
+    template <priority_t> constexpr static auto valid_priority() -> bool {
+        return true;
+    }
+
+    // Runs ready tasks until there are none, each time taking the one with
+    // the earliest deadline, including tasks queued while others run.
+    template <priority_t> auto service_tasks() -> void {
+        while (auto const t = pop_task()) {
+            t->run();
+            --task_count;
+        }
+    }
+
+    [[nodiscard]] auto is_idle() const -> bool { return task_count == 0; }
+};
+static_assert(task_manager<edf_task_manager<archetypes::scheduler_hal, int>>);
+} // namespace async
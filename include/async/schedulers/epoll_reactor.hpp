@@ -0,0 +1,229 @@
+#pragma once
+
+#if not __has_include(<sys/epoll.h>)
+#error async::epoll_reactor is unavailable: <sys/epoll.h> does not exist
+#endif
+
+#include <async/concepts.hpp>
+#include <async/env.hpp>
+#include <async/stop_token.hpp>
+#include <async/tags.hpp>
+#include <async/type_traits.hpp>
+
+#include <stdx/concepts.hpp>
+
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <memory>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace async {
+// An idle hook for run loops on hosted Linux builds, which waits on an epoll
+// instance. Injected as the run loop idle hook, it multiplexes file descriptor
+// readiness onto the thread that runs the loop: while the loop has no work,
+// that thread waits in epoll_wait, and completes the fd_readable and
+// fd_writable operations whose descriptors become ready. Scheduling onto an
+// idle loop writes to an eventfd that the epoll instance also watches.
+//
+// Each descriptor may have one readiness operation at a time.
+// NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+class epoll_reactor {
+    struct op_base {
+        using fn_t = auto (*)(op_base &) -> void;
+
+        fn_t ready;
+        fn_t cancel;
+        op_base *next{};
+    };
+
+    // A stop request hands the operation to the thread in epoll_wait, which
+    // removes its descriptor and completes it. An operation that became ready
+    // meanwhile waits for that, so the request never outlives it.
+    // NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+    template <typename Rcvr> struct op_state : op_base {
+        struct stop_callback_fn {
+            auto operator()() -> void {
+                o->cancelling.store(true);
+                o->reactor->request_cancel(o);
+            }
+            op_state *o;
+        };
+
+        using stop_callback_t = optional_stop_callback_t<
+            stop_token_of_t<env_of_t<Rcvr>>, stop_callback_fn>;
+
+        template <typename R>
+        op_state(epoll_reactor *r, int f, std::uint32_t ev, R &&rc)
+            : op_base{ready_with, cancel_with}, reactor{r}, fd{f}, events{ev},
+              rcvr{std::forward<R>(rc)} {}
+        op_state(op_state &&) = delete;
+
+        static auto ready_with(op_base &b) -> void {
+            auto &o = static_cast<op_state &>(b);
+            o.stop_cb.reset();
+            o.reactor->remove(o.fd);
+            o.done = true;
+            if (not o.cancelling.load()) {
+                set_value(std::move(o.rcvr));
+            }
+        }
+
+        static auto cancel_with(op_base &b) -> void {
+            auto &o = static_cast<op_state &>(b);
+            if (o.done) {
+                set_value(std::move(o.rcvr));
+            } else {
+                o.stop_cb.reset();
+                o.reactor->remove(o.fd);
+                set_stopped(std::move(o.rcvr));
+            }
+        }
+
+        epoll_reactor *reactor{};
+        int fd{};
+        std::uint32_t events{};
+        [[no_unique_address]] Rcvr rcvr;
+        bool done{};
+        std::atomic<bool> cancelling{};
+        [[no_unique_address]] stop_callback_t stop_cb{};
+
+        auto start() -> void {
+            if constexpr (not unstoppable_token<
+                              stop_token_of_t<env_of_t<Rcvr>>>) {
+                auto token = get_stop_token(get_env(rcvr));
+                if (token.stop_requested()) {
+                    set_stopped(std::move(rcvr));
+                    return;
+                }
+                stop_cb.emplace(token, stop_callback_fn{this});
+            }
+            if (auto const e = reactor->add(fd, events, this); e != 0) {
+                stop_cb.reset();
+                set_error(std::move(rcvr), static_cast<std::errc>(e));
+            }
+        }
+
+      private:
+        template <stdx::same_as_unqualified<op_state> O>
+        friend constexpr auto tag_invoke(start_t, O &&o) -> void {
+            o.start();
+        }
+    };
+
+  public:
+    // The sender of a readiness operation: it completes when the descriptor
+    // is ready (or has an error or hangup pending, which the next call on it
+    // reports).
+    struct sender {
+        using is_sender = void;
+        using completion_signatures =
+            async::completion_signatures<set_value_t(), set_error_t(std::errc),
+                                         set_stopped_t()>;
+
+        template <stdx::same_as_unqualified<sender> S, receiver R>
+        [[nodiscard]] friend constexpr auto tag_invoke(connect_t, S &&s, R &&r)
+            -> op_state<std::remove_cvref_t<R>> {
+            check_connect<S, R>();
+            return {s.reactor, s.fd, s.events, std::forward<R>(r)};
+        }
+
+        epoll_reactor *reactor;
+        int fd;
+        std::uint32_t events;
+    };
+
+    epoll_reactor()
+        : epoll_fd{::epoll_create1(EPOLL_CLOEXEC)},
+          wake_fd{::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)} {
+        auto ev = ::epoll_event{.events = EPOLLIN, .data = {.ptr = nullptr}};
+        ::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, wake_fd, &ev);
+    }
+    epoll_reactor(epoll_reactor &&) = delete;
+
+    ~epoll_reactor() {
+        ::close(wake_fd);
+        ::close(epoll_fd);
+    }
+
+    // Called by an idle run loop: unless work has already arrived, waits
+    // until it does or a descriptor is ready, and completes the operations
+    // that are ready.
+    template <typename Pred> auto wait(Pred &&work_arrived) -> void {
+        poll(work_arrived() ? 0 : -1);
+    }
+
+    auto notify() -> void {
+        std::uint64_t const one{1};
+        [[maybe_unused]] auto const r = ::write(wake_fd, &one, sizeof(one));
+    }
+
+    // Completes the operations that are ready, waiting up to timeout_ms
+    // milliseconds (forever if negative) for one to become ready.
+    auto poll(int timeout_ms = 0) -> void {
+        std::array<::epoll_event, 16> ready_events{};
+        auto const n = ::epoll_wait(epoll_fd, ready_events.data(),
+                                    static_cast<int>(ready_events.size()),
+                                    timeout_ms);
+        for (auto i = 0; i < n; ++i) {
+            auto const op = static_cast<op_base *>(ready_events[i].data.ptr);
+            if (op == nullptr) {
+                std::uint64_t count{};
+                [[maybe_unused]] auto const r =
+                    ::read(wake_fd, &count, sizeof(count));
+            } else {
+                op->ready(*op);
+            }
+        }
+        auto head = cancelled.exchange(nullptr, std::memory_order_acquire);
+        while (head != nullptr) {
+            auto const op = std::exchange(head, head->next);
+            op->cancel(*op);
+        }
+    }
+
+  private:
+    auto add(int fd, std::uint32_t events, op_base *op) -> int {
+        auto ev = ::epoll_event{
+            .events = static_cast<std::uint32_t>(events | EPOLLONESHOT),
+            .data = {.ptr = op}};
+        return ::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &ev) == 0 ? 0 : errno;
+    }
+
+    auto remove(int fd) -> void {
+        ::epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+    }
+
+    auto request_cancel(op_base *op) -> void {
+        auto head = cancelled.load(std::memory_order_relaxed);
+        do {
+            op->next = head;
+        } while (not cancelled.compare_exchange_weak(
+            head, op, std::memory_order_release, std::memory_order_relaxed));
+        notify();
+    }
+
+    int epoll_fd;
+    int wake_fd;
+    std::atomic<op_base *> cancelled{};
+};
+
+// Completes when the descriptor is ready to read.
+[[nodiscard]] inline auto fd_readable(epoll_reactor &r, int fd)
+    -> epoll_reactor::sender {
+    return {&r, fd, EPOLLIN};
+}
+
+// Completes when the descriptor is ready to write.
+[[nodiscard]] inline auto fd_writable(epoll_reactor &r, int fd)
+    -> epoll_reactor::sender {
+    return {&r, fd, EPOLLOUT};
+}
+} // namespace async
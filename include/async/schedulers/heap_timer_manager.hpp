@@ -0,0 +1,221 @@
+#pragma once
+
+#include <async/schedulers/timer_manager.hpp>
+#include <async/schedulers/timer_manager_interface.hpp>
+#include <conc/concurrency.hpp>
+
+#include <atomic>
+#include <concepts>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace async {
+namespace detail {
+template <typename T>
+concept heap_timer_hal = timer_hal<T> and requires(typename T::task_t &task) {
+    { task.child } -> std::convertible_to<typename T::task_t *>;
+};
+} // namespace detail
+
+namespace archetypes {
+struct heap_timer_hal : timer_hal {
+    using task_t = heap_timer_task<time_point_t>;
+};
+} // namespace archetypes
+static_assert(detail::heap_timer_hal<archetypes::heap_timer_hal>);
+
+// A timer manager that keeps tasks in an intrusive pairing heap, linked
+// through each task's child, next (sibling) and prev pointers. A task's prev
+// points at its left sibling, or at its parent if it is a first child.
+//
+// Inserting a task and finding the next task are O(1); removing the next
+// task, or cancelling any task, is amortized O(log n). Unlike
+// generic_timer_manager, tasks with the same expiry time may run in any
+// order.
+template <detail::heap_timer_hal H> struct heap_timer_manager {
+    using time_point_t = typename H::time_point_t;
+    using duration_t =
+        decltype(std::declval<time_point_t>() - std::declval<time_point_t>());
+    using task_t = typename H::task_t;
+
+  private:
+    struct mutex;
+    task_t *root{};
+    std::atomic<int> task_count{};
+
+    [[nodiscard]] static auto as_task(auto *p) -> task_t * {
+        return static_cast<task_t *>(p);
+    }
+
+    // the earlier root stays on top when expiry times are equal
+    [[nodiscard]] static auto meld(task_t *a, task_t *b) -> task_t * {
+        if (a == nullptr) {
+            return b;
+        }
+        if (b == nullptr) {
+            return a;
+        }
+        if (b->expiration_time < a->expiration_time) {
+            std::swap(a, b);
+        }
+        b->prev = a;
+        b->next = a->child;
+        if (a->child != nullptr) {
+            a->child->prev = b;
+        }
+        a->child = b;
+        a->next = a->prev = nullptr;
+        return a;
+    }
+
+    // the standard two-pass merge of a list of siblings
+    [[nodiscard]] static auto merge_pairs(task_t *first) -> task_t * {
+        task_t *pairs{};
+        while (first != nullptr) {
+            auto const second = as_task(first->next);
+            auto const rest =
+                second == nullptr ? nullptr : as_task(second->next);
+            first->next = first->prev = nullptr;
+            if (second != nullptr) {
+                second->next = second->prev = nullptr;
+            }
+            auto const m = meld(first, second);
+            m->next = pairs;
+            pairs = m;
+            first = rest;
+        }
+        task_t *result{};
+        while (pairs != nullptr) {
+            auto const next = as_task(pairs->next);
+            pairs->next = nullptr;
+            result = meld(result, pairs);
+            pairs = next;
+        }
+        return result;
+    }
+
+    auto set_root(task_t *r) -> void {
+        root = r;
+        if (root == nullptr) {
+            H::disable();
+        } else {
+            H::set_event_time(root->expiration_time);
+        }
+    }
+
+    auto remove(task_t *t) -> void {
+        if (t == root) {
+            set_root(merge_pairs(as_task(std::exchange(t->child, nullptr))));
+            return;
+        }
+        auto const prev = as_task(t->prev);
+        if (prev->child == t) {
+            prev->child = t->next;
+        } else {
+            prev->next = t->next;
+        }
+        if (t->next != nullptr) {
+            t->next->prev = prev;
+        }
+        t->next = t->prev = nullptr;
+        auto const children =
+            merge_pairs(as_task(std::exchange(t->child, nullptr)));
+        set_root(meld(root, children));
+    }
+
+    auto insert(task_t *t) -> void {
+        auto const was_empty = root == nullptr;
+        auto const r = meld(root, t);
+        if (r != root) {
+            set_root(r);
+        }
+        if (was_empty) {
+            H::enable();
+        }
+    }
+
+  public:
+    constexpr static auto create_task = async::create_task<task_t>;
+
+    template <std::derived_from<task_t> T, std::convertible_to<duration_t> D>
+    auto run_after(T &t, D d) -> bool {
+        return conc::call_in_critical_section<mutex>([&]() -> bool {
+            if (auto const added = not std::exchange(t.pending, true); added) {
+                ++task_count;
+                t.expiration_time = H::now() + static_cast<duration_t>(d);
+                insert(std::addressof(t));
+                return true;
+            }
+            return false;
+        });
+    }
+
+    template <std::derived_from<task_t> T,
+              std::convertible_to<time_point_t> TP>
+    auto run_at(T &t, TP tp) -> bool {
+        return conc::call_in_critical_section<mutex>([&]() -> bool {
+            if (auto const added = not std::exchange(t.pending, true); added) {
+                ++task_count;
+                t.expiration_time = static_cast<time_point_t>(tp);
+                insert(std::addressof(t));
+                return true;
+            }
+            return false;
+        });
+    }
+
+    template <typename T, typename D> auto run_after(T const &, D) -> bool {
+        static_assert(stdx::always_false_v<D>,
+                      "Invalid duration type: did you forget to specialize "
+                      "async::timer_mgr::time_point_for?");
+        return false;
+    }
+
+    auto cancel(task_t &t) -> bool {
+        return conc::call_in_critical_section<mutex>([&]() -> bool {
+            if (t.pending) {
+                remove(std::addressof(t));
+                t.pending = false;
+                --task_count;
+                return true;
+            }
+            return false;
+        });
+    }
+
+    auto service_task() -> void {
+        if (auto t = conc::call_in_critical_section<mutex>([&]() -> task_t * {
+                if (root == nullptr) {
+                    return nullptr;
+                }
+                auto const n = root;
+                remove(n);
+                n->pending = false;
+                return n;
+            });
+            t != nullptr) {
+            t->run();
+            --task_count;
+        }
+    }
+
+    [[nodiscard]] auto next_expiration() const -> std::optional<time_point_t> {
+        return conc::call_in_critical_section<mutex>(
+            [&]() -> std::optional<time_point_t> {
+                if (root == nullptr) {
+                    return std::nullopt;
+                }
+                return root->expiration_time;
+            });
+    }
+
+    [[nodiscard]] auto time_until_next() const -> std::optional<duration_t> {
+        return detail::time_until<H, duration_t>(next_expiration());
+    }
+
+    [[nodiscard]] auto is_idle() const -> bool { return task_count == 0; }
+};
+static_assert(timer_manager<heap_timer_manager<archetypes::heap_timer_hal>>);
+} // namespace async
@@ -0,0 +1,109 @@
+#pragma once
+
+#if not __has_include(<thread>)
+#error async::hosted_timer_hal is unavailable: <thread> does not exist
+#endif
+
+#include <async/schedulers/timer_manager_interface.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace async {
+// A timer HAL for hosted builds, driven by std::chrono::steady_clock. While a
+// service_thread exists, it plays the part of the timer interrupt: it sleeps
+// on a condition variable until the programmed event time and then services
+// the timer manager of the given domain. Like a hardware compare, an event
+// fires once per call to set_event_time.
+//
+// When the injected timer manager has service_expired, every expired task is
+// run in one wakeup; otherwise service_task is called.
+template <typename Domain = timer_mgr::default_domain>
+struct hosted_timer_hal {
+    using clock_t = std::chrono::steady_clock;
+    using time_point_t = clock_t::time_point;
+    using task_t = timer_task<time_point_t>;
+
+  private:
+    static inline std::mutex m{};
+    static inline std::condition_variable cv{};
+    static inline time_point_t event_time{};
+    static inline bool enabled{};
+    static inline bool armed{};
+    static inline bool stopping{};
+
+    template <typename... DummyArgs> static auto service() -> void {
+        auto &mgr =
+            timer_mgr::detail::get_injected_manager<Domain, DummyArgs...>();
+        if constexpr (requires { mgr.service_expired(); }) {
+            mgr.service_expired();
+        } else {
+            mgr.service_task();
+        }
+    }
+
+    static auto run() -> void {
+        std::unique_lock l{m};
+        while (not stopping) {
+            if (not enabled or not armed) {
+                cv.wait(l);
+            } else if (auto const tp = event_time; now() < tp) {
+                cv.wait_until(l, tp);
+            } else {
+                armed = false;
+                l.unlock();
+                service();
+                l.lock();
+            }
+        }
+    }
+
+  public:
+    [[nodiscard]] static auto now() -> time_point_t { return clock_t::now(); }
+
+    static auto enable() -> void {
+        {
+            std::lock_guard l{m};
+            enabled = true;
+        }
+        cv.notify_one();
+    }
+
+    static auto disable() -> void {
+        std::lock_guard l{m};
+        enabled = false;
+    }
+
+    static auto set_event_time(time_point_t tp) -> void {
+        {
+            std::lock_guard l{m};
+            event_time = tp;
+            armed = true;
+        }
+        cv.notify_one();
+    }
+
+    // The thread that services timer events. Only one may exist at a time
+    // for each domain.
+    // NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+    class service_thread {
+        std::thread t{[] { run(); }};
+
+      public:
+        service_thread() = default;
+        service_thread(service_thread &&) = delete;
+
+        ~service_thread() {
+            {
+                std::lock_guard l{m};
+                stopping = true;
+            }
+            cv.notify_one();
+            t.join();
+            stopping = false;
+        }
+    };
+};
+} // namespace async
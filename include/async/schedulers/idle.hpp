@@ -0,0 +1,25 @@
+#pragma once
+
+#include <async/schedulers/task_manager_interface.hpp>
+#include <async/schedulers/timer_manager_interface.hpp>
+
+#include <optional>
+
+namespace async {
+// How long a low-power loop may sleep: zero while the task manager has work,
+// otherwise the time until the next timer in the given domain expires, or
+// nullopt when no timer is queued and only an external interrupt can wake
+// the system.
+template <typename TimerDomain = timer_mgr::default_domain,
+          typename... DummyArgs>
+    requires(sizeof...(DummyArgs) == 0)
+[[nodiscard]] auto max_sleep_duration() {
+    using duration_t = typename decltype(timer_mgr::time_until_next<
+                                         TimerDomain, DummyArgs...>())::
+        value_type;
+    if (not task_mgr::is_idle<DummyArgs...>()) {
+        return std::optional<duration_t>{duration_t{}};
+    }
+    return timer_mgr::time_until_next<TimerDomain, DummyArgs...>();
+}
+} // namespace async
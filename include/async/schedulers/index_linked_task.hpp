@@ -0,0 +1,238 @@
+#pragma once
+
+#include <async/schedulers/task.hpp>
+
+#include <stdx/bit.hpp>
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+
+namespace async {
+// A region of RAM that holds every task of a kind that is linked by index: for
+// instance, the section in which static_allocator storage is placed. A link is
+// the offset of a task from base() in units of granularity, so with a
+// granularity of 4, 16-bit links reach 256 KiB. Every task so linked must lie
+// in the region at a multiple of the granularity.
+template <typename R>
+concept link_region = requires {
+    { R::base() } -> std::convertible_to<std::uintptr_t>;
+    { R::granularity } -> std::convertible_to<std::size_t>;
+};
+
+// A link that is stored as an index but reads and writes like a pointer.
+template <typename T, link_region Region, std::unsigned_integral Index>
+class index_link {
+    constexpr static auto null = std::numeric_limits<Index>::max();
+    Index idx{null};
+
+    [[nodiscard]] static auto encode(T const *t) -> Index {
+        if (t == nullptr) {
+            return null;
+        }
+        auto const offset = stdx::bit_cast<std::uintptr_t>(t) -
+                            static_cast<std::uintptr_t>(Region::base());
+        return static_cast<Index>(offset / Region::granularity);
+    }
+
+    [[nodiscard]] static auto decode(Index i) -> T * {
+        if (i == null) {
+            return nullptr;
+        }
+        auto const base = static_cast<std::uintptr_t>(Region::base());
+        return stdx::bit_cast<T *>(base +
+                                   std::uintptr_t{i} * Region::granularity);
+    }
+
+  public:
+    constexpr index_link() = default;
+    // NOLINTNEXTLINE(google-explicit-constructor)
+    index_link(T *t) : idx{encode(t)} {}
+
+    auto operator=(T *t) -> index_link & {
+        idx = encode(t);
+        return *this;
+    }
+
+    [[nodiscard]] auto get() const -> T * { return decode(idx); }
+    // NOLINTNEXTLINE(google-explicit-constructor)
+    operator T *() const { return get(); }
+    auto operator->() const -> T * { return get(); }
+    auto operator*() const -> T & { return *get(); }
+};
+
+// NOLINTNEXTLINE(*-special-member-functions)
+template <std::derived_from<task_base> Base, link_region Region,
+          std::unsigned_integral Index = std::uint16_t>
+struct index_single_linked_task : Base {
+    using link_t = index_link<index_single_linked_task, Region, Index>;
+
+    using Base::Base;
+    constexpr index_single_linked_task(index_single_linked_task &&) = delete;
+    link_t next{};
+};
+
+// NOLINTNEXTLINE(*-special-member-functions)
+template <std::derived_from<task_base> Base, link_region Region,
+          std::unsigned_integral Index = std::uint16_t>
+struct index_double_linked_task : Base {
+    using link_t = index_link<index_double_linked_task, Region, Index>;
+
+    using Base::Base;
+    constexpr index_double_linked_task(index_double_linked_task &&) = delete;
+    link_t next{};
+    link_t prev{};
+};
+
+template <typename T>
+concept index_single_linkable = requires(T *t) {
+    typename T::link_t;
+    requires std::same_as<decltype(t->next), typename T::link_t>;
+};
+
+template <typename T>
+concept index_double_linkable =
+    index_single_linkable<T> and requires(T *t) {
+        requires std::same_as<decltype(t->prev), typename T::link_t>;
+    };
+
+// A FIFO queue of index-linked tasks, with the part of the interface of
+// stdx::intrusive_forward_list that the task managers use.
+template <index_single_linkable T> class index_forward_list {
+    T *head{};
+    T *tail{};
+
+  public:
+    [[nodiscard]] constexpr auto empty() const -> bool {
+        return head == nullptr;
+    }
+
+    [[nodiscard]] constexpr auto front() const -> T & { return *head; }
+
+    auto push_back(T *t) -> void {
+        t->next = nullptr;
+        if (tail == nullptr) {
+            head = t;
+        } else {
+            tail->next = t;
+        }
+        tail = t;
+    }
+
+    auto pop_front() -> T * {
+        auto const t = head;
+        head = t->next;
+        if (head == nullptr) {
+            tail = nullptr;
+        }
+        t->next = nullptr;
+        return t;
+    }
+};
+
+// A list of index-linked tasks, with the part of the interface of
+// stdx::intrusive_list that the timer managers use.
+template <index_double_linkable T> class index_list {
+    T *head{};
+    T *tail{};
+
+  public:
+    class iterator {
+        T *node{};
+
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = T;
+        using pointer = T *;
+        using reference = T &;
+
+        constexpr iterator() = default;
+        constexpr explicit(true) iterator(T *t) : node{t} {}
+
+        [[nodiscard]] constexpr auto get() const -> T * { return node; }
+        auto operator*() const -> T & { return *node; }
+        auto operator->() const -> T * { return node; }
+
+        auto operator++() -> iterator & {
+            node = node->next;
+            return *this;
+        }
+        auto operator++(int) -> iterator {
+            auto const it = *this;
+            ++*this;
+            return it;
+        }
+
+      private:
+        [[nodiscard]] friend constexpr auto operator==(iterator, iterator)
+            -> bool = default;
+    };
+
+    [[nodiscard]] constexpr auto begin() const -> iterator {
+        return iterator{head};
+    }
+    [[nodiscard]] constexpr auto end() const -> iterator { return {}; }
+
+    [[nodiscard]] constexpr auto empty() const -> bool {
+        return head == nullptr;
+    }
+
+    [[nodiscard]] constexpr auto front() const -> T & { return *head; }
+
+    auto push_back(T *t) -> void {
+        t->prev = tail;
+        t->next = nullptr;
+        if (tail == nullptr) {
+            head = t;
+        } else {
+            tail->next = t;
+        }
+        tail = t;
+    }
+
+    // Inserts t before pos.
+    auto insert(iterator pos, T *t) -> void {
+        auto const next = pos.get();
+        if (next == nullptr) {
+            push_back(t);
+            return;
+        }
+        T *const prev = next->prev;
+        t->prev = prev;
+        t->next = next;
+        next->prev = t;
+        if (prev == nullptr) {
+            head = t;
+        } else {
+            prev->next = t;
+        }
+    }
+
+    auto remove(T *t) -> void {
+        T *const next = t->next;
+        T *const prev = t->prev;
+        if (prev == nullptr) {
+            head = next;
+        } else {
+            prev->next = next;
+        }
+        if (next == nullptr) {
+            tail = prev;
+        } else {
+            next->prev = prev;
+        }
+        t->next = nullptr;
+        t->prev = nullptr;
+    }
+
+    auto pop_front() -> T * {
+        auto const t = head;
+        remove(t);
+        return t;
+    }
+};
+} // namespace async
@@ -6,11 +6,13 @@
 #include <async/env.hpp>
 #include <async/stack_allocator.hpp>
 #include <async/tags.hpp>
+#include <async/trace.hpp>
 #include <async/type_traits.hpp>
 
 #include <stdx/concepts.hpp>
 
 #include <concepts>
+#include <memory>
 #include <type_traits>
 #include <utility>
 
@@ -22,8 +24,14 @@ class inline_scheduler {
       private:
         template <stdx::same_as_unqualified<op_state> O>
         friend constexpr auto tag_invoke(start_t, O &&o) -> void {
+            detail::trace<trace_kind::inline_scheduler, start_t>(
+                o.receiver, std::addressof(o));
+            detail::trace<trace_kind::inline_scheduler, set_value_t>(
+                o.receiver, std::addressof(o));
             set_value(std::forward<O>(o).receiver);
         }
+
+        friend constexpr auto tag_invoke(restart_t, op_state &) -> void {}
     };
 
     class env {
@@ -76,6 +84,8 @@ class inline_scheduler {
         -> bool = default;
 
   public:
+    using elides_redundant_hops = void;
+
     struct singleshot;
     struct multishot;
 
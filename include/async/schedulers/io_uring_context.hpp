@@ -0,0 +1,554 @@
+#pragma once
+
+#if not __has_include(<linux/io_uring.h>)
+#error async::io_uring_context is unavailable: <linux/io_uring.h> does not exist
+#endif
+
+#include <async/completion_scheduler.hpp>
+#include <async/concepts.hpp>
+#include <async/env.hpp>
+#include <async/stop_token.hpp>
+#include <async/tags.hpp>
+#include <async/type_traits.hpp>
+
+#include <stdx/concepts.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace async {
+// An I/O context for hosted Linux builds, driven by an io_uring. Operations
+// may be started from any thread. The thread that calls run takes every
+// operation started since it last woke, writes a submission queue entry (SQE)
+// for each, and submits the batch with one io_uring_enter, which also waits
+// for completions. An operation state is its own SQE user_data, so nothing is
+// allocated, and reads and writes use the caller's buffers directly.
+//
+// The rings are set up with the raw system calls; liburing is not needed.
+// Where the kernel does not provide io_uring, the context is not valid.
+// NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+class io_uring_context {
+  public:
+    // The fields of an SQE that an operation sets.
+    struct sqe_args {
+        std::uint8_t opcode{IORING_OP_NOP};
+        int fd{-1};
+        std::uint64_t addr{};
+        std::uint32_t len{};
+        std::uint64_t off{};
+    };
+
+    // The offset with which reads and writes use (and advance) the file
+    // position, as for a pipe or a socket.
+    constexpr static auto current_position = ~std::uint64_t{};
+
+  private:
+    struct op_base {
+        using complete_fn = auto (*)(op_base &, int) -> void;
+
+        complete_fn complete;
+        sqe_args args{};
+        op_base *next{};
+    };
+
+    [[nodiscard]] static auto user_data(op_base const *op) -> std::uint64_t {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        return reinterpret_cast<std::uintptr_t>(op);
+    }
+
+    // NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+    template <typename Rcvr> struct schedule_op_state : op_base {
+        template <typename R>
+        schedule_op_state(io_uring_context *c, R &&r)
+            : op_base{complete_with}, ctx{c}, rcvr{std::forward<R>(r)} {}
+        schedule_op_state(schedule_op_state &&) = delete;
+
+        static auto complete_with(op_base &b, int) -> void {
+            auto &o = static_cast<schedule_op_state &>(b);
+            if (get_stop_token(get_env(o.rcvr)).stop_requested()) {
+                set_stopped(std::move(o.rcvr));
+            } else {
+                set_value(std::move(o.rcvr));
+            }
+        }
+
+        io_uring_context *ctx{};
+        [[no_unique_address]] Rcvr rcvr;
+
+      private:
+        template <stdx::same_as_unqualified<schedule_op_state> O>
+        friend constexpr auto tag_invoke(start_t, O &&o) -> void {
+            o.ctx->push_back(std::addressof(o));
+        }
+    };
+
+    // A stop request submits an IORING_OP_ASYNC_CANCEL for the operation.
+    // The operation completes once the kernel has answered both, so neither
+    // SQE outlives it. A cancel that overtakes its operation (which is not yet
+    // submitted) is resubmitted behind it.
+    // NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+    template <typename Value, typename Rcvr> struct io_op_state : op_base {
+        struct cancel_op : op_base {
+            io_op_state *owner;
+        };
+
+        struct stop_callback_fn {
+            auto operator()() -> void { o->request_cancel(); }
+            io_op_state *o;
+        };
+
+        using stop_callback_t = optional_stop_callback_t<
+            stop_token_of_t<env_of_t<Rcvr>>, stop_callback_fn>;
+
+        template <typename R>
+        io_op_state(io_uring_context *c, sqe_args a, R &&r)
+            : op_base{complete_with, a}, ctx{c}, rcvr{std::forward<R>(r)},
+              cancel{{cancel_done_with,
+                      {IORING_OP_ASYNC_CANCEL, -1,
+                       user_data(static_cast<op_base *>(this))}},
+                     this} {}
+        io_op_state(io_op_state &&) = delete;
+
+        auto request_cancel() -> void {
+            cancelling.store(true);
+            ctx->push_back(std::addressof(cancel));
+        }
+
+        static auto complete_with(op_base &b, int res) -> void {
+            auto &o = static_cast<io_op_state &>(b);
+            o.stop_cb.reset();
+            o.result = res;
+            o.done = true;
+            if (not o.cancelling.load() or o.cancel_done) {
+                o.deliver();
+            }
+        }
+
+        static auto cancel_done_with(op_base &b, int res) -> void {
+            auto &o = *static_cast<cancel_op &>(b).owner;
+            if (res == -ENOENT and not o.done) {
+                o.ctx->push_back(std::addressof(o.cancel));
+                return;
+            }
+            o.cancel_done = true;
+            if (o.done) {
+                o.deliver();
+            }
+        }
+
+        auto deliver() -> void {
+            if (result >= 0) {
+                set_value(std::move(rcvr), static_cast<Value>(result));
+            } else if (result == -ECANCELED and cancelling.load()) {
+                set_stopped(std::move(rcvr));
+            } else {
+                set_error(std::move(rcvr), static_cast<std::errc>(-result));
+            }
+        }
+
+        io_uring_context *ctx{};
+        [[no_unique_address]] Rcvr rcvr;
+        cancel_op cancel;
+        int result{};
+        bool done{};
+        bool cancel_done{};
+        std::atomic<bool> cancelling{};
+        [[no_unique_address]] stop_callback_t stop_cb{};
+
+      private:
+        template <stdx::same_as_unqualified<io_op_state> O>
+        friend constexpr auto tag_invoke(start_t, O &&o) -> void {
+            if constexpr (not unstoppable_token<
+                              stop_token_of_t<env_of_t<Rcvr>>>) {
+                auto token = get_stop_token(get_env(o.rcvr));
+                if (token.stop_requested()) {
+                    set_stopped(std::move(o.rcvr));
+                    return;
+                }
+                o.stop_cb.emplace(token, stop_callback_fn{std::addressof(o)});
+            }
+            o.ctx->push_back(std::addressof(o));
+        }
+    };
+
+  public:
+    struct scheduler {
+        struct env {
+            [[nodiscard]] friend constexpr auto
+            tag_invoke(get_completion_scheduler_t<set_value_t>, env e) noexcept
+                -> scheduler {
+                return {e.ctx};
+            }
+            io_uring_context *ctx;
+        };
+
+        struct sender {
+            using is_sender = void;
+            using completion_signatures =
+                async::completion_signatures<set_value_t(), set_stopped_t()>;
+
+            [[nodiscard]] friend constexpr auto tag_invoke(get_env_t,
+                                                           sender s) noexcept
+                -> env {
+                return {s.ctx};
+            }
+
+            template <stdx::same_as_unqualified<sender> S, receiver R>
+            [[nodiscard]] friend constexpr auto tag_invoke(connect_t, S &&s,
+                                                           R &&r)
+                -> schedule_op_state<std::remove_cvref_t<R>> {
+                check_connect<S, R>();
+                return {s.ctx, std::forward<R>(r)};
+            }
+
+            io_uring_context *ctx;
+        };
+
+        [[nodiscard]] constexpr auto schedule() -> sender { return {ctx}; }
+
+        template <typename T>
+        [[nodiscard]] friend constexpr auto operator==(scheduler x, T const &y)
+            -> bool {
+            if constexpr (std::same_as<T, scheduler>) {
+                return x.ctx == y.ctx;
+            }
+            return false;
+        }
+
+        io_uring_context *ctx;
+    };
+
+    // The sender of one I/O operation: it completes with the (non-negative)
+    // result of the operation, with the error it failed with, or with
+    // set_stopped if it was cancelled by a stop request.
+    template <typename Value> struct io_sender {
+        using is_sender = void;
+        using completion_signatures =
+            async::completion_signatures<set_value_t(Value),
+                                         set_error_t(std::errc),
+                                         set_stopped_t()>;
+
+        [[nodiscard]] friend constexpr auto tag_invoke(get_env_t,
+                                                       io_sender s) noexcept
+            -> scheduler::env {
+            return {s.ctx};
+        }
+
+        template <stdx::same_as_unqualified<io_sender> S, receiver R>
+        [[nodiscard]] friend constexpr auto tag_invoke(connect_t, S &&s, R &&r)
+            -> io_op_state<Value, std::remove_cvref_t<R>> {
+            check_connect<S, R>();
+            return {s.ctx, s.args, std::forward<R>(r)};
+        }
+
+        io_uring_context *ctx;
+        sqe_args args;
+    };
+
+    explicit io_uring_context(unsigned entries = 64) {
+        ::io_uring_params p{};
+        auto const fd = ::syscall(__NR_io_uring_setup, entries, &p);
+        if (fd < 0) {
+            return;
+        }
+        ring_fd = static_cast<int>(fd);
+
+        sq_size = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+        cq_size = p.cq_off.cqes + p.cq_entries * sizeof(::io_uring_cqe);
+        auto const single_mmap = (p.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single_mmap) {
+            sq_size = cq_size = std::max(sq_size, cq_size);
+        }
+        sq_ptr = map(sq_size, IORING_OFF_SQ_RING);
+        cq_ptr = single_mmap ? sq_ptr : map(cq_size, IORING_OFF_CQ_RING);
+        sqes_size = p.sq_entries * sizeof(::io_uring_sqe);
+        sqes_ptr = map(sqes_size, IORING_OFF_SQES);
+        wake_fd = ::eventfd(0, EFD_CLOEXEC);
+        if (sq_ptr == MAP_FAILED or cq_ptr == MAP_FAILED or
+            sqes_ptr == MAP_FAILED or wake_fd < 0) {
+            release();
+            return;
+        }
+
+        sq_head = at<unsigned>(sq_ptr, p.sq_off.head);
+        sq_tail = at<unsigned>(sq_ptr, p.sq_off.tail);
+        sq_mask = *at<unsigned>(sq_ptr, p.sq_off.ring_mask);
+        sq_array = at<unsigned>(sq_ptr, p.sq_off.array);
+        sq_entries = p.sq_entries;
+        sqes = static_cast<::io_uring_sqe *>(sqes_ptr);
+        cq_head = at<unsigned>(cq_ptr, p.cq_off.head);
+        cq_tail = at<unsigned>(cq_ptr, p.cq_off.tail);
+        cq_mask = *at<unsigned>(cq_ptr, p.cq_off.ring_mask);
+        cqes = at<::io_uring_cqe>(cq_ptr, p.cq_off.cqes);
+        wake_op.args = {IORING_OP_READ, wake_fd, user_data_of(wake_count),
+                        sizeof(wake_count), 0};
+    }
+    io_uring_context(io_uring_context &&) = delete;
+
+    // No operation may be in flight when the context is destroyed.
+    ~io_uring_context() { release(); }
+
+    [[nodiscard]] auto valid() const -> bool { return ring_fd >= 0; }
+
+    auto get_scheduler() -> scheduler { return {this}; }
+
+    // Makes run return once every operation started so far has completed.
+    auto finish() -> void {
+        finish_requested.store(true);
+        if (sleeping.load()) {
+            wake();
+        }
+    }
+
+    // Submits and completes operations until finish is called and nothing is
+    // left in flight. Operations started by completions on this thread join
+    // the next batch.
+    auto run() -> void {
+        if (not std::exchange(wake_armed, true)) {
+            queue_front(std::addressof(wake_op));
+        }
+        while (true) {
+            take_incoming();
+            fill_sqes();
+            auto const idle = in_flight == 0 and pending == nullptr;
+            if (idle and finish_requested.load()) {
+                enter(0);
+                return;
+            }
+            sleeping.store(true);
+            auto const wait = incoming.load() == nullptr and
+                              not(idle and finish_requested.load());
+            enter(wait ? 1 : 0);
+            sleeping.store(false, std::memory_order_relaxed);
+            reap();
+        }
+    }
+
+    auto push_back(op_base *op) -> void {
+        auto head = incoming.load(std::memory_order_relaxed);
+        do {
+            op->next = head;
+        } while (not incoming.compare_exchange_weak(
+            head, op, std::memory_order_seq_cst, std::memory_order_relaxed));
+        if (sleeping.load()) {
+            wake();
+        }
+    }
+
+  private:
+    template <typename T>
+    [[nodiscard]] static auto at(void *base, std::uint32_t offset) -> T * {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        return reinterpret_cast<T *>(static_cast<std::byte *>(base) + offset);
+    }
+
+    template <typename T>
+    [[nodiscard]] static auto user_data_of(T &t) -> std::uint64_t {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        return reinterpret_cast<std::uintptr_t>(std::addressof(t));
+    }
+
+    [[nodiscard]] auto map(std::size_t size, std::uint64_t offset) const
+        -> void * {
+        return ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, ring_fd,
+                      static_cast<off_t>(offset));
+    }
+
+    auto release() -> void {
+        if (sqes_ptr != MAP_FAILED) {
+            ::munmap(sqes_ptr, sqes_size);
+        }
+        if (cq_ptr != MAP_FAILED and cq_ptr != sq_ptr) {
+            ::munmap(cq_ptr, cq_size);
+        }
+        if (sq_ptr != MAP_FAILED) {
+            ::munmap(sq_ptr, sq_size);
+        }
+        sqes_ptr = cq_ptr = sq_ptr = MAP_FAILED;
+        if (wake_fd >= 0) {
+            ::close(wake_fd);
+            wake_fd = -1;
+        }
+        if (ring_fd >= 0) {
+            ::close(ring_fd);
+            ring_fd = -1;
+        }
+    }
+
+    auto wake() const -> void {
+        std::uint64_t const one{1};
+        [[maybe_unused]] auto const r = ::write(wake_fd, &one, sizeof(one));
+    }
+
+    auto queue_front(op_base *op) -> void {
+        op->next = pending;
+        pending = op;
+        if (pending_tail == nullptr) {
+            pending_tail = op;
+        }
+    }
+
+    // Producers push onto an atomic LIFO stack; the run thread takes the
+    // whole stack at once and appends it, reversed, to its FIFO of operations
+    // waiting for room in the submission queue.
+    auto take_incoming() -> void {
+        auto head = incoming.exchange(nullptr, std::memory_order_acquire);
+        op_base *fifo{};
+        auto const last = head;
+        while (head != nullptr) {
+            auto const next = head->next;
+            head->next = fifo;
+            fifo = std::exchange(head, next);
+        }
+        if (fifo == nullptr) {
+            return;
+        }
+        if (pending_tail == nullptr) {
+            pending = fifo;
+        } else {
+            pending_tail->next = fifo;
+        }
+        pending_tail = last;
+    }
+
+    auto fill_sqes() -> void {
+        auto tail = *sq_tail;
+        auto const head =
+            std::atomic_ref{*sq_head}.load(std::memory_order_acquire);
+        while (pending != nullptr and tail - head < sq_entries) {
+            auto const op = std::exchange(pending, pending->next);
+            auto const index = tail & sq_mask;
+            auto &sqe = sqes[index];
+            sqe = {};
+            sqe.opcode = op->args.opcode;
+            sqe.fd = op->args.fd;
+            sqe.addr = op->args.addr;
+            sqe.len = op->args.len;
+            sqe.off = op->args.off;
+            sqe.user_data = user_data(op);
+            sq_array[index] = index;
+            ++tail;
+            ++to_submit;
+            if (op != std::addressof(wake_op)) {
+                ++in_flight;
+            }
+        }
+        if (pending == nullptr) {
+            pending_tail = nullptr;
+        }
+        std::atomic_ref{*sq_tail}.store(tail, std::memory_order_release);
+    }
+
+    auto enter(unsigned min_complete) -> void {
+        auto const flags = min_complete > 0 ? IORING_ENTER_GETEVENTS : 0u;
+        auto const r = ::syscall(__NR_io_uring_enter, ring_fd, to_submit,
+                                 min_complete, flags, nullptr, 0);
+        if (r > 0) {
+            to_submit -= static_cast<unsigned>(r);
+        }
+    }
+
+    auto reap() -> void {
+        auto head = *cq_head;
+        auto const tail =
+            std::atomic_ref{*cq_tail}.load(std::memory_order_acquire);
+        while (head != tail) {
+            auto const &cqe = cqes[head & cq_mask];
+            // NOLINTNEXTLINE(performance-no-int-to-ptr)
+            auto const op = reinterpret_cast<op_base *>(cqe.user_data);
+            auto const res = cqe.res;
+            std::atomic_ref{*cq_head}.store(++head, std::memory_order_release);
+            if (op == std::addressof(wake_op)) {
+                queue_front(op);
+            } else {
+                --in_flight;
+                op->complete(*op, res);
+            }
+        }
+    }
+
+    constexpr static op_base::complete_fn complete_nothing =
+        [](op_base &, int) {};
+
+    int ring_fd{-1};
+    int wake_fd{-1};
+    void *sq_ptr{MAP_FAILED};
+    void *cq_ptr{MAP_FAILED};
+    void *sqes_ptr{MAP_FAILED};
+    std::size_t sq_size{};
+    std::size_t cq_size{};
+    std::size_t sqes_size{};
+
+    unsigned *sq_head{};
+    unsigned *sq_tail{};
+    unsigned *sq_array{};
+    unsigned sq_mask{};
+    unsigned sq_entries{};
+    ::io_uring_sqe *sqes{};
+    unsigned *cq_head{};
+    unsigned *cq_tail{};
+    unsigned cq_mask{};
+    ::io_uring_cqe *cqes{};
+
+    std::atomic<op_base *> incoming{};
+    op_base *pending{};
+    op_base *pending_tail{};
+    unsigned to_submit{};
+    std::size_t in_flight{};
+    std::atomic<bool> finish_requested{};
+    std::atomic<bool> sleeping{};
+
+    // A read of the eventfd is kept in flight, so that a push from another
+    // thread can wake the run thread from io_uring_enter.
+    op_base wake_op{complete_nothing};
+    std::uint64_t wake_count{};
+    bool wake_armed{};
+};
+
+// Reads into the buffer, completing with the number of bytes read (0 at end
+// of file).
+[[nodiscard]] inline auto
+async_read(io_uring_context &ctx, int fd, std::span<std::byte> buffer,
+           std::uint64_t offset = io_uring_context::current_position)
+    -> io_uring_context::io_sender<std::size_t> {
+    return {&ctx,
+            {IORING_OP_READ, fd,
+             // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+             reinterpret_cast<std::uintptr_t>(buffer.data()),
+             static_cast<std::uint32_t>(buffer.size()), offset}};
+}
+
+// Writes from the buffer, completing with the number of bytes written.
+[[nodiscard]] inline auto
+async_write(io_uring_context &ctx, int fd, std::span<std::byte const> buffer,
+            std::uint64_t offset = io_uring_context::current_position)
+    -> io_uring_context::io_sender<std::size_t> {
+    return {&ctx,
+            {IORING_OP_WRITE, fd,
+             // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+             reinterpret_cast<std::uintptr_t>(buffer.data()),
+             static_cast<std::uint32_t>(buffer.size()), offset}};
+}
+
+// Accepts a connection on a listening socket, completing with the file
+// descriptor of the connected socket.
+[[nodiscard]] inline auto async_accept(io_uring_context &ctx, int fd)
+    -> io_uring_context::io_sender<int> {
+    return {&ctx, {IORING_OP_ACCEPT, fd}};
+}
+} // namespace async
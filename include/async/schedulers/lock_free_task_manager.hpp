@@ -0,0 +1,94 @@
+#pragma once
+
+#include <async/schedulers/task_manager.hpp>
+#include <async/schedulers/task_manager_interface.hpp>
+
+#include <stdx/intrusive_forward_list.hpp>
+
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace async {
+// A task manager whose enqueue path never enters a critical section: each
+// priority is an intrusive MPSC stack built on the task's next pointer. The
+// single consumer in service_tasks<P> takes the whole stack with one exchange
+// and restores FIFO order before running the batch.
+template <detail::scheduler_hal S, std::size_t NumPriorities,
+          prioritizable_task Task = priority_task>
+    requires stdx::single_linkable<Task>
+struct lock_free_task_manager {
+    using task_t = Task;
+
+  private:
+    std::array<std::atomic<task_t *>, NumPriorities> task_stacks{};
+    std::atomic<int> task_count{};
+
+    [[nodiscard]] static auto next_of(task_t const &t) -> task_t * {
+        return static_cast<task_t *>(t.next);
+    }
+
+    template <priority_t P> auto take_batch() -> task_t * {
+        auto stack =
+            task_stacks[P].exchange(nullptr, std::memory_order_acquire);
+        task_t *batch{};
+        while (stack != nullptr) {
+            auto const next = next_of(*stack);
+            stack->next = batch;
+            batch = std::exchange(stack, next);
+        }
+        return batch;
+    }
+
+  public:
+    constexpr static auto create_task = async::create_task<task_t>;
+
+    auto enqueue_task(task_t &t, priority_t p) -> bool {
+        if (std::atomic_ref{t.pending}.exchange(true,
+                                                std::memory_order_acq_rel)) {
+            return false;
+        }
+        ++task_count;
+        auto &stack = task_stacks[p];
+        auto head = stack.load(std::memory_order_relaxed);
+        do {
+            t.next = head;
+        } while (not stack.compare_exchange_weak(head, std::addressof(t),
+                                                 std::memory_order_release,
+                                                 std::memory_order_relaxed));
+        S::schedule(p);
+        return true;
+    }
+
+    template <priority_t P> constexpr static auto valid_priority() -> bool {
+        return P < NumPriorities;
+    }
+
+    template <priority_t P, typename RQP = requeue_policy::deferred>
+    auto service_tasks() -> void
+        requires(valid_priority<P>())
+    {
+        auto task = take_batch<P>();
+        while (task != nullptr) {
+            // next must be read before pending is cleared: after that, a
+            // producer may requeue the task and overwrite it
+            auto &t = *std::exchange(task, next_of(*task));
+            std::atomic_ref{t.pending}.store(false, std::memory_order_release);
+            t.run();
+            --task_count;
+            if constexpr (std::same_as<RQP, requeue_policy::immediate>) {
+                if (task == nullptr) {
+                    task = take_batch<P>();
+                }
+            }
+        }
+    }
+
+    [[nodiscard]] auto is_idle() const -> bool { return task_count == 0; }
+};
+static_assert(
+    task_manager<lock_free_task_manager<archetypes::scheduler_hal, 16>>);
+} // namespace async
@@ -3,26 +3,69 @@
 #include <async/concepts.hpp>
 #include <async/env.hpp>
 #include <async/schedulers/task_manager_interface.hpp>
+#include <async/schedulers/timer_manager_interface.hpp>
 #include <async/stop_token.hpp>
 #include <async/tags.hpp>
+#include <async/trace.hpp>
 #include <async/type_traits.hpp>
 
 #include <stdx/concepts.hpp>
 
+#include <atomic>
 #include <concepts>
+#include <cstddef>
+#include <memory>
 #include <type_traits>
 #include <utility>
 
 namespace async {
+namespace handoff {
+// The continuation is always queued as a task.
+struct never {
+    template <priority_t>
+    constexpr static auto try_inline(auto &&) -> bool {
+        return false;
+    }
+};
+
+// When the caller already runs at priority P or above (a lower number), the
+// continuation runs inline, saving the queue and the interrupt that services
+// it. Inline runs may start further inline runs; beyond MaxDepth nested runs,
+// tasks are queued again, so the stack stays bounded. The depth is counted
+// across all contexts, which only errs towards queueing.
+template <std::size_t MaxDepth = 4> struct when_priority_permits {
+    template <priority_t P, typename F>
+    static auto try_inline(F &&f) -> bool {
+        if (task_mgr::detail::current_priority() > P) {
+            return false;
+        }
+        if (depth.fetch_add(1, std::memory_order_relaxed) >= MaxDepth) {
+            depth.fetch_sub(1, std::memory_order_relaxed);
+            return false;
+        }
+        std::forward<F>(f)();
+        depth.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+  private:
+    static inline std::atomic<std::size_t> depth{};
+};
+} // namespace handoff
+
 namespace task_mgr {
-template <priority_t P, typename Rcvr, typename Task>
+template <priority_t P, typename Rcvr, typename Task,
+          typename Handoff = handoff::never>
 struct op_state final : Task {
     template <stdx::same_as_unqualified<Rcvr> R>
     // NOLINTNEXTLINE(bugprone-forwarding-reference-overload)
-    constexpr explicit(true) op_state(R &&r) : rcvr{std::forward<R>(r)} {}
+    constexpr explicit(true) op_state(R &&r)
+        : Task{run_task<op_state>}, rcvr{std::forward<R>(r)} {}
 
-    auto run() -> void final {
+    auto run() -> void {
         if (not check_stopped()) {
+            ::async::detail::trace<trace_kind::priority_scheduler<P>,
+                                   set_value_t>(rcvr, this);
             set_value(std::move(rcvr));
         }
     }
@@ -33,6 +76,8 @@ struct op_state final : Task {
     auto check_stopped() -> bool {
         if constexpr (not unstoppable_token<stop_token_of_t<env_of_t<Rcvr>>>) {
             if (get_stop_token(get_env(rcvr)).stop_requested()) {
+                ::async::detail::trace<trace_kind::priority_scheduler<P>,
+                                       set_stopped_t>(rcvr, this);
                 set_stopped(std::move(rcvr));
                 return true;
             }
@@ -42,14 +87,24 @@ struct op_state final : Task {
 
     template <stdx::same_as_unqualified<op_state> O>
     friend constexpr auto tag_invoke(start_t, O &&o) -> void {
-        if (not std::forward<O>(o).check_stopped()) {
+        ::async::detail::trace<trace_kind::priority_scheduler<P>, start_t>(
+            o.rcvr, std::addressof(o));
+        // a task that orders by deadline takes it from the environment
+        if constexpr (requires {
+                          o.deadline = get_deadline(get_env(o.rcvr));
+                      }) {
+            o.deadline = get_deadline(get_env(o.rcvr));
+        }
+        if (not std::forward<O>(o).check_stopped() and
+            not Handoff::template try_inline<P>([&] { o.run(); })) {
             detail::enqueue_task(o, P);
         }
     }
 };
 } // namespace task_mgr
 
-template <priority_t P, typename Task = priority_task>
+template <priority_t P, typename Task = priority_task,
+          typename Handoff = handoff::never>
 class fixed_priority_scheduler {
     class env {
         [[nodiscard]] friend constexpr auto
@@ -66,8 +121,8 @@ class fixed_priority_scheduler {
         template <stdx::same_as_unqualified<sender> S, receiver R>
         [[nodiscard]] friend constexpr auto tag_invoke(connect_t, S &&, R &&r) {
             check_connect<S, R>();
-            return task_mgr::op_state<P, std::remove_cvref_t<R>, Task>{
-                std::forward<R>(r)};
+            return task_mgr::op_state<P, std::remove_cvref_t<R>, Task,
+                                      Handoff>{std::forward<R>(r)};
         }
 
         [[nodiscard]] friend constexpr auto tag_invoke(get_env_t,
@@ -102,5 +157,9 @@ class fixed_priority_scheduler {
                       "injected task manager");
         return {};
     }
+
+    [[nodiscard]] constexpr static auto concurrency() -> std::size_t {
+        return task_mgr::detail::concurrency();
+    }
 };
 } // namespace async
@@ -0,0 +1,232 @@
+#pragma once
+
+#include <async/concepts.hpp>
+#include <async/env.hpp>
+#include <async/schedulers/task.hpp>
+#include <async/schedulers/task_manager_interface.hpp>
+#include <async/stop_token.hpp>
+#include <async/tags.hpp>
+#include <async/type_traits.hpp>
+
+#include <stdx/concepts.hpp>
+#include <stdx/type_traits.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace async {
+// A task that can be handed to another core: besides its link in the local
+// task manager, it has a link in the target core's remote queue, and the
+// priority at which the target core should run it.
+// NOLINTNEXTLINE(*-special-member-functions)
+template <typename Task = priority_task> struct remote_task : Task {
+    using Task::Task;
+    constexpr remote_task(remote_task &&) = delete;
+    remote_task *remote_next{};
+    priority_t remote_priority{};
+};
+
+// A lock-free multi-producer, single-consumer queue of tasks sent to one core.
+// Any core pushes; the owning core takes everything at once (from its IPC
+// interrupt) and hands the tasks to its task manager. It must be placed in
+// memory that all the cores see coherently, and each pushing core must have
+// lock-free atomic compare-exchange on it.
+template <typename Task = priority_task> class remote_queue {
+    std::atomic<remote_task<Task> *> head{};
+
+  public:
+    using task_t = remote_task<Task>;
+
+    // Returns true if the queue was empty, in which case the owning core
+    // must be notified. Otherwise a notification is already pending.
+    auto push(task_t &t) -> bool {
+        auto h = head.load(std::memory_order_relaxed);
+        do {
+            t.remote_next = h;
+        } while (not head.compare_exchange_weak(h, std::addressof(t),
+                                                std::memory_order_release,
+                                                std::memory_order_relaxed));
+        return h == nullptr;
+    }
+
+    // Takes all the queued tasks, in the order they were pushed.
+    [[nodiscard]] auto take_all() -> task_t * {
+        auto t = head.exchange(nullptr, std::memory_order_acquire);
+        task_t *fifo{};
+        while (t != nullptr) {
+            auto const next = t->remote_next;
+            t->remote_next = fifo;
+            fifo = t;
+            t = next;
+        }
+        return fifo;
+    }
+};
+
+template <typename T>
+concept remote_core_hal = requires {
+    { T::template queue<std::size_t{}>() };
+    { T::template notify<std::size_t{}>() } -> std::same_as<void>;
+};
+
+namespace detail {
+struct undefined_remote_core_hal {
+    template <std::size_t Core, typename... DummyArgs>
+    static auto queue() -> remote_queue<> & {
+        static_assert(
+            stdx::always_false_v<std::integral_constant<std::size_t, Core>,
+                                 DummyArgs...>,
+            "Inject a remote core HAL by specializing "
+            "async::injected_remote_core_hal.");
+        static remote_queue<> q{};
+        return q;
+    }
+
+    template <std::size_t Core, typename... DummyArgs>
+    static auto notify() -> void {
+        static_assert(
+            stdx::always_false_v<std::integral_constant<std::size_t, Core>,
+                                 DummyArgs...>,
+            "Inject a remote core HAL by specializing "
+            "async::injected_remote_core_hal.");
+    }
+};
+static_assert(remote_core_hal<undefined_remote_core_hal>);
+} // namespace detail
+
+// The HAL gives the remote_queue owned by each core, and raises a core's IPC
+// interrupt.
+template <typename...>
+inline auto injected_remote_core_hal = detail::undefined_remote_core_hal{};
+
+namespace remote_core {
+namespace detail {
+template <std::size_t Core, typename... DummyArgs>
+    requires(sizeof...(DummyArgs) == 0)
+auto queue() -> decltype(auto) {
+    return injected_remote_core_hal<DummyArgs...>.template queue<Core>();
+}
+
+template <std::size_t Core, typename... DummyArgs>
+    requires(sizeof...(DummyArgs) == 0)
+auto notify() -> void {
+    injected_remote_core_hal<DummyArgs...>.template notify<Core>();
+}
+} // namespace detail
+
+// Called on core Core (from its IPC interrupt) to move the tasks that other
+// cores have sent it into its own task manager, each at the priority it was
+// sent with. Returns the number of tasks moved.
+template <std::size_t Core, typename... DummyArgs>
+    requires(sizeof...(DummyArgs) == 0)
+auto receive() -> std::size_t {
+    auto t = detail::queue<Core, DummyArgs...>().take_all();
+    auto n = std::size_t{};
+    while (t != nullptr) {
+        auto const next = t->remote_next;
+        t->remote_next = nullptr;
+        task_mgr::detail::enqueue_task<DummyArgs...>(*t, t->remote_priority);
+        t = next;
+        ++n;
+    }
+    return n;
+}
+
+template <std::size_t Core, priority_t P, typename Rcvr, typename Task>
+struct op_state final : remote_task<Task> {
+    template <stdx::same_as_unqualified<Rcvr> R>
+    // NOLINTNEXTLINE(bugprone-forwarding-reference-overload)
+    constexpr explicit(true) op_state(R &&r)
+        : remote_task<Task>{run_task<op_state>}, rcvr{std::forward<R>(r)} {}
+
+    auto run() -> void {
+        if (not check_stopped()) {
+            set_value(std::move(rcvr));
+        }
+    }
+
+    [[no_unique_address]] Rcvr rcvr;
+
+  private:
+    auto check_stopped() -> bool {
+        if constexpr (not unstoppable_token<stop_token_of_t<env_of_t<Rcvr>>>) {
+            if (get_stop_token(get_env(rcvr)).stop_requested()) {
+                set_stopped(std::move(rcvr));
+                return true;
+            }
+        }
+        return false;
+    }
+
+    template <stdx::same_as_unqualified<op_state> O>
+    friend auto tag_invoke(start_t, O &&o) -> void {
+        if (o.check_stopped()) {
+            return;
+        }
+        o.remote_priority = P;
+        if (detail::queue<Core>().push(o)) {
+            detail::notify<Core>();
+        }
+    }
+};
+} // namespace remote_core
+
+// A scheduler whose operations complete on another core of an asymmetric
+// multicore part, in that core's task manager at priority P. Starting an
+// operation pushes it onto the target core's remote queue and, if the queue
+// was empty, raises the target core's IPC interrupt; the interrupt handler
+// calls remote_core::receive<Core>() to hand the queued tasks to the local
+// task manager. Task is the task type of the target core's task manager.
+template <std::size_t Core, priority_t P, typename Task = priority_task>
+class remote_core_scheduler {
+    class env {
+        [[nodiscard]] friend constexpr auto
+        tag_invoke(get_completion_scheduler_t<set_value_t>, env) noexcept
+            -> remote_core_scheduler {
+            return {};
+        }
+    };
+
+    struct sender {
+        using is_sender = void;
+
+      private:
+        template <stdx::same_as_unqualified<sender> S, receiver R>
+        [[nodiscard]] friend constexpr auto tag_invoke(connect_t, S &&, R &&r) {
+            check_connect<S, R>();
+            return remote_core::op_state<Core, P, std::remove_cvref_t<R>,
+                                         Task>{std::forward<R>(r)};
+        }
+
+        [[nodiscard]] friend constexpr auto tag_invoke(get_env_t,
+                                                       sender) noexcept -> env {
+            return {};
+        }
+
+        template <typename Env>
+        [[nodiscard]] friend constexpr auto
+        tag_invoke(get_completion_signatures_t, sender, Env const &) noexcept
+            -> completion_signatures<set_value_t(), set_stopped_t()> {
+            return {};
+        }
+
+        template <typename Env>
+            requires unstoppable_token<stop_token_of_t<Env>>
+        [[nodiscard]] friend constexpr auto
+        tag_invoke(get_completion_signatures_t, sender, Env const &) noexcept
+            -> completion_signatures<set_value_t()> {
+            return {};
+        }
+    };
+
+    [[nodiscard]] friend constexpr auto operator==(remote_core_scheduler,
+                                                   remote_core_scheduler)
+        -> bool = default;
+
+  public:
+    [[nodiscard]] constexpr static auto schedule() -> sender { return {}; }
+};
+} // namespace async
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <async/schedulers/task.hpp>
+#include <async/schedulers/task_manager_instrumentation.hpp>
+#include <async/schedulers/task_manager_interface.hpp>
+#include <async/schedulers/timer_manager_interface.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+namespace async {
+namespace replay {
+// The values are part of the log format. Zero is never recorded, so that an
+// unused entry in a dumped log can be told apart from an event.
+enum struct event_kind : std::uint8_t {
+    enqueue = 1,
+    run,
+    arm,
+    expiry,
+    cancel,
+};
+
+// Tasks are identified by the order in which they were enqueued (and timers
+// by the order in which they were armed): the id of an event is the ordinal
+// of the enqueue or arm that it refers to. Ids are the same from one run of a
+// program to the next, where addresses are not.
+struct event {
+    std::uint32_t id;
+    event_kind kind;
+    priority_t priority;
+};
+static_assert(std::is_trivially_copyable_v<event>);
+static_assert(sizeof(event) == 8);
+
+// A fixed-size log of the first N events. Recording takes no lock and is safe
+// from any number of threads or interrupts. Once the log is full, further
+// events are counted but not stored, since a replay needs the log from the
+// start.
+template <std::size_t N> class log {
+    std::array<event, N> entries{};
+    std::atomic<std::uint32_t> next{};
+
+  public:
+    auto record(event e) -> void {
+        auto const i = next.fetch_add(1, std::memory_order_relaxed);
+        if (i < N) {
+            entries[i] = e;
+        }
+    }
+
+    // Starts a new recording. Events must not be recorded concurrently.
+    auto clear() -> void { next.store(0, std::memory_order_release); }
+
+    [[nodiscard]] auto size() const -> std::size_t {
+        auto const n = next.load(std::memory_order_acquire);
+        return n < N ? n : N;
+    }
+
+    [[nodiscard]] auto overflowed() const -> bool {
+        return next.load(std::memory_order_acquire) > N;
+    }
+
+    [[nodiscard]] auto events() const -> std::span<event const> {
+        return {entries.data(), size()};
+    }
+
+    // The entries as they are laid out in memory, for dumping.
+    [[nodiscard]] auto raw() const -> std::array<event, N> const & {
+        return entries;
+    }
+};
+} // namespace replay
+
+// A task that carries the id under which it was last enqueued or armed.
+template <typename Base> struct replay_task_base : Base {
+    using Base::Base;
+
+    std::uint32_t replay_id{};
+};
+
+using replayable_priority_task = single_linked_task<replay_task_base<task_base>>;
+
+template <typename T>
+using replayable_timer_task =
+    double_linked_task<replay_task_base<detail::default_timer_task<T>>>;
+
+namespace instrumentation {
+// Records the order of scheduling events for replay::player. Sink provides a
+// static record(replay::event) function, typically forwarding to a
+// replay::log. Used with priority_task_manager, it records each enqueue and
+// each task run; used with generic_timer_manager, each arm, expiry and
+// cancellation. Tasks must be replayable (replayable_priority_task or
+// replayable_timer_task).
+//
+// Each manager numbers its tasks independently; the hooks are called within
+// the manager's critical section where ids are assigned.
+template <typename Sink> struct recording {
+    auto on_enqueue(auto &task, priority_t p, std::size_t) -> void {
+        task.replay_id = next_id++;
+        Sink::record({task.replay_id, replay::event_kind::enqueue, p});
+    }
+
+    auto on_run_start(auto const &task, priority_t p) -> void {
+        Sink::record({task.replay_id, replay::event_kind::run, p});
+    }
+
+    constexpr static auto on_run_end(auto const &, priority_t) -> void {}
+
+    auto on_arm(auto &task) -> void {
+        task.replay_id = next_id++;
+        Sink::record({task.replay_id, replay::event_kind::arm, {}});
+    }
+
+    auto on_expiry(auto const &task) -> void {
+        Sink::record({task.replay_id, replay::event_kind::expiry, {}});
+    }
+
+    auto on_cancel(auto const &task) -> void {
+        Sink::record({task.replay_id, replay::event_kind::cancel, {}});
+    }
+
+  private:
+    std::uint32_t next_id{};
+};
+} // namespace instrumentation
+} // namespace async
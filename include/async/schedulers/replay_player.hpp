@@ -0,0 +1,221 @@
+#pragma once
+
+#include <async/schedulers/replay.hpp>
+#include <async/schedulers/task.hpp>
+#include <async/schedulers/task_manager_interface.hpp>
+#include <async/schedulers/timer_manager_interface.hpp>
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace async {
+namespace replay {
+enum struct status : std::uint8_t { running, complete, diverged };
+
+// Replays a recorded log on a host: it provides a task manager and a timer
+// manager (to be injected in place of the recorded ones) that only queue
+// tasks, and run() then dispatches the queued tasks in exactly the recorded
+// order. This reproduces a target's interleaving of tasks and timer expiries,
+// for instance to profile it.
+//
+// Everything that enqueued a task or armed a timer in the recording must do so
+// in the replay as well, in the same order; in particular, an interrupt
+// handler that did so must be played by the test harness. If the replay does
+// something else, it has diverged: step() and run() stop at the event that
+// could not be replayed, which position() identifies.
+template <typename TimePoint> class player {
+  public:
+    using task_t = replayable_priority_task;
+    using timer_task_t = replayable_timer_task<TimePoint>;
+    using time_point_t = TimePoint;
+    using duration_t =
+        decltype(std::declval<time_point_t>() - std::declval<time_point_t>());
+
+  private:
+    std::span<event const> recorded{};
+    std::size_t pos{};
+    std::vector<task_t *> tasks{};
+    std::vector<timer_task_t *> timers{};
+    std::size_t pending_tasks{};
+    std::size_t pending_timers{};
+    time_point_t current{};
+
+    auto enqueue(task_t &t) -> bool {
+        if (std::exchange(t.pending, true)) {
+            return false;
+        }
+        t.replay_id = static_cast<std::uint32_t>(tasks.size());
+        tasks.push_back(std::addressof(t));
+        ++pending_tasks;
+        return true;
+    }
+
+    auto arm(timer_task_t &t, time_point_t expiry) -> bool {
+        if (std::exchange(t.pending, true)) {
+            return false;
+        }
+        t.expiration_time = expiry;
+        t.replay_id = static_cast<std::uint32_t>(timers.size());
+        timers.push_back(std::addressof(t));
+        ++pending_timers;
+        return true;
+    }
+
+    auto cancel(timer_task_t &t) -> bool {
+        if (not std::exchange(t.pending, false)) {
+            return false;
+        }
+        --pending_timers;
+        return true;
+    }
+
+    template <typename T>
+    static auto queued(std::vector<T *> const &v, std::uint32_t id) -> T * {
+        if (id >= v.size()) {
+            return nullptr;
+        }
+        auto const t = v[id];
+        return t->pending and t->replay_id == id ? t : nullptr;
+    }
+
+    auto replay(event const &e) -> bool {
+        switch (e.kind) {
+        case event_kind::enqueue:
+            return e.id < tasks.size();
+        case event_kind::arm:
+            return e.id < timers.size();
+        case event_kind::cancel:
+            return e.id < timers.size() and queued(timers, e.id) == nullptr;
+        case event_kind::run:
+            if (auto const t = queued(tasks, e.id)) {
+                t->pending = false;
+                --pending_tasks;
+                t->run();
+                return true;
+            }
+            return false;
+        case event_kind::expiry:
+            if (auto const t = queued(timers, e.id)) {
+                t->pending = false;
+                --pending_timers;
+                if (current < t->expiration_time) {
+                    current = t->expiration_time;
+                }
+                t->run();
+                return true;
+            }
+            return false;
+        }
+        return false;
+    }
+
+  public:
+    player() = default;
+    explicit player(std::span<event const> events) : recorded{events} {}
+
+    // Replays the next event. A task or timer runs inside step().
+    auto step() -> status {
+        if (pos == recorded.size()) {
+            return status::complete;
+        }
+        auto const &e = recorded[pos];
+        ++pos;
+        if (not replay(e)) {
+            --pos;
+            return status::diverged;
+        }
+        return pos == recorded.size() ? status::complete : status::running;
+    }
+
+    auto run() -> status {
+        auto s = status::running;
+        while (s == status::running) {
+            s = step();
+        }
+        return s;
+    }
+
+    // The index of the next event to replay (or of the event at which the
+    // replay diverged).
+    [[nodiscard]] auto position() const -> std::size_t { return pos; }
+
+    // Timers do not wait for real time in a replay: the current time is the
+    // expiration time of the last timer that fired.
+    [[nodiscard]] auto now() const -> time_point_t { return current; }
+
+    struct task_manager_t {
+        using task_t = player::task_t;
+        constexpr static auto create_task = async::create_task<task_t>;
+
+        auto enqueue_task(task_t &t, priority_t) -> bool {
+            return p->enqueue(t);
+        }
+
+        template <priority_t> constexpr static auto valid_priority() -> bool {
+            return true;
+        }
+
+        // Tasks run only when the player dispatches them.
+        template <priority_t> constexpr static auto service_tasks() -> void {}
+
+        [[nodiscard]] auto is_idle() const -> bool {
+            return p->pending_tasks == 0;
+        }
+
+        player *p;
+    };
+
+    struct timer_manager_t {
+        using task_t = timer_task_t;
+        using time_point_t = player::time_point_t;
+        using duration_t = player::duration_t;
+        constexpr static auto create_task = async::create_task<task_t>;
+
+        template <std::derived_from<task_t> T,
+                  std::convertible_to<duration_t> D>
+        auto run_after(T &t, D d) -> bool {
+            return p->arm(t, p->current + static_cast<duration_t>(d));
+        }
+
+        template <std::derived_from<task_t> T,
+                  std::convertible_to<duration_t> D,
+                  std::convertible_to<duration_t> S>
+        auto run_after(T &t, D d, S) -> bool {
+            return run_after(t, d);
+        }
+
+        template <std::derived_from<task_t> T,
+                  std::convertible_to<time_point_t> TP>
+        auto run_at(T &t, TP tp) -> bool {
+            return p->arm(t, static_cast<time_point_t>(tp));
+        }
+
+        template <std::derived_from<task_t> T,
+                  std::convertible_to<duration_t> D>
+        auto run_after_expiry(T &t, D d) -> bool {
+            return p->arm(t, t.expiration_time + static_cast<duration_t>(d));
+        }
+
+        auto cancel(task_t &t) -> bool { return p->cancel(t); }
+
+        // Timers expire only when the player dispatches them.
+        constexpr static auto service_task() -> void {}
+        constexpr static auto service_expired() -> std::size_t { return 0; }
+
+        [[nodiscard]] auto is_idle() const -> bool {
+            return p->pending_timers == 0;
+        }
+
+        player *p;
+    };
+
+    [[nodiscard]] auto get_task_manager() -> task_manager_t { return {this}; }
+    [[nodiscard]] auto get_timer_manager() -> timer_manager_t { return {this}; }
+};
+} // namespace replay
+} // namespace async
@@ -1,48 +1,95 @@
 #pragma once
 
-#ifdef SIMULATE_FREESTANDING
-#define HAS_CONDITION_VARIABLE 0
-#else
-#define HAS_CONDITION_VARIABLE __has_include(<condition_variable>)
-#endif
-
 #include <async/completion_scheduler.hpp>
 #include <async/concepts.hpp>
+#include <async/dispatch_node.hpp>
 #include <async/env.hpp>
+#include <async/schedulers/task_manager_interface.hpp>
 #include <async/stop_token.hpp>
 #include <async/tags.hpp>
+#include <async/trace.hpp>
 #include <async/type_traits.hpp>
-#include <conc/concurrency.hpp>
 
 #include <stdx/concepts.hpp>
-#include <stdx/intrusive_list.hpp>
 
+#include <array>
 #include <atomic>
-#if HAS_CONDITION_VARIABLE
-#include <condition_variable>
-#include <mutex>
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#if defined(__cpp_lib_atomic_wait) and not defined(SIMULATE_FREESTANDING)
+#define ASYNC_HAS_ATOMIC_WAIT 1
+#else
+#define ASYNC_HAS_ATOMIC_WAIT 0
 #endif
 
 namespace async {
+namespace detail {
+struct spin_idle {
+    template <typename Pred> static auto wait(Pred &&) -> void {}
+    static auto notify() -> void {}
+};
+} // namespace detail
+
+// Where std::atomic::wait is unavailable, an idle run_loop calls wait(pred)
+// until pred() holds, and a push that finds it idle calls notify(). wait may
+// sleep until notify or an interrupt, and may return early; pred() tells it
+// whether work has arrived. The default spins. For example, on a Cortex-M:
+//   wait(pred): if (not pred()) __WFE();   notify(): __SEV();
+template <typename...>
+inline auto injected_run_loop_idle = detail::spin_idle{};
+
+namespace detail {
+// An injected idle hook is used even where std::atomic::wait is available, so
+// that a hook such as epoll_reactor can do other work while the loop is idle.
+template <typename... DummyArgs>
+constexpr auto use_idle_hook =
+    not ASYNC_HAS_ATOMIC_WAIT or
+    not std::same_as<decltype(injected_run_loop_idle<DummyArgs...>),
+                     spin_idle>;
+// Once a push publishes its operation, the consumer may run it, see the loop
+// finish and return from run(), while the producer still has the wake-up to
+// do. So each push counts itself in and out, and a loop is not destroyed until
+// no push is in flight.
+inline auto wait_for_pushers(std::atomic<int> const &pushers) -> void {
+    while (pushers.load(std::memory_order_acquire) != 0) {
+    }
+}
+} // namespace detail
+
 namespace _run_loop {
 // NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
 template <typename Uniq = decltype([] {})> class run_loop {
-    struct op_state_base {
-        virtual auto execute() -> void = 0;
+    struct op_state_base : dispatch_node {
+        using dispatch_node::dispatch_node;
+
+        auto execute() -> void { dispatch(); }
+
         op_state_base *next{};
-        op_state_base *prev{};
     };
 
     // NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
     template <typename Rcvr> struct op_state : op_state_base {
         template <typename R>
-        op_state(run_loop *rl, R &&r) : loop{rl}, rcvr{std::forward<R>(r)} {}
+        op_state(run_loop *rl, R &&r)
+            : op_state_base{dispatch_to<op_state, &op_state::execute>},
+              loop{rl}, rcvr{std::forward<R>(r)} {}
         op_state(op_state &&) = delete;
 
-        auto execute() -> void override {
+        auto execute() -> void {
             if (get_stop_token(get_env(rcvr)).stop_requested()) {
+                detail::trace<trace_kind::runloop_scheduler, set_stopped_t>(rcvr,
+                                                                    this);
                 set_stopped(std::move(rcvr));
             } else {
+                detail::trace<trace_kind::runloop_scheduler, set_value_t>(rcvr,
+                                                                    this);
                 set_value(std::move(rcvr));
             }
         }
@@ -53,11 +100,15 @@ template <typename Uniq = decltype([] {})> class run_loop {
       private:
         template <stdx::same_as_unqualified<op_state> O>
         friend constexpr auto tag_invoke(start_t, O &&o) -> void {
+            detail::trace<trace_kind::runloop_scheduler, start_t>(
+                o.rcvr, std::addressof(o));
             std::forward<O>(o).loop->push_back(std::addressof(o));
         }
     };
 
     struct scheduler {
+        using elides_redundant_hops = void;
+
         struct env {
             [[nodiscard]] friend constexpr auto
             tag_invoke(get_completion_scheduler_t<set_value_t>, env e) noexcept
@@ -103,76 +154,400 @@ template <typename Uniq = decltype([] {})> class run_loop {
         run_loop *loop;
     };
 
-    template <typename Pred> auto wait_until(Pred &&p) {
-#if HAS_CONDITION_VARIABLE
-        std::unique_lock l{m};
-        cv.wait(l, std::forward<Pred>(p));
-#else
-        while (not p()) {
-        }
+    // Producers push onto an atomic LIFO stack; the single consumer takes the
+    // whole stack at once and reverses it into its own FIFO list. A producer
+    // wakes the consumer only if the consumer has said it is going to sleep.
+    template <typename... DummyArgs> auto wait_for_work() -> void {
+        sleeping.store(true);
+        if constexpr (detail::use_idle_hook<DummyArgs...>) {
+            while (incoming.load() == nullptr) {
+                injected_run_loop_idle<DummyArgs...>.wait([&] {
+                    return incoming.load(std::memory_order_acquire) != nullptr;
+                });
+            }
+        } else {
+#if ASYNC_HAS_ATOMIC_WAIT
+            incoming.wait(nullptr);
 #endif
+        }
+        sleeping.store(false, std::memory_order_relaxed);
     }
 
-    template <typename F> auto notify(F &&f) {
-#if HAS_CONDITION_VARIABLE
-        std::unique_lock l{m};
-        std::forward<F>(f)();
-        cv.notify_one();
-#else
-        std::forward<F>(f)();
-#endif
+    auto take_incoming() -> bool {
+        auto head = incoming.exchange(nullptr, std::memory_order_acquire);
+        if (head == nullptr) {
+            return false;
+        }
+        op_state_base *fifo{};
+        while (head != nullptr) {
+            auto const next = head->next;
+            head->next = fifo;
+            fifo = std::exchange(head, next);
+        }
+        pending = fifo;
+        return true;
+    }
+
+    auto execute_pending() -> std::size_t {
+        std::size_t n{};
+        while (pending != nullptr) {
+            // an operation may be gone once it has executed
+            auto const op = std::exchange(pending, pending->next);
+            if (op == std::addressof(finish_node)) {
+                finished = true;
+            } else {
+                op->execute();
+                ++n;
+            }
+        }
+        return n;
     }
 
+    struct finish_marker final : op_state_base {
+        finish_marker() : op_state_base{dispatch_nothing} {}
+    };
+
   public:
     run_loop() noexcept = default;
     run_loop(run_loop &&) = delete;
+    ~run_loop() { detail::wait_for_pushers(pushers); }
 
     auto get_scheduler() -> scheduler { return {this}; }
 
-    auto finish() -> void {
-        notify([&] {
-            conc::call_in_critical_section<Uniq>(
-                [&] { state = state_t::finishing; });
-        });
+    template <typename... DummyArgs> auto finish() -> void {
+        if (not finish_requested.exchange(true, std::memory_order_relaxed)) {
+            push_back<DummyArgs...>(std::addressof(finish_node));
+        }
     }
 
-    auto run() -> void {
-        while (auto op = pop_front()) {
-            op->execute();
+    // Each wakeup takes every operation queued so far and runs the batch;
+    // anything pushed meanwhile goes onto a fresh stack for the next batch.
+    template <typename... DummyArgs> auto run() -> void {
+        while (true) {
+            execute_pending();
+            if (take_incoming()) {
+                continue;
+            }
+            if (finished) {
+                return;
+            }
+            wait_for_work<DummyArgs...>();
         }
     }
 
+    // Runs what is queued now, without waiting, and returns how many
+    // operations ran.
+    auto drain() -> std::size_t {
+        auto n = execute_pending();
+        if (take_incoming()) {
+            n += execute_pending();
+        }
+        return n;
+    }
+
+    template <typename... DummyArgs>
     auto push_back(op_state_base *task) -> void {
-        notify([&] {
-            conc::call_in_critical_section<Uniq>(
-                [&] { tasks.push_back(task); });
-        });
+        pushers.fetch_add(1, std::memory_order_relaxed);
+        auto head = incoming.load(std::memory_order_relaxed);
+        do {
+            task->next = head;
+        } while (not incoming.compare_exchange_weak(
+            head, task, std::memory_order_seq_cst, std::memory_order_relaxed));
+        if (sleeping.load()) {
+            if constexpr (detail::use_idle_hook<DummyArgs...>) {
+                injected_run_loop_idle<DummyArgs...>.notify();
+            } else {
+#if ASYNC_HAS_ATOMIC_WAIT
+                incoming.notify_one();
+#endif
+            }
+        }
+        pushers.fetch_sub(1, std::memory_order_release);
     }
 
-    auto pop_front() -> op_state_base * {
-        wait_until([&] {
-            return conc::call_in_critical_section<Uniq>([&] {
-                return not tasks.empty() or state == state_t::finishing;
-            });
-        });
-        return conc::call_in_critical_section<Uniq>([&]() -> op_state_base * {
-            return tasks.empty() ? nullptr : tasks.pop_front();
-        });
+    // only one thread may consume (call run or pop_front)
+    template <typename... DummyArgs> auto pop_front() -> op_state_base * {
+        while (true) {
+            while (pending != nullptr) {
+                auto const op = std::exchange(pending, pending->next);
+                if (op != std::addressof(finish_node)) {
+                    return op;
+                }
+                finished = true;
+            }
+            if (take_incoming()) {
+                continue;
+            }
+            if (finished) {
+                return nullptr;
+            }
+            wait_for_work<DummyArgs...>();
+        }
     }
 
   private:
-    enum struct state_t { starting, running, finishing };
+    std::atomic<op_state_base *> incoming{};
+    op_state_base *pending{};
+    std::atomic<bool> finish_requested{};
+    bool finished{};
+    finish_marker finish_node{};
+    std::atomic<bool> sleeping{};
+    std::atomic<int> pushers{};
+};
+
+// A run loop with N priorities (0 is the highest). Each priority has its own
+// atomic stack, and a bitmap says which stacks have work, so producers never
+// contend across priorities. After each operation the consumer looks again for
+// the highest ready priority, so urgent work overtakes queued work of lower
+// priority.
+// NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+template <std::size_t N, typename Uniq = decltype([] {})>
+class priority_run_loop {
+    static_assert(N > 0 and N <= 64,
+                  "priority_run_loop supports from 1 to 64 priorities");
+    using bitmap_t =
+        std::conditional_t<(N <= 32), std::uint32_t, std::uint64_t>;
+
+    struct op_state_base : dispatch_node {
+        using dispatch_node::dispatch_node;
+
+        auto execute() -> void { dispatch(); }
+
+        op_state_base *next{};
+    };
+
+    // NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+    template <typename Rcvr> struct op_state : op_state_base {
+        template <typename R>
+        op_state(priority_run_loop *rl, priority_t p, R &&r)
+            : op_state_base{dispatch_to<op_state, &op_state::execute>},
+              loop{rl}, priority{p}, rcvr{std::forward<R>(r)} {}
+        op_state(op_state &&) = delete;
+
+        auto execute() -> void {
+            if (get_stop_token(get_env(rcvr)).stop_requested()) {
+                detail::trace<trace_kind::runloop_scheduler, set_stopped_t>(rcvr,
+                                                                    this);
+                set_stopped(std::move(rcvr));
+            } else {
+                detail::trace<trace_kind::runloop_scheduler, set_value_t>(rcvr,
+                                                                    this);
+                set_value(std::move(rcvr));
+            }
+        }
+
+        priority_run_loop *loop{};
+        priority_t priority{};
+        [[no_unique_address]] Rcvr rcvr;
+
+      private:
+        template <stdx::same_as_unqualified<op_state> O>
+        friend constexpr auto tag_invoke(start_t, O &&o) -> void {
+            detail::trace<trace_kind::runloop_scheduler, start_t>(
+                o.rcvr, std::addressof(o));
+            o.loop->push_back(std::addressof(o), o.priority);
+        }
+    };
+
+    struct scheduler {
+        struct env {
+            [[nodiscard]] friend constexpr auto
+            tag_invoke(get_completion_scheduler_t<set_value_t>, env e) noexcept
+                -> scheduler {
+                return e.loop->get_scheduler(e.priority);
+            }
+            priority_run_loop *loop;
+            priority_t priority;
+        };
+
+        struct sender {
+            using is_sender = void;
+            using completion_signatures =
+                async::completion_signatures<set_value_t(), set_stopped_t()>;
+
+            [[nodiscard]] friend constexpr auto tag_invoke(get_env_t,
+                                                           sender s) noexcept
+                -> env {
+                return {s.loop, s.priority};
+            }
+
+            template <stdx::same_as_unqualified<sender> S, receiver R>
+            [[nodiscard]] friend constexpr auto tag_invoke(connect_t, S &&s,
+                                                           R &&r)
+                -> op_state<std::remove_cvref_t<R>> {
+                check_connect<S, R>();
+                return {s.loop, s.priority, std::forward<R>(r)};
+            }
+
+            priority_run_loop *loop;
+            priority_t priority;
+        };
+
+        [[nodiscard]] constexpr auto schedule() -> sender {
+            return {loop, priority};
+        }
+
+        template <typename T>
+        [[nodiscard]] friend constexpr auto operator==(scheduler x, T const &y)
+            -> bool {
+            if constexpr (std::same_as<T, scheduler>) {
+                return x.loop == y.loop and x.priority == y.priority;
+            }
+            return false;
+        }
+
+        priority_run_loop *loop;
+        priority_t priority;
+    };
+
+    template <typename... DummyArgs> auto wait_for_work() -> void {
+        sleeping.store(true);
+        if constexpr (detail::use_idle_hook<DummyArgs...>) {
+            while (ready.load() == 0) {
+                injected_run_loop_idle<DummyArgs...>.wait([&] {
+                    return ready.load(std::memory_order_acquire) != 0;
+                });
+            }
+        } else {
+#if ASYNC_HAS_ATOMIC_WAIT
+            ready.wait(0);
+#endif
+        }
+        sleeping.store(false, std::memory_order_relaxed);
+    }
 
-    state_t state{state_t::starting};
-    stdx::intrusive_list<op_state_base> tasks{};
-#if HAS_CONDITION_VARIABLE
-    std::mutex m{};
-    std::condition_variable cv{};
+    auto take_incoming() -> void {
+        auto r = ready.exchange(0, std::memory_order_acquire);
+        while (r != 0) {
+            auto const p = static_cast<std::size_t>(std::countr_zero(r));
+            r &= r - 1;
+
+            auto head = incoming[p].exchange(nullptr, std::memory_order_acquire);
+            op_state_base *fifo{};
+            auto const last = head;
+            while (head != nullptr) {
+                auto const next = head->next;
+                head->next = fifo;
+                fifo = std::exchange(head, next);
+            }
+            if (fifo == nullptr) {
+                continue;
+            }
+            if (pending[p].head == nullptr) {
+                pending[p].head = fifo;
+            } else {
+                pending[p].tail->next = fifo;
+            }
+            pending[p].tail = last;
+            pending_mask |= bitmap_t{1} << p;
+        }
+    }
+
+    auto pop_highest() -> op_state_base * {
+        auto const p = static_cast<std::size_t>(std::countr_zero(pending_mask));
+        auto &q = pending[p];
+        auto const op = std::exchange(q.head, q.head->next);
+        if (q.head == nullptr) {
+            q.tail = nullptr;
+            pending_mask &= ~(bitmap_t{1} << p);
+        }
+        return op;
+    }
+
+    struct finish_marker final : op_state_base {
+        finish_marker() : op_state_base{dispatch_nothing} {}
+    };
+
+    struct queue {
+        op_state_base *head{};
+        op_state_base *tail{};
+    };
+
+  public:
+    priority_run_loop() noexcept = default;
+    priority_run_loop(priority_run_loop &&) = delete;
+    ~priority_run_loop() { detail::wait_for_pushers(pushers); }
+
+    template <priority_t P> constexpr static auto valid_priority() -> bool {
+        return P < N;
+    }
+
+    template <priority_t P> auto get_scheduler() -> scheduler {
+        static_assert(valid_priority<P>(),
+                      "priority_run_loop has invalid priority");
+        return {this, P};
+    }
+
+    auto get_scheduler(priority_t p) -> scheduler {
+        assert(p < N and "priority_run_loop has invalid priority");
+        return {this, p};
+    }
+
+    template <typename... DummyArgs> auto finish() -> void {
+        if (not finish_requested.exchange(true, std::memory_order_relaxed)) {
+            push_back<DummyArgs...>(std::addressof(finish_node), N - 1);
+        }
+    }
+
+    template <typename... DummyArgs> auto run() -> void {
+        while (true) {
+            if (ready.load(std::memory_order_relaxed) != 0) {
+                take_incoming();
+            }
+            if (pending_mask != 0) {
+                auto const op = pop_highest();
+                if (op == std::addressof(finish_node)) {
+                    finished = true;
+                } else {
+                    op->execute();
+                }
+                continue;
+            }
+            if (finished) {
+                return;
+            }
+            wait_for_work<DummyArgs...>();
+        }
+    }
+
+    template <typename... DummyArgs>
+    auto push_back(op_state_base *task, priority_t p) -> void {
+        assert(p < N and "priority_run_loop has invalid priority");
+        pushers.fetch_add(1, std::memory_order_relaxed);
+        auto &stack = incoming[p];
+        auto head = stack.load(std::memory_order_relaxed);
+        do {
+            task->next = head;
+        } while (not stack.compare_exchange_weak(
+            head, task, std::memory_order_release, std::memory_order_relaxed));
+        ready.fetch_or(bitmap_t{1} << p);
+        if (sleeping.load()) {
+            if constexpr (detail::use_idle_hook<DummyArgs...>) {
+                injected_run_loop_idle<DummyArgs...>.notify();
+            } else {
+#if ASYNC_HAS_ATOMIC_WAIT
+                ready.notify_one();
 #endif
+            }
+        }
+        pushers.fetch_sub(1, std::memory_order_release);
+    }
+
+  private:
+    std::array<std::atomic<op_state_base *>, N> incoming{};
+    std::atomic<bitmap_t> ready{};
+    std::array<queue, N> pending{};
+    bitmap_t pending_mask{};
+    std::atomic<bool> finish_requested{};
+    bool finished{};
+    finish_marker finish_node{};
+    std::atomic<bool> sleeping{};
+    std::atomic<int> pushers{};
 };
 } // namespace _run_loop
 
+using _run_loop::priority_run_loop;
 using _run_loop::run_loop;
 } // namespace async
 
-#undef HAS_CONDITION_VARIABLE
+#undef ASYNC_HAS_ATOMIC_WAIT
@@ -0,0 +1,278 @@
+#pragma once
+
+#if not __has_include(<thread>)
+#error async::static_thread_pool is unavailable: <thread> does not exist
+#endif
+
+#include <async/completion_scheduler.hpp>
+#include <async/concepts.hpp>
+#include <async/env.hpp>
+#include <async/stop_token.hpp>
+#include <async/tags.hpp>
+#include <async/type_traits.hpp>
+
+#include <stdx/concepts.hpp>
+#include <stdx/intrusive_list.hpp>
+
+#include <array>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#if defined(__linux__) and __has_include(<pthread.h>)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace async {
+namespace _thread_pool {
+// Restricts the calling thread to one CPU core. Where the platform offers no
+// way to do that, the thread runs wherever the OS puts it.
+inline auto pin_this_thread(std::size_t core) -> void {
+#if defined(__linux__) and __has_include(<pthread.h>)
+    if (core < CPU_SETSIZE) {
+        cpu_set_t set{};
+        CPU_ZERO(&set);
+        CPU_SET(core, &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    }
+#else
+    (void)core;
+#endif
+}
+
+// A fixed set of worker threads that is created with the pool and joined when
+// the pool is destroyed. Operation states are intrusively queued, so
+// scheduling work never allocates. Each worker has its own queue besides the
+// shared one; work scheduled on a particular worker stays on it.
+// NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+template <std::size_t NumThreads> class static_thread_pool {
+    static_assert(NumThreads > 0,
+                  "static_thread_pool needs at least one worker thread");
+
+    struct op_state_base {
+        virtual auto execute() -> void = 0;
+        op_state_base *next{};
+        op_state_base *prev{};
+    };
+
+    // NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+    template <typename Rcvr> struct op_state : op_state_base {
+        template <typename R>
+        op_state(static_thread_pool *p, std::size_t w, R &&r)
+            : pool{p}, worker{w}, rcvr{std::forward<R>(r)} {}
+        op_state(op_state &&) = delete;
+
+        auto execute() -> void override {
+            if (get_stop_token(get_env(rcvr)).stop_requested()) {
+                set_stopped(std::move(rcvr));
+            } else {
+                set_value(std::move(rcvr));
+            }
+        }
+
+        static_thread_pool *pool{};
+        std::size_t worker{};
+        [[no_unique_address]] Rcvr rcvr;
+
+      private:
+        template <stdx::same_as_unqualified<op_state> O>
+        friend auto tag_invoke(start_t, O &&o) -> void {
+            o.pool->push_back(std::addressof(o), o.worker);
+        }
+    };
+
+    struct scheduler {
+        using elides_redundant_hops = void;
+
+        struct env {
+            [[nodiscard]] friend constexpr auto
+            tag_invoke(get_completion_scheduler_t<set_value_t>, env e) noexcept
+                -> scheduler {
+                return {e.pool, e.worker};
+            }
+            static_thread_pool *pool;
+            std::size_t worker;
+        };
+
+        struct sender {
+            using is_sender = void;
+            using completion_signatures =
+                async::completion_signatures<set_value_t(), set_stopped_t()>;
+
+            [[nodiscard]] friend constexpr auto tag_invoke(get_env_t,
+                                                           sender s) noexcept
+                -> env {
+                return {s.pool, s.worker};
+            }
+
+            template <stdx::same_as_unqualified<sender> S, receiver R>
+            [[nodiscard]] friend constexpr auto tag_invoke(connect_t, S &&s,
+                                                           R &&r)
+                -> op_state<std::remove_cvref_t<R>> {
+                check_connect<S, R>();
+                return {s.pool, s.worker, std::forward<R>(r)};
+            }
+
+            static_thread_pool *pool;
+            std::size_t worker;
+        };
+
+        [[nodiscard]] constexpr auto schedule() -> sender {
+            return {pool, worker};
+        }
+
+        // Work scheduled this way runs only on the given worker, so a
+        // pipeline that keeps rescheduling there stays cache-hot.
+        [[nodiscard]] constexpr auto schedule_on(std::size_t w) -> sender {
+            return {pool, w};
+        }
+
+        [[nodiscard]] constexpr static auto concurrency() -> std::size_t {
+            return NumThreads;
+        }
+
+        template <typename T>
+        [[nodiscard]] friend constexpr auto operator==(scheduler x, T const &y)
+            -> bool {
+            if constexpr (std::same_as<T, scheduler>) {
+                return x.pool == y.pool and x.worker == y.worker;
+            }
+            return false;
+        }
+
+        static_thread_pool *pool;
+        std::size_t worker{any_worker};
+    };
+
+    // The pool's environment: its get_scheduler query gives the local
+    // scheduler, so work that reads its scheduler from the pool stays on the
+    // worker that it runs on.
+    struct env {
+        [[nodiscard]] friend auto tag_invoke(get_scheduler_t, env e)
+            -> scheduler {
+            return e.pool->get_local_scheduler();
+        }
+        static_thread_pool *pool;
+    };
+
+    // The worker that the calling thread is, if it is one of this pool's.
+    inline static thread_local static_thread_pool const *current_pool{};
+    inline static thread_local std::size_t current_worker{};
+
+    auto pop_front(std::size_t w) -> op_state_base * {
+        std::unique_lock l{m};
+        auto &local = local_tasks[w];
+        cv.wait(l, [&] {
+            return not local.empty() or not tasks.empty() or stopping;
+        });
+        if (not local.empty()) {
+            return local.pop_front();
+        }
+        return tasks.empty() ? nullptr : tasks.pop_front();
+    }
+
+    auto work(std::size_t w, std::size_t const *cores) -> void {
+        if (cores != nullptr) {
+            pin_this_thread(cores[w]);
+        }
+        current_pool = this;
+        current_worker = w;
+        while (auto op = pop_front(w)) {
+            op->execute();
+        }
+    }
+
+    template <std::size_t... Is>
+    auto start_workers(std::size_t const *cores, std::index_sequence<Is...>)
+        -> std::array<std::thread, NumThreads> {
+        return {std::thread{[this, cores] { work(Is, cores); }}...};
+    }
+
+  public:
+    constexpr static auto any_worker = NumThreads;
+
+    static_thread_pool()
+        : workers{start_workers(nullptr,
+                                std::make_index_sequence<NumThreads>{})} {}
+
+    // Worker i is pinned to CPU core cores[i], which keeps its caches warm.
+    // Pinning does not move memory: operation states stay wherever their
+    // owners put them, so it does not make them local to any NUMA node.
+    explicit static_thread_pool(std::array<std::size_t, NumThreads> cores)
+        : affinity{cores},
+          workers{start_workers(affinity.data(),
+                                std::make_index_sequence<NumThreads>{})} {}
+    static_thread_pool(static_thread_pool &&) = delete;
+
+    // Work that is already queued is run before the workers exit.
+    ~static_thread_pool() {
+        {
+            std::lock_guard l{m};
+            stopping = true;
+        }
+        cv.notify_all();
+        for (auto &w : workers) {
+            w.join();
+        }
+    }
+
+    auto get_scheduler() -> scheduler { return {this}; }
+
+    // A scheduler for one worker's own queue.
+    auto get_scheduler_on(std::size_t w) -> scheduler { return {this, w}; }
+
+    // Called from one of this pool's workers, a scheduler for that worker's
+    // own queue; otherwise, a scheduler for the shared queue.
+    auto get_local_scheduler() -> scheduler {
+        if (current_pool == this) {
+            return {this, current_worker};
+        }
+        return {this};
+    }
+
+    auto push_back(op_state_base *op, std::size_t w = any_worker) -> void {
+        {
+            std::lock_guard l{m};
+            if (w < NumThreads) {
+                local_tasks[w].push_back(op);
+            } else {
+                tasks.push_back(op);
+            }
+        }
+        // Only the target worker can take local work, but we cannot wake
+        // just that one.
+        if (w < NumThreads) {
+            cv.notify_all();
+        } else {
+            cv.notify_one();
+        }
+    }
+
+    [[nodiscard]] constexpr static auto size() -> std::size_t {
+        return NumThreads;
+    }
+
+  private:
+    [[nodiscard]] friend auto tag_invoke(get_env_t, static_thread_pool &p)
+        -> env {
+        return {std::addressof(p)};
+    }
+
+    std::mutex m{};
+    std::condition_variable cv{};
+    stdx::intrusive_list<op_state_base> tasks{};
+    std::array<stdx::intrusive_list<op_state_base>, NumThreads> local_tasks{};
+    bool stopping{};
+    std::array<std::size_t, NumThreads> affinity{};
+    std::array<std::thread, NumThreads> workers;
+};
+} // namespace _thread_pool
+
+using _thread_pool::static_thread_pool;
+} // namespace async
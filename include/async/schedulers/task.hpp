@@ -1,5 +1,7 @@
 #pragma once
 
+#include <async/dispatch_node.hpp>
+
 #include <stdx/concepts.hpp>
 #include <stdx/function_traits.hpp>
 #include <stdx/tuple.hpp>
@@ -11,11 +13,14 @@
 #include <utility>
 
 namespace async {
-// NOLINTNEXTLINE(*-special-member-functions)
-struct task_base {
+// A task is a dispatch_node: it runs through the function that the most
+// derived type gives to task_base (see run_task below).
+struct task_base : dispatch_node {
+    using dispatch_node::dispatch_node;
+
+    auto run() -> void { dispatch(); }
+
     bool pending{};
-    virtual auto run() -> void = 0;
-    virtual ~task_base() = default;
 
   private:
     [[nodiscard]] friend constexpr auto operator==(task_base const &lhs,
@@ -24,25 +29,40 @@ struct task_base {
     }
 };
 
+// The function with which a task of type T runs: it calls T's own run().
+template <typename T>
+constexpr inline dispatch_node::fn_t run_task = dispatch_to<T, &T::run>;
+
 // NOLINTNEXTLINE(*-special-member-functions)
 template <std::derived_from<task_base> Base> struct single_linked_task : Base {
-    constexpr single_linked_task() = default;
+    using Base::Base;
     constexpr single_linked_task(single_linked_task &&) = delete;
     single_linked_task *next{};
 };
 
 // NOLINTNEXTLINE(*-special-member-functions)
 template <std::derived_from<task_base> Base> struct double_linked_task : Base {
-    constexpr double_linked_task() = default;
+    using Base::Base;
     constexpr double_linked_task(double_linked_task &&) = delete;
     double_linked_task *next{};
     double_linked_task *prev{};
 };
 
+// NOLINTNEXTLINE(*-special-member-functions)
+template <std::derived_from<task_base> Base> struct heap_linked_task : Base {
+    using Base::Base;
+    constexpr heap_linked_task(heap_linked_task &&) = delete;
+    heap_linked_task *next{};
+    heap_linked_task *prev{};
+    heap_linked_task *child{};
+};
+
 template <stdx::callable F, typename ArgTuple, typename Base>
 struct task : Base {
-    constexpr explicit(true) task(F const &f) : func(f) {}
-    constexpr explicit(true) task(F &&f) : func(std::move(f)) {}
+    constexpr explicit(true) task(F const &f)
+        : Base{run_task<task>}, func(f) {}
+    constexpr explicit(true) task(F &&f)
+        : Base{run_task<task>}, func(std::move(f)) {}
 
     template <typename... Args> auto bind_front(Args &&...args) -> task & {
         [&]<std::size_t... Is>(std::index_sequence<Is...>) {
@@ -51,7 +71,7 @@ struct task : Base {
         return *this;
     }
 
-    auto run() -> void final { bound_args.apply(func); }
+    auto run() -> void { bound_args.apply(func); }
 
     [[no_unique_address]] F func;
     [[no_unique_address]] ArgTuple bound_args{};
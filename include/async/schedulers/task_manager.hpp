@@ -1,8 +1,10 @@
 #pragma once
 
+#include <async/schedulers/task_manager_instrumentation.hpp>
 #include <async/schedulers/task_manager_interface.hpp>
 #include <conc/concurrency.hpp>
 
+#include <stdx/bitset.hpp>
 #include <stdx/function_traits.hpp>
 #include <stdx/intrusive_forward_list.hpp>
 #include <stdx/tuple.hpp>
@@ -11,62 +13,206 @@
 #include <atomic>
 #include <concepts>
 #include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <memory>
 #include <type_traits>
 #include <utility>
 
 namespace async {
+namespace detail {
+template <typename T> struct task_queue {
+    using type = stdx::intrusive_forward_list<T>;
+};
+template <index_single_linkable T> struct task_queue<T> {
+    using type = index_forward_list<T>;
+};
+template <typename T> using task_queue_t = typename task_queue<T>::type;
+} // namespace detail
+
 namespace requeue_policy {
 struct immediate {
     template <priority_t P, typename>
-    [[nodiscard]] constexpr static auto get_queue(auto &queues) -> auto & {
+    [[nodiscard]] constexpr static auto get_queue(auto &queues, auto &&...)
+        -> auto & {
         return queues[P];
     }
 };
 
 struct deferred {
     template <priority_t P, typename Mutex>
-    [[nodiscard]] constexpr static auto get_queue(auto &queues) {
-        return conc::call_in_critical_section<Mutex>(
-            [&]() { return std::exchange(queues[P], {}); });
+    [[nodiscard]] constexpr static auto get_queue(auto &queues,
+                                                  auto &&...on_detach) {
+        return conc::call_in_critical_section<Mutex>([&]() {
+            (on_detach(), ...);
+            return std::exchange(queues[P], {});
+        });
     }
 };
 } // namespace requeue_policy
 
+namespace aging {
+// No aging: service_highest always picks the highest ready priority.
+struct none {
+    template <std::size_t NumPriorities> struct state {
+        [[nodiscard]] constexpr static auto
+        select(stdx::bitset<NumPriorities> const &ready) -> std::size_t {
+            return (~ready).lowest_unset();
+        }
+    };
+};
+
+// Each time service_highest passes over a ready priority in favour of a
+// higher one, that priority ages by one round. Once it has waited Rounds
+// rounds it is serviced next, ahead of higher priorities.
+template <std::uint16_t Rounds> struct after_rounds {
+    static_assert(Rounds > 0, "aging needs at least one round");
+
+    template <std::size_t NumPriorities> struct state {
+        [[nodiscard]] constexpr auto
+        select(stdx::bitset<NumPriorities> const &ready) -> std::size_t {
+            auto selected = (~ready).lowest_unset();
+            for (auto p = selected + 1; p < NumPriorities; ++p) {
+                if (not ready[p]) {
+                    waits[p] = 0;
+                } else if (++waits[p] >= Rounds and
+                           waits[selected] < Rounds) {
+                    selected = p;
+                }
+            }
+            if (selected < NumPriorities) {
+                waits[selected] = 0;
+            }
+            return selected;
+        }
+
+      private:
+        std::array<std::uint16_t, NumPriorities> waits{};
+    };
+};
+} // namespace aging
+
 namespace detail {
 template <typename T>
 concept scheduler_hal = requires {
     { T::schedule(priority_t{}) } -> std::same_as<void>;
 };
-}
+} // namespace detail
+
+namespace detail {
+// A HAL that reports the priority at which the caller runs (for instance,
+// from the active interrupt) allows handoff::when_priority_permits.
+template <typename T>
+concept priority_aware_hal = scheduler_hal<T> and requires {
+    { T::current_priority() } -> std::same_as<priority_t>;
+};
+} // namespace detail
 
 namespace archetypes {
 struct scheduler_hal {
     constexpr static auto schedule(priority_t) -> void {}
 };
+
+struct priority_aware_hal : scheduler_hal {
+    constexpr static auto current_priority() -> priority_t { return 0; }
+};
 } // namespace archetypes
 static_assert(detail::scheduler_hal<archetypes::scheduler_hal>);
+static_assert(detail::priority_aware_hal<archetypes::priority_aware_hal>);
+
+// A HAL for poll mode: scheduling a priority raises no interrupt, so
+// enqueueing a task only marks its priority ready, and the main loop runs
+// tasks by calling poll().
+struct polling_hal {
+    constexpr static auto schedule(priority_t) -> void {}
+};
+static_assert(detail::scheduler_hal<polling_hal>);
 
 template <detail::scheduler_hal S, std::size_t NumPriorities,
-          prioritizable_task Task = priority_task>
+          prioritizable_task Task = priority_task,
+          typename Instrumentation = instrumentation::none,
+          typename Aging = aging::none>
 struct priority_task_manager {
     using task_t = Task;
 
   private:
     struct mutex;
-    std::array<stdx::intrusive_forward_list<task_t>, NumPriorities>
-        task_queues{};
+    std::array<detail::task_queue_t<task_t>, NumPriorities> task_queues{};
+    stdx::bitset<NumPriorities> ready{};
+    std::array<std::size_t, NumPriorities> queue_sizes{};
     std::atomic<int> task_count{};
+    [[no_unique_address]] Instrumentation instr{};
+    [[no_unique_address]] typename Aging::template state<NumPriorities>
+        aging_state{};
+
+    auto run_task(task_t &task, priority_t p) -> void {
+        instr.on_run_start(task, p);
+        task.run();
+        instr.on_run_end(task, p);
+        --task_count;
+    }
+
+    template <priority_t P> auto run_task(task_t &task) -> void {
+        run_task(task, P);
+    }
+
+    // must be called in a critical section
+    auto pop_front(std::size_t p) -> task_t * {
+        auto &q = task_queues[p];
+        if (std::empty(q)) {
+            return nullptr;
+        }
+        auto &task = q.front();
+        q.pop_front();
+        task.pending = false;
+        if (--queue_sizes[p] == 0) {
+            ready.reset(p);
+        }
+        return std::addressof(task);
+    }
+
+    template <priority_t P> auto pop_task() -> task_t * {
+        return conc::call_in_critical_section<mutex>(
+            [&]() -> task_t * { return pop_front(P); });
+    }
+
+    template <priority_t P>
+    auto service_while(auto keep_going) -> std::size_t {
+        while (keep_going()) {
+            auto const task = pop_task<P>();
+            if (task == nullptr) {
+                return 0;
+            }
+            run_task<P>(*task);
+        }
+        return conc::call_in_critical_section<mutex>([&] {
+            auto const remaining = queue_sizes[P];
+            if (remaining != 0) {
+                S::schedule(P);
+            }
+            return remaining;
+        });
+    }
+
+    template <typename RQP, std::size_t... Is>
+    auto service_priority(priority_t p, std::index_sequence<Is...>) -> void {
+        using F = void (priority_task_manager::*)();
+        constexpr static auto service_fns = std::array<F, NumPriorities>{
+            &priority_task_manager::template service_tasks<Is, RQP>...};
+        (this->*service_fns[p])();
+    }
 
   public:
     constexpr static auto create_task = async::create_task<task_t>;
 
     auto enqueue_task(task_t &t, priority_t p) -> bool {
         return conc::call_in_critical_section<mutex>([&]() -> bool {
-            auto const added = not std::exchange(t.pending, true);
+            auto const added = not std::atomic_ref{t.pending}.exchange(true);
             if (added) {
                 ++task_count;
                 task_queues[p].push_back(std::addressof(t));
+                instr.on_enqueue(t, p, ++queue_sizes[p]);
+                ready.set(p);
                 S::schedule(p);
             }
             return added;
@@ -81,19 +227,106 @@ struct priority_task_manager {
     auto service_tasks() -> void
         requires(valid_priority<P>())
     {
-        decltype(auto) q = RQP::template get_queue<P, mutex>(task_queues);
-        while (not std::empty(q)) {
-            auto &task = q.front();
-            conc::call_in_critical_section<mutex>([&]() {
-                q.pop_front();
-                task.pending = false;
+        decltype(auto) q =
+            RQP::template get_queue<P, mutex>(task_queues, [&] {
+                ready.reset(P);
+                queue_sizes[P] = 0;
             });
-            task.run();
-            --task_count;
+        if constexpr (std::is_reference_v<decltype(q)>) {
+            while (auto const task = pop_task<P>()) {
+                run_task<P>(*task);
+            }
+        } else {
+            // a detached batch is owned here: enqueue_task cannot touch a
+            // task's links until its pending flag is cleared, so the batch
+            // runs without further critical sections
+            while (not std::empty(q)) {
+                auto &task = q.front();
+                q.pop_front();
+                std::atomic_ref{task.pending}.store(false,
+                                                    std::memory_order_release);
+                run_task<P>(task);
+            }
+        }
+    }
+
+    // Bounded servicing pops tasks from the live queue one at a time, so
+    // tasks queued during servicing count against the same budget. The
+    // number of tasks left at P is returned; if any are left, the priority
+    // is scheduled again.
+    template <priority_t P>
+    auto service_tasks(std::size_t max_tasks) -> std::size_t
+        requires(valid_priority<P>())
+    {
+        return service_while<P>([&] { return max_tasks-- != 0; });
+    }
+
+    template <priority_t P, detail::clock_hal Clock>
+    auto service_tasks(typename Clock::time_point_t deadline) -> std::size_t
+        requires(valid_priority<P>())
+    {
+        return service_while<P>([&] { return Clock::now() < deadline; });
+    }
+
+    // A runtime entry point for servicing a priority, e.g. from an interrupt
+    // vector shared by several priorities. The priority indexes a table of
+    // service_tasks<P> instantiations built at compile time, so dispatch is
+    // one indirect call. The priority must be less than NumPriorities.
+    template <typename RQP = requeue_policy::deferred>
+    auto service_tasks(priority_t p) -> void {
+        service_priority<RQP>(p, std::make_index_sequence<NumPriorities>{});
+    }
+
+    template <typename RQP = requeue_policy::deferred>
+    auto service_highest() -> bool {
+        auto const p = conc::call_in_critical_section<mutex>(
+            [&] { return aging_state.select(ready); });
+        if (p == NumPriorities) {
+            return false;
         }
+        service_tasks<RQP>(static_cast<priority_t>(p));
+        return true;
+    }
+
+    // Runs tasks one at a time from the highest ready priority (as chosen by
+    // the aging policy), until no task is ready or max_tasks have run, and
+    // returns the number that ran. Priorities are chosen again before each
+    // task, so a task queued at a higher priority meanwhile runs next. With a
+    // polling_hal, this is how a main loop dispatches tasks.
+    auto poll(std::size_t max_tasks = std::numeric_limits<std::size_t>::max())
+        -> std::size_t {
+        auto ran = std::size_t{};
+        while (ran != max_tasks) {
+            auto p = priority_t{};
+            auto const task =
+                conc::call_in_critical_section<mutex>([&]() -> task_t * {
+                    auto const selected = aging_state.select(ready);
+                    if (selected == NumPriorities) {
+                        return nullptr;
+                    }
+                    p = static_cast<priority_t>(selected);
+                    return pop_front(selected);
+                });
+            if (task == nullptr) {
+                break;
+            }
+            run_task(*task, p);
+            ++ran;
+        }
+        return ran;
     }
 
     [[nodiscard]] auto is_idle() const -> bool { return task_count == 0; }
+
+    [[nodiscard]] static auto current_priority() -> priority_t
+        requires detail::priority_aware_hal<S>
+    {
+        return S::current_priority();
+    }
+
+    [[nodiscard]] auto get_instrumentation() const -> Instrumentation const & {
+        return instr;
+    }
 };
 static_assert(
     task_manager<priority_task_manager<archetypes::scheduler_hal, 16>>);
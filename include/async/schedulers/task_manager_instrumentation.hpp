@@ -0,0 +1,117 @@
+#pragma once
+
+#include <async/schedulers/task.hpp>
+#include <async/schedulers/task_manager_interface.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace async {
+namespace detail {
+template <typename T>
+concept clock_hal = requires {
+    { T::now() } -> std::same_as<typename T::time_point_t>;
+};
+
+template <typename D> constexpr auto to_ticks(D d) -> std::uint64_t {
+    if constexpr (requires { d.count(); }) {
+        return static_cast<std::uint64_t>(d.count());
+    } else {
+        return static_cast<std::uint64_t>(d);
+    }
+}
+} // namespace detail
+
+// A task that records when it was enqueued, so that an instrumentation
+// policy can measure enqueue-to-run latency.
+template <typename TimePoint> struct timestamped_task_base : task_base {
+    using task_base::task_base;
+
+    TimePoint enqueue_time{};
+};
+
+template <typename TimePoint>
+using timestamped_priority_task =
+    single_linked_task<timestamped_task_base<TimePoint>>;
+
+namespace instrumentation {
+// The default policy: every hook is empty and the manager stores nothing. The
+// on_arm, on_expiry and on_cancel hooks are called by generic_timer_manager.
+struct none {
+    constexpr static auto on_enqueue(auto const &, priority_t, std::size_t)
+        -> void {}
+    constexpr static auto on_run_start(auto const &, priority_t) -> void {}
+    constexpr static auto on_run_end(auto const &, priority_t) -> void {}
+
+    constexpr static auto on_arm(auto const &) -> void {}
+    constexpr static auto on_expiry(auto const &) -> void {}
+    constexpr static auto on_cancel(auto const &) -> void {}
+};
+
+// A histogram with power-of-two buckets: bucket 0 counts zero values and
+// bucket N counts values in [2^(N-1), 2^N). The last bucket also counts
+// everything larger.
+template <std::size_t NumBuckets = 32> struct histogram {
+    std::array<std::uint32_t, NumBuckets> buckets{};
+
+    constexpr auto record(std::uint64_t value) -> void {
+        auto const b = std::min(static_cast<std::size_t>(std::bit_width(value)),
+                                NumBuckets - 1);
+        ++buckets[b];
+    }
+
+    [[nodiscard]] constexpr auto count() const -> std::uint64_t {
+        std::uint64_t total{};
+        for (auto b : buckets) {
+            total += b;
+        }
+        return total;
+    }
+};
+
+template <std::size_t NumBuckets = 32> struct priority_stats {
+    std::size_t high_water_mark{};
+    histogram<NumBuckets> latency{};
+    histogram<NumBuckets> run_time{};
+};
+
+// Records per-priority queue high-water marks, enqueue-to-run latency and
+// run time. Latency is only recorded for tasks that carry an enqueue_time
+// (see timestamped_priority_task).
+template <detail::clock_hal Clock, std::size_t NumPriorities,
+          std::size_t NumBuckets = 32>
+struct histograms {
+    using time_point_t = typename Clock::time_point_t;
+
+    std::array<priority_stats<NumBuckets>, NumPriorities> stats{};
+
+    auto on_enqueue(auto &task, priority_t p, std::size_t depth) -> void {
+        auto &s = stats[p];
+        s.high_water_mark = std::max(s.high_water_mark, depth);
+        if constexpr (requires { task.enqueue_time = Clock::now(); }) {
+            task.enqueue_time = Clock::now();
+        }
+    }
+
+    auto on_run_start(auto const &task, priority_t p) -> void {
+        run_start[p] = Clock::now();
+        if constexpr (requires { run_start[p] - task.enqueue_time; }) {
+            stats[p].latency.record(
+                detail::to_ticks(run_start[p] - task.enqueue_time));
+        }
+    }
+
+    auto on_run_end(auto const &, priority_t p) -> void {
+        stats[p].run_time.record(detail::to_ticks(Clock::now() - run_start[p]));
+    }
+
+  private:
+    std::array<time_point_t, NumPriorities> run_start{};
+};
+} // namespace instrumentation
+} // namespace async
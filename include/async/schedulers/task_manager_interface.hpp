@@ -1,11 +1,15 @@
 #pragma once
 
+#include <async/schedulers/index_linked_task.hpp>
 #include <async/schedulers/task.hpp>
 
 #include <stdx/intrusive_forward_list.hpp>
 #include <stdx/type_traits.hpp>
 
 #include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <type_traits>
 #include <utility>
 
@@ -13,7 +17,8 @@ namespace async {
 using priority_t = std::uint8_t;
 
 template <typename T>
-concept prioritizable_task = stdx::single_linkable<T> and
+concept prioritizable_task = (stdx::single_linkable<T> or
+                              index_single_linkable<T>) and
                              std::equality_comparable<T> and requires(T *t) {
                                  { t->run() } -> std::same_as<void>;
                                  { t->pending } -> std::same_as<bool &>;
@@ -91,6 +96,34 @@ template <priority_t P, typename... DummyArgs>
 constexpr auto valid_priority() -> bool {
     return injected_task_manager<DummyArgs...>.template valid_priority<P>();
 }
+
+// The number of tasks at one priority that the task manager can run at once.
+template <typename... DummyArgs>
+    requires(sizeof...(DummyArgs) == 0)
+constexpr auto concurrency() -> std::size_t {
+    using task_manager_t =
+        std::remove_cvref_t<decltype(injected_task_manager<DummyArgs...>)>;
+    if constexpr (requires { task_manager_t::concurrency(); }) {
+        return task_manager_t::concurrency();
+    } else {
+        return 1;
+    }
+}
+
+template <typename... DummyArgs>
+    requires(sizeof...(DummyArgs) == 0)
+auto current_priority() -> priority_t {
+    constexpr auto reports_priority =
+        requires { injected_task_manager<DummyArgs...>.current_priority(); };
+    static_assert(reports_priority,
+                  "Running tasks inline needs a task manager whose HAL "
+                  "reports current_priority()");
+    if constexpr (reports_priority) {
+        return injected_task_manager<DummyArgs...>.current_priority();
+    } else {
+        return {};
+    }
+}
 } // namespace detail
 
 template <priority_t P, typename... DummyArgs>
@@ -99,6 +132,39 @@ auto service_tasks() -> void {
     return injected_task_manager<DummyArgs...>.template service_tasks<P>();
 }
 
+template <typename... DummyArgs>
+    requires(sizeof...(DummyArgs) == 0)
+auto service_tasks(priority_t p) -> void {
+    return injected_task_manager<DummyArgs...>.service_tasks(p);
+}
+
+template <priority_t P, typename... DummyArgs>
+    requires(sizeof...(DummyArgs) == 0)
+auto service_tasks(std::size_t max_tasks) -> std::size_t {
+    return injected_task_manager<DummyArgs...>.template service_tasks<P>(
+        max_tasks);
+}
+
+template <priority_t P, typename Clock, typename... DummyArgs>
+    requires(sizeof...(DummyArgs) == 0)
+auto service_tasks(typename Clock::time_point_t deadline) -> std::size_t {
+    return injected_task_manager<DummyArgs...>
+        .template service_tasks<P, Clock>(deadline);
+}
+
+template <typename... DummyArgs>
+    requires(sizeof...(DummyArgs) == 0)
+auto service_highest() -> bool {
+    return injected_task_manager<DummyArgs...>.service_highest();
+}
+
+template <typename... DummyArgs>
+    requires(sizeof...(DummyArgs) == 0)
+auto poll(std::size_t max_tasks = std::numeric_limits<std::size_t>::max())
+    -> std::size_t {
+    return injected_task_manager<DummyArgs...>.poll(max_tasks);
+}
+
 template <typename... DummyArgs>
     requires(sizeof...(DummyArgs) == 0)
 auto is_idle() -> bool {
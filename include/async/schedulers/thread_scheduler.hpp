@@ -8,11 +8,13 @@
 #include <async/concepts.hpp>
 #include <async/env.hpp>
 #include <async/tags.hpp>
+#include <async/trace.hpp>
 #include <async/type_traits.hpp>
 
 #include <stdx/concepts.hpp>
 
 #include <concepts>
+#include <memory>
 #include <thread>
 #include <type_traits>
 #include <utility>
@@ -25,7 +27,11 @@ class thread_scheduler {
       private:
         template <stdx::same_as_unqualified<op_state> O>
         friend auto tag_invoke(start_t, O &&o) -> void {
+            detail::trace<trace_kind::thread_scheduler, start_t>(
+                o.receiver, std::addressof(o));
             std::thread{[&] {
+                detail::trace<trace_kind::thread_scheduler, set_value_t>(
+                    o.receiver, std::addressof(o));
                 set_value(std::forward<O>(o).receiver);
             }}.detach();
         }
@@ -63,6 +69,8 @@ class thread_scheduler {
         -> bool = default;
 
   public:
+    using elides_redundant_hops = void;
+
     [[nodiscard]] constexpr static auto schedule() -> sender { return {}; }
 };
 } // namespace async
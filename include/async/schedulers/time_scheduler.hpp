@@ -4,10 +4,12 @@
 #include <async/env.hpp>
 #include <async/schedulers/timer_manager_interface.hpp>
 #include <async/tags.hpp>
+#include <async/trace.hpp>
 #include <async/type_traits.hpp>
 
 #include <stdx/concepts.hpp>
 
+#include <concepts>
 #include <memory>
 #include <optional>
 #include <type_traits>
@@ -18,19 +20,63 @@ namespace timer_mgr {
 template <typename Rcvr, typename Task> struct op_state_base : Task {
     template <stdx::same_as_unqualified<Rcvr> R>
     // NOLINTNEXTLINE(bugprone-forwarding-reference-overload)
-    constexpr explicit(true) op_state_base(R &&r) : rcvr{std::forward<R>(r)} {}
+    constexpr explicit(true) op_state_base(R &&r)
+        : Task{run_task<op_state_base>}, rcvr{std::forward<R>(r)} {}
 
-    auto run() -> void final { set_value(std::move(rcvr)); }
+    auto run() -> void {
+        ::async::detail::trace<trace_kind::time_scheduler, set_value_t>(rcvr,
+                                                                        this);
+        set_value(std::move(rcvr));
+    }
 
     [[no_unique_address]] Rcvr rcvr;
 };
 
-template <typename Domain, typename Duration, typename Rcvr, typename Task>
+// An absolute time at which to run a task, used in place of a duration.
+template <typename TimePoint> struct deadline {
+    TimePoint time_point{};
+};
+
+template <typename T> constexpr auto is_deadline_v = false;
+template <typename TP> constexpr auto is_deadline_v<deadline<TP>> = true;
+
+// Slack from the receiver's environment is passed on to the timer manager
+// when it accepts it; otherwise the timer is armed as usual.
+template <typename Domain, typename O> auto start_timer(O &o) -> void {
+    ::async::detail::trace<trace_kind::time_scheduler, start_t>(
+        o.rcvr, std::addressof(o));
+    using slack_t = timer_slack_of_t<env_of_t<decltype(o.rcvr)>>;
+    if constexpr (is_deadline_v<decltype(o.d)>) {
+        detail::run_at<Domain>(o, o.d.time_point);
+    } else if constexpr (not std::same_as<slack_t, no_timer_slack> and
+                  requires(slack_t s) {
+                      detail::get_injected_manager<Domain>().run_after(o, o.d,
+                                                                       s);
+                  }) {
+        detail::run_after<Domain>(o, o.d, get_timer_slack(get_env(o.rcvr)));
+    } else {
+        detail::run_after<Domain>(o, o.d);
+    }
+}
+
+namespace cancellation {
+// A stop callback is registered when the timer starts, so a stop request
+// cancels the timer at once.
+struct immediate;
+// Nothing is registered: a stop request is noticed when the timer expires,
+// which then completes with set_stopped. This saves a critical section on
+// every start, for timers that are rarely cancelled.
+struct on_expiry;
+} // namespace cancellation
+
+template <typename Domain, typename Duration, typename Rcvr, typename Task,
+          typename Cancellation = cancellation::immediate>
 struct op_state;
 
-template <typename Domain, typename Duration, typename Rcvr, typename Task>
+template <typename Domain, typename Duration, typename Rcvr, typename Task,
+          typename Cancellation>
     requires unstoppable_token<stop_token_of_t<env_of_t<Rcvr>>>
-struct op_state<Domain, Duration, Rcvr, Task> final
+struct op_state<Domain, Duration, Rcvr, Task, Cancellation> final
     : op_state_base<Rcvr, Task> {
     template <stdx::same_as_unqualified<Rcvr> R>
     // NOLINTNEXTLINE(bugprone-forwarding-reference-overload)
@@ -42,13 +88,13 @@ struct op_state<Domain, Duration, Rcvr, Task> final
   private:
     template <stdx::same_as_unqualified<op_state> O>
     friend constexpr auto tag_invoke(start_t, O &&o) -> void {
-        detail::run_after<Domain>(o, o.d);
+        start_timer<Domain>(o);
     }
 };
 
 template <typename Domain, typename Duration, typename Rcvr, typename Task>
     requires(not unstoppable_token<stop_token_of_t<env_of_t<Rcvr>>>)
-struct op_state<Domain, Duration, Rcvr, Task> final
+struct op_state<Domain, Duration, Rcvr, Task, cancellation::immediate> final
     : op_state_base<Rcvr, Task> {
     template <stdx::same_as_unqualified<Rcvr> R>
     // NOLINTNEXTLINE(bugprone-forwarding-reference-overload)
@@ -60,7 +106,7 @@ struct op_state<Domain, Duration, Rcvr, Task> final
   private:
     struct stop_callback_fn {
         auto operator()() -> void {
-            if (detail::cancel(*ops)) {
+            if (detail::cancel<Domain>(*ops)) {
                 set_stopped(std::move(ops->rcvr));
             }
         }
@@ -73,7 +119,7 @@ struct op_state<Domain, Duration, Rcvr, Task> final
         if (token.stop_requested()) {
             set_stopped(std::forward<O>(o).rcvr);
         } else {
-            detail::run_after<Domain>(o, o.d);
+            start_timer<Domain>(o);
             o.stop_cb.emplace(token, stop_callback_fn{std::addressof(o)});
         }
     }
@@ -82,10 +128,227 @@ struct op_state<Domain, Duration, Rcvr, Task> final
         stop_callback_for_t<stop_token_of_t<env_of_t<Rcvr>>, stop_callback_fn>;
     std::optional<stop_callback_t> stop_cb{};
 };
+
+template <typename Domain, typename Duration, typename Rcvr, typename Task>
+    requires(not unstoppable_token<stop_token_of_t<env_of_t<Rcvr>>>)
+struct op_state<Domain, Duration, Rcvr, Task, cancellation::on_expiry> final
+    : Task {
+    template <stdx::same_as_unqualified<Rcvr> R>
+    // NOLINTNEXTLINE(bugprone-forwarding-reference-overload)
+    constexpr explicit(true) op_state(R &&r, Duration dur)
+        : Task{run_task<op_state>}, rcvr{std::forward<R>(r)}, d{dur} {}
+
+    auto run() -> void {
+        if (get_stop_token(get_env(rcvr)).stop_requested()) {
+            ::async::detail::trace<trace_kind::time_scheduler, set_stopped_t>(
+                rcvr, this);
+            set_stopped(std::move(rcvr));
+        } else {
+            ::async::detail::trace<trace_kind::time_scheduler, set_value_t>(
+                rcvr, this);
+            set_value(std::move(rcvr));
+        }
+    }
+
+    [[no_unique_address]] Rcvr rcvr;
+    [[no_unique_address]] Duration d{};
+
+  private:
+    template <stdx::same_as_unqualified<op_state> O>
+    friend constexpr auto tag_invoke(start_t, O &&o) -> void {
+        if (get_stop_token(get_env(o.rcvr)).stop_requested()) {
+            set_stopped(std::forward<O>(o).rcvr);
+        } else {
+            start_timer<Domain>(o);
+        }
+    }
+};
+
+// The op state of a periodic sender is its own timer task. After the first
+// expiry it is requeued relative to its previous expiration time, so the
+// period does not drift and nothing is reconnected.
+template <typename Domain, typename Duration, typename Rcvr, typename F,
+          typename Task>
+struct periodic_op_state_base : Task {
+    template <stdx::same_as_unqualified<Rcvr> R, stdx::same_as_unqualified<F> G>
+    constexpr periodic_op_state_base(R &&r, Duration dur, G &&g)
+        : Task{run_task<periodic_op_state_base>}, rcvr{std::forward<R>(r)},
+          d{dur}, f{std::forward<G>(g)} {}
+
+    auto run() -> void {
+        if (get_stop_token(get_env(rcvr)).stop_requested()) {
+            set_stopped(std::move(rcvr));
+            return;
+        }
+        if constexpr (std::same_as<std::invoke_result_t<F &>, bool>) {
+            if (f()) {
+                set_value(std::move(rcvr));
+                return;
+            }
+        } else {
+            f();
+        }
+        if (get_stop_token(get_env(rcvr)).stop_requested()) {
+            set_stopped(std::move(rcvr));
+        } else if constexpr (requires {
+                                 detail::get_injected_manager<Domain>()
+                                     .run_after_expiry(*this, d);
+                             }) {
+            detail::run_after_expiry<Domain>(*this, d);
+        } else {
+            detail::run_after<Domain>(*this, d);
+        }
+    }
+
+    [[no_unique_address]] Rcvr rcvr;
+    [[no_unique_address]] Duration d{};
+    [[no_unique_address]] F f;
+};
+
+template <typename Domain, typename Duration, typename Rcvr, typename F,
+          typename Task, typename Cancellation = cancellation::immediate>
+struct periodic_op_state;
+
+template <typename Domain, typename Duration, typename Rcvr, typename F,
+          typename Task, typename Cancellation>
+    requires unstoppable_token<stop_token_of_t<env_of_t<Rcvr>>>
+struct periodic_op_state<Domain, Duration, Rcvr, F, Task, Cancellation> final
+    : periodic_op_state_base<Domain, Duration, Rcvr, F, Task> {
+    using periodic_op_state_base<Domain, Duration, Rcvr, F,
+                                 Task>::periodic_op_state_base;
+
+  private:
+    template <stdx::same_as_unqualified<periodic_op_state> O>
+    friend constexpr auto tag_invoke(start_t, O &&o) -> void {
+        start_timer<Domain>(o);
+    }
+};
+
+template <typename Domain, typename Duration, typename Rcvr, typename F,
+          typename Task>
+    requires(not unstoppable_token<stop_token_of_t<env_of_t<Rcvr>>>)
+struct periodic_op_state<Domain, Duration, Rcvr, F, Task,
+                         cancellation::immediate> final
+    : periodic_op_state_base<Domain, Duration, Rcvr, F, Task> {
+    using periodic_op_state_base<Domain, Duration, Rcvr, F,
+                                 Task>::periodic_op_state_base;
+
+  private:
+    struct stop_callback_fn {
+        auto operator()() -> void {
+            if (detail::cancel<Domain>(*ops)) {
+                set_stopped(std::move(ops->rcvr));
+            }
+        }
+        periodic_op_state *ops;
+    };
+
+    template <stdx::same_as_unqualified<periodic_op_state> O>
+    friend constexpr auto tag_invoke(start_t, O &&o) -> void {
+        auto token = get_stop_token(get_env(o.rcvr));
+        if (token.stop_requested()) {
+            set_stopped(std::forward<O>(o).rcvr);
+        } else {
+            start_timer<Domain>(o);
+            o.stop_cb.emplace(token, stop_callback_fn{std::addressof(o)});
+        }
+    }
+
+    using stop_callback_t =
+        stop_callback_for_t<stop_token_of_t<env_of_t<Rcvr>>, stop_callback_fn>;
+    std::optional<stop_callback_t> stop_cb{};
+};
+
+// A stop request is noticed at the next expiry, before f is called.
+template <typename Domain, typename Duration, typename Rcvr, typename F,
+          typename Task>
+    requires(not unstoppable_token<stop_token_of_t<env_of_t<Rcvr>>>)
+struct periodic_op_state<Domain, Duration, Rcvr, F, Task,
+                         cancellation::on_expiry> final
+    : periodic_op_state_base<Domain, Duration, Rcvr, F, Task> {
+    using periodic_op_state_base<Domain, Duration, Rcvr, F,
+                                 Task>::periodic_op_state_base;
+
+  private:
+    template <stdx::same_as_unqualified<periodic_op_state> O>
+    friend constexpr auto tag_invoke(start_t, O &&o) -> void {
+        if (get_stop_token(get_env(o.rcvr)).stop_requested()) {
+            set_stopped(std::forward<O>(o).rcvr);
+        } else {
+            start_timer<Domain>(o);
+        }
+    }
+};
+
+template <typename Domain, typename Duration, typename F, typename Task,
+          typename Cancellation = cancellation::immediate>
+struct periodic_sender {
+    using is_sender = void;
+    [[no_unique_address]] Duration d{};
+    [[no_unique_address]] F f;
+
+  private:
+    template <stdx::same_as_unqualified<periodic_sender> S, receiver R>
+    [[nodiscard]] friend constexpr auto tag_invoke(connect_t, S &&s, R &&r) {
+        check_connect<S, R>();
+        return periodic_op_state<Domain, Duration, std::remove_cvref_t<R>, F,
+                                 Task, Cancellation>{std::forward<R>(r), s.d,
+                                                     std::forward<S>(s).f};
+    }
+
+    template <typename Env>
+    [[nodiscard]] friend constexpr auto
+    tag_invoke(get_completion_signatures_t, periodic_sender const &,
+               Env const &) noexcept {
+        constexpr auto finite = std::same_as<std::invoke_result_t<F &>, bool>;
+        constexpr auto stoppable = not unstoppable_token<stop_token_of_t<Env>>;
+        if constexpr (finite and stoppable) {
+            return completion_signatures<set_value_t(), set_stopped_t()>{};
+        } else if constexpr (finite) {
+            return completion_signatures<set_value_t()>{};
+        } else if constexpr (stoppable) {
+            return completion_signatures<set_stopped_t()>{};
+        } else {
+            return completion_signatures<>{};
+        }
+    }
+};
+
+template <typename Domain, typename TimePoint, typename Task>
+struct deadline_sender {
+    using is_sender = void;
+    [[no_unique_address]] deadline<TimePoint> d{};
+
+  private:
+    template <stdx::same_as_unqualified<deadline_sender> S, receiver R>
+    [[nodiscard]] friend constexpr auto tag_invoke(connect_t, S &&s, R &&r) {
+        check_connect<S, R>();
+        return op_state<Domain, deadline<TimePoint>, std::remove_cvref_t<R>,
+                        Task>{std::forward<R>(r), s.d};
+    }
+
+    template <typename Env>
+    [[nodiscard]] friend constexpr auto tag_invoke(get_completion_signatures_t,
+                                                   deadline_sender,
+                                                   Env const &) noexcept
+        -> completion_signatures<set_value_t(), set_stopped_t()> {
+        return {};
+    }
+
+    template <typename Env>
+        requires unstoppable_token<stop_token_of_t<Env>>
+    [[nodiscard]] friend constexpr auto tag_invoke(get_completion_signatures_t,
+                                                   deadline_sender,
+                                                   Env const &) noexcept
+        -> completion_signatures<set_value_t()> {
+        return {};
+    }
+};
 } // namespace timer_mgr
 
 template <typename Domain, typename Duration,
-          typename Task = timer_task<timer_mgr::time_point_for_t<Duration>>>
+          typename Task = timer_task<timer_mgr::time_point_for_t<Duration>>,
+          typename Cancellation = timer_mgr::cancellation::immediate>
 class time_scheduler {
     struct env {
         [[nodiscard]] friend constexpr auto
@@ -107,7 +370,8 @@ class time_scheduler {
                                                        R &&r) {
             check_connect<S, R>();
             return timer_mgr::op_state<Domain, Duration, std::remove_cvref_t<R>,
-                                       Task>{std::forward<R>(r), s.d};
+                                       Task, Cancellation>{std::forward<R>(r),
+                                                           s.d};
         }
 
         [[nodiscard]] friend constexpr auto tag_invoke(get_env_t,
@@ -150,7 +414,38 @@ class time_scheduler {
 template <typename D>
 time_scheduler(D) -> time_scheduler<timer_mgr::default_domain, D>;
 
-template <typename Domain = timer_mgr::default_domain>
+// Completes at an absolute time point rather than after a duration, so
+// senders chained against one precomputed deadline need no clock reads.
+template <typename Domain = timer_mgr::default_domain, typename TimePoint,
+          typename Task = timer_task<TimePoint>>
+[[nodiscard]] constexpr auto schedule_at(TimePoint tp)
+    -> timer_mgr::deadline_sender<Domain, TimePoint, Task> {
+    static_assert(timer_mgr::detail::valid_time_point<TimePoint, Domain>(),
+                  "schedule_at has invalid time point type for the injected "
+                  "timer manager");
+    return {{tp}};
+}
+
+// Calls f every period of the scheduler's duration, measured from the first
+// expiry rather than from each call. If f returns bool, returning true
+// completes the sender; otherwise it runs until it is stopped. The scheduler's
+// cancellation policy applies to the periodic sender too.
+template <typename Domain, typename Duration, typename Task,
+          typename Cancellation, stdx::callable F>
+[[nodiscard]] constexpr auto
+periodic(time_scheduler<Domain, Duration, Task, Cancellation> s, F &&f) {
+    static_assert(timer_mgr::detail::valid_duration<Duration, Domain>(),
+                  "periodic has invalid duration type for the injected timer "
+                  "manager");
+    return timer_mgr::periodic_sender<Domain, Duration, std::remove_cvref_t<F>,
+                                      Task, Cancellation>{s.d,
+                                                          std::forward<F>(f)};
+}
+
+template <typename Domain = timer_mgr::default_domain,
+          typename Cancellation = timer_mgr::cancellation::immediate>
 constexpr auto time_scheduler_factory =
-    []<typename D>(D d) -> time_scheduler<Domain, D> { return {d}; };
+    []<typename D>(D d)
+    -> time_scheduler<Domain, D, timer_task<timer_mgr::time_point_for_t<D>>,
+                      Cancellation> { return {d}; };
 } // namespace async
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <async/schedulers/task_manager_instrumentation.hpp>
 #include <async/schedulers/timer_manager_interface.hpp>
 #include <conc/concurrency.hpp>
 
@@ -10,13 +11,23 @@
 #include <algorithm>
 #include <atomic>
 #include <concepts>
+#include <cstddef>
 #include <iterator>
 #include <memory>
+#include <optional>
 #include <type_traits>
 #include <utility>
 
 namespace async {
 namespace detail {
+template <typename T> struct timer_queue {
+    using type = stdx::intrusive_list<T>;
+};
+template <index_double_linkable T> struct timer_queue<T> {
+    using type = index_list<T>;
+};
+template <typename T> using timer_queue_t = typename timer_queue<T>::type;
+
 template <typename T>
 concept timer_hal =
     timeable_task<typename T::task_t> and
@@ -27,6 +38,18 @@ concept timer_hal =
         { T::set_event_time(tp) } -> std::same_as<void>;
         { task.expiration_time } -> std::same_as<typename T::time_point_t &>;
     };
+
+// How long until the next task expires, or nullopt if none is queued. A task
+// that is already due gives a zero duration.
+template <typename H, typename Duration>
+auto time_until(std::optional<typename H::time_point_t> next)
+    -> std::optional<Duration> {
+    if (not next) {
+        return std::nullopt;
+    }
+    auto const now = H::now();
+    return *next < now ? Duration{} : *next - now;
+}
 } // namespace detail
 
 namespace archetypes {
@@ -42,7 +65,9 @@ struct timer_hal {
 } // namespace archetypes
 static_assert(detail::timer_hal<archetypes::timer_hal>);
 
-template <detail::timer_hal H> struct generic_timer_manager {
+template <detail::timer_hal H,
+          typename Instrumentation = instrumentation::none>
+struct generic_timer_manager {
     using time_point_t = typename H::time_point_t;
     using duration_t =
         decltype(std::declval<time_point_t>() - std::declval<time_point_t>());
@@ -50,8 +75,24 @@ template <detail::timer_hal H> struct generic_timer_manager {
 
   private:
     struct mutex;
-    stdx::intrusive_list<task_t> task_queue{};
+    detail::timer_queue_t<task_t> task_queue{};
     std::atomic<int> task_count{};
+    [[no_unique_address]] Instrumentation instr{};
+
+    // A task with slack joins the first group of tasks that expires no
+    // earlier than it does and no later than its slack allows, so that the
+    // group needs only one timer event.
+    auto coalesce(task_t &t, duration_t slack) -> void {
+        auto pos = std::find_if(std::begin(task_queue), std::end(task_queue),
+                                [&](auto const &task) {
+                                    return task.expiration_time >=
+                                           t.expiration_time;
+                                });
+        if (pos != std::end(task_queue) and
+            pos->expiration_time <= t.expiration_time + slack) {
+            t.expiration_time = pos->expiration_time;
+        }
+    }
 
     auto schedule(task_t *t) -> void {
         if (std::empty(task_queue)) {
@@ -71,6 +112,18 @@ template <detail::timer_hal H> struct generic_timer_manager {
         }
     }
 
+    // A task in a batch that service_expired took stays pending (and
+    // expired) until it is about to run, so that it can be neither armed nor
+    // cancelled while the batch holds it.
+    static auto arm(task_t &t) -> bool {
+        if (std::atomic_ref{t.pending}.exchange(true,
+                                                std::memory_order_seq_cst)) {
+            return false;
+        }
+        std::atomic_ref{t.expired}.store(false, std::memory_order_seq_cst);
+        return true;
+    }
+
     auto compute_next_event() -> void {
         if (std::empty(task_queue)) {
             H::disable();
@@ -85,10 +138,59 @@ template <detail::timer_hal H> struct generic_timer_manager {
     template <std::derived_from<task_t> T, std::convertible_to<duration_t> D>
     auto run_after(T &t, D d) -> bool {
         return conc::call_in_critical_section<mutex>([&]() -> bool {
-            if (auto const added = not std::exchange(t.pending, true); added) {
+            if (auto const added = arm(t); added) {
                 ++task_count;
                 t.expiration_time = H::now() + static_cast<duration_t>(d);
                 schedule(std::addressof(t));
+                instr.on_arm(t);
+                return true;
+            }
+            return false;
+        });
+    }
+
+    template <std::derived_from<task_t> T, std::convertible_to<duration_t> D,
+              std::convertible_to<duration_t> S>
+    auto run_after(T &t, D d, S slack) -> bool {
+        return conc::call_in_critical_section<mutex>([&]() -> bool {
+            if (auto const added = arm(t); added) {
+                ++task_count;
+                t.expiration_time = H::now() + static_cast<duration_t>(d);
+                coalesce(t, static_cast<duration_t>(slack));
+                schedule(std::addressof(t));
+                instr.on_arm(t);
+                return true;
+            }
+            return false;
+        });
+    }
+
+    template <std::derived_from<task_t> T,
+              std::convertible_to<time_point_t> TP>
+    auto run_at(T &t, TP tp) -> bool {
+        return conc::call_in_critical_section<mutex>([&]() -> bool {
+            if (auto const added = arm(t); added) {
+                ++task_count;
+                t.expiration_time = static_cast<time_point_t>(tp);
+                schedule(std::addressof(t));
+                instr.on_arm(t);
+                return true;
+            }
+            return false;
+        });
+    }
+
+    // Like run_after, but the duration is measured from the task's previous
+    // expiration time rather than from now, so a task that is requeued every
+    // period does not accumulate drift.
+    template <std::derived_from<task_t> T, std::convertible_to<duration_t> D>
+    auto run_after_expiry(T &t, D d) -> bool {
+        return conc::call_in_critical_section<mutex>([&]() -> bool {
+            if (auto const added = arm(t); added) {
+                ++task_count;
+                t.expiration_time += static_cast<duration_t>(d);
+                schedule(std::addressof(t));
+                instr.on_arm(t);
                 return true;
             }
             return false;
@@ -104,34 +206,115 @@ template <detail::timer_hal H> struct generic_timer_manager {
 
     auto cancel(task_t &t) -> bool {
         return conc::call_in_critical_section<mutex>([&]() -> bool {
-            if (t.pending) {
+            // a task that service_expired took runs: it is too late
+            if (std::atomic_ref{t.pending}.load(std::memory_order_seq_cst) and
+                not std::atomic_ref{t.expired}.load(
+                    std::memory_order_seq_cst)) {
                 task_queue.remove(std::addressof(t));
-                t.pending = false;
+                std::atomic_ref{t.pending}.store(false,
+                                                 std::memory_order_seq_cst);
                 --task_count;
                 compute_next_event();
+                instr.on_cancel(t);
                 return true;
             }
             return false;
         });
     }
 
+    // Runs the next task. If it is due, any tasks that expire at the same time
+    // (for instance, because they were coalesced) run in the same call, and
+    // the timer is only reprogrammed once the last of them is taken. A task
+    // that requeues itself for the same time may wait for the next call.
     auto service_task() -> void {
-        if (auto t = conc::call_in_critical_section<mutex>([&]() -> task_t * {
-                if (std::empty(task_queue)) {
+        auto const now = H::now();
+        auto budget = task_count.load();
+        auto const due = [&](task_t const &t, time_point_t expiry) {
+            return t.expiration_time <= expiry and t.expiration_time <= now;
+        };
+
+        auto const take = [&](auto const &in_pass) -> task_t * {
+            return conc::call_in_critical_section<mutex>([&]() -> task_t * {
+                if (std::empty(task_queue) or
+                    not in_pass(task_queue.front())) {
                     return nullptr;
                 }
                 auto n = task_queue.pop_front();
                 n->pending = false;
-                compute_next_event();
+                if (--budget <= 0 or std::empty(task_queue) or
+                    not due(task_queue.front(), n->expiration_time)) {
+                    compute_next_event();
+                }
                 return n;
             });
-            t != nullptr) {
+        };
+
+        auto t = take([](task_t const &) { return true; });
+        while (t != nullptr) {
+            auto const expiry = t->expiration_time;
+            instr.on_expiry(*t);
             t->run();
             --task_count;
+            t = budget <= 0 ? nullptr : take([&](task_t const &next) {
+                return due(next, expiry);
+            });
         }
     }
 
+    // Runs every task that is due at now. The due tasks are taken and the
+    // timer is reprogrammed in one critical section; the tasks then run
+    // outside it. A task that is taken runs: until it does, cancel returns
+    // false for it and run_after does not rearm it, as for a task that
+    // service_task has taken. Tasks queued while the batch runs wait for the
+    // next call. Returns the number of tasks run.
+    auto service_expired(time_point_t now) -> std::size_t {
+        detail::timer_queue_t<task_t> batch{};
+        conc::call_in_critical_section<mutex>([&] {
+            while (not std::empty(task_queue) and
+                   task_queue.front().expiration_time <= now) {
+                auto n = task_queue.pop_front();
+                std::atomic_ref{n->expired}.store(true,
+                                                  std::memory_order_seq_cst);
+                batch.push_back(n);
+            }
+            compute_next_event();
+        });
+
+        auto count = std::size_t{};
+        while (not std::empty(batch)) {
+            auto t = batch.pop_front();
+            // pending first: while it is set, cancel looks at expired
+            std::atomic_ref{t->pending}.store(false, std::memory_order_seq_cst);
+            std::atomic_ref{t->expired}.store(false, std::memory_order_seq_cst);
+            instr.on_expiry(*t);
+            t->run();
+            --task_count;
+            ++count;
+        }
+        return count;
+    }
+
+    auto service_expired() -> std::size_t { return service_expired(H::now()); }
+
+    [[nodiscard]] auto next_expiration() const -> std::optional<time_point_t> {
+        return conc::call_in_critical_section<mutex>(
+            [&]() -> std::optional<time_point_t> {
+                if (std::empty(task_queue)) {
+                    return std::nullopt;
+                }
+                return task_queue.front().expiration_time;
+            });
+    }
+
+    [[nodiscard]] auto time_until_next() const -> std::optional<duration_t> {
+        return detail::time_until<H, duration_t>(next_expiration());
+    }
+
     [[nodiscard]] auto is_idle() const -> bool { return task_count == 0; }
+
+    [[nodiscard]] auto get_instrumentation() const -> Instrumentation const & {
+        return instr;
+    }
 };
 static_assert(timer_manager<generic_timer_manager<archetypes::timer_hal>>);
 } // namespace async
@@ -1,17 +1,22 @@
 #pragma once
 
+#include <async/forwarding_query.hpp>
+#include <async/schedulers/index_linked_task.hpp>
 #include <async/schedulers/task.hpp>
 
 #include <stdx/intrusive_list.hpp>
 #include <stdx/type_traits.hpp>
 
 #include <concepts>
+#include <cstddef>
 #include <functional>
+#include <utility>
 
 namespace async {
 template <typename T>
 concept timeable_task =
-    stdx::double_linkable<T> and std::strict_weak_order<std::less<>, T, T> and
+    (stdx::double_linkable<T> or index_double_linkable<T>) and
+    std::strict_weak_order<std::less<>, T, T> and
     requires(T *t) {
         { t->run() } -> std::same_as<void>;
         { t->pending } -> std::same_as<bool &>;
@@ -30,7 +35,12 @@ concept timer_manager =
 
 namespace detail {
 template <typename T> struct default_timer_task : task_base {
+    using task_base::task_base;
+
     T expiration_time{};
+    // set while the task waits to run in a batch that service_expired took,
+    // so that cancel knows it is no longer on the queue
+    bool expired{};
 
   private:
     [[nodiscard]] friend constexpr auto
@@ -43,6 +53,9 @@ template <typename T> struct default_timer_task : task_base {
 template <typename T>
 using timer_task = double_linked_task<detail::default_timer_task<T>>;
 
+template <typename T>
+using heap_timer_task = heap_linked_task<detail::default_timer_task<T>>;
+
 namespace detail {
 struct undefined_timer_manager {
     using time_point_t = int;
@@ -72,6 +85,45 @@ struct undefined_timer_manager {
 static_assert(timer_manager<undefined_timer_manager>);
 } // namespace detail
 
+struct no_timer_slack {};
+
+// A receiver's environment may answer get_timer_slack with a duration by
+// which its timer may fire late. A timer manager that supports slack may use
+// it to fire several timers on one interrupt.
+constexpr inline struct get_timer_slack_t : forwarding_query_t {
+    template <typename T>
+        requires true // more constrained
+    constexpr auto operator()(T &&t) const
+        -> decltype(tag_invoke(std::declval<get_timer_slack_t>(),
+                               std::forward<T>(t))) {
+        return tag_invoke(*this, std::forward<T>(t));
+    }
+
+    constexpr auto operator()(auto &&) const -> no_timer_slack { return {}; }
+} get_timer_slack;
+
+template <typename T>
+using timer_slack_of_t = decltype(get_timer_slack(std::declval<T>()));
+
+struct no_deadline {};
+
+// A receiver's environment may answer get_deadline with the time point after
+// which its result is no longer wanted. See with_deadline.
+constexpr inline struct get_deadline_t : forwarding_query_t {
+    template <typename T>
+        requires true // more constrained
+    constexpr auto operator()(T &&t) const
+        -> decltype(tag_invoke(std::declval<get_deadline_t>(),
+                               std::forward<T>(t))) {
+        return tag_invoke(*this, std::forward<T>(t));
+    }
+
+    constexpr auto operator()(auto &&) const -> no_deadline { return {}; }
+} get_deadline;
+
+template <typename T>
+using deadline_of_t = decltype(get_deadline(std::declval<T>()));
+
 template <typename...>
 inline auto injected_timer_manager = detail::undefined_timer_manager{};
 
@@ -97,6 +149,22 @@ auto run_after(Args &&...args) -> bool {
         std::forward<Args>(args)...);
 }
 
+template <typename Domain = default_domain, typename... DummyArgs,
+          typename... Args>
+    requires(sizeof...(DummyArgs) == 0)
+auto run_at(Args &&...args) -> bool {
+    return get_injected_manager<Domain, DummyArgs...>().run_at(
+        std::forward<Args>(args)...);
+}
+
+template <typename Domain = default_domain, typename... DummyArgs,
+          typename... Args>
+    requires(sizeof...(DummyArgs) == 0)
+auto run_after_expiry(Args &&...args) -> bool {
+    return get_injected_manager<Domain, DummyArgs...>().run_after_expiry(
+        std::forward<Args>(args)...);
+}
+
 template <typename Domain = default_domain, typename... DummyArgs,
           typename... Args>
     requires(sizeof...(DummyArgs) == 0)
@@ -113,6 +181,15 @@ constexpr auto valid_duration() -> bool {
                decltype(get_injected_manager<Domain, DummyArgs...>())>::
                duration_t>;
 }
+
+template <typename TP, typename Domain = default_domain, typename... DummyArgs>
+    requires(sizeof...(DummyArgs) == 0)
+constexpr auto valid_time_point() -> bool {
+    return std::convertible_to<
+        TP, typename std::remove_cvref_t<
+                decltype(get_injected_manager<Domain, DummyArgs...>())>::
+                time_point_t>;
+}
 } // namespace detail
 
 template <typename Domain = default_domain, typename... DummyArgs>
@@ -121,12 +198,34 @@ auto service_task() -> void {
     return detail::get_injected_manager<Domain, DummyArgs...>().service_task();
 }
 
+template <typename Domain = default_domain, typename... DummyArgs,
+          typename... Args>
+    requires(sizeof...(DummyArgs) == 0)
+auto service_expired(Args &&...args) -> std::size_t {
+    return detail::get_injected_manager<Domain, DummyArgs...>().service_expired(
+        std::forward<Args>(args)...);
+}
+
 template <typename Domain = default_domain, typename... DummyArgs>
     requires(sizeof...(DummyArgs) == 0)
 auto is_idle() -> bool {
     return detail::get_injected_manager<Domain, DummyArgs...>().is_idle();
 }
 
+template <typename Domain = default_domain, typename... DummyArgs>
+    requires(sizeof...(DummyArgs) == 0)
+auto next_expiration() {
+    return detail::get_injected_manager<Domain, DummyArgs...>()
+        .next_expiration();
+}
+
+template <typename Domain = default_domain, typename... DummyArgs>
+    requires(sizeof...(DummyArgs) == 0)
+auto time_until_next() {
+    return detail::get_injected_manager<Domain, DummyArgs...>()
+        .time_until_next();
+}
+
 template <typename D> struct time_point_for {
     using type = D;
 };
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <async/schedulers/timer_manager.hpp>
+#include <async/schedulers/timer_manager_interface.hpp>
+#include <conc/concurrency.hpp>
+
+#include <boost/mp11/algorithm.hpp>
+#include <boost/mp11/list.hpp>
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace async {
+// Shares one hardware compare channel between several timer domains. Each
+// domain's timer manager is given a virtual channel HAL: the multiplexer
+// records each channel's requested event and programs the hardware with the
+// earliest one. The timer ISR calls service_task(), which services every
+// domain whose event is due.
+//
+// With a single domain there is nothing to share: hal<Domain> is the
+// hardware HAL itself and service_task() forwards to that domain.
+template <detail::timer_hal H, typename... Domains> struct timer_multiplexer {
+    static_assert(sizeof...(Domains) > 0,
+                  "timer_multiplexer needs at least one domain");
+
+    using time_point_t = typename H::time_point_t;
+    using task_t = typename H::task_t;
+
+  private:
+    constexpr static auto num_channels = sizeof...(Domains);
+
+    struct mutex;
+    struct channel_state {
+        time_point_t event_time{};
+        bool armed{};
+    };
+    static inline std::array<channel_state, num_channels> channels{};
+    static inline bool hardware_enabled{};
+
+    // called inside the multiplexer's critical section
+    static auto reprogram() -> void {
+        channel_state const *earliest{};
+        for (auto const &c : channels) {
+            if (c.armed and
+                (earliest == nullptr or c.event_time < earliest->event_time)) {
+                earliest = &c;
+            }
+        }
+        if (earliest == nullptr) {
+            if (std::exchange(hardware_enabled, false)) {
+                H::disable();
+            }
+            return;
+        }
+        H::set_event_time(earliest->event_time);
+        if (not std::exchange(hardware_enabled, true)) {
+            H::enable();
+        }
+    }
+
+    template <std::size_t I> struct channel {
+        using time_point_t = typename H::time_point_t;
+        using task_t = typename H::task_t;
+
+        static auto now() -> time_point_t { return H::now(); }
+
+        static auto enable() -> void {
+            conc::call_in_critical_section<mutex>([] {
+                channels[I].armed = true;
+                reprogram();
+            });
+        }
+
+        static auto disable() -> void {
+            conc::call_in_critical_section<mutex>([] {
+                channels[I].armed = false;
+                reprogram();
+            });
+        }
+
+        static auto set_event_time(time_point_t tp) -> void {
+            conc::call_in_critical_section<mutex>([&] {
+                channels[I].event_time = tp;
+                if (channels[I].armed) {
+                    reprogram();
+                }
+            });
+        }
+    };
+
+    template <typename Domain>
+    constexpr static auto index_of =
+        boost::mp11::mp_find<boost::mp11::mp_list<Domains...>, Domain>::value;
+
+    template <std::size_t I>
+    using domain_t = boost::mp11::mp_at_c<boost::mp11::mp_list<Domains...>, I>;
+
+    template <std::size_t I, typename... DummyArgs>
+    static auto service_if_due(time_point_t now) -> void {
+        if (conc::call_in_critical_section<mutex>([&] {
+                return channels[I].armed and channels[I].event_time <= now;
+            })) {
+            timer_mgr::service_task<domain_t<I>, DummyArgs...>();
+        }
+    }
+
+  public:
+    template <typename Domain>
+        requires(index_of<Domain> < num_channels)
+    using hal = std::conditional_t<num_channels == 1, H,
+                                   channel<index_of<Domain>>>;
+
+    template <typename... DummyArgs>
+        requires(sizeof...(DummyArgs) == 0)
+    static auto service_task() -> void {
+        if constexpr (num_channels == 1) {
+            timer_mgr::service_task<Domains..., DummyArgs...>();
+        } else {
+            auto const now = H::now();
+            [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                (service_if_due<Is, DummyArgs...>(now), ...);
+            }(std::index_sequence_for<Domains...>{});
+        }
+    }
+};
+} // namespace async
@@ -0,0 +1,327 @@
+#pragma once
+
+#include <async/schedulers/timer_manager.hpp>
+#include <async/schedulers/timer_manager_interface.hpp>
+#include <conc/concurrency.hpp>
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace async {
+namespace detail {
+template <typename TP> constexpr auto ticks_of(TP tp) -> std::uint64_t {
+    if constexpr (requires { tp.time_since_epoch().count(); }) {
+        return static_cast<std::uint64_t>(tp.time_since_epoch().count());
+    } else {
+        return static_cast<std::uint64_t>(tp);
+    }
+}
+
+template <typename TP> constexpr auto from_ticks(std::uint64_t t) -> TP {
+    if constexpr (requires { typename TP::duration; }) {
+        return TP{typename TP::duration{t}};
+    } else {
+        return static_cast<TP>(t);
+    }
+}
+
+// A FIFO list threaded through a task's next and prev pointers. Unlike
+// stdx::intrusive_list, removal only touches the neighbours of the task.
+template <typename T> struct task_fifo {
+    T *head{};
+    T *tail{};
+
+    [[nodiscard]] constexpr auto empty() const -> bool {
+        return head == nullptr;
+    }
+
+    constexpr auto push_back(T *t) -> void {
+        t->prev = tail;
+        t->next = nullptr;
+        if (tail == nullptr) {
+            head = t;
+        } else {
+            tail->next = t;
+        }
+        tail = t;
+    }
+
+    constexpr auto pop_front() -> T * {
+        auto const t = head;
+        if (t != nullptr) {
+            remove(t);
+        }
+        return t;
+    }
+
+    constexpr auto remove(T *t) -> void {
+        auto const next = static_cast<T *>(t->next);
+        auto const prev = static_cast<T *>(t->prev);
+        (prev == nullptr ? head : prev->next) = next;
+        (next == nullptr ? tail : next->prev) = prev;
+        t->next = t->prev = nullptr;
+    }
+};
+} // namespace detail
+
+// A timer manager that keeps tasks in a hierarchical timing wheel rather than
+// a sorted list, so run_after and cancel do not depend on the number of
+// outstanding tasks. One tick is one unit of the HAL's duration.
+//
+// A task at level L sits in the slot picked by the L-th base-SlotsPerLevel
+// digit of its expiry, where L is the highest digit in which the expiry
+// differs from the current tick. As time advances, slots are cascaded down a
+// level whenever the current tick crosses a slot boundary. Tasks that are
+// further out than the whole wheel wait in an overflow list.
+template <detail::timer_hal H, std::size_t Levels = 4,
+          std::size_t SlotsPerLevel = 64>
+struct timing_wheel_timer_manager {
+    using time_point_t = typename H::time_point_t;
+    using duration_t =
+        decltype(std::declval<time_point_t>() - std::declval<time_point_t>());
+    using task_t = typename H::task_t;
+
+  private:
+    static_assert(Levels > 0 and SlotsPerLevel > 1);
+
+    constexpr static auto span(std::size_t level) -> std::uint64_t {
+        std::uint64_t s{1};
+        for (auto i = std::size_t{}; i < level; ++i) {
+            s *= SlotsPerLevel;
+        }
+        return s;
+    }
+    static_assert(span(Levels) / span(Levels - 1) == SlotsPerLevel,
+                  "timing wheel is too large for 64-bit ticks");
+
+    struct mutex;
+    using list_t = detail::task_fifo<task_t>;
+
+    std::array<list_t, Levels * SlotsPerLevel> slots{};
+    // one bit per level 0 slot, set while the slot holds tasks
+    std::array<std::uint64_t, (SlotsPerLevel + 63) / 64> occupied{};
+    list_t overflow{};
+    list_t expired{};
+    std::uint64_t current{};
+    std::size_t wheel_count{};
+    std::atomic<int> task_count{};
+
+    [[nodiscard]] auto list_for(std::uint64_t expiry) -> list_t & {
+        if (expiry <= current) {
+            return expired;
+        }
+        for (auto level = std::size_t{}; level < Levels; ++level) {
+            if (expiry / span(level + 1) == current / span(level + 1)) {
+                auto const slot = (expiry / span(level)) % SlotsPerLevel;
+                return slots[level * SlotsPerLevel + slot];
+            }
+        }
+        return overflow;
+    }
+
+    [[nodiscard]] auto on_level_0(std::uint64_t expiry) const -> bool {
+        return expiry > current and
+               expiry / SlotsPerLevel == current / SlotsPerLevel;
+    }
+
+    auto set_occupied(std::size_t slot, bool value) -> void {
+        auto const bit = std::uint64_t{1} << (slot % 64);
+        auto &word = occupied[slot / 64];
+        word = value ? word | bit : word & ~bit;
+    }
+
+    auto place(task_t *t) -> void {
+        auto const expiry = detail::ticks_of(t->expiration_time);
+        auto &l = list_for(expiry);
+        if (&l != &expired) {
+            ++wheel_count;
+        }
+        l.push_back(t);
+        if (on_level_0(expiry)) {
+            set_occupied(expiry % SlotsPerLevel, true);
+        }
+    }
+
+    auto cascade(list_t &l) -> void {
+        auto tasks = std::exchange(l, {});
+        while (auto t = tasks.pop_front()) {
+            --wheel_count;
+            place(t);
+        }
+    }
+
+    auto process_tick() -> void {
+        if (current % span(Levels) == 0) {
+            cascade(overflow);
+        }
+        for (auto level = Levels - 1; level > 0; --level) {
+            if (current % span(level) == 0) {
+                auto const slot = (current / span(level)) % SlotsPerLevel;
+                cascade(slots[level * SlotsPerLevel + slot]);
+            }
+        }
+        cascade(slots[current % SlotsPerLevel]);
+        set_occupied(current % SlotsPerLevel, false);
+    }
+
+    // The next tick at which a level 0 slot is due or a cascade happens. This
+    // scans the occupancy bitmap a word at a time, so it reads one word for
+    // up to 64 slots per level.
+    [[nodiscard]] auto next_tick() const -> std::uint64_t {
+        auto const base = current / SlotsPerLevel * SlotsPerLevel;
+        auto slot = current % SlotsPerLevel + 1;
+        while (slot < SlotsPerLevel) {
+            if (auto const word = occupied[slot / 64] >> (slot % 64);
+                word != 0) {
+                return base + slot +
+                       static_cast<std::uint64_t>(std::countr_zero(word));
+            }
+            slot = (slot / 64 + 1) * 64;
+        }
+        return base + SlotsPerLevel;
+    }
+
+    auto advance(std::uint64_t target) -> void {
+        while (current < target) {
+            if (wheel_count == 0) {
+                current = target;
+                return;
+            }
+            auto const next = next_tick();
+            if (next > target) {
+                current = target;
+                return;
+            }
+            current = next;
+            process_tick();
+        }
+    }
+
+    auto compute_next_event() -> void {
+        if (not expired.empty()) {
+            H::set_event_time(H::now());
+        } else if (wheel_count != 0) {
+            H::set_event_time(detail::from_ticks<time_point_t>(next_tick()));
+        } else {
+            H::disable();
+        }
+    }
+
+    auto insert(task_t *t, time_point_t now, time_point_t expiry) -> void {
+        if (wheel_count == 0 and expired.empty()) {
+            current = detail::ticks_of(now);
+            H::enable();
+        } else {
+            advance(detail::ticks_of(now));
+        }
+        t->expiration_time = expiry;
+        place(t);
+        compute_next_event();
+    }
+
+  public:
+    constexpr static auto create_task = async::create_task<task_t>;
+
+    template <std::derived_from<task_t> T, std::convertible_to<duration_t> D>
+    auto run_after(T &t, D d) -> bool {
+        return conc::call_in_critical_section<mutex>([&]() -> bool {
+            if (auto const added = not std::exchange(t.pending, true); added) {
+                ++task_count;
+                auto const now = H::now();
+                insert(std::addressof(t), now,
+                       now + static_cast<duration_t>(d));
+                return true;
+            }
+            return false;
+        });
+    }
+
+    template <std::derived_from<task_t> T,
+              std::convertible_to<time_point_t> TP>
+    auto run_at(T &t, TP tp) -> bool {
+        return conc::call_in_critical_section<mutex>([&]() -> bool {
+            if (auto const added = not std::exchange(t.pending, true); added) {
+                ++task_count;
+                insert(std::addressof(t), H::now(),
+                       static_cast<time_point_t>(tp));
+                return true;
+            }
+            return false;
+        });
+    }
+
+    template <typename T, typename D> auto run_after(T const &, D) -> bool {
+        static_assert(stdx::always_false_v<D>,
+                      "Invalid duration type: did you forget to specialize "
+                      "async::timer_mgr::time_point_for?");
+        return false;
+    }
+
+    auto cancel(task_t &t) -> bool {
+        return conc::call_in_critical_section<mutex>([&]() -> bool {
+            if (t.pending) {
+                auto const expiry = detail::ticks_of(t.expiration_time);
+                auto &l = list_for(expiry);
+                if (&l != &expired) {
+                    --wheel_count;
+                }
+                l.remove(std::addressof(t));
+                if (on_level_0(expiry) and l.empty()) {
+                    set_occupied(expiry % SlotsPerLevel, false);
+                }
+                t.pending = false;
+                --task_count;
+                compute_next_event();
+                return true;
+            }
+            return false;
+        });
+    }
+
+    auto service_task() -> void {
+        if (auto t = conc::call_in_critical_section<mutex>([&]() -> task_t * {
+                advance(detail::ticks_of(H::now()));
+                auto const n = expired.pop_front();
+                if (n != nullptr) {
+                    n->pending = false;
+                }
+                compute_next_event();
+                return n;
+            });
+            t != nullptr) {
+            t->run();
+            --task_count;
+        }
+    }
+
+    // The wheel does not track exact expiry times between ticks, so this is
+    // the next tick at which the wheel needs servicing: never later than the
+    // next expiry, but possibly earlier.
+    [[nodiscard]] auto next_expiration() const -> std::optional<time_point_t> {
+        return conc::call_in_critical_section<mutex>(
+            [&]() -> std::optional<time_point_t> {
+                if (not expired.empty()) {
+                    return detail::from_ticks<time_point_t>(current);
+                }
+                if (wheel_count == 0) {
+                    return std::nullopt;
+                }
+                return detail::from_ticks<time_point_t>(next_tick());
+            });
+    }
+
+    [[nodiscard]] auto time_until_next() const -> std::optional<duration_t> {
+        return detail::time_until<H, duration_t>(next_expiration());
+    }
+
+    [[nodiscard]] auto is_idle() const -> bool { return task_count == 0; }
+};
+static_assert(
+    timer_manager<timing_wheel_timer_manager<archetypes::timer_hal>>);
+} // namespace async
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <async/completion_scheduler.hpp>
+#include <async/concepts.hpp>
+#include <async/dispatch_node.hpp>
+#include <async/env.hpp>
+#include <async/tags.hpp>
+#include <async/type_traits.hpp>
+
+#include <stdx/concepts.hpp>
+#include <stdx/intrusive_forward_list.hpp>
+
+#include <cstddef>
+#include <utility>
+
+namespace async {
+namespace _trampoline_scheduler {
+struct pending_node : dispatch_node {
+    using dispatch_node::dispatch_node;
+    pending_node *next{};
+};
+
+// How deep the inline completions on this thread are nested, and the
+// operations that were started too deep to complete inline. The outermost
+// start runs the pending operations once its own completion returns, so the
+// stack never holds more than the maximum depth of inline completions.
+struct state {
+    std::size_t depth{};
+    stdx::intrusive_forward_list<pending_node> pending{};
+
+    template <typename F> auto run(std::size_t max_depth, F &&f) -> bool {
+        if (depth >= max_depth) {
+            return false;
+        }
+        ++depth;
+        std::forward<F>(f)();
+        if (--depth == 0) {
+            drain();
+        }
+        return true;
+    }
+
+    auto drain() -> void {
+        ++depth;
+        while (not pending.empty()) {
+            pending.pop_front()->dispatch();
+        }
+        --depth;
+    }
+};
+
+inline thread_local state current{};
+} // namespace _trampoline_scheduler
+
+// Like inline_scheduler, operations complete inside start, until they are
+// nested MaxDepth deep on one thread. An operation started deeper than that
+// is queued and completes when the outermost inline completion returns. A
+// chain that reschedules itself (with repeat, or recursively through
+// let_value) keeps inline speed while it is shallow, and a bounded stack
+// however deep it goes.
+template <std::size_t MaxDepth = 16> class trampoline_scheduler {
+    static_assert(MaxDepth > 0, "A trampoline_scheduler must allow some depth");
+
+    template <typename R>
+    // NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+    struct op_state : _trampoline_scheduler::pending_node {
+        template <stdx::same_as_unqualified<R> Rcvr>
+        constexpr explicit(true) op_state(Rcvr &&r)
+            : pending_node{dispatch_to<op_state, &op_state::complete>},
+              receiver{std::forward<Rcvr>(r)} {}
+        constexpr op_state(op_state &&) = delete;
+
+        auto complete() -> void { set_value(std::move(receiver)); }
+
+        [[no_unique_address]] R receiver;
+
+      private:
+        template <stdx::same_as_unqualified<op_state> O>
+        friend auto tag_invoke(start_t, O &&o) -> void {
+            auto &st = _trampoline_scheduler::current;
+            if (not st.run(MaxDepth, [&] { o.complete(); })) {
+                st.pending.push_back(std::addressof(o));
+            }
+        }
+    };
+
+    class env {
+        [[nodiscard]] friend constexpr auto
+        tag_invoke(get_completion_scheduler_t<set_value_t>, env) noexcept
+            -> trampoline_scheduler {
+            return {};
+        }
+    };
+
+    struct sender {
+        using is_sender = void;
+        using completion_signatures =
+            async::completion_signatures<set_value_t()>;
+
+      private:
+        template <stdx::same_as_unqualified<sender> S, receiver R>
+        [[nodiscard]] friend constexpr auto tag_invoke(connect_t, S &&, R &&r)
+            -> op_state<std::remove_cvref_t<R>> {
+            check_connect<S, R>();
+            return op_state<std::remove_cvref_t<R>>{std::forward<R>(r)};
+        }
+
+        [[nodiscard]] friend constexpr auto tag_invoke(get_env_t,
+                                                       sender) noexcept
+            -> env {
+            return {};
+        }
+    };
+
+    [[nodiscard]] friend constexpr auto operator==(trampoline_scheduler,
+                                                   trampoline_scheduler)
+        -> bool = default;
+
+  public:
+    [[nodiscard]] constexpr static auto schedule() -> sender { return {}; }
+};
+} // namespace async
@@ -0,0 +1,217 @@
+#pragma once
+
+#include <async/schedulers/task_manager.hpp>
+#include <async/schedulers/task_manager_interface.hpp>
+#include <conc/concurrency.hpp>
+
+#include <stdx/intrusive_forward_list.hpp>
+
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace async {
+namespace detail {
+template <typename T>
+concept multicore_scheduler_hal = scheduler_hal<T> and requires {
+    { T::current_core() } -> std::convertible_to<std::size_t>;
+};
+
+// A bounded Chase-Lev deque: the owning core pushes and pops at the bottom,
+// other cores steal from the top.
+template <typename T, std::size_t Capacity> struct chase_lev_deque {
+    static_assert(Capacity > 0);
+
+    auto push(T *t) -> bool {
+        auto const b = bottom.load(std::memory_order_relaxed);
+        auto const tp = top.load(std::memory_order_acquire);
+        if (b - tp >= static_cast<std::int64_t>(Capacity)) {
+            return false;
+        }
+        slot(b).store(t, std::memory_order_relaxed);
+        bottom.store(b + 1, std::memory_order_release);
+        return true;
+    }
+
+    auto pop() -> T * {
+        auto const b = bottom.load(std::memory_order_relaxed) - 1;
+        bottom.store(b, std::memory_order_seq_cst);
+        auto tp = top.load(std::memory_order_seq_cst);
+        if (tp > b) {
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        auto t = slot(b).load(std::memory_order_relaxed);
+        if (tp == b) {
+            // last element: race against thieves for it
+            if (not top.compare_exchange_strong(tp, tp + 1,
+                                                std::memory_order_seq_cst,
+                                                std::memory_order_relaxed)) {
+                t = nullptr;
+            }
+            bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return t;
+    }
+
+    auto steal() -> T * {
+        auto tp = top.load(std::memory_order_seq_cst);
+        auto const b = bottom.load(std::memory_order_seq_cst);
+        if (tp >= b) {
+            return nullptr;
+        }
+        auto t = slot(tp).load(std::memory_order_relaxed);
+        if (not top.compare_exchange_strong(tp, tp + 1,
+                                            std::memory_order_seq_cst,
+                                            std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        return t;
+    }
+
+  private:
+    auto slot(std::int64_t i) -> std::atomic<T *> & {
+        return buffer[static_cast<std::size_t>(i) % Capacity];
+    }
+
+    std::atomic<std::int64_t> top{};
+    std::atomic<std::int64_t> bottom{};
+    std::array<std::atomic<T *>, Capacity> buffer{};
+};
+} // namespace detail
+
+namespace archetypes {
+struct multicore_scheduler_hal {
+    constexpr static auto schedule(priority_t) -> void {}
+    constexpr static auto current_core() -> std::size_t { return 0; }
+};
+} // namespace archetypes
+static_assert(
+    detail::multicore_scheduler_hal<archetypes::multicore_scheduler_hal>);
+
+// A task manager for SMP targets. Each core has a deque per priority: a task
+// is queued on the deque of the core that enqueues it, and a core servicing a
+// priority takes work from its own deque first (most recent first), then
+// steals from other cores (oldest first). If a deque is full, tasks go to a
+// shared overflow queue for that priority which is protected by a critical
+// section.
+//
+// The deque operations of the owning core are not reentrant, so each core
+// marks itself while it runs one. An enqueue that interrupts one (say, from an
+// interrupt handler on the same core) goes to the overflow queue instead, and a
+// service that interrupts one takes its own core's tasks as a thief would.
+template <detail::multicore_scheduler_hal S, std::size_t NumCores,
+          std::size_t NumPriorities, std::size_t Capacity = 64,
+          prioritizable_task Task = priority_task>
+    requires stdx::single_linkable<Task>
+struct work_stealing_task_manager {
+    using task_t = Task;
+
+  private:
+    struct mutex;
+    using deque_t = detail::chase_lev_deque<task_t, Capacity>;
+
+    std::array<std::array<deque_t, NumPriorities>, NumCores> deques{};
+    std::array<stdx::intrusive_forward_list<task_t>, NumPriorities>
+        overflow{};
+    std::array<std::atomic<std::size_t>, NumPriorities> queued{};
+    std::atomic<int> task_count{};
+    // set while a core runs an operation on its own deques
+    std::array<std::atomic<bool>, NumCores> owner_busy{};
+
+    // Runs f on the core's own deques, unless that would interrupt another
+    // such operation; returns false if so.
+    template <typename F> auto as_owner(std::size_t core, F &&f) -> bool {
+        auto &busy = owner_busy[core];
+        if (busy.exchange(true, std::memory_order_acquire)) {
+            return false;
+        }
+        std::forward<F>(f)();
+        busy.store(false, std::memory_order_release);
+        return true;
+    }
+
+    template <priority_t P> auto take_task(std::size_t core) -> task_t * {
+        task_t *t{};
+        auto const owned = as_owner(core, [&] { t = deques[core][P].pop(); });
+        if (t != nullptr) {
+            return t;
+        }
+        for (auto i = std::size_t{owned ? 1u : 0u}; i < NumCores; ++i) {
+            if (t = deques[(core + i) % NumCores][P].steal(); t != nullptr) {
+                return t;
+            }
+        }
+        return conc::call_in_critical_section<mutex>([&]() -> task_t * {
+            auto &q = overflow[P];
+            if (std::empty(q)) {
+                return nullptr;
+            }
+            auto &t = q.front();
+            q.pop_front();
+            return std::addressof(t);
+        });
+    }
+
+  public:
+    constexpr static auto create_task = async::create_task<task_t>;
+
+    auto enqueue_task(task_t &t, priority_t p) -> bool {
+        if (std::atomic_ref{t.pending}.exchange(true,
+                                                std::memory_order_acq_rel)) {
+            return false;
+        }
+        ++task_count;
+        ++queued[p];
+        auto const core = static_cast<std::size_t>(S::current_core());
+        auto pushed = false;
+        as_owner(core,
+                 [&] { pushed = deques[core][p].push(std::addressof(t)); });
+        if (not pushed) {
+            conc::call_in_critical_section<mutex>(
+                [&] { overflow[p].push_back(std::addressof(t)); });
+        }
+        S::schedule(p);
+        return true;
+    }
+
+    template <priority_t P> constexpr static auto valid_priority() -> bool {
+        return P < NumPriorities;
+    }
+
+    // With requeue_policy::deferred, at most as many tasks as were queued at
+    // P on entry are run, so a task that requeues itself cannot keep this
+    // call going forever.
+    template <priority_t P, typename RQP = requeue_policy::deferred>
+    auto service_tasks() -> void
+        requires(valid_priority<P>())
+    {
+        auto const core = static_cast<std::size_t>(S::current_core());
+        auto budget = queued[P].load();
+        while (not std::same_as<RQP, requeue_policy::deferred> or
+               budget-- != 0) {
+            auto const task = take_task<P>(core);
+            if (task == nullptr) {
+                return;
+            }
+            --queued[P];
+            std::atomic_ref{task->pending}.store(false,
+                                                 std::memory_order_release);
+            task->run();
+            --task_count;
+        }
+    }
+
+    [[nodiscard]] auto is_idle() const -> bool { return task_count == 0; }
+
+    [[nodiscard]] constexpr static auto concurrency() -> std::size_t {
+        return NumCores;
+    }
+};
+static_assert(task_manager<work_stealing_task_manager<
+                  archetypes::multicore_scheduler_hal, 2, 16>>);
+} // namespace async
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <compare>
+#include <concepts>
+#include <type_traits>
+
+namespace async {
+// A time point read from a free-running hardware counter of native width,
+// which wraps around. Time points are compared by their modular difference,
+// so ordering stays correct across rollover without extending the counter in
+// software, as long as the time points compared (the pending expiry times and
+// now) are less than half the counter's range apart. Durations are the
+// signed type of the same width.
+template <std::unsigned_integral Rep> struct wrapping_time_point {
+    using rep = Rep;
+    using duration = std::make_signed_t<Rep>;
+
+    Rep ticks{};
+
+    constexpr auto operator+=(duration d) -> wrapping_time_point & {
+        ticks = static_cast<Rep>(ticks + static_cast<Rep>(d));
+        return *this;
+    }
+
+    constexpr auto operator-=(duration d) -> wrapping_time_point & {
+        ticks = static_cast<Rep>(ticks - static_cast<Rep>(d));
+        return *this;
+    }
+
+  private:
+    [[nodiscard]] friend constexpr auto operator-(wrapping_time_point a,
+                                                  wrapping_time_point b)
+        -> duration {
+        return static_cast<duration>(static_cast<Rep>(a.ticks - b.ticks));
+    }
+
+    [[nodiscard]] friend constexpr auto operator+(wrapping_time_point tp,
+                                                  duration d)
+        -> wrapping_time_point {
+        return tp += d;
+    }
+
+    [[nodiscard]] friend constexpr auto operator-(wrapping_time_point tp,
+                                                  duration d)
+        -> wrapping_time_point {
+        return tp -= d;
+    }
+
+    [[nodiscard]] friend constexpr auto operator==(wrapping_time_point,
+                                                   wrapping_time_point)
+        -> bool = default;
+
+    [[nodiscard]] friend constexpr auto operator<=>(wrapping_time_point a,
+                                                    wrapping_time_point b)
+        -> std::strong_ordering {
+        return a - b <=> duration{};
+    }
+};
+} // namespace async
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <async/concepts.hpp>
+#include <async/type_traits.hpp>
+
+#include <stdx/functional.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <utility>
+
+namespace async::detail {
+// A sender in a runtime-sized range is connected by reference if it is
+// multishot, so that the range can be run again; otherwise it is moved from.
+template <typename S> constexpr auto connectable(S &s) -> decltype(auto) {
+    if constexpr (multishot_sender<S>) {
+        return (s);
+    } else {
+        return std::move(s);
+    }
+}
+
+// The op states of a runtime-sized range of senders (as in when_all_range and
+// when_any_range), stored inline up to a capacity of N. MakeRcvr makes the
+// receiver for the sender at an index.
+template <std::size_t N, typename S, typename Rcvr> struct sender_range_ops {
+    using ops_t =
+        connect_result_t<decltype(connectable(std::declval<S &>())), Rcvr>;
+
+    template <typename MakeRcvr>
+    constexpr sender_range_ops(std::span<S> sndrs, MakeRcvr &&make_rcvr) {
+        for (auto i = std::size_t{}; i < std::min(std::size(sndrs), N); ++i) {
+            ops[i].emplace(stdx::with_result_of{
+                [&] { return connect(connectable(sndrs[i]), make_rcvr(i)); }});
+        }
+    }
+
+    // The last operation to complete may destroy this storage, so nothing in
+    // it is read after that operation is started.
+    auto start_first(std::size_t n) -> void {
+        auto *const first = std::data(ops);
+        for (auto i = std::size_t{}; i < n; ++i) {
+            start(*first[i]);
+        }
+    }
+
+    std::array<std::optional<ops_t>, N> ops{};
+};
+} // namespace async::detail
@@ -5,8 +5,13 @@
 #include <async/tags.hpp>
 
 #include <stdx/functional.hpp>
+#include <stdx/tuple.hpp>
+
+#include <boost/mp11/algorithm.hpp>
+#include <boost/mp11/list.hpp>
 
 #include <concepts>
+#include <cstddef>
 #include <type_traits>
 #include <utility>
 #include <variant>
@@ -58,6 +63,8 @@ struct op_state {
     [[no_unique_address]] Func func;
     [[no_unique_address]] Rcvr rcvr;
 
+    // the second op state is emplaced over the first one, so the op state is
+    // only as big as the larger of the two
     using dependent_sender = std::invoke_result_t<Func>;
     using first_ops = connect_result_t<Sndr, first_rcvr>;
     using second_ops = connect_result_t<dependent_sender, Rcvr>;
@@ -155,6 +162,144 @@ template <std::invocable F> struct pipeable {
                                                  std::forward<Self>(self).f};
     }
 };
+
+// An n-ary sequence runs its senders in order. Every step's op state lives in
+// the same variant, so the op state is as big as the largest step, rather than
+// growing with each level of a nested chain of binary sequences.
+template <typename Ops, typename Rcvr, std::size_t I> struct step_receiver {
+    using is_receiver = void;
+
+    Ops *ops;
+
+  private:
+    template <typename... Args>
+    friend auto tag_invoke(set_value_t, step_receiver const &self,
+                           Args &&...args) -> void {
+        self.ops->template complete<I>(std::forward<Args>(args)...);
+    }
+
+    template <channel_tag Tag, typename... Args>
+    friend auto tag_invoke(Tag, step_receiver const &self, Args &&...args)
+        -> void {
+        Tag{}(self.ops->rcvr, std::forward<Args>(args)...);
+    }
+
+    [[nodiscard]] friend constexpr auto tag_invoke(async::get_env_t,
+                                                   step_receiver const &r)
+        -> ::async::detail::forwarding_env<env_of_t<Rcvr>> {
+        return forward_env_of(r.ops->rcvr);
+    }
+};
+
+template <typename Rcvr, typename First, typename... Rest>
+// NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+struct steps_op_state {
+    constexpr static auto last_step = sizeof...(Rest);
+
+    template <std::size_t I>
+    using step_rcvr = step_receiver<steps_op_state, Rcvr, I>;
+
+    template <stdx::same_as_unqualified<First> F, typename R, typename... Ss>
+    constexpr steps_op_state(F &&f, R &&r, Ss &&...ss)
+        : rcvr{std::forward<R>(r)}, rest{std::forward<Ss>(ss)...},
+          state{std::in_place_index<0>, stdx::with_result_of{[&] {
+                    return connect(std::forward<F>(f), step_rcvr<0>{this});
+                }}} {}
+    constexpr steps_op_state(steps_op_state &&) = delete;
+
+    template <std::size_t I, typename... Args>
+    auto complete(Args &&...args) -> void {
+        if constexpr (I == last_step) {
+            set_value(std::move(rcvr), std::forward<Args>(args)...);
+        } else {
+            auto &op = state.template emplace<I + 1>(stdx::with_result_of{[&] {
+                return connect(std::move(rest)[stdx::index<I>],
+                               step_rcvr<I + 1>{this});
+            }});
+            start(std::move(op));
+        }
+    }
+
+    [[no_unique_address]] Rcvr rcvr;
+    [[no_unique_address]] stdx::tuple<Rest...> rest;
+
+    template <typename Is> struct ops_for;
+    template <std::size_t... Is> struct ops_for<std::index_sequence<Is...>> {
+        using type =
+            std::variant<connect_result_t<First, step_rcvr<0>>,
+                         connect_result_t<Rest, step_rcvr<Is + 1>>...>;
+    };
+    typename ops_for<std::index_sequence_for<Rest...>>::type state;
+
+  private:
+    template <stdx::same_as_unqualified<steps_op_state> O>
+    friend constexpr auto tag_invoke(start_t, O &&o) -> void {
+        start(std::get<0>(std::forward<O>(o).state));
+    }
+};
+
+template <typename... Sndrs> struct steps_sender {
+    using is_sender = void;
+
+    [[no_unique_address]] stdx::tuple<Sndrs...> sndrs;
+
+  private:
+    using last_sender = boost::mp11::mp_back<boost::mp11::mp_list<Sndrs...>>;
+    using earlier_senders =
+        boost::mp11::mp_pop_back<boost::mp11::mp_list<Sndrs...>>;
+
+    template <typename Self, typename R>
+    [[nodiscard]] constexpr static auto connect_impl(Self &&self, R &&r) {
+        return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+            return steps_op_state<std::remove_cvref_t<R>, Sndrs...>{
+                std::forward<Self>(self).sndrs[stdx::index<0>],
+                std::forward<R>(r),
+                std::forward<Self>(self).sndrs[stdx::index<Is + 1>]...};
+        }(std::make_index_sequence<sizeof...(Sndrs) - 1>{});
+    }
+
+    template <async::receiver R>
+    [[nodiscard]] friend constexpr auto tag_invoke(connect_t,
+                                                   steps_sender &&self, R &&r)
+        -> steps_op_state<std::remove_cvref_t<R>, Sndrs...> {
+        check_connect<steps_sender &&, R>();
+        return connect_impl(std::move(self), std::forward<R>(r));
+    }
+
+    template <stdx::same_as_unqualified<steps_sender> Self, async::receiver R>
+        requires(... and (multishot_sender<Sndrs> and
+                          std::copy_constructible<Sndrs>))
+    [[nodiscard]] friend constexpr auto tag_invoke(connect_t, Self &&self,
+                                                   R &&r)
+        -> steps_op_state<std::remove_cvref_t<R>, Sndrs...> {
+        check_connect<Self, R>();
+        return connect_impl(std::forward<Self>(self), std::forward<R>(r));
+    }
+
+    template <typename Env> struct unchanged_completions {
+        template <typename S>
+        using fn = boost::mp11::mp_append<error_signatures_of_t<S, Env>,
+                                          stopped_signatures_of_t<S, Env>>;
+    };
+
+    template <typename Env>
+    [[nodiscard]] friend constexpr auto tag_invoke(get_completion_signatures_t,
+                                                   steps_sender const &,
+                                                   Env const &)
+        -> boost::mp11::mp_unique<boost::mp11::mp_apply<
+            boost::mp11::mp_append,
+            boost::mp11::mp_push_back<
+                boost::mp11::mp_transform_q<unchanged_completions<Env>,
+                                            earlier_senders>,
+                completion_signatures_of_t<last_sender, Env>>>> {
+        return {};
+    }
+
+    [[nodiscard]] friend constexpr auto tag_invoke(async::get_env_t,
+                                                   steps_sender const &self) {
+        return forward_env_of(self.sndrs[stdx::index<sizeof...(Sndrs) - 1>]);
+    }
+};
 } // namespace _sequence
 
 template <std::invocable F> [[nodiscard]] constexpr auto sequence(F &&f) {
@@ -167,6 +312,13 @@ template <sender S, std::invocable F>
     return std::forward<S>(s) | sequence(std::forward<F>(f));
 }
 
+template <sender... Sndrs>
+    requires(sizeof...(Sndrs) > 1)
+[[nodiscard]] constexpr auto sequence(Sndrs &&...sndrs) -> sender auto {
+    return _sequence::steps_sender<std::remove_cvref_t<Sndrs>...>{
+        {std::forward<Sndrs>(sndrs)...}};
+}
+
 template <sender S> [[nodiscard]] constexpr auto seq(S &&s) {
     return sequence(_sequence::detail::wrapper{std::forward<S>(s)});
 }
@@ -0,0 +1,905 @@
+#pragma once
+
+#include <async/compose.hpp>
+#include <async/concepts.hpp>
+#include <async/env.hpp>
+#include <async/schedulers/task.hpp>
+#include <async/schedulers/time_scheduler.hpp>
+#include <async/schedulers/timer_manager_interface.hpp>
+#include <async/sequence_sender.hpp>
+#include <async/tags.hpp>
+#include <async/stop_token.hpp>
+#include <async/type_traits.hpp>
+#include <conc/concurrency.hpp>
+
+#include <stdx/concepts.hpp>
+#include <stdx/functional.hpp>
+#include <stdx/tuple.hpp>
+#include <stdx/type_traits.hpp>
+
+#include <boost/mp11/algorithm.hpp>
+#include <boost/mp11/list.hpp>
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace async {
+namespace _sequence {
+// Each adaptor is a receiver that handles set_next with a step (which holds
+// the adaptor's function and state) and forwards everything else. The step
+// lives in the receiver, and so in the operation state of the sequence.
+template <typename Step, typename R> struct receiver {
+    using is_receiver = void;
+    [[no_unique_address]] R r;
+    [[no_unique_address]] Step step;
+
+  private:
+    template <stdx::same_as_unqualified<receiver> Self, typename... Args>
+    friend constexpr auto tag_invoke(set_next_t, Self &&self, Args &&...args)
+        -> bool {
+        return self.step.next(self.r, std::forward<Args>(args)...);
+    }
+
+    template <stdx::same_as_unqualified<receiver> Self>
+    friend constexpr auto tag_invoke(set_value_t, Self &&self) -> void {
+        self.step.end(std::forward<Self>(self).r);
+    }
+
+    template <stdx::same_as_unqualified<receiver> Self, typename... Args>
+    friend constexpr auto tag_invoke(set_error_t, Self &&self, Args &&...args)
+        -> void {
+        self.step.error(std::forward<Self>(self).r,
+                        std::forward<Args>(args)...);
+    }
+
+    template <stdx::same_as_unqualified<receiver> Self>
+    friend constexpr auto tag_invoke(set_stopped_t, Self &&self) -> void {
+        self.step.stopped(std::forward<Self>(self).r);
+    }
+
+    [[nodiscard]] friend constexpr auto tag_invoke(async::get_env_t,
+                                                   receiver const &self)
+        -> ::async::detail::forwarding_env<env_of_t<R>> {
+        return forward_env_of(self.r);
+    }
+};
+
+// The completion of the sequence is passed on unless a step overrides it.
+struct step_base {
+    template <typename R> constexpr static auto end(R &&r) -> void {
+        set_value(std::forward<R>(r));
+    }
+    template <typename R, typename... Args>
+    constexpr static auto error(R &&r, Args &&...args) -> void {
+        set_error(std::forward<R>(r), std::forward<Args>(args)...);
+    }
+    template <typename R> constexpr static auto stopped(R &&r) -> void {
+        set_stopped(std::forward<R>(r));
+    }
+};
+
+// A spec describes an adaptor: it makes the step for a given sequence (whose
+// completion signatures, and the receiver it sends to, it may need) and
+// computes the completion signatures.
+template <typename S, typename Spec> struct sender {
+    using is_sender = void;
+
+    [[no_unique_address]] S s;
+    [[no_unique_address]] Spec spec;
+
+  private:
+    template <typename R>
+    using step_t =
+        decltype(std::declval<Spec const &>()
+                     .template make_step<completion_signatures_of_t<
+                                             S, env_of_t<R>>,
+                                         std::remove_cvref_t<R>>());
+
+    template <typename R>
+    using receiver_t = receiver<step_t<R>, std::remove_cvref_t<R>>;
+
+    template <stdx::same_as_unqualified<sender> Self, async::receiver R>
+        requires std::is_rvalue_reference_v<Self &&> or multishot_sender<S>
+    [[nodiscard]] friend constexpr auto tag_invoke(connect_t, Self &&self,
+                                                   R &&r) {
+        check_connect<Self, R>();
+        using sigs_t = completion_signatures_of_t<S, env_of_t<R>>;
+        return connect(
+            std::forward<Self>(self).s,
+            receiver_t<R>{std::forward<R>(r),
+                          self.spec.template make_step<
+                              sigs_t, std::remove_cvref_t<R>>()});
+    }
+
+    [[nodiscard]] friend constexpr auto tag_invoke(async::get_env_t,
+                                                   sender const &self) {
+        return forward_env_of(self.s);
+    }
+
+    template <typename Env>
+    [[nodiscard]] friend constexpr auto
+    tag_invoke(get_completion_signatures_t, sender const &, Env const &) ->
+        typename Spec::template signatures<completion_signatures_of_t<S, Env>> {
+        return {};
+    }
+};
+
+template <typename Spec> struct pipeable {
+    Spec spec;
+
+  private:
+    template <async::sender S, stdx::same_as_unqualified<pipeable> Self>
+    friend constexpr auto operator|(S &&s, Self &&self) -> async::sender auto {
+        return sender<std::remove_cvref_t<S>, Spec>{
+            std::forward<S>(s), std::forward<Self>(self).spec};
+    }
+};
+
+template <typename Spec> constexpr auto make_adaptor(Spec &&spec) {
+    return _compose::adaptor{stdx::tuple{
+        pipeable<std::remove_cvref_t<Spec>>{std::forward<Spec>(spec)}}};
+}
+
+template <typename F> struct transform_spec {
+    F f;
+
+    template <typename... As>
+    using result_signature = ::async::detail::eat_void_t<
+        std::invoke_result_t<F &, As...>, ::async::detail::next_signature>;
+
+    template <typename Sigs>
+    using signatures = transform_item_signatures<Sigs, result_signature>;
+
+    struct step : step_base {
+        [[no_unique_address]] F f;
+
+        template <typename R, typename... Args>
+        constexpr auto next(R &r, Args &&...args) -> bool {
+            if constexpr (std::is_void_v<
+                              std::invoke_result_t<F &, Args &&...>>) {
+                std::invoke(f, std::forward<Args>(args)...);
+                return set_next(r);
+            } else {
+                return set_next(r, std::invoke(f, std::forward<Args>(args)...));
+            }
+        }
+    };
+
+    template <typename, typename>
+    constexpr auto make_step() const -> step {
+        return {{}, f};
+    }
+};
+
+template <typename P> struct filter_spec {
+    P p;
+
+    template <typename Sigs> using signatures = Sigs;
+
+    struct step : step_base {
+        [[no_unique_address]] P p;
+
+        template <typename R, typename... Args>
+        constexpr auto next(R &r, Args &&...args) -> bool {
+            if (std::invoke(p, std::as_const(args)...)) {
+                return set_next(r, std::forward<Args>(args)...);
+            }
+            return true;
+        }
+    };
+
+    template <typename, typename>
+    constexpr auto make_step() const -> step {
+        return {{}, p};
+    }
+};
+
+struct take_spec {
+    std::size_t n;
+
+    template <typename Sigs> using signatures = Sigs;
+
+    struct step : step_base {
+        std::size_t remaining;
+
+        template <typename R, typename... Args>
+        constexpr auto next(R &r, Args &&...args) -> bool {
+            if (remaining == 0) {
+                return false;
+            }
+            --remaining;
+            return set_next(r, std::forward<Args>(args)...) and remaining != 0;
+        }
+    };
+
+    template <typename, typename>
+    constexpr auto make_step() const -> step {
+        return {{}, n};
+    }
+};
+
+template <typename Sig> struct single_item {
+    static_assert(stdx::always_false_v<Sig>,
+                  "batch, window and debounce require a sequence of single "
+                  "values");
+};
+template <typename T> struct single_item<set_next_t(T)> {
+    using type = std::remove_cvref_t<T>;
+};
+
+template <typename Items> struct item_type {
+    static_assert(stdx::always_false_v<Items>,
+                  "batch, window and debounce require a sequence of one item "
+                  "type");
+};
+template <typename Sig> struct item_type<completion_signatures<Sig>> {
+    using type = typename single_item<Sig>::type;
+};
+
+template <std::size_t N> struct batch_spec {
+    template <typename Sigs>
+    using batch_signature = completion_signatures<set_next_t(
+        std::span<typename item_type<item_signatures_t<Sigs>>::type>)>;
+
+    template <typename Sigs>
+    using signatures = boost::mp11::mp_unique<boost::mp11::mp_append<
+        batch_signature<Sigs>,
+        boost::mp11::mp_remove_if<Sigs, ::async::detail::is_next_signature>>>;
+
+    template <typename T> struct step : step_base {
+        std::array<T, N> items{};
+        std::size_t count{};
+
+        template <typename R, typename Arg>
+        constexpr auto next(R &r, Arg &&arg) -> bool {
+            items[count++] = std::forward<Arg>(arg);
+            if (count < N) {
+                return true;
+            }
+            count = 0;
+            return set_next(r, std::span<T>{items});
+        }
+
+        // a partial batch is sent before the end of the sequence
+        template <typename R> constexpr auto end(R &&r) -> void {
+            if (count != 0) {
+                set_next(r, std::span<T>{items.data(), count});
+                count = 0;
+            }
+            set_value(std::forward<R>(r));
+        }
+    };
+
+    template <typename Sigs, typename>
+    constexpr auto make_step() const
+        -> step<typename item_type<item_signatures_t<Sigs>>::type> {
+        return {};
+    }
+};
+
+// The completion of a sequence, held until work in another context (such as
+// a timer) has finished; monostate until the sequence completes.
+template <typename Sigs>
+using stored_completion_t = boost::mp11::mp_push_front<
+    boost::mp11::mp_unique<boost::mp11::mp_append<
+        std::variant<value_holder<>>,
+        ::async::detail::gather_signatures<set_error_t, Sigs, error_holder,
+                                           std::variant>,
+        std::variant<stopped_holder<>>>>,
+    std::monostate>;
+
+template <typename C, typename R>
+auto complete_stored(C &completion, R &&r) -> void {
+    std::visit(
+        [&]<typename H>(H &h) -> void {
+            if constexpr (not std::is_same_v<H, std::monostate>) {
+                std::move(h)(std::forward<R>(r));
+            }
+        },
+        completion);
+}
+
+template <typename Step> struct window_timer_receiver {
+    using is_receiver = void;
+    Step *step;
+
+  private:
+    friend constexpr auto tag_invoke(set_value_t,
+                                     window_timer_receiver const &r) -> void {
+        r.step->expire();
+    }
+    friend constexpr auto tag_invoke(set_stopped_t,
+                                     window_timer_receiver const &r) -> void {
+        r.step->expire();
+    }
+
+    [[nodiscard]] friend constexpr auto
+    tag_invoke(async::get_env_t, window_timer_receiver const &r)
+        -> ::async::detail::singleton_env<get_stop_token_t,
+                                          inplace_stop_token> {
+        return {r.step->state.stop_source.get_token()};
+    }
+};
+
+// A window batches as batch does, and also sends a partial batch when a timer
+// expires. The timer is armed by an item that arrives while no timer is
+// pending, so no item waits longer than one timer period.
+//
+// Items and expiries may arrive in different contexts (for instance, a sensor
+// interrupt and a timer interrupt). A batch is filled in one buffer and sent
+// from the other; the buffers are handed over in a short critical section,
+// and only one context at a time sends batches downstream.
+template <typename Sched, std::size_t N> struct window_spec {
+    [[no_unique_address]] Sched sched;
+
+    template <typename Sigs>
+    using signatures = typename batch_spec<N>::template signatures<Sigs>;
+
+    template <typename T, typename Sigs, typename R> struct step {
+        using timer_sender_t = decltype(std::declval<Sched &>().schedule());
+        using timer_state_t =
+            connect_result_t<timer_sender_t, window_timer_receiver<step>>;
+
+        using completions_t = stored_completion_t<Sigs>;
+
+        // Nothing has started when a step is moved into its operation state,
+        // so a move carries no state.
+        // NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+        struct state_t {
+            state_t() = default;
+            state_t(state_t &&) : state_t{} {}
+
+            std::array<std::array<T, N>, 2> buffers{};
+            std::size_t filling{};
+            std::size_t count{};
+            std::size_t sent_count{};
+            std::size_t active{};
+            bool flush_due{};
+            bool delivering{};
+            bool timer_pending{};
+            bool more{true};
+            bool completed{};
+            completions_t completion{};
+            R *rcvr{};
+            inplace_stop_source stop_source{};
+            std::optional<timer_state_t> timer{};
+        };
+
+        [[no_unique_address]] Sched sched;
+        state_t state{};
+
+        struct mutex;
+
+        // Called in the critical section: the filling buffer becomes the
+        // sending buffer when that is free. Once the receiver wants no more
+        // items, a batch is discarded instead.
+        auto seal() -> bool {
+            if (not state.more) {
+                state.count = 0;
+                state.flush_due = false;
+                return false;
+            }
+            if (state.sent_count != 0 or state.count == 0) {
+                return false;
+            }
+            state.sent_count = std::exchange(state.count, 0);
+            state.filling ^= 1u;
+            state.flush_due = false;
+            return true;
+        }
+
+        auto flush() -> void {
+            if (state.count != 0 and not seal()) {
+                state.flush_due = true;
+            }
+        }
+
+        auto send_batches() -> void {
+            auto claimed = conc::call_in_critical_section<mutex>([&] {
+                if (state.delivering or state.sent_count == 0) {
+                    return false;
+                }
+                state.delivering = true;
+                return true;
+            });
+            while (claimed) {
+                auto &b = state.buffers[state.filling ^ 1u];
+                auto const more = set_next(
+                    *state.rcvr, std::span<T>{b.data(), state.sent_count});
+                claimed = conc::call_in_critical_section<mutex>([&] {
+                    state.sent_count = 0;
+                    state.more = state.more and more;
+                    if ((state.flush_due or state.count == N) and seal()) {
+                        return true;
+                    }
+                    state.delivering = false;
+                    return false;
+                });
+            }
+        }
+
+        // Expiry and the end of the sequence may each finish the last piece
+        // of work, in either order; whichever leaves last completes the
+        // sequence.
+        auto leave() -> void {
+            auto const done = conc::call_in_critical_section<mutex>([&] {
+                --state.active;
+                if (state.active != 0 or state.completion.index() == 0 or
+                    state.completed or state.timer_pending or
+                    state.delivering or state.sent_count != 0 or
+                    state.count != 0) {
+                    return false;
+                }
+                state.completed = true;
+                return true;
+            });
+            if (done) {
+                complete_stored(state.completion, std::move(*state.rcvr));
+            }
+        }
+
+        auto arm_timer() -> void {
+            start(state.timer.emplace(stdx::with_result_of{[&] {
+                return connect(sched.schedule(),
+                               window_timer_receiver<step>{this});
+            }}));
+        }
+
+        // The timer stays pending until its expiry has been handled, so that
+        // it is not rearmed while it is running. Items that arrive meanwhile
+        // rearm it here.
+        auto expire() -> void {
+            conc::call_in_critical_section<mutex>([&] {
+                ++state.active;
+                flush();
+            });
+            send_batches();
+            auto const rearm = conc::call_in_critical_section<mutex>([&] {
+                state.timer_pending =
+                    state.count != 0 and state.completion.index() == 0;
+                return state.timer_pending;
+            });
+            if (rearm) {
+                arm_timer();
+            }
+            leave();
+        }
+
+        template <typename Rcvr, typename Arg>
+        auto next(Rcvr &r, Arg &&arg) -> bool {
+            state.rcvr = std::addressof(r);
+            auto const arm = conc::call_in_critical_section<mutex>([&] {
+                // the buffer is full while the previous batch is still
+                // being sent: the item is dropped (an overrun)
+                if (not state.more or state.count == N) {
+                    return false;
+                }
+                state.buffers[state.filling][state.count++] =
+                    std::forward<Arg>(arg);
+                if (state.count == N) {
+                    seal();
+                }
+                return not std::exchange(state.timer_pending, true);
+            });
+            if (arm) {
+                arm_timer();
+            }
+            send_batches();
+            return conc::call_in_critical_section<mutex>(
+                [&] { return state.more; });
+        }
+
+        // At the end of the sequence the partial batch is sent; on an error
+        // or a stop it is discarded. In each case a pending timer is
+        // cancelled, and the sequence completes once the timer has finished.
+        template <typename Tag, typename Holder, typename Rcvr,
+                  typename... Args>
+        auto finish(Rcvr &r, Args &&...args) -> void {
+            state.rcvr = std::addressof(r);
+            auto const cancel = conc::call_in_critical_section<mutex>([&] {
+                ++state.active;
+                state.completion.template emplace<Holder>(
+                    std::forward<Args>(args)...);
+                if constexpr (std::is_same_v<Tag, set_value_t>) {
+                    flush();
+                } else {
+                    state.count = 0;
+                    state.flush_due = false;
+                }
+                return state.timer_pending;
+            });
+            if (cancel) {
+                state.stop_source.request_stop();
+            }
+            send_batches();
+            leave();
+        }
+
+        template <typename Rcvr> auto end(Rcvr &&r) -> void {
+            finish<set_value_t, value_holder<>>(r);
+        }
+        template <typename Rcvr, typename... Args>
+        auto error(Rcvr &&r, Args &&...args) -> void {
+            finish<set_error_t, error_holder<std::remove_cvref_t<Args>...>>(
+                r, std::forward<Args>(args)...);
+        }
+        template <typename Rcvr> auto stopped(Rcvr &&r) -> void {
+            finish<set_stopped_t, stopped_holder<>>(r);
+        }
+    };
+
+    template <typename Sigs, typename R>
+    constexpr auto make_step() const
+        -> step<typename item_type<item_signatures_t<Sigs>>::type, Sigs, R> {
+        return {sched};
+    }
+};
+
+// A timer task that an adaptor's step arms, restarts and cancels in place, so
+// that however many items arrive it uses one timer node. Nothing has started
+// when a step is moved into its operation state, so a move carries no state;
+// the owner is set when the step first handles an item.
+template <typename Task, typename Owner>
+// NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+struct step_timer : Task {
+    constexpr step_timer() : Task{run_task<step_timer>} {}
+    constexpr step_timer(step_timer &&) : step_timer{} {}
+
+    auto run() -> void { owner->expire(); }
+
+    Owner *owner{};
+};
+
+// Debounce holds the latest item and restarts the timer with each one; the
+// item is sent when the timer expires, so a burst of items ends in one item.
+// As in window, the item may be sent from the timer's context or, at the end
+// of the sequence, from the sequence's own; only one context at a time sends,
+// and whichever sends last completes the sequence.
+template <typename Domain, typename Duration, typename Task>
+struct debounce_spec {
+    [[no_unique_address]] Duration d;
+
+    template <typename Sigs>
+    using item_t = typename item_type<item_signatures_t<Sigs>>::type;
+
+    template <typename Sigs>
+    using signatures = boost::mp11::mp_unique<boost::mp11::mp_append<
+        completion_signatures<set_next_t(item_t<Sigs>)>,
+        boost::mp11::mp_remove_if<Sigs, ::async::detail::is_next_signature>>>;
+
+    template <typename T, typename Sigs, typename R> struct step {
+        // NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+        struct state_t {
+            state_t() = default;
+            state_t(state_t &&) : state_t{} {}
+
+            std::optional<T> item{};
+            bool more{true};
+            bool delivering{};
+            bool completed{};
+            stored_completion_t<Sigs> completion{};
+            R *rcvr{};
+            step_timer<Task, step> timer{};
+        };
+
+        [[no_unique_address]] Duration d;
+        state_t state{};
+
+        struct mutex;
+
+        // Called in the critical section. Once the receiver wants no more
+        // items, a held item is discarded instead.
+        auto claim(std::optional<T> &v) -> bool {
+            if (state.delivering or not state.item) {
+                return false;
+            }
+            if (state.more) {
+                v = std::move(state.item);
+                state.delivering = true;
+            }
+            state.item.reset();
+            return state.delivering;
+        }
+
+        auto deliver() -> void {
+            std::optional<T> v{};
+            auto claimed = conc::call_in_critical_section<mutex>(
+                [&] { return claim(v); });
+            while (claimed) {
+                auto const more = set_next(*state.rcvr, std::move(*v));
+                claimed = conc::call_in_critical_section<mutex>([&] {
+                    state.more = state.more and more;
+                    state.delivering = false;
+                    return state.completion.index() != 0 and claim(v);
+                });
+            }
+            auto const done = conc::call_in_critical_section<mutex>([&] {
+                if (state.delivering or state.completed or
+                    state.completion.index() == 0) {
+                    return false;
+                }
+                state.completed = true;
+                return true;
+            });
+            if (done) {
+                complete_stored(state.completion, std::move(*state.rcvr));
+            }
+        }
+
+        auto expire() -> void { deliver(); }
+
+        template <typename Rcvr, typename Arg>
+        auto next(Rcvr &r, Arg &&arg) -> bool {
+            state.rcvr = std::addressof(r);
+            state.timer.owner = this;
+            auto const more = conc::call_in_critical_section<mutex>([&] {
+                if (state.more) {
+                    state.item.emplace(std::forward<Arg>(arg));
+                }
+                return state.more;
+            });
+            if (more) {
+                timer_mgr::detail::cancel<Domain>(state.timer);
+                timer_mgr::detail::run_after<Domain>(state.timer, d);
+            }
+            return more;
+        }
+
+        // At the end of the sequence the held item is sent at once; on an
+        // error or a stop it is discarded.
+        template <typename Tag, typename Holder, typename Rcvr,
+                  typename... Args>
+        auto finish(Rcvr &r, Args &&...args) -> void {
+            state.rcvr = std::addressof(r);
+            timer_mgr::detail::cancel<Domain>(state.timer);
+            conc::call_in_critical_section<mutex>([&] {
+                state.completion.template emplace<Holder>(
+                    std::forward<Args>(args)...);
+                if constexpr (not std::is_same_v<Tag, set_value_t>) {
+                    state.item.reset();
+                }
+            });
+            deliver();
+        }
+
+        template <typename Rcvr> auto end(Rcvr &&r) -> void {
+            finish<set_value_t, value_holder<>>(r);
+        }
+        template <typename Rcvr, typename... Args>
+        auto error(Rcvr &&r, Args &&...args) -> void {
+            finish<set_error_t, error_holder<std::remove_cvref_t<Args>...>>(
+                r, std::forward<Args>(args)...);
+        }
+        template <typename Rcvr> auto stopped(Rcvr &&r) -> void {
+            finish<set_stopped_t, stopped_holder<>>(r);
+        }
+    };
+
+    template <typename Sigs, typename R>
+    constexpr auto make_step() const -> step<item_t<Sigs>, Sigs, R> {
+        return {d};
+    }
+};
+
+// Throttle sends an item and then drops items until the timer expires. The
+// timer is armed only by an item that is sent, and expiry only reopens the
+// gate, so nothing is sent from the timer's context.
+template <typename Domain, typename Duration, typename Task>
+struct throttle_spec {
+    [[no_unique_address]] Duration d;
+
+    template <typename Sigs> using signatures = Sigs;
+
+    struct step {
+        // NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+        struct state_t {
+            state_t() = default;
+            state_t(state_t &&) : state_t{} {}
+
+            bool open{true};
+            step_timer<Task, step> timer{};
+        };
+
+        [[no_unique_address]] Duration d;
+        state_t state{};
+
+        struct mutex;
+
+        auto expire() -> void {
+            conc::call_in_critical_section<mutex>([&] { state.open = true; });
+        }
+
+        template <typename R, typename... Args>
+        auto next(R &r, Args &&...args) -> bool {
+            state.timer.owner = this;
+            auto const pass = conc::call_in_critical_section<mutex>(
+                [&] { return std::exchange(state.open, false); });
+            if (not pass) {
+                return true;
+            }
+            timer_mgr::detail::run_after<Domain>(state.timer, d);
+            return set_next(r, std::forward<Args>(args)...);
+        }
+
+        template <typename R> auto end(R &&r) -> void {
+            timer_mgr::detail::cancel<Domain>(state.timer);
+            set_value(std::forward<R>(r));
+        }
+        template <typename R, typename... Args>
+        auto error(R &&r, Args &&...args) -> void {
+            timer_mgr::detail::cancel<Domain>(state.timer);
+            set_error(std::forward<R>(r), std::forward<Args>(args)...);
+        }
+        template <typename R> auto stopped(R &&r) -> void {
+            timer_mgr::detail::cancel<Domain>(state.timer);
+            set_stopped(std::forward<R>(r));
+        }
+    };
+
+    template <typename, typename>
+    constexpr auto make_step() const -> step {
+        return {d};
+    }
+};
+
+template <typename F> struct for_each_spec {
+    F f;
+
+    template <typename Sigs>
+    using signatures =
+        boost::mp11::mp_remove_if<Sigs, ::async::detail::is_next_signature>;
+
+    struct step : step_base {
+        [[no_unique_address]] F f;
+
+        template <typename R, typename... Args>
+        constexpr auto next(R &, Args &&...args) -> bool {
+            std::invoke(f, std::forward<Args>(args)...);
+            return true;
+        }
+    };
+
+    template <typename, typename>
+    constexpr auto make_step() const -> step {
+        return {{}, f};
+    }
+};
+} // namespace _sequence
+
+// Sends f(item) for each item of a sequence (or, if f returns void, an item
+// with no values).
+template <stdx::callable F> [[nodiscard]] constexpr auto transform(F &&f) {
+    return _sequence::make_adaptor(
+        _sequence::transform_spec<std::remove_cvref_t<F>>{std::forward<F>(f)});
+}
+
+template <sender S, stdx::callable F>
+[[nodiscard]] constexpr auto transform(S &&s, F &&f) -> sender auto {
+    return std::forward<S>(s) | transform(std::forward<F>(f));
+}
+
+// Sends only the items for which the predicate returns true.
+template <stdx::callable P> [[nodiscard]] constexpr auto filter(P &&p) {
+    return _sequence::make_adaptor(
+        _sequence::filter_spec<std::remove_cvref_t<P>>{std::forward<P>(p)});
+}
+
+template <sender S, stdx::callable P>
+[[nodiscard]] constexpr auto filter(S &&s, P &&p) -> sender auto {
+    return std::forward<S>(s) | filter(std::forward<P>(p));
+}
+
+// Sends the first n items, then ends the sequence.
+[[nodiscard]] constexpr auto take(std::size_t n) {
+    return _sequence::make_adaptor(_sequence::take_spec{n});
+}
+
+template <sender S>
+[[nodiscard]] constexpr auto take(S &&s, std::size_t n) -> sender auto {
+    return std::forward<S>(s) | take(n);
+}
+
+// Collects N single-value items at a time, and sends each batch as a span over
+// storage in the operation state. The span is valid until set_next returns. At
+// the end of the sequence, a partial batch is sent.
+template <std::size_t N> [[nodiscard]] constexpr auto batch() {
+    static_assert(N > 0, "A batch must hold at least one item");
+    return _sequence::make_adaptor(_sequence::batch_spec<N>{});
+}
+
+template <std::size_t N, sender S>
+[[nodiscard]] constexpr auto batch(S &&s) -> sender auto {
+    return std::forward<S>(s) | batch<N>();
+}
+
+// Collects up to N single-value items at a time, as batch does, and also sends
+// a partial batch when a timer from the scheduler expires: no item waits
+// longer than one timer period. For example, with a time_scheduler:
+//
+//   readings | async::window<16>(async::time_scheduler{10ms})
+//
+// The timer may expire in a different context from the one sending items; if
+// a batch fills while the previous batch is still being sent, further items
+// are dropped until it has been sent.
+template <std::size_t N, scheduler Sched>
+[[nodiscard]] constexpr auto window(Sched &&sched) {
+    static_assert(N > 0, "A batch must hold at least one item");
+    return _sequence::make_adaptor(
+        _sequence::window_spec<std::remove_cvref_t<Sched>, N>{
+            std::forward<Sched>(sched)});
+}
+
+template <std::size_t N, sender S, scheduler Sched>
+[[nodiscard]] constexpr auto window(S &&s, Sched &&sched) -> sender auto {
+    return std::forward<S>(s) | window<N>(std::forward<Sched>(sched));
+}
+
+// Sends the last item of each burst: an item is sent once the time
+// scheduler's duration has passed without another item. For example, to act
+// on a bouncing button once it has settled:
+//
+//   edges | async::debounce(async::time_scheduler{20ms})
+//
+// One timer task in the operation state is restarted with each item. At the
+// end of the sequence, an item that is still held is sent.
+template <typename Domain, typename Duration, typename Task,
+          typename Cancellation>
+[[nodiscard]] constexpr auto
+debounce(time_scheduler<Domain, Duration, Task, Cancellation> sched) {
+    static_assert(timer_mgr::detail::valid_duration<Duration, Domain>(),
+                  "debounce has invalid duration type for the injected timer "
+                  "manager");
+    return _sequence::make_adaptor(
+        _sequence::debounce_spec<Domain, Duration, Task>{sched.d});
+}
+
+template <sender S, typename Domain, typename Duration, typename Task,
+          typename Cancellation>
+[[nodiscard]] constexpr auto
+debounce(S &&s, time_scheduler<Domain, Duration, Task, Cancellation> sched)
+    -> sender auto {
+    return std::forward<S>(s) | debounce(sched);
+}
+
+// Sends the first item of each burst: after an item is sent, items are
+// dropped until the time scheduler's duration has passed. One timer task in
+// the operation state is armed by each item that is sent.
+template <typename Domain, typename Duration, typename Task,
+          typename Cancellation>
+[[nodiscard]] constexpr auto
+throttle(time_scheduler<Domain, Duration, Task, Cancellation> sched) {
+    static_assert(timer_mgr::detail::valid_duration<Duration, Domain>(),
+                  "throttle has invalid duration type for the injected timer "
+                  "manager");
+    return _sequence::make_adaptor(
+        _sequence::throttle_spec<Domain, Duration, Task>{sched.d});
+}
+
+template <sender S, typename Domain, typename Duration, typename Task,
+          typename Cancellation>
+[[nodiscard]] constexpr auto
+throttle(S &&s, time_scheduler<Domain, Duration, Task, Cancellation> sched)
+    -> sender auto {
+    return std::forward<S>(s) | throttle(sched);
+}
+
+// Calls f for each item. The result is an ordinary sender, which completes
+// with set_value() at the end of the sequence.
+template <stdx::callable F> [[nodiscard]] constexpr auto for_each(F &&f) {
+    return _sequence::make_adaptor(
+        _sequence::for_each_spec<std::remove_cvref_t<F>>{std::forward<F>(f)});
+}
+
+template <sender S, stdx::callable F>
+[[nodiscard]] constexpr auto for_each(S &&s, F &&f) -> sender auto {
+    return std::forward<S>(s) | for_each(std::forward<F>(f));
+}
+} // namespace async
@@ -0,0 +1,283 @@
+#pragma once
+
+#include <async/concepts.hpp>
+#include <async/env.hpp>
+#include <async/stop_token.hpp>
+#include <async/tags.hpp>
+#include <async/trampoline.hpp>
+#include <async/type_traits.hpp>
+
+#include <stdx/concepts.hpp>
+#include <stdx/functional.hpp>
+#include <stdx/type_traits.hpp>
+
+#include <boost/mp11/algorithm.hpp>
+
+#include <concepts>
+#include <optional>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+namespace async {
+// A sequence sender sends any number of items, each with set_next, before it
+// completes. Its completion signatures list the items as set_next_t(Ts...)
+// alongside its completions; a sequence that runs to its end completes with
+// set_value(). A receiver that does not handle set_next cannot be connected
+// to it.
+//
+// set_next returns whether the receiver wants more items. When it returns
+// false, the sequence sends no more and completes with set_value().
+constexpr inline struct set_next_t {
+    template <typename... Ts>
+    constexpr auto operator()(Ts &&...ts) const
+        noexcept(noexcept(tag_invoke(std::declval<set_next_t>(),
+                                     std::forward<Ts>(ts)...)))
+            -> decltype(tag_invoke(*this, std::forward<Ts>(ts)...)) {
+        return tag_invoke(*this, std::forward<Ts>(ts)...);
+    }
+} set_next{};
+
+namespace detail {
+template <typename Sig> struct is_next_signature : std::false_type {};
+template <typename... As>
+struct is_next_signature<set_next_t(As...)> : std::true_type {};
+
+template <typename... As>
+using next_signature = completion_signatures<set_next_t(As...)>;
+
+// Maps each item signature with F (as transform_completion_signatures maps
+// value signatures) and keeps the other signatures.
+template <typename Sigs, template <typename...> typename F>
+struct transform_items;
+template <typename... Sigs, template <typename...> typename F>
+struct transform_items<completion_signatures<Sigs...>, F> {
+    using type = boost::mp11::mp_unique<boost::mp11::mp_append<
+        completion_signatures<>,
+        stdx::conditional_t<
+            is_next_signature<Sigs>::value,
+            typename transform_signature<set_next_t, Sigs, F>::type,
+            completion_signatures<Sigs>>...>>;
+};
+
+template <typename Rcvr> auto stop_requested(Rcvr const &r) -> bool {
+    if constexpr (unstoppable_token<stop_token_of_t<env_of_t<Rcvr>>>) {
+        return false;
+    } else {
+        return get_stop_token(get_env(r)).stop_requested();
+    }
+}
+} // namespace detail
+
+template <typename Sigs>
+using item_signatures_t =
+    boost::mp11::mp_copy_if<Sigs, detail::is_next_signature>;
+
+template <typename S, typename E = empty_env>
+using item_signatures_of_t =
+    item_signatures_t<completion_signatures_of_t<S, E>>;
+
+template <typename Sigs, template <typename...> typename F>
+using transform_item_signatures =
+    typename detail::transform_items<Sigs, F>::type;
+
+template <typename S, typename E, template <typename...> typename F>
+using transform_item_signatures_of =
+    transform_item_signatures<completion_signatures_of_t<S, E>, F>;
+
+namespace _iterate {
+template <typename Range, typename Rcvr> struct op_state {
+    [[no_unique_address]] Range range;
+    [[no_unique_address]] Rcvr rcvr;
+
+  private:
+    template <stdx::same_as_unqualified<op_state> O>
+    friend constexpr auto tag_invoke(start_t, O &&o) -> void {
+        for (auto const &v : o.range) {
+            if (::async::detail::stop_requested(o.rcvr)) {
+                set_stopped(std::forward<O>(o).rcvr);
+                return;
+            }
+            if (not set_next(o.rcvr, v)) {
+                break;
+            }
+        }
+        set_value(std::forward<O>(o).rcvr);
+    }
+};
+
+template <typename Range> struct sender {
+    using is_sender = void;
+    using item_t = std::ranges::range_value_t<Range const>;
+
+    [[no_unique_address]] Range range;
+
+  private:
+    template <stdx::same_as_unqualified<sender> S, receiver R>
+    [[nodiscard]] friend constexpr auto tag_invoke(connect_t, S &&s, R &&r)
+        -> op_state<Range, std::remove_cvref_t<R>> {
+        check_connect<S, R>();
+        return {std::forward<S>(s).range, std::forward<R>(r)};
+    }
+
+    template <typename Env>
+    [[nodiscard]] friend constexpr auto tag_invoke(get_completion_signatures_t,
+                                                   sender const &,
+                                                   Env const &) noexcept
+        -> completion_signatures<set_next_t(item_t), set_value_t(),
+                                 set_stopped_t()> {
+        return {};
+    }
+
+    template <typename Env>
+        requires unstoppable_token<stop_token_of_t<Env>>
+    [[nodiscard]] friend constexpr auto tag_invoke(get_completion_signatures_t,
+                                                   sender const &,
+                                                   Env const &) noexcept
+        -> completion_signatures<set_next_t(item_t), set_value_t()> {
+        return {};
+    }
+};
+} // namespace _iterate
+
+// A sequence of the elements of a range, sent in order. The range is held by
+// value: to refer to storage elsewhere, pass a span.
+template <std::ranges::forward_range R>
+    requires std::copy_constructible<std::remove_cvref_t<R>>
+[[nodiscard]] constexpr auto iterate(R &&r)
+    -> _iterate::sender<std::remove_cvref_t<R>> {
+    return {std::forward<R>(r)};
+}
+
+namespace _generate {
+template <typename Ops> struct receiver {
+    using is_receiver = void;
+
+    Ops *ops;
+
+  private:
+    template <typename... Args>
+    friend constexpr auto tag_invoke(set_value_t, receiver const &r,
+                                     Args &&...args) -> void {
+        r.ops->next(std::forward<Args>(args)...);
+    }
+    template <typename... Args>
+    friend constexpr auto tag_invoke(set_error_t, receiver const &r,
+                                     Args &&...args) -> void {
+        r.ops->finish(set_error, std::forward<Args>(args)...);
+    }
+    friend constexpr auto tag_invoke(set_stopped_t, receiver const &r) -> void {
+        r.ops->finish(set_stopped);
+    }
+
+    [[nodiscard]] friend constexpr auto tag_invoke(async::get_env_t,
+                                                   receiver const &self)
+        -> ::async::detail::forwarding_env<env_of_t<typename Ops::rcvr_t>> {
+        return forward_env_of(self.ops->rcvr);
+    }
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+template <typename Sndr, typename Rcvr> struct op_state {
+    using rcvr_t = Rcvr;
+    using receiver_t = receiver<op_state>;
+
+    template <stdx::same_as_unqualified<Sndr> S,
+              stdx::same_as_unqualified<Rcvr> R>
+    constexpr op_state(S &&s, R &&r)
+        : sndr{std::forward<S>(s)}, rcvr{std::forward<R>(r)} {}
+    constexpr op_state(op_state &&) = delete;
+
+    // As in repeat, an operation state that can reset itself is connected
+    // once and restarted in place for each item.
+    auto restart() -> void {
+        if constexpr (restartable_operation<state_t>) {
+            if (state) {
+                async::restart(*state);
+            } else {
+                state.emplace(stdx::with_result_of{
+                    [&] { return connect(sndr, receiver_t{this}); }});
+            }
+            start(*state);
+        } else {
+            auto &op = state.emplace(stdx::with_result_of{
+                [&] { return connect(sndr, receiver_t{this}); }});
+            start(std::move(op));
+        }
+    }
+
+    template <typename... Args> auto next(Args &&...args) -> void {
+        if (not set_next(rcvr, std::forward<Args>(args)...)) {
+            finish(set_value);
+            return;
+        }
+        if (not loop.defer()) {
+            loop.run([&] { restart(); });
+        }
+    }
+
+    template <typename Tag, typename... Args>
+    auto finish(Tag tag, Args &&...args) -> void {
+        loop.finish();
+        tag(std::move(rcvr), std::forward<Args>(args)...);
+    }
+
+    [[no_unique_address]] Sndr sndr;
+    [[no_unique_address]] Rcvr rcvr;
+
+    using state_t = async::connect_result_t<Sndr &, receiver_t>;
+    std::optional<state_t> state{};
+
+    struct mutex;
+    ::async::detail::trampoline<mutex> loop{};
+
+  private:
+    template <stdx::same_as_unqualified<op_state> O>
+    friend constexpr auto tag_invoke(start_t, O &&o) -> void {
+        o.loop.run([&] { o.restart(); });
+    }
+};
+
+template <typename Sndr> struct sender {
+    using is_sender = void;
+
+    [[no_unique_address]] Sndr sndr;
+
+  private:
+    template <typename Env>
+    [[nodiscard]] friend constexpr auto
+    tag_invoke(get_completion_signatures_t, sender const &, Env const &) {
+        return transform_completion_signatures_of<
+            Sndr, Env, completion_signatures<set_value_t()>,
+            ::async::detail::next_signature>{};
+    }
+
+    [[nodiscard]] friend constexpr auto tag_invoke(async::get_env_t,
+                                                   sender const &self) {
+        return forward_env_of(self.sndr);
+    }
+
+    template <stdx::same_as_unqualified<sender> Self, async::receiver R>
+        requires multishot_sender<Sndr>
+    [[nodiscard]] friend constexpr auto tag_invoke(connect_t, Self &&self,
+                                                   R &&r)
+        -> op_state<Sndr, std::remove_cvref_t<R>> {
+        check_connect<Self, R>();
+        return {std::forward<Self>(self).sndr, std::forward<R>(r)};
+    }
+};
+} // namespace _generate
+
+// A sequence made by running a (multishot) sender over and over: each value
+// it completes with is an item. An error or a stop ends the sequence with that
+// completion. A 10 kHz ADC sample sender becomes a stream of samples:
+//
+//   async::generate(adc.sample()) | async::for_each(record);
+//
+// Like repeat, generate connects a restartable operation state once and
+// restarts it in place for each item, and iterates rather than recursing when
+// the sender completes inline.
+template <sender S> [[nodiscard]] constexpr auto generate(S &&s) {
+    return _generate::sender<std::remove_cvref_t<S>>{std::forward<S>(s)};
+}
+} // namespace async
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <async/allocator.hpp>
+#include <async/concepts.hpp>
+#include <async/env.hpp>
+#include <async/start_detached.hpp>
+#include <async/static_allocator.hpp>
+#include <async/stop_token.hpp>
+#include <async/tags.hpp>
+#include <async/type_traits.hpp>
+
+#include <stdx/concepts.hpp>
+
+#include <atomic>
+#include <concepts>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace async {
+namespace _spawn_when_available {
+template <typename Uniq, typename Sndr, typename Rcvr>
+// NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+struct op_state final : detail::slot_waiter {
+    using detached_t =
+        _start_detached::op_state<Uniq, Sndr, static_allocator,
+                                  inplace_stop_source>;
+
+    template <typename S, stdx::same_as_unqualified<Rcvr> R>
+    constexpr op_state(S &&s, R &&r)
+        : sndr{std::forward<S>(s)}, rcvr{std::forward<R>(r)} {}
+    constexpr op_state(op_state &&) = delete;
+    ~op_state() {
+        if (detail::slot_waiters_v<Uniq>.dequeue(this)) {
+            detail::slot_waiters_v<Uniq>.end_wait();
+        }
+    }
+
+    auto retry() -> void final { attempt(); }
+
+    // A waiter that is stopped leaves the queue, unless a release has just
+    // taken it to retry; then the retry sees the request.
+    struct stop_callback_fn {
+        auto operator()() -> void {
+            ops->stopping.store(true);
+            if (detail::slot_waiters_v<Uniq>.dequeue(ops)) {
+                ops->stop();
+            }
+        }
+        op_state *ops;
+    };
+
+    using stop_callback_t = optional_stop_callback_t<
+        stop_token_of_t<env_of_t<Rcvr>>, stop_callback_fn>;
+
+    [[no_unique_address]] Sndr sndr;
+    [[no_unique_address]] Rcvr rcvr;
+    std::atomic<bool> stopping{};
+    [[no_unique_address]] stop_callback_t stop_cb{};
+
+  private:
+    // The sender is only moved from when a slot is claimed, so a failed
+    // attempt leaves it intact for the next one.
+    auto try_spawn() -> inplace_stop_source * {
+        inplace_stop_source *stop_src{};
+        static_allocator::construct<Uniq, detached_t>(
+            [&](detached_t &&ops) {
+                stop_src = std::addressof(ops.stop_src);
+                async::start(std::move(ops));
+            },
+            std::move(sndr));
+        return stop_src;
+    }
+
+    auto stop() -> void {
+        detail::slot_waiters_v<Uniq>.end_wait();
+        stop_cb.reset();
+        set_stopped(std::move(rcvr));
+    }
+
+    auto attempt() -> void {
+        auto &waiters = detail::slot_waiters_v<Uniq>;
+        while (true) {
+            if (stopping.load()) {
+                stop();
+                return;
+            }
+            auto const e = waiters.epoch();
+            if (auto const stop_src = try_spawn(); stop_src != nullptr) {
+                waiters.end_wait();
+                stop_cb.reset();
+                set_value(std::move(rcvr), stop_src);
+                return;
+            }
+            if (waiters.enqueue(this, e)) {
+                // a stop request that found the queue empty left this to us
+                if (stopping.load() and waiters.dequeue(this)) {
+                    stop();
+                }
+                return;
+            }
+        }
+    }
+
+    template <stdx::same_as_unqualified<op_state> O>
+    friend constexpr auto tag_invoke(start_t, O &&o) -> void {
+        if constexpr (not unstoppable_token<stop_token_of_t<env_of_t<Rcvr>>>) {
+            auto token = get_stop_token(get_env(o.rcvr));
+            if (token.stop_requested()) {
+                set_stopped(std::forward<O>(o).rcvr);
+                return;
+            }
+            o.stop_cb.emplace(token, stop_callback_fn{std::addressof(o)});
+        }
+        detail::slot_waiters_v<Uniq>.begin_wait();
+        o.attempt();
+    }
+};
+
+template <typename Uniq, typename Sndr> struct sender {
+    using is_sender = void;
+    using completion_signatures =
+        async::completion_signatures<set_value_t(inplace_stop_source *),
+                                     set_stopped_t()>;
+
+    [[no_unique_address]] Sndr sndr;
+
+  private:
+    template <stdx::same_as_unqualified<sender> Self, receiver R>
+        requires std::copy_constructible<Sndr>
+    [[nodiscard]] friend constexpr auto tag_invoke(connect_t, Self &&self,
+                                                   R &&r)
+        -> op_state<Uniq, Sndr, std::remove_cvref_t<R>> {
+        check_connect<Self, R>();
+        return {std::forward<Self>(self).sndr, std::forward<R>(r)};
+    }
+
+    template <receiver R>
+    [[nodiscard]] friend constexpr auto tag_invoke(connect_t, sender &&self,
+                                                   R &&r)
+        -> op_state<Uniq, Sndr, std::remove_cvref_t<R>> {
+        check_connect<sender &&, R>();
+        return {std::move(self).sndr, std::forward<R>(r)};
+    }
+};
+} // namespace _spawn_when_available
+
+template <typename Uniq = decltype([] {}), sender S>
+[[nodiscard]] constexpr auto spawn_when_available(S &&s) -> sender auto {
+    using Sndr = std::remove_cvref_t<S>;
+    static_assert(
+        std::same_as<allocator_of_t<env_of_t<Sndr>>, static_allocator>,
+        "spawn_when_available waits on a static_allocator domain");
+    return _spawn_when_available::sender<Uniq, Sndr>{std::forward<S>(s)};
+}
+} // namespace async
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <async/allocator.hpp>
 #include <async/concepts.hpp>
 #include <async/env.hpp>
+#include <async/stack_allocator.hpp>
 #include <async/stop_token.hpp>
 #include <async/tags.hpp>
 #include <async/type_traits.hpp>
@@ -13,7 +15,12 @@
 #include <boost/mp11/algorithm.hpp>
 #include <boost/mp11/list.hpp>
 
+#include <array>
+#include <atomic>
 #include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <optional>
 #include <type_traits>
 #include <utility>
@@ -22,6 +29,157 @@
 namespace async {
 namespace _split {
 
+// A subscriber is completed through a table that its most derived type gives,
+// of one function for each way that the split can complete. The way it
+// completed is resolved once, when the shared operation completes; each
+// subscriber is then sent the completion with one indirect call, rather than
+// each visiting the stored completion in turn.
+struct subscriber_link {
+    using fn_t = auto (*)(subscriber_link &) -> void;
+
+    constexpr explicit(true) subscriber_link(fn_t const *fns)
+        : completions{fns} {}
+
+    auto notify(std::size_t index) -> void { completions[index](*this); }
+
+    fn_t const *completions;
+    subscriber_link *next_ops{};
+};
+
+template <typename Sub, std::size_t N>
+constexpr inline auto completion_fns =
+    []<std::size_t... Is>(std::index_sequence<Is...>) {
+        return std::array<subscriber_link::fn_t, N>{
+            [](subscriber_link &l) -> void {
+                static_cast<Sub &>(l).template complete<Is>();
+            }...};
+    }(std::make_index_sequence<N>{});
+
+struct closed_link final : subscriber_link {
+    constexpr closed_link() : subscriber_link{nullptr} {}
+};
+inline constinit closed_link closed_sentinel{};
+
+// The operations waiting on a split. Subscribing is a lock-free push. When the
+// shared operation completes, the list is closed by swapping in a sentinel, so
+// a later subscriber sees with a single acquire load that the completion is
+// already available.
+class subscriber_list {
+  public:
+    enum struct push_result { closed, first, queued };
+
+    [[nodiscard]] auto is_closed() const -> bool {
+        return head.load(std::memory_order_acquire) ==
+               std::addressof(closed_sentinel);
+    }
+
+    [[nodiscard]] auto push(subscriber_link *l) -> push_result {
+        auto h = head.load(std::memory_order_acquire);
+        do {
+            if (h == std::addressof(closed_sentinel)) {
+                return push_result::closed;
+            }
+            l->next_ops = h;
+        } while (not head.compare_exchange_weak(h, l,
+                                                std::memory_order_acq_rel,
+                                                std::memory_order_acquire));
+        return h == nullptr ? push_result::first : push_result::queued;
+    }
+
+    // Notifying an operation may end its lifetime, so the next link is read
+    // first. The index says which way the shared operation completed.
+    auto close_and_notify(std::size_t index) -> void {
+        auto l = head.exchange(std::addressof(closed_sentinel),
+                               std::memory_order_acq_rel);
+        while (l != nullptr) {
+            auto const next = l->next_ops;
+            l->notify(index);
+            l = next;
+        }
+    }
+
+    auto reset() -> void { head.store(nullptr, std::memory_order_relaxed); }
+
+  private:
+    std::atomic<subscriber_link *> head{};
+};
+
+// Where a split keeps the completion of its shared operation, to send to each
+// subscriber.
+template <typename Values, typename Errors, typename Stoppeds>
+struct completion_storage {
+    using completions_t = boost::mp11::mp_push_front<
+        boost::mp11::mp_unique<
+            boost::mp11::mp_append<Values, Errors, Stoppeds>>,
+        std::monostate>;
+
+    template <typename Holder, typename... Args>
+    auto store(Args &&...args) -> void {
+        using index = boost::mp11::mp_find<completions_t, Holder>;
+        static_assert(index::value < boost::mp11::mp_size<completions_t>::value);
+        values.template emplace<index::value>(std::forward<Args>(args)...);
+    }
+
+    auto reset() -> void { values.template emplace<0>(); }
+
+    constexpr static auto size = boost::mp11::mp_size<completions_t>::value;
+
+    [[nodiscard]] auto index() const -> std::size_t { return values.index(); }
+
+    template <std::size_t I, typename R> auto send(R &r) const -> void {
+        if constexpr (I != 0) {
+            (*std::get_if<I>(std::addressof(values)))(r);
+        }
+    }
+
+    completions_t values{};
+};
+
+// A sender that sends no values and whose only error is an error code (a bus
+// transfer, say) has its completion kept as a state byte and the code in a
+// word-sized slot.
+template <typename... Vs, detail::small_error E, typename... Ss>
+    requires(... and std::same_as<Vs, value_holder<>>)
+struct completion_storage<std::variant<Vs...>, std::variant<error_holder<E>>,
+                          std::variant<Ss...>> {
+    enum struct state : std::uint8_t { pending, value, error, stopped };
+
+    template <typename Holder, typename... Args>
+    auto store(Args &&...args) -> void {
+        using tag_t = typename Holder::tag_t;
+        if constexpr (std::same_as<tag_t, set_error_t>) {
+            error = static_cast<E>(args...);
+            st = state::error;
+        } else if constexpr (std::same_as<tag_t, set_value_t>) {
+            st = state::value;
+        } else {
+            st = state::stopped;
+        }
+    }
+
+    auto reset() -> void { st = state::pending; }
+
+    constexpr static std::size_t size = 4;
+
+    [[nodiscard]] auto index() const -> std::size_t {
+        return static_cast<std::size_t>(st);
+    }
+
+    template <std::size_t I, typename R> auto send(R &r) const -> void {
+        constexpr auto s = static_cast<state>(I);
+        if constexpr (s == state::value and sizeof...(Vs) != 0) {
+            set_value(r);
+        } else if constexpr (s == state::error) {
+            set_error(r, error);
+        } else if constexpr (s == state::stopped and sizeof...(Ss) != 0) {
+            set_stopped(r);
+        }
+    }
+
+    E error{};
+    state st{};
+};
+
 template <typename S, typename Uniq> struct op_state_base;
 
 template <typename S, typename Uniq> struct single_receiver {
@@ -30,43 +188,31 @@ template <typename S, typename Uniq> struct single_receiver {
 
     template <typename Tuple, typename... Args>
     static auto store_values(Args &&...args) -> void {
-        using index =
-            boost::mp11::mp_find<typename op_state_t::completions_t, Tuple>;
-        static_assert(
-            index::value <
-            boost::mp11::mp_size<typename op_state_t::completions_t>::value);
-        op_state_t::values.template emplace<index::value>(
-            std::forward<Args>(args)...);
+        op_state_t::values.template store<Tuple>(std::forward<Args>(args)...);
     }
 
   private:
     template <typename... Args>
     friend auto tag_invoke(set_value_t, single_receiver const &, Args &&...args)
         -> void {
-        if (op_state_t::linked_ops) {
-            using tuple_t = value_holder<Args...>;
-            store_values<tuple_t>(std::forward<Args>(args)...);
-            op_state_t::linked_ops->notify();
-        }
+        using tuple_t = value_holder<Args...>;
+        store_values<tuple_t>(std::forward<Args>(args)...);
+        op_state_t::subscribers.close_and_notify(op_state_t::values.index());
     }
 
     template <typename... Args>
     friend auto tag_invoke(set_error_t, single_receiver const &, Args &&...args)
         -> void {
-        if (op_state_t::linked_ops) {
-            using tuple_t = error_holder<Args...>;
-            store_values<tuple_t>(std::forward<Args>(args)...);
-            op_state_t::linked_ops->notify();
-        }
+        using tuple_t = error_holder<Args...>;
+        store_values<tuple_t>(std::forward<Args>(args)...);
+        op_state_t::subscribers.close_and_notify(op_state_t::values.index());
     }
 
     template <typename... Args>
     friend auto tag_invoke(set_stopped_t, single_receiver const &) -> void {
-        if (op_state_t::linked_ops) {
-            using tuple_t = stopped_holder<>;
-            store_values<tuple_t>();
-            op_state_t::linked_ops->notify();
-        }
+        using tuple_t = stopped_holder<>;
+        store_values<tuple_t>();
+        op_state_t::subscribers.close_and_notify(op_state_t::values.index());
     }
 
     [[nodiscard]] friend constexpr auto tag_invoke(get_env_t,
@@ -76,25 +222,21 @@ template <typename S, typename Uniq> struct single_receiver {
     }
 };
 
-template <typename S, typename Uniq> struct op_state_base {
-    virtual auto notify() -> void = 0;
+template <typename S, typename Uniq> struct op_state_base : subscriber_link {
+    using subscriber_link::subscriber_link;
 
     static auto reset() -> void {
         single_ops.reset();
-        values.template emplace<0>();
-        linked_ops = nullptr;
+        values.reset();
+        subscribers.reset();
     }
 
     using E = env_of_t<single_receiver<S, Uniq>>;
     using values_t = value_types_of_t<S, E, value_holder, std::variant>;
     using errors_t = error_types_of_t<S, E, error_holder, std::variant>;
     using stoppeds_t = stopped_types_of_t<S, E, stopped_holder, std::variant>;
-    using completions_t = boost::mp11::mp_push_front<
-        boost::mp11::mp_unique<
-            boost::mp11::mp_append<values_t, errors_t, stoppeds_t>>,
-        std::monostate>;
-    static inline completions_t values{};
-    static inline op_state_base *linked_ops{};
+    static inline completion_storage<values_t, errors_t, stoppeds_t> values{};
+    static inline subscriber_list subscribers{};
     static inline inplace_stop_source stop_source{};
 
     using single_op_state_t = connect_result_t<S &&, single_receiver<S, Uniq>>;
@@ -116,32 +258,24 @@ struct op_state : op_state_base<S, Uniq> {
 
     template <stdx::same_as_unqualified<Rcvr> R>
     // NOLINTNEXTLINE(bugprone-forwarding-reference-overload)
-    constexpr explicit(true) op_state(R &&r) : rcvr{std::forward<R>(r)} {}
+    constexpr explicit(true) op_state(R &&r)
+        : op_state_t{
+              completion_fns<op_state, decltype(op_state_t::values)::size>
+                  .data()},
+          rcvr{std::forward<R>(r)} {}
     constexpr op_state(op_state &&) = delete;
 
-    auto notify() -> void final {
-        complete();
-        if (next_ops) {
-            next_ops->notify();
-        }
+    template <std::size_t I> auto complete() -> void {
+        stop_cb.reset();
+        op_state_t::values.template send<I>(rcvr);
     }
 
   private:
-    auto complete() -> void {
-        stop_cb.reset();
-        std::visit(
-            [&]<typename T>(T const &t) -> void {
-                if constexpr (not std::is_same_v<T, std::monostate>) {
-                    t(rcvr);
-                }
-            },
-            op_state_t::values);
-    }
 
     template <stdx::same_as_unqualified<op_state> O>
     friend constexpr auto tag_invoke(start_t, O &&o) -> void {
-        if (op_state_t::values.index() != 0) {
-            std::forward<O>(o).complete();
+        if (op_state_t::subscribers.is_closed()) {
+            o.notify(op_state_t::values.index());
             return;
         }
 
@@ -153,19 +287,23 @@ struct op_state : op_state_base<S, Uniq> {
             return;
         }
 
-        if (o.next_ops =
-                std::exchange(op_state_t::linked_ops, std::addressof(o));
-            not o.next_ops) {
+        switch (op_state_t::subscribers.push(std::addressof(o))) {
+        case subscriber_list::push_result::closed:
+            o.notify(op_state_t::values.index());
+            break;
+        case subscriber_list::push_result::first:
             start(std::move(*op_state_t::single_ops));
+            break;
+        case subscriber_list::push_result::queued:
+            break;
         }
     }
 
-    using stop_callback_t =
-        stop_callback_for_t<stop_token_of_t<env_of_t<Rcvr>>, stop_callback_fn>;
+    using stop_callback_t = optional_stop_callback_t<
+        stop_token_of_t<env_of_t<Rcvr>>, stop_callback_fn>;
 
     [[no_unique_address]] Rcvr rcvr;
-    op_state_t *next_ops{};
-    std::optional<stop_callback_t> stop_cb{};
+    [[no_unique_address]] stop_callback_t stop_cb{};
 };
 
 template <typename Sndr, typename Uniq> struct sender {
@@ -228,6 +366,246 @@ template <typename Uniq> struct pipeable {
         return std::forward<S>(s);
     }
 };
+
+// The allocated variant keeps its shared state in memory obtained from the
+// sender's allocator rather than in static storage. The state is reference
+// counted by the senders and operation states that refer to it, and is
+// released when the last of them goes away.
+template <typename S, typename Uniq, typename Alloc> struct shared_state;
+
+template <typename S, typename Uniq, typename Alloc> struct shared_receiver {
+    using is_receiver = void;
+    using state_t = shared_state<S, Uniq, Alloc>;
+
+    state_t *state;
+
+  private:
+    template <typename... Args>
+    friend auto tag_invoke(set_value_t, shared_receiver const &r,
+                           Args &&...args) -> void {
+        r.state->template complete<value_holder<Args...>>(
+            std::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    friend auto tag_invoke(set_error_t, shared_receiver const &r,
+                           Args &&...args) -> void {
+        r.state->template complete<error_holder<Args...>>(
+            std::forward<Args>(args)...);
+    }
+
+    friend auto tag_invoke(set_stopped_t, shared_receiver const &r) -> void {
+        r.state->template complete<stopped_holder<>>();
+    }
+
+    [[nodiscard]] friend constexpr auto tag_invoke(get_env_t,
+                                                   shared_receiver const &r)
+        -> detail::singleton_env<get_stop_token_t, inplace_stop_token> {
+        return {r.state->stop_source.get_token()};
+    }
+};
+
+template <typename S, typename Uniq, typename Alloc>
+// NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+struct shared_state {
+    using receiver_t = shared_receiver<S, Uniq, Alloc>;
+    using E = env_of_t<receiver_t>;
+    using values_t = value_types_of_t<S, E, value_holder, std::variant>;
+    using errors_t = error_types_of_t<S, E, error_holder, std::variant>;
+    using stoppeds_t = stopped_types_of_t<S, E, stopped_holder, std::variant>;
+    using single_op_state_t = connect_result_t<S &&, receiver_t>;
+
+    template <typename T>
+    // NOLINTNEXTLINE(bugprone-forwarding-reference-overload)
+    constexpr explicit(true) shared_state(T &&t)
+        : single_ops{connect(std::forward<T>(t), receiver_t{this})} {}
+    constexpr shared_state(shared_state &&) = delete;
+
+    auto acquire() -> void { refs.fetch_add(1, std::memory_order_relaxed); }
+    auto release() -> void {
+        if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            Alloc::template destruct<Uniq>(this);
+        }
+    }
+
+    // the running single operation holds a reference until it completes
+    auto start_single() -> void {
+        acquire();
+        start(std::move(single_ops));
+    }
+
+    template <typename Tuple, typename... Args>
+    auto complete(Args &&...args) -> void {
+        values.template store<Tuple>(std::forward<Args>(args)...);
+        subscribers.close_and_notify(values.index());
+        release();
+    }
+
+    completion_storage<values_t, errors_t, stoppeds_t> values{};
+    subscriber_list subscribers{};
+    inplace_stop_source stop_source{};
+    single_op_state_t single_ops;
+    std::atomic<std::size_t> refs{1};
+};
+
+template <typename S, typename Rcvr, typename Uniq, typename Alloc>
+// NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+struct shared_op_state final : subscriber_link {
+    using state_t = shared_state<S, Uniq, Alloc>;
+
+    struct stop_callback_fn {
+        auto operator()() -> void { stop_source->request_stop(); }
+        inplace_stop_source *stop_source;
+    };
+
+    template <stdx::same_as_unqualified<Rcvr> R>
+    constexpr shared_op_state(state_t *s, R &&r)
+        : subscriber_link{completion_fns<shared_op_state,
+                                         decltype(state_t::values)::size>
+                              .data()},
+          state{s}, rcvr{std::forward<R>(r)} {
+        if (state != nullptr) {
+            state->acquire();
+        }
+    }
+    constexpr shared_op_state(shared_op_state &&) = delete;
+    ~shared_op_state() {
+        if (state != nullptr) {
+            state->release();
+        }
+    }
+
+    template <std::size_t I> auto complete() -> void {
+        stop_cb.reset();
+        state->values.template send<I>(rcvr);
+    }
+
+  private:
+
+    template <stdx::same_as_unqualified<shared_op_state> O>
+    friend constexpr auto tag_invoke(start_t, O &&o) -> void {
+        if (o.state == nullptr) {
+            set_stopped(std::forward<O>(o).rcvr);
+            return;
+        }
+        if (o.state->subscribers.is_closed()) {
+            o.notify(o.state->values.index());
+            return;
+        }
+
+        std::forward<O>(o).stop_cb.emplace(
+            get_stop_token(get_env(o.rcvr)),
+            stop_callback_fn{std::addressof(o.state->stop_source)});
+        if (o.state->stop_source.stop_requested()) {
+            set_stopped(std::forward<O>(o).rcvr);
+            return;
+        }
+
+        switch (o.state->subscribers.push(std::addressof(o))) {
+        case subscriber_list::push_result::closed:
+            o.notify(o.state->values.index());
+            break;
+        case subscriber_list::push_result::first:
+            o.state->start_single();
+            break;
+        case subscriber_list::push_result::queued:
+            break;
+        }
+    }
+
+    using stop_callback_t = optional_stop_callback_t<
+        stop_token_of_t<env_of_t<Rcvr>>, stop_callback_fn>;
+
+    state_t *state;
+    [[no_unique_address]] Rcvr rcvr;
+    [[no_unique_address]] stop_callback_t stop_cb{};
+};
+
+template <typename Sndr, typename Uniq, typename Alloc> struct shared_sender {
+    using is_sender = void;
+    using state_t = shared_state<Sndr, Uniq, Alloc>;
+    using env_t = env_of_t<Sndr>;
+
+    constexpr shared_sender(state_t *s, env_t const &e) : state{s}, env{e} {}
+    constexpr shared_sender(shared_sender const &other)
+        : state{other.state}, env{other.env} {
+        if (state != nullptr) {
+            state->acquire();
+        }
+    }
+    constexpr shared_sender(shared_sender &&other) noexcept
+        : state{std::exchange(other.state, nullptr)},
+          env{std::move(other.env)} {}
+    constexpr auto operator=(shared_sender other) noexcept -> shared_sender & {
+        std::swap(state, other.state);
+        std::swap(env, other.env);
+        return *this;
+    }
+    ~shared_sender() {
+        if (state != nullptr) {
+            state->release();
+        }
+    }
+
+    [[nodiscard]] friend constexpr auto tag_invoke(async::get_env_t,
+                                                   shared_sender const &self)
+        -> env_t const & {
+        return self.env;
+    }
+
+  private:
+    state_t *state;
+    [[no_unique_address]] env_t env;
+
+    template <typename Env>
+    [[nodiscard]] friend constexpr auto tag_invoke(get_completion_signatures_t,
+                                                   shared_sender const &,
+                                                   Env const &)
+        -> transform_completion_signatures_of<
+            Sndr, Env, completion_signatures<set_stopped_t()>> {
+        return {};
+    }
+
+    template <stdx::same_as_unqualified<shared_sender> Self, receiver R>
+    [[nodiscard]] friend constexpr auto tag_invoke(connect_t, Self &&self,
+                                                   R &&r)
+        -> shared_op_state<Sndr, std::remove_cvref_t<R>, Uniq, Alloc> {
+        check_connect<Self, R>();
+        return {self.state, std::forward<R>(r)};
+    }
+};
+
+// Allocating on the stack cannot outlive the pipe expression, so senders
+// whose attributes ask for the stack allocator get static storage instead.
+template <typename S>
+using shared_allocator_t =
+    stdx::conditional_t<std::is_same_v<allocator_of_t<env_of_t<S>>,
+                                       stack_allocator>,
+                        static_allocator, allocator_of_t<env_of_t<S>>>;
+
+template <typename Uniq> struct allocated_pipeable {
+  private:
+    template <singleshot_sender S>
+        requires(not std::is_reference_v<S>)
+    friend constexpr auto operator|(S &&s, allocated_pipeable)
+        -> async::sender auto {
+        using sender_t = std::remove_cvref_t<S>;
+        using alloc_t = shared_allocator_t<sender_t>;
+        using state_t = shared_state<sender_t, Uniq, alloc_t>;
+        auto e = get_env(s);
+        state_t *state{};
+        alloc_t::template construct<Uniq, state_t>(
+            [&](state_t &&st) { state = std::addressof(st); },
+            std::forward<S>(s));
+        return shared_sender<sender_t, Uniq, alloc_t>{state, e};
+    }
+
+    template <multishot_sender S>
+    friend constexpr auto operator|(S &&s, allocated_pipeable)
+        -> async::sender auto {
+        return std::forward<S>(s);
+    }
+};
 } // namespace _split
 
 template <typename Uniq = decltype([] {})>
@@ -239,4 +617,15 @@ template <sender S, typename Uniq = decltype([] {})>
 [[nodiscard]] constexpr auto split(S &&s) -> sender auto {
     return std::forward<S>(s) | split<Uniq>();
 }
+
+template <typename Uniq = decltype([] {})>
+[[nodiscard]] constexpr auto split_allocated()
+    -> _split::allocated_pipeable<Uniq> {
+    return {};
+}
+
+template <sender S, typename Uniq = decltype([] {})>
+[[nodiscard]] constexpr auto split_allocated(S &&s) -> sender auto {
+    return std::forward<S>(s) | split_allocated<Uniq>();
+}
 } // namespace async
@@ -5,11 +5,17 @@
 #include <async/env.hpp>
 #include <async/stop_token.hpp>
 #include <async/tags.hpp>
+#include <async/trace.hpp>
+#include <conc/concurrency.hpp>
 
 #include <stdx/concepts.hpp>
+#include <stdx/functional.hpp>
 #include <stdx/optional.hpp>
 
 #include <concepts>
+#include <cstdint>
+#include <memory>
+#include <optional>
 #include <type_traits>
 #include <utility>
 
@@ -21,8 +27,9 @@ template <typename Ops> struct receiver {
     Ops *ops;
 
   private:
-    friend auto tag_invoke(channel_tag auto, receiver const &r, auto &&...)
-        -> void {
+    template <channel_tag Tag>
+    friend auto tag_invoke(Tag, receiver const &r, auto &&...) -> void {
+        r.ops->template trace<Tag>();
         r.ops->die();
     }
 
@@ -41,20 +48,28 @@ struct op_state {
     using receiver_t = receiver<op_state>;
     using stop_source_t = StopSource;
     using Ops = connect_result_t<Sndr, receiver_t>;
+    using tracer_t = tracer_of_t<env_of_t<Sndr>>;
 
     template <typename S>
     constexpr explicit(true) op_state(S &&s)
-        : ops{connect(std::forward<S>(s), receiver<op_state>{this})} {}
+        : tracer{get_tracer(get_env(s))},
+          ops{connect(std::forward<S>(s), receiver<op_state>{this})} {}
     constexpr op_state(op_state &&) = delete;
 
     auto die() { Alloc::template destruct<Uniq>(this); }
 
+    template <typename Event> auto trace() const -> void {
+        detail::trace_with<trace_kind::start_detached, Event>(tracer, this);
+    }
+
     [[no_unique_address]] stop_source_t stop_src;
+    [[no_unique_address]] tracer_t tracer;
     Ops ops;
 
   private:
     template <stdx::same_as_unqualified<op_state> O>
     friend constexpr auto tag_invoke(start_t, O &&o) -> void {
+        o.template trace<start_t>();
         start(std::forward<O>(o).ops);
     }
 };
@@ -74,6 +89,147 @@ template <typename Uniq, typename StopSource, sender S>
     return stop_src;
 }
 
+// The operation state for a recycling call site lives in static storage for
+// the life of the program. Relaunching it reconnects the sender in place,
+// without going through an allocator. (The op state is connected again rather
+// than only restarted, because each launch may pass a different sender.) A
+// launch while the operation is running queues a single restart with the
+// sender it passed, which happens when the running operation completes.
+//
+// Restarts are run by a loop around connect and start, never from inside a
+// completion: a completion that finds the loop running (because the operation
+// completed synchronously) only records that a restart is due, and the loop
+// reconnects once start has returned. A completion that finds no loop running
+// (because the operation completed later, elsewhere) runs the loop itself, in
+// the way that a completion may destroy its detached operation state.
+//
+// The stop source is never recreated, because callers keep the pointer that
+// a launch returned. A stop request applies to the run in progress, and the
+// source is reset before each run.
+template <typename Uniq, typename Sndr, typename StopSource>
+struct recycling_op_state {
+    using receiver_t = receiver<recycling_op_state>;
+    using stop_source_t = StopSource;
+    using Ops = connect_result_t<Sndr &, receiver_t>;
+
+    struct mutex;
+    enum struct state_t : std::uint8_t { idle, running, restart_pending };
+
+    template <typename S> auto launch(S &&s) -> stdx::optional<StopSource *> {
+        auto const [prev, run_here] = conc::call_in_critical_section<mutex>(
+            [&]() -> std::pair<state_t, bool> {
+                auto const p = state;
+                if (p == state_t::restart_pending) {
+                    return {p, false};
+                }
+                if (p == state_t::running) {
+                    next.emplace(std::forward<S>(s));
+                    state = state_t::restart_pending;
+                    return {p, false};
+                }
+                state = state_t::running;
+                if (looping) {
+                    next.emplace(std::forward<S>(s));
+                    restart_due = true;
+                    return {p, false};
+                }
+                ops.reset();
+                sndr.emplace(std::forward<S>(s));
+                looping = true;
+                return {p, true};
+            });
+        if (run_here) {
+            run();
+        }
+        if (prev == state_t::restart_pending) {
+            return {};
+        }
+        return std::addressof(stop_src);
+    }
+
+    auto die() -> void {
+        auto const run_here = conc::call_in_critical_section<mutex>([&] {
+            if (state != state_t::restart_pending) {
+                state = state_t::idle;
+                return false;
+            }
+            state = state_t::running;
+            if (looping) {
+                restart_due = true;
+                return false;
+            }
+            ops.reset();
+            take_next();
+            looping = true;
+            return true;
+        });
+        if (run_here) {
+            run();
+        }
+    }
+
+    template <typename Event> auto trace() const -> void {
+        detail::trace<trace_kind::start_detached, Event>(*sndr, this);
+    }
+
+    [[no_unique_address]] stop_source_t stop_src;
+
+  private:
+    auto take_next() -> void {
+        sndr.emplace(std::move(*next));
+        next.reset();
+    }
+
+    auto run() -> void {
+        do {
+            stop_src.reset();
+            auto &op = ops.emplace(stdx::with_result_of{
+                [&] { return connect(*sndr, receiver_t{this}); }});
+            trace<start_t>();
+            async::start(op);
+        } while (conc::call_in_critical_section<mutex>([&] {
+            if (not restart_due) {
+                looping = false;
+                return false;
+            }
+            restart_due = false;
+            ops.reset();
+            take_next();
+            return true;
+        }));
+    }
+
+    std::optional<Sndr> sndr{};
+    std::optional<Sndr> next{};
+    std::optional<Ops> ops{};
+    state_t state{};
+    bool looping{};
+    bool restart_due{};
+};
+
+template <typename Uniq, typename Sndr, typename StopSource>
+inline auto recycling_op_state_v =
+    recycling_op_state<Uniq, Sndr, StopSource>{};
+
+template <typename Uniq, typename StopSource, sender S>
+[[nodiscard]] auto start_recycling(S &&s) -> stdx::optional<StopSource *> {
+    using Sndr = std::remove_cvref_t<S>;
+    static_assert(multishot_sender<Sndr>,
+                  "start_detached_recycling needs a sender that can be "
+                  "connected more than once");
+    return recycling_op_state_v<Uniq, Sndr, StopSource>.launch(
+        std::forward<S>(s));
+}
+
+template <typename Uniq, typename StopSource> struct recycling_pipeable {
+  private:
+    template <async::sender S,
+              stdx::same_as_unqualified<recycling_pipeable> Self>
+    [[nodiscard]] friend auto operator|(S &&s, Self &&) {
+        return start_recycling<Uniq, StopSource>(std::forward<S>(s));
+    }
+};
+
 template <typename Uniq, typename StopSource> struct pipeable {
   private:
     template <async::sender S, stdx::same_as_unqualified<pipeable> Self>
@@ -104,4 +260,15 @@ template <typename Uniq = decltype([] {}), sender S>
 [[nodiscard]] auto start_detached_unstoppable(S &&s) {
     return std::forward<S>(s) | start_detached_unstoppable<Uniq>();
 }
+
+template <typename Uniq = decltype([] {})>
+[[nodiscard]] constexpr auto start_detached_recycling()
+    -> _start_detached::recycling_pipeable<Uniq, inplace_stop_source> {
+    return {};
+}
+
+template <typename Uniq = decltype([] {}), sender S>
+[[nodiscard]] auto start_detached_recycling(S &&s) {
+    return std::forward<S>(s) | start_detached_recycling<Uniq>();
+}
 } // namespace async
@@ -1,13 +1,136 @@
 #pragma once
 
 #include <async/concepts.hpp>
-#include <async/sequence.hpp>
+#include <async/env.hpp>
+#include <async/tags.hpp>
+#include <async/type_traits.hpp>
 
+#include <stdx/concepts.hpp>
+#include <stdx/functional.hpp>
+
+#include <boost/mp11/algorithm.hpp>
+
+#include <concepts>
+#include <type_traits>
 #include <utility>
+#include <variant>
 
 namespace async {
+namespace _start_on {
+template <typename Ops, typename Rcvr> struct receiver {
+    using is_receiver = void;
+
+    Ops *ops;
+
+  private:
+    friend auto tag_invoke(set_value_t, receiver const &self, auto &&...)
+        -> void {
+        self.ops->start_child();
+    }
+
+    template <channel_tag Tag, typename... Args>
+    friend auto tag_invoke(Tag, receiver const &self, Args &&...args) -> void {
+        Tag{}(self.ops->rcvr, std::forward<Args>(args)...);
+    }
+
+    [[nodiscard]] friend constexpr auto tag_invoke(async::get_env_t,
+                                                   receiver const &r)
+        -> ::async::detail::forwarding_env<env_of_t<Rcvr>> {
+        return forward_env_of(r.ops->rcvr);
+    }
+};
+
+template <typename SchedSndr, typename S, typename Rcvr>
+// NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+struct op_state {
+    using sched_rcvr = receiver<op_state, Rcvr>;
+
+    // Until the scheduler completes, the child sender waits beside the
+    // schedule operation. Then the child operation takes their place, connected
+    // straight to the downstream receiver, so the op state is only as big as
+    // the larger of the two stages.
+    struct scheduling {
+        [[no_unique_address]] S sndr;
+        connect_result_t<SchedSndr, sched_rcvr> ops;
+    };
+    using child_ops = connect_result_t<S, Rcvr>;
+
+    template <typename Sc, typename Sn, typename R>
+    constexpr op_state(Sc &&sc, Sn &&sn, R &&r)
+        : rcvr{std::forward<R>(r)},
+          state{std::in_place_index<0>, stdx::with_result_of{[&] {
+                    return scheduling{
+                        std::forward<Sn>(sn),
+                        connect(std::forward<Sc>(sc), sched_rcvr{this})};
+                }}} {}
+    constexpr op_state(op_state &&) = delete;
+
+    auto start_child() -> void {
+        auto sndr = std::move(std::get<0>(state).sndr);
+        auto &op = state.template emplace<1>(stdx::with_result_of{
+            [&] { return connect(std::move(sndr), std::move(rcvr)); }});
+        start(std::move(op));
+    }
+
+    [[no_unique_address]] Rcvr rcvr;
+    std::variant<scheduling, child_ops> state;
+
+  private:
+    template <stdx::same_as_unqualified<op_state> O>
+    friend constexpr auto tag_invoke(start_t, O &&o) -> void {
+        start(std::get<0>(std::forward<O>(o).state).ops);
+    }
+};
+
+template <typename SchedSndr, typename S> struct sender {
+    using is_sender = void;
+
+    [[no_unique_address]] SchedSndr sched;
+    [[no_unique_address]] S s;
+
+  private:
+    template <async::receiver R>
+    [[nodiscard]] friend constexpr auto tag_invoke(connect_t, sender &&self,
+                                                   R &&r)
+        -> op_state<SchedSndr, S, std::remove_cvref_t<R>> {
+        check_connect<sender &&, R>();
+        return {std::move(self).sched, std::move(self).s, std::forward<R>(r)};
+    }
+
+    template <stdx::same_as_unqualified<sender> Self, async::receiver R>
+        requires multishot_sender<SchedSndr> and
+                 std::copy_constructible<SchedSndr> and
+                 std::copy_constructible<S>
+    [[nodiscard]] friend constexpr auto tag_invoke(connect_t, Self &&self,
+                                                   R &&r)
+        -> op_state<SchedSndr, S, std::remove_cvref_t<R>> {
+        check_connect<Self, R>();
+        return {std::forward<Self>(self).sched, std::forward<Self>(self).s,
+                std::forward<R>(r)};
+    }
+
+    template <typename Env>
+    [[nodiscard]] friend constexpr auto tag_invoke(get_completion_signatures_t,
+                                                   sender const &, Env const &)
+        -> boost::mp11::mp_unique<boost::mp11::mp_append<
+            error_signatures_of_t<SchedSndr, Env>,
+            stopped_signatures_of_t<SchedSndr, Env>,
+            completion_signatures_of_t<S, Env>>> {
+        return {};
+    }
+
+    [[nodiscard]] friend constexpr auto tag_invoke(async::get_env_t,
+                                                   sender const &self) {
+        return forward_env_of(self.s);
+    }
+};
+} // namespace _start_on
+
 template <scheduler Sched, sender S>
 [[nodiscard]] constexpr auto start_on(Sched &&sched, S &&s) -> sender auto {
-    return std::forward<Sched>(sched).schedule() | seq(std::forward<S>(s));
+    return _start_on::sender<
+        std::remove_cvref_t<decltype(std::forward<Sched>(sched).schedule())>,
+        std::remove_cvref_t<S>>{std::forward<Sched>(sched).schedule(),
+                                std::forward<S>(s)};
 }
 } // namespace async
@@ -1,17 +1,27 @@
 #pragma once
 
+#include <conc/concurrency.hpp>
 #include <stdx/bit.hpp>
-#include <stdx/bitset.hpp>
+#include <stdx/intrusive_list.hpp>
 
 #include <array>
+#include <atomic>
+#include <bit>
 #include <cstddef>
+#include <cstdint>
 #include <iterator>
+#include <limits>
 #include <memory>
 #include <type_traits>
 #include <utility>
 
 namespace async {
 namespace detail {
+// Slots are claimed and released with atomic operations on the words of the
+// used bitmap, so construct and destruct need no critical section and may be
+// called concurrently (for instance, from several ISRs). A claim starts at the
+// word that most recently had a slot claimed or released, so with a large N
+// it does not usually scan the whole bitmap.
 template <typename Name, typename T, std::size_t N> struct static_allocator_t {
     constexpr static inline auto alignment = alignof(T);
     constexpr static inline auto size = sizeof(T);
@@ -19,17 +29,22 @@ template <typename Name, typename T, std::size_t N> struct static_allocator_t {
         size % alignment == 0 ? size : size + alignment - (size % alignment);
 
     using storage_t = std::array<std::byte, aligned_size * N>;
+    using word_t = std::uint32_t;
+    constexpr static inline auto word_bits =
+        std::numeric_limits<word_t>::digits;
+    constexpr static inline auto num_words = (N + word_bits - 1) / word_bits;
 
     alignas(alignment) storage_t data{};
-    stdx::bitset<N> used{};
+    std::array<std::atomic<word_t>, num_words> used{};
+    // the word where the next claim starts looking for a free slot
+    std::atomic<std::size_t> hint{};
 
     template <typename... Args> auto construct(Args &&...args) -> T * {
-        auto const idx = used.lowest_unset();
+        auto const idx = claim();
         if (idx == N) {
             return nullptr;
         }
         auto const ptr = std::data(data) + idx * aligned_size;
-        used.set(idx);
         return std::construct_at(stdx::bit_cast<T *>(ptr),
                                  std::forward<Args>(args)...);
     }
@@ -37,9 +52,56 @@ template <typename Name, typename T, std::size_t N> struct static_allocator_t {
     auto destruct(T const *t) -> void {
         std::destroy_at(t);
         auto const ptr = stdx::bit_cast<std::byte *>(t);
-        auto const idx =
-            static_cast<std::size_t>(ptr - std::data(data)) / aligned_size;
-        used.reset(idx);
+        auto const idx = index_of(ptr - std::data(data));
+        used[idx / word_bits].fetch_and(~bit(idx % word_bits),
+                                        std::memory_order_release);
+        if constexpr (num_words > 1) {
+            hint.store(idx / word_bits, std::memory_order_relaxed);
+        }
+    }
+
+  private:
+    constexpr static auto bit(std::size_t b) -> word_t {
+        return static_cast<word_t>(word_t{1} << b);
+    }
+
+    // bits past N in the last word are never available
+    constexpr static auto unavailable(std::size_t w) -> word_t {
+        auto const first = N - w * word_bits;
+        return first >= word_bits ? word_t{}
+                                  : static_cast<word_t>(~(bit(first) - 1u));
+    }
+
+    auto claim() -> std::size_t {
+        auto const start = hint.load(std::memory_order_relaxed);
+        for (auto i = std::size_t{}; i < num_words; ++i) {
+            auto const w = start + i < num_words ? start + i
+                                                 : start + i - num_words;
+            auto word = used[w].load(std::memory_order_relaxed);
+            while (auto const free = static_cast<word_t>(
+                       ~(word | unavailable(w)))) {
+                auto const b = static_cast<std::size_t>(std::countr_zero(free));
+                if (used[w].compare_exchange_weak(word, word | bit(b),
+                                                  std::memory_order_acquire,
+                                                  std::memory_order_relaxed)) {
+                    if (w != start) {
+                        hint.store(w, std::memory_order_relaxed);
+                    }
+                    return w * word_bits + b;
+                }
+            }
+        }
+        return N;
+    }
+
+    [[nodiscard]] constexpr static auto index_of(std::ptrdiff_t offset)
+        -> std::size_t {
+        auto const o = static_cast<std::size_t>(offset);
+        if constexpr (std::has_single_bit(aligned_size)) {
+            return o >> std::countr_zero(aligned_size);
+        } else {
+            return o / aligned_size;
+        }
     }
 };
 template <typename Name, typename T, std::size_t N>
@@ -49,6 +111,138 @@ inline auto static_allocator_v = static_allocator_t<Name, T, N>{};
 template <typename Name>
 constexpr inline auto static_allocation_limit = std::size_t{1};
 
+// Specialize this to true to keep allocation statistics for a domain. When it
+// is false (the default), no counters exist and nothing is recorded.
+template <typename Name>
+constexpr inline auto static_allocation_stats_enabled = false;
+
+struct allocation_stats {
+    std::size_t current{};
+    std::size_t peak{};
+    std::size_t failed{};
+};
+
+namespace detail {
+struct allocation_counters {
+    std::atomic<std::size_t> current{};
+    std::atomic<std::size_t> peak{};
+    std::atomic<std::size_t> failed{};
+
+    auto allocated() -> void {
+        auto const n = current.fetch_add(1, std::memory_order_relaxed) + 1;
+        auto p = peak.load(std::memory_order_relaxed);
+        while (p < n and not peak.compare_exchange_weak(
+                             p, n, std::memory_order_relaxed)) {
+        }
+    }
+    auto deallocated() -> void {
+        current.fetch_sub(1, std::memory_order_relaxed);
+    }
+    auto failed_allocation() -> void {
+        failed.fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+template <typename Name>
+    requires static_allocation_stats_enabled<Name>
+inline auto allocation_counters_v = allocation_counters{};
+} // namespace detail
+
+namespace detail {
+// NOLINTNEXTLINE(cppcoreguidelines-virtual-class-destructor)
+struct slot_waiter {
+    virtual auto retry() -> void = 0;
+
+    slot_waiter *prev{};
+    slot_waiter *next{};
+    // changed only inside the waiters' critical section
+    bool linked{};
+};
+
+// Operations waiting for a slot in an allocation domain. A waiter registers
+// (begin_wait) before it first tries to claim a slot, and only queues itself
+// if no slot was released since it last looked. So a release either lets the
+// waiter's own claim succeed or finds it in the queue. While nobody waits,
+// a release costs a fence and a load of the waiting count.
+struct slot_waiters {
+    struct mutex;
+
+    auto begin_wait() -> void {
+        waiting.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+    auto end_wait() -> void {
+        waiting.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] auto epoch() const -> std::size_t {
+        return releases.load(std::memory_order_acquire);
+    }
+
+    auto enqueue(slot_waiter *w, std::size_t e) -> bool {
+        return conc::call_in_critical_section<mutex>([&] {
+            if (releases.load(std::memory_order_relaxed) != e) {
+                return false;
+            }
+            queue.push_back(w);
+            w->linked = true;
+            return true;
+        });
+    }
+
+    // Removes a waiter that gave up. Returns false if it was not queued (for
+    // instance, because notify has just taken it to retry).
+    auto dequeue(slot_waiter *w) -> bool {
+        return conc::call_in_critical_section<mutex>([&] {
+            if (not w->linked) {
+                return false;
+            }
+            queue.remove(w);
+            w->prev = w->next = nullptr;
+            w->linked = false;
+            return true;
+        });
+    }
+
+    auto notify() -> void {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiting.load(std::memory_order_relaxed) == 0) {
+            return;
+        }
+        auto const w = conc::call_in_critical_section<mutex>(
+            [&]() -> slot_waiter * {
+                releases.fetch_add(1, std::memory_order_release);
+                if (queue.empty()) {
+                    return nullptr;
+                }
+                auto next = queue.pop_front();
+                next->prev = next->next = nullptr;
+                next->linked = false;
+                return next;
+            });
+        if (w != nullptr) {
+            w->retry();
+        }
+    }
+
+  private:
+    std::atomic<std::size_t> waiting{};
+    std::atomic<std::size_t> releases{};
+    stdx::intrusive_list<slot_waiter> queue{};
+};
+
+template <typename Name> inline auto slot_waiters_v = slot_waiters{};
+} // namespace detail
+
+template <typename Name>
+    requires static_allocation_stats_enabled<Name>
+[[nodiscard]] auto static_allocation_stats() -> allocation_stats {
+    auto const &c = detail::allocation_counters_v<Name>;
+    return {c.current.load(std::memory_order_relaxed),
+            c.peak.load(std::memory_order_relaxed),
+            c.failed.load(std::memory_order_relaxed)};
+}
+
 struct static_allocator {
     template <typename Name, typename T, typename F, typename... Args>
         requires std::is_constructible_v<T, Args...>
@@ -56,9 +250,15 @@ struct static_allocator {
         auto &a =
             detail::static_allocator_v<Name, T, static_allocation_limit<Name>>;
         if (auto t = a.construct(std::forward<Args>(args)...); t != nullptr) {
+            if constexpr (static_allocation_stats_enabled<Name>) {
+                detail::allocation_counters_v<Name>.allocated();
+            }
             std::forward<F>(f)(std::move(*t));
             return true;
         }
+        if constexpr (static_allocation_stats_enabled<Name>) {
+            detail::allocation_counters_v<Name>.failed_allocation();
+        }
         return false;
     }
 
@@ -66,7 +266,11 @@ struct static_allocator {
     static auto destruct(T const *t) -> void {
         auto &a =
             detail::static_allocator_v<Name, T, static_allocation_limit<Name>>;
+        if constexpr (static_allocation_stats_enabled<Name>) {
+            detail::allocation_counters_v<Name>.deallocated();
+        }
         a.destruct(t);
+        detail::slot_waiters_v<Name>.notify();
     }
 };
 } // namespace async
@@ -6,10 +6,21 @@
 #include <stdx/intrusive_list.hpp>
 
 #include <atomic>
+#include <cassert>
 #include <concepts>
+#include <cstdint>
+#include <memory>
+#include <optional>
 #include <type_traits>
 #include <utility>
 
+#if __has_include(<thread>)
+#include <thread>
+#define ASYNC_HAS_THREADS 1
+#else
+#define ASYNC_HAS_THREADS 0
+#endif
+
 namespace async {
 template <class T, class CB>
 using stop_callback_for_t = typename T::template callback_type<CB>;
@@ -41,7 +52,8 @@ struct inplace_stop_source;
 template <typename F> struct inplace_stop_callback;
 
 template <typename Source> struct stop_token {
-    template <class T> using callback_type = inplace_stop_callback<T>;
+    template <class T>
+    using callback_type = typename Source::template callback_type<T>;
 
     [[nodiscard]] auto stop_requested() const noexcept -> bool {
         return source != nullptr and source->stop_requested();
@@ -62,15 +74,25 @@ template <typename Source> struct stop_token {
 struct stop_callback_base {
     virtual auto run() -> void = 0;
 
+    // unlinked: not in a list (never registered, or already run or removed)
+    // linked: in its source's list of registered callbacks
+    // pending: taken from that list by request_stop, and not yet run
+    // abandoned: pending, and its owner on another thread is unregistering it
+    enum struct phase_t : std::uint8_t { unlinked, linked, pending, abandoned };
+
     stop_callback_base *prev{};
     stop_callback_base *next{};
+    // changed from linked or to pending only inside the source's critical
+    // section, but read outside it to skip that section
+    std::atomic<phase_t> phase{};
 };
 
 struct inplace_stop_source {
     struct mutex;
+    template <typename F> using callback_type = inplace_stop_callback<F>;
 
     [[nodiscard]] auto stop_requested() const noexcept -> bool {
-        return requested.load();
+        return (state.load(std::memory_order_acquire) & requested) != 0;
     }
     [[nodiscard]] constexpr static auto stop_possible() noexcept -> bool {
         return true;
@@ -81,47 +103,291 @@ struct inplace_stop_source {
         return {this};
     }
 
+    // The critical section guards only the list of registered callbacks.
+    // Registering after stop was requested, and unregistering a callback that
+    // already ran (or was never registered) need no critical section.
     auto request_stop() -> bool {
-        if (not requested.exchange(true)) {
-            auto get_next_cb = [&] {
-                return conc::call_in_critical_section<mutex>(
-                    [&]() -> stop_callback_base * {
-                        if (callbacks.empty()) {
-                            return nullptr;
-                        }
-                        auto cb = callbacks.pop_front();
-                        cb->prev = cb->next = nullptr;
-                        return cb;
-                    });
-            };
-            for (auto cb = get_next_cb(); cb != nullptr; cb = get_next_cb()) {
-                cb->run();
+        auto const prev = state.fetch_or(requested, std::memory_order_acq_rel);
+        if ((prev & requested) != 0) {
+            return false;
+        }
+        // Nothing can be registered from now on, so the whole list is taken
+        // in one critical section. The callbacks are then run from a list of
+        // this call's own, which an owner on another thread does not touch:
+        // it marks its callback abandoned, and waits for it to be passed over.
+        callback_list to_run{};
+#if ASYNC_HAS_THREADS
+        runner = std::this_thread::get_id();
+#endif
+        taken = std::addressof(to_run);
+        conc::call_in_critical_section<mutex>([&] {
+            while (not callbacks.empty()) {
+                auto cb = callbacks.pop_front();
+                cb->phase.store(phase_t::pending, std::memory_order_release);
+                to_run.push_back(cb);
             }
-            return true;
+        });
+        while (auto cb = claim_next(to_run)) {
+            cb->run();
+            // the callback may be gone now; after a reset, another
+            // request_stop may be running one of its own
+            running.compare_exchange_strong(cb, nullptr,
+                                            std::memory_order_release,
+                                            std::memory_order_relaxed);
         }
-        return false;
+        return true;
     }
 
     auto register_callback(stop_callback_base *cb) -> bool {
+        if (stop_requested()) {
+            return false;
+        }
         return conc::call_in_critical_section<mutex>([&] {
-            if (not requested) {
+            if ((state.load(std::memory_order_relaxed) & requested) == 0) {
                 callbacks.push_back(cb);
+                cb->phase.store(phase_t::linked, std::memory_order_release);
                 return true;
             }
             return false;
         });
     }
     auto unregister_callback(stop_callback_base *cb) -> void {
-        conc::call_in_critical_section<mutex>([&] { callbacks.remove(cb); });
+        auto p = cb->phase.load(std::memory_order_acquire);
+        if (p == phase_t::linked) {
+            p = conc::call_in_critical_section<mutex>([&] {
+                if (cb->phase.load(std::memory_order_relaxed) ==
+                    phase_t::linked) {
+                    callbacks.remove(cb);
+                    cb->phase.store(phase_t::unlinked,
+                                    std::memory_order_release);
+                }
+                return cb->phase.load(std::memory_order_relaxed);
+            });
+        }
+        if (p == phase_t::pending) {
+            unregister_pending(cb);
+        }
+        wait_for_run(cb);
+    }
+
+    // Makes a source whose stop was requested usable again. No callback may
+    // be registered. A request_stop still running (or interrupted) does not
+    // go on to run callbacks registered after the reset.
+    auto reset() -> void {
+        conc::call_in_critical_section<mutex>([&] {
+            auto const s = state.load(std::memory_order_relaxed);
+            if ((s & requested) != 0) {
+                state.store(s + requested, std::memory_order_release);
+            }
+        });
     }
 
   private:
-    std::atomic<bool> requested{};
-    stdx::intrusive_list<stop_callback_base> callbacks{};
+    using phase_t = stop_callback_base::phase_t;
+    using callback_list = stdx::intrusive_list<stop_callback_base>;
+
+    // Takes the next callback to run from request_stop's list, and marks it
+    // running; passes over (and releases) any that their owners abandoned.
+    // Without threads, an unregistration may interrupt this to take its
+    // callback out of the list, so each callback is taken in the critical
+    // section.
+    auto claim_next(callback_list &to_run) -> stop_callback_base * {
+        auto const claim = [&]() -> stop_callback_base * {
+            while (not to_run.empty()) {
+                auto const cb = to_run.pop_front();
+                cb->prev = cb->next = nullptr;
+                running.store(cb, std::memory_order_release);
+                auto expected = phase_t::pending;
+                if (cb->phase.compare_exchange_strong(
+                        expected, phase_t::unlinked,
+                        std::memory_order_acq_rel)) {
+                    return cb;
+                }
+                auto r = cb;
+                running.compare_exchange_strong(r, nullptr,
+                                                std::memory_order_release,
+                                                std::memory_order_relaxed);
+                cb->phase.store(phase_t::unlinked, std::memory_order_release);
+            }
+            return nullptr;
+        };
+#if ASYNC_HAS_THREADS
+        return claim();
+#else
+        return conc::call_in_critical_section<mutex>(claim);
+#endif
+    }
+
+    // A callback that request_stop took but has not run. On the thread that
+    // is running request_stop (inside one of its callbacks), or without
+    // threads, the callback is taken out of request_stop's list, which is not
+    // being changed meanwhile. On another thread, it is abandoned, and left
+    // for request_stop to pass over.
+    auto unregister_pending(stop_callback_base *cb) -> void {
+#if ASYNC_HAS_THREADS
+        if (runner != std::this_thread::get_id()) {
+            auto expected = phase_t::pending;
+            if (cb->phase.compare_exchange_strong(expected, phase_t::abandoned,
+                                                  std::memory_order_acq_rel)) {
+                while (cb->phase.load(std::memory_order_acquire) ==
+                       phase_t::abandoned) {
+                    std::this_thread::yield();
+                }
+            }
+            return;
+        }
+        if (cb->phase.load(std::memory_order_relaxed) == phase_t::pending) {
+            taken->remove(cb);
+            cb->phase.store(phase_t::unlinked, std::memory_order_release);
+        }
+#else
+        conc::call_in_critical_section<mutex>([&] {
+            if (cb->phase.load(std::memory_order_relaxed) == phase_t::pending) {
+                taken->remove(cb);
+                cb->phase.store(phase_t::unlinked, std::memory_order_release);
+            }
+        });
+#endif
+    }
+
+    // A callback that request_stop is running on another thread may not be
+    // destroyed until it returns. A callback may destroy itself while it
+    // runs, and without threads (where request_stop may have been interrupted
+    // to get here) there is nothing to wait for.
+    auto wait_for_run([[maybe_unused]] stop_callback_base const *cb) const
+        -> void {
+#if ASYNC_HAS_THREADS
+        if (running.load(std::memory_order_acquire) == cb and
+            runner != std::this_thread::get_id()) {
+            while (running.load(std::memory_order_acquire) == cb) {
+                std::this_thread::yield();
+            }
+        }
+#endif
+    }
+
+    // the low bit says whether stop was requested, and the rest count resets
+    constexpr static auto requested = std::uint32_t{1};
+    std::atomic<std::uint32_t> state{};
+    callback_list callbacks{};
+    // the list of callbacks that request_stop took, while it runs them
+    callback_list *taken{};
+    std::atomic<stop_callback_base *> running{};
+#if ASYNC_HAS_THREADS
+    std::thread::id runner{};
+#endif
 };
 
 using inplace_stop_token = stop_token<inplace_stop_source>;
 
+template <typename F> struct single_inplace_stop_callback;
+
+namespace detail {
+// NOLINTNEXTLINE(cppcoreguidelines-virtual-class-destructor)
+struct single_stop_callback_base {
+    virtual auto run() -> void = 0;
+};
+
+struct stopped_callback final : single_stop_callback_base {
+    auto run() -> void override {}
+};
+inline constinit stopped_callback stopped_sentinel{};
+inline constinit stopped_callback running_sentinel{};
+#if ASYNC_HAS_THREADS
+// the single stop callback that request_stop is running on this thread
+inline thread_local single_stop_callback_base const *running_here{};
+#endif
+} // namespace detail
+
+// A stop source that holds at most one callback at a time. It is a single
+// atomic pointer, which is either empty, the registered callback, or once
+// stop has been requested, a sentinel saying whether the callback is still
+// running. Registering a second callback while one is registered is a
+// precondition violation.
+struct single_inplace_stop_source {
+    template <typename F> using callback_type = single_inplace_stop_callback<F>;
+
+    [[nodiscard]] auto stop_requested() const noexcept -> bool {
+        return is_stopped(state.load(std::memory_order_acquire));
+    }
+    [[nodiscard]] constexpr static auto stop_possible() noexcept -> bool {
+        return true;
+    }
+
+    [[nodiscard]] constexpr auto get_token() const noexcept
+        -> stop_token<single_inplace_stop_source> {
+        return {this};
+    }
+
+    auto request_stop() -> bool {
+        auto cb = state.load(std::memory_order_acquire);
+        do {
+            if (is_stopped(cb)) {
+                return false;
+            }
+        } while (not state.compare_exchange_weak(
+            cb, std::addressof(detail::running_sentinel),
+            std::memory_order_acq_rel, std::memory_order_acquire));
+        if (cb != nullptr) {
+#if ASYNC_HAS_THREADS
+            auto const outer = std::exchange(detail::running_here, cb);
+            cb->run();
+            detail::running_here = outer;
+#else
+            cb->run();
+#endif
+        }
+        // the callback may be gone now; a concurrent unregister waits for this
+        state.store(std::addressof(detail::stopped_sentinel),
+                    std::memory_order_release);
+        return true;
+    }
+
+    auto register_callback(detail::single_stop_callback_base *cb) -> bool {
+        detail::single_stop_callback_base *expected{};
+        if (state.compare_exchange_strong(expected, cb,
+                                          std::memory_order_acq_rel,
+                                          std::memory_order_acquire)) {
+            return true;
+        }
+        assert(is_stopped(expected) and
+               "single_inplace_stop_source holds only one callback at a time");
+        return false;
+    }
+
+    // Called only for a callback whose registration succeeded. If stop was
+    // requested meanwhile, the callback may be running on another thread, and
+    // may not be destroyed until it returns; but it may destroy itself while
+    // it runs.
+    auto unregister_callback(detail::single_stop_callback_base *cb) -> void {
+        auto expected = cb;
+        if (state.compare_exchange_strong(expected, nullptr,
+                                          std::memory_order_acq_rel,
+                                          std::memory_order_acquire)) {
+            return;
+        }
+#if ASYNC_HAS_THREADS
+        if (detail::running_here != cb) {
+            while (state.load(std::memory_order_acquire) ==
+                   std::addressof(detail::running_sentinel)) {
+                std::this_thread::yield();
+            }
+        }
+#endif
+    }
+
+  private:
+    [[nodiscard]] constexpr static auto
+    is_stopped(detail::single_stop_callback_base const *cb) -> bool {
+        return cb == std::addressof(detail::stopped_sentinel) or
+               cb == std::addressof(detail::running_sentinel);
+    }
+
+    std::atomic<detail::single_stop_callback_base *> state{};
+};
+
+using single_inplace_stop_token = stop_token<single_inplace_stop_source>;
+
 struct never_stop_token {
     template <class T> using callback_type = inplace_stop_callback<T>;
 
@@ -180,7 +446,7 @@ template <typename F> struct inplace_stop_callback final : stop_callback_base {
     }
     inplace_stop_callback(inplace_stop_callback &&) = delete;
     ~inplace_stop_callback() {
-        if (next != nullptr or prev != nullptr) {
+        if (source != nullptr) {
             source->unregister_callback(this);
         }
     }
@@ -191,6 +457,55 @@ template <typename F> struct inplace_stop_callback final : stop_callback_base {
     F callback;
 };
 
+// NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+template <typename F>
+struct single_inplace_stop_callback final : detail::single_stop_callback_base {
+    single_inplace_stop_callback(single_inplace_stop_token t, F const &f)
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+        : source{const_cast<single_inplace_stop_source *>(t.source)},
+          callback{f} {
+        if (source != nullptr and not source->register_callback(this)) {
+            source = nullptr;
+            callback();
+        }
+    }
+    single_inplace_stop_callback(single_inplace_stop_token t, F &&f)
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+        : source{const_cast<single_inplace_stop_source *>(t.source)},
+          callback{std::move(f)} {
+        if (source != nullptr and not source->register_callback(this)) {
+            source = nullptr;
+            callback();
+        }
+    }
+    single_inplace_stop_callback(single_inplace_stop_callback &&) = delete;
+    ~single_inplace_stop_callback() {
+        if (source != nullptr) {
+            source->unregister_callback(this);
+        }
+    }
+
+    auto run() -> void override { callback(); }
+
+    single_inplace_stop_source *source{};
+    F callback;
+};
+
+namespace detail {
+struct no_stop_callback {
+    constexpr auto emplace(auto &&...) -> void {}
+    constexpr auto reset() -> void {}
+};
+} // namespace detail
+
+// Storage for a stop callback that an operation registers while it runs. For
+// an unstoppable token there is nothing to register, and this is an empty type
+// whose emplace and reset do nothing.
+template <typename Token, typename F>
+using optional_stop_callback_t =
+    std::conditional_t<unstoppable_token<Token>, detail::no_stop_callback,
+                       std::optional<stop_callback_for_t<Token, F>>>;
+
 struct get_stop_token_t : forwarding_query_t {
     template <typename T>
         requires true // more constrained
@@ -211,3 +526,5 @@ template <typename E> auto get_stop_token(E &&e) {
 template <typename T>
 using stop_token_of_t = decltype(get_stop_token(std::declval<T>()));
 } // namespace async
+
+#undef ASYNC_HAS_THREADS
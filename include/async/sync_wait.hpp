@@ -6,10 +6,16 @@
 #include <async/type_traits.hpp>
 
 #include <stdx/concepts.hpp>
+#include <stdx/functional.hpp>
 #include <stdx/tuple.hpp>
 
+#include <array>
+#include <atomic>
+#include <cassert>
 #include <concepts>
+#include <cstddef>
 #include <optional>
+#include <span>
 #include <type_traits>
 #include <utility>
 
@@ -77,6 +83,78 @@ template <typename Uniq, sender S> auto wait(S &&s) {
     return values;
 }
 
+// Drives a runtime number of independent senders on one run loop. Each
+// sender's result is kept separately, and one sender's error or cancellation
+// does not affect the others.
+template <typename V, typename RL, std::size_t N> struct all_state {
+    std::array<V, N> results{};
+    std::atomic<std::size_t> remaining{};
+    RL loop{};
+
+    auto complete() -> void {
+        if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            loop.finish();
+        }
+    }
+};
+
+template <typename State, typename Env> struct all_receiver {
+    using is_receiver = void;
+
+    State *state;
+    std::size_t index;
+
+  private:
+    template <typename... Args>
+    friend auto tag_invoke(set_value_t, all_receiver const &r, Args &&...args)
+        -> void {
+        r.state->results[r.index].emplace(
+            stdx::make_tuple(std::forward<Args>(args)...));
+        r.state->complete();
+    }
+    friend auto tag_invoke(set_error_t, all_receiver const &r, auto &&...)
+        -> void {
+        r.state->complete();
+    }
+    friend auto tag_invoke(set_stopped_t, all_receiver const &r) -> void {
+        r.state->complete();
+    }
+
+    [[nodiscard]] friend constexpr auto tag_invoke(get_env_t,
+                                                   all_receiver const &r) noexcept
+        -> Env {
+        return {r.state->loop.get_scheduler()};
+    }
+};
+
+template <typename Uniq, std::size_t N, typename S, std::size_t SE>
+auto wait_all(std::span<S, SE> sndrs) {
+    using RL = run_loop<Uniq>;
+    using E = env<decltype(std::declval<RL &>().get_scheduler())>;
+    using V = detail::sync_wait_type<E, S &>;
+    using state_t = all_state<V, RL, N>;
+    using rcvr_t = all_receiver<state_t, E>;
+    using ops_t = connect_result_t<S &, rcvr_t>;
+
+    if constexpr (SE != std::dynamic_extent) {
+        static_assert(SE <= N, "sync_wait_all: more senders than capacity");
+    }
+    assert(std::size(sndrs) <= N and
+           "sync_wait_all: more senders than capacity");
+
+    state_t state{};
+    std::array<std::optional<ops_t>, N> ops{};
+    state.remaining.store(sndrs.size() + 1, std::memory_order_relaxed);
+    for (auto i = std::size_t{}; i < sndrs.size(); ++i) {
+        start(ops[i].emplace(stdx::with_result_of{
+            [&] { return connect(sndrs[i], rcvr_t{&state, i}); }}));
+    }
+    // the extra count keeps the loop from finishing while senders are started
+    state.complete();
+    state.loop.run();
+    return state.results;
+}
+
 template <typename Uniq> struct pipeable {
   private:
     template <async::sender S, stdx::same_as_unqualified<pipeable> Self>
@@ -95,4 +173,10 @@ template <typename Uniq = decltype([] {})>
 [[nodiscard]] constexpr auto sync_wait() -> _sync_wait::pipeable<Uniq> {
     return {};
 }
+
+template <std::size_t N, typename Uniq = decltype([] {}), typename S,
+          std::size_t SE>
+[[nodiscard]] auto sync_wait_all(std::span<S, SE> sndrs) {
+    return _sync_wait::wait_all<Uniq, N>(sndrs);
+}
 } // namespace async
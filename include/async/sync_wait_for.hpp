@@ -0,0 +1,97 @@
+#pragma once
+
+#include <async/concepts.hpp>
+#include <async/just.hpp>
+#include <async/schedulers/runloop_scheduler.hpp>
+#include <async/schedulers/time_scheduler.hpp>
+#include <async/sequence.hpp>
+#include <async/sync_wait.hpp>
+#include <async/tags.hpp>
+#include <async/timeout.hpp>
+#include <async/type_traits.hpp>
+#include <async/when_any.hpp>
+
+#include <stdx/concepts.hpp>
+#include <stdx/tuple.hpp>
+
+#include <concepts>
+#include <type_traits>
+#include <utility>
+
+namespace async {
+namespace _sync_wait_for {
+// values is what sync_wait would return; it is empty if the sender completed
+// with an error or stopped, or if the wait timed out.
+template <typename V> struct result {
+    V values;
+    bool timed_out;
+};
+
+template <typename V, typename RL> struct receiver {
+    using is_receiver = void;
+
+    // NOLINTBEGIN(cppcoreguidelines-avoid-const-or-ref-data-members)
+    result<V> &res;
+    RL &loop;
+    // NOLINTEND(cppcoreguidelines-avoid-const-or-ref-data-members)
+
+  private:
+    template <typename... Args>
+    friend auto tag_invoke(set_value_t, receiver const &r, Args &&...args)
+        -> void {
+        r.res.values.emplace(stdx::make_tuple(std::forward<Args>(args)...));
+        r.loop.finish();
+    }
+    template <typename E>
+    friend auto tag_invoke(set_error_t, receiver const &r, E &&) -> void {
+        r.res.timed_out = std::same_as<std::remove_cvref_t<E>, timed_out_t>;
+        r.loop.finish();
+    }
+    friend auto tag_invoke(set_stopped_t, receiver const &r) -> void {
+        r.loop.finish();
+    }
+
+    [[nodiscard]] friend constexpr auto tag_invoke(get_env_t,
+                                                   receiver const &r) noexcept
+        -> _sync_wait::env<decltype(std::declval<RL>().get_scheduler())> {
+        return {r.loop.get_scheduler()};
+    }
+};
+
+// The sender races a timer on the given time scheduler. Whichever completes
+// first stops the other; the timer's win is reported as a timed_out_t error.
+// Both operation states live on the stack.
+template <typename Uniq, sender S, typename TimeSched>
+auto wait_for(S &&s, TimeSched sched) {
+    run_loop<Uniq> rl{};
+    auto rl_sched = rl.get_scheduler();
+    _sync_wait::env<decltype(rl_sched)> e{rl_sched};
+
+    auto raced = when_any(std::forward<S>(s),
+                          sched.schedule() | seq(just_error(timed_out_t{})));
+
+    using V = _sync_wait::detail::sync_wait_type<decltype(e), decltype(raced)>;
+    result<V> res{};
+    auto r = receiver<V, decltype(rl)>{res, rl};
+
+    auto op_state = connect(std::move(raced), r);
+    start(op_state);
+    rl.run();
+    return res;
+}
+} // namespace _sync_wait_for
+
+template <typename Uniq = decltype([] {}), sender S, typename Domain,
+          typename Duration, typename Task, typename Cancellation>
+[[nodiscard]] auto
+sync_wait_for(S &&s,
+              time_scheduler<Domain, Duration, Task, Cancellation> sched) {
+    return _sync_wait_for::wait_for<Uniq>(std::forward<S>(s), sched);
+}
+
+template <typename Uniq = decltype([] {}), sender S, typename Duration>
+[[nodiscard]] auto sync_wait_for(S &&s, Duration d) {
+    return _sync_wait_for::wait_for<Uniq>(std::forward<S>(s),
+                                          time_scheduler{d});
+}
+} // namespace async
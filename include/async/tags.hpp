@@ -86,6 +86,19 @@ constexpr inline struct start_t {
     }
 } start{};
 
+// Resets a completed operation state in place so that it can be started again
+// (as an lvalue) without being reconnected. There is no default: operation
+// states opt in.
+constexpr inline struct restart_t {
+    template <typename... Ts>
+    constexpr auto operator()(Ts &&...ts) const
+        noexcept(noexcept(tag_invoke(std::declval<restart_t>(),
+                                     std::forward<Ts>(ts)...)))
+            -> decltype(tag_invoke(*this, std::forward<Ts>(ts)...)) {
+        return tag_invoke(*this, std::forward<Ts>(ts)...);
+    }
+} restart{};
+
 struct get_scheduler_t : forwarding_query_t {
     template <typename T>
         requires true
@@ -5,6 +5,7 @@
 #include <async/env.hpp>
 #include <async/forwarding_query.hpp>
 #include <async/tags.hpp>
+#include <async/trace.hpp>
 #include <async/type_traits.hpp>
 
 #include <stdx/concepts.hpp>
@@ -18,6 +19,7 @@
 
 #include <concepts>
 #include <functional>
+#include <memory>
 #include <type_traits>
 #include <utility>
 
@@ -103,7 +105,10 @@ template <typename Tag, typename R, typename... Fs> struct receiver {
 
   private:
     template <stdx::same_as_unqualified<receiver> Self, typename... Args>
-    friend auto tag_invoke(Tag, Self &&self, Args &&...args) -> void {
+    friend constexpr auto tag_invoke(Tag, Self &&self, Args &&...args)
+        -> void {
+        ::async::detail::trace<trace_kind::then, Tag>(self.r,
+                                                      std::addressof(self));
         using arities =
             typename detail::args<Args &&...>::template arities_t<Fs...>;
         using offsets = typename detail::offsets_t<arities, Fs...>;
@@ -127,9 +132,13 @@ template <typename Tag, typename R, typename... Fs> struct receiver {
 
     template <typename T, stdx::same_as_unqualified<receiver> Self,
               typename... Args>
-    friend auto tag_invoke(T, Self &&self, Args &&...args)
+    friend constexpr auto tag_invoke(T, Self &&self, Args &&...args)
         -> decltype(T{}(std::forward<Self>(self).r,
                         std::forward<Args>(args)...)) {
+        if constexpr (channel_tag<T>) {
+            ::async::detail::trace<trace_kind::then, T>(self.r,
+                                                        std::addressof(self));
+        }
         return T{}(std::forward<Self>(self).r, std::forward<Args>(args)...);
     }
 };
@@ -232,14 +241,74 @@ template <typename Tag, typename S, typename... Fs> class sender {
     [[no_unique_address]] stdx::tuple<Fs...> fs;
 };
 
+// Two functions called one after the other: g is called with what f returns
+// (or with nothing, if f returns void).
+template <typename F, typename G> struct fused {
+    [[no_unique_address]] F f;
+    [[no_unique_address]] G g;
+
+    template <typename... Args>
+        requires std::invocable<F &, Args...>
+    constexpr auto operator()(Args &&...args) & -> decltype(auto) {
+        return call(f, g, std::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+        requires std::invocable<F const &, Args...>
+    constexpr auto operator()(Args &&...args) const & -> decltype(auto) {
+        return call(f, g, std::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+        requires std::invocable<F, Args...>
+    constexpr auto operator()(Args &&...args) && -> decltype(auto) {
+        return call(std::move(f), std::move(g), std::forward<Args>(args)...);
+    }
+
+  private:
+    template <typename FF, typename GG, typename... Args>
+    constexpr static auto call(FF &&ff, GG &&gg, Args &&...args)
+        -> decltype(auto) {
+        if constexpr (std::is_void_v<std::invoke_result_t<FF, Args...>>) {
+            std::invoke(std::forward<FF>(ff), std::forward<Args>(args)...);
+            return std::invoke(std::forward<GG>(gg));
+        } else {
+            return std::invoke(
+                std::forward<GG>(gg),
+                std::invoke(std::forward<FF>(ff), std::forward<Args>(args)...));
+        }
+    }
+};
+
+// A then of one function may be fused with the then of one function that
+// follows it, giving a single sender (and a single receiver and operation
+// state) however long the chain.
+template <typename S> struct fusible : std::false_type {};
+template <typename S, typename F>
+struct fusible<sender<set_value_t, S, F>> : std::true_type {
+    template <typename G> using fn_t = fused<F, G>;
+    template <typename G> using sender_t = sender<set_value_t, S, fn_t<G>>;
+};
+
 template <typename Tag, typename... Fs> struct pipeable {
     stdx::tuple<Fs...> fs;
 
   private:
     template <async::sender S, stdx::same_as_unqualified<pipeable> Self>
     friend constexpr auto operator|(S &&s, Self &&self) -> async::sender auto {
-        return sender<Tag, std::remove_cvref_t<S>, Fs...>{
-            std::forward<S>(s), std::forward<Self>(self).fs};
+        using fuse_t = fusible<std::remove_cvref_t<S>>;
+        if constexpr (std::same_as<Tag, set_value_t> and
+                      sizeof...(Fs) == 1 and fuse_t::value) {
+            using fn_t = typename fuse_t::template fn_t<Fs...>;
+            return typename fuse_t::template sender_t<Fs...>{
+                std::forward<S>(s).s,
+                stdx::tuple<fn_t>{
+                    fn_t{std::forward<S>(s).fs[stdx::index<0>],
+                         std::forward<Self>(self).fs[stdx::index<0>]}}};
+        } else {
+            return sender<Tag, std::remove_cvref_t<S>, Fs...>{
+                std::forward<S>(s), std::forward<Self>(self).fs};
+        }
     }
 };
 } // namespace _then
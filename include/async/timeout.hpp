@@ -0,0 +1,207 @@
+#pragma once
+
+#include <async/compose.hpp>
+#include <async/concepts.hpp>
+#include <async/env.hpp>
+#include <async/schedulers/time_scheduler.hpp>
+#include <async/schedulers/timer_manager_interface.hpp>
+#include <async/stop_token.hpp>
+#include <async/tags.hpp>
+#include <async/type_traits.hpp>
+#include <async/when_any.hpp>
+
+#include <stdx/concepts.hpp>
+#include <stdx/tuple.hpp>
+
+#include <atomic>
+#include <concepts>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace async {
+struct timed_out_t {};
+
+namespace _timeout {
+template <typename Ops, typename Rcvr> struct receiver {
+    using is_receiver = void;
+
+    Ops *ops;
+
+  private:
+    template <channel_tag Tag, typename... Args>
+    friend constexpr auto tag_invoke(Tag, receiver const &r, Args &&...args)
+        -> void {
+        r.ops->template complete<Tag>(std::forward<Args>(args)...);
+    }
+
+    [[nodiscard]] friend constexpr auto tag_invoke(async::get_env_t,
+                                                   receiver const &self)
+        -> detail::overriding_env<get_stop_token_t, inplace_stop_token, Rcvr> {
+        return override_env_with<get_stop_token_t>(
+            self.ops->stop_source.get_token(), self.ops->rcvr);
+    }
+};
+
+// The op state is its own timer task, so a timeout costs one timer node and
+// one stop source, rather than the op states of a race between the sender
+// and a timer. At expiry it requests stop on the sender; when the sender
+// then completes with set_stopped, that is reported as a timed_out_t error.
+//
+// The sender may complete inside the timer's request_stop (many senders
+// complete from their stop callbacks), or on another thread while it runs.
+// So the sender's completion is stored, and the timer holds a share of the
+// completion count until request_stop returns: whichever of the two lets go
+// last reports the completion.
+template <typename Domain, typename Task, typename Duration, typename Sndr,
+          typename Rcvr>
+// NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+struct op_state final : Task {
+    using receiver_t = receiver<op_state, Rcvr>;
+    using env_t =
+        detail::overriding_env<get_stop_token_t, inplace_stop_token, Rcvr>;
+
+    template <typename S, stdx::same_as_unqualified<Rcvr> R>
+    constexpr op_state(S &&s, R &&r, Duration dur)
+        : Task{run_task<op_state>}, rcvr{std::forward<R>(r)}, d{dur},
+          state{connect(std::forward<S>(s), receiver_t{this})} {}
+    constexpr op_state(op_state &&) = delete;
+
+    auto run() -> void {
+        timed_out.store(true, std::memory_order_relaxed);
+        stop_source.request_stop();
+        release();
+    }
+
+    template <typename Tag, typename... Args>
+    auto complete(Args &&...args) -> void {
+        slots.template store<Tag>(std::forward<Args>(args)...);
+        if constexpr (std::same_as<Tag, set_stopped_t>) {
+            child_stopped = true;
+        }
+        // a timer that is cancelled before it fires gives up its share here
+        if (timer_mgr::detail::cancel<Domain>(*this)) {
+            release();
+        }
+        release();
+    }
+
+    auto release() -> void {
+        if (count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            stop_cb.reset();
+            if (child_stopped and timed_out.load(std::memory_order_relaxed)) {
+                set_error(std::move(rcvr), timed_out_t{});
+            } else {
+                slots.report(rcvr);
+            }
+        }
+    }
+
+    struct stop_callback_fn {
+        auto operator()() -> void { stop_source->request_stop(); }
+        inplace_stop_source *stop_source;
+    };
+
+    using state_t = connect_result_t<Sndr, receiver_t>;
+    using stop_callback_t = optional_stop_callback_t<
+        stop_token_of_t<env_of_t<Rcvr>>, stop_callback_fn>;
+
+    [[no_unique_address]] Rcvr rcvr;
+    [[no_unique_address]] Duration d;
+    std::atomic<bool> timed_out{};
+    bool child_stopped{};
+    std::atomic<int> count{};
+    _when_any::completion_slots<_when_any::first_complete, env_t, Sndr> slots{};
+    inplace_stop_source stop_source{};
+    [[no_unique_address]] stop_callback_t stop_cb{};
+    state_t state;
+
+  private:
+    template <stdx::same_as_unqualified<op_state> O>
+    friend constexpr auto tag_invoke(start_t, O &&o) -> void {
+        // one share for the sender, one for the timer
+        o.count.store(2, std::memory_order_relaxed);
+        if constexpr (not unstoppable_token<stop_token_of_t<env_of_t<Rcvr>>>) {
+            auto token = get_stop_token(get_env(o.rcvr));
+            if (token.stop_requested()) {
+                set_stopped(std::forward<O>(o).rcvr);
+                return;
+            }
+            o.stop_cb.emplace(token,
+                              stop_callback_fn{std::addressof(o.stop_source)});
+        }
+        timer_mgr::detail::run_after<Domain>(o, o.d);
+        start(o.state);
+    }
+};
+
+template <typename Domain, typename Task, typename Duration, typename Sndr>
+struct sender {
+    using is_sender = void;
+    [[no_unique_address]] Sndr sndr;
+    [[no_unique_address]] Duration d;
+
+  private:
+    template <typename Env>
+    [[nodiscard]] friend constexpr auto
+    tag_invoke(get_completion_signatures_t, sender const &, Env const &)
+        -> transform_completion_signatures_of<
+            Sndr, Env,
+            completion_signatures<set_error_t(timed_out_t), set_stopped_t()>> {
+        return {};
+    }
+
+    [[nodiscard]] friend constexpr auto tag_invoke(async::get_env_t,
+                                                   sender const &self) {
+        return forward_env_of(self.sndr);
+    }
+
+    template <receiver_from<Sndr> R>
+    [[nodiscard]] friend constexpr auto tag_invoke(connect_t, sender &&self,
+                                                   R &&r)
+        -> op_state<Domain, Task, Duration, Sndr, std::remove_cvref_t<R>> {
+        return {std::move(self).sndr, std::forward<R>(r), self.d};
+    }
+
+    template <stdx::same_as_unqualified<sender> Self, receiver_from<Sndr> R>
+        requires multishot_sender<Sndr, R>
+    [[nodiscard]] friend constexpr auto tag_invoke(connect_t, Self &&self,
+                                                   R &&r)
+        -> op_state<Domain, Task, Duration, Sndr, std::remove_cvref_t<R>> {
+        return {std::forward<Self>(self).sndr, std::forward<R>(r), self.d};
+    }
+};
+
+template <typename Domain, typename Task, typename Duration> struct pipeable {
+    [[no_unique_address]] Duration d;
+
+  private:
+    template <async::sender S, stdx::same_as_unqualified<pipeable> Self>
+    friend constexpr auto operator|(S &&s, Self &&self) -> async::sender auto {
+        return sender<Domain, Task, Duration, std::remove_cvref_t<S>>{
+            std::forward<S>(s), self.d};
+    }
+};
+} // namespace _timeout
+
+// Completes with a timed_out_t error if the sender has not completed after
+// the time scheduler's duration; the sender is requested to stop at that
+// time, and the error is sent once it has stopped.
+template <typename Domain, typename Duration, typename Task,
+          typename Cancellation>
+[[nodiscard]] constexpr auto
+timeout(time_scheduler<Domain, Duration, Task, Cancellation> sched) {
+    static_assert(timer_mgr::detail::valid_duration<Duration, Domain>(),
+                  "timeout has invalid duration type for the injected timer "
+                  "manager");
+    return _compose::adaptor{
+        stdx::tuple{_timeout::pipeable<Domain, Task, Duration>{sched.d}}};
+}
+
+template <sender S, typename Domain, typename Duration, typename Task,
+          typename Cancellation>
+[[nodiscard]] constexpr auto
+timeout(S &&s, time_scheduler<Domain, Duration, Task, Cancellation> sched) {
+    return std::forward<S>(s) | timeout(sched);
+}
+} // namespace async
@@ -0,0 +1,228 @@
+#pragma once
+
+#include <async/env.hpp>
+#include <async/forwarding_query.hpp>
+#include <async/tags.hpp>
+
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace async {
+// Identifies the kind of a traced operation in a trace_record. The values are
+// part of the format that tools/trace_to_chrome.py decodes.
+enum struct trace_kind_id : std::uint8_t {
+    then,
+    let,
+    when_all,
+    start_detached,
+    inline_scheduler,
+    thread_scheduler,
+    runloop_scheduler,
+    priority_scheduler,
+    time_scheduler,
+};
+
+// The kinds of operation that report to a tracer. Each is an empty tag, so a
+// tracer can dispatch on the kind at compile time, or use the id and name at
+// runtime.
+namespace trace_kind {
+template <trace_kind_id Id> struct kind {
+    constexpr static auto id = Id;
+};
+
+struct then : kind<trace_kind_id::then> {
+    constexpr static auto name = "then";
+};
+struct let : kind<trace_kind_id::let> {
+    constexpr static auto name = "let";
+};
+struct when_all : kind<trace_kind_id::when_all> {
+    constexpr static auto name = "when_all";
+};
+struct start_detached : kind<trace_kind_id::start_detached> {
+    constexpr static auto name = "start_detached";
+};
+struct inline_scheduler : kind<trace_kind_id::inline_scheduler> {
+    constexpr static auto name = "inline_scheduler";
+};
+struct thread_scheduler : kind<trace_kind_id::thread_scheduler> {
+    constexpr static auto name = "thread_scheduler";
+};
+struct runloop_scheduler : kind<trace_kind_id::runloop_scheduler> {
+    constexpr static auto name = "runloop_scheduler";
+};
+// The priority is that of the task manager queue the operation runs from.
+template <std::uint8_t P>
+struct priority_scheduler : kind<trace_kind_id::priority_scheduler> {
+    constexpr static auto name = "priority_scheduler";
+    constexpr static std::uint8_t priority = P;
+};
+struct time_scheduler : kind<trace_kind_id::time_scheduler> {
+    constexpr static auto name = "time_scheduler";
+};
+} // namespace trace_kind
+
+// The tracer used when no tracer is injected and the environment has none.
+// Operations do not call it, so tracing costs nothing unless a tracer is
+// provided.
+struct null_tracer {
+    template <typename Kind, typename Event>
+    constexpr auto operator()(Kind, Event, void const *) const -> void {}
+};
+
+// A tracer used for every operation whose environment has none, for instance
+// to register live operations in a debug build.
+template <typename...> inline auto injected_tracer = null_tracer{};
+
+namespace detail {
+template <typename T, typename... DummyArgs>
+constexpr auto default_tracer() {
+    return injected_tracer<DummyArgs...>;
+}
+} // namespace detail
+
+constexpr inline struct get_tracer_t : forwarding_query_t {
+    template <typename T>
+        requires true // more constrained
+    constexpr auto operator()(T &&t) const
+        -> decltype(tag_invoke(std::declval<get_tracer_t>(),
+                               std::forward<T>(t))) {
+        return tag_invoke(*this, std::forward<T>(t));
+    }
+
+    constexpr auto operator()(auto &&t) const {
+        return detail::default_tracer<decltype(t)>();
+    }
+} get_tracer;
+
+template <typename T>
+using tracer_of_t = decltype(get_tracer(std::declval<T>()));
+
+namespace detail {
+// Called by an operation when it starts (Event is start_t) and when it
+// completes (Event is the completion channel tag). op identifies the
+// operation; it is the address of its operation state, or of its receiver for
+// adaptors that have no operation state of their own.
+template <typename Kind, typename Event, typename Tracer>
+constexpr auto trace_with(Tracer const &t, void const *op) -> void {
+    if constexpr (not std::same_as<Tracer, null_tracer>) {
+        t(Kind{}, Event{}, op);
+    }
+}
+
+// Traces with the tracer in the environment of q (a receiver or a sender).
+template <typename Kind, typename Event, typename Q>
+constexpr auto trace(Q const &q, void const *op) -> void {
+    using tracer_t = tracer_of_t<env_of_t<Q const &>>;
+    if constexpr (not std::same_as<tracer_t, null_tracer>) {
+        trace_with<Kind, Event>(get_tracer(get_env(q)), op);
+    }
+}
+} // namespace detail
+
+// Zero is never recorded, so that an unused slot in a dumped buffer can be told
+// apart from a record.
+enum struct trace_event : std::uint8_t { start = 1, value, error, stopped };
+
+constexpr inline std::uint8_t no_trace_priority = 0xffu;
+
+// A trace_buffer is plain data, so that it can be dumped from a target's
+// memory and decoded on a host.
+struct trace_record {
+    std::uint32_t seq;
+    std::uint32_t timestamp;
+    std::uintptr_t op;
+    trace_kind_id kind;
+    trace_event event;
+    std::uint8_t priority;
+};
+static_assert(std::is_trivially_copyable_v<trace_record>);
+
+// A fixed-size buffer of the most recent N trace events. Recording takes no
+// lock and is safe from any number of threads or interrupts: each event claims
+// a slot with a single fetch_add and overwrites the oldest record. (A record
+// may be torn only if N events are recorded while one is being written.)
+//
+// Clock provides the timestamp of each record with a static now() function;
+// without a clock, the timestamp is the sequence number. The buffer is meant
+// to be read once tracing has stopped, either in place or by dumping it for
+// decoding with tools/trace_to_chrome.py.
+template <std::size_t N, typename Clock = void> class trace_buffer {
+    static_assert(N > 0 and (N & (N - 1)) == 0,
+                  "trace_buffer size must be a power of two");
+
+    template <typename Event> constexpr static auto event_of() -> trace_event {
+        if constexpr (std::same_as<Event, set_value_t>) {
+            return trace_event::value;
+        } else if constexpr (std::same_as<Event, set_error_t>) {
+            return trace_event::error;
+        } else if constexpr (std::same_as<Event, set_stopped_t>) {
+            return trace_event::stopped;
+        } else {
+            return trace_event::start;
+        }
+    }
+
+    template <typename Kind> constexpr static auto priority_of() {
+        if constexpr (requires { Kind::priority; }) {
+            return Kind::priority;
+        } else {
+            return no_trace_priority;
+        }
+    }
+
+    std::array<trace_record, N> records{};
+    std::atomic<std::uint32_t> next{};
+
+  public:
+    struct tracer {
+        template <typename Kind, typename Event>
+        auto operator()(Kind, Event, void const *op) const -> void {
+            buffer->record(Kind::id, event_of<Event>(), op,
+                           priority_of<Kind>());
+        }
+        trace_buffer *buffer;
+    };
+
+    [[nodiscard]] auto get_tracer() -> tracer { return {this}; }
+
+    auto record(trace_kind_id kind, trace_event e, void const *op,
+                std::uint8_t priority = no_trace_priority) -> void {
+        auto const seq = next.fetch_add(1, std::memory_order_relaxed);
+        auto const timestamp = [&]() -> std::uint32_t {
+            if constexpr (std::is_void_v<Clock>) {
+                return seq;
+            } else {
+                return static_cast<std::uint32_t>(Clock::now());
+            }
+        }();
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        auto const addr = reinterpret_cast<std::uintptr_t>(op);
+        records[seq % N] = {seq, timestamp, addr, kind, e, priority};
+    }
+
+    // Calls f with each record, oldest first.
+    template <typename F> auto for_each(F &&f) const -> void {
+        auto const end = next.load(std::memory_order_acquire);
+        auto const begin = end > N ? end - static_cast<std::uint32_t>(N) : 0u;
+        for (auto i = begin; i != end; ++i) {
+            f(records[i % N]);
+        }
+    }
+
+    [[nodiscard]] auto size() const -> std::size_t {
+        auto const n = next.load(std::memory_order_acquire);
+        return n < N ? n : N;
+    }
+
+    // The records as they are laid out in memory, for dumping.
+    [[nodiscard]] auto raw() const -> std::array<trace_record, N> const & {
+        return records;
+    }
+};
+} // namespace async
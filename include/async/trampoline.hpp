@@ -0,0 +1,102 @@
+#pragma once
+
+#include <conc/concurrency.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#if __has_include(<thread>)
+#include <thread>
+#define ASYNC_HAS_THREADS 1
+#else
+#define ASYNC_HAS_THREADS 0
+#endif
+
+namespace async {
+namespace detail {
+// Turns re-entrant restarts into iteration. An adaptor that restarts its child
+// operation from the child's completion (like repeat or retry) runs the start
+// under run(). A completion that arrives while that start is still on the stack
+// asks the running loop for another iteration (defer) instead of recursing.
+// Before the adaptor completes, it calls finish, so that the loop does not
+// touch the (possibly destroyed) operation state afterwards.
+//
+// The loop's state is one atomic: a defer is one compare-exchange, and the
+// loop ends each iteration with one compare-exchange. A finish nested in the
+// loop's start marks the loop's frame (on its stack) done; a finish on another
+// thread waits for the loop to end, which it does as soon as its start
+// returns. Without threads, a finish may interrupt the loop between its check
+// of the frame and its exit, so there the loop exits in a critical section.
+template <typename Mutex> class trampoline {
+    enum struct state_t : std::uint8_t { idle, running, again };
+
+    struct frame {
+        std::atomic<bool> done{};
+    };
+
+    std::atomic<state_t> state{};
+    frame *active{};
+#if ASYNC_HAS_THREADS
+    std::thread::id owner{};
+#endif
+
+    // Returns true for another iteration. Once the adaptor has finished, it
+    // may be gone: only the frame is safe to look at.
+    auto next_iteration(frame const &fr) -> bool {
+        auto const step = [&] {
+            if (fr.done.load(std::memory_order_acquire)) {
+                return false;
+            }
+            auto s = state.load(std::memory_order_acquire);
+            while (not state.compare_exchange_weak(
+                s, s == state_t::again ? state_t::running : state_t::idle,
+                std::memory_order_acq_rel, std::memory_order_acquire)) {
+            }
+            return s == state_t::again;
+        };
+#if ASYNC_HAS_THREADS
+        return step();
+#else
+        return conc::call_in_critical_section<Mutex>(step);
+#endif
+    }
+
+  public:
+    template <typename F> auto run(F &&f) -> void {
+        frame fr{};
+#if ASYNC_HAS_THREADS
+        owner = std::this_thread::get_id();
+#endif
+        active = std::addressof(fr);
+        state.store(state_t::running, std::memory_order_release);
+        do {
+            f();
+        } while (next_iteration(fr));
+    }
+
+    [[nodiscard]] auto defer() -> bool {
+        auto s = state_t::running;
+        return state.compare_exchange_strong(s, state_t::again,
+                                             std::memory_order_acq_rel);
+    }
+
+    auto finish() -> void {
+        if (state.load(std::memory_order_acquire) == state_t::idle) {
+            return;
+        }
+#if ASYNC_HAS_THREADS
+        if (owner != std::this_thread::get_id()) {
+            while (state.load(std::memory_order_acquire) != state_t::idle) {
+                std::this_thread::yield();
+            }
+            return;
+        }
+#endif
+        active->done.store(true, std::memory_order_release);
+        state.store(state_t::idle, std::memory_order_release);
+    }
+};
+} // namespace detail
+} // namespace async
@@ -10,6 +10,8 @@
 #include <boost/mp11/algorithm.hpp>
 #include <boost/mp11/list.hpp>
 
+#include <concepts>
+#include <cstdint>
 #include <type_traits>
 #include <utility>
 
@@ -33,9 +35,24 @@ constexpr inline struct get_completion_signatures_t {
     }
 } get_completion_signatures{};
 
+namespace detail {
+// Completion signatures are always queried through const lvalues, so they are
+// computed (and instantiated) once for each sender and environment type,
+// however those are qualified at each use.
+template <typename S, typename E> struct completion_signatures_of {};
+template <typename S, typename E>
+    requires std::is_invocable_v<get_completion_signatures_t, S const &,
+                                 E const &>
+struct completion_signatures_of<S, E> {
+    using type = std::invoke_result_t<get_completion_signatures_t, S const &,
+                                      E const &>;
+};
+} // namespace detail
+
 template <typename S, typename E = empty_env>
 using completion_signatures_of_t =
-    std::invoke_result_t<get_completion_signatures_t, S, E>;
+    typename detail::completion_signatures_of<std::remove_cvref_t<S>,
+                                              std::remove_cvref_t<E>>::type;
 
 namespace detail {
 template <typename... Tags> struct with_any_tag {
@@ -44,8 +61,26 @@ template <typename... Tags> struct with_any_tag {
         std::bool_constant<(... or std::is_same_v<Tags, stdx::return_t<Sig>>)>;
 };
 
+// Filtering with a pack expansion and a single mp_append is flatter (and much
+// cheaper to instantiate) than a recursive mp_copy_if.
+template <typename Tag, typename Sig> struct signature_if_tag {
+    using type = completion_signatures<>;
+};
+template <typename Tag, typename... As> struct signature_if_tag<Tag, Tag(As...)> {
+    using type = completion_signatures<Tag(As...)>;
+};
+
+template <typename Sigs, typename Tag> struct signatures_by_tag_t {
+    using type = boost::mp11::mp_copy_if_q<Sigs, with_any_tag<Tag>>;
+};
+template <typename... Sigs, typename Tag>
+struct signatures_by_tag_t<completion_signatures<Sigs...>, Tag> {
+    using type = boost::mp11::mp_append<
+        completion_signatures<>, typename signature_if_tag<Tag, Sigs>::type...>;
+};
+
 template <typename Sigs, typename Tag>
-using signatures_by_tag = boost::mp11::mp_copy_if_q<Sigs, with_any_tag<Tag>>;
+using signatures_by_tag = typename signatures_by_tag_t<Sigs, Tag>::type;
 
 template <bool> struct indirect_meta_apply {
     template <template <typename...> typename T, typename... As>
@@ -81,10 +116,30 @@ struct variantify {
 
 template <typename Tag, typename Sigs, template <typename...> typename Tuple,
           template <typename...> typename Variant>
-using gather_signatures =
+using gather_signatures_uncached =
     typename variantify<Variant,
                         Tuple>::template fn<signatures_by_tag<Sigs, Tag>>;
 
+// A class template is instantiated once for each set of arguments, where an
+// alias is substituted again at every use. The constraint keeps
+// gather_signatures usable in a requires-expression.
+template <typename Tag, typename Sigs, template <typename...> typename Tuple,
+          template <typename...> typename Variant>
+struct gather_signatures_t {};
+template <typename Tag, typename Sigs, template <typename...> typename Tuple,
+          template <typename...> typename Variant>
+    requires requires {
+        typename gather_signatures_uncached<Tag, Sigs, Tuple, Variant>;
+    }
+struct gather_signatures_t<Tag, Sigs, Tuple, Variant> {
+    using type = gather_signatures_uncached<Tag, Sigs, Tuple, Variant>;
+};
+
+template <typename Tag, typename Sigs, template <typename...> typename Tuple,
+          template <typename...> typename Variant>
+using gather_signatures =
+    typename gather_signatures_t<Tag, Sigs, Tuple, Variant>::type;
+
 template <typename...> struct type_list;
 } // namespace detail
 
@@ -141,6 +196,56 @@ template <typename InputSigs, typename SetStopped> struct stopped_list {
     using type = stdx::conditional_t<std::is_same_v<sigs_t, type_list<>>,
                                      completion_signatures<>, SetStopped>;
 };
+
+// Each signature maps to the (possibly empty) list of signatures it becomes. A
+// transform may produce a single signature rather than a list.
+template <typename Sig> struct as_signature_list {
+    using type = completion_signatures<Sig>;
+};
+template <typename... Sigs>
+struct as_signature_list<completion_signatures<Sigs...>> {
+    using type = completion_signatures<Sigs...>;
+};
+
+template <typename Tag, typename Sig, template <typename...> typename F>
+struct transform_signature {
+    using type = completion_signatures<>;
+};
+template <typename Tag, typename... As, template <typename...> typename F>
+struct transform_signature<Tag, Tag(As...), F> {
+    using type = typename as_signature_list<meta_apply<F, As...>>::type;
+};
+
+template <typename InputSigs, typename AddlSigs,
+          template <typename...> typename SetValue,
+          template <typename...> typename SetError, typename SetStopped>
+struct transform_completion_signatures_t {
+    using type = boost::mp11::mp_unique<boost::mp11::mp_append<
+        AddlSigs,
+        boost::mp11::mp_flatten<
+            gather_signatures<set_value_t, InputSigs, SetValue,
+                              completion_signatures>>,
+        boost::mp11::mp_flatten<
+            gather_signatures<set_error_t, InputSigs, SetError,
+                              completion_signatures>>,
+        typename stopped_list<InputSigs, SetStopped>::type>>;
+};
+
+// The common case, in one mp_append over three pack expansions rather than a
+// chain of gather, flatten and append for each channel.
+template <typename... Sigs, typename AddlSigs,
+          template <typename...> typename SetValue,
+          template <typename...> typename SetError, typename SetStopped>
+struct transform_completion_signatures_t<completion_signatures<Sigs...>,
+                                         AddlSigs, SetValue, SetError,
+                                         SetStopped> {
+    using type = boost::mp11::mp_unique<boost::mp11::mp_append<
+        AddlSigs,
+        typename transform_signature<set_value_t, Sigs, SetValue>::type...,
+        typename transform_signature<set_error_t, Sigs, SetError>::type...,
+        stdx::conditional_t<(... or std::is_same_v<Sigs, set_stopped_t()>),
+                            SetStopped, completion_signatures<>>>>;
+};
 } // namespace detail
 
 template <typename InputSigs, typename AddlSigs = completion_signatures<>,
@@ -148,13 +253,8 @@ template <typename InputSigs, typename AddlSigs = completion_signatures<>,
           template <typename...> typename SetError = detail::default_set_error,
           typename SetStopped = completion_signatures<set_stopped_t()>>
 using transform_completion_signatures =
-    boost::mp11::mp_unique<boost::mp11::mp_append<
-        AddlSigs,
-        boost::mp11::mp_flatten<detail::gather_signatures<
-            set_value_t, InputSigs, SetValue, completion_signatures>>,
-        boost::mp11::mp_flatten<detail::gather_signatures<
-            set_error_t, InputSigs, SetError, completion_signatures>>,
-        typename detail::stopped_list<InputSigs, SetStopped>::type>>;
+    typename detail::transform_completion_signatures_t<
+        InputSigs, AddlSigs, SetValue, SetError, SetStopped>::type;
 
 template <typename S, typename E = empty_env,
           typename AddlSigs = completion_signatures<>,
@@ -174,6 +274,14 @@ template <> struct eat_void<void> {
 };
 template <typename T, template <typename...> typename C>
 using eat_void_t = typename eat_void<T>::template type<C>;
+
+// An error code: an enum or integer that fits in a machine word. It can be
+// kept in a plain slot, without the engaged flag of an optional or the index
+// and visitation of a variant.
+template <typename T>
+concept small_error = (std::is_enum_v<T> or std::integral<T>) and
+                      std::is_trivially_copyable_v<T> and
+                      sizeof(T) <= sizeof(std::uintptr_t);
 } // namespace detail
 
 template <typename Tag> struct channel_holder {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <async/concepts.hpp>
+#include <async/just.hpp>
 #include <async/tags.hpp>
 #include <async/type_traits.hpp>
 
@@ -13,6 +14,7 @@
 #include <boost/mp11/algorithm.hpp>
 #include <boost/mp11/list.hpp>
 
+#include <algorithm>
 #include <array>
 #include <concepts>
 #include <cstddef>
@@ -203,6 +205,84 @@ template <typename... Sndrs> struct sender : std::variant<Sndrs...> {
 };
 } // namespace _variant
 
+namespace _select {
+// The sender to run is chosen by a runtime index: connect looks up a constexpr
+// table of connect functions, one per sender, so the choice costs the same
+// however many senders there are. An index past the end connects just_stopped.
+template <typename... Sndrs> struct sender {
+    using is_sender = void;
+
+    std::size_t index;
+    stdx::tuple<Sndrs...> sndrs;
+
+  private:
+    using stopped_sender_t = decltype(just_stopped());
+
+    template <typename Env>
+    [[nodiscard]] friend constexpr auto tag_invoke(get_completion_signatures_t,
+                                                   sender const &, Env const &)
+        -> boost::mp11::mp_unique<boost::mp11::mp_append<
+            completion_signatures_of_t<Sndrs, Env>...,
+            completion_signatures<set_stopped_t()>>> {
+        return {};
+    }
+
+    template <typename Self, typename R>
+    using ops_t = _variant::op_state<
+        connect_result_t<stdx::forward_like_t<Self, Sndrs>,
+                         std::remove_cvref_t<R>>...,
+        connect_result_t<stopped_sender_t, std::remove_cvref_t<R>>>;
+
+    template <typename O, typename S, typename R>
+    [[nodiscard]] constexpr static auto connect_to(S &&s, R &&r) -> O {
+        using V = typename O::variant_t;
+        constexpr auto I = boost::mp11::mp_find<V, connect_result_t<S, R>>::value;
+        return {V{std::in_place_index<I>, stdx::with_result_of{[&] {
+                      return connect(std::forward<S>(s), std::forward<R>(r));
+                  }}}};
+    }
+
+    template <std::size_t I, typename O, typename Self, typename R>
+    [[nodiscard]] constexpr static auto connect_one(Self &&self, R &&r) -> O {
+        return connect_to<O>(std::forward<Self>(self).sndrs[stdx::index<I>],
+                             std::forward<R>(r));
+    }
+
+    template <typename O, typename Self, typename R>
+    [[nodiscard]] constexpr static auto connect_stopped(Self &&, R &&r) -> O {
+        return connect_to<O>(just_stopped(), std::forward<R>(r));
+    }
+
+    template <typename Self, typename R>
+    [[nodiscard]] constexpr static auto connect_impl(Self &&self, R &&r)
+        -> ops_t<Self, R> {
+        using O = ops_t<Self, R>;
+        using F = auto (*)(Self &&, R &&)->O;
+        constexpr auto table =
+            []<std::size_t... Is>(std::index_sequence<Is...>) {
+                return std::array<F, sizeof...(Is) + 1>{
+                    connect_one<Is, O, Self, R>...,
+                    connect_stopped<O, Self, R>};
+            }(std::make_index_sequence<sizeof...(Sndrs)>{});
+        auto const i = std::min(self.index, sizeof...(Sndrs));
+        return table[i](std::forward<Self>(self), std::forward<R>(r));
+    }
+
+    template <receiver_from<sender> R>
+    [[nodiscard]] friend constexpr auto tag_invoke(connect_t, sender &&self,
+                                                   R &&r) {
+        return connect_impl(std::move(self), std::forward<R>(r));
+    }
+
+    template <stdx::same_as_unqualified<sender> Self, receiver_from<sender> R>
+        requires(... and multishot_sender<Sndrs, R>)
+    [[nodiscard]] friend constexpr auto tag_invoke(connect_t, Self &&self,
+                                                   R &&r) {
+        return connect_impl(std::forward<Self>(self), std::forward<R>(r));
+    }
+};
+} // namespace _select
+
 namespace detail {
 template <typename ArgList> struct return_t {
     template <matchable_option T>
@@ -228,6 +308,13 @@ template <typename... Args> constexpr auto make_variant_sender(Args &&...args) {
         make_variant(std::forward<Args>(args)...)};
 }
 
+template <sender... Sndrs>
+[[nodiscard]] constexpr auto select_sender(std::size_t index, Sndrs &&...sndrs)
+    -> sender auto {
+    return _select::sender<std::remove_cvref_t<Sndrs>...>{
+        index, {std::forward<Sndrs>(sndrs)...}};
+}
+
 template <stdx::callable F1, stdx::callable F2>
 constexpr auto make_variant_sender(bool b, F1 &&f1, F2 &&f2) {
     using senders = boost::mp11::mp_transform<
@@ -0,0 +1,184 @@
+#pragma once
+
+#include <async/concepts.hpp>
+#include <async/env.hpp>
+#include <async/stop_token.hpp>
+#include <async/tags.hpp>
+#include <async/type_traits.hpp>
+#include <conc/concurrency.hpp>
+
+#include <stdx/concepts.hpp>
+#include <stdx/intrusive_list.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace async {
+namespace _interrupt {
+// NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+struct waiter {
+    waiter *next{};
+    waiter *prev{};
+    bool linked{};
+    // set if a stop request finds the operation not linked, so that it is not
+    // linked afterwards
+    bool stopping{};
+
+    virtual auto complete() -> void = 0;
+    virtual ~waiter() = default;
+};
+
+// The operations waiting for one interrupt. An operation links itself in when
+// it starts; signal() unlinks every waiting operation and completes it.
+template <typename IrqTag> struct irq {
+    struct mutex;
+    static inline stdx::intrusive_list<waiter> waiters{};
+
+    // Returns false if a stop request came first.
+    static auto link(waiter &w) -> bool {
+        return conc::call_in_critical_section<mutex>([&] {
+            if (w.stopping) {
+                return false;
+            }
+            waiters.push_back(std::addressof(w));
+            w.linked = true;
+            return true;
+        });
+    }
+
+    // Returns false if the operation was already unlinked by signal(), or is
+    // not yet linked (in which case it will not be).
+    static auto unlink(waiter &w) -> bool {
+        return conc::call_in_critical_section<mutex>([&] {
+            if (not w.linked) {
+                w.stopping = true;
+                return false;
+            }
+            waiters.remove(std::addressof(w));
+            w.linked = false;
+            return true;
+        });
+    }
+
+    // Operations that start while the others complete (for instance, the
+    // next iteration of a repeat) wait for the next interrupt.
+    static auto signal() -> std::size_t {
+        stdx::intrusive_list<waiter> ready{};
+        conc::call_in_critical_section<mutex>([&] {
+            while (not waiters.empty()) {
+                auto w = waiters.pop_front();
+                w->linked = false;
+                ready.push_back(w);
+            }
+        });
+
+        auto count = std::size_t{};
+        while (not ready.empty()) {
+            auto w = ready.pop_front();
+            w->prev = w->next = nullptr;
+            w->complete();
+            ++count;
+        }
+        return count;
+    }
+};
+
+template <typename IrqTag, typename Rcvr>
+// NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+struct op_state final : waiter {
+    template <stdx::same_as_unqualified<Rcvr> R>
+    // NOLINTNEXTLINE(bugprone-forwarding-reference-overload)
+    constexpr explicit(true) op_state(R &&r) : rcvr{std::forward<R>(r)} {}
+    constexpr op_state(op_state &&) = delete;
+
+    auto complete() -> void override {
+        stop_cb.reset();
+        set_value(std::move(rcvr));
+    }
+
+    struct stop_callback_fn {
+        auto operator()() -> void {
+            if (irq<IrqTag>::unlink(*ops)) {
+                set_stopped(std::move(ops->rcvr));
+            }
+        }
+        op_state *ops;
+    };
+
+    using stop_callback_t =
+        optional_stop_callback_t<stop_token_of_t<env_of_t<Rcvr>>,
+                                 stop_callback_fn>;
+
+    [[no_unique_address]] Rcvr rcvr;
+    [[no_unique_address]] stop_callback_t stop_cb{};
+
+  private:
+    template <stdx::same_as_unqualified<op_state> O>
+    friend constexpr auto tag_invoke(start_t, O &&o) -> void {
+        if constexpr (unstoppable_token<stop_token_of_t<env_of_t<Rcvr>>>) {
+            irq<IrqTag>::link(o);
+        } else {
+            auto token = get_stop_token(get_env(o.rcvr));
+            if (token.stop_requested()) {
+                set_stopped(std::forward<O>(o).rcvr);
+                return;
+            }
+            // Once the operation is linked, the interrupt may complete it at
+            // once, so the stop callback is registered first and nothing is
+            // touched after.
+            o.stop_cb.emplace(token, stop_callback_fn{std::addressof(o)});
+            if (not irq<IrqTag>::link(o)) {
+                o.stop_cb.reset();
+                set_stopped(std::forward<O>(o).rcvr);
+            }
+        }
+    }
+};
+
+template <typename IrqTag> struct sender {
+    using is_sender = void;
+
+  private:
+    template <stdx::same_as_unqualified<sender> S, receiver R>
+    [[nodiscard]] friend constexpr auto tag_invoke(connect_t, S &&, R &&r)
+        -> op_state<IrqTag, std::remove_cvref_t<R>> {
+        check_connect<S, R>();
+        return op_state<IrqTag, std::remove_cvref_t<R>>{std::forward<R>(r)};
+    }
+
+    template <typename Env>
+    [[nodiscard]] friend constexpr auto tag_invoke(get_completion_signatures_t,
+                                                   sender, Env const &) noexcept
+        -> completion_signatures<set_value_t(), set_stopped_t()> {
+        return {};
+    }
+
+    template <typename Env>
+        requires unstoppable_token<stop_token_of_t<Env>>
+    [[nodiscard]] friend constexpr auto tag_invoke(get_completion_signatures_t,
+                                                   sender, Env const &) noexcept
+        -> completion_signatures<set_value_t()> {
+        return {};
+    }
+};
+} // namespace _interrupt
+
+template <typename IrqTag> using interrupt_sender = _interrupt::sender<IrqTag>;
+
+// Completes the next time signal_interrupt<IrqTag>() is called, directly in
+// that context (typically the interrupt handler). The operation state links
+// itself into a list for the interrupt; nothing is allocated and no task
+// manager is involved. To continue elsewhere, follow with continue_on.
+template <typename IrqTag>
+[[nodiscard]] constexpr auto wait_for_interrupt() -> interrupt_sender<IrqTag> {
+    return {};
+}
+
+// Called from the interrupt handler: completes every operation waiting for
+// the interrupt, and returns how many there were.
+template <typename IrqTag> auto signal_interrupt() -> std::size_t {
+    return _interrupt::irq<IrqTag>::signal();
+}
+} // namespace async
@@ -2,10 +2,13 @@
 
 #include <async/concepts.hpp>
 #include <async/env.hpp>
+#include <async/sender_range.hpp>
 #include <async/stop_token.hpp>
 #include <async/tags.hpp>
+#include <async/trace.hpp>
 
 #include <stdx/concepts.hpp>
+#include <stdx/functional.hpp>
 #include <stdx/type_traits.hpp>
 #include <stdx/utility.hpp>
 
@@ -13,10 +16,15 @@
 #include <boost/mp11/function.hpp>
 #include <boost/mp11/list.hpp>
 
+#include <algorithm>
+#include <array>
 #include <atomic>
+#include <cassert>
 #include <concepts>
 #include <cstddef>
+#include <memory>
 #include <optional>
+#include <span>
 #include <type_traits>
 #include <utility>
 
@@ -73,6 +81,8 @@ struct sub_op_storage<E, S> {
     template <typename... Args> auto store(Args &&...args) -> void {
         v.emplace(std::forward<Args>(args)...);
     }
+    auto value() && -> decltype(auto) { return std::move(v).value(); }
+
     using value_t = value_types_of_t<typename S::sender_t, E, std::optional,
                                      std::type_identity_t>;
     using values_t = detail::type_list<typename value_t::value_type>;
@@ -80,6 +90,34 @@ struct sub_op_storage<E, S> {
     value_t v{};
 };
 
+template <typename E, typename S>
+using single_value_t =
+    typename value_types_of_t<typename S::sender_t, E, std::optional,
+                              std::type_identity_t>::value_type;
+
+// A trivially destructible value needs no engaged flag: it is constructed in
+// place when the sender completes, and only read when the countdown shows
+// that every sender completed with a value. A value left behind by an error
+// or cancellation needs no destruction.
+template <typename E, single_sender<set_value_t, E> S>
+    requires std::is_trivially_destructible_v<single_value_t<E, S>>
+struct sub_op_storage<E, S> {
+    using value_t = single_value_t<E, S>;
+    using values_t = detail::type_list<value_t>;
+
+    // NOLINTNEXTLINE(modernize-use-equals-default)
+    constexpr sub_op_storage() {}
+
+    template <typename... Args> auto store(Args &&...args) -> void {
+        std::construct_at(std::addressof(v), std::forward<Args>(args)...);
+    }
+    auto value() && -> value_t && { return std::move(v); }
+
+    union {
+        value_t v;
+    };
+};
+
 template <typename Ops, typename R, typename S>
 // NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
 struct sub_op_state : sub_op_storage<env_of_t<R>, S> {
@@ -117,6 +155,26 @@ struct sub_op_state : sub_op_storage<env_of_t<R>, S> {
     ops_t ops;
 };
 
+// Where the first error is kept until every sender has completed. An error
+// code needs no engaged flag, since have_error records that it was stored.
+template <typename T> struct error_slot {
+    template <typename... Args> auto store(Args &&...args) -> void {
+        e.emplace(std::forward<Args>(args)...);
+    }
+    auto take() -> T && { return std::move(*e); }
+
+    std::optional<T> e{};
+};
+
+template <detail::small_error T> struct error_slot<T> {
+    template <typename Arg> auto store(Arg &&arg) -> void {
+        e = static_cast<T>(arg);
+    }
+    auto take() const -> T { return e; }
+
+    T e{};
+};
+
 template <typename...> struct error_op_state;
 
 template <typename E> struct error_op_state<E, boost::mp11::mp_list<>> {
@@ -127,10 +185,10 @@ template <typename E> struct error_op_state<E, boost::mp11::mp_list<>> {
 template <typename E, single_sender<set_error_t, E>... Sndrs>
 struct error_op_state<E, boost::mp11::mp_list<Sndrs...>> {
     template <typename... Args> auto store_error(Args &&...args) -> void {
-        e.emplace(std::forward<Args>(args)...);
+        e.store(std::forward<Args>(args)...);
     }
     template <typename R> auto release_error(R &&r) -> void {
-        set_error(std::forward<R>(r), std::move(*e));
+        set_error(std::forward<R>(r), e.take());
     }
 
     // All senders should send the same error type
@@ -139,7 +197,7 @@ struct error_op_state<E, boost::mp11::mp_list<Sndrs...>> {
     using signatures =
         completion_signatures<set_error_t(typename error_t::value_type)>;
 
-    error_t e{};
+    error_slot<typename error_t::value_type> e{};
 };
 
 template <typename E> struct is_error_sender {
@@ -165,25 +223,27 @@ struct op_state
               s)}...,
           rcvr{std::forward<R>(r)} {}
 
+    // Each sub-operation stores its result before counting down (release),
+    // and the last one to count down reads them all (acquire).
     auto notify() -> void {
-        if (--count == 0) {
+        if (count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
             complete();
         }
     }
 
     template <typename... Args> auto notify_error(Args &&...args) -> void {
-        if (not have_error.exchange(true)) {
+        if (not have_error.exchange(true, std::memory_order_relaxed)) {
             this->store_error(std::forward<Args>(args)...);
         }
         stop_source.request_stop();
-        if (--count == 0) {
+        if (count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
             complete();
         }
     }
 
     auto notify_stopped() -> void {
         stop_source.request_stop();
-        if (--count == 0) {
+        if (count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
             complete();
         }
     }
@@ -195,10 +255,13 @@ struct op_state
     auto complete() -> void {
         stop_cb.reset();
         if (have_error) {
+            detail::trace<trace_kind::when_all, set_error_t>(rcvr, this);
             this->release_error(rcvr);
         } else if (stop_source.stop_requested()) {
+            detail::trace<trace_kind::when_all, set_stopped_t>(rcvr, this);
             set_stopped(rcvr);
         } else {
+            detail::trace<trace_kind::when_all, set_value_t>(rcvr, this);
             using value_senders =
                 boost::mp11::mp_copy_if<boost::mp11::mp_list<Sndrs...>,
                                         single_value_sender_t>;
@@ -206,29 +269,32 @@ struct op_state
                 set_value(
                     rcvr,
                     static_cast<sub_op_state<op_state, Rcvr, Ss> &&>(*this)
-                        .v.value()...);
+                        .value()...);
             }(value_senders{});
         }
     }
 
-    using stop_callback_t =
-        stop_callback_for_t<stop_token_of_t<env_of_t<Rcvr>>, stop_callback_fn>;
+    using stop_callback_t = optional_stop_callback_t<
+        stop_token_of_t<env_of_t<Rcvr>>, stop_callback_fn>;
 
     [[no_unique_address]] Rcvr rcvr;
     std::atomic<std::size_t> count{};
     inplace_stop_source stop_source{};
-    std::optional<stop_callback_t> stop_cb{};
+    [[no_unique_address]] stop_callback_t stop_cb{};
     std::atomic<bool> have_error{};
 
   private:
     template <stdx::same_as_unqualified<op_state> O>
     friend constexpr auto tag_invoke(start_t, O &&o) -> void {
+        detail::trace<trace_kind::when_all, start_t>(o.rcvr, std::addressof(o));
         o.stop_cb.emplace(get_stop_token(get_env(o.rcvr)),
                           stop_callback_fn{std::addressof(o.stop_source)});
         if (o.stop_source.stop_requested()) {
+            detail::trace<trace_kind::when_all, set_stopped_t>(
+                o.rcvr, std::addressof(o));
             set_stopped(std::forward<O>(o).rcvr);
         } else {
-            o.count = sizeof...(Sndrs);
+            o.count.store(sizeof...(Sndrs), std::memory_order_relaxed);
             (start(static_cast<stdx::forward_like_t<
                        O, sub_op_state<op_state, Rcvr, Sndrs>>>(o)
                        .ops),
@@ -334,4 +400,232 @@ template <sender... Sndrs>
             {std::forward<Sndrs>(sndrs)}...};
     }(std::make_index_sequence<sizeof...(Sndrs)>{});
 }
+
+namespace _when_all_range {
+template <typename Ops> struct sub_receiver {
+    using is_receiver = void;
+
+    Ops *ops;
+    std::size_t index;
+
+  private:
+    template <typename... Args>
+    friend auto tag_invoke(set_value_t, sub_receiver const &r, Args &&...args)
+        -> void {
+        r.ops->emplace_value(r.index, std::forward<Args>(args)...);
+    }
+    template <typename... Args>
+    friend auto tag_invoke(set_error_t, sub_receiver const &r, Args &&...args)
+        -> void {
+        r.ops->notify_error(std::forward<Args>(args)...);
+    }
+    friend auto tag_invoke(set_stopped_t, sub_receiver const &r) -> void {
+        r.ops->notify_stopped();
+    }
+
+    [[nodiscard]] friend constexpr auto tag_invoke(get_env_t,
+                                                   sub_receiver const &self)
+        -> detail::overriding_env<get_stop_token_t, inplace_stop_token,
+                                  typename Ops::receiver_t> {
+        return override_env_with<get_stop_token_t>(
+            self.ops->stop_source.get_token(), self.ops->rcvr);
+    }
+};
+
+template <typename E, typename S> struct error_storage {
+    auto store_error(auto &&...) -> void {}
+    auto release_error(auto &&) const -> void {}
+    using signatures = completion_signatures<>;
+};
+
+template <typename E, _when_all::single_sender<set_error_t, E> S>
+struct error_storage<E, S> {
+    template <typename... Args> auto store_error(Args &&...args) -> void {
+        e.store(std::forward<Args>(args)...);
+    }
+    template <typename R> auto release_error(R &&r) -> void {
+        set_error(std::forward<R>(r), e.take());
+    }
+
+    using error_t =
+        error_types_of_t<S, E, std::optional, std::type_identity_t>;
+    using signatures =
+        completion_signatures<set_error_t(typename error_t::value_type)>;
+
+    _when_all::error_slot<typename error_t::value_type> e{};
+};
+
+// Where the values sent by each sender go: nowhere when V is void, otherwise
+// the element of the caller's output array with the same index.
+template <typename V> struct results {
+    template <typename... Args>
+    auto store(std::size_t i, Args &&...args) -> void {
+        values[i] = V(std::forward<Args>(args)...);
+    }
+    template <typename R> auto send(R &&r, std::size_t n) -> void {
+        set_value(std::forward<R>(r), values.first(n));
+    }
+    using signatures = completion_signatures<set_value_t(std::span<V>)>;
+
+    std::span<V> values;
+};
+
+template <> struct results<void> {
+    auto store(std::size_t, auto &&...) -> void {}
+    template <typename R> auto send(R &&r, std::size_t) -> void {
+        set_value(std::forward<R>(r));
+    }
+    using signatures = completion_signatures<set_value_t()>;
+};
+
+template <std::size_t N, typename S, typename V, typename Rcvr>
+// NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+struct op_state : error_storage<env_of_t<Rcvr>, S> {
+    using receiver_t = Rcvr;
+
+    struct stop_callback_fn {
+        auto operator()() -> void { stop_source->request_stop(); }
+        inplace_stop_source *stop_source;
+    };
+
+    template <typename R>
+    constexpr op_state(std::span<S> sndrs, results<V> rs, R &&r)
+        : res{rs}, rcvr{std::forward<R>(r)}, size{std::size(sndrs)},
+          sub_ops{sndrs, [this](std::size_t i) {
+                      return sub_receiver<op_state>{this, i};
+                  }} {}
+    constexpr op_state(op_state &&) = delete;
+
+    template <typename... Args>
+    auto emplace_value(std::size_t i, Args &&...args) -> void {
+        res.store(i, std::forward<Args>(args)...);
+        notify();
+    }
+
+    template <typename... Args> auto notify_error(Args &&...args) -> void {
+        if (not have_error.exchange(true, std::memory_order_relaxed)) {
+            this->store_error(std::forward<Args>(args)...);
+        }
+        stop_source.request_stop();
+        notify();
+    }
+
+    auto notify_stopped() -> void {
+        stop_source.request_stop();
+        notify();
+    }
+
+    auto notify() -> void {
+        if (count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            complete();
+        }
+    }
+
+    auto complete() -> void {
+        stop_cb.reset();
+        if (have_error) {
+            this->release_error(rcvr);
+        } else if (stop_source.stop_requested()) {
+            set_stopped(rcvr);
+        } else {
+            res.send(rcvr, size);
+        }
+    }
+
+    using stop_callback_t = optional_stop_callback_t<
+        stop_token_of_t<env_of_t<Rcvr>>, stop_callback_fn>;
+
+    [[no_unique_address]] results<V> res;
+    [[no_unique_address]] Rcvr rcvr;
+    std::size_t size;
+    std::atomic<std::size_t> count{};
+    inplace_stop_source stop_source{};
+    [[no_unique_address]] stop_callback_t stop_cb{};
+    std::atomic<bool> have_error{};
+    detail::sender_range_ops<N, S, sub_receiver<op_state>> sub_ops;
+
+  private:
+    template <stdx::same_as_unqualified<op_state> O>
+    friend constexpr auto tag_invoke(start_t, O &&o) -> void {
+        o.stop_cb.emplace(get_stop_token(get_env(o.rcvr)),
+                          stop_callback_fn{std::addressof(o.stop_source)});
+        // more than N senders breaks a precondition that when_all_range
+        // asserts; without assertions, nothing runs
+        if (o.size > N or o.stop_source.stop_requested()) {
+            o.stop_cb.reset();
+            set_stopped(std::forward<O>(o).rcvr);
+            return;
+        }
+        if (o.size == 0) {
+            o.complete();
+            return;
+        }
+        o.count.store(o.size, std::memory_order_relaxed);
+        o.sub_ops.start_first(o.size);
+    }
+};
+
+template <std::size_t N, typename S, typename V> struct sender {
+    using is_sender = void;
+
+    std::span<S> sndrs;
+    [[no_unique_address]] results<V> res;
+
+  private:
+    template <stdx::same_as_unqualified<sender> Self, receiver_from<sender> R>
+    [[nodiscard]] friend constexpr auto tag_invoke(connect_t, Self &&self,
+                                                   R &&r)
+        -> op_state<N, S, V, std::remove_cvref_t<R>> {
+        return {self.sndrs, self.res, std::forward<R>(r)};
+    }
+
+    template <typename E>
+    using signatures = boost::mp11::mp_unique<boost::mp11::mp_append<
+        typename results<V>::signatures,
+        typename error_storage<E, S>::signatures,
+        completion_signatures<set_stopped_t()>>>;
+
+    template <typename Env>
+    [[nodiscard]] friend constexpr auto tag_invoke(get_completion_signatures_t,
+                                                   sender const &, Env const &)
+        -> signatures<Env> {
+        return {};
+    }
+};
+} // namespace _when_all_range
+
+// Runs every sender in the range concurrently, up to a capacity of N fixed at
+// compile time, and completes when all of them have. The values each sender
+// sends are stored in the results range at the same index. The range may not
+// be larger than N, and the results range may not be smaller than it.
+template <std::size_t N, typename S, std::size_t SE, typename V,
+          std::size_t VE>
+[[nodiscard]] constexpr auto when_all_range(std::span<S, SE> sndrs,
+                                            std::span<V, VE> results)
+    -> sender auto {
+    if constexpr (SE != std::dynamic_extent) {
+        static_assert(SE <= N, "when_all_range: more senders than capacity");
+        if constexpr (VE != std::dynamic_extent) {
+            static_assert(VE >= SE,
+                          "when_all_range: fewer results than senders");
+        }
+    }
+    assert(std::size(sndrs) <= N and
+           "when_all_range: more senders than capacity");
+    assert(std::size(results) >= std::size(sndrs) and
+           "when_all_range: fewer results than senders");
+    return _when_all_range::sender<N, S, V>{
+        sndrs, _when_all_range::results<V>{results}};
+}
+
+template <std::size_t N, typename S, std::size_t SE>
+[[nodiscard]] constexpr auto when_all_range(std::span<S, SE> sndrs)
+    -> sender auto {
+    if constexpr (SE != std::dynamic_extent) {
+        static_assert(SE <= N, "when_all_range: more senders than capacity");
+    }
+    assert(std::size(sndrs) <= N and
+           "when_all_range: more senders than capacity");
+    return _when_all_range::sender<N, S, void>{sndrs, {}};
+}
 } // namespace async
@@ -3,19 +3,24 @@
 #include <async/compose.hpp>
 #include <async/concepts.hpp>
 #include <async/env.hpp>
+#include <async/sender_range.hpp>
 #include <async/stop_token.hpp>
 #include <async/type_traits.hpp>
-#include <conc/concurrency.hpp>
 
 #include <stdx/concepts.hpp>
 #include <stdx/functional.hpp>
 #include <stdx/tuple.hpp>
 #include <stdx/utility.hpp>
 
+#include <algorithm>
+#include <array>
 #include <atomic>
+#include <cassert>
 #include <concepts>
 #include <cstddef>
 #include <optional>
+#include <span>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 #include <variant>
@@ -81,101 +86,129 @@ struct sub_op_state {
 template <typename... Ts>
 using decayed_tuple = stdx::tuple<std::remove_cvref_t<Ts>...>;
 
+// A policy assigns each completion channel to a slot. Within a slot, the
+// first completion wins: it claims the slot with a single atomic exchange, so
+// deciding the winner needs no critical section. When every sender has
+// completed, the completion in the lowest-numbered occupied slot is reported.
+
 // Policy: when the first sender completes successfully, all other senders are
 // stopped. If no senders complete successfully, the first error is reported.
 // Stopped is reported only if all senders are stopped.
 struct first_successful {
-    template <typename Mutex, typename Tag, typename Completions,
-              typename... Args>
-    static auto emplace(Completions &completions, auto &stop_source,
-                        Args &&...args) -> void {
-        using T = decayed_tuple<Tag, Args...>;
-        using index = boost::mp11::mp_find<Completions, T>;
-        static_assert(index::value < boost::mp11::mp_size<Completions>::value);
-
-        conc::call_in_critical_section<Mutex>([&] {
-            auto const should_store = [&] {
-                if constexpr (std::same_as<Tag, set_value_t>) {
-                    return std::visit(
-                        stdx::overload{
-                            []<typename Tuple>(Tuple const &) {
-                                return not std::same_as<
-                                    boost::mp11::mp_first<Tuple>, set_value_t>;
-                            },
-                            [](std::monostate) { return true; }},
-                        completions);
-                }
-                return completions.index() == 0;
-            }();
-
-            if (should_store) {
-                completions.template emplace<index::value>(
-                    stdx::make_tuple(Tag{}, std::forward<Args>(args)...));
-            }
-        });
-        if constexpr (std::same_as<Tag, set_value_t>) {
-            stop_source.request_stop();
-        }
-    }
+    constexpr static auto num_slots = std::size_t{3};
+    template <typename Tag>
+    constexpr static auto slot = std::same_as<Tag, set_value_t>   ? 0u
+                                 : std::same_as<Tag, set_error_t> ? 1u
+                                                                  : 2u;
+    template <typename Tag>
+    constexpr static auto stops_others = std::same_as<Tag, set_value_t>;
 };
 
 // Policy: when the first sender completes either with success or error, all
 // other senders are stopped. The first success or error is reported. Stopped is
 // reported only if all senders are stopped.
 struct first_noncancelled {
-    template <typename Mutex, typename Tag, typename Completions,
-              typename... Args>
-    static auto emplace(Completions &completions, auto &stop_source,
-                        Args &&...args) -> void {
-        using T = decayed_tuple<Tag, Args...>;
-        using index = boost::mp11::mp_find<Completions, T>;
-        static_assert(index::value < boost::mp11::mp_size<Completions>::value);
-
-        conc::call_in_critical_section<Mutex>([&] {
-            auto const should_store = [&] {
-                if constexpr (std::same_as<Tag, set_stopped_t>) {
-                    return completions.index() == 0;
-                }
-                return std::visit(
-                    stdx::overload{
-                        []<typename Tuple>(Tuple const &) {
-                            return std::same_as<boost::mp11::mp_first<Tuple>,
-                                                set_stopped_t>;
-                        },
-                        [](std::monostate) { return true; }},
-                    completions);
-            }();
-
-            if (should_store) {
-                completions.template emplace<index::value>(
-                    stdx::make_tuple(Tag{}, std::forward<Args>(args)...));
-            }
-        });
-        if constexpr (not std::same_as<Tag, set_stopped_t>) {
-            stop_source.request_stop();
-        }
-    }
+    constexpr static auto num_slots = std::size_t{2};
+    template <typename Tag>
+    constexpr static auto slot = std::same_as<Tag, set_stopped_t> ? 1u : 0u;
+    template <typename Tag>
+    constexpr static auto stops_others = not std::same_as<Tag, set_stopped_t>;
 };
 
 // Policy: when the first sender completes on any channel, all other senders are
 // stopped.
 struct first_complete {
-    template <typename Mutex, typename Tag, typename Completions,
-              typename... Args>
-    static auto emplace(Completions &completions, auto &stop_source,
-                        Args &&...args) -> void {
-        using T = decayed_tuple<Tag, Args...>;
-        using index = boost::mp11::mp_find<Completions, T>;
-        static_assert(index::value < boost::mp11::mp_size<Completions>::value);
-
-        conc::call_in_critical_section<Mutex>([&] {
-            if (completions.index() == 0) {
-                completions.template emplace<index::value>(
-                    stdx::make_tuple(Tag{}, std::forward<Args>(args)...));
-            }
-        });
-        stop_source.request_stop();
+    constexpr static auto num_slots = std::size_t{1};
+    template <typename Tag> constexpr static auto slot = 0u;
+    template <typename Tag> constexpr static auto stops_others = true;
+};
+
+template <typename Completions> struct slot_storage {
+    std::atomic<bool> claimed{};
+    Completions completions{};
+};
+
+template <template <std::size_t> typename SlotCompletions, typename Is>
+struct slots;
+template <template <std::size_t> typename SlotCompletions, std::size_t... Is>
+struct slots<SlotCompletions, std::index_sequence<Is...>> {
+    using type = std::tuple<slot_storage<SlotCompletions<Is>>...>;
+};
+
+// The slots holding the winning completions of some senders run in Env.
+template <typename StopPolicy, typename Env, typename... Sndrs>
+struct completion_slots {
+    template <typename Tag> struct prepend {
+        template <typename L> using fn = boost::mp11::mp_push_front<L, Tag>;
+    };
+
+    template <typename Tag, typename L>
+    using apply_tag = boost::mp11::mp_transform_q<prepend<Tag>, L>;
+
+    template <typename Tag, typename... Ls>
+    using tagged = boost::mp11::mp_append<std::variant<>, apply_tag<Tag, Ls>...>;
+
+    template <std::size_t Slot, typename Tag, typename L>
+    using in_slot =
+        boost::mp11::mp_if_c<StopPolicy::template slot<Tag> == Slot, L,
+                             std::variant<>>;
+
+    template <std::size_t Slot>
+    using slot_completions_t = boost::mp11::mp_unique<boost::mp11::mp_append<
+        std::variant<std::monostate>,
+        in_slot<Slot, set_value_t,
+                tagged<set_value_t,
+                       value_types_of_t<Sndrs, Env, decayed_tuple,
+                                        std::variant>...>>,
+        in_slot<Slot, set_error_t,
+                tagged<set_error_t,
+                       error_types_of_t<Sndrs, Env, decayed_tuple,
+                                        std::variant>...>>,
+        in_slot<Slot, set_stopped_t,
+                tagged<set_stopped_t,
+                       stopped_types_of_t<Sndrs, Env, decayed_tuple,
+                                          std::variant>...>>>>;
+
+    using slots_t =
+        typename slots<slot_completions_t,
+                       std::make_index_sequence<StopPolicy::num_slots>>::type;
+
+    template <typename Tag, typename... Args>
+    auto store(Args &&...args) -> void {
+        auto &s = std::get<StopPolicy::template slot<Tag>>(storage);
+        if (not s.claimed.exchange(true, std::memory_order_relaxed)) {
+            using T = decayed_tuple<Tag, Args...>;
+            using C = std::remove_cvref_t<decltype(s.completions)>;
+            using index = boost::mp11::mp_find<C, T>;
+            static_assert(index::value < boost::mp11::mp_size<C>::value);
+            s.completions.template emplace<index::value>(
+                stdx::make_tuple(Tag{}, std::forward<Args>(args)...));
+        }
+    }
+
+    // Sends the completion in the lowest-numbered occupied slot to r. Returns
+    // false if every slot is empty.
+    template <typename R> auto report(R &r) -> bool {
+        auto const report_slot = [&]<typename C>(C &&c) -> bool {
+            return std::visit(
+                stdx::overload{
+                    [&]<typename T>(T &&t) {
+                        std::forward<T>(t).apply(
+                            [&]<typename... Args>(auto tag, Args &&...args) {
+                                tag(r, std::forward<Args>(args)...);
+                            });
+                        return true;
+                    },
+                    [](std::monostate) { return false; }},
+                std::forward<C>(c));
+        };
+        return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+            return (report_slot(std::move(std::get<Is>(storage).completions)) or
+                    ...);
+        }(std::make_index_sequence<StopPolicy::num_slots>{});
     }
+
+    slots_t storage{};
 };
 
 template <typename StopPolicy, typename Rcvr, typename... Sndrs>
@@ -193,32 +226,18 @@ struct op_state
           rcvr{std::forward<R>(r)} {}
     constexpr op_state(op_state &&) = delete;
 
-    template <typename Tag> struct prepend {
-        template <typename L> using fn = boost::mp11::mp_push_front<L, Tag>;
-    };
-
-    template <typename Tag, typename L>
-    using apply_tag = boost::mp11::mp_transform_q<prepend<Tag>, L>;
-
     using env_t =
         detail::overriding_env<get_stop_token_t, inplace_stop_token, Rcvr>;
 
-    using completions_t = boost::mp11::mp_unique<boost::mp11::mp_append<
-        std::variant<std::monostate>,
-        apply_tag<set_value_t, value_types_of_t<Sndrs, env_t, decayed_tuple,
-                                                std::variant>>...,
-        apply_tag<set_error_t, error_types_of_t<Sndrs, env_t, decayed_tuple,
-                                                std::variant>>...,
-        apply_tag<set_stopped_t, stopped_types_of_t<Sndrs, env_t, decayed_tuple,
-                                                    std::variant>>...>>;
-
-    struct mutex;
-
     template <typename Tag, typename... Args>
     auto emplace(Args &&...args) -> void {
-        StopPolicy::template emplace<mutex, Tag>(completions, stop_source,
-                                                 std::forward<Args>(args)...);
-        if (--count == 0) {
+        slots.template store<Tag>(std::forward<Args>(args)...);
+        if constexpr (StopPolicy::template stops_others<Tag>) {
+            stop_source.request_stop();
+        }
+        // release publishes the stored completion to whichever sub-operation
+        // completes last; it acquires everything the others stored
+        if (count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
             complete();
         }
     }
@@ -232,25 +251,17 @@ struct op_state
                 return;
             }
         }
-        std::visit(stdx::overload{
-                       [&]<typename T>(T &&t) {
-                           std::forward<T>(t).apply(
-                               [&]<typename... Args>(auto tag, Args &&...args) {
-                                   tag(rcvr, std::forward<Args>(args)...);
-                               });
-                       },
-                       [](std::monostate) {}},
-                   std::move(completions));
+        slots.report(rcvr);
     }
 
-    using stop_callback_t =
-        stop_callback_for_t<stop_token_of_t<env_of_t<Rcvr>>, stop_callback_fn>;
+    using stop_callback_t = optional_stop_callback_t<
+        stop_token_of_t<env_of_t<Rcvr>>, stop_callback_fn>;
 
     [[no_unique_address]] Rcvr rcvr;
-    completions_t completions{};
+    completion_slots<StopPolicy, env_t, Sndrs...> slots{};
     std::atomic<std::size_t> count{};
     inplace_stop_source stop_source{};
-    std::optional<stop_callback_t> stop_cb{};
+    [[no_unique_address]] stop_callback_t stop_cb{};
 
   private:
     template <stdx::same_as_unqualified<op_state> O>
@@ -260,7 +271,7 @@ struct op_state
         if (o.stop_source.stop_requested()) {
             set_stopped(std::forward<O>(o).rcvr);
         } else {
-            o.count = sizeof...(Sndrs);
+            o.count.store(sizeof...(Sndrs), std::memory_order_relaxed);
             (start(static_cast<stdx::forward_like_t<
                        O, sub_op_state<op_state, Rcvr, Sndrs>>>(o)
                        .ops),
@@ -311,11 +322,11 @@ struct op_state<StopPolicy, Rcvr> {
         }
         op_state *ops;
     };
-    using stop_callback_t =
-        stop_callback_for_t<stop_token_of_t<env_of_t<Rcvr>>, stop_callback_fn>;
+    using stop_callback_t = optional_stop_callback_t<
+        stop_token_of_t<env_of_t<Rcvr>>, stop_callback_fn>;
 
     [[no_unique_address]] Rcvr rcvr;
-    std::optional<stop_callback_t> stop_cb{};
+    [[no_unique_address]] stop_callback_t stop_cb{};
 
   private:
     template <stdx::same_as_unqualified<op_state> O>
@@ -391,4 +402,144 @@ template <sender Sndr, sender Trigger>
 [[nodiscard]] constexpr auto stop_when(Sndr &&s, Trigger &&t) -> sender auto {
     return std::forward<Sndr>(s) | stop_when(std::forward<Trigger>(t));
 }
+
+namespace _when_any_range {
+template <typename Ops> struct sub_receiver {
+    using is_receiver = void;
+
+    Ops *ops;
+
+  private:
+    template <channel_tag Tag, typename... Args>
+    friend auto tag_invoke(Tag, sub_receiver const &r, Args &&...args) -> void {
+        r.ops->template emplace<Tag>(std::forward<Args>(args)...);
+    }
+
+    [[nodiscard]] friend constexpr auto tag_invoke(get_env_t,
+                                                   sub_receiver const &self)
+        -> detail::overriding_env<get_stop_token_t, inplace_stop_token,
+                                  typename Ops::receiver_t> {
+        return override_env_with<get_stop_token_t>(
+            self.ops->stop_source.get_token(), self.ops->rcvr);
+    }
+};
+
+// The senders race as in when_any, but all have the same type, so their
+// completions share one set of slots: a loser's completion is dropped without
+// being stored anywhere.
+template <std::size_t N, typename StopPolicy, typename S, typename Rcvr>
+// NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+struct op_state {
+    using receiver_t = Rcvr;
+    using env_t =
+        detail::overriding_env<get_stop_token_t, inplace_stop_token, Rcvr>;
+
+    struct stop_callback_fn {
+        auto operator()() -> void { stop_source->request_stop(); }
+        inplace_stop_source *stop_source;
+    };
+
+    template <typename R>
+    constexpr op_state(std::span<S> sndrs, R &&r)
+        : rcvr{std::forward<R>(r)}, size{std::size(sndrs)},
+          sub_ops{sndrs, [this](std::size_t) {
+                      return sub_receiver<op_state>{this};
+                  }} {}
+    constexpr op_state(op_state &&) = delete;
+
+    template <typename Tag, typename... Args>
+    auto emplace(Args &&...args) -> void {
+        slots.template store<Tag>(std::forward<Args>(args)...);
+        if constexpr (StopPolicy::template stops_others<Tag>) {
+            stop_source.request_stop();
+        }
+        if (count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            complete();
+        }
+    }
+
+    auto complete() -> void {
+        stop_cb.reset();
+        if constexpr (not async::unstoppable_token<
+                          async::stop_token_of_t<async::env_of_t<Rcvr>>>) {
+            if (async::get_stop_token(async::get_env(rcvr)).stop_requested()) {
+                set_stopped(rcvr);
+                return;
+            }
+        }
+        if (not slots.report(rcvr)) {
+            set_stopped(rcvr);
+        }
+    }
+
+    using stop_callback_t = optional_stop_callback_t<
+        stop_token_of_t<env_of_t<Rcvr>>, stop_callback_fn>;
+
+    [[no_unique_address]] Rcvr rcvr;
+    std::size_t size;
+    _when_any::completion_slots<StopPolicy, env_t, S> slots{};
+    std::atomic<std::size_t> count{};
+    inplace_stop_source stop_source{};
+    [[no_unique_address]] stop_callback_t stop_cb{};
+    detail::sender_range_ops<N, S, sub_receiver<op_state>> sub_ops;
+
+  private:
+    template <stdx::same_as_unqualified<op_state> O>
+    friend constexpr auto tag_invoke(start_t, O &&o) -> void {
+        o.stop_cb.emplace(get_stop_token(get_env(o.rcvr)),
+                          stop_callback_fn{std::addressof(o.stop_source)});
+        // more than N senders breaks a precondition that when_any_range
+        // asserts; without assertions, nothing runs
+        if (o.size > N or o.stop_source.stop_requested()) {
+            o.stop_cb.reset();
+            set_stopped(std::forward<O>(o).rcvr);
+            return;
+        }
+        if (o.size == 0) {
+            o.complete();
+            return;
+        }
+        o.count.store(o.size, std::memory_order_relaxed);
+        o.sub_ops.start_first(o.size);
+    }
+};
+
+template <std::size_t N, typename StopPolicy, typename S> struct sender {
+    using is_sender = void;
+
+    std::span<S> sndrs;
+
+  private:
+    template <stdx::same_as_unqualified<sender> Self, receiver_from<sender> R>
+    [[nodiscard]] friend constexpr auto tag_invoke(connect_t, Self &&self,
+                                                   R &&r)
+        -> op_state<N, StopPolicy, S, std::remove_cvref_t<R>> {
+        return {self.sndrs, std::forward<R>(r)};
+    }
+
+    template <typename Env>
+    [[nodiscard]] friend constexpr auto tag_invoke(get_completion_signatures_t,
+                                                   sender const &, Env const &)
+        -> boost::mp11::mp_unique<
+            boost::mp11::mp_append<completion_signatures_of_t<S, Env>,
+                                   completion_signatures<set_stopped_t()>>> {
+        return {};
+    }
+};
+} // namespace _when_any_range
+
+// Races every sender in the range, up to a capacity of N fixed at compile
+// time, and completes as when_any does with the same policy. The range may
+// not be larger than N.
+template <std::size_t N, typename StopPolicy = _when_any::first_noncancelled,
+          typename S, std::size_t SE>
+[[nodiscard]] constexpr auto when_any_range(std::span<S, SE> sndrs)
+    -> sender auto {
+    if constexpr (SE != std::dynamic_extent) {
+        static_assert(SE <= N, "when_any_range: more senders than capacity");
+    }
+    assert(std::size(sndrs) <= N and
+           "when_any_range: more senders than capacity");
+    return _when_any_range::sender<N, StopPolicy, S>{sndrs};
+}
 } // namespace async
@@ -0,0 +1,222 @@
+#pragma once
+
+#include <async/compose.hpp>
+#include <async/concepts.hpp>
+#include <async/env.hpp>
+#include <async/schedulers/timer_manager_interface.hpp>
+#include <async/stop_token.hpp>
+#include <async/tags.hpp>
+#include <async/type_traits.hpp>
+#include <async/when_any.hpp>
+
+#include <stdx/concepts.hpp>
+#include <stdx/tuple.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace async {
+namespace _with_deadline {
+template <typename TimePoint, typename Rcvr>
+struct env : detail::forwarding_env<env_of_t<Rcvr>> {
+    inplace_stop_token token;
+    TimePoint deadline;
+
+  private:
+    [[nodiscard]] friend constexpr auto tag_invoke(get_stop_token_t,
+                                                   env const &self)
+        -> inplace_stop_token {
+        return self.token;
+    }
+
+    [[nodiscard]] friend constexpr auto tag_invoke(get_deadline_t,
+                                                   env const &self)
+        -> TimePoint {
+        return self.deadline;
+    }
+};
+
+template <typename Ops, typename Rcvr, typename TimePoint> struct receiver {
+    using is_receiver = void;
+
+    Ops *ops;
+
+  private:
+    template <channel_tag Tag, typename... Args>
+    friend constexpr auto tag_invoke(Tag, receiver const &r, Args &&...args)
+        -> void {
+        r.ops->template complete<Tag>(std::forward<Args>(args)...);
+    }
+
+    [[nodiscard]] friend constexpr auto tag_invoke(async::get_env_t,
+                                                   receiver const &self)
+        -> env<TimePoint, Rcvr> {
+        return {{get_env(self.ops->rcvr)},
+                self.ops->stop_source.get_token(),
+                self.ops->deadline};
+    }
+};
+
+// An enclosing deadline of the same type that is earlier still applies.
+template <typename TimePoint, typename Rcvr>
+constexpr auto effective_deadline(TimePoint tp, Rcvr const &r) -> TimePoint {
+    if constexpr (std::same_as<deadline_of_t<env_of_t<Rcvr>>, TimePoint>) {
+        return std::min(tp, get_deadline(get_env(r)));
+    } else {
+        return tp;
+    }
+}
+
+// The op state is its own timer task. At the deadline it requests stop on
+// the stop source that the wrapped sender sees, which also forwards stop
+// requests from downstream. The wrapped sender's completion is stored, and
+// the timer keeps a share of the completion count until its request_stop
+// returns, so a completion from inside that request_stop cannot destroy the
+// op state under it.
+template <typename Domain, typename Task, typename TimePoint, typename Sndr,
+          typename Rcvr>
+// NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+struct op_state final : Task {
+    using receiver_t = receiver<op_state, Rcvr, TimePoint>;
+
+    template <typename S, stdx::same_as_unqualified<Rcvr> R>
+    constexpr op_state(S &&s, R &&r, TimePoint tp)
+        : Task{run_task<op_state>}, rcvr{std::forward<R>(r)},
+          deadline{effective_deadline(tp, rcvr)},
+          state{connect(std::forward<S>(s), receiver_t{this})} {}
+    constexpr op_state(op_state &&) = delete;
+
+    auto run() -> void {
+        stop_source.request_stop();
+        release();
+    }
+
+    template <typename Tag, typename... Args>
+    auto complete(Args &&...args) -> void {
+        slots.template store<Tag>(std::forward<Args>(args)...);
+        if (timer_mgr::detail::cancel<Domain>(*this)) {
+            release();
+        }
+        release();
+    }
+
+    auto release() -> void {
+        if (count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            stop_cb.reset();
+            slots.report(rcvr);
+        }
+    }
+
+    struct stop_callback_fn {
+        auto operator()() -> void { stop_source->request_stop(); }
+        inplace_stop_source *stop_source;
+    };
+
+    using state_t = connect_result_t<Sndr, receiver_t>;
+    using stop_callback_t = optional_stop_callback_t<
+        stop_token_of_t<env_of_t<Rcvr>>, stop_callback_fn>;
+
+    [[no_unique_address]] Rcvr rcvr;
+    TimePoint deadline;
+    std::atomic<int> count{};
+    _when_any::completion_slots<_when_any::first_complete, env<TimePoint, Rcvr>,
+                                Sndr>
+        slots{};
+    inplace_stop_source stop_source{};
+    [[no_unique_address]] stop_callback_t stop_cb{};
+    state_t state;
+
+  private:
+    template <stdx::same_as_unqualified<op_state> O>
+    friend constexpr auto tag_invoke(start_t, O &&o) -> void {
+        // one share for the wrapped sender, one for the timer
+        o.count.store(2, std::memory_order_relaxed);
+        if constexpr (not unstoppable_token<stop_token_of_t<env_of_t<Rcvr>>>) {
+            auto token = get_stop_token(get_env(o.rcvr));
+            if (token.stop_requested()) {
+                set_stopped(std::forward<O>(o).rcvr);
+                return;
+            }
+            o.stop_cb.emplace(token,
+                              stop_callback_fn{std::addressof(o.stop_source)});
+        }
+        timer_mgr::detail::run_at<Domain>(o, o.deadline);
+        start(o.state);
+    }
+};
+
+template <typename Domain, typename Task, typename TimePoint, typename Sndr>
+struct sender {
+    using is_sender = void;
+    [[no_unique_address]] Sndr sndr;
+    TimePoint deadline;
+
+  private:
+    template <typename Env>
+    [[nodiscard]] friend constexpr auto
+    tag_invoke(get_completion_signatures_t, sender const &, Env const &)
+        -> transform_completion_signatures_of<
+            Sndr, Env, completion_signatures<set_stopped_t()>> {
+        return {};
+    }
+
+    [[nodiscard]] friend constexpr auto tag_invoke(async::get_env_t,
+                                                   sender const &self) {
+        return forward_env_of(self.sndr);
+    }
+
+    template <receiver_from<Sndr> R>
+    [[nodiscard]] friend constexpr auto tag_invoke(connect_t, sender &&self,
+                                                   R &&r)
+        -> op_state<Domain, Task, TimePoint, Sndr, std::remove_cvref_t<R>> {
+        return {std::move(self).sndr, std::forward<R>(r), self.deadline};
+    }
+
+    template <stdx::same_as_unqualified<sender> Self, receiver_from<Sndr> R>
+        requires multishot_sender<Sndr, R>
+    [[nodiscard]] friend constexpr auto tag_invoke(connect_t, Self &&self,
+                                                   R &&r)
+        -> op_state<Domain, Task, TimePoint, Sndr, std::remove_cvref_t<R>> {
+        return {std::forward<Self>(self).sndr, std::forward<R>(r),
+                self.deadline};
+    }
+};
+
+template <typename Domain, typename Task, typename TimePoint> struct pipeable {
+    TimePoint deadline;
+
+  private:
+    template <async::sender S, stdx::same_as_unqualified<pipeable> Self>
+    friend constexpr auto operator|(S &&s, Self &&self) -> async::sender auto {
+        return sender<Domain, Task, TimePoint, std::remove_cvref_t<S>>{
+            std::forward<S>(s), self.deadline};
+    }
+};
+} // namespace _with_deadline
+
+// Requests stop on the wrapped sender at the time point tp, with one timer in
+// Domain, so that work whose result is no longer wanted is dropped rather
+// than run to completion. Schedulers and senders that check their stop token
+// (as the task manager schedulers do before running a task) then complete
+// with set_stopped. The deadline is also available to the wrapped sender with
+// the get_deadline query.
+template <typename Domain = timer_mgr::default_domain, typename TimePoint,
+          typename Task = timer_task<TimePoint>>
+[[nodiscard]] constexpr auto with_deadline(TimePoint tp) {
+    static_assert(timer_mgr::detail::valid_time_point<TimePoint, Domain>(),
+                  "with_deadline has invalid time point type for the injected "
+                  "timer manager");
+    return _compose::adaptor{
+        stdx::tuple{_with_deadline::pipeable<Domain, Task, TimePoint>{tp}}};
+}
+
+template <typename Domain = timer_mgr::default_domain, sender S,
+          typename TimePoint, typename Task = timer_task<TimePoint>>
+[[nodiscard]] constexpr auto with_deadline(S &&s, TimePoint tp) {
+    return std::forward<S>(s) | with_deadline<Domain, TimePoint, Task>(tp);
+}
+} // namespace async
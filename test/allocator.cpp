@@ -1,6 +1,8 @@
 #include "detail/common.hpp"
 
 #include <async/allocator.hpp>
+#include <async/arena_allocator.hpp>
+#include <async/pool_allocator.hpp>
 #include <async/schedulers/inline_scheduler.hpp>
 #include <async/schedulers/thread_scheduler.hpp>
 #include <async/sequence.hpp>
@@ -8,8 +10,17 @@
 #include <async/static_allocator.hpp>
 #include <async/then.hpp>
 
+#include <catch2/catch_template_test_macros.hpp>
 #include <catch2/catch_test_macros.hpp>
 
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
 TEST_CASE("default allocator is static_allocator", "[allocator]") {
     static_assert(std::is_same_v<async::allocator_of_t<async::empty_env>,
                                  async::static_allocator>);
@@ -86,10 +97,10 @@ TEST_CASE("static allocate more than 1", "[allocator]") {
                     auto x = alloc.construct<multi_domain, S>(
                         [](auto &&) { CHECK(false); }, 0);
                     CHECK(not x);
-                    alloc.destruct<domain>(&q);
+                    alloc.destruct<multi_domain>(&q);
                 },
                 17));
-            alloc.destruct<domain>(&p);
+            alloc.destruct<multi_domain>(&p);
         },
         42));
 }
@@ -134,6 +145,95 @@ TEST_CASE("stack allocate rvalues", "[allocator]") {
         [&](counter) { CHECK(construction_count == 1); }, 42));
 }
 
+namespace {
+struct wide_domain;
+struct concurrent_domain;
+} // namespace
+
+template <>
+constexpr inline auto async::static_allocation_limit<wide_domain> =
+    std::size_t{40};
+
+template <>
+constexpr inline auto async::static_allocation_limit<concurrent_domain> =
+    std::size_t{3};
+
+TEST_CASE("static allocate across bitmap words", "[allocator]") {
+    auto &a = async::detail::static_allocator_v<wide_domain, S, 40>;
+    std::vector<S *> ps{};
+    for (auto i = 0; i < 40; ++i) {
+        auto p = a.construct(i);
+        REQUIRE(p != nullptr);
+        ps.push_back(p);
+    }
+    CHECK(a.construct(40) == nullptr);
+
+    a.destruct(ps[35]);
+    auto p = a.construct(35);
+    CHECK(p == ps[35]);
+    for (auto q : ps) {
+        a.destruct(q);
+    }
+}
+
+TEMPLATE_TEST_CASE_SIG("static allocate and free churn", "[allocator]",
+                       ((std::size_t N), N), 8, 64, 1024) {
+    using A = async::detail::static_allocator_t<wide_domain, S, N>;
+    auto a = std::make_unique<A>();
+    std::vector<S *> ps{};
+    for (auto i = std::size_t{}; i < N; ++i) {
+        ps.push_back(a->construct(static_cast<int>(i)));
+        REQUIRE(ps.back() != nullptr);
+    }
+    CHECK(a->construct(0) == nullptr);
+
+    // free and reclaim slots in a scattered order
+    for (auto round = std::size_t{}; round < 4; ++round) {
+        for (auto i = round; i < N; i += 5) {
+            a->destruct(ps[i]);
+        }
+        for (auto i = round; i < N; i += 5) {
+            ps[i] = a->construct(static_cast<int>(i));
+            REQUIRE(ps[i] != nullptr);
+        }
+        CHECK(a->construct(0) == nullptr);
+    }
+    for (auto i = std::size_t{}; i < N; ++i) {
+        CHECK(ps[i]->i == static_cast<int>(i));
+        a->destruct(ps[i]);
+    }
+}
+
+TEST_CASE("static allocate concurrently", "[allocator]") {
+    auto alloc = async::static_allocator{};
+    std::atomic<int> allocated{};
+    std::atomic<int> clobbered{};
+    auto work = [&](int id) {
+        for (auto i = 0; i < 1000; ++i) {
+            alloc.construct<concurrent_domain, S>(
+                [&](auto &&s) {
+                    ++allocated;
+                    std::this_thread::yield();
+                    if (s.i != id) {
+                        ++clobbered;
+                    }
+                    alloc.destruct<concurrent_domain>(&s);
+                },
+                id);
+        }
+    };
+    std::thread t1{work, 1};
+    std::thread t2{work, 2};
+    std::thread t3{work, 3};
+    std::thread t4{work, 4};
+    t1.join();
+    t2.join();
+    t3.join();
+    t4.join();
+    CHECK(allocated > 0);
+    CHECK(clobbered == 0);
+}
+
 TEST_CASE("static allocator is an allocator", "[allocator]") {
     static_assert(async::allocator<async::static_allocator>);
 }
@@ -141,3 +241,178 @@ TEST_CASE("static allocator is an allocator", "[allocator]") {
 TEST_CASE("stack allocator is an allocator", "[allocator]") {
     static_assert(async::allocator<async::stack_allocator>);
 }
+
+namespace {
+struct stats_domain;
+
+template <typename Name>
+concept has_allocation_stats =
+    requires { async::static_allocation_stats<Name>(); };
+} // namespace
+
+template <>
+constexpr inline auto async::static_allocation_limit<stats_domain> =
+    std::size_t{2};
+
+template <>
+constexpr inline auto async::static_allocation_stats_enabled<stats_domain> =
+    true;
+
+TEST_CASE("static allocation stats are not kept by default", "[allocator]") {
+    static_assert(not has_allocation_stats<domain>);
+    static_assert(has_allocation_stats<stats_domain>);
+}
+
+TEST_CASE("static allocation stats track use and failures", "[allocator]") {
+    auto alloc = async::static_allocator{};
+    auto stats = async::static_allocation_stats<stats_domain>();
+    CHECK(stats.current == 0);
+    CHECK(stats.peak == 0);
+    CHECK(stats.failed == 0);
+
+    CHECK(alloc.construct<stats_domain, S>(
+        [&](auto &&p) {
+            CHECK(async::static_allocation_stats<stats_domain>().current == 1);
+            CHECK(alloc.construct<stats_domain, S>(
+                [&](auto &&q) {
+                    CHECK(not alloc.construct<stats_domain, S>(
+                        [](auto &&) { CHECK(false); }, 0));
+                    alloc.destruct<stats_domain>(&q);
+                },
+                17));
+            alloc.destruct<stats_domain>(&p);
+        },
+        42));
+
+    stats = async::static_allocation_stats<stats_domain>();
+    CHECK(stats.current == 0);
+    CHECK(stats.peak == 2);
+    CHECK(stats.failed == 1);
+}
+
+namespace {
+struct pool_domain_a;
+struct pool_domain_b;
+
+struct big {
+    big(int x) : i{x} {}
+    int i;
+    std::array<char, 40> pad{};
+};
+
+using small_pool =
+    async::pool_allocator<async::pool_size_class<sizeof(S), 1>,
+                          async::pool_size_class<64, 1>>;
+} // namespace
+
+TEST_CASE("pool allocator is an allocator", "[allocator]") {
+    static_assert(async::allocator<small_pool>);
+}
+
+TEST_CASE("pool allocator is shared between domains", "[allocator]") {
+    auto alloc = small_pool{};
+    S *first{};
+    CHECK(alloc.construct<pool_domain_a, S>(
+        [&](auto &&s) {
+            first = &s;
+            CHECK(s.i == 42);
+        },
+        42));
+
+    S *second{};
+    CHECK(alloc.construct<pool_domain_b, S>(
+        [&](auto &&s) { second = &s; }, 17));
+    CHECK(second != nullptr);
+    CHECK(second != first);
+
+    CHECK(not alloc.construct<pool_domain_a, S>([](auto &&) { CHECK(false); },
+                                                0));
+
+    alloc.destruct<pool_domain_a>(first);
+    alloc.destruct<pool_domain_b>(second);
+}
+
+TEST_CASE("pool allocator reuses freed blocks", "[allocator]") {
+    auto alloc = small_pool{};
+    S *first{};
+    CHECK(alloc.construct<pool_domain_a, S>([&](auto &&s) { first = &s; },
+                                            42));
+    alloc.destruct<pool_domain_a>(first);
+
+    S *second{};
+    CHECK(alloc.construct<pool_domain_b, S>([&](auto &&s) { second = &s; },
+                                            17));
+    CHECK(second == first);
+    alloc.destruct<pool_domain_b>(second);
+}
+
+TEST_CASE("pool allocator places objects by size", "[allocator]") {
+    auto alloc = small_pool{};
+    big *b{};
+    CHECK(alloc.construct<pool_domain_a, big>([&](auto &&x) { b = &x; }, 42));
+    CHECK(not alloc.construct<pool_domain_a, big>(
+        [](auto &&) { CHECK(false); }, 0));
+
+    S *s{};
+    CHECK(alloc.construct<pool_domain_b, S>([&](auto &&x) { s = &x; }, 17));
+    alloc.destruct<pool_domain_a>(b);
+    alloc.destruct<pool_domain_b>(s);
+}
+
+namespace {
+struct test_arena;
+using arena = async::arena_allocator<test_arena>;
+} // namespace
+
+TEST_CASE("arena allocator is an allocator", "[allocator]") {
+    static_assert(async::allocator<arena>);
+}
+
+TEST_CASE("arena allocator bump-allocates until full", "[allocator]") {
+    alignas(S) std::array<std::byte, 2 * sizeof(S)> buffer{};
+    arena::set_buffer(buffer);
+    auto alloc = arena{};
+
+    S *first{};
+    CHECK(alloc.construct<domain, S>([&](auto &&s) { first = &s; }, 42));
+    S *second{};
+    CHECK(alloc.construct<multi_domain, S>([&](auto &&s) { second = &s; },
+                                           17));
+    CHECK(second == first + 1);
+    CHECK(arena::bytes_used() == 2 * sizeof(S));
+
+    alloc.destruct<domain>(first);
+    CHECK(not alloc.construct<domain, S>([](auto &&) { CHECK(false); }, 0));
+    alloc.destruct<multi_domain>(second);
+}
+
+TEST_CASE("arena allocator resets in bulk", "[allocator]") {
+    alignas(S) std::array<std::byte, sizeof(S)> buffer{};
+    arena::set_buffer(buffer);
+    auto alloc = arena{};
+
+    S *first{};
+    CHECK(alloc.construct<domain, S>([&](auto &&s) { first = &s; }, 42));
+    alloc.destruct<domain>(first);
+
+    arena::reset();
+    CHECK(arena::bytes_used() == 0);
+    S *second{};
+    CHECK(alloc.construct<domain, S>([&](auto &&s) { second = &s; }, 17));
+    CHECK(second == first);
+    CHECK(second->i == 17);
+    alloc.destruct<domain>(second);
+}
+
+TEST_CASE("arena allocator respects alignment", "[allocator]") {
+    alignas(std::uint64_t) std::array<std::byte, 16> buffer{};
+    arena::set_buffer(buffer);
+    auto alloc = arena{};
+
+    CHECK(alloc.construct<domain, char>([](auto &&) {}, 'a'));
+    std::uint64_t *p{};
+    CHECK(alloc.construct<domain, std::uint64_t>([&](auto &&x) { p = &x; },
+                                                 1u));
+    CHECK(stdx::bit_cast<std::uintptr_t>(p) % alignof(std::uint64_t) == 0);
+    CHECK(arena::bytes_used() == 16);
+}
@@ -0,0 +1,147 @@
+#include "detail/common.hpp"
+
+#include <async/any_sender.hpp>
+#include <async/concepts.hpp>
+#include <async/env.hpp>
+#include <async/just.hpp>
+#include <async/read_env.hpp>
+#include <async/schedulers/inline_scheduler.hpp>
+#include <async/stop_token.hpp>
+#include <async/tags.hpp>
+#include <async/then.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <concepts>
+#include <utility>
+
+TEST_CASE("any_sender erases a sender", "[any_sender]") {
+    int value{};
+    auto s = async::any_sender_of<async::set_value_t(int)>{async::just(42)};
+    static_assert(async::sender_of<decltype(s), async::set_value_t(int)>);
+    auto op = async::connect(s, receiver{[&](int i) { value = i; }});
+    async::start(op);
+    CHECK(value == 42);
+}
+
+TEST_CASE("any_senders of different types can share a table",
+          "[any_sender]") {
+    using handler_t = async::any_sender_of<async::set_value_t(int)>;
+    auto const handlers = std::array{
+        handler_t{async::just(1)},
+        handler_t{async::inline_scheduler::schedule() |
+                  async::then([] { return 2; })},
+        handler_t{async::just(2) | async::then([](int i) { return i + 1; })}};
+
+    int sum{};
+    for (auto const &h : handlers) {
+        auto op = async::connect(h, receiver{[&](int i) { sum += i; }});
+        async::start(op);
+    }
+    CHECK(sum == 6);
+}
+
+TEST_CASE("any_sender can be copied and moved", "[any_sender]") {
+    auto const check = [](auto const &s) {
+        int value{};
+        auto op = async::connect(s, receiver{[&](int i) { value = i; }});
+        async::start(op);
+        CHECK(value == 42);
+    };
+
+    auto s1 = async::any_sender_of<async::set_value_t(int)>{async::just(42)};
+    auto s2 = s1;
+    auto s3 = std::move(s1);
+    s1 = s2;
+    check(s1);
+    check(s2);
+    check(s3);
+}
+
+TEST_CASE("any_sender completes on any of its channels", "[any_sender]") {
+    int value{};
+    auto s = async::any_sender_of<async::set_value_t(int),
+                                  async::set_error_t(int)>{
+        async::just_error(17)};
+    auto op = async::connect(s, error_receiver{[&](int i) { value = i; }});
+    async::start(op);
+    CHECK(value == 17);
+}
+
+TEST_CASE("any_sender storage sizes are configurable", "[any_sender]") {
+    using small_t =
+        async::basic_any_sender<sizeof(int), 4 * sizeof(void *),
+                                async::set_value_t(int)>;
+    int value{};
+    auto s = small_t{async::just(42)};
+    auto op = async::connect(std::move(s), receiver{[&](int i) { value = i; }});
+    async::start(op);
+    CHECK(value == 42);
+}
+
+TEST_CASE("any_receiver_ref forwards a stop token only if it accepts "
+          "set_stopped",
+          "[any_sender]") {
+    using value_ref_t = async::any_receiver_ref<async::set_value_t()>;
+    using stoppable_ref_t =
+        async::any_receiver_ref<async::set_value_t(), async::set_stopped_t()>;
+    static_assert(
+        std::same_as<async::env_of_t<value_ref_t>, async::empty_env>);
+    static_assert(
+        std::same_as<async::stop_token_of_t<async::env_of_t<stoppable_ref_t>>,
+                     async::inplace_stop_token>);
+}
+
+TEST_CASE("any_sender forwards the receiver's stop token", "[any_sender]") {
+    bool stopped{};
+    auto s = async::any_sender_of<async::set_value_t(), async::set_stopped_t()>{
+        async::get_stop_token() |
+        async::then([&](auto token) { stopped = token.stop_requested(); })};
+    auto r = stoppable_receiver{[] {}};
+    auto op = async::connect(s, r);
+    r.request_stop();
+    async::start(op);
+    CHECK(stopped);
+}
+
+namespace {
+struct single_stoppable_receiver {
+    using is_receiver = void;
+
+    struct env {
+        async::single_inplace_stop_token token;
+
+      private:
+        [[nodiscard]] friend constexpr auto tag_invoke(async::get_stop_token_t,
+                                                       env const &self) {
+            return self.token;
+        }
+    };
+
+    async::single_inplace_stop_source *source;
+
+  private:
+    [[nodiscard]] friend constexpr auto
+    tag_invoke(async::get_env_t, single_stoppable_receiver const &self)
+        -> env {
+        return {self.source->get_token()};
+    }
+
+    friend constexpr auto tag_invoke(async::channel_tag auto,
+                                     single_stoppable_receiver const &,
+                                     auto &&...) -> void {}
+};
+} // namespace
+
+TEST_CASE("any_sender bridges another kind of stop token", "[any_sender]") {
+    bool stopped{};
+    auto s = async::any_sender_of<async::set_value_t(), async::set_stopped_t()>{
+        async::get_stop_token() |
+        async::then([&](auto token) { stopped = token.stop_requested(); })};
+    auto source = async::single_inplace_stop_source{};
+    auto op = async::connect(s, single_stoppable_receiver{&source});
+    source.request_stop();
+    async::start(op);
+    CHECK(stopped);
+}
@@ -0,0 +1,89 @@
+#include "detail/common.hpp"
+
+#include <async/async_scope.hpp>
+#include <async/just.hpp>
+#include <async/schedulers/priority_scheduler.hpp>
+#include <async/schedulers/task_manager.hpp>
+#include <async/start_detached.hpp>
+#include <async/then.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace {
+struct hal {
+    static auto schedule(async::priority_t) {}
+};
+
+using task_manager_t = async::priority_task_manager<hal, 8>;
+} // namespace
+
+template <> inline auto async::injected_task_manager<> = task_manager_t{};
+
+TEST_CASE("spawn starts the operation", "[async_scope]") {
+    async::async_scope scope{};
+    int var{};
+    using S = async::fixed_priority_scheduler<0>;
+    auto s = S::schedule() | async::then([&] { var = 42; });
+    CHECK(scope.spawn(s));
+    CHECK(scope.outstanding_count() == 1);
+    async::task_mgr::service_tasks<0>();
+    CHECK(var == 42);
+    CHECK(scope.outstanding_count() == 0);
+}
+
+TEST_CASE("join completes immediately for an empty scope", "[async_scope]") {
+    async::async_scope scope{};
+    int var{};
+    auto j = scope.join() | async::then([&] { var = 42; });
+    CHECK(async::start_detached(j));
+    CHECK(var == 42);
+}
+
+TEST_CASE("join completes when all spawned work completes",
+          "[async_scope]") {
+    async::async_scope scope{};
+    int var{};
+    int joined{};
+    using S = async::fixed_priority_scheduler<0>;
+    auto s = S::schedule() | async::then([&] { ++var; });
+    CHECK(scope.spawn<struct spawn_0>(s));
+    CHECK(scope.spawn<struct spawn_1>(s));
+
+    auto j = scope.join() | async::then([&] { joined = var; });
+    CHECK(async::start_detached(j));
+    CHECK(joined == 0);
+
+    async::task_mgr::service_tasks<0>();
+    CHECK(var == 2);
+    CHECK(joined == 2);
+}
+
+TEST_CASE("request_stop cancels all spawned work", "[async_scope]") {
+    async::async_scope scope{};
+    int var{};
+    int stopped{};
+    using S = async::fixed_priority_scheduler<0>;
+    auto s = S::schedule()                 //
+             | async::then([&] { ++var; }) //
+             | async::upon_stopped([&] { ++stopped; });
+    CHECK(scope.spawn<struct stop_0>(s));
+    CHECK(scope.spawn<struct stop_1>(s));
+    CHECK(scope.request_stop());
+
+    async::task_mgr::service_tasks<0>();
+    CHECK(var == 0);
+    CHECK(stopped == 2);
+    CHECK(scope.outstanding_count() == 0);
+}
+
+TEST_CASE("failed spawn does not count as outstanding", "[async_scope]") {
+    async::async_scope scope{};
+    using S = async::fixed_priority_scheduler<0>;
+    auto s = S::schedule();
+    using Name = decltype([] {});
+    CHECK(scope.spawn<Name>(s));
+    CHECK(not scope.spawn<Name>(s));
+    CHECK(scope.outstanding_count() == 1);
+    async::task_mgr::service_tasks<0>();
+    CHECK(scope.outstanding_count() == 0);
+}
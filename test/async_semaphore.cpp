@@ -0,0 +1,119 @@
+#include "detail/common.hpp"
+
+#include <async/async_semaphore.hpp>
+#include <async/concepts.hpp>
+#include <async/type_traits.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <concepts>
+#include <vector>
+
+TEST_CASE("semaphore and mutex senders are senders", "[async_semaphore]") {
+    auto sem = async::async_semaphore<2>{};
+    auto m = async::async_mutex{};
+    static_assert(async::sender<decltype(sem.acquire())>);
+    static_assert(async::sender<decltype(m.lock())>);
+}
+
+TEST_CASE("acquire advertises set_stopped only when stoppable",
+          "[async_semaphore]") {
+    auto sem = async::async_semaphore<2>{};
+    static_assert(
+        std::same_as<async::completion_signatures_of_t<decltype(sem.acquire())>,
+                     async::completion_signatures<async::set_value_t()>>);
+
+    [[maybe_unused]] auto r = stoppable_receiver([] {});
+    static_assert(
+        std::same_as<async::completion_signatures_of_t<
+                         decltype(sem.acquire()), async::env_of_t<decltype(r)>>,
+                     async::completion_signatures<async::set_value_t(),
+                                                  async::set_stopped_t()>>);
+}
+
+TEST_CASE("acquire completes while permits are free", "[async_semaphore]") {
+    auto sem = async::async_semaphore<2>{};
+    int acquired{};
+    auto op1 = async::connect(sem.acquire(), receiver{[&] { ++acquired; }});
+    auto op2 = async::connect(sem.acquire(), receiver{[&] { ++acquired; }});
+    auto op3 = async::connect(sem.acquire(), receiver{[&] { ++acquired; }});
+    async::start(op1);
+    async::start(op2);
+    CHECK(acquired == 2);
+    CHECK(sem.available() == 0);
+
+    async::start(op3);
+    CHECK(acquired == 2);
+
+    sem.release();
+    CHECK(acquired == 3);
+    CHECK(sem.available() == 0);
+
+    sem.release();
+    sem.release();
+    CHECK(sem.available() == 2);
+}
+
+TEST_CASE("waiting operations are served in order", "[async_semaphore]") {
+    auto m = async::async_mutex{};
+    std::vector<int> order{};
+    auto op1 = async::connect(m.lock(), receiver{[&] { order.push_back(1); }});
+    auto op2 = async::connect(m.lock(), receiver{[&] { order.push_back(2); }});
+    auto op3 = async::connect(m.lock(), receiver{[&] { order.push_back(3); }});
+    async::start(op1);
+    async::start(op2);
+    async::start(op3);
+    CHECK(order == std::vector{1});
+    CHECK(m.is_locked());
+
+    m.unlock();
+    CHECK(order == std::vector{1, 2});
+    m.unlock();
+    CHECK(order == std::vector{1, 2, 3});
+    m.unlock();
+    CHECK(not m.is_locked());
+}
+
+TEST_CASE("stopping a waiting lock unlinks it", "[async_semaphore]") {
+    auto m = async::async_mutex{};
+    auto op1 = async::connect(m.lock(), receiver{[] {}});
+    async::start(op1);
+
+    int value{};
+    auto r = stoppable_receiver{[&] { value = 17; }};
+    auto op2 = async::connect(m.lock(), r);
+    async::start(op2);
+    r.request_stop();
+    CHECK(value == 17);
+
+    m.unlock();
+    CHECK(not m.is_locked());
+}
+
+TEST_CASE("a stopped lock does not wait", "[async_semaphore]") {
+    auto m = async::async_mutex{};
+    int value{};
+    auto r = stoppable_receiver{[&] { value = 17; }};
+    r.request_stop();
+    auto op = async::connect(m.lock(), r);
+    async::start(op);
+    CHECK(value == 17);
+    CHECK(not m.is_locked());
+}
+
+TEST_CASE("a lock that is given the mutex no longer listens for stop",
+          "[async_semaphore]") {
+    auto m = async::async_mutex{};
+    auto op1 = async::connect(m.lock(), receiver{[] {}});
+    async::start(op1);
+
+    int calls{};
+    auto r = stoppable_receiver{[&] { ++calls; }};
+    auto op2 = async::connect(m.lock(), r);
+    async::start(op2);
+    m.unlock();
+    CHECK(calls == 1);
+    r.request_stop();
+    CHECK(calls == 1);
+    CHECK(m.is_locked());
+}
@@ -0,0 +1,70 @@
+#include "detail/common.hpp"
+
+#include <async/bulk.hpp>
+#include <async/concepts.hpp>
+#include <async/just.hpp>
+#include <async/schedulers/inline_scheduler.hpp>
+#include <async/schedulers/static_thread_pool.hpp>
+#include <async/sync_wait.hpp>
+#include <async/then.hpp>
+#include <async/type_traits.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <vector>
+
+TEST_CASE("bulk calls the function for each index in order", "[bulk]") {
+    std::vector<int> indices{};
+    int value{};
+    auto s = async::inline_scheduler::schedule() |
+             async::then([] { return 3; }) |
+             async::bulk(4, [&](int i, int v) { indices.push_back(i * v); });
+    auto op = async::connect(s, receiver{[&](int v) { value = v; }});
+    async::start(op);
+    CHECK(indices == std::vector{0, 3, 6, 9});
+    CHECK(value == 3);
+}
+
+TEST_CASE("bulk on a sender without a completion scheduler", "[bulk]") {
+    int sum{};
+    auto s = async::just(2) | async::bulk(5, [&](int i, int v) { sum += i * v; });
+    static_assert(
+        std::same_as<async::completion_signatures_of_t<decltype(s)>,
+                     async::completion_signatures<async::set_value_t(int)>>);
+    auto op = async::connect(s, receiver{[] {}});
+    async::start(op);
+    CHECK(sum == 20);
+}
+
+TEST_CASE("bulk passes errors through without calling the function",
+          "[bulk]") {
+    int calls{};
+    int value{};
+    auto s = async::just_error(42) | async::bulk(5, [&](int) { ++calls; });
+    auto op = async::connect(s, error_receiver{[&](int v) { value = v; }});
+    async::start(op);
+    CHECK(calls == 0);
+    CHECK(value == 42);
+}
+
+TEST_CASE("bulk on a thread pool spreads the work over its threads",
+          "[bulk]") {
+    async::static_thread_pool<4> pool{};
+    std::array<std::atomic<int>, 100> results{};
+    auto s = pool.get_scheduler().schedule() | async::then([] { return 2; }) |
+             async::bulk(std::size_t{100}, [&](std::size_t i, int v) {
+                 results[i] = static_cast<int>(i) * v;
+             });
+    static_assert(async::sender_of<decltype(s), async::set_value_t(int)>);
+
+    auto const v = s | async::sync_wait();
+    REQUIRE(v.has_value());
+    CHECK(get<0>(*v) == 2);
+    for (auto i = std::size_t{}; i < results.size(); ++i) {
+        CHECK(results[i] == static_cast<int>(i) * 2);
+    }
+}
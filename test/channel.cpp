@@ -0,0 +1,172 @@
+#include "detail/common.hpp"
+
+#include <async/channel.hpp>
+#include <async/concepts.hpp>
+#include <async/type_traits.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <concepts>
+#include <vector>
+
+TEST_CASE("channel senders are senders", "[channel]") {
+    auto c = async::channel<int, 2>{};
+    static_assert(async::sender<decltype(c.send(42))>);
+    static_assert(async::sender<decltype(c.receive())>);
+}
+
+TEST_CASE("channel senders advertise set_stopped only when stoppable",
+          "[channel]") {
+    auto c = async::channel<int, 2>{};
+    static_assert(
+        std::same_as<async::completion_signatures_of_t<decltype(c.send(42))>,
+                     async::completion_signatures<async::set_value_t()>>);
+    static_assert(
+        std::same_as<async::completion_signatures_of_t<decltype(c.receive())>,
+                     async::completion_signatures<async::set_value_t(int)>>);
+
+    [[maybe_unused]] auto r = stoppable_receiver([] {});
+    static_assert(
+        std::same_as<async::completion_signatures_of_t<
+                         decltype(c.receive()), async::env_of_t<decltype(r)>>,
+                     async::completion_signatures<async::set_value_t(int),
+                                                  async::set_stopped_t()>>);
+}
+
+TEST_CASE("values are received in the order they were sent", "[channel]") {
+    auto c = async::channel<int, 4>{};
+    int sent{};
+    for (auto i = 1; i <= 3; ++i) {
+        auto op = async::connect(c.send(i), receiver{[&] { ++sent; }});
+        async::start(op);
+    }
+    CHECK(sent == 3);
+    CHECK(c.size() == 3);
+
+    std::vector<int> received{};
+    for (auto i = 0; i < 3; ++i) {
+        auto op = async::connect(
+            c.receive(), receiver{[&](int v) { received.push_back(v); }});
+        async::start(op);
+    }
+    CHECK(received == std::vector{1, 2, 3});
+    CHECK(c.size() == 0);
+}
+
+TEST_CASE("receive waits for a value", "[channel]") {
+    auto c = async::channel<int, 2>{};
+    int value{};
+    auto rop =
+        async::connect(c.receive(), receiver{[&](int v) { value = v; }});
+    async::start(rop);
+    CHECK(value == 0);
+
+    bool sent{};
+    auto sop = async::connect(c.send(42), receiver{[&] { sent = true; }});
+    async::start(sop);
+    CHECK(value == 42);
+    CHECK(sent);
+    CHECK(c.size() == 0);
+}
+
+TEST_CASE("send waits for space", "[channel]") {
+    auto c = async::channel<int, 1>{};
+    bool sent1{};
+    bool sent2{};
+    auto sop1 = async::connect(c.send(1), receiver{[&] { sent1 = true; }});
+    auto sop2 = async::connect(c.send(2), receiver{[&] { sent2 = true; }});
+    async::start(sop1);
+    async::start(sop2);
+    CHECK(sent1);
+    CHECK(not sent2);
+
+    int value{};
+    auto rop1 =
+        async::connect(c.receive(), receiver{[&](int v) { value = v; }});
+    async::start(rop1);
+    CHECK(value == 1);
+    CHECK(sent2);
+    CHECK(c.size() == 1);
+
+    auto rop2 =
+        async::connect(c.receive(), receiver{[&](int v) { value = v; }});
+    async::start(rop2);
+    CHECK(value == 2);
+}
+
+TEST_CASE("waiting receivers are served in order", "[channel]") {
+    auto c = async::channel<int, 1>{};
+    std::vector<int> received{};
+    auto rop1 = async::connect(
+        c.receive(), receiver{[&](int v) { received.push_back(v * 10); }});
+    auto rop2 = async::connect(
+        c.receive(), receiver{[&](int v) { received.push_back(v * 100); }});
+    async::start(rop1);
+    async::start(rop2);
+
+    auto sop1 = async::connect(c.send(1), receiver{[] {}});
+    auto sop2 = async::connect(c.send(2), receiver{[] {}});
+    async::start(sop1);
+    async::start(sop2);
+    CHECK(received == std::vector{10, 200});
+}
+
+TEST_CASE("channel can carry move-only values", "[channel]") {
+    auto c = async::channel<move_only<int>, 1>{};
+    int value{};
+    auto rop = async::connect(
+        c.receive(), receiver{[&](move_only<int> v) { value = v.value; }});
+    async::start(rop);
+    auto sop = async::connect(c.send(move_only{42}), receiver{[] {}});
+    async::start(sop);
+    CHECK(value == 42);
+}
+
+TEST_CASE("stopping a waiting receive unlinks it", "[channel]") {
+    auto c = async::channel<int, 1>{};
+    int value{};
+    auto r = stoppable_receiver{[&] { value = 17; }};
+    auto rop = async::connect(c.receive(), r);
+    async::start(rop);
+    r.request_stop();
+    CHECK(value == 17);
+
+    auto sop = async::connect(c.send(42), receiver{[] {}});
+    async::start(sop);
+    CHECK(c.size() == 1);
+}
+
+TEST_CASE("stopping a waiting send unlinks it", "[channel]") {
+    auto c = async::channel<int, 1>{};
+    auto sop1 = async::connect(c.send(1), receiver{[] {}});
+    async::start(sop1);
+
+    int value{};
+    auto r = stoppable_receiver{[&] { value = 17; }};
+    auto sop2 = async::connect(c.send(2), r);
+    async::start(sop2);
+    r.request_stop();
+    CHECK(value == 17);
+
+    auto rop1 =
+        async::connect(c.receive(), receiver{[&](int v) { value = v; }});
+    async::start(rop1);
+    CHECK(value == 1);
+    CHECK(c.size() == 0);
+}
+
+TEST_CASE("a receive completed by a send no longer listens for stop",
+          "[channel]") {
+    auto c = async::channel<int, 1>{};
+    int count{};
+    auto r = stoppable_receiver{[&] { ++count; }};
+    auto rop = async::connect(c.receive(), r);
+    async::start(rop);
+    CHECK(count == 0);
+
+    auto sop = async::connect(c.send(42), receiver{[] {}});
+    async::start(sop);
+    CHECK(count == 1);
+    r.request_stop();
+    CHECK(count == 1);
+}
@@ -0,0 +1,68 @@
+#include <async/constexpr_wait.hpp>
+#include <async/just.hpp>
+#include <async/let_value.hpp>
+#include <async/read_env.hpp>
+#include <async/schedulers/inline_scheduler.hpp>
+#include <async/then.hpp>
+
+#include <stdx/tuple.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstddef>
+
+TEST_CASE("constexpr_wait evaluates a pipeline at compile time",
+          "[constexpr_wait]") {
+    constexpr auto v = async::just(42) |
+                       async::then([](int i) { return i * 2; }) |
+                       async::constexpr_wait();
+    STATIC_REQUIRE(v.has_value());
+    STATIC_REQUIRE(get<0>(*v) == 84);
+}
+
+TEST_CASE("constexpr_wait can compute a lookup table", "[constexpr_wait]") {
+    constexpr auto table = [] {
+        return async::constexpr_wait(
+                   async::inline_scheduler::schedule() | async::then([] {
+                       std::array<int, 8> a{};
+                       for (auto i = std::size_t{}; i < a.size(); ++i) {
+                           a[i] = static_cast<int>(i * i);
+                       }
+                       return a;
+                   }))
+            .value();
+    }();
+    STATIC_REQUIRE(get<0>(table)[3] == 9);
+    STATIC_REQUIRE(get<0>(table)[7] == 49);
+}
+
+TEST_CASE("constexpr_wait drives let_value", "[constexpr_wait]") {
+    constexpr auto v =
+        async::just(3) |
+        async::let_value([](int i) { return async::just(i * i); }) |
+        async::constexpr_wait();
+    STATIC_REQUIRE(get<0>(v.value()) == 9);
+}
+
+TEST_CASE("constexpr_wait returns nothing for an error", "[constexpr_wait]") {
+    constexpr auto v = async::just_error(42) | async::constexpr_wait();
+    STATIC_REQUIRE(not v.has_value());
+}
+
+TEST_CASE("constexpr_wait gives an inline scheduler in the environment",
+          "[constexpr_wait]") {
+    constexpr auto v = async::get_scheduler() |
+                       async::let_value([](auto sched) {
+                           return sched.schedule() |
+                                  async::then([] { return 17; });
+                       }) |
+                       async::constexpr_wait();
+    STATIC_REQUIRE(get<0>(v.value()) == 17);
+}
+
+TEST_CASE("constexpr_wait works at runtime too", "[constexpr_wait]") {
+    auto const v = async::just(42) | async::constexpr_wait();
+    REQUIRE(v.has_value());
+    CHECK(get<0>(*v) == 42);
+}
@@ -13,6 +13,8 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <concepts>
+
 namespace {
 template <auto> class test_scheduler {
     template <typename R> struct op_state {
@@ -58,12 +60,74 @@ template <auto> class test_scheduler {
         -> bool = default;
 
   public:
+    using elides_redundant_hops = void;
+
     auto schedule() {
         ++schedule_calls;
         return sender{};
     }
     static inline int schedule_calls{};
 };
+
+class id_scheduler {
+    template <typename R> struct op_state {
+        [[no_unique_address]] R receiver;
+
+      private:
+        template <stdx::same_as_unqualified<op_state> O>
+        friend constexpr auto tag_invoke(async::start_t, O &&o) -> void {
+            async::set_value(std::forward<O>(o).receiver);
+        }
+    };
+
+    struct env {
+        int id;
+
+      private:
+        template <typename Tag>
+        [[nodiscard]] friend constexpr auto
+        tag_invoke(async::get_completion_scheduler_t<Tag>, env e) noexcept
+            -> id_scheduler {
+            return {e.id};
+        }
+    };
+
+    struct sender {
+        using is_sender = void;
+        using completion_signatures =
+            async::completion_signatures<async::set_value_t()>;
+
+        int id;
+
+      private:
+        [[nodiscard]] friend constexpr auto tag_invoke(async::get_env_t,
+                                                       sender s) noexcept
+            -> env {
+            return {s.id};
+        }
+
+        template <stdx::same_as_unqualified<sender> S,
+                  async::receiver_from<sender> R>
+        [[nodiscard]] friend constexpr auto tag_invoke(async::connect_t, S &&,
+                                                       R &&r) -> op_state<R> {
+            return {std::forward<R>(r)};
+        }
+    };
+
+    [[nodiscard]] friend constexpr auto operator==(id_scheduler, id_scheduler)
+        -> bool = default;
+
+  public:
+    using elides_redundant_hops = void;
+
+    auto schedule() {
+        ++schedule_calls;
+        return sender{id};
+    }
+
+    int id;
+    static inline int schedule_calls{};
+};
 } // namespace
 
 TEST_CASE("continue_on", "[continue_on]") {
@@ -186,3 +250,62 @@ TEST_CASE("continue_on cancellation", "[continue_on]") {
     CHECK(test_scheduler<1>::schedule_calls == 1);
     CHECK(test_scheduler<2>::schedule_calls == 0);
 }
+
+TEST_CASE("continue_on onto the same stateless scheduler is elided",
+          "[continue_on]") {
+    test_scheduler<1>::schedule_calls = 0;
+    int value{};
+
+    auto sched = test_scheduler<1>{};
+    auto n1 = async::then(sched.schedule(), [] { return 42; });
+    auto t = n1 | async::continue_on(sched);
+    static_assert(std::same_as<decltype(t), decltype(n1)>);
+
+    auto op = async::connect(t, receiver{[&](auto i) { value = i; }});
+    async::start(op);
+    CHECK(value == 42);
+    CHECK(test_scheduler<1>::schedule_calls == 1);
+}
+
+TEST_CASE("continue_on onto an equal scheduler is elided at runtime",
+          "[continue_on]") {
+    id_scheduler::schedule_calls = 0;
+    int value{};
+
+    auto sched1 = id_scheduler{1};
+    auto n1 = async::then(sched1.schedule(), [] { return 42; }) |
+              async::continue_on(id_scheduler{1});
+    auto op1 = async::connect(n1, receiver{[&](auto i) { value = i; }});
+    async::start(op1);
+    CHECK(value == 42);
+    CHECK(id_scheduler::schedule_calls == 1);
+
+    auto n2 = async::then(sched1.schedule(), [] { return 17; }) |
+              async::continue_on(id_scheduler{2});
+    auto op2 = async::connect(n2, receiver{[&](auto i) { value = i; }});
+    async::start(op2);
+    CHECK(value == 17);
+    CHECK(id_scheduler::schedule_calls == 3);
+}
+
+TEST_CASE("continue_on reports the scheduler it hops to", "[continue_on]") {
+    auto n = id_scheduler{1}.schedule() | async::continue_on(id_scheduler{2});
+    CHECK(async::get_completion_scheduler<async::set_value_t>(
+              async::get_env(n)) == id_scheduler{2});
+}
+
+TEST_CASE("continue_on back to the first scheduler is not elided",
+          "[continue_on]") {
+    id_scheduler::schedule_calls = 0;
+    int value{};
+
+    auto n = async::then(id_scheduler{1}.schedule(), [] { return 42; }) |
+             async::continue_on(id_scheduler{2}) |
+             async::continue_on(id_scheduler{1});
+    CHECK(async::get_completion_scheduler<async::set_value_t>(
+              async::get_env(n)) == id_scheduler{1});
+    auto op = async::connect(n, receiver{[&](auto i) { value = i; }});
+    async::start(op);
+    CHECK(value == 42);
+    CHECK(id_scheduler::schedule_calls == 3);
+}
@@ -0,0 +1,71 @@
+#include <async/critical_section_stats.hpp>
+#include <async/stop_token.hpp>
+#include <conc/concurrency.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <string_view>
+#include <utility>
+
+namespace {
+struct base_policy {
+    template <typename = void, typename F, typename... Pred>
+    static auto call_in_critical_section(F &&f, Pred &&...) -> decltype(auto) {
+        return std::forward<F>(f)();
+    }
+};
+
+struct test_clock {
+    using time_point_t = std::uint64_t;
+    static inline time_point_t current{};
+    static auto now() -> time_point_t { return current; }
+};
+
+using policy_t = async::timed_concurrency_policy<base_policy, test_clock>;
+
+struct mutex_a;
+struct mutex_b;
+} // namespace
+
+template <> inline auto conc::injected_policy<> = policy_t{};
+
+TEST_CASE("critical section time is recorded per tag",
+          "[critical_section_stats]") {
+    policy_t::reset();
+    conc::call_in_critical_section<mutex_a>([] { test_clock::current += 3; });
+    conc::call_in_critical_section<mutex_a>([] { test_clock::current += 5; });
+    conc::call_in_critical_section<mutex_b>([] { test_clock::current += 2; });
+
+    auto const &a = policy_t::stats<mutex_a>();
+    CHECK(a.count == 2);
+    CHECK(a.total == 8);
+    CHECK(a.max == 5);
+    CHECK(a.tag.find("mutex_a") != std::string_view::npos);
+
+    auto const &b = policy_t::stats<mutex_b>();
+    CHECK(b.count == 1);
+    CHECK(b.max == 2);
+}
+
+TEST_CASE("wrapped policy passes results through",
+          "[critical_section_stats]") {
+    auto const r = conc::call_in_critical_section<mutex_a>([] { return 42; });
+    CHECK(r == 42);
+}
+
+TEST_CASE("library critical sections are recorded",
+          "[critical_section_stats]") {
+    policy_t::reset();
+    auto s = async::inplace_stop_source{};
+    s.request_stop();
+
+    auto tags = 0;
+    auto count = std::uint32_t{};
+    policy_t::for_each([&](async::critical_section_stats const &stats) {
+        ++tags;
+        count += stats.count;
+    });
+    CHECK(tags > 0);
+    CHECK(count > 0);
+}
@@ -0,0 +1,207 @@
+#include "detail/common.hpp"
+
+#include <async/concepts.hpp>
+#include <async/dma_transfer.hpp>
+#include <async/repeat.hpp>
+#include <async/type_traits.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace {
+struct test_dma_hal {
+    using channel_t = int;
+
+    static inline async::dma_completion *pending{};
+    static inline std::span<std::byte> buffer{};
+    static inline channel_t channel{};
+    static inline int starts{};
+
+    static auto start_transfer(channel_t ch, std::span<std::byte> b,
+                               async::dma_completion &c) -> void {
+        channel = ch;
+        buffer = b;
+        pending = &c;
+        ++starts;
+    }
+
+    static auto abort_transfer(channel_t) -> bool {
+        return std::exchange(pending, nullptr) != nullptr;
+    }
+
+    static auto complete(std::size_t bytes) -> void {
+        std::exchange(pending, nullptr)->transfer_complete(bytes);
+    }
+
+    static auto fail() -> void {
+        std::exchange(pending, nullptr)->transfer_error();
+    }
+
+    static auto reset() -> void {
+        pending = nullptr;
+        buffer = {};
+        channel = {};
+        starts = 0;
+    }
+};
+static_assert(async::detail::dma_hal<test_dma_hal>);
+} // namespace
+
+TEST_CASE("dma_transfer is a sender", "[dma_transfer]") {
+    std::array<std::byte, 4> buf{};
+    static_assert(
+        async::sender<decltype(async::dma_transfer<test_dma_hal>(0, buf))>);
+    static_assert(async::sender<decltype(async::dma_transfer<test_dma_hal>(
+                      0, buf, buf))>);
+}
+
+TEST_CASE("dma_transfer advertises set_stopped only when stoppable",
+          "[dma_transfer]") {
+    std::array<std::byte, 4> buf{};
+    auto s = async::dma_transfer<test_dma_hal>(0, buf);
+    static_assert(
+        std::same_as<async::completion_signatures_of_t<decltype(s)>,
+                     async::completion_signatures<
+                         async::set_value_t(std::span<std::byte>),
+                         async::set_error_t(async::dma_error)>>);
+
+    [[maybe_unused]] auto r = stoppable_receiver([] {});
+    static_assert(std::same_as<
+                  async::completion_signatures_of_t<
+                      decltype(s), async::env_of_t<decltype(r)>>,
+                  async::completion_signatures<
+                      async::set_value_t(std::span<std::byte>),
+                      async::set_error_t(async::dma_error),
+                      async::set_stopped_t()>>);
+}
+
+TEST_CASE("dma_transfer completes with the transferred part of the buffer",
+          "[dma_transfer]") {
+    test_dma_hal::reset();
+    std::array<std::byte, 8> buf{};
+    std::span<std::byte> result{};
+    auto op = async::connect(
+        async::dma_transfer<test_dma_hal>(3, buf),
+        receiver{[&](std::span<std::byte> s) { result = s; }});
+    async::start(op);
+    CHECK(test_dma_hal::channel == 3);
+    CHECK(test_dma_hal::buffer.data() == buf.data());
+    CHECK(result.empty());
+
+    test_dma_hal::complete(5);
+    CHECK(result.data() == buf.data());
+    CHECK(result.size() == 5);
+}
+
+TEST_CASE("dma_transfer completes with an error", "[dma_transfer]") {
+    test_dma_hal::reset();
+    std::array<std::byte, 8> buf{};
+    bool failed{};
+    auto op = async::connect(
+        async::dma_transfer<test_dma_hal>(0, buf),
+        error_receiver{[&](async::dma_error) { failed = true; }});
+    async::start(op);
+    test_dma_hal::fail();
+    CHECK(failed);
+}
+
+TEST_CASE("stopping dma_transfer aborts the transfer", "[dma_transfer]") {
+    test_dma_hal::reset();
+    std::array<std::byte, 8> buf{};
+    int value{};
+    auto r = stoppable_receiver{[&] { value = 17; }};
+    auto op = async::connect(async::dma_transfer<test_dma_hal>(0, buf), r);
+    async::start(op);
+    r.request_stop();
+    CHECK(value == 17);
+    CHECK(test_dma_hal::pending == nullptr);
+}
+
+TEST_CASE("repeat restarts dma_transfer without reconnecting",
+          "[dma_transfer]") {
+    test_dma_hal::reset();
+    std::array<std::byte, 8> buf{};
+    using op_t =
+        async::connect_result_t<decltype(async::dma_transfer<test_dma_hal>(
+                                    0, buf)) &,
+                                universal_receiver>;
+    static_assert(async::restartable_operation<op_t>);
+
+    int count{};
+    bool done{};
+    auto s = async::dma_transfer<test_dma_hal>(0, buf) |
+             async::repeat_until([&](std::span<std::byte> b) {
+                 CHECK(b.data() == buf.data());
+                 return ++count == 3;
+             });
+    auto op = async::connect(s, receiver{[&](auto) { done = true; }});
+    async::start(op);
+    for (auto i = 0; i < 3; ++i) {
+        CHECK(test_dma_hal::starts == i + 1);
+        test_dma_hal::complete(buf.size());
+    }
+    CHECK(count == 3);
+    CHECK(done);
+}
+
+TEST_CASE("double-buffered dma_transfer starts the next transfer before "
+          "completing",
+          "[dma_transfer]") {
+    test_dma_hal::reset();
+    std::array<std::byte, 4> front{};
+    std::array<std::byte, 4> back{};
+    std::vector<std::byte *> received{};
+    std::vector<std::byte *> filling{};
+
+    auto s = async::dma_transfer<test_dma_hal>(0, front, back) |
+             async::repeat_until([&](std::span<std::byte> b) {
+                 received.push_back(b.data());
+                 filling.push_back(test_dma_hal::buffer.data());
+                 return received.size() == 4;
+             });
+    auto op = async::connect(s, receiver{[](auto) {}});
+    async::start(op);
+    CHECK(test_dma_hal::buffer.data() == front.data());
+
+    for (auto i = 0; i < 4; ++i) {
+        test_dma_hal::complete(4);
+    }
+    CHECK(received == std::vector{front.data(), back.data(), front.data(),
+                                  back.data()});
+    CHECK(filling == std::vector{back.data(), front.data(), back.data(),
+                                 front.data()});
+}
+
+TEST_CASE("double-buffered dma_transfer keeps a transfer that completes "
+          "before it is restarted",
+          "[dma_transfer]") {
+    test_dma_hal::reset();
+    std::array<std::byte, 4> front{};
+    std::array<std::byte, 4> back{};
+    std::span<std::byte> result{};
+
+    auto op = async::connect(
+        async::dma_transfer<test_dma_hal>(0, front, back),
+        receiver{[&](std::span<std::byte> b) { result = b; }});
+    async::start(op);
+    test_dma_hal::complete(4);
+    CHECK(result.data() == front.data());
+    CHECK(test_dma_hal::buffer.data() == back.data());
+
+    // the receiver still owns front, so nothing is started
+    test_dma_hal::complete(2);
+    CHECK(test_dma_hal::starts == 2);
+
+    async::restart(op);
+    async::start(op);
+    CHECK(result.data() == back.data());
+    CHECK(result.size() == 2);
+    CHECK(test_dma_hal::starts == 3);
+    CHECK(test_dma_hal::buffer.data() == front.data());
+}
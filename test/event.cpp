@@ -0,0 +1,129 @@
+#include "detail/common.hpp"
+
+#include <async/concepts.hpp>
+#include <async/event.hpp>
+#include <async/type_traits.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <concepts>
+
+TEST_CASE("event wait senders are senders", "[event]") {
+    auto m = async::manual_reset_event{};
+    auto a = async::auto_reset_event{};
+    static_assert(async::sender<decltype(m.wait())>);
+    static_assert(async::sender<decltype(a.wait())>);
+}
+
+TEST_CASE("wait advertises set_stopped only when stoppable", "[event]") {
+    auto e = async::manual_reset_event{};
+    static_assert(
+        std::same_as<async::completion_signatures_of_t<decltype(e.wait())>,
+                     async::completion_signatures<async::set_value_t()>>);
+
+    [[maybe_unused]] auto r = stoppable_receiver([] {});
+    static_assert(
+        std::same_as<async::completion_signatures_of_t<
+                         decltype(e.wait()), async::env_of_t<decltype(r)>>,
+                     async::completion_signatures<async::set_value_t(),
+                                                  async::set_stopped_t()>>);
+}
+
+TEST_CASE("set completes every waiting operation", "[event]") {
+    auto e = async::manual_reset_event{};
+    int count{};
+    auto op1 = async::connect(e.wait(), receiver{[&] { ++count; }});
+    auto op2 = async::connect(e.wait(), receiver{[&] { ++count; }});
+    auto op3 = async::connect(e.wait(), receiver{[&] { ++count; }});
+    async::start(op1);
+    async::start(op2);
+    async::start(op3);
+    CHECK(count == 0);
+    CHECK(not e.is_set());
+
+    e.set();
+    CHECK(count == 3);
+    CHECK(e.is_set());
+}
+
+TEST_CASE("a manual-reset event stays set until reset", "[event]") {
+    auto e = async::manual_reset_event{};
+    e.set();
+    int count{};
+    auto op1 = async::connect(e.wait(), receiver{[&] { ++count; }});
+    async::start(op1);
+    CHECK(count == 1);
+
+    e.reset();
+    CHECK(not e.is_set());
+    auto op2 = async::connect(e.wait(), receiver{[&] { ++count; }});
+    async::start(op2);
+    CHECK(count == 1);
+    e.set();
+    CHECK(count == 2);
+}
+
+TEST_CASE("an auto-reset event resets when it completes waiting operations",
+          "[event]") {
+    auto e = async::auto_reset_event{};
+    int count{};
+    auto op1 = async::connect(e.wait(), receiver{[&] { ++count; }});
+    auto op2 = async::connect(e.wait(), receiver{[&] { ++count; }});
+    async::start(op1);
+    async::start(op2);
+    e.set();
+    CHECK(count == 2);
+    CHECK(not e.is_set());
+}
+
+TEST_CASE("an auto-reset event set with no waiters releases one wait",
+          "[event]") {
+    auto e = async::auto_reset_event{};
+    e.set();
+    CHECK(e.is_set());
+
+    int count{};
+    auto op1 = async::connect(e.wait(), receiver{[&] { ++count; }});
+    auto op2 = async::connect(e.wait(), receiver{[&] { ++count; }});
+    async::start(op1);
+    CHECK(count == 1);
+    CHECK(not e.is_set());
+    async::start(op2);
+    CHECK(count == 1);
+}
+
+TEST_CASE("stopping a waiting operation leaves the others waiting",
+          "[event]") {
+    auto e = async::manual_reset_event{};
+    int count{};
+    int stopped{};
+    auto op1 = async::connect(e.wait(), receiver{[&] { ++count; }});
+    auto r = stoppable_receiver{[&] { ++stopped; }};
+    auto op2 = async::connect(e.wait(), r);
+    auto op3 = async::connect(e.wait(), receiver{[&] { ++count; }});
+    async::start(op1);
+    async::start(op2);
+    async::start(op3);
+
+    r.request_stop();
+    CHECK(stopped == 1);
+    CHECK(count == 0);
+
+    e.set();
+    CHECK(count == 2);
+    CHECK(stopped == 1);
+}
+
+TEST_CASE("a wait completed by set no longer listens for stop", "[event]") {
+    auto e = async::manual_reset_event{};
+    int count{};
+    auto r = stoppable_receiver{[&] { ++count; }};
+    auto op = async::connect(e.wait(), r);
+    async::start(op);
+    CHECK(count == 0);
+
+    e.set();
+    CHECK(count == 1);
+    r.request_stop();
+    CHECK(count == 1);
+}
@@ -14,6 +14,27 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace {
+struct test_idle {
+    static inline std::atomic<int> waits{};
+    static inline std::atomic<int> notifies{};
+
+    template <typename Pred> static auto wait(Pred &&p) -> void {
+        ++waits;
+        if (not p()) {
+            std::this_thread::yield();
+        }
+    }
+    static auto notify() -> void { ++notifies; }
+};
+} // namespace
+
+template <> inline auto async::injected_run_loop_idle<> = test_idle{};
+
 TEST_CASE("sync_wait for inline scheduler", "[freestanding_sync_wait]") {
     auto value = async::inline_scheduler::schedule() |
                  async::then([] { return 42; }) | async::sync_wait();
@@ -70,3 +91,19 @@ TEST_CASE("sync_wait with read (thread scheduler", "[freestanding_sync_wait]") {
     REQUIRE(value.has_value());
     CHECK(get<0>(*value) == 42);
 }
+
+TEST_CASE("sync_wait idles through the injected hook",
+          "[freestanding_sync_wait]") {
+    test_idle::waits = 0;
+    test_idle::notifies = 0;
+
+    auto value = async::thread_scheduler::schedule() | async::then([] {
+                     std::this_thread::sleep_for(std::chrono::milliseconds{10});
+                     return 42;
+                 }) |
+                 async::sync_wait();
+    REQUIRE(value.has_value());
+    CHECK(get<0>(*value) == 42);
+    CHECK(test_idle::waits > 0);
+    CHECK(test_idle::notifies > 0);
+}
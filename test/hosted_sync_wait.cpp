@@ -12,6 +12,9 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <array>
+#include <span>
+
 TEST_CASE("sync_wait for inline scheduler", "[hosted_sync_wait]") {
     auto value = async::inline_scheduler::schedule() |
                  async::then([] { return 42; }) | async::sync_wait();
@@ -67,3 +70,30 @@ TEST_CASE("sync_wait with read (thread scheduler)", "[hosted_sync_wait]") {
     REQUIRE(value.has_value());
     CHECK(get<0>(*value) == 42);
 }
+
+TEST_CASE("sync_wait_all runs a runtime number of senders on one loop",
+          "[hosted_sync_wait]") {
+    auto const make = [](int i) {
+        return async::start_on(
+            async::thread_scheduler{},
+            async::make_variant_sender(
+                i != 2, [=] { return async::just(i); },
+                [] { return async::just_error(17); }));
+    };
+    auto sndrs = std::array{make(0), make(1), make(2), make(3)};
+
+    auto const results = async::sync_wait_all<8>(std::span{sndrs}.first(3));
+    REQUIRE(results[0].has_value());
+    CHECK(get<0>(*results[0]) == 0);
+    REQUIRE(results[1].has_value());
+    CHECK(get<0>(*results[1]) == 1);
+    CHECK(not results[2].has_value());
+    CHECK(not results[3].has_value());
+}
+
+TEST_CASE("sync_wait_all with no senders returns immediately",
+          "[hosted_sync_wait]") {
+    auto sndrs = std::array<decltype(async::just(42)), 0>{};
+    auto const results = async::sync_wait_all<4>(std::span{sndrs});
+    CHECK(not results[0].has_value());
+}
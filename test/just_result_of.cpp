@@ -98,3 +98,45 @@ TEST_CASE("just_result_of has a stack allocator", "[just_result_of]") {
                            decltype(async::just_result_of([] { return 42; }))>>,
                        async::stack_allocator>);
 }
+
+TEST_CASE("memoized_result_of computes once", "[just_result_of]") {
+    int calls{};
+    int value{};
+    auto m = async::memoized_result_of([&] {
+        ++calls;
+        return 42;
+    });
+    auto s = m.get();
+    static_assert(async::sender_of<decltype(s), async::set_value_t(int)>);
+    CHECK(not m.is_cached());
+
+    auto op1 = async::connect(s, receiver{[&](int i) { value = i; }});
+    async::start(op1);
+    CHECK(value == 42);
+    CHECK(m.is_cached());
+
+    value = 0;
+    auto op2 = async::connect(m.get(), receiver{[&](int i) { value = i; }});
+    async::start(op2);
+    async::start(op1);
+    CHECK(value == 42);
+    CHECK(calls == 1);
+}
+
+TEST_CASE("memoized_result_of recomputes after invalidation",
+          "[just_result_of]") {
+    int calls{};
+    int value{};
+    auto m = async::memoized_result_of([&] { return ++calls; });
+    auto op = async::connect(m.get(), receiver{[&](int i) { value = i; }});
+    async::start(op);
+    CHECK(value == 1);
+
+    m.invalidate();
+    CHECK(not m.is_cached());
+    async::start(op);
+    CHECK(value == 2);
+    async::start(op);
+    CHECK(value == 2);
+    CHECK(calls == 2);
+}
@@ -11,6 +11,9 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <array>
+#include <cstddef>
+
 TEST_CASE("let_value", "[let_value]") {
     int value{};
 
@@ -208,3 +211,18 @@ TEST_CASE("let_value can be single shot with passthrough", "[let_value]") {
                               async::let_value([](auto) { return 42; });
     static_assert(async::singleshot_sender<decltype(l)>);
 }
+
+TEST_CASE("let_value second stage reuses the first stage's storage",
+          "[let_value]") {
+    using data_t = std::array<char, 64>;
+    auto s = async::just(data_t{}) |
+             async::let_value([](data_t const &d) { return async::just(d); });
+    using op_t = async::connect_result_t<decltype(s), universal_receiver>;
+    STATIC_REQUIRE(sizeof(op_t) < 2 * sizeof(data_t));
+
+    std::size_t size{};
+    auto op = async::connect(
+        s, receiver{[&](data_t const &d) { size = d.size(); }});
+    async::start(op);
+    CHECK(size == 64);
+}
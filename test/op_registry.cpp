@@ -0,0 +1,70 @@
+#include "detail/common.hpp"
+
+#include <async/op_registry.hpp>
+#include <async/schedulers/runloop_scheduler.hpp>
+#include <async/start_detached.hpp>
+#include <async/trace.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <concepts>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace {
+async::op_registry<8> registry{};
+} // namespace
+
+template <> inline auto async::injected_tracer<> = registry.get_tracer();
+
+TEST_CASE("injected tracer is used when the environment has none",
+          "[op_registry]") {
+    static_assert(std::same_as<async::tracer_of_t<async::empty_env>,
+                               async::op_registry<8>::tracer>);
+}
+
+TEST_CASE("a scheduled operation is live until it completes",
+          "[op_registry]") {
+    async::run_loop rl{};
+    auto op = async::connect(rl.get_scheduler().schedule(), receiver{[] {}});
+    async::start(op);
+
+    std::vector<std::string_view> kinds{};
+    registry.for_each([&](async::live_op const &l) {
+        CHECK(l.op.load() == std::addressof(op));
+        kinds.emplace_back(l.kind);
+    });
+    CHECK(kinds == std::vector<std::string_view>{"runloop_scheduler"});
+
+    rl.finish();
+    rl.run();
+    CHECK(registry.size() == 0);
+}
+
+TEST_CASE("a detached operation is live until it completes", "[op_registry]") {
+    async::run_loop rl{};
+    CHECK(async::start_detached(rl.get_scheduler().schedule()));
+    CHECK(registry.size() == 2);
+
+    rl.finish();
+    rl.run();
+    CHECK(registry.size() == 0);
+}
+
+TEST_CASE("operations beyond the registry's capacity are counted",
+          "[op_registry]") {
+    async::op_registry<2> r{};
+    std::array<int, 3> ops{};
+    for (auto &op : ops) {
+        r.add("test", std::addressof(op));
+    }
+    CHECK(r.size() == 2);
+    CHECK(r.dropped() == 1);
+
+    r.remove(std::addressof(ops[2]));
+    CHECK(r.size() == 2);
+    r.remove(std::addressof(ops[0]));
+    CHECK(r.size() == 1);
+}
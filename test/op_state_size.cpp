@@ -0,0 +1,57 @@
+#include "detail/common.hpp"
+
+#include <async/just.hpp>
+#include <async/op_state_size.hpp>
+#include <async/schedulers/inline_scheduler.hpp>
+#include <async/sequence.hpp>
+#include <async/then.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <iostream>
+#include <string_view>
+
+namespace {
+template <typename S> auto report(std::string_view name, S const &) {
+    constexpr auto size = async::op_state_size_of_v<S>;
+    std::cout << "  " << name << ": " << size << '\n';
+    return size;
+}
+} // namespace
+
+TEST_CASE("empty operation states collapse", "[op_state_size]") {
+    STATIC_REQUIRE(async::op_state_size_of_v<decltype(async::just())> == 1);
+    STATIC_REQUIRE(
+        async::op_state_size_of_v<decltype(async::just() |
+                                           async::then([] {}))> == 1);
+}
+
+TEST_CASE("operation state holds sent values", "[op_state_size]") {
+    STATIC_REQUIRE(async::op_state_size_of_v<decltype(async::just(42))> >=
+                   sizeof(int));
+}
+
+TEST_CASE("op state budget passes the sender through", "[op_state_size]") {
+    int value{};
+    auto s = async::just(42) | async::static_assert_op_state_budget<16>();
+    auto op = async::connect(s, receiver{[&](int i) { value = i; }});
+    async::start(op);
+    CHECK(value == 42);
+}
+
+TEST_CASE("op state size breakdown of a pipeline", "[op_state_size]") {
+    auto const s0 = async::inline_scheduler::schedule();
+    auto const s1 = s0 | async::then([] { return 42; });
+    auto const s2 = s1 | async::then([](int i) { return i * 2; });
+    auto const s3 = s2 | async::seq(async::just(17));
+
+    std::cout << "op state sizes:\n";
+    auto const sz0 = report("schedule()", s0);
+    auto const sz1 = report("| then", s1);
+    auto const sz2 = report("| then", s2);
+    auto const sz3 = report("| seq(just)", s3);
+    CHECK(sz0 <= sz1);
+    CHECK(sz1 <= sz2);
+    CHECK(sz2 <= sz3);
+}
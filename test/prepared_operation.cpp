@@ -0,0 +1,101 @@
+#include "detail/common.hpp"
+
+#include <async/concepts.hpp>
+#include <async/just.hpp>
+#include <async/prepared_operation.hpp>
+#include <async/tags.hpp>
+
+#include <stdx/concepts.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <type_traits>
+#include <utility>
+
+namespace {
+int connections{};
+
+// A multishot sender whose operation state cannot restart itself, and which
+// counts how often it is connected.
+struct counting_sender {
+    using is_sender = void;
+    using completion_signatures =
+        async::completion_signatures<async::set_value_t(int)>;
+
+    template <typename R> struct op_state {
+        [[no_unique_address]] R rcvr;
+
+      private:
+        template <stdx::same_as_unqualified<op_state> O>
+        friend constexpr auto tag_invoke(async::start_t, O &&o) -> void {
+            async::set_value(std::forward<O>(o).rcvr, 42);
+        }
+    };
+
+  private:
+    template <stdx::same_as_unqualified<counting_sender> S,
+              async::receiver R>
+    [[nodiscard]] friend constexpr auto tag_invoke(async::connect_t, S &&,
+                                                   R &&r)
+        -> op_state<std::remove_cvref_t<R>> {
+        ++connections;
+        return {std::forward<R>(r)};
+    }
+};
+
+template <typename T>
+concept resettable = requires(T &t) { t.reset(); };
+} // namespace
+
+TEST_CASE("a prepared operation connects when it is constructed",
+          "[prepared_operation]") {
+    connections = 0;
+    int value{};
+    auto op = async::prepared_operation{counting_sender{},
+                                        receiver{[&](int i) { value = i; }}};
+    CHECK(connections == 1);
+    CHECK(value == 0);
+    op.start();
+    CHECK(value == 42);
+    CHECK(connections == 1);
+}
+
+TEST_CASE("a prepared operation is reconnected when it is reset",
+          "[prepared_operation]") {
+    connections = 0;
+    int count{};
+    auto op = async::prepared_operation{counting_sender{},
+                                        receiver{[&](int) { ++count; }}};
+    op.start();
+    op.reset();
+    CHECK(connections == 2);
+    op.start();
+    CHECK(count == 2);
+}
+
+TEST_CASE("a restartable operation is restarted in place",
+          "[prepared_operation]") {
+    int count{};
+    auto op = async::prepared_operation{async::just(42),
+                                        receiver{[&](int) { ++count; }}};
+    op.start();
+    op.reset();
+    op.start();
+    CHECK(count == 2);
+}
+
+TEST_CASE("a singleshot sender can be prepared but not reset",
+          "[prepared_operation]") {
+    int value{};
+    auto op = async::prepared_operation{
+        async::just(move_only{42}),
+        receiver{[&](move_only<int> m) { value = m.value; }}};
+    static_assert(not resettable<decltype(op)>);
+    op.start();
+    CHECK(value == 42);
+}
+
+TEST_CASE("a prepared operation cannot be moved", "[prepared_operation]") {
+    using op_t = async::prepared_operation<counting_sender, universal_receiver>;
+    static_assert(not std::is_move_constructible_v<op_t>);
+}
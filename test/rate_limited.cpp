@@ -0,0 +1,141 @@
+#include "detail/common.hpp"
+
+#include <async/just_result_of.hpp>
+#include <async/rate_limited.hpp>
+#include <async/schedulers/timer_manager.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+auto current_time = std::chrono::steady_clock::time_point{};
+auto enabled = false;
+
+struct hal {
+    using time_point_t = std::chrono::steady_clock::time_point;
+    using task_t = async::timer_task<time_point_t>;
+
+    static auto enable() -> void { enabled = true; }
+    static auto disable() -> void { enabled = false; }
+    static auto set_event_time(time_point_t) -> void {}
+    static auto now() -> time_point_t { return current_time; }
+};
+
+using timer_manager_t = async::generic_timer_manager<hal>;
+using bucket_t = async::token_bucket<hal, 2>;
+} // namespace
+
+template <typename Rep, typename Period>
+struct async::timer_mgr::time_point_for<std::chrono::duration<Rep, Period>> {
+    using type = std::chrono::steady_clock::time_point;
+};
+
+template <>
+[[maybe_unused]] inline auto async::injected_timer_manager<> =
+    timer_manager_t{};
+
+TEST_CASE("acquire completes while tokens are available", "[rate_limited]") {
+    auto b = bucket_t{10ms};
+    int acquired{};
+    auto op1 = async::connect(b.acquire(), receiver{[&] { ++acquired; }});
+    auto op2 = async::connect(b.acquire(), receiver{[&] { ++acquired; }});
+    auto op3 = async::connect(b.acquire(), receiver{[&] { ++acquired; }});
+    async::start(op1);
+    async::start(op2);
+    CHECK(acquired == 2);
+    CHECK(b.available() == 0);
+    CHECK(not enabled);
+
+    async::start(op3);
+    CHECK(acquired == 2);
+    CHECK(enabled);
+
+    current_time += 10ms;
+    async::timer_mgr::service_task();
+    CHECK(acquired == 3);
+    CHECK(async::timer_mgr::is_idle());
+}
+
+TEST_CASE("tokens refill lazily up to the capacity", "[rate_limited]") {
+    auto b = bucket_t{10ms};
+    auto op1 = async::connect(b.acquire(), receiver{[] {}});
+    auto op2 = async::connect(b.acquire(), receiver{[] {}});
+    async::start(op1);
+    async::start(op2);
+    CHECK(b.available() == 0);
+
+    current_time += 10ms;
+    CHECK(b.available() == 1);
+    current_time += 100ms;
+    CHECK(b.available() == 2);
+    CHECK(async::timer_mgr::is_idle());
+}
+
+TEST_CASE("waiting operations are served in order at the refill rate",
+          "[rate_limited]") {
+    auto b = bucket_t{10ms};
+    std::vector<int> order{};
+    auto op1 =
+        async::connect(b.acquire(), receiver{[&] { order.push_back(1); }});
+    auto op2 =
+        async::connect(b.acquire(), receiver{[&] { order.push_back(2); }});
+    auto op3 =
+        async::connect(b.acquire(), receiver{[&] { order.push_back(3); }});
+    auto op4 =
+        async::connect(b.acquire(), receiver{[&] { order.push_back(4); }});
+    async::start(op1);
+    async::start(op2);
+    async::start(op3);
+    async::start(op4);
+    CHECK(order == std::vector{1, 2});
+
+    current_time += 10ms;
+    async::timer_mgr::service_task();
+    CHECK(order == std::vector{1, 2, 3});
+
+    current_time += 10ms;
+    async::timer_mgr::service_task();
+    CHECK(order == std::vector{1, 2, 3, 4});
+    CHECK(async::timer_mgr::is_idle());
+}
+
+TEST_CASE("stopping a waiting acquire unlinks it", "[rate_limited]") {
+    auto b = bucket_t{10ms};
+    auto op1 = async::connect(b.acquire(), receiver{[] {}});
+    auto op2 = async::connect(b.acquire(), receiver{[] {}});
+    async::start(op1);
+    async::start(op2);
+
+    int value{};
+    auto r = stoppable_receiver{[&] { value = 17; }};
+    auto op3 = async::connect(b.acquire(), r);
+    async::start(op3);
+    r.request_stop();
+    CHECK(value == 17);
+
+    current_time += 10ms;
+    async::timer_mgr::service_task();
+    CHECK(b.available() == 1);
+}
+
+TEST_CASE("rate_limited runs the sender once it has a token",
+          "[rate_limited]") {
+    auto b = bucket_t{10ms};
+    int sent{};
+    auto const s = async::just_result_of([&] { ++sent; });
+    auto op1 = async::connect(async::rate_limited(b, s), receiver{[] {}});
+    auto op2 = async::connect(async::rate_limited(b, s), receiver{[] {}});
+    auto op3 = async::connect(async::rate_limited(b, s), receiver{[] {}});
+    async::start(op1);
+    async::start(op2);
+    async::start(op3);
+    CHECK(sent == 2);
+
+    current_time += 10ms;
+    async::timer_mgr::service_task();
+    CHECK(sent == 3);
+}
@@ -5,6 +5,7 @@
 #include <async/just.hpp>
 #include <async/let_value.hpp>
 #include <async/read_env.hpp>
+#include <async/repeat.hpp>
 #include <async/schedulers/inline_scheduler.hpp>
 #include <async/start_on.hpp>
 #include <async/stop_token.hpp>
@@ -49,3 +50,50 @@ TEST_CASE("read_env with sync_wait", "[read_env]") {
     REQUIRE(value.has_value());
     CHECK(get<0>(*value) == 42);
 }
+
+namespace {
+int queries{};
+
+struct counted_query_t {
+    template <typename Env> constexpr auto operator()(Env const &) const {
+        ++queries;
+        return 42;
+    }
+};
+} // namespace
+
+TEST_CASE("read_env_once advertises what it sends", "[read_env]") {
+    static_assert(
+        async::sender_of<decltype(async::read_env_once(counted_query_t{})),
+                         async::set_value_t(int)>);
+}
+
+TEST_CASE("read_env_once queries the environment at connect", "[read_env]") {
+    queries = 0;
+    int value{};
+    auto op = async::connect(async::read_env_once(counted_query_t{}),
+                             receiver{[&](int i) { value = i; }});
+    CHECK(queries == 1);
+    async::start(op);
+    CHECK(value == 42);
+    CHECK(queries == 1);
+}
+
+TEST_CASE("read_env_once operations are restartable", "[read_env]") {
+    using op_t =
+        async::connect_result_t<decltype(async::read_env_once(
+                                    counted_query_t{})) &,
+                                universal_receiver>;
+    static_assert(async::restartable_operation<op_t>);
+}
+
+TEST_CASE("repeating read_env_once does not query the environment again",
+          "[read_env]") {
+    queries = 0;
+    int value{};
+    auto s = async::read_env_once(counted_query_t{}) | async::repeat_n(3);
+    auto op = async::connect(s, receiver{[&](int i) { value = i; }});
+    async::start(op);
+    CHECK(value == 42);
+    CHECK(queries == 1);
+}
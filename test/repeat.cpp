@@ -10,8 +10,13 @@
 #include <async/variant_sender.hpp>
 #include <async/when_all.hpp>
 
+#include <stdx/concepts.hpp>
+
 #include <catch2/catch_test_macros.hpp>
 
+#include <type_traits>
+#include <utility>
+
 TEST_CASE("repeat advertises what it sends", "[repeat]") {
     [[maybe_unused]] auto s = async::just(42) | async::repeat();
     static_assert(std::same_as<async::completion_signatures_of_t<decltype(s)>,
@@ -139,3 +144,80 @@ TEST_CASE("repeat can be cancelled", "[repeat]") {
     async::start(op);
     CHECK(var == 44);
 }
+
+TEST_CASE("repeat iterates instead of recursing on inline completion",
+          "[repeat]") {
+    int var{};
+    auto sub = async::just() | async::sequence([&] {
+                   ++var;
+                   return async::just(42);
+               });
+    auto s = sub | async::repeat_n(1'000'000);
+    auto op = async::connect(s, receiver{[&](auto i) { var += i; }});
+    async::start(op);
+    CHECK(var == 1'000'043);
+}
+
+namespace {
+int connects{};
+int restarts{};
+
+struct restartable_sender {
+    using is_sender = void;
+    using completion_signatures =
+        async::completion_signatures<async::set_value_t(int)>;
+
+    template <typename R> struct op_state {
+        R r;
+
+      private:
+        template <stdx::same_as_unqualified<op_state> O>
+        friend constexpr auto tag_invoke(async::start_t, O &&o) -> void {
+            async::set_value(std::forward<O>(o).r, 42);
+        }
+
+        friend constexpr auto tag_invoke(async::restart_t, op_state &)
+            -> void {
+            ++restarts;
+        }
+    };
+
+    template <stdx::same_as_unqualified<restartable_sender> Self, typename R>
+    [[nodiscard]] friend constexpr auto tag_invoke(async::connect_t, Self &&,
+                                                   R &&r)
+        -> op_state<std::remove_cvref_t<R>> {
+        ++connects;
+        return {std::forward<R>(r)};
+    }
+};
+} // namespace
+
+TEST_CASE("repeat restarts a restartable operation in place", "[repeat]") {
+    connects = 0;
+    restarts = 0;
+    int var{};
+    auto s = restartable_sender{} | async::repeat_n(3);
+    auto op = async::connect(s, receiver{[&](auto i) { var = i; }});
+    async::start(op);
+    CHECK(var == 42);
+    CHECK(connects == 1);
+    CHECK(restarts == 3);
+}
+
+TEST_CASE("just and inline_scheduler operations are restartable",
+          "[repeat]") {
+    using just_op_t = async::connect_result_t<decltype(async::just(42)) &,
+                                              universal_receiver>;
+    static_assert(async::restartable_operation<just_op_t>);
+
+    using move_only_op_t =
+        async::connect_result_t<decltype(async::just(move_only{42})),
+                                universal_receiver>;
+    static_assert(not async::restartable_operation<move_only_op_t>);
+
+    using sched_op_t = async::connect_result_t<
+        decltype(async::inline_scheduler::schedule<
+                 async::inline_scheduler::multishot>()) &,
+        universal_receiver>;
+    static_assert(async::restartable_operation<sched_op_t>);
+}
@@ -113,3 +113,13 @@ TEST_CASE("retry can be cancelled", "[retry]") {
     async::start(op);
     CHECK(var == 44);
 }
+
+TEST_CASE("retry iterates instead of recursing on inline completion",
+          "[retry]") {
+    int var{};
+    auto s = async::just_error(42) |
+             async::retry_until([&](auto) { return ++var == 1'000'000; });
+    auto op = async::connect(s, error_receiver{[&](auto i) { var += i; }});
+    async::start(op);
+    CHECK(var == 1'000'042);
+}
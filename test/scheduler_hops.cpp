@@ -0,0 +1,134 @@
+#include "detail/common.hpp"
+
+#include <async/concepts.hpp>
+#include <async/continue_on.hpp>
+#include <async/just.hpp>
+#include <async/scheduler_hops.hpp>
+#include <async/schedulers/priority_scheduler.hpp>
+#include <async/schedulers/task_manager.hpp>
+#include <async/start_on.hpp>
+#include <async/tags.hpp>
+#include <async/then.hpp>
+#include <async/when_all.hpp>
+
+#include <stdx/concepts.hpp>
+
+#include <boost/mp11/list.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <concepts>
+
+namespace {
+template <auto> class test_scheduler {
+    template <typename R> struct op_state {
+        [[no_unique_address]] R receiver;
+
+      private:
+        template <stdx::same_as_unqualified<op_state> O>
+        friend constexpr auto tag_invoke(async::start_t, O &&o) -> void {
+            async::set_value(std::forward<O>(o).receiver);
+        }
+    };
+
+    class env {
+        template <typename Tag>
+        [[nodiscard]] friend constexpr auto
+        tag_invoke(async::get_completion_scheduler_t<Tag>, env) noexcept
+            -> test_scheduler {
+            return {};
+        }
+    };
+
+    struct sender {
+        using is_sender = void;
+        using completion_signatures =
+            async::completion_signatures<async::set_value_t()>;
+
+      private:
+        [[nodiscard]] friend constexpr auto tag_invoke(async::get_env_t,
+                                                       sender) noexcept -> env {
+            return {};
+        }
+
+        template <stdx::same_as_unqualified<sender> S,
+                  async::receiver_from<sender> R>
+        [[nodiscard]] friend constexpr auto tag_invoke(async::connect_t, S &&,
+                                                       R &&r) -> op_state<R> {
+            return {std::forward<R>(r)};
+        }
+    };
+
+    [[nodiscard]] friend constexpr auto operator==(test_scheduler,
+                                                   test_scheduler)
+        -> bool = default;
+
+  public:
+    static auto schedule() -> sender { return {}; }
+};
+
+using sched1 = test_scheduler<1>;
+using sched2 = test_scheduler<2>;
+
+struct hal {
+    static auto schedule(async::priority_t) {}
+};
+
+using task_manager_t = async::priority_task_manager<hal, 8>;
+} // namespace
+
+template <> inline auto async::injected_task_manager<> = task_manager_t{};
+
+TEST_CASE("a sender without schedulers has no hops", "[scheduler_hops]") {
+    using S = decltype(async::just(42) | async::then([](int i) { return i; }));
+    STATIC_REQUIRE(async::scheduler_hop_count_v<S> == 0);
+}
+
+TEST_CASE("schedule and continue_on are hops", "[scheduler_hops]") {
+    using S = decltype(sched1::schedule() |
+                       async::then([] { return 42; }) |
+                       async::continue_on(sched2{}));
+    STATIC_REQUIRE(
+        std::same_as<async::scheduler_hops_t<S>,
+                     boost::mp11::mp_list<sched1, sched2>>);
+    STATIC_REQUIRE(async::scheduler_hop_count_v<S> == 2);
+    STATIC_REQUIRE(async::redundant_hop_count_v<S> == 0);
+}
+
+TEST_CASE("continue_on to the scheduler a sender completes on is no hop",
+          "[scheduler_hops]") {
+    using S = decltype(sched1::schedule() | async::continue_on(sched1{}));
+    STATIC_REQUIRE(async::scheduler_hop_count_v<S> == 1);
+}
+
+TEST_CASE("repeated hops to the same scheduler are redundant",
+          "[scheduler_hops]") {
+    using S = decltype(async::just() | async::continue_on(sched1{}) |
+                       async::continue_on(sched1{}));
+    STATIC_REQUIRE(async::scheduler_hop_count_v<S> == 2);
+    STATIC_REQUIRE(async::redundant_hop_count_v<S> == 1);
+}
+
+TEST_CASE("hops of concurrent senders are added up", "[scheduler_hops]") {
+    using S = decltype(async::when_all(sched1::schedule(),
+                                       async::start_on(sched2{},
+                                                       async::just())));
+    STATIC_REQUIRE(async::scheduler_hop_count_v<S> == 2);
+}
+
+TEST_CASE("hop priorities", "[scheduler_hops]") {
+    using S = decltype(async::fixed_priority_scheduler<3>::schedule() |
+                       async::continue_on(async::fixed_priority_scheduler<1>{}));
+    STATIC_REQUIRE(async::hop_priorities_v<S> ==
+                   std::array<async::priority_t, 2>{3, 1});
+}
+
+TEST_CASE("hop budget passes the sender through", "[scheduler_hops]") {
+    int value{};
+    auto s = sched1::schedule() | async::then([] { return 42; }) |
+             async::continue_on(sched2{}) | async::static_assert_hop_budget<2>();
+    auto op = async::connect(s, receiver{[&](int i) { value = i; }});
+    async::start(op);
+    CHECK(value == 42);
+}
@@ -0,0 +1,139 @@
+#include "detail/common.hpp"
+
+#include <async/env.hpp>
+#include <async/schedulers/edf_task_manager.hpp>
+#include <async/schedulers/priority_scheduler.hpp>
+#include <async/schedulers/timer_manager_interface.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <limits>
+#include <vector>
+
+namespace {
+struct hal {
+    static auto schedule(async::priority_t) {}
+};
+
+using task_t = async::edf_task<int>;
+using task_manager_t = async::edf_task_manager<hal, int>;
+
+std::vector<int> order{};
+
+auto make_task(int id) {
+    return async::create_task<task_t>([id] { order.push_back(id); });
+}
+
+struct deadline_receiver {
+    using is_receiver = void;
+    int deadline;
+
+  private:
+    [[nodiscard]] friend constexpr auto tag_invoke(async::get_env_t,
+                                                   deadline_receiver const &r) {
+        return async::singleton_env<async::get_deadline_t>(r.deadline);
+    }
+
+    friend auto tag_invoke(async::set_value_t, deadline_receiver const &r)
+        -> void {
+        order.push_back(r.deadline);
+    }
+};
+} // namespace
+
+template <> inline auto async::injected_task_manager<> = task_manager_t{};
+
+TEST_CASE("edf_task_manager fulfils concept", "[edf_task_manager]") {
+    static_assert(async::task_manager<task_manager_t>);
+}
+
+TEST_CASE("tasks run in deadline order", "[edf_task_manager]") {
+    order.clear();
+    auto m = task_manager_t{};
+    auto t1 = make_task(1);
+    t1.deadline = 30;
+    auto t2 = make_task(2);
+    t2.deadline = 10;
+    auto t3 = make_task(3);
+    t3.deadline = 20;
+    CHECK(m.enqueue_task(t1, 0));
+    CHECK(m.enqueue_task(t2, 0));
+    CHECK(m.enqueue_task(t3, 0));
+    CHECK(not m.enqueue_task(t3, 0));
+    CHECK(not m.is_idle());
+
+    m.service_tasks<0>();
+    CHECK(order == std::vector{2, 3, 1});
+    CHECK(m.is_idle());
+}
+
+TEST_CASE("tasks with equal deadlines run in FIFO order",
+          "[edf_task_manager]") {
+    order.clear();
+    auto m = task_manager_t{};
+    auto t1 = make_task(1);
+    t1.deadline = 10;
+    auto t2 = make_task(2);
+    t2.deadline = 10;
+    auto t3 = make_task(3);
+    t3.deadline = 5;
+    auto t4 = make_task(4);
+    t4.deadline = 10;
+    CHECK(m.enqueue_task(t1, 0));
+    CHECK(m.enqueue_task(t2, 0));
+    CHECK(m.enqueue_task(t3, 0));
+    CHECK(m.enqueue_task(t4, 0));
+
+    m.service_tasks<0>();
+    CHECK(order == std::vector{3, 1, 2, 4});
+}
+
+TEST_CASE("tasks without a deadline run last", "[edf_task_manager]") {
+    order.clear();
+    auto m = task_manager_t{};
+    auto t1 = async::create_task<task_t>([] { order.push_back(1); });
+    CHECK(t1.deadline == std::numeric_limits<int>::max());
+    auto t2 = make_task(2);
+    t2.deadline = 100;
+    CHECK(m.enqueue_task(t1, 0));
+    CHECK(m.enqueue_task(t2, 0));
+
+    m.service_tasks<0>();
+    CHECK(order == std::vector{2, 1});
+}
+
+TEST_CASE("a task queued while servicing is ordered by its deadline",
+          "[edf_task_manager]") {
+    order.clear();
+    auto m = task_manager_t{};
+    auto t3 = make_task(3);
+    t3.deadline = 30;
+    auto t2 = make_task(2);
+    t2.deadline = 20;
+    auto t1 = async::create_task<task_t>([&] {
+        order.push_back(1);
+        m.enqueue_task(t2, 0);
+    });
+    t1.deadline = 10;
+    CHECK(m.enqueue_task(t3, 0));
+    CHECK(m.enqueue_task(t1, 0));
+
+    m.service_tasks<0>();
+    CHECK(order == std::vector{1, 2, 3});
+}
+
+TEST_CASE("fixed_priority_scheduler takes the deadline from the environment",
+          "[edf_task_manager]") {
+    order.clear();
+    using S = async::fixed_priority_scheduler<0, task_t>;
+    auto op1 = async::connect(S::schedule(), deadline_receiver{30});
+    auto op2 = async::connect(S::schedule(), deadline_receiver{10});
+    auto op3 = async::connect(S::schedule(), deadline_receiver{20});
+    async::start(op1);
+    async::start(op2);
+    async::start(op3);
+
+    async::task_mgr::service_tasks<0>();
+    CHECK(order == std::vector{10, 20, 30});
+    CHECK(async::task_mgr::is_idle());
+}
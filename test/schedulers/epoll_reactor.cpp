@@ -0,0 +1,99 @@
+#include "detail/common.hpp"
+
+#include <async/concepts.hpp>
+#include <async/schedulers/epoll_reactor.hpp>
+#include <async/schedulers/runloop_scheduler.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <system_error>
+#include <thread>
+
+#include <unistd.h>
+
+template <>
+inline auto async::injected_run_loop_idle<> = async::epoll_reactor{};
+
+namespace {
+auto &reactor = async::injected_run_loop_idle<>;
+
+// NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+struct pipe_fds {
+    pipe_fds() { CHECK(::pipe(fds.data()) == 0); }
+    pipe_fds(pipe_fds &&) = delete;
+    ~pipe_fds() {
+        ::close(fds[0]);
+        ::close(fds[1]);
+    }
+    [[nodiscard]] auto read_end() const -> int { return fds[0]; }
+    [[nodiscard]] auto write_end() const -> int { return fds[1]; }
+
+    std::array<int, 2> fds{};
+};
+} // namespace
+
+TEST_CASE("readiness senders advertise their completions",
+          "[epoll_reactor]") {
+    auto s = async::fd_readable(reactor, 0);
+    static_assert(async::sender_of<decltype(s), async::set_value_t()>);
+    static_assert(async::sender_of<decltype(s), async::set_error_t(std::errc)>);
+    static_assert(async::sender_of<decltype(s), async::set_stopped_t()>);
+}
+
+TEST_CASE("an idle run_loop completes a ready descriptor", "[epoll_reactor]") {
+    async::run_loop rl{};
+    pipe_fds p{};
+    bool ready{};
+    auto op = async::connect(async::fd_readable(reactor, p.read_end()),
+                             receiver{[&] {
+                                 ready = true;
+                                 rl.finish();
+                             }});
+    async::start(op);
+    CHECK(not ready);
+
+    CHECK(::write(p.write_end(), "x", 1) == 1);
+    rl.run();
+    CHECK(ready);
+}
+
+TEST_CASE("scheduling from another thread wakes the reactor",
+          "[epoll_reactor]") {
+    async::run_loop rl{};
+    int value{};
+    auto op = async::connect(rl.get_scheduler().schedule(), receiver{[&] {
+                                 value = 42;
+                                 rl.finish();
+                             }});
+    std::thread t{[&] { async::start(op); }};
+    rl.run();
+    t.join();
+    CHECK(value == 42);
+}
+
+TEST_CASE("a descriptor that cannot be watched completes with an error",
+          "[epoll_reactor]") {
+    auto error = std::errc{};
+    auto op = async::connect(async::fd_readable(reactor, -1),
+                             error_receiver{[&](std::errc e) { error = e; }});
+    async::start(op);
+    CHECK(error == std::errc::bad_file_descriptor);
+}
+
+TEST_CASE("a stop request cancels a readiness operation", "[epoll_reactor]") {
+    async::run_loop rl{};
+    pipe_fds p{};
+    bool stopped{};
+    auto r = stoppable_receiver{[&] {
+        stopped = true;
+        rl.finish();
+    }};
+    auto op = async::connect(async::fd_readable(reactor, p.read_end()), r);
+    async::start(op);
+
+    std::thread t{[&] { r.request_stop(); }};
+    rl.run();
+    t.join();
+    CHECK(stopped);
+}
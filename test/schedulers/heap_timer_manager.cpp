@@ -0,0 +1,193 @@
+#include <async/schedulers/heap_timer_manager.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace {
+struct hal {
+    using time_point_t = int;
+    using task_t = async::heap_timer_task<time_point_t>;
+
+    static inline time_point_t current_time{};
+    static inline bool enabled{};
+    static inline std::vector<time_point_t> calls{};
+
+    static auto enable() -> void { enabled = true; }
+    static auto disable() -> void { enabled = false; }
+    static auto set_event_time(time_point_t tp) -> void { calls.push_back(tp); }
+    static auto now() -> time_point_t { return current_time; }
+};
+
+using timer_manager_t = async::heap_timer_manager<hal>;
+} // namespace
+
+TEST_CASE("heap timer manager fulfils concept", "[heap_timer_manager]") {
+    static_assert(async::timer_manager<timer_manager_t>);
+}
+
+TEST_CASE("nothing pending", "[heap_timer_manager]") {
+    auto m = timer_manager_t{};
+    CHECK(m.is_idle());
+}
+
+TEST_CASE("queue a task", "[heap_timer_manager]") {
+    hal::calls.clear();
+    auto t = timer_manager_t::create_task([] {});
+
+    auto m = timer_manager_t{};
+    CHECK(m.run_after(t, 3));
+    CHECK(not m.is_idle());
+    CHECK(hal::enabled);
+    REQUIRE(hal::calls.size() == 1);
+    CHECK(hal::calls[0] == 3);
+}
+
+TEST_CASE("run a queued task", "[heap_timer_manager]") {
+    auto m = timer_manager_t{};
+    int var{};
+    auto t = timer_manager_t::create_task([&] { var = 42; });
+    m.run_after(t, 3);
+    m.service_task();
+    CHECK(var == 42);
+    CHECK(m.is_idle());
+    CHECK(not hal::enabled);
+}
+
+TEST_CASE("queueing a queued task fails", "[heap_timer_manager]") {
+    auto m = timer_manager_t{};
+    auto t = timer_manager_t::create_task([] {});
+    CHECK(m.run_after(t, 3));
+    CHECK(not m.run_after(t, 4));
+    m.service_task();
+    CHECK(m.is_idle());
+}
+
+TEST_CASE("interrupt is set for nearest time", "[heap_timer_manager]") {
+    hal::calls.clear();
+    auto m = timer_manager_t{};
+    auto t1 = timer_manager_t::create_task([] {});
+    auto t2 = timer_manager_t::create_task([] {});
+    auto t3 = timer_manager_t::create_task([] {});
+    m.run_after(t1, 5);
+    m.run_after(t2, 3);
+    m.run_after(t3, 4);
+    CHECK(hal::calls == std::vector{5, 3});
+
+    m.service_task();
+    CHECK(hal::calls.back() == 4);
+}
+
+TEST_CASE("run many tasks in time order", "[heap_timer_manager]") {
+    auto m = timer_manager_t{};
+    std::vector<int> order{};
+    auto const f = [&](int i) { order.push_back(i); };
+    auto tasks = std::array{
+        timer_manager_t::create_task(f), timer_manager_t::create_task(f),
+        timer_manager_t::create_task(f), timer_manager_t::create_task(f),
+        timer_manager_t::create_task(f), timer_manager_t::create_task(f),
+        timer_manager_t::create_task(f), timer_manager_t::create_task(f)};
+    auto const times = std::array{7, 2, 9, 4, 1, 8, 3, 6};
+    for (auto i = std::size_t{}; i < tasks.size(); ++i) {
+        m.run_after(tasks[i].bind_front(times[i]), times[i]);
+    }
+    while (not m.is_idle()) {
+        m.service_task();
+    }
+    CHECK(order == std::vector{1, 2, 3, 4, 6, 7, 8, 9});
+}
+
+TEST_CASE("task can reschedule itself", "[heap_timer_manager]") {
+    auto m = timer_manager_t{};
+    int var{};
+    auto task = timer_manager_t::create_task([&](hal::task_t *t) {
+        CHECK(m.run_after(*t, 1));
+        ++var;
+    });
+    m.run_after(task.bind_front(&task), 1);
+
+    m.service_task();
+    CHECK(var == 1);
+    CHECK(task.pending);
+    m.service_task();
+    CHECK(var == 2);
+    CHECK(not m.is_idle());
+}
+
+TEST_CASE("cancel a scheduled task", "[heap_timer_manager]") {
+    auto m = timer_manager_t{};
+    int var{};
+    auto task = timer_manager_t::create_task([&] { var = 42; });
+    m.run_after(task, 1);
+    CHECK(m.cancel(task));
+    CHECK(not task.pending);
+    CHECK(m.is_idle());
+    CHECK(not hal::enabled);
+    m.service_task();
+    CHECK(var == 0);
+}
+
+TEST_CASE("cancelling an unscheduled task fails", "[heap_timer_manager]") {
+    auto m = timer_manager_t{};
+    auto task = timer_manager_t::create_task([] {});
+    CHECK(not m.cancel(task));
+}
+
+TEST_CASE("cancel tasks anywhere in the heap", "[heap_timer_manager]") {
+    auto m = timer_manager_t{};
+    std::vector<int> order{};
+    auto const f = [&](int i) { order.push_back(i); };
+    auto tasks = std::array{
+        timer_manager_t::create_task(f), timer_manager_t::create_task(f),
+        timer_manager_t::create_task(f), timer_manager_t::create_task(f),
+        timer_manager_t::create_task(f), timer_manager_t::create_task(f),
+        timer_manager_t::create_task(f), timer_manager_t::create_task(f)};
+    auto const times = std::array{7, 2, 9, 4, 1, 8, 3, 6};
+    for (auto i = std::size_t{}; i < tasks.size(); ++i) {
+        m.run_after(tasks[i].bind_front(times[i]), times[i]);
+    }
+    // force some structure into the heap before cancelling
+    m.service_task();
+    CHECK(m.cancel(tasks[3]));
+    CHECK(m.cancel(tasks[2]));
+    CHECK(m.cancel(tasks[1]));
+    while (not m.is_idle()) {
+        m.service_task();
+    }
+    CHECK(order == std::vector{1, 3, 6, 7, 8});
+}
+
+TEST_CASE("run_at queues a task for an absolute time",
+          "[heap_timer_manager]") {
+    hal::calls.clear();
+    auto m = timer_manager_t{};
+    int var{};
+    auto t = timer_manager_t::create_task([&] { var = 42; });
+    hal::current_time = 5;
+    CHECK(m.run_at(t, 8));
+    CHECK(t.expiration_time == 8);
+    REQUIRE(not std::empty(hal::calls));
+    CHECK(hal::calls.back() == 8);
+
+    m.service_task();
+    CHECK(var == 42);
+    CHECK(m.is_idle());
+    hal::current_time = {};
+}
+
+TEST_CASE("next_expiration reports the earliest queued expiry",
+          "[heap_timer_manager]") {
+    auto m = timer_manager_t{};
+    CHECK(m.next_expiration() == std::nullopt);
+
+    auto t1 = timer_manager_t::create_task([] {});
+    m.run_after(t1, 10);
+    auto t2 = timer_manager_t::create_task([] {});
+    m.run_after(t2, 7);
+    CHECK(m.next_expiration() == 7);
+    hal::current_time = 3;
+    CHECK(m.time_until_next() == 4);
+    hal::current_time = {};
+}
@@ -0,0 +1,80 @@
+#include <async/just.hpp>
+#include <async/schedulers/hosted_timer_hal.hpp>
+#include <async/schedulers/time_scheduler.hpp>
+#include <async/schedulers/timer_manager.hpp>
+#include <async/start_on.hpp>
+#include <async/sync_wait.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+namespace {
+using hal_t = async::hosted_timer_hal<>;
+using timer_manager_t = async::generic_timer_manager<hal_t>;
+
+template <typename F> auto wait_for(F &&f) -> bool {
+    auto const deadline = std::chrono::steady_clock::now() + 5s;
+    while (not f()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::yield();
+    }
+    return true;
+}
+} // namespace
+
+template <typename Rep, typename Period>
+struct async::timer_mgr::time_point_for<std::chrono::duration<Rep, Period>> {
+    using type = hal_t::time_point_t;
+};
+
+template <> inline auto async::injected_timer_manager<> = timer_manager_t{};
+
+TEST_CASE("hosted HAL fulfils concept", "[hosted_timer_hal]") {
+    static_assert(async::detail::timer_hal<hal_t>);
+}
+
+TEST_CASE("hosted HAL runs a timer task", "[hosted_timer_hal]") {
+    hal_t::service_thread thread{};
+    std::atomic<bool> done{};
+    auto t = timer_manager_t::create_task([&] { done = true; });
+    auto const start = hal_t::now();
+    async::timer_mgr::detail::run_after(t, 2ms);
+    CHECK(wait_for([&] { return done.load(); }));
+    CHECK(hal_t::now() - start >= 2ms);
+    CHECK(async::timer_mgr::is_idle());
+}
+
+TEST_CASE("hosted HAL runs tasks in expiry order", "[hosted_timer_hal]") {
+    hal_t::service_thread thread{};
+    std::atomic<int> count{};
+    std::array<int, 3> order{};
+    auto f = [&](int i) {
+        order[static_cast<std::size_t>(count.load())] = i;
+        ++count;
+    };
+    auto t1 = timer_manager_t::create_task(f);
+    auto t2 = timer_manager_t::create_task(f);
+    auto t3 = timer_manager_t::create_task(f);
+    async::timer_mgr::detail::run_after(t3.bind_front(3), 6ms);
+    async::timer_mgr::detail::run_after(t1.bind_front(1), 2ms);
+    async::timer_mgr::detail::run_after(t2.bind_front(2), 4ms);
+    CHECK(wait_for([&] { return count == 3; }));
+    CHECK(order == std::array{1, 2, 3});
+}
+
+TEST_CASE("time_scheduler works with the hosted HAL", "[hosted_timer_hal]") {
+    hal_t::service_thread thread{};
+    auto const result =
+        async::start_on(async::time_scheduler{1ms}, async::just(42)) |
+        async::sync_wait();
+    REQUIRE(result.has_value());
+    CHECK(get<0>(*result) == 42);
+}
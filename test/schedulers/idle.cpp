@@ -0,0 +1,56 @@
+#include <async/schedulers/idle.hpp>
+#include <async/schedulers/task_manager.hpp>
+#include <async/schedulers/timer_manager.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <optional>
+
+namespace {
+struct task_hal {
+    static auto schedule(async::priority_t) {}
+};
+
+struct timer_hal {
+    using time_point_t = int;
+    using task_t = async::timer_task<time_point_t>;
+
+    static inline time_point_t current_time{};
+
+    static auto enable() -> void {}
+    static auto disable() -> void {}
+    static auto set_event_time(time_point_t) -> void {}
+    static auto now() -> time_point_t { return current_time; }
+};
+
+using task_manager_t = async::priority_task_manager<task_hal, 8>;
+using timer_manager_t = async::generic_timer_manager<timer_hal>;
+} // namespace
+
+template <> inline auto async::injected_task_manager<> = task_manager_t{};
+template <> inline auto async::injected_timer_manager<> = timer_manager_t{};
+
+TEST_CASE("nothing to do: sleep until an external interrupt", "[idle]") {
+    CHECK(async::max_sleep_duration() == std::nullopt);
+}
+
+TEST_CASE("sleep until the next timer expires", "[idle]") {
+    auto t = timer_manager_t::create_task([] {});
+    async::timer_mgr::detail::run_after(t, 10);
+    timer_hal::current_time = 4;
+    CHECK(async::timer_mgr::next_expiration() == 10);
+    CHECK(async::max_sleep_duration() == 6);
+
+    async::timer_mgr::service_task();
+    CHECK(async::max_sleep_duration() == std::nullopt);
+    timer_hal::current_time = {};
+}
+
+TEST_CASE("no sleep while tasks are queued", "[idle]") {
+    auto t = task_manager_t::create_task([] {});
+    async::task_mgr::detail::enqueue_task(t, 0);
+    CHECK(async::max_sleep_duration() == 0);
+
+    async::task_mgr::service_tasks<0>();
+    CHECK(async::max_sleep_duration() == std::nullopt);
+}
@@ -0,0 +1,103 @@
+#include <async/schedulers/index_linked_task.hpp>
+#include <async/schedulers/task_manager.hpp>
+#include <async/schedulers/timer_manager_interface.hpp>
+
+#include <stdx/bit.hpp>
+#include <stdx/tuple.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace {
+alignas(64) std::array<std::byte, 1024> arena{};
+
+struct region {
+    static auto base() -> std::uintptr_t {
+        return stdx::bit_cast<std::uintptr_t>(arena.data());
+    }
+    constexpr static std::size_t granularity = 8;
+};
+
+using task_t = async::index_single_linked_task<async::task_base, region>;
+using timer_task_t =
+    async::index_double_linked_task<async::detail::default_timer_task<int>,
+                                    region>;
+
+template <typename T, typename... Args>
+auto make_at(std::size_t slot, Args &&...args) -> T * {
+    return std::construct_at(stdx::bit_cast<T *>(arena.data() + slot * 64),
+                             std::forward<Args>(args)...);
+}
+
+struct hal {
+    static auto schedule(async::priority_t) {}
+};
+} // namespace
+
+TEST_CASE("index-linked tasks are smaller than pointer-linked tasks",
+          "[index_linked_task]") {
+    static_assert(sizeof(task_t) < sizeof(async::priority_task));
+    static_assert(sizeof(timer_task_t) < sizeof(async::timer_task<int>));
+    static_assert(async::prioritizable_task<task_t>);
+    static_assert(async::timeable_task<timer_task_t>);
+}
+
+TEST_CASE("an index link reads back the task it was given",
+          "[index_linked_task]") {
+    auto const t = make_at<task_t>(3, async::dispatch_nothing);
+    auto link = task_t::link_t{};
+    CHECK(link.get() == nullptr);
+    link = t;
+    CHECK(link.get() == t);
+    link = nullptr;
+    CHECK(link.get() == nullptr);
+}
+
+TEST_CASE("priority_task_manager queues index-linked tasks",
+          "[index_linked_task]") {
+    auto m = async::priority_task_manager<hal, 2, task_t>{};
+    std::vector<int> order{};
+    auto const f1 = [&] { order.push_back(1); };
+    auto const f2 = [&] { order.push_back(2); };
+    auto const t1 =
+        make_at<async::task<decltype(f1), stdx::tuple<>, task_t>>(0, f1);
+    auto const t2 =
+        make_at<async::task<decltype(f2), stdx::tuple<>, task_t>>(1, f2);
+
+    CHECK(m.enqueue_task(*t2, 0));
+    CHECK(m.enqueue_task(*t1, 0));
+    m.service_tasks<0>();
+    CHECK(order == std::vector{2, 1});
+    CHECK(m.is_idle());
+}
+
+TEST_CASE("index_list inserts and removes in place", "[index_linked_task]") {
+    auto l = async::index_list<timer_task_t>{};
+    auto const t1 = make_at<timer_task_t>(4, async::dispatch_nothing);
+    auto const t2 = make_at<timer_task_t>(5, async::dispatch_nothing);
+    auto const t3 = make_at<timer_task_t>(6, async::dispatch_nothing);
+
+    l.push_back(t1);
+    l.push_back(t3);
+    auto pos = std::begin(l);
+    ++pos;
+    l.insert(pos, t2);
+
+    std::vector<timer_task_t *> tasks{};
+    for (auto &t : l) {
+        tasks.push_back(std::addressof(t));
+    }
+    CHECK(tasks == std::vector{t1, t2, t3});
+
+    l.remove(t2);
+    CHECK(l.pop_front() == t1);
+    CHECK(l.pop_front() == t3);
+    CHECK(std::empty(l));
+}
@@ -0,0 +1,139 @@
+#include "detail/common.hpp"
+
+#include <async/concepts.hpp>
+#include <async/schedulers/io_uring_context.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <system_error>
+#include <thread>
+
+#include <unistd.h>
+
+namespace {
+// NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+struct pipe_fds {
+    pipe_fds() { CHECK(::pipe(fds.data()) == 0); }
+    pipe_fds(pipe_fds &&) = delete;
+    ~pipe_fds() {
+        ::close(fds[0]);
+        ::close(fds[1]);
+    }
+    [[nodiscard]] auto read_end() const -> int { return fds[0]; }
+    [[nodiscard]] auto write_end() const -> int { return fds[1]; }
+
+    std::array<int, 2> fds{};
+};
+
+auto const hello = std::array{std::byte{'h'}, std::byte{'e'}, std::byte{'l'},
+                              std::byte{'l'}, std::byte{'o'}};
+} // namespace
+
+TEST_CASE("io_uring_context senders advertise their completions",
+          "[io_uring_context]") {
+    async::io_uring_context ctx{};
+    auto s = async::async_read(ctx, 0, {});
+    static_assert(
+        async::sender_of<decltype(s), async::set_value_t(std::size_t)>);
+    static_assert(async::sender_of<decltype(s), async::set_error_t(std::errc)>);
+    static_assert(async::sender_of<decltype(async::async_accept(ctx, 0)),
+                                   async::set_value_t(int)>);
+    static_assert(async::sender_of<decltype(ctx.get_scheduler().schedule()),
+                                   async::set_value_t()>);
+}
+
+TEST_CASE("io_uring_context scheduler runs work", "[io_uring_context]") {
+    async::io_uring_context ctx{};
+    if (not ctx.valid()) {
+        WARN("io_uring is unavailable");
+        return;
+    }
+    int value{};
+    auto op = async::connect(ctx.get_scheduler().schedule(),
+                             receiver{[&] { value = 42; }});
+    async::start(op);
+    ctx.finish();
+    ctx.run();
+    CHECK(value == 42);
+}
+
+TEST_CASE("io_uring_context writes and reads a pipe", "[io_uring_context]") {
+    async::io_uring_context ctx{};
+    if (not ctx.valid()) {
+        WARN("io_uring is unavailable");
+        return;
+    }
+    pipe_fds p{};
+    std::array<std::byte, 8> buffer{};
+    std::size_t written{};
+    std::size_t read{};
+
+    auto w = async::connect(
+        async::async_write(ctx, p.write_end(), hello),
+        receiver{[&](std::size_t n) { written = n; }});
+    auto r = async::connect(async::async_read(ctx, p.read_end(), buffer),
+                            receiver{[&](std::size_t n) { read = n; }});
+    async::start(w);
+    async::start(r);
+    ctx.finish();
+    ctx.run();
+    CHECK(written == hello.size());
+    REQUIRE(read == hello.size());
+    CHECK(std::equal(hello.begin(), hello.end(), buffer.begin()));
+}
+
+TEST_CASE("io_uring_context reports errors", "[io_uring_context]") {
+    async::io_uring_context ctx{};
+    if (not ctx.valid()) {
+        WARN("io_uring is unavailable");
+        return;
+    }
+    std::array<std::byte, 8> buffer{};
+    auto error = std::errc{};
+    auto op = async::connect(async::async_read(ctx, -1, buffer),
+                             error_receiver{[&](std::errc e) { error = e; }});
+    async::start(op);
+    ctx.finish();
+    ctx.run();
+    CHECK(error == std::errc::bad_file_descriptor);
+}
+
+TEST_CASE("a stop request cancels a read in flight", "[io_uring_context]") {
+    async::io_uring_context ctx{};
+    if (not ctx.valid()) {
+        WARN("io_uring is unavailable");
+        return;
+    }
+    pipe_fds p{};
+    std::array<std::byte, 8> buffer{};
+    bool stopped{};
+    auto r = stoppable_receiver{[&] { stopped = true; }};
+    auto op = async::connect(async::async_read(ctx, p.read_end(), buffer), r);
+    async::start(op);
+
+    std::thread t{[&] { ctx.run(); }};
+    r.request_stop();
+    ctx.finish();
+    t.join();
+    CHECK(stopped);
+}
+
+TEST_CASE("operations started from another thread wake the context",
+          "[io_uring_context]") {
+    async::io_uring_context ctx{};
+    if (not ctx.valid()) {
+        WARN("io_uring is unavailable");
+        return;
+    }
+    std::thread t{[&] { ctx.run(); }};
+    int value{};
+    auto op = async::connect(ctx.get_scheduler().schedule(),
+                             receiver{[&] { value = 42; }});
+    async::start(op);
+    ctx.finish();
+    t.join();
+    CHECK(value == 42);
+}
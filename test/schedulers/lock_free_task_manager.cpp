@@ -0,0 +1,167 @@
+#include <async/schedulers/lock_free_task_manager.hpp>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+struct hal {
+    static inline std::vector<async::priority_t> calls{};
+    static auto schedule(async::priority_t p) { calls.push_back(p); }
+};
+
+using task_manager_t = async::lock_free_task_manager<hal, 8>;
+
+struct mt_hal {
+    static auto schedule(async::priority_t) {}
+};
+using mt_task_manager_t = async::lock_free_task_manager<mt_hal, 8>;
+} // namespace
+
+TEST_CASE("lock-free task manager fulfils concept",
+          "[lock_free_task_manager]") {
+    static_assert(async::task_manager<task_manager_t>);
+}
+
+TEST_CASE("nothing pending", "[lock_free_task_manager]") {
+    auto m = task_manager_t{};
+    CHECK(m.is_idle());
+}
+
+TEST_CASE("queue a task", "[lock_free_task_manager]") {
+    hal::calls.clear();
+    auto m = task_manager_t{};
+    auto task = task_manager_t::create_task([] {});
+    CHECK(m.enqueue_task(task, 3));
+    CHECK(not m.is_idle());
+    REQUIRE(hal::calls.size() == 1);
+    CHECK(hal::calls[0] == 3);
+}
+
+TEST_CASE("run a queued task", "[lock_free_task_manager]") {
+    auto m = task_manager_t{};
+    int var{};
+    auto task = task_manager_t::create_task([&] { var = 42; });
+    CHECK(m.enqueue_task(task, 3));
+    m.service_tasks<3>();
+    CHECK(var == 42);
+    CHECK(m.is_idle());
+}
+
+TEST_CASE("queueing a task is idempotent", "[lock_free_task_manager]") {
+    hal::calls.clear();
+    auto m = task_manager_t{};
+    int var{};
+    auto task = task_manager_t::create_task([&] { ++var; });
+    CHECK(m.enqueue_task(task, 3));
+    CHECK(not m.enqueue_task(task, 3));
+    REQUIRE(hal::calls.size() == 1);
+    m.service_tasks<3>();
+    CHECK(var == 1);
+    CHECK(m.is_idle());
+}
+
+TEST_CASE("run tasks in FIFO order", "[lock_free_task_manager]") {
+    auto m = task_manager_t{};
+    int var{1};
+    auto task1 = task_manager_t::create_task([&] { var *= 2; });
+    auto task2 = task_manager_t::create_task([&] { var += 2; });
+    auto task3 = task_manager_t::create_task([&] { var *= 3; });
+    CHECK(m.enqueue_task(task1, 0));
+    CHECK(m.enqueue_task(task2, 0));
+    CHECK(m.enqueue_task(task3, 0));
+    m.service_tasks<0>();
+    CHECK(var == 12);
+    CHECK(m.is_idle());
+}
+
+TEST_CASE("don't run a queued task of a different priority",
+          "[lock_free_task_manager]") {
+    auto m = task_manager_t{};
+    int var{};
+    auto task = task_manager_t::create_task([&] { var = 42; });
+    CHECK(m.enqueue_task(task, 1));
+    m.service_tasks<0>();
+    CHECK(not m.is_idle());
+    CHECK(var == 0);
+    m.service_tasks<1>();
+    CHECK(var == 42);
+}
+
+TEST_CASE("task can requeue itself (immediate execution)",
+          "[lock_free_task_manager]") {
+    auto m = task_manager_t{};
+    int var{};
+
+    auto task = task_manager_t::create_task(
+        [&](task_manager_t *mgr, async::priority_task *t) {
+            if (var++ == 0) {
+                CHECK(mgr->enqueue_task(*t, 0));
+            }
+        });
+    CHECK(m.enqueue_task(task.bind_front(&m, &task), 0));
+    m.service_tasks<0, async::requeue_policy::immediate>();
+    CHECK(var == 2);
+    CHECK(m.is_idle());
+}
+
+TEST_CASE("task can requeue itself (deferred execution)",
+          "[lock_free_task_manager]") {
+    auto m = task_manager_t{};
+    int var{};
+
+    auto task = task_manager_t::create_task(
+        [&](task_manager_t *mgr, async::priority_task *t) {
+            ++var;
+            CHECK(mgr->enqueue_task(*t, 0));
+        });
+    CHECK(m.enqueue_task(task.bind_front(&m, &task), 0));
+    m.service_tasks<0, async::requeue_policy::deferred>();
+    CHECK(var == 1);
+    CHECK(not m.is_idle());
+}
+
+TEMPLATE_TEST_CASE("multiple producers and one consumer",
+                   "[lock_free_task_manager]",
+                   async::requeue_policy::deferred,
+                   async::requeue_policy::immediate) {
+    constexpr auto num_producers = 4;
+    constexpr auto tasks_per_producer = 1000;
+
+    auto m = mt_task_manager_t{};
+    std::atomic<int> runs{};
+    std::atomic<bool> producing{true};
+    auto const f = [&] { ++runs; };
+    auto tasks = std::array{
+        mt_task_manager_t::create_task(f), mt_task_manager_t::create_task(f),
+        mt_task_manager_t::create_task(f), mt_task_manager_t::create_task(f)};
+
+    std::atomic<int> enqueued{};
+    std::vector<std::thread> producers{};
+    for (auto i = 0; i < num_producers; ++i) {
+        producers.emplace_back([&, i] {
+            for (auto j = 0; j < tasks_per_producer; ++j) {
+                if (m.enqueue_task(tasks[static_cast<std::size_t>(i)], 0)) {
+                    ++enqueued;
+                }
+            }
+        });
+    }
+    auto consumer = std::thread{[&] {
+        while (producing or not m.is_idle()) {
+            m.service_tasks<0, TestType>();
+        }
+    }};
+    for (auto &t : producers) {
+        t.join();
+    }
+    producing = false;
+    consumer.join();
+
+    CHECK(m.is_idle());
+    CHECK(runs == enqueued);
+}
@@ -15,10 +15,15 @@
 #include <catch2/catch_test_macros.hpp>
 
 #include <concepts>
+#include <cstddef>
 
 namespace {
 struct hal {
     static auto schedule(async::priority_t) {}
+    static auto current_priority() -> async::priority_t { return current; }
+
+    // below every task priority, as in thread mode
+    static inline async::priority_t current{8};
 };
 
 using task_manager_t = async::priority_task_manager<hal, 8>;
@@ -123,3 +128,73 @@ TEST_CASE("request and response", "[priority_scheduler]") {
     CHECK(var == 86);
     CHECK(async::task_mgr::is_idle());
 }
+
+TEST_CASE("fixed_priority_scheduler tasks can be serviced by runtime priority",
+          "[priority_scheduler]") {
+    auto s = async::fixed_priority_scheduler<3>{};
+    int var{};
+    async::sender auto sndr =
+        async::start_on(s, async::just_result_of([&] { var = 42; }));
+    auto op = async::connect(sndr, universal_receiver{});
+    async::start(op);
+
+    auto const p = async::priority_t{3};
+    async::task_mgr::service_tasks(p);
+    CHECK(var == 42);
+}
+
+namespace {
+template <std::size_t MaxDepth = 4>
+using handoff_scheduler = async::fixed_priority_scheduler<
+    2, async::priority_task, async::handoff::when_priority_permits<MaxDepth>>;
+} // namespace
+
+TEST_CASE("handoff runs a task inline at or above its priority",
+          "[priority_scheduler]") {
+    int var{};
+    auto op = async::connect(handoff_scheduler<>::schedule(),
+                             receiver{[&] { var = 42; }});
+
+    hal::current = 2;
+    async::start(op);
+    hal::current = 8;
+    CHECK(var == 42);
+    CHECK(async::task_mgr::is_idle());
+}
+
+TEST_CASE("handoff queues a task below its priority", "[priority_scheduler]") {
+    int var{};
+    auto op = async::connect(handoff_scheduler<>::schedule(),
+                             receiver{[&] { var = 42; }});
+
+    hal::current = 3;
+    async::start(op);
+    hal::current = 8;
+    CHECK(var == 0);
+    async::task_mgr::service_tasks<2>();
+    CHECK(var == 42);
+    CHECK(async::task_mgr::is_idle());
+}
+
+TEST_CASE("handoff queues tasks beyond its maximum depth",
+          "[priority_scheduler]") {
+    int var{};
+    auto op3 = async::connect(handoff_scheduler<2>::schedule(),
+                              receiver{[&] { ++var; }});
+    auto op2 = async::connect(handoff_scheduler<2>::schedule(), receiver{[&] {
+                                  ++var;
+                                  async::start(op3);
+                              }});
+    auto op1 = async::connect(handoff_scheduler<2>::schedule(), receiver{[&] {
+                                  ++var;
+                                  async::start(op2);
+                              }});
+
+    hal::current = 0;
+    async::start(op1);
+    hal::current = 8;
+    CHECK(var == 2);
+    async::task_mgr::service_tasks<2>();
+    CHECK(var == 3);
+    CHECK(async::task_mgr::is_idle());
+}
@@ -0,0 +1,90 @@
+#include "detail/common.hpp"
+
+#include <async/concepts.hpp>
+#include <async/continue_on.hpp>
+#include <async/just.hpp>
+#include <async/schedulers/remote_core_scheduler.hpp>
+#include <async/schedulers/task_manager.hpp>
+#include <async/tags.hpp>
+#include <async/then.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <concepts>
+#include <cstddef>
+#include <vector>
+
+namespace {
+struct hal {
+    static auto schedule(async::priority_t) {}
+};
+
+using task_manager_t = async::priority_task_manager<hal, 8>;
+
+struct ipc_hal {
+    template <std::size_t Core> static auto queue() -> async::remote_queue<> & {
+        static async::remote_queue<> q{};
+        return q;
+    }
+
+    template <std::size_t Core> static auto notify() -> void {
+        ++notifications;
+    }
+
+    static inline int notifications{};
+};
+} // namespace
+
+template <> inline auto async::injected_task_manager<> = task_manager_t{};
+template <> inline auto async::injected_remote_core_hal<> = ipc_hal{};
+
+TEST_CASE("remote_core_scheduler fulfils concept", "[remote_core_scheduler]") {
+    static_assert(async::scheduler<async::remote_core_scheduler<1, 0>>);
+    static_assert(async::remote_core_hal<ipc_hal>);
+}
+
+TEST_CASE("sender has the remote_core_scheduler as its completion scheduler",
+          "[remote_core_scheduler]") {
+    using S = async::remote_core_scheduler<1, 0>;
+    auto s = S::schedule();
+    auto cs =
+        async::get_completion_scheduler<async::set_value_t>(async::get_env(s));
+    static_assert(std::same_as<decltype(cs), S>);
+}
+
+TEST_CASE("remote_core_scheduler hands tasks to the target core",
+          "[remote_core_scheduler]") {
+    ipc_hal::notifications = 0;
+    std::vector<int> order{};
+    auto op1 = async::connect(async::remote_core_scheduler<1, 0>::schedule(),
+                              receiver{[&] { order.push_back(1); }});
+    auto op2 = async::connect(async::remote_core_scheduler<1, 0>::schedule(),
+                              receiver{[&] { order.push_back(2); }});
+
+    async::start(op1);
+    async::start(op2);
+    CHECK(ipc_hal::notifications == 1);
+    CHECK(order.empty());
+
+    // on core 1, in the IPC interrupt
+    CHECK(async::remote_core::receive<1>() == 2);
+    CHECK(order.empty());
+    async::task_mgr::service_tasks<0>();
+    CHECK(order == std::vector{1, 2});
+    CHECK(async::task_mgr::is_idle());
+}
+
+TEST_CASE("continue_on can hop to another core", "[remote_core_scheduler]") {
+    ipc_hal::notifications = 0;
+    int value{};
+    auto s = async::just(42) |
+             async::continue_on(async::remote_core_scheduler<1, 0>{}) |
+             async::then([](int i) { return i * 2; });
+    auto op = async::connect(s, receiver{[&](int i) { value = i; }});
+    async::start(op);
+    CHECK(ipc_hal::notifications == 1);
+
+    CHECK(async::remote_core::receive<1>() == 1);
+    async::task_mgr::service_tasks<0>();
+    CHECK(value == 84);
+}
@@ -0,0 +1,153 @@
+#include <async/schedulers/replay.hpp>
+#include <async/schedulers/replay_player.hpp>
+#include <async/schedulers/task_manager.hpp>
+#include <async/schedulers/timer_manager.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <vector>
+
+namespace {
+auto test_log = async::replay::log<16>{};
+
+struct sink {
+    static auto record(async::replay::event e) -> void { test_log.record(e); }
+};
+
+struct hal {
+    static auto schedule(async::priority_t) {}
+};
+
+struct timer_hal {
+    using time_point_t = int;
+    using task_t = async::replayable_timer_task<time_point_t>;
+
+    static inline time_point_t current_time{};
+
+    static auto enable() -> void {}
+    static auto disable() -> void {}
+    static auto set_event_time(time_point_t) -> void {}
+    static auto now() -> time_point_t { return current_time; }
+};
+
+using recording_t = async::instrumentation::recording<sink>;
+using task_manager_t =
+    async::priority_task_manager<hal, 4, async::replayable_priority_task,
+                                 recording_t>;
+using timer_manager_t = async::generic_timer_manager<timer_hal, recording_t>;
+using player_t = async::replay::player<int>;
+
+auto kinds() {
+    std::vector<async::replay::event_kind> v{};
+    for (auto const &e : test_log.events()) {
+        v.push_back(e.kind);
+    }
+    return v;
+}
+} // namespace
+
+TEST_CASE("recording managers fulfil concepts", "[replay]") {
+    static_assert(async::task_manager<task_manager_t>);
+    static_assert(async::timer_manager<timer_manager_t>);
+    static_assert(async::task_manager<player_t::task_manager_t>);
+    static_assert(async::timer_manager<player_t::timer_manager_t>);
+}
+
+TEST_CASE("task manager records enqueue and run order", "[replay]") {
+    test_log.clear();
+    using enum async::replay::event_kind;
+    auto m = task_manager_t{};
+    auto t1 = task_manager_t::create_task([] {});
+    auto t2 = task_manager_t::create_task([] {});
+    m.enqueue_task(t1, 1);
+    m.enqueue_task(t2, 0);
+    m.service_tasks<0>();
+    m.service_tasks<1>();
+
+    CHECK(kinds() == std::vector{enqueue, enqueue, run, run});
+    auto const events = test_log.events();
+    CHECK(events[2].id == 1);
+    CHECK(events[2].priority == 0);
+    CHECK(events[3].id == 0);
+    CHECK(events[3].priority == 1);
+}
+
+TEST_CASE("timer manager records arm, expiry and cancel", "[replay]") {
+    test_log.clear();
+    using enum async::replay::event_kind;
+    auto m = timer_manager_t{};
+    auto t1 = timer_manager_t::create_task([] {});
+    auto t2 = timer_manager_t::create_task([] {});
+    timer_hal::current_time = 0;
+    m.run_after(t1, 5);
+    m.run_after(t2, 10);
+    m.cancel(t2);
+    timer_hal::current_time = 5;
+    m.service_task();
+
+    CHECK(kinds() == std::vector{arm, arm, cancel, expiry});
+    CHECK(test_log.events()[3].id == 0);
+}
+
+TEST_CASE("log counts events beyond its capacity", "[replay]") {
+    auto l = async::replay::log<2>{};
+    for (auto i = 0u; i < 3; ++i) {
+        l.record({i, async::replay::event_kind::run, 0});
+    }
+    CHECK(l.size() == 2);
+    CHECK(l.overflowed());
+}
+
+TEST_CASE("player dispatches tasks in recorded order", "[replay]") {
+    using enum async::replay::event_kind;
+    auto const events = std::vector<async::replay::event>{
+        {0, enqueue, 1}, {1, enqueue, 0}, {1, run, 0}, {0, run, 1}};
+    auto p = player_t{events};
+    auto m = p.get_task_manager();
+
+    std::vector<int> order{};
+    auto t1 = player_t::task_manager_t::create_task([&] { order.push_back(1); });
+    auto t2 = player_t::task_manager_t::create_task([&] { order.push_back(2); });
+    m.enqueue_task(t1, 1);
+    m.enqueue_task(t2, 0);
+    CHECK(not m.is_idle());
+
+    CHECK(p.run() == async::replay::status::complete);
+    CHECK(order == std::vector{2, 1});
+    CHECK(m.is_idle());
+}
+
+TEST_CASE("player interleaves tasks and timers", "[replay]") {
+    using enum async::replay::event_kind;
+    auto const events = std::vector<async::replay::event>{
+        {0, arm, 0}, {0, expiry, 0}, {0, enqueue, 2}, {0, run, 2}};
+    auto p = player_t{events};
+    auto tm = p.get_task_manager();
+    auto timers = p.get_timer_manager();
+
+    std::vector<int> order{};
+    auto task = player_t::task_manager_t::create_task(
+        [&] { order.push_back(p.now()); });
+    auto timer = player_t::timer_manager_t::create_task([&] {
+        order.push_back(-1);
+        tm.enqueue_task(task, 2);
+    });
+    timers.run_after(timer, 7);
+
+    CHECK(p.run() == async::replay::status::complete);
+    CHECK(order == std::vector{-1, 7});
+}
+
+TEST_CASE("player stops where the replay diverges", "[replay]") {
+    using enum async::replay::event_kind;
+    auto const events = std::vector<async::replay::event>{
+        {0, enqueue, 0}, {1, enqueue, 0}, {1, run, 0}};
+    auto p = player_t{events};
+    auto m = p.get_task_manager();
+
+    auto t = player_t::task_manager_t::create_task([] {});
+    m.enqueue_task(t, 0);
+
+    CHECK(p.run() == async::replay::status::diverged);
+    CHECK(p.position() == 1);
+}
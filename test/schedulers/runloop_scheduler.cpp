@@ -3,9 +3,16 @@
 #include <async/completion_scheduler.hpp>
 #include <async/schedulers/runloop_scheduler.hpp>
 
+#include <stdx/functional.hpp>
+
 #include <catch2/catch_test_macros.hpp>
 
+#include <array>
+#include <atomic>
 #include <concepts>
+#include <optional>
+#include <thread>
+#include <vector>
 
 TEST_CASE("runloop_scheduler fulfils concept", "[runloop_scheduler]") {
     static_assert(
@@ -42,3 +49,170 @@ TEST_CASE("runloop operation", "[runloop_scheduler]") {
     rl.run();
     CHECK(value == 42);
 }
+
+TEST_CASE("runloop runs operations in the order they were pushed",
+          "[runloop_scheduler]") {
+    std::vector<int> order{};
+
+    async::run_loop rl{};
+    auto s = rl.get_scheduler().schedule();
+    auto op1 = async::connect(s, receiver{[&] { order.push_back(1); }});
+    auto op2 = async::connect(s, receiver{[&] { order.push_back(2); }});
+    auto op3 = async::connect(s, receiver{[&] { order.push_back(3); }});
+    async::start(op1);
+    async::start(op2);
+    rl.finish();
+    async::start(op3);
+
+    rl.run();
+    CHECK(order == std::vector{1, 2, 3});
+}
+
+TEST_CASE("runloop consumes operations pushed from several threads",
+          "[runloop_scheduler]") {
+    constexpr auto num_threads = 4;
+    constexpr auto ops_per_thread = 1000;
+    std::atomic<int> count{};
+
+    async::run_loop rl{};
+    auto s = rl.get_scheduler().schedule();
+    auto const r = receiver{[&] { ++count; }};
+    using op_t = decltype(async::connect(s, r));
+
+    std::vector<std::thread> producers{};
+    std::array<std::array<std::optional<op_t>, ops_per_thread>, num_threads>
+        ops{};
+    for (auto &thread_ops : ops) {
+        producers.emplace_back([&] {
+            for (auto &op : thread_ops) {
+                async::start(op.emplace(
+                    stdx::with_result_of{[&] { return async::connect(s, r); }}));
+            }
+        });
+    }
+    auto finisher = std::thread{[&] {
+        for (auto &t : producers) {
+            t.join();
+        }
+        rl.finish();
+    }};
+
+    rl.run();
+    finisher.join();
+    CHECK(count == num_threads * ops_per_thread);
+}
+
+TEST_CASE("runloop drain runs what is queued without waiting",
+          "[runloop_scheduler]") {
+    int count{};
+
+    async::run_loop rl{};
+    auto s = rl.get_scheduler().schedule();
+    auto op1 = async::connect(s, receiver{[&] { ++count; }});
+    auto op2 = async::connect(s, receiver{[&] { ++count; }});
+    CHECK(rl.drain() == 0);
+
+    async::start(op1);
+    async::start(op2);
+    CHECK(rl.drain() == 2);
+    CHECK(count == 2);
+    CHECK(rl.drain() == 0);
+}
+
+TEST_CASE("priority_run_loop scheduler fulfils concept",
+          "[runloop_scheduler]") {
+    static_assert(async::scheduler<decltype(async::priority_run_loop<4>{}
+                                                .get_scheduler(0))>);
+}
+
+TEST_CASE("priority_run_loop schedulers compare by loop and priority",
+          "[runloop_scheduler]") {
+    async::priority_run_loop<4> rl1{};
+    async::priority_run_loop<4> rl2{};
+    CHECK(rl1.get_scheduler(1) == rl1.get_scheduler(1));
+    CHECK(rl1.get_scheduler(1) != rl1.get_scheduler(2));
+    CHECK(rl1.get_scheduler(1) != rl2.get_scheduler(1));
+}
+
+TEST_CASE("priority_run_loop checks a static priority at compile time",
+          "[runloop_scheduler]") {
+    using loop_t = async::priority_run_loop<4>;
+    static_assert(loop_t::valid_priority<3>());
+    static_assert(not loop_t::valid_priority<4>());
+    loop_t rl{};
+    CHECK(rl.get_scheduler<2>() == rl.get_scheduler(2));
+}
+
+TEST_CASE("priority_run_loop runs higher priorities first",
+          "[runloop_scheduler]") {
+    std::vector<int> order{};
+
+    async::priority_run_loop<4> rl{};
+    auto op3 = async::connect(rl.get_scheduler(3).schedule(),
+                              receiver{[&] { order.push_back(3); }});
+    auto op1 = async::connect(rl.get_scheduler(1).schedule(),
+                              receiver{[&] { order.push_back(1); }});
+    auto op0 = async::connect(rl.get_scheduler(0).schedule(),
+                              receiver{[&] { order.push_back(0); }});
+    async::start(op3);
+    async::start(op1);
+    async::start(op0);
+    rl.finish();
+    rl.run();
+    CHECK(order == std::vector{0, 1, 3});
+}
+
+TEST_CASE("priority_run_loop runs the same priority in order",
+          "[runloop_scheduler]") {
+    std::vector<int> order{};
+
+    async::priority_run_loop<2> rl{};
+    auto s = rl.get_scheduler(1).schedule();
+    auto op1 = async::connect(s, receiver{[&] { order.push_back(1); }});
+    auto op2 = async::connect(s, receiver{[&] { order.push_back(2); }});
+    auto op3 = async::connect(s, receiver{[&] { order.push_back(3); }});
+    async::start(op1);
+    async::start(op2);
+    async::start(op3);
+    rl.finish();
+    rl.run();
+    CHECK(order == std::vector{1, 2, 3});
+}
+
+TEST_CASE("priority_run_loop work scheduled while running overtakes lower "
+          "priorities",
+          "[runloop_scheduler]") {
+    std::vector<int> order{};
+
+    async::priority_run_loop<3> rl{};
+    auto urgent = async::connect(rl.get_scheduler(0).schedule(),
+                                 receiver{[&] { order.push_back(0); }});
+    auto first = async::connect(rl.get_scheduler(1).schedule(),
+                                receiver{[&] {
+                                    order.push_back(1);
+                                    async::start(urgent);
+                                }});
+    auto later = async::connect(rl.get_scheduler(2).schedule(),
+                                receiver{[&] { order.push_back(2); }});
+    async::start(later);
+    async::start(first);
+    rl.finish();
+    rl.run();
+    CHECK(order == std::vector{1, 0, 2});
+}
+
+TEST_CASE("priority_run_loop can be woken from another thread",
+          "[runloop_scheduler]") {
+    std::atomic<int> count{};
+
+    async::priority_run_loop<2> rl{};
+    auto op = async::connect(rl.get_scheduler(0).schedule(),
+                             receiver{[&] {
+                                 ++count;
+                                 rl.finish();
+                             }});
+    auto t = std::thread{[&] { async::start(op); }};
+    rl.run();
+    t.join();
+    CHECK(count == 1);
+}
@@ -0,0 +1,198 @@
+#include "detail/common.hpp"
+
+#include <async/completion_scheduler.hpp>
+#include <async/concepts.hpp>
+#include <async/env.hpp>
+#include <async/schedulers/static_thread_pool.hpp>
+
+#include <stdx/functional.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+
+TEST_CASE("static_thread_pool scheduler fulfils concept",
+          "[static_thread_pool]") {
+    static_assert(async::scheduler<
+                  decltype(async::static_thread_pool<1>{}.get_scheduler())>);
+}
+
+TEST_CASE("schedulers from the same pool compare equal",
+          "[static_thread_pool]") {
+    async::static_thread_pool<1> p1{};
+    async::static_thread_pool<1> p2{};
+
+    auto s = p1.get_scheduler();
+    CHECK(s != p2.get_scheduler());
+    CHECK(s == p1.get_scheduler());
+}
+
+TEST_CASE("sender has the pool scheduler as its completion scheduler",
+          "[static_thread_pool]") {
+    async::static_thread_pool<1> p{};
+    auto s = p.get_scheduler();
+    CHECK(async::get_completion_scheduler<async::set_value_t>(
+              async::get_env(s.schedule())) == s);
+}
+
+TEST_CASE("static_thread_pool sender completes on a worker thread",
+          "[static_thread_pool]") {
+    auto const this_thread_id = std::this_thread::get_id();
+    std::thread::id other_thread_id{};
+
+    bool recvd{};
+    std::mutex m{};
+    std::condition_variable cv{};
+
+    async::static_thread_pool<2> p{};
+    auto op = async::connect(p.get_scheduler().schedule(),
+                             receiver{[&] {
+                                 std::lock_guard l{m};
+                                 other_thread_id = std::this_thread::get_id();
+                                 recvd = true;
+                                 cv.notify_one();
+                             }});
+    async::start(op);
+
+    std::unique_lock l{m};
+    cv.wait(l, [&] { return recvd; });
+    CHECK(this_thread_id != other_thread_id);
+}
+
+TEST_CASE("static_thread_pool runs queued work before it is destroyed",
+          "[static_thread_pool]") {
+    std::atomic<int> count{};
+    auto const f = [&] { ++count; };
+    using pool_t = async::static_thread_pool<4>;
+    using op_t = async::connect_result_t<
+        decltype(std::declval<pool_t &>().get_scheduler().schedule()),
+        decltype(receiver{f})>;
+
+    auto ops = std::array<std::optional<op_t>, 100>{};
+    {
+        pool_t p{};
+        auto s = p.get_scheduler().schedule();
+        for (auto &op : ops) {
+            op.emplace(stdx::with_result_of{
+                [&] { return async::connect(s, receiver{f}); }});
+            async::start(*op);
+        }
+    }
+    CHECK(count == 100);
+}
+
+TEST_CASE("work scheduled on a worker always runs on that worker",
+          "[static_thread_pool]") {
+    std::array<std::thread::id, 20> ids{};
+    std::atomic<int> count{};
+    auto const f = [&] { ids[count++] = std::this_thread::get_id(); };
+    using pool_t = async::static_thread_pool<4>;
+    using op_t = async::connect_result_t<
+        decltype(std::declval<pool_t &>().get_scheduler().schedule_on(0)),
+        decltype(receiver{f})>;
+
+    auto ops = std::array<std::optional<op_t>, 20>{};
+    {
+        pool_t p{};
+        auto s = p.get_scheduler().schedule_on(2);
+        for (auto &op : ops) {
+            op.emplace(stdx::with_result_of{
+                [&] { return async::connect(s, receiver{f}); }});
+            async::start(*op);
+        }
+    }
+    CHECK(count == 20);
+    for (auto const &id : ids) {
+        CHECK(id == ids[0]);
+    }
+}
+
+TEST_CASE("sender scheduled on a worker has that worker's scheduler as its "
+          "completion scheduler",
+          "[static_thread_pool]") {
+    async::static_thread_pool<2> p{};
+    auto s = p.get_scheduler();
+    auto cs = async::get_completion_scheduler<async::set_value_t>(
+        async::get_env(s.schedule_on(1)));
+    CHECK(cs == p.get_scheduler_on(1));
+    CHECK(cs != s);
+    CHECK(cs != p.get_scheduler_on(0));
+}
+
+TEST_CASE("local scheduler prefers the current worker's queue",
+          "[static_thread_pool]") {
+    async::static_thread_pool<2> p{};
+    CHECK(p.get_local_scheduler() == p.get_scheduler());
+
+    std::optional<decltype(p.get_scheduler())> local{};
+    bool recvd{};
+    std::mutex m{};
+    std::condition_variable cv{};
+
+    auto op = async::connect(p.get_scheduler().schedule_on(1),
+                             receiver{[&] {
+                                 std::lock_guard l{m};
+                                 local = p.get_local_scheduler();
+                                 recvd = true;
+                                 cv.notify_one();
+                             }});
+    async::start(op);
+
+    std::unique_lock l{m};
+    cv.wait(l, [&] { return recvd; });
+    CHECK(local == p.get_scheduler_on(1));
+}
+
+TEST_CASE("the pool's environment gives the local scheduler",
+          "[static_thread_pool]") {
+    async::static_thread_pool<2> p{};
+    CHECK(async::get_scheduler(async::get_env(p)) == p.get_scheduler());
+
+    std::optional<decltype(p.get_scheduler())> local{};
+    bool recvd{};
+    std::mutex m{};
+    std::condition_variable cv{};
+
+    auto op = async::connect(p.get_scheduler().schedule_on(0),
+                             receiver{[&] {
+                                 std::lock_guard l{m};
+                                 local = async::get_scheduler(
+                                     async::get_env(p));
+                                 recvd = true;
+                                 cv.notify_one();
+                             }});
+    async::start(op);
+
+    std::unique_lock l{m};
+    cv.wait(l, [&] { return recvd; });
+    CHECK(local == p.get_scheduler_on(0));
+}
+
+TEST_CASE("static_thread_pool with pinned workers runs work",
+          "[static_thread_pool]") {
+    std::atomic<int> count{};
+    auto const f = [&] { ++count; };
+    using pool_t = async::static_thread_pool<2>;
+    using op_t = async::connect_result_t<
+        decltype(std::declval<pool_t &>().get_scheduler().schedule()),
+        decltype(receiver{f})>;
+
+    auto ops = std::array<std::optional<op_t>, 10>{};
+    {
+        pool_t p{std::array<std::size_t, 2>{0, 0}};
+        auto s = p.get_scheduler().schedule();
+        for (auto &op : ops) {
+            op.emplace(stdx::with_result_of{
+                [&] { return async::connect(s, receiver{f}); }});
+            async::start(*op);
+        }
+    }
+    CHECK(count == 10);
+}
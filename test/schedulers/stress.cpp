@@ -0,0 +1,270 @@
+#include "detail/common.hpp"
+
+#include <async/concepts.hpp>
+#include <async/schedulers/runloop_scheduler.hpp>
+#include <async/schedulers/task_manager.hpp>
+#include <async/schedulers/timer_manager.hpp>
+#include <async/stop_token.hpp>
+
+#include <stdx/functional.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <vector>
+
+// These tests run the schedulers' shared state from several threads at once.
+// They check invariants that hold however the threads interleave, and are
+// meant to be run under ThreadSanitizer (as the sanitizer CI job does).
+
+namespace {
+constexpr auto num_threads = 4;
+
+template <typename F> auto on_threads(int n, F f) -> void {
+    std::vector<std::thread> threads{};
+    for (auto i = 0; i < n; ++i) {
+        threads.emplace_back(f, i);
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+}
+
+template <typename T, typename F>
+auto make_all(std::size_t n, F &&make) -> std::vector<std::optional<T>> {
+    auto v = std::vector<std::optional<T>>(n);
+    for (auto &x : v) {
+        x.emplace(stdx::with_result_of{make});
+    }
+    return v;
+}
+
+struct task_hal {
+    static auto schedule(async::priority_t) -> void {}
+};
+using task_manager_t = async::priority_task_manager<task_hal, 8>;
+
+std::atomic<int> ticks{};
+
+struct timer_hal {
+    using time_point_t = int;
+    using task_t = async::timer_task<time_point_t>;
+
+    static auto enable() -> void {}
+    static auto disable() -> void {}
+    static auto set_event_time(time_point_t) -> void {}
+    static auto now() -> time_point_t { return ticks.load(); }
+};
+using timer_manager_t = async::generic_timer_manager<timer_hal>;
+} // namespace
+
+TEST_CASE("priority_task_manager runs every task enqueued by many threads",
+          "[stress]") {
+    constexpr auto tasks_per_thread = 16;
+    constexpr auto rounds = 500;
+
+    auto m = task_manager_t{};
+    std::atomic<int> runs{};
+    std::atomic<int> enqueued{};
+    std::atomic<bool> producing{true};
+    auto const f = [&] { ++runs; };
+    auto tasks = make_all<decltype(task_manager_t::create_task(f))>(
+        num_threads * tasks_per_thread,
+        [&] { return task_manager_t::create_task(f); });
+
+    auto consumer = std::thread{[&] {
+        while (producing or not m.is_idle()) {
+            while (m.service_highest()) {
+            }
+        }
+    }};
+    on_threads(num_threads, [&](int i) {
+        for (auto r = 0; r < rounds; ++r) {
+            for (auto j = 0; j < tasks_per_thread; ++j) {
+                auto &t = tasks[static_cast<std::size_t>(
+                    i * tasks_per_thread + j)];
+                if (m.enqueue_task(*t,
+                                   static_cast<async::priority_t>(j % 8))) {
+                    ++enqueued;
+                }
+            }
+        }
+    });
+    producing = false;
+    consumer.join();
+
+    CHECK(m.is_idle());
+    CHECK(runs == enqueued);
+}
+
+TEST_CASE("generic_timer_manager fires or cancels every timer armed by many "
+          "threads",
+          "[stress]") {
+    constexpr auto tasks_per_thread = 16;
+    constexpr auto rounds = 500;
+
+    auto m = timer_manager_t{};
+    std::atomic<int> fired{};
+    std::atomic<int> armed{};
+    std::atomic<int> cancelled{};
+    std::atomic<bool> producing{true};
+    auto const f = [&] { ++fired; };
+    auto tasks = make_all<decltype(timer_manager_t::create_task(f))>(
+        num_threads * tasks_per_thread,
+        [&] { return timer_manager_t::create_task(f); });
+
+    auto consumer = std::thread{[&] {
+        while (producing or not m.is_idle()) {
+            ++ticks;
+            m.service_expired();
+        }
+    }};
+    on_threads(num_threads, [&](int i) {
+        for (auto r = 0; r < rounds; ++r) {
+            for (auto j = 0; j < tasks_per_thread; ++j) {
+                auto &t = tasks[static_cast<std::size_t>(
+                    i * tasks_per_thread + j)];
+                if (m.run_after(*t, 1 + j % 8)) {
+                    ++armed;
+                }
+                if (j % 3 == 0 and m.cancel(*t)) {
+                    ++cancelled;
+                }
+            }
+        }
+    });
+    producing = false;
+    consumer.join();
+
+    CHECK(m.is_idle());
+    CHECK(fired + cancelled == armed);
+}
+
+TEST_CASE("inplace_stop_source runs each callback once while callbacks come "
+          "and go",
+          "[stress]") {
+    constexpr auto rounds = 100;
+
+    for (auto r = 0; r < rounds; ++r) {
+        async::inplace_stop_source source{};
+        std::atomic<int> registered{};
+        std::atomic<int> double_runs{};
+        std::atomic<int> missed{};
+
+        auto requester = std::thread{[&] {
+            while (registered < r * num_threads) {
+                std::this_thread::yield();
+            }
+            source.request_stop();
+        }};
+        on_threads(num_threads, [&](int) {
+            auto stopped = false;
+            while (not stopped) {
+                stopped = source.stop_requested();
+                ++registered;
+                std::atomic<int> runs{};
+                {
+                    async::inplace_stop_callback cb{source.get_token(), [&] {
+                                                        if (++runs > 1) {
+                                                            ++double_runs;
+                                                        }
+                                                    }};
+                }
+                // once stop was seen, registering runs the callback inline
+                if (stopped and runs == 0) {
+                    ++missed;
+                }
+            }
+        });
+        requester.join();
+
+        CHECK(double_runs == 0);
+        CHECK(missed == 0);
+    }
+}
+
+TEST_CASE("single_inplace_stop_source does not run a callback after it is "
+          "destroyed",
+          "[stress]") {
+    constexpr auto rounds = 2'000;
+
+    for (auto r = 0; r < rounds; ++r) {
+        async::single_inplace_stop_source source{};
+        std::atomic<bool> alive{true};
+        std::atomic<int> late_runs{};
+        auto cb = std::make_unique<async::single_inplace_stop_callback<
+            std::function<void()>>>(source.get_token(), [&] {
+            if (not alive) {
+                ++late_runs;
+            }
+        });
+
+        auto requester = std::thread{[&] { source.request_stop(); }};
+        cb.reset();
+        alive = false;
+        requester.join();
+
+        CHECK(late_runs == 0);
+    }
+}
+
+TEST_CASE("run_loop runs work scheduled from many threads", "[stress]") {
+    constexpr auto ops_per_thread = 1'000;
+    constexpr auto total = num_threads * ops_per_thread;
+
+    async::run_loop rl{};
+    std::atomic<int> runs{};
+    auto const rcvr = receiver{[&] {
+        if (++runs == total) {
+            rl.finish();
+        }
+    }};
+    using op_t = decltype(async::connect(rl.get_scheduler().schedule(), rcvr));
+    auto ops = make_all<op_t>(total, [&] {
+        return async::connect(rl.get_scheduler().schedule(), rcvr);
+    });
+
+    auto consumer = std::thread{[&] { rl.run(); }};
+    on_threads(num_threads, [&](int i) {
+        for (auto j = 0; j < ops_per_thread; ++j) {
+            async::start(*ops[static_cast<std::size_t>(
+                i * ops_per_thread + j)]);
+        }
+    });
+    consumer.join();
+
+    CHECK(runs == total);
+}
+
+TEST_CASE("run_loop can be destroyed as soon as run returns after a finish "
+          "from another thread",
+          "[stress]") {
+    constexpr auto rounds = 2'000;
+
+    for (auto r = 0; r < rounds; ++r) {
+        auto rl = std::make_unique<async::run_loop<>>();
+        auto finisher = std::thread{[loop = rl.get()] { loop->finish(); }};
+        rl->run();
+        rl.reset();
+        finisher.join();
+    }
+}
+
+TEST_CASE("priority_run_loop can be destroyed as soon as run returns after a "
+          "finish from another thread",
+          "[stress]") {
+    constexpr auto rounds = 2'000;
+
+    for (auto r = 0; r < rounds; ++r) {
+        auto rl = std::make_unique<async::priority_run_loop<4>>();
+        auto finisher = std::thread{[loop = rl.get()] { loop->finish(); }};
+        rl->run();
+        rl.reset();
+        finisher.join();
+    }
+}
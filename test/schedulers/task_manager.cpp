@@ -22,8 +22,13 @@ std::function<void()> interrupt_fn{};
 struct test_concurrency_policy {
     static inline std::mutex m{};
 
+    static inline int critical_sections{};
+
     struct interrupt {
-        interrupt() { m.lock(); }
+        interrupt() {
+            m.lock();
+            ++critical_sections;
+        }
         ~interrupt() {
             m.unlock();
             if (interrupt_fn) {
@@ -196,6 +201,59 @@ TEST_CASE("queue a task on interrupt during servicing (immediate execution)",
     CHECK(m.is_idle());
 }
 
+TEST_CASE("deferred servicing takes one critical section per batch",
+          "[task_manager]") {
+    auto m = task_manager_t{};
+    int var{};
+    auto task1 = task_manager_t::create_task([&] { ++var; });
+    auto task2 = task_manager_t::create_task([&] { ++var; });
+    auto task3 = task_manager_t::create_task([&] { ++var; });
+    m.enqueue_task(task1, 0);
+    m.enqueue_task(task2, 0);
+    m.enqueue_task(task3, 0);
+
+    test_concurrency_policy::critical_sections = 0;
+    m.service_tasks<0, async::requeue_policy::deferred>();
+    CHECK(var == 3);
+    CHECK(test_concurrency_policy::critical_sections == 1);
+    CHECK(m.is_idle());
+}
+
+TEST_CASE("requeueing a task in a detached batch before it runs is a no-op",
+          "[task_manager]") {
+    auto m = task_manager_t{};
+    int var{};
+    auto task = task_manager_t::create_task([&] { ++var; });
+    m.enqueue_task(task, 1);
+
+    interrupt_fn = [&] {
+        interrupt_fn = {};
+        CHECK(not m.enqueue_task(task, 1));
+    };
+
+    m.service_tasks<1, async::requeue_policy::deferred>();
+    CHECK(var == 1);
+    CHECK(m.is_idle());
+}
+
+TEST_CASE("requeueing a task in a detached batch after it runs defers it",
+          "[task_manager]") {
+    auto m = task_manager_t{};
+    int var{};
+    auto task1 = task_manager_t::create_task([&] { ++var; });
+    auto task2 = task_manager_t::create_task(
+        [&](task_manager_t *mgr) { CHECK(mgr->enqueue_task(task1, 0)); });
+    m.enqueue_task(task1, 0);
+    m.enqueue_task(task2.bind_front(&m), 0);
+
+    m.service_tasks<0, async::requeue_policy::deferred>();
+    CHECK(var == 1);
+    CHECK(not m.is_idle());
+    m.service_tasks<0, async::requeue_policy::deferred>();
+    CHECK(var == 2);
+    CHECK(m.is_idle());
+}
+
 TEMPLATE_TEST_CASE("thread safety for execution", "[task_manager]",
                    async::requeue_policy::deferred,
                    async::requeue_policy::immediate) {
@@ -209,3 +267,309 @@ TEMPLATE_TEST_CASE("thread safety for execution", "[task_manager]",
     t1.join();
     t2.join();
 }
+
+TEST_CASE("service highest priority with nothing queued", "[task_manager]") {
+    auto m = task_manager_t{};
+    CHECK(not m.service_highest());
+}
+
+TEST_CASE("service highest priority runs the highest queued priority",
+          "[task_manager]") {
+    auto m = task_manager_t{};
+    int var{1};
+    auto task1 = task_manager_t::create_task([&] { var *= 2; });
+    auto task2 = task_manager_t::create_task([&] { var += 2; });
+    CHECK(m.enqueue_task(task1, 5));
+    CHECK(m.enqueue_task(task2, 2));
+
+    CHECK(m.service_highest());
+    CHECK(var == 3);
+    CHECK(not m.is_idle());
+
+    CHECK(m.service_highest());
+    CHECK(var == 6);
+    CHECK(m.is_idle());
+    CHECK(not m.service_highest());
+}
+
+TEST_CASE("service highest priority after targeted servicing",
+          "[task_manager]") {
+    auto m = task_manager_t{};
+    int var{};
+    auto task1 = task_manager_t::create_task([&] { ++var; });
+    auto task2 = task_manager_t::create_task([&] { var += 10; });
+    CHECK(m.enqueue_task(task1, 1));
+    CHECK(m.enqueue_task(task2, 3));
+    m.service_tasks<1>();
+    CHECK(var == 1);
+
+    CHECK(m.service_highest());
+    CHECK(var == 11);
+    CHECK(not m.service_highest());
+}
+
+TEST_CASE("service highest priority (immediate execution)", "[task_manager]") {
+    auto m = task_manager_t{};
+    int var{};
+
+    auto task = task_manager_t::create_task(
+        [&](task_manager_t *mgr, async::priority_task *t) {
+            if (var++ == 0) {
+                CHECK(mgr->enqueue_task(*t, 4));
+            }
+        });
+    CHECK(m.enqueue_task(task.bind_front(&m, &task), 4));
+    CHECK(m.service_highest<async::requeue_policy::immediate>());
+    CHECK(var == 2);
+    CHECK(m.is_idle());
+    CHECK(not m.service_highest());
+}
+
+TEST_CASE("bounded servicing runs at most max_tasks", "[task_manager]") {
+    hal::calls.clear();
+    auto m = task_manager_t{};
+    int var{};
+    auto task1 = task_manager_t::create_task([&] { ++var; });
+    auto task2 = task_manager_t::create_task([&] { ++var; });
+    auto task3 = task_manager_t::create_task([&] { ++var; });
+    m.enqueue_task(task1, 2);
+    m.enqueue_task(task2, 2);
+    m.enqueue_task(task3, 2);
+    hal::calls.clear();
+
+    CHECK(m.service_tasks<2>(2) == 1);
+    CHECK(var == 2);
+    REQUIRE(hal::calls.size() == 1);
+    CHECK(hal::calls[0] == 2);
+
+    hal::calls.clear();
+    CHECK(m.service_tasks<2>(2) == 0);
+    CHECK(var == 3);
+    CHECK(hal::calls.empty());
+    CHECK(m.is_idle());
+}
+
+TEST_CASE("bounded servicing counts requeued tasks against the budget",
+          "[task_manager]") {
+    auto m = task_manager_t{};
+    int var{};
+
+    auto task = task_manager_t::create_task(
+        [&](task_manager_t *mgr, async::priority_task *t) {
+            ++var;
+            CHECK(mgr->enqueue_task(*t, 0));
+        });
+    CHECK(m.enqueue_task(task.bind_front(&m, &task), 0));
+    CHECK(m.service_tasks<0>(3) == 1);
+    CHECK(var == 3);
+    CHECK(not m.is_idle());
+}
+
+namespace {
+struct test_clock {
+    using time_point_t = int;
+    static inline time_point_t current{};
+    static auto now() -> time_point_t { return current; }
+};
+} // namespace
+
+TEST_CASE("servicing with a deadline stops when the deadline passes",
+          "[task_manager]") {
+    hal::calls.clear();
+    auto m = task_manager_t{};
+    test_clock::current = 0;
+    auto task1 = task_manager_t::create_task([&] { test_clock::current += 5; });
+    auto task2 = task_manager_t::create_task([&] { test_clock::current += 5; });
+    auto task3 = task_manager_t::create_task([&] { test_clock::current += 5; });
+    m.enqueue_task(task1, 1);
+    m.enqueue_task(task2, 1);
+    m.enqueue_task(task3, 1);
+    hal::calls.clear();
+
+    CHECK(m.service_tasks<1, test_clock>(8) == 1);
+    CHECK(test_clock::current == 10);
+    REQUIRE(hal::calls.size() == 1);
+    CHECK(hal::calls[0] == 1);
+
+    CHECK(m.service_tasks<1, test_clock>(100) == 0);
+    CHECK(m.is_idle());
+}
+
+TEST_CASE("bounded servicing keeps service_highest consistent",
+          "[task_manager]") {
+    auto m = task_manager_t{};
+    int var{};
+    auto task1 = task_manager_t::create_task([&] { ++var; });
+    auto task2 = task_manager_t::create_task([&] { ++var; });
+    m.enqueue_task(task1, 3);
+    m.enqueue_task(task2, 3);
+
+    CHECK(m.service_tasks<3>(1) == 1);
+    CHECK(m.service_highest());
+    CHECK(var == 2);
+    CHECK(not m.service_highest());
+}
+
+namespace {
+using aging_task_manager_t =
+    async::priority_task_manager<hal, 8, async::priority_task,
+                                 async::instrumentation::none,
+                                 async::aging::after_rounds<3>>;
+} // namespace
+
+TEST_CASE("without aging, a busy priority starves lower priorities",
+          "[task_manager]") {
+    auto m = task_manager_t{};
+    int high{};
+    int low{};
+    auto busy = task_manager_t::create_task(
+        [&](task_manager_t *mgr, async::priority_task *t) {
+            ++high;
+            mgr->enqueue_task(*t, 0);
+        });
+    auto starved = task_manager_t::create_task([&] { ++low; });
+    m.enqueue_task(busy.bind_front(&m, &busy), 0);
+    m.enqueue_task(starved, 5);
+
+    for (auto i = 0; i < 10; ++i) {
+        CHECK(m.service_highest());
+    }
+    CHECK(high == 10);
+    CHECK(low == 0);
+}
+
+TEST_CASE("aging promotes a starved priority after a number of rounds",
+          "[task_manager]") {
+    auto m = aging_task_manager_t{};
+    int high{};
+    int low{};
+    auto busy = aging_task_manager_t::create_task(
+        [&](aging_task_manager_t *mgr, async::priority_task *t) {
+            ++high;
+            mgr->enqueue_task(*t, 0);
+        });
+    auto starved = aging_task_manager_t::create_task([&] { ++low; });
+    m.enqueue_task(busy.bind_front(&m, &busy), 0);
+    m.enqueue_task(starved, 5);
+
+    CHECK(m.service_highest());
+    CHECK(m.service_highest());
+    CHECK(high == 2);
+    CHECK(low == 0);
+    CHECK(m.service_highest());
+    CHECK(high == 2);
+    CHECK(low == 1);
+    CHECK(m.service_highest());
+    CHECK(high == 3);
+}
+
+TEST_CASE("aging picks the highest of several starved priorities first",
+          "[task_manager]") {
+    auto m = aging_task_manager_t{};
+    int var{};
+    auto busy = aging_task_manager_t::create_task(
+        [&](aging_task_manager_t *mgr, async::priority_task *t) {
+            mgr->enqueue_task(*t, 0);
+        });
+    auto task1 = aging_task_manager_t::create_task([&] { var = var * 10 + 1; });
+    auto task2 = aging_task_manager_t::create_task([&] { var = var * 10 + 2; });
+    m.enqueue_task(busy.bind_front(&m, &busy), 0);
+    m.enqueue_task(task2, 6);
+    m.enqueue_task(task1, 4);
+
+    for (auto i = 0; i < 4; ++i) {
+        CHECK(m.service_highest());
+    }
+    CHECK(var == 12);
+}
+
+TEST_CASE("service a priority chosen at runtime", "[task_manager]") {
+    auto m = task_manager_t{};
+    int var{};
+    auto task1 = task_manager_t::create_task([&] { var += 1; });
+    auto task2 = task_manager_t::create_task([&] { var += 10; });
+    CHECK(m.enqueue_task(task1, 2));
+    CHECK(m.enqueue_task(task2, 7));
+
+    auto p = async::priority_t{7};
+    m.service_tasks(p);
+    CHECK(var == 10);
+    CHECK(not m.is_idle());
+    p = 2;
+    m.service_tasks(p);
+    CHECK(var == 11);
+    CHECK(m.is_idle());
+}
+
+TEST_CASE("service a priority chosen at runtime (immediate execution)",
+          "[task_manager]") {
+    auto m = task_manager_t{};
+    int var{};
+
+    auto task = task_manager_t::create_task(
+        [&](task_manager_t *mgr, async::priority_task *t) {
+            if (var++ == 0) {
+                CHECK(mgr->enqueue_task(*t, 3));
+            }
+        });
+    CHECK(m.enqueue_task(task.bind_front(&m, &task), 3));
+    m.service_tasks<async::requeue_policy::immediate>(3);
+    CHECK(var == 2);
+    CHECK(m.is_idle());
+}
+
+namespace {
+using polled_task_manager_t =
+    async::priority_task_manager<async::polling_hal, 8>;
+} // namespace
+
+TEST_CASE("poll runs ready tasks in priority order", "[task_manager]") {
+    auto m = polled_task_manager_t{};
+    std::vector<int> order{};
+    auto task1 = polled_task_manager_t::create_task([&] { order.push_back(1); });
+    auto task2 = polled_task_manager_t::create_task([&] { order.push_back(2); });
+    auto task3 = polled_task_manager_t::create_task([&] { order.push_back(3); });
+    CHECK(m.enqueue_task(task3, 3));
+    CHECK(m.enqueue_task(task1, 1));
+    CHECK(m.enqueue_task(task2, 2));
+
+    CHECK(m.poll() == 3);
+    CHECK(order == std::vector{1, 2, 3});
+    CHECK(m.is_idle());
+}
+
+TEST_CASE("poll runs at most the given number of tasks", "[task_manager]") {
+    auto m = polled_task_manager_t{};
+    int var{};
+    auto task1 = polled_task_manager_t::create_task([&] { ++var; });
+    auto task2 = polled_task_manager_t::create_task([&] { ++var; });
+    auto task3 = polled_task_manager_t::create_task([&] { ++var; });
+    CHECK(m.enqueue_task(task1, 0));
+    CHECK(m.enqueue_task(task2, 0));
+    CHECK(m.enqueue_task(task3, 5));
+
+    CHECK(m.poll(2) == 2);
+    CHECK(var == 2);
+    CHECK(not m.is_idle());
+    CHECK(m.poll(2) == 1);
+    CHECK(m.poll(2) == 0);
+    CHECK(m.is_idle());
+}
+
+TEST_CASE("poll runs a higher priority task queued while polling next",
+          "[task_manager]") {
+    auto m = polled_task_manager_t{};
+    std::vector<int> order{};
+    auto urgent =
+        polled_task_manager_t::create_task([&] { order.push_back(0); });
+    auto first = polled_task_manager_t::create_task([&] {
+        order.push_back(1);
+        CHECK(m.enqueue_task(urgent, 0));
+    });
+    auto last = polled_task_manager_t::create_task([&] { order.push_back(2); });
+    CHECK(m.enqueue_task(first, 1));
+    CHECK(m.enqueue_task(last, 2));
+
+    CHECK(m.poll() == 3);
+    CHECK(order == std::vector{1, 0, 2});
+}
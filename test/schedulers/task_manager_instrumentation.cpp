@@ -0,0 +1,87 @@
+#include <async/schedulers/task_manager.hpp>
+#include <async/schedulers/task_manager_instrumentation.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <type_traits>
+
+namespace {
+struct hal {
+    static auto schedule(async::priority_t) {}
+};
+
+struct test_clock {
+    using time_point_t = std::uint64_t;
+    static inline time_point_t current{};
+    static auto now() -> time_point_t { return current; }
+};
+
+using task_t = async::timestamped_priority_task<test_clock::time_point_t>;
+using instrumentation_t = async::instrumentation::histograms<test_clock, 8>;
+using task_manager_t =
+    async::priority_task_manager<hal, 8, task_t, instrumentation_t>;
+} // namespace
+
+TEST_CASE("uninstrumented manager stores nothing extra",
+          "[task_manager_instrumentation]") {
+    using plain_t = async::priority_task_manager<hal, 8>;
+    using none_t = async::priority_task_manager<hal, 8, async::priority_task,
+                                                async::instrumentation::none>;
+    static_assert(std::is_same_v<plain_t, none_t>);
+    static_assert(std::is_empty_v<async::instrumentation::none>);
+}
+
+TEST_CASE("instrumented manager fulfils concept",
+          "[task_manager_instrumentation]") {
+    static_assert(async::task_manager<task_manager_t>);
+}
+
+TEST_CASE("histogram buckets are powers of two",
+          "[task_manager_instrumentation]") {
+    auto h = async::instrumentation::histogram<4>{};
+    h.record(0);
+    h.record(1);
+    h.record(2);
+    h.record(3);
+    h.record(1000);
+    CHECK(h.buckets[0] == 1);
+    CHECK(h.buckets[1] == 1);
+    CHECK(h.buckets[2] == 2);
+    CHECK(h.buckets[3] == 1);
+    CHECK(h.count() == 5);
+}
+
+TEST_CASE("high water mark tracks queue depth per priority",
+          "[task_manager_instrumentation]") {
+    auto m = task_manager_t{};
+    auto task1 = task_manager_t::create_task([] {});
+    auto task2 = task_manager_t::create_task([] {});
+    auto task3 = task_manager_t::create_task([] {});
+    m.enqueue_task(task1, 1);
+    m.enqueue_task(task2, 1);
+    m.enqueue_task(task3, 2);
+    m.service_tasks<1>();
+    m.enqueue_task(task1, 1);
+
+    auto const &stats = m.get_instrumentation().stats;
+    CHECK(stats[1].high_water_mark == 2);
+    CHECK(stats[2].high_water_mark == 1);
+    CHECK(stats[0].high_water_mark == 0);
+}
+
+TEST_CASE("latency and run time are recorded",
+          "[task_manager_instrumentation]") {
+    auto m = task_manager_t{};
+    test_clock::current = 0;
+    auto task = task_manager_t::create_task([] { test_clock::current += 6; });
+    m.enqueue_task(task, 3);
+    test_clock::current = 2;
+    m.service_tasks<3>();
+
+    auto const &s = m.get_instrumentation().stats[3];
+    CHECK(s.latency.count() == 1);
+    CHECK(s.latency.buckets[2] == 1);
+    CHECK(s.run_time.count() == 1);
+    CHECK(s.run_time.buckets[3] == 1);
+}
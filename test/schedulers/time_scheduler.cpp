@@ -1,9 +1,18 @@
 #include "detail/common.hpp"
 
+#include <async/continue_on.hpp>
+#include <async/just.hpp>
 #include <async/just_result_of.hpp>
+#include <async/retry_with_backoff.hpp>
 #include <async/schedulers/time_scheduler.hpp>
 #include <async/schedulers/timer_manager.hpp>
+#include <async/sequence.hpp>
 #include <async/start_on.hpp>
+#include <async/sync_wait_for.hpp>
+#include <async/then.hpp>
+#include <async/variant_sender.hpp>
+#include <async/when_all.hpp>
+#include <async/when_any.hpp>
 
 #include <stdx/concepts.hpp>
 
@@ -12,6 +21,7 @@
 #include <chrono>
 #include <concepts>
 #include <functional>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -51,8 +61,11 @@ struct test_concurrency_policy {
         }
     };
 
+    static inline int critical_sections{};
+
     template <typename = void, typename F, typename... Pred>
     static auto call_in_critical_section(F &&f, Pred &&...) -> decltype(auto) {
+        ++critical_sections;
         [[maybe_unused]] interrupt raii_interrupt{};
         return std::forward<F>(f)();
     }
@@ -184,3 +197,389 @@ TEST_CASE("time_scheduler can have different domain", "[time_scheduler]") {
     CHECK(async::timer_mgr::is_idle<alt_domain>());
     CHECK(not enabled<alt_domain>);
 }
+
+namespace {
+template <typename F> struct slack_receiver : receiver<F> {
+    std::chrono::milliseconds slack{};
+
+    struct env {
+        std::chrono::milliseconds slack;
+
+      private:
+        [[nodiscard]] friend constexpr auto
+        tag_invoke(async::get_timer_slack_t, env const &self) {
+            return self.slack;
+        }
+    };
+
+  private:
+    [[nodiscard]] friend constexpr auto tag_invoke(async::get_env_t,
+                                                   slack_receiver const &self)
+        -> env {
+        return {self.slack};
+    }
+};
+template <typename F>
+slack_receiver(F, std::chrono::milliseconds) -> slack_receiver<F>;
+} // namespace
+
+TEST_CASE("time_scheduler passes slack from the receiver environment",
+          "[time_scheduler]") {
+    using time_point_t = hal<default_domain>::time_point_t;
+    calls<default_domain, time_point_t>.clear();
+
+    int var{};
+    auto op1 = async::connect(
+        async::start_on(async::time_scheduler{10ms},
+                        async::just_result_of([&] { var += 1; })),
+        universal_receiver{});
+    auto op2 = async::connect(
+        async::start_on(async::time_scheduler{8ms},
+                        async::just_result_of([&] { var += 2; })),
+        slack_receiver{receiver{[] {}}, 5ms});
+
+    async::start(op1);
+    async::start(op2);
+    CHECK(calls<default_domain, time_point_t>.size() == 1);
+
+    current_time<default_domain, time_point_t> = time_point_t{10ms};
+    async::timer_mgr::service_task();
+    CHECK(var == 3);
+    CHECK(async::timer_mgr::is_idle());
+    current_time<default_domain, time_point_t> = {};
+}
+
+TEST_CASE("service_expired completes every due time_scheduler sender",
+          "[time_scheduler]") {
+    using time_point_t = hal<default_domain>::time_point_t;
+
+    int var{};
+    auto op1 = async::connect(
+        async::start_on(async::time_scheduler{10ms},
+                        async::just_result_of([&] { var += 1; })),
+        universal_receiver{});
+    auto op2 = async::connect(
+        async::start_on(async::time_scheduler{20ms},
+                        async::just_result_of([&] { var += 2; })),
+        universal_receiver{});
+
+    async::start(op1);
+    async::start(op2);
+    CHECK(async::timer_mgr::service_expired(time_point_t{20ms}) == 2);
+    CHECK(var == 3);
+    CHECK(async::timer_mgr::is_idle());
+}
+
+TEST_CASE("periodic calls its function every period", "[time_scheduler]") {
+    using time_point_t = hal<default_domain>::time_point_t;
+    calls<default_domain, time_point_t>.clear();
+
+    int var{};
+    auto op = async::connect(
+        async::periodic(async::time_scheduler{10ms}, [&] { ++var; }),
+        universal_receiver{});
+    async::start(op);
+    REQUIRE(calls<default_domain, time_point_t>.size() == 1);
+    CHECK(calls<default_domain, time_point_t>.back() == time_point_t{10ms});
+
+    // servicing late does not move the next expiry
+    current_time<default_domain, time_point_t> = time_point_t{13ms};
+    async::timer_mgr::service_task();
+    CHECK(var == 1);
+    CHECK(calls<default_domain, time_point_t>.back() == time_point_t{20ms});
+
+    current_time<default_domain, time_point_t> = time_point_t{21ms};
+    async::timer_mgr::service_task();
+    CHECK(var == 2);
+    CHECK(calls<default_domain, time_point_t>.back() == time_point_t{30ms});
+    CHECK(not async::timer_mgr::is_idle());
+
+    CHECK(async::timer_mgr::detail::cancel(op));
+    CHECK(async::timer_mgr::is_idle());
+    current_time<default_domain, time_point_t> = {};
+}
+
+TEST_CASE("periodic completes when its function returns true",
+          "[time_scheduler]") {
+    int var{};
+    bool done{};
+    auto s = async::periodic(async::time_scheduler{10ms},
+                             [&] { return ++var == 2; });
+    static_assert(async::sender_of<decltype(s), async::set_value_t()>);
+    auto op = async::connect(s, receiver{[&] { done = true; }});
+    async::start(op);
+
+    async::timer_mgr::service_task();
+    CHECK(var == 1);
+    CHECK(not done);
+    async::timer_mgr::service_task();
+    CHECK(var == 2);
+    CHECK(done);
+    CHECK(async::timer_mgr::is_idle());
+}
+
+TEST_CASE("periodic is cancellable", "[time_scheduler]") {
+    int var{};
+    auto r = stoppable_receiver{[&] { var = 17; }};
+    auto op = async::connect(
+        async::periodic(async::time_scheduler{10ms}, [&] { var = 42; }), r);
+
+    async::start(op);
+    async::timer_mgr::service_task();
+    CHECK(var == 42);
+    CHECK(not async::timer_mgr::is_idle());
+    r.request_stop();
+    CHECK(var == 17);
+    CHECK(async::timer_mgr::is_idle());
+    CHECK(not enabled<default_domain>);
+}
+
+TEST_CASE("schedule_at completes at an absolute time", "[time_scheduler]") {
+    using time_point_t = hal<default_domain>::time_point_t;
+    calls<default_domain, time_point_t>.clear();
+
+    auto const deadline = time_point_t{25ms};
+    int var{};
+    auto op1 = async::connect(
+        async::schedule_at(deadline) | async::then([&] { var += 1; }),
+        universal_receiver{});
+    auto op2 = async::connect(
+        async::schedule_at(deadline) | async::then([&] { var += 2; }),
+        universal_receiver{});
+
+    current_time<default_domain, time_point_t> = time_point_t{3ms};
+    async::start(op1);
+    current_time<default_domain, time_point_t> = time_point_t{7ms};
+    async::start(op2);
+    REQUIRE(not calls<default_domain, time_point_t>.empty());
+    CHECK(calls<default_domain, time_point_t>.back() == deadline);
+
+    current_time<default_domain, time_point_t> = deadline;
+    CHECK(async::timer_mgr::service_expired() == 2);
+    CHECK(var == 3);
+    current_time<default_domain, time_point_t> = {};
+}
+
+TEST_CASE("schedule_at is cancellable after start", "[time_scheduler]") {
+    using time_point_t = hal<default_domain>::time_point_t;
+    int var{};
+    auto r = stoppable_receiver{[&] { var = 17; }};
+    auto op = async::connect(async::schedule_at(time_point_t{1s}), r);
+
+    async::start(op);
+    CHECK(not async::timer_mgr::is_idle());
+    r.request_stop();
+    CHECK(var == 17);
+    CHECK(async::timer_mgr::is_idle());
+}
+
+TEST_CASE("on_expiry cancellation registers no stop callback on start",
+          "[time_scheduler]") {
+    constexpr auto immediate = async::time_scheduler_factory<>;
+    constexpr auto on_expiry = async::time_scheduler_factory<
+        async::timer_mgr::default_domain,
+        async::timer_mgr::cancellation::on_expiry>;
+
+    auto r1 = stoppable_receiver{[] {}};
+    auto op1 = async::connect(immediate(10ms).schedule(), r1);
+    test_concurrency_policy::critical_sections = 0;
+    async::start(op1);
+    auto const immediate_sections = test_concurrency_policy::critical_sections;
+    async::timer_mgr::service_task();
+
+    int var{};
+    auto r2 = stoppable_receiver{[&] { var = 42; }};
+    auto op2 = async::connect(on_expiry(10ms).schedule(), r2);
+    test_concurrency_policy::critical_sections = 0;
+    async::start(op2);
+    CHECK(test_concurrency_policy::critical_sections < immediate_sections);
+    CHECK(test_concurrency_policy::critical_sections == 1);
+
+    async::timer_mgr::service_task();
+    CHECK(var == 42);
+    CHECK(async::timer_mgr::is_idle());
+}
+
+TEST_CASE("on_expiry cancellation completes stopped when the timer expires",
+          "[time_scheduler]") {
+    constexpr auto factory = async::time_scheduler_factory<
+        async::timer_mgr::default_domain,
+        async::timer_mgr::cancellation::on_expiry>;
+    int var{};
+    async::sender auto sndr =
+        async::start_on(factory(1s), async::just_result_of([&] { var = 42; }));
+    auto r = stoppable_receiver{[&] { var = 17; }};
+    auto op = async::connect(sndr, r);
+
+    async::start(op);
+    r.request_stop();
+    CHECK(var == 0);
+    CHECK(not async::timer_mgr::is_idle());
+
+    async::timer_mgr::service_task();
+    CHECK(var == 17);
+    CHECK(async::timer_mgr::is_idle());
+}
+
+TEST_CASE("periodic follows on_expiry cancellation", "[time_scheduler]") {
+    constexpr auto factory = async::time_scheduler_factory<
+        async::timer_mgr::default_domain,
+        async::timer_mgr::cancellation::on_expiry>;
+    int var{};
+    auto r = stoppable_receiver{[&] { var = 17; }};
+    auto op =
+        async::connect(async::periodic(factory(10ms), [&] { ++var; }), r);
+
+    async::start(op);
+    async::timer_mgr::service_task();
+    CHECK(var == 1);
+    r.request_stop();
+    CHECK(var == 1);
+    CHECK(not async::timer_mgr::is_idle());
+
+    async::timer_mgr::service_task();
+    CHECK(var == 17);
+    CHECK(async::timer_mgr::is_idle());
+}
+
+TEST_CASE("continue_on an equal time_scheduler delays again",
+          "[time_scheduler]") {
+    auto s = async::time_scheduler{10ms};
+    int var{};
+    auto op = async::connect(s.schedule() | async::continue_on(s) |
+                                 async::then([&] { var = 42; }),
+                             universal_receiver{});
+
+    async::start(op);
+    async::timer_mgr::service_task();
+    CHECK(var == 0);
+    CHECK(not async::timer_mgr::is_idle());
+    async::timer_mgr::service_task();
+    CHECK(var == 42);
+    CHECK(async::timer_mgr::is_idle());
+}
+
+TEST_CASE("stopping a time_scheduler in another domain cancels there",
+          "[time_scheduler]") {
+    auto s = async::time_scheduler_factory<alt_domain>(1s);
+    int var{};
+    auto r = stoppable_receiver{[&] { var = 17; }};
+    auto op = async::connect(s.schedule(), r);
+
+    async::start(op);
+    CHECK(not async::timer_mgr::is_idle<alt_domain>());
+    r.request_stop();
+    CHECK(var == 17);
+    CHECK(async::timer_mgr::is_idle<alt_domain>());
+}
+
+TEST_CASE("retry_with_backoff delays between attempts", "[time_scheduler]") {
+    using time_point_t = hal<default_domain>::time_point_t;
+    calls<default_domain, time_point_t>.clear();
+
+    int attempts{};
+    int value{};
+    auto sub = async::just() | async::sequence([&] {
+                   return async::make_variant_sender(
+                       ++attempts < 3, [] { return async::just_error(17); },
+                       [] { return async::just(42); });
+               });
+    auto s = sub | async::retry_with_backoff(async::time_scheduler{10ms},
+                                             async::backoff_policy{10ms, 15ms});
+    auto op = async::connect(s, receiver{[&](int i) { value = i; }});
+    async::start(op);
+    CHECK(attempts == 1);
+    REQUIRE(calls<default_domain, time_point_t>.size() == 1);
+    CHECK(calls<default_domain, time_point_t>.back() == time_point_t{10ms});
+
+    // the second delay is doubled, but capped at the maximum
+    current_time<default_domain, time_point_t> = time_point_t{10ms};
+    async::timer_mgr::service_task();
+    CHECK(attempts == 2);
+    CHECK(calls<default_domain, time_point_t>.back() == time_point_t{25ms});
+
+    current_time<default_domain, time_point_t> = time_point_t{25ms};
+    async::timer_mgr::service_task();
+    CHECK(attempts == 3);
+    CHECK(value == 42);
+    CHECK(async::timer_mgr::is_idle());
+    current_time<default_domain, time_point_t> = {};
+}
+
+TEST_CASE("retry_with_backoff applies jitter", "[time_scheduler]") {
+    using time_point_t = hal<default_domain>::time_point_t;
+    calls<default_domain, time_point_t>.clear();
+
+    auto s = async::just_error(17) |
+             async::retry_with_backoff(
+                 async::time_scheduler{10ms},
+                 async::backoff_policy{10ms, 100ms, 2, 2,
+                                       [](auto d) { return d + 1ms; }});
+    auto op = async::connect(s, error_receiver{[](int) {}});
+    async::start(op);
+    REQUIRE(calls<default_domain, time_point_t>.size() == 1);
+    CHECK(calls<default_domain, time_point_t>.back() == time_point_t{11ms});
+    async::timer_mgr::service_task();
+    CHECK(async::timer_mgr::is_idle());
+}
+
+TEST_CASE("retry_with_backoff sends the error after max attempts",
+          "[time_scheduler]") {
+    int attempts{};
+    int value{};
+    auto sub = async::just() | async::sequence([&] {
+                   ++attempts;
+                   return async::just_error(17);
+               });
+    auto s = sub | async::retry_with_backoff(
+                       async::time_scheduler{10ms},
+                       async::backoff_policy{10ms, 10ms, 3});
+    auto op = async::connect(s, error_receiver{[&](int i) { value = i; }});
+    async::start(op);
+    async::timer_mgr::service_task();
+    async::timer_mgr::service_task();
+    CHECK(attempts == 3);
+    CHECK(value == 17);
+    CHECK(async::timer_mgr::is_idle());
+}
+
+TEST_CASE("retry_with_backoff is cancellable while waiting",
+          "[time_scheduler]") {
+    int var{};
+    auto r = stoppable_receiver{[&] { var = 42; }};
+    auto s = async::just_error(17) |
+             async::retry_with_backoff(async::time_scheduler{10ms},
+                                       async::backoff_policy{10ms, 10ms});
+    auto op = async::connect(s, r);
+    async::start(op);
+    CHECK(not async::timer_mgr::is_idle());
+    r.request_stop();
+    CHECK(var == 42);
+    CHECK(async::timer_mgr::is_idle());
+}
+
+TEST_CASE("sync_wait_for returns the sender's values if it wins",
+          "[time_scheduler]") {
+    auto [values, timed_out] = async::sync_wait_for(async::just(42), 1s);
+    REQUIRE(values.has_value());
+    CHECK(get<0>(*values) == 42);
+    CHECK(not timed_out);
+    CHECK(async::timer_mgr::is_idle());
+}
+
+TEST_CASE("sync_wait_for stops the sender on timeout", "[time_scheduler]") {
+    // completes only when stopped
+    auto s = async::when_all(async::just(42), async::when_any());
+
+    auto timer = std::thread{[] {
+        std::this_thread::sleep_for(10ms);
+        async::timer_mgr::service_task();
+    }};
+    auto [values, timed_out] =
+        async::sync_wait_for(s, async::time_scheduler{10ms});
+    timer.join();
+
+    CHECK(not values.has_value());
+    CHECK(timed_out);
+    CHECK(async::timer_mgr::is_idle());
+}
@@ -357,3 +357,221 @@ TEST_CASE("queue a task on interrupt during servicing", "[timer_manager]") {
     CHECK(hal::calls.back() == 2);
     CHECK(hal::enabled);
 }
+
+TEST_CASE("a task with slack joins a later task within its slack",
+          "[timer_manager]") {
+    hal::calls.clear();
+
+    auto m = timer_manager_t{};
+    auto t1 = timer_manager_t::create_task([] {});
+    m.run_after(t1, 10);
+    auto t2 = timer_manager_t::create_task([] {});
+    m.run_after(t2, 8, 2);
+    CHECK(t2.expiration_time == 10);
+    REQUIRE(hal::calls.size() == 1);
+    CHECK(hal::calls[0] == 10);
+}
+
+TEST_CASE("a task with slack is not delayed beyond its slack",
+          "[timer_manager]") {
+    hal::calls.clear();
+
+    auto m = timer_manager_t{};
+    auto t1 = timer_manager_t::create_task([] {});
+    m.run_after(t1, 10);
+    auto t2 = timer_manager_t::create_task([] {});
+    m.run_after(t2, 7, 2);
+    CHECK(t2.expiration_time == 7);
+    REQUIRE(not std::empty(hal::calls));
+    CHECK(hal::calls.back() == 7);
+}
+
+TEST_CASE("coalesced tasks run in one service_task call", "[timer_manager]") {
+    hal::calls.clear();
+    hal::enabled = false;
+
+    auto m = timer_manager_t{};
+    std::vector<int> order{};
+    auto t1 = timer_manager_t::create_task([&] { order.push_back(1); });
+    m.run_after(t1, 10);
+    auto t2 = timer_manager_t::create_task([&] { order.push_back(2); });
+    m.run_after(t2, 8, 5);
+    auto t3 = timer_manager_t::create_task([&] { order.push_back(3); });
+    m.run_after(t3, 20);
+
+    hal::current_time = 10;
+    m.service_task();
+    CHECK(order == std::vector{1, 2});
+    CHECK(not m.is_idle());
+    REQUIRE(hal::calls.size() == 2);
+    CHECK(hal::calls.back() == 20);
+
+    hal::current_time = 20;
+    m.service_task();
+    CHECK(order == std::vector{1, 2, 3});
+    CHECK(m.is_idle());
+    CHECK(not hal::enabled);
+    hal::current_time = {};
+}
+
+TEST_CASE("a task requeued for the same time runs on the next call",
+          "[timer_manager]") {
+    hal::calls.clear();
+
+    auto m = timer_manager_t{};
+    int var{};
+    auto task = timer_manager_t::create_task([&](hal::task_t *t) {
+        if (++var == 1) {
+            m.run_after(*t, 0);
+        }
+    });
+    m.run_after(task.bind_front(&task), 0);
+
+    m.service_task();
+    CHECK(var == 1);
+    CHECK(task.pending);
+    REQUIRE(not std::empty(hal::calls));
+    CHECK(hal::calls.back() == 0);
+
+    m.service_task();
+    CHECK(var == 2);
+    CHECK(m.is_idle());
+}
+
+TEST_CASE("service_expired runs every due task", "[timer_manager]") {
+    hal::calls.clear();
+
+    auto m = timer_manager_t{};
+    std::vector<int> order{};
+    auto t1 = timer_manager_t::create_task([&] { order.push_back(1); });
+    m.run_after(t1, 3);
+    auto t2 = timer_manager_t::create_task([&] { order.push_back(2); });
+    m.run_after(t2, 2);
+    auto t3 = timer_manager_t::create_task([&] { order.push_back(3); });
+    m.run_after(t3, 5);
+    hal::calls.clear();
+
+    CHECK(m.service_expired(4) == 2);
+    CHECK(order == std::vector{2, 1});
+    CHECK(not t1.pending);
+    CHECK(not t2.pending);
+    CHECK(t3.pending);
+    REQUIRE(hal::calls.size() == 1);
+    CHECK(hal::calls[0] == 5);
+}
+
+TEST_CASE("service_expired with nothing due runs nothing", "[timer_manager]") {
+    hal::enabled = false;
+
+    auto m = timer_manager_t{};
+    int var{};
+    auto t = timer_manager_t::create_task([&] { var = 42; });
+    m.run_after(t, 3);
+
+    CHECK(m.service_expired(2) == 0);
+    CHECK(var == 0);
+    CHECK(hal::enabled);
+
+    CHECK(m.service_expired(3) == 1);
+    CHECK(var == 42);
+    CHECK(m.is_idle());
+    CHECK(not hal::enabled);
+}
+
+TEST_CASE("a task in an expired batch cannot be cancelled once taken",
+          "[timer_manager]") {
+    auto m = timer_manager_t{};
+    int var{};
+    auto t2 = timer_manager_t::create_task([&] { var = 17; });
+    auto t1 = timer_manager_t::create_task([&] {
+        CHECK(not m.cancel(t2));
+        CHECK(not m.run_after(t2, 5));
+        var = 42;
+    });
+    m.run_after(t1, 1);
+    m.run_after(t2, 2);
+
+    CHECK(m.service_expired(2) == 2);
+    CHECK(var == 17);
+    CHECK(not t2.pending);
+    CHECK(not t2.expired);
+    CHECK(m.is_idle());
+
+    // t2 is back on the queue when it is cancelled
+    m.run_after(t2, 1);
+    CHECK(m.cancel(t2));
+    CHECK(m.is_idle());
+}
+
+TEST_CASE("a task requeued during service_expired waits for the next call",
+          "[timer_manager]") {
+    auto m = timer_manager_t{};
+    int var{};
+    auto task = timer_manager_t::create_task([&](hal::task_t *t) {
+        m.run_after(*t, 0);
+        ++var;
+    });
+    m.run_after(task.bind_front(&task), 0);
+
+    CHECK(m.service_expired(0) == 1);
+    CHECK(var == 1);
+    CHECK(task.pending);
+    CHECK(m.service_expired(0) == 1);
+    CHECK(var == 2);
+}
+
+TEST_CASE("run_after_expiry measures from the previous expiry",
+          "[timer_manager]") {
+    hal::calls.clear();
+
+    auto m = timer_manager_t{};
+    auto t = timer_manager_t::create_task([] {});
+    m.run_after(t, 10);
+    hal::current_time = 12;
+    m.service_task();
+
+    CHECK(m.run_after_expiry(t, 10));
+    CHECK(t.expiration_time == 20);
+    REQUIRE(not std::empty(hal::calls));
+    CHECK(hal::calls.back() == 20);
+    CHECK(not m.run_after_expiry(t, 10));
+    hal::current_time = {};
+}
+
+TEST_CASE("run_at queues a task for an absolute time", "[timer_manager]") {
+    hal::calls.clear();
+
+    auto m = timer_manager_t{};
+    int var{};
+    auto t = timer_manager_t::create_task([&] { var = 42; });
+    hal::current_time = 5;
+    CHECK(m.run_at(t, 8));
+    CHECK(t.expiration_time == 8);
+    REQUIRE(hal::calls.size() == 1);
+    CHECK(hal::calls[0] == 8);
+    CHECK(not m.run_at(t, 9));
+
+    m.service_task();
+    CHECK(var == 42);
+    CHECK(m.is_idle());
+    hal::current_time = {};
+}
+
+TEST_CASE("next_expiration reports the earliest queued expiry",
+          "[timer_manager]") {
+    auto m = timer_manager_t{};
+    CHECK(m.next_expiration() == std::nullopt);
+    CHECK(m.time_until_next() == std::nullopt);
+
+    auto t1 = timer_manager_t::create_task([] {});
+    m.run_after(t1, 10);
+    auto t2 = timer_manager_t::create_task([] {});
+    m.run_after(t2, 7);
+    CHECK(m.next_expiration() == 7);
+
+    hal::current_time = 3;
+    CHECK(m.time_until_next() == 4);
+    hal::current_time = 9;
+    CHECK(m.time_until_next() == 0);
+    hal::current_time = {};
+}
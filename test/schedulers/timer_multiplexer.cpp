@@ -0,0 +1,98 @@
+#include <async/schedulers/timer_manager.hpp>
+#include <async/schedulers/timer_multiplexer.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <concepts>
+#include <vector>
+
+namespace {
+struct hal {
+    using time_point_t = int;
+    using task_t = async::timer_task<time_point_t>;
+
+    static inline time_point_t current_time{};
+    static inline bool enabled{};
+    static inline std::vector<time_point_t> calls{};
+
+    static auto enable() -> void { enabled = true; }
+    static auto disable() -> void { enabled = false; }
+    static auto set_event_time(time_point_t tp) -> void { calls.push_back(tp); }
+    static auto now() -> time_point_t { return current_time; }
+
+    static auto reset() -> void {
+        current_time = {};
+        enabled = false;
+        calls.clear();
+    }
+};
+
+struct alt_domain;
+using default_domain = async::timer_mgr::default_domain;
+using mux_t = async::timer_multiplexer<hal, default_domain, alt_domain>;
+using timer_manager_t =
+    async::generic_timer_manager<mux_t::hal<default_domain>>;
+using alt_timer_manager_t =
+    async::generic_timer_manager<mux_t::hal<alt_domain>>;
+} // namespace
+
+template <> inline auto async::injected_timer_manager<> = timer_manager_t{};
+template <>
+inline auto async::injected_timer_manager<alt_domain> = alt_timer_manager_t{};
+
+TEST_CASE("a single domain uses the hardware HAL directly",
+          "[timer_multiplexer]") {
+    using single_t = async::timer_multiplexer<hal, default_domain>;
+    static_assert(std::same_as<single_t::hal<default_domain>, hal>);
+}
+
+TEST_CASE("channels satisfy the timer HAL concept", "[timer_multiplexer]") {
+    static_assert(async::detail::timer_hal<mux_t::hal<default_domain>>);
+    static_assert(async::detail::timer_hal<mux_t::hal<alt_domain>>);
+}
+
+TEST_CASE("the hardware is programmed with the earliest channel",
+          "[timer_multiplexer]") {
+    hal::reset();
+    auto t1 = timer_manager_t::create_task([] {});
+    auto t2 = alt_timer_manager_t::create_task([] {});
+
+    async::timer_mgr::detail::run_after(t1, 10);
+    CHECK(hal::enabled);
+    CHECK(hal::calls.back() == 10);
+    async::timer_mgr::detail::run_after<alt_domain>(t2, 5);
+    CHECK(hal::calls.back() == 5);
+
+    async::timer_mgr::detail::cancel<alt_domain>(t2);
+    CHECK(hal::calls.back() == 10);
+    async::timer_mgr::detail::cancel(t1);
+    CHECK(not hal::enabled);
+}
+
+TEST_CASE("one interrupt services every due domain", "[timer_multiplexer]") {
+    hal::reset();
+    int var{};
+    auto t1 = timer_manager_t::create_task([&] { var += 1; });
+    auto t2 = alt_timer_manager_t::create_task([&] { var += 2; });
+    auto t3 = alt_timer_manager_t::create_task([&] { var += 4; });
+    async::timer_mgr::detail::run_after(t1, 5);
+    async::timer_mgr::detail::run_after<alt_domain>(t2, 5);
+    async::timer_mgr::detail::run_after<alt_domain>(t3, 8);
+
+    hal::current_time = 4;
+    mux_t::service_task();
+    CHECK(var == 0);
+
+    hal::current_time = 5;
+    mux_t::service_task();
+    CHECK(var == 3);
+    CHECK(hal::enabled);
+    CHECK(hal::calls.back() == 8);
+
+    hal::current_time = 8;
+    mux_t::service_task();
+    CHECK(var == 7);
+    CHECK(not hal::enabled);
+    CHECK(async::timer_mgr::is_idle());
+    CHECK(async::timer_mgr::is_idle<alt_domain>());
+}
@@ -0,0 +1,297 @@
+#include <async/schedulers/timing_wheel_timer_manager.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <vector>
+
+namespace {
+struct hal {
+    using time_point_t = int;
+    using task_t = async::timer_task<time_point_t>;
+
+    static inline time_point_t current_time{};
+    static inline bool enabled{};
+    static inline std::vector<time_point_t> calls{};
+
+    static auto enable() -> void { enabled = true; }
+    static auto disable() -> void { enabled = false; }
+    static auto set_event_time(time_point_t tp) -> void { calls.push_back(tp); }
+    static auto now() -> time_point_t { return current_time; }
+
+    static auto reset() -> void {
+        current_time = {};
+        enabled = false;
+        calls.clear();
+    }
+};
+
+// 2 levels of 4 slots: level 0 covers 4 ticks, level 1 covers 16 ticks
+using timer_manager_t = async::timing_wheel_timer_manager<hal, 2, 4>;
+} // namespace
+
+TEST_CASE("timing wheel fulfils concept", "[timing_wheel_timer_manager]") {
+    static_assert(async::timer_manager<timer_manager_t>);
+}
+
+TEST_CASE("nothing pending", "[timing_wheel_timer_manager]") {
+    auto m = timer_manager_t{};
+    CHECK(m.is_idle());
+}
+
+TEST_CASE("queue a task", "[timing_wheel_timer_manager]") {
+    hal::reset();
+    auto m = timer_manager_t{};
+    auto t = timer_manager_t::create_task([] {});
+    CHECK(m.run_after(t, 3));
+    CHECK(not m.is_idle());
+    CHECK(hal::enabled);
+    REQUIRE(hal::calls.size() == 1);
+    CHECK(hal::calls[0] == 3);
+}
+
+TEST_CASE("a task does not run before it expires",
+          "[timing_wheel_timer_manager]") {
+    hal::reset();
+    auto m = timer_manager_t{};
+    int var{};
+    auto t = timer_manager_t::create_task([&] { var = 42; });
+    m.run_after(t, 3);
+    hal::current_time = 2;
+    m.service_task();
+    CHECK(var == 0);
+    hal::current_time = 3;
+    m.service_task();
+    CHECK(var == 42);
+    CHECK(m.is_idle());
+    CHECK(not hal::enabled);
+}
+
+TEST_CASE("queueing a queued task fails", "[timing_wheel_timer_manager]") {
+    hal::reset();
+    auto m = timer_manager_t{};
+    auto t = timer_manager_t::create_task([] {});
+    CHECK(m.run_after(t, 3));
+    CHECK(not m.run_after(t, 4));
+}
+
+TEST_CASE("run tasks in time order", "[timing_wheel_timer_manager]") {
+    hal::reset();
+    auto m = timer_manager_t{};
+    std::vector<int> order{};
+    auto t1 = timer_manager_t::create_task([&] { order.push_back(1); });
+    auto t2 = timer_manager_t::create_task([&] { order.push_back(2); });
+    auto t3 = timer_manager_t::create_task([&] { order.push_back(3); });
+    m.run_after(t1, 9);
+    m.run_after(t2, 2);
+    m.run_after(t3, 6);
+
+    for (hal::current_time = 0; hal::current_time < 10; ++hal::current_time) {
+        m.service_task();
+    }
+    CHECK(order == std::vector{2, 3, 1});
+    CHECK(m.is_idle());
+}
+
+TEST_CASE("run tasks with same expiry time in FIFO order",
+          "[timing_wheel_timer_manager]") {
+    hal::reset();
+    auto m = timer_manager_t{};
+    std::vector<int> order{};
+    auto t1 = timer_manager_t::create_task([&] { order.push_back(1); });
+    auto t2 = timer_manager_t::create_task([&] { order.push_back(2); });
+    m.run_after(t1, 7);
+    hal::current_time = 5;
+    m.run_after(t2, 2);
+
+    hal::current_time = 7;
+    m.service_task();
+    CHECK(hal::calls.back() == 7);
+    m.service_task();
+    CHECK(order == std::vector{1, 2});
+    CHECK(m.is_idle());
+}
+
+TEST_CASE("tasks cascade down from higher levels",
+          "[timing_wheel_timer_manager]") {
+    hal::reset();
+    auto m = timer_manager_t{};
+    int var{};
+    auto t = timer_manager_t::create_task([&] { var = 42; });
+    m.run_after(t, 13);
+
+    // the next event is at the level 0 boundary where the task cascades
+    CHECK(hal::calls.back() == 4);
+    for (hal::current_time = 4; hal::current_time < 13; ++hal::current_time) {
+        m.service_task();
+        CHECK(var == 0);
+    }
+    m.service_task();
+    CHECK(var == 42);
+    CHECK(m.is_idle());
+}
+
+TEST_CASE("tasks beyond the wheel wait in overflow",
+          "[timing_wheel_timer_manager]") {
+    hal::reset();
+    auto m = timer_manager_t{};
+    int var{};
+    auto t = timer_manager_t::create_task([&] { var = 42; });
+    m.run_after(t, 40);
+
+    hal::current_time = 39;
+    m.service_task();
+    CHECK(var == 0);
+    hal::current_time = 40;
+    m.service_task();
+    CHECK(var == 42);
+    CHECK(m.is_idle());
+}
+
+TEST_CASE("a late service call runs every expired task",
+          "[timing_wheel_timer_manager]") {
+    hal::reset();
+    auto m = timer_manager_t{};
+    int var{};
+    auto t1 = timer_manager_t::create_task([&] { ++var; });
+    auto t2 = timer_manager_t::create_task([&] { ++var; });
+    m.run_after(t1, 3);
+    m.run_after(t2, 30);
+
+    hal::current_time = 100;
+    m.service_task();
+    CHECK(var == 1);
+    // the interrupt is asked to fire again immediately
+    CHECK(hal::calls.back() == 100);
+    m.service_task();
+    CHECK(var == 2);
+    CHECK(m.is_idle());
+}
+
+TEST_CASE("task can reschedule itself", "[timing_wheel_timer_manager]") {
+    hal::reset();
+    auto m = timer_manager_t{};
+    int var{};
+    auto task = timer_manager_t::create_task([&](hal::task_t *t) {
+        CHECK(m.run_after(*t, 5));
+        ++var;
+    });
+    m.run_after(task.bind_front(&task), 5);
+
+    hal::current_time = 5;
+    m.service_task();
+    CHECK(var == 1);
+    CHECK(task.pending);
+    CHECK(hal::enabled);
+    CHECK(hal::calls.back() == 8);
+
+    hal::current_time = 10;
+    m.service_task();
+    CHECK(var == 2);
+    CHECK(not m.is_idle());
+}
+
+TEST_CASE("cancel a scheduled task", "[timing_wheel_timer_manager]") {
+    hal::reset();
+    auto m = timer_manager_t{};
+    int var{};
+    auto t = timer_manager_t::create_task([&] { var = 42; });
+    m.run_after(t, 10);
+    CHECK(m.cancel(t));
+    CHECK(not t.pending);
+    CHECK(m.is_idle());
+    CHECK(not hal::enabled);
+
+    hal::current_time = 10;
+    m.service_task();
+    CHECK(var == 0);
+}
+
+TEST_CASE("cancelling an unscheduled task fails",
+          "[timing_wheel_timer_manager]") {
+    hal::reset();
+    auto m = timer_manager_t{};
+    auto t = timer_manager_t::create_task([] {});
+    CHECK(not m.cancel(t));
+}
+
+TEST_CASE("cancel with more tasks outstanding at every level",
+          "[timing_wheel_timer_manager]") {
+    hal::reset();
+    auto m = timer_manager_t{};
+    std::vector<int> order{};
+    auto t1 = timer_manager_t::create_task([&] { order.push_back(1); });
+    auto t2 = timer_manager_t::create_task([&] { order.push_back(2); });
+    auto t3 = timer_manager_t::create_task([&] { order.push_back(3); });
+    auto t4 = timer_manager_t::create_task([&] { order.push_back(4); });
+    auto t5 = timer_manager_t::create_task([&] { order.push_back(5); });
+    auto t6 = timer_manager_t::create_task([&] { order.push_back(6); });
+    m.run_after(t1, 2);
+    m.run_after(t2, 2);
+    m.run_after(t3, 9);
+    m.run_after(t4, 9);
+    m.run_after(t5, 50);
+    m.run_after(t6, 50);
+
+    CHECK(m.cancel(t1));
+    CHECK(m.cancel(t4));
+    CHECK(m.cancel(t5));
+
+    for (hal::current_time = 0; hal::current_time <= 50;
+         ++hal::current_time) {
+        m.service_task();
+    }
+    CHECK(order == std::vector{2, 3, 6});
+    CHECK(m.is_idle());
+}
+
+TEST_CASE("run_at queues a task for an absolute time",
+          "[timing_wheel_timer_manager]") {
+    hal::reset();
+    auto m = timer_manager_t{};
+    int var{};
+    auto t = timer_manager_t::create_task([&] { var = 42; });
+    hal::current_time = 5;
+    CHECK(m.run_at(t, 8));
+    REQUIRE(not hal::calls.empty());
+    CHECK(hal::calls.back() == 8);
+
+    hal::current_time = 7;
+    m.service_task();
+    CHECK(var == 0);
+    hal::current_time = 8;
+    m.service_task();
+    CHECK(var == 42);
+    CHECK(m.is_idle());
+}
+
+TEST_CASE("run_at in the past runs on the next service",
+          "[timing_wheel_timer_manager]") {
+    hal::reset();
+    auto m = timer_manager_t{};
+    int var{};
+    auto t = timer_manager_t::create_task([&] { var = 42; });
+    hal::current_time = 5;
+    CHECK(m.run_at(t, 2));
+    m.service_task();
+    CHECK(var == 42);
+    CHECK(m.is_idle());
+}
+
+TEST_CASE("next_expiration is never later than the next expiry",
+          "[timing_wheel_timer_manager]") {
+    hal::reset();
+    auto m = timer_manager_t{};
+    CHECK(m.next_expiration() == std::nullopt);
+
+    auto t = timer_manager_t::create_task([] {});
+    m.run_after(t, 3);
+    CHECK(m.next_expiration() == 3);
+
+    auto u = timer_manager_t::create_task([] {});
+    m.cancel(t);
+    m.run_after(u, 9);
+    auto const next = m.next_expiration();
+    REQUIRE(next.has_value());
+    CHECK(*next <= 9);
+    CHECK(m.time_until_next() == *next);
+}
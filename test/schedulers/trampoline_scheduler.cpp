@@ -0,0 +1,74 @@
+#include "detail/common.hpp"
+
+#include <async/completion_scheduler.hpp>
+#include <async/concepts.hpp>
+#include <async/env.hpp>
+#include <async/schedulers/trampoline_scheduler.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <functional>
+
+namespace {
+// A receiver that starts its own operation again from its completion, as an
+// unbounded chain of inline reschedules would.
+struct chain {
+    int remaining{};
+    int depth{};
+    int max_depth{};
+    std::function<void()> again{};
+};
+
+struct chain_receiver {
+    using is_receiver = void;
+    chain *c;
+
+  private:
+    friend auto tag_invoke(async::set_value_t, chain_receiver const &r)
+        -> void {
+        auto &c = *r.c;
+        c.max_depth = std::max(c.max_depth, ++c.depth);
+        if (--c.remaining > 0) {
+            c.again();
+        }
+        --c.depth;
+    }
+};
+} // namespace
+
+TEST_CASE("trampoline_scheduler fulfils concept", "[trampoline_scheduler]") {
+    static_assert(async::scheduler<async::trampoline_scheduler<>>);
+    static_assert(
+        async::sender_of<decltype(async::trampoline_scheduler<>::schedule()),
+                         async::set_value_t()>);
+}
+
+TEST_CASE("trampoline_scheduler completes inline when shallow",
+          "[trampoline_scheduler]") {
+    bool recvd{};
+    auto s = async::trampoline_scheduler<>::schedule();
+    auto op = async::connect(s, receiver{[&] { recvd = true; }});
+    async::start(op);
+    CHECK(recvd);
+}
+
+TEST_CASE("trampoline_scheduler sender has the scheduler as its completion "
+          "scheduler",
+          "[trampoline_scheduler]") {
+    auto s = async::trampoline_scheduler<4>::schedule();
+    CHECK(async::get_completion_scheduler<async::set_value_t>(
+              async::get_env(s)) == async::trampoline_scheduler<4>{});
+}
+
+TEST_CASE("trampoline_scheduler bounds the depth of a rescheduling chain",
+          "[trampoline_scheduler]") {
+    constexpr auto max_depth = 8;
+    chain c{.remaining = 10'000};
+    auto op = async::connect(async::trampoline_scheduler<max_depth>::schedule(),
+                             chain_receiver{&c});
+    c.again = [&] { async::start(op); };
+    async::start(op);
+    CHECK(c.remaining == 0);
+    CHECK(c.max_depth <= max_depth);
+}
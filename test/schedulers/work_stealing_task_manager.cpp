@@ -0,0 +1,193 @@
+#include <async/schedulers/work_stealing_task_manager.hpp>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace {
+struct hal {
+    static inline thread_local std::size_t core{};
+    static inline std::atomic<int> schedule_calls{};
+    static auto schedule(async::priority_t) { ++schedule_calls; }
+    static auto current_core() -> std::size_t { return core; }
+};
+
+using task_manager_t = async::work_stealing_task_manager<hal, 4, 8, 4>;
+} // namespace
+
+TEST_CASE("work-stealing task manager fulfils concept",
+          "[work_stealing_task_manager]") {
+    static_assert(async::task_manager<task_manager_t>);
+}
+
+TEST_CASE("nothing pending", "[work_stealing_task_manager]") {
+    auto m = task_manager_t{};
+    CHECK(m.is_idle());
+}
+
+TEST_CASE("run a queued task", "[work_stealing_task_manager]") {
+    hal::core = 0;
+    hal::schedule_calls = 0;
+    auto m = task_manager_t{};
+    int var{};
+    auto task = task_manager_t::create_task([&] { var = 42; });
+    CHECK(m.enqueue_task(task, 3));
+    CHECK(hal::schedule_calls == 1);
+    CHECK(not m.is_idle());
+    m.service_tasks<3>();
+    CHECK(var == 42);
+    CHECK(m.is_idle());
+}
+
+TEST_CASE("queueing a task is idempotent", "[work_stealing_task_manager]") {
+    hal::core = 0;
+    auto m = task_manager_t{};
+    int var{};
+    auto task = task_manager_t::create_task([&] { ++var; });
+    CHECK(m.enqueue_task(task, 3));
+    CHECK(not m.enqueue_task(task, 3));
+    m.service_tasks<3>();
+    CHECK(var == 1);
+    CHECK(m.is_idle());
+}
+
+TEST_CASE("don't run a queued task of a different priority",
+          "[work_stealing_task_manager]") {
+    hal::core = 0;
+    auto m = task_manager_t{};
+    int var{};
+    auto task = task_manager_t::create_task([&] { var = 42; });
+    CHECK(m.enqueue_task(task, 1));
+    m.service_tasks<0>();
+    CHECK(var == 0);
+    CHECK(not m.is_idle());
+}
+
+TEST_CASE("an idle core steals work from another core",
+          "[work_stealing_task_manager]") {
+    auto m = task_manager_t{};
+    int var{};
+    auto task = task_manager_t::create_task([&] { var = 42; });
+    hal::core = 2;
+    CHECK(m.enqueue_task(task, 0));
+    hal::core = 1;
+    m.service_tasks<0>();
+    CHECK(var == 42);
+    CHECK(m.is_idle());
+}
+
+TEST_CASE("tasks beyond a full deque overflow and still run",
+          "[work_stealing_task_manager]") {
+    hal::core = 0;
+    auto m = task_manager_t{};
+    int var{};
+    auto const f = [&] { ++var; };
+    auto tasks = std::array{
+        task_manager_t::create_task(f), task_manager_t::create_task(f),
+        task_manager_t::create_task(f), task_manager_t::create_task(f),
+        task_manager_t::create_task(f), task_manager_t::create_task(f)};
+    for (auto &t : tasks) {
+        CHECK(m.enqueue_task(t, 0));
+    }
+    m.service_tasks<0>();
+    CHECK(var == 6);
+    CHECK(m.is_idle());
+}
+
+TEST_CASE("task can requeue itself (deferred execution)",
+          "[work_stealing_task_manager]") {
+    hal::core = 0;
+    auto m = task_manager_t{};
+    int var{};
+
+    auto task = task_manager_t::create_task(
+        [&](task_manager_t *mgr, async::priority_task *t) {
+            ++var;
+            CHECK(mgr->enqueue_task(*t, 0));
+        });
+    CHECK(m.enqueue_task(task.bind_front(&m, &task), 0));
+    m.service_tasks<0, async::requeue_policy::deferred>();
+    CHECK(var == 1);
+    CHECK(not m.is_idle());
+}
+
+TEST_CASE("task can requeue itself (immediate execution)",
+          "[work_stealing_task_manager]") {
+    hal::core = 0;
+    auto m = task_manager_t{};
+    int var{};
+
+    auto task = task_manager_t::create_task(
+        [&](task_manager_t *mgr, async::priority_task *t) {
+            if (var++ == 0) {
+                CHECK(mgr->enqueue_task(*t, 0));
+            }
+        });
+    CHECK(m.enqueue_task(task.bind_front(&m, &task), 0));
+    m.service_tasks<0, async::requeue_policy::immediate>();
+    CHECK(var == 2);
+    CHECK(m.is_idle());
+}
+
+TEST_CASE("a running task can enqueue other tasks",
+          "[work_stealing_task_manager]") {
+    hal::core = 0;
+    auto m = task_manager_t{};
+    int var{};
+    auto const f = [&] { ++var; };
+    auto others = std::array{
+        task_manager_t::create_task(f), task_manager_t::create_task(f),
+        task_manager_t::create_task(f), task_manager_t::create_task(f),
+        task_manager_t::create_task(f), task_manager_t::create_task(f)};
+
+    auto task = task_manager_t::create_task([&] {
+        for (auto &t : others) {
+            CHECK(m.enqueue_task(t, 0));
+        }
+    });
+    CHECK(m.enqueue_task(task, 0));
+    m.service_tasks<0, async::requeue_policy::immediate>();
+    CHECK(var == 6);
+    CHECK(m.is_idle());
+}
+
+TEST_CASE("cores share work", "[work_stealing_task_manager]") {
+    constexpr auto num_cores = std::size_t{4};
+    constexpr auto rounds = 500;
+    using mt_task_manager_t =
+        async::work_stealing_task_manager<hal, num_cores, 1, 16>;
+
+    auto m = mt_task_manager_t{};
+    std::atomic<int> runs{};
+    auto const f = [&] { ++runs; };
+    auto tasks = std::array{
+        mt_task_manager_t::create_task(f), mt_task_manager_t::create_task(f),
+        mt_task_manager_t::create_task(f), mt_task_manager_t::create_task(f)};
+
+    std::atomic<int> enqueued{};
+    std::vector<std::thread> cores{};
+    for (auto c = std::size_t{}; c < num_cores; ++c) {
+        cores.emplace_back([&, c] {
+            hal::core = c;
+            for (auto i = 0; i < rounds; ++i) {
+                if (m.enqueue_task(tasks[c], 0)) {
+                    ++enqueued;
+                }
+                m.service_tasks<0>();
+            }
+            while (not m.is_idle()) {
+                m.service_tasks<0>();
+            }
+        });
+    }
+    for (auto &t : cores) {
+        t.join();
+    }
+    CHECK(m.is_idle());
+    CHECK(runs == enqueued);
+}
@@ -0,0 +1,71 @@
+#include <async/schedulers/timer_manager.hpp>
+#include <async/schedulers/wrapping_time_point.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <concepts>
+#include <cstdint>
+#include <vector>
+
+namespace {
+using tick_t = async::wrapping_time_point<std::uint32_t>;
+
+struct hal {
+    using time_point_t = tick_t;
+    using task_t = async::timer_task<time_point_t>;
+
+    static inline time_point_t current_time{};
+    static inline std::vector<time_point_t> calls{};
+
+    static auto enable() -> void {}
+    static auto disable() -> void {}
+    static auto set_event_time(time_point_t tp) -> void { calls.push_back(tp); }
+    static auto now() -> time_point_t { return current_time; }
+};
+
+using timer_manager_t = async::generic_timer_manager<hal>;
+
+constexpr auto before_wrap = tick_t{0xffff'fff0u};
+} // namespace
+
+TEST_CASE("wrapping time points use a signed duration of the same width",
+          "[wrapping_time_point]") {
+    static_assert(std::same_as<decltype(before_wrap - before_wrap),
+                               std::int32_t>);
+    static_assert(std::same_as<timer_manager_t::duration_t, std::int32_t>);
+}
+
+TEST_CASE("wrapping time points are ordered across rollover",
+          "[wrapping_time_point]") {
+    constexpr auto after_wrap = before_wrap + 0x20;
+    static_assert(after_wrap.ticks == 0x10u);
+    static_assert(before_wrap < after_wrap);
+    static_assert(after_wrap > before_wrap);
+    static_assert(after_wrap - before_wrap == 0x20);
+    static_assert(before_wrap - after_wrap == -0x20);
+    static_assert(after_wrap - 0x20 == before_wrap);
+}
+
+TEST_CASE("timers are ordered and expire correctly across rollover",
+          "[wrapping_time_point]") {
+    hal::current_time = before_wrap;
+    hal::calls.clear();
+    auto m = timer_manager_t{};
+
+    std::vector<int> order{};
+    auto t1 = timer_manager_t::create_task([&] { order.push_back(1); });
+    auto t2 = timer_manager_t::create_task([&] { order.push_back(2); });
+    CHECK(m.run_after(t1, 0x20));
+    CHECK(m.run_after(t2, 0x08));
+    CHECK(hal::calls == std::vector{before_wrap + 0x20, before_wrap + 0x08});
+
+    hal::current_time = before_wrap + 0x08;
+    m.service_expired();
+    CHECK(order == std::vector{2});
+    CHECK(m.time_until_next() == 0x18);
+
+    hal::current_time = before_wrap + 0x20;
+    m.service_expired();
+    CHECK(order == std::vector{2, 1});
+    CHECK(m.is_idle());
+}
@@ -1,10 +1,14 @@
 #include "detail/common.hpp"
 
 #include <async/just.hpp>
+#include <async/just_result_of.hpp>
 #include <async/sequence.hpp>
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <array>
+#include <vector>
+
 TEST_CASE("sequence", "[sequence]") {
     int value{};
     auto s = async::sequence(async::just(), [] { return async::just(42); });
@@ -220,3 +224,45 @@ TEST_CASE(
     auto s = async::just() | async::seq(stateful_sender{1337});
     CHECK(get_fwd(async::get_env(s)) == 1337);
 }
+
+TEST_CASE("n-ary sequence runs senders in order", "[sequence]") {
+    std::vector<int> order{};
+    auto s = async::sequence(
+        async::just_result_of([&] { order.push_back(1); }),
+        async::just_result_of([&] { order.push_back(2); }),
+        async::just_result_of([&] {
+            order.push_back(3);
+            return 42;
+        }));
+    static_assert(async::sender_of<decltype(s), async::set_value_t(int)>);
+
+    int value{};
+    auto op = async::connect(s, receiver{[&](auto i) { value = i; }});
+    async::start(op);
+    CHECK(value == 42);
+    CHECK(order == std::vector{1, 2, 3});
+}
+
+TEST_CASE("n-ary sequence stops at the first error", "[sequence]") {
+    int value{};
+    bool ran_last{};
+    auto s = async::sequence(
+        async::just(), async::just_error(17),
+        async::just_result_of([&] { ran_last = true; }));
+    static_assert(async::sender_of<decltype(s), async::set_error_t(int)>);
+
+    auto op = async::connect(s, error_receiver{[&](auto i) { value = i; }});
+    async::start(op);
+    CHECK(value == 17);
+    CHECK(not ran_last);
+}
+
+TEST_CASE("n-ary sequence op state is as big as its largest step",
+          "[sequence]") {
+    auto const a = std::array<int, 16>{};
+    auto s = async::sequence(async::just(a), async::just(a), async::just(a),
+                             async::just(42));
+    auto op = async::connect(s, receiver{[](auto...) {}});
+    // the steps not yet run are held as senders, but only one op state is live
+    static_assert(sizeof(op) < sizeof(s) + sizeof(a) + 2 * sizeof(void *));
+}
@@ -0,0 +1,442 @@
+#include "detail/common.hpp"
+
+#include <async/channel.hpp>
+#include <async/concepts.hpp>
+#include <async/just.hpp>
+#include <async/schedulers/time_scheduler.hpp>
+#include <async/schedulers/timer_manager.hpp>
+#include <async/sequence_adaptors.hpp>
+#include <async/sequence_sender.hpp>
+#include <async/stop_token.hpp>
+#include <async/type_traits.hpp>
+
+#include <stdx/concepts.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <chrono>
+#include <concepts>
+#include <memory>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+template <typename F> struct sequence_receiver : F {
+    using is_receiver = void;
+    bool *done;
+
+  private:
+    template <stdx::same_as_unqualified<sequence_receiver> R,
+              typename... Args>
+    friend constexpr auto tag_invoke(async::set_next_t, R &&r, Args &&...args)
+        -> bool {
+        r(std::forward<Args>(args)...);
+        return true;
+    }
+    friend constexpr auto tag_invoke(async::set_value_t,
+                                     sequence_receiver const &r) -> void {
+        *r.done = true;
+    }
+    friend constexpr auto tag_invoke(async::channel_tag auto,
+                                     sequence_receiver const &, auto &&...)
+        -> void {}
+};
+template <typename F>
+sequence_receiver(F, bool *) -> sequence_receiver<F>;
+
+// A timer that expires when the test fires it.
+class test_timer {
+    // NOLINTNEXTLINE(cppcoreguidelines-virtual-class-destructor)
+    struct task {
+        virtual auto expire() -> void = 0;
+    };
+
+    // NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+    template <typename R> struct op_state final : task {
+        template <stdx::same_as_unqualified<R> Rcvr>
+        explicit op_state(Rcvr &&r) : rcvr{std::forward<Rcvr>(r)} {}
+        op_state(op_state &&) = delete;
+
+        auto expire() -> void override { async::set_value(std::move(rcvr)); }
+
+        struct stop_callback_fn {
+            auto operator()() -> void {
+                if (pending == ops) {
+                    pending = nullptr;
+                    async::set_stopped(std::move(ops->rcvr));
+                }
+            }
+            op_state *ops;
+        };
+
+        [[no_unique_address]] R rcvr;
+        std::optional<async::stop_callback_for_t<
+            async::stop_token_of_t<async::env_of_t<R>>, stop_callback_fn>>
+            stop_cb{};
+
+      private:
+        template <stdx::same_as_unqualified<op_state> O>
+        friend constexpr auto tag_invoke(async::start_t, O &&o) -> void {
+            ++starts;
+            pending = std::addressof(o);
+            o.stop_cb.emplace(async::get_stop_token(async::get_env(o.rcvr)),
+                              stop_callback_fn{std::addressof(o)});
+        }
+    };
+
+    class env {
+        template <typename Tag>
+        [[nodiscard]] friend constexpr auto
+        tag_invoke(async::get_completion_scheduler_t<Tag>, env) noexcept
+            -> test_timer {
+            return {};
+        }
+    };
+
+    struct sender {
+        using is_sender = void;
+        using completion_signatures =
+            async::completion_signatures<async::set_value_t(),
+                                         async::set_stopped_t()>;
+
+      private:
+        [[nodiscard]] friend constexpr auto tag_invoke(async::get_env_t,
+                                                       sender) noexcept -> env {
+            return {};
+        }
+
+        template <stdx::same_as_unqualified<sender> S, async::receiver R>
+        [[nodiscard]] friend constexpr auto tag_invoke(async::connect_t, S &&,
+                                                       R &&r)
+            -> op_state<std::remove_cvref_t<R>> {
+            return op_state<std::remove_cvref_t<R>>{std::forward<R>(r)};
+        }
+    };
+
+    [[nodiscard]] friend constexpr auto operator==(test_timer, test_timer)
+        -> bool = default;
+
+  public:
+    [[nodiscard]] static auto schedule() -> sender { return {}; }
+
+    static auto fire() -> void { std::exchange(pending, nullptr)->expire(); }
+
+    static auto reset() -> void {
+        pending = nullptr;
+        starts = 0;
+    }
+
+    static inline task *pending{};
+    static inline int starts{};
+};
+
+using time_point_t = std::chrono::steady_clock::time_point;
+auto current_time = time_point_t{};
+
+struct hal {
+    using time_point_t = std::chrono::steady_clock::time_point;
+    using task_t = async::timer_task<time_point_t>;
+
+    static auto enable() -> void {}
+    static auto disable() -> void {}
+    static auto set_event_time(time_point_t) -> void {}
+    static auto now() -> time_point_t { return current_time; }
+};
+
+using timer_manager_t = async::generic_timer_manager<hal>;
+} // namespace
+
+template <typename Rep, typename Period>
+struct async::timer_mgr::time_point_for<std::chrono::duration<Rep, Period>> {
+    using type = std::chrono::steady_clock::time_point;
+};
+
+template <>
+[[maybe_unused]] inline auto async::injected_timer_manager<> =
+    timer_manager_t{};
+
+TEST_CASE("transform maps each item", "[sequence_adaptors]") {
+    auto s = async::iterate(std::array{1, 2, 3}) |
+             async::transform([](int i) { return i * 1.5f; });
+    static_assert(std::same_as<
+                  async::completion_signatures_of_t<decltype(s)>,
+                  async::completion_signatures<async::set_next_t(float),
+                                               async::set_value_t()>>);
+
+    std::vector<float> items{};
+    bool done{};
+    auto op = async::connect(
+        s, sequence_receiver{[&](float f) { items.push_back(f); }, &done});
+    async::start(op);
+    CHECK(items == std::vector{1.5f, 3.0f, 4.5f});
+    CHECK(done);
+}
+
+TEST_CASE("transform with a void function sends empty items",
+          "[sequence_adaptors]") {
+    int sum{};
+    auto s = async::iterate(std::array{1, 2, 3}) |
+             async::transform([&](int i) { sum += i; });
+    static_assert(std::same_as<
+                  async::completion_signatures_of_t<decltype(s)>,
+                  async::completion_signatures<async::set_next_t(),
+                                               async::set_value_t()>>);
+
+    int count{};
+    bool done{};
+    auto op =
+        async::connect(s, sequence_receiver{[&] { ++count; }, &done});
+    async::start(op);
+    CHECK(sum == 6);
+    CHECK(count == 3);
+}
+
+TEST_CASE("filter sends only matching items", "[sequence_adaptors]") {
+    std::vector<int> items{};
+    bool done{};
+    auto op = async::connect(
+        async::iterate(std::array{1, 2, 3, 4, 5}) |
+            async::filter([](int i) { return i % 2 == 1; }),
+        sequence_receiver{[&](int i) { items.push_back(i); }, &done});
+    async::start(op);
+    CHECK(items == std::vector{1, 3, 5});
+    CHECK(done);
+}
+
+TEST_CASE("take ends the sequence after n items", "[sequence_adaptors]") {
+    std::vector<int> items{};
+    bool done{};
+    auto op = async::connect(
+        async::iterate(std::array{1, 2, 3, 4, 5}) | async::take(2),
+        sequence_receiver{[&](int i) { items.push_back(i); }, &done});
+    async::start(op);
+    CHECK(items == std::vector{1, 2});
+    CHECK(done);
+}
+
+TEST_CASE("take ends an endless sequence", "[sequence_adaptors]") {
+    int count{};
+    bool done{};
+    auto op = async::connect(
+        async::generate(async::just(42)) | async::take(3),
+        sequence_receiver{[&](int) { ++count; }, &done});
+    async::start(op);
+    CHECK(count == 3);
+    CHECK(done);
+}
+
+TEST_CASE("batch collects items into spans", "[sequence_adaptors]") {
+    auto s = async::iterate(std::array{1, 2, 3, 4, 5}) | async::batch<2>();
+    static_assert(
+        std::same_as<async::completion_signatures_of_t<decltype(s)>,
+                     async::completion_signatures<
+                         async::set_next_t(std::span<int>),
+                         async::set_value_t()>>);
+
+    std::vector<std::vector<int>> batches{};
+    bool done{};
+    auto op = async::connect(s, sequence_receiver{[&](std::span<int> b) {
+                                                      batches.emplace_back(
+                                                          b.begin(), b.end());
+                                                  },
+                                                  &done});
+    async::start(op);
+    CHECK(batches ==
+          std::vector<std::vector<int>>{{1, 2}, {3, 4}, {5}});
+    CHECK(done);
+}
+
+TEST_CASE("for_each makes an ordinary sender", "[sequence_adaptors]") {
+    int sum{};
+    auto s = async::iterate(std::array{1, 2, 3}) |
+             async::for_each([&](int i) { sum += i; });
+    static_assert(
+        std::same_as<async::completion_signatures_of_t<decltype(s)>,
+                     async::completion_signatures<async::set_value_t()>>);
+
+    bool done{};
+    auto op = async::connect(s, receiver{[&] { done = true; }});
+    async::start(op);
+    CHECK(sum == 6);
+    CHECK(done);
+}
+
+TEST_CASE("a pipeline of sequence adaptors runs in one operation state",
+          "[sequence_adaptors]") {
+    std::vector<int> sums{};
+    auto s = async::generate(async::just(1)) |
+             async::transform([n = 0](int i) mutable { return n += i; }) |
+             async::filter([](int i) { return i % 2 == 0; }) |
+             async::batch<2>() | async::take(3) |
+             async::for_each([&](std::span<int> b) {
+                 sums.push_back(b[0] + b[1]);
+             });
+
+    bool done{};
+    auto op = async::connect(s, receiver{[&] { done = true; }});
+    async::start(op);
+    CHECK(sums == std::vector{2 + 4, 6 + 8, 10 + 12});
+    CHECK(done);
+}
+
+TEST_CASE("window sends full batches and cancels its timer at the end",
+          "[sequence_adaptors]") {
+    test_timer::reset();
+    auto s = async::iterate(std::array{1, 2, 3, 4, 5}) |
+             async::window<2>(test_timer{});
+    static_assert(
+        std::same_as<async::completion_signatures_of_t<decltype(s)>,
+                     async::completion_signatures<
+                         async::set_next_t(std::span<int>),
+                         async::set_value_t()>>);
+
+    std::vector<std::vector<int>> batches{};
+    bool done{};
+    auto op = async::connect(s, sequence_receiver{[&](std::span<int> b) {
+                                                      batches.emplace_back(
+                                                          b.begin(), b.end());
+                                                  },
+                                                  &done});
+    async::start(op);
+    CHECK(batches ==
+          std::vector<std::vector<int>>{{1, 2}, {3, 4}, {5}});
+    CHECK(test_timer::starts == 1);
+    CHECK(test_timer::pending == nullptr);
+    CHECK(done);
+}
+
+TEST_CASE("window sends a partial batch when its timer expires",
+          "[sequence_adaptors]") {
+    test_timer::reset();
+    auto c = async::channel<int, 4>{};
+    auto push = [&](int v) {
+        auto sop = async::connect(c.send(v), receiver{[] {}});
+        async::start(sop);
+    };
+
+    std::vector<std::vector<int>> batches{};
+    bool done{};
+    auto op = async::connect(
+        async::generate(c.receive()) | async::take(5) |
+            async::window<4>(test_timer{}),
+        sequence_receiver{[&](std::span<int> b) {
+                              batches.emplace_back(b.begin(), b.end());
+                          },
+                          &done});
+    async::start(op);
+    push(1);
+    push(2);
+    CHECK(batches.empty());
+    CHECK(test_timer::starts == 1);
+
+    test_timer::fire();
+    CHECK(batches == std::vector<std::vector<int>>{{1, 2}});
+
+    push(3);
+    CHECK(test_timer::starts == 2);
+    push(4);
+    push(5);
+    CHECK(batches == std::vector<std::vector<int>>{{1, 2}, {3, 4, 5}});
+    CHECK(test_timer::pending == nullptr);
+    CHECK(done);
+}
+
+TEST_CASE("debounce sends the last item of a burst", "[sequence_adaptors]") {
+    auto c = async::channel<int, 4>{};
+    auto push = [&](int v) {
+        auto sop = async::connect(c.send(v), receiver{[] {}});
+        async::start(sop);
+    };
+
+    std::vector<int> items{};
+    bool done{};
+    auto op = async::connect(
+        async::generate(c.receive()) |
+            async::debounce(async::time_scheduler{10ms}),
+        sequence_receiver{[&](int i) { items.push_back(i); }, &done});
+    async::start(op);
+    for (auto i = 0; i < 1000; ++i) {
+        push(i);
+    }
+    CHECK(items.empty());
+
+    current_time += 10ms;
+    async::timer_mgr::service_task();
+    CHECK(items == std::vector{999});
+    CHECK(async::timer_mgr::is_idle());
+
+    push(1000);
+    current_time += 5ms;
+    push(1001);
+    current_time += 5ms;
+    async::timer_mgr::service_task();
+    CHECK(items == std::vector{999});
+    current_time += 5ms;
+    async::timer_mgr::service_task();
+    CHECK(items == std::vector{999, 1001});
+    CHECK(not done);
+}
+
+TEST_CASE("debounce sends a held item at the end of the sequence",
+          "[sequence_adaptors]") {
+    std::vector<int> items{};
+    bool done{};
+    auto op = async::connect(
+        async::iterate(std::array{1, 2, 3}) |
+            async::debounce(async::time_scheduler{10ms}),
+        sequence_receiver{[&](int i) { items.push_back(i); }, &done});
+    async::start(op);
+    CHECK(items == std::vector{3});
+    CHECK(done);
+    CHECK(async::timer_mgr::is_idle());
+}
+
+TEST_CASE("throttle sends the first item of a burst", "[sequence_adaptors]") {
+    auto c = async::channel<int, 4>{};
+    auto push = [&](int v) {
+        auto sop = async::connect(c.send(v), receiver{[] {}});
+        async::start(sop);
+    };
+
+    std::vector<int> items{};
+    bool done{};
+    auto op = async::connect(
+        async::generate(c.receive()) |
+            async::throttle(async::time_scheduler{10ms}),
+        sequence_receiver{[&](int i) { items.push_back(i); }, &done});
+    async::start(op);
+    for (auto i = 0; i < 1000; ++i) {
+        push(i);
+    }
+    CHECK(items == std::vector{0});
+
+    current_time += 10ms;
+    async::timer_mgr::service_task();
+    CHECK(async::timer_mgr::is_idle());
+    push(1000);
+    push(1001);
+    CHECK(items == std::vector{0, 1000});
+
+    current_time += 10ms;
+    async::timer_mgr::service_task();
+    CHECK(async::timer_mgr::is_idle());
+}
+
+TEST_CASE("throttle cancels its timer at the end of the sequence",
+          "[sequence_adaptors]") {
+    std::vector<int> items{};
+    bool done{};
+    auto op = async::connect(
+        async::iterate(std::array{1, 2, 3}) |
+            async::throttle(async::time_scheduler{10ms}),
+        sequence_receiver{[&](int i) { items.push_back(i); }, &done});
+    async::start(op);
+    CHECK(items == std::vector{1});
+    CHECK(done);
+    CHECK(async::timer_mgr::is_idle());
+}
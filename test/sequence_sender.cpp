@@ -0,0 +1,115 @@
+#include "detail/common.hpp"
+
+#include <async/concepts.hpp>
+#include <async/just.hpp>
+#include <async/sequence_sender.hpp>
+#include <async/type_traits.hpp>
+
+#include <stdx/concepts.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <concepts>
+#include <utility>
+#include <vector>
+
+namespace {
+template <typename F> struct sequence_receiver : F {
+    using is_receiver = void;
+    bool *done;
+
+  private:
+    template <stdx::same_as_unqualified<sequence_receiver> R,
+              typename... Args>
+    friend constexpr auto tag_invoke(async::set_next_t, R &&r, Args &&...args)
+        -> bool {
+        return r(std::forward<Args>(args)...);
+    }
+    friend constexpr auto tag_invoke(async::set_value_t,
+                                     sequence_receiver const &r) -> void {
+        *r.done = true;
+    }
+    friend constexpr auto tag_invoke(async::channel_tag auto,
+                                     sequence_receiver const &, auto &&...)
+        -> void {}
+};
+template <typename F>
+sequence_receiver(F, bool *) -> sequence_receiver<F>;
+} // namespace
+
+TEST_CASE("iterate is a sequence sender", "[sequence_sender]") {
+    auto s = async::iterate(std::array{1, 2, 3});
+    static_assert(async::sender<decltype(s)>);
+    static_assert(std::same_as<
+                  async::completion_signatures_of_t<decltype(s)>,
+                  async::completion_signatures<async::set_next_t(int),
+                                               async::set_value_t()>>);
+    static_assert(
+        std::same_as<async::item_signatures_of_t<decltype(s)>,
+                     async::completion_signatures<async::set_next_t(int)>>);
+}
+
+TEST_CASE("iterate sends each element, then completes",
+          "[sequence_sender]") {
+    std::vector<int> items{};
+    bool done{};
+    auto op = async::connect(async::iterate(std::array{1, 2, 3}),
+                             sequence_receiver{[&](int i) {
+                                                   items.push_back(i);
+                                                   return true;
+                                               },
+                                               &done});
+    async::start(op);
+    CHECK(items == std::vector{1, 2, 3});
+    CHECK(done);
+}
+
+TEST_CASE("a sequence ends when the receiver wants no more items",
+          "[sequence_sender]") {
+    std::vector<int> items{};
+    bool done{};
+    auto op = async::connect(async::iterate(std::array{1, 2, 3}),
+                             sequence_receiver{[&](int i) {
+                                                   items.push_back(i);
+                                                   return i < 2;
+                                               },
+                                               &done});
+    async::start(op);
+    CHECK(items == std::vector{1, 2});
+    CHECK(done);
+}
+
+TEST_CASE("generate sends each value of a sender as an item",
+          "[sequence_sender]") {
+    auto s = async::generate(async::just(42));
+    static_assert(std::same_as<
+                  async::completion_signatures_of_t<decltype(s)>,
+                  async::completion_signatures<async::set_value_t(),
+                                               async::set_next_t(int)>>);
+
+    int count{};
+    bool done{};
+    auto op = async::connect(s, sequence_receiver{[&](int i) {
+                                                      CHECK(i == 42);
+                                                      return ++count < 1000;
+                                                  },
+                                                  &done});
+    async::start(op);
+    CHECK(count == 1000);
+    CHECK(done);
+}
+
+TEST_CASE("generate ends with the error of its sender", "[sequence_sender]") {
+    auto s = async::generate(async::just_error(17));
+    static_assert(std::same_as<
+                  async::completion_signatures_of_t<decltype(s)>,
+                  async::completion_signatures<async::set_value_t(),
+                                               async::set_error_t(int)>>);
+
+    int value{};
+    auto op =
+        async::connect(s, error_receiver{[&](int i) { value = i; }});
+    async::start(op);
+    CHECK(value == 17);
+}
@@ -0,0 +1,118 @@
+#include "detail/common.hpp"
+
+#include <async/schedulers/priority_scheduler.hpp>
+#include <async/schedulers/task_manager.hpp>
+#include <async/spawn_when_available.hpp>
+#include <async/start_detached.hpp>
+#include <async/then.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace {
+struct hal {
+    static auto schedule(async::priority_t) {}
+};
+
+using task_manager_t = async::priority_task_manager<hal, 8>;
+} // namespace
+
+template <> inline auto async::injected_task_manager<> = task_manager_t{};
+
+TEST_CASE("spawn_when_available spawns immediately when a slot is free",
+          "[spawn_when_available]") {
+    int var{};
+    bool spawned{};
+    using S = async::fixed_priority_scheduler<0>;
+    auto s = S::schedule() | async::then([&] { ++var; });
+
+    using Name = decltype([] {});
+    auto w = async::spawn_when_available<Name>(s) |
+             async::then([&](auto stop_src) { spawned = stop_src != nullptr; });
+    CHECK(async::start_detached(w));
+    CHECK(spawned);
+    async::task_mgr::service_tasks<0>();
+    CHECK(var == 1);
+}
+
+TEST_CASE("spawn_when_available waits for a slot to be released",
+          "[spawn_when_available]") {
+    int var{};
+    bool spawned{};
+    using S = async::fixed_priority_scheduler<0>;
+    auto s = S::schedule() | async::then([&] { ++var; });
+
+    using Name = decltype([] {});
+    CHECK(async::start_detached<Name>(s));
+    CHECK(not async::start_detached<Name>(s));
+
+    auto w = async::spawn_when_available<Name>(s) |
+             async::then([&](auto) { spawned = true; });
+    CHECK(async::start_detached(w));
+    CHECK(not spawned);
+
+    async::task_mgr::service_tasks<0>();
+    CHECK(var == 1);
+    CHECK(spawned);
+
+    async::task_mgr::service_tasks<0>();
+    CHECK(var == 2);
+}
+
+TEST_CASE("spawn_when_available waiters are served in order",
+          "[spawn_when_available]") {
+    int var{};
+    int order{};
+    int first{};
+    int second{};
+    using S = async::fixed_priority_scheduler<0>;
+    auto s = S::schedule() | async::then([&] { ++var; });
+
+    using Name = decltype([] {});
+    CHECK(async::start_detached<Name>(s));
+
+    auto w1 = async::spawn_when_available<Name>(s) |
+              async::then([&](auto) { first = ++order; });
+    auto w2 = async::spawn_when_available<Name>(s) |
+              async::then([&](auto) { second = ++order; });
+    CHECK(async::start_detached(w1));
+    CHECK(async::start_detached(w2));
+
+    async::task_mgr::service_tasks<0>();
+    CHECK(first == 1);
+    CHECK(second == 0);
+    async::task_mgr::service_tasks<0>();
+    CHECK(second == 2);
+    async::task_mgr::service_tasks<0>();
+    CHECK(var == 3);
+}
+
+TEST_CASE("a stopped spawn_when_available waiter leaves the queue",
+          "[spawn_when_available]") {
+    int var{};
+    bool stopped{};
+    using S = async::fixed_priority_scheduler<0>;
+    auto s = S::schedule() | async::then([&] { ++var; });
+
+    using Name = decltype([] {});
+    CHECK(async::start_detached<Name>(s));
+
+    auto r = stoppable_receiver{[&] { stopped = true; }};
+    auto op = async::connect(async::spawn_when_available<Name>(s), r);
+    async::start(op);
+    CHECK(not stopped);
+
+    r.request_stop();
+    CHECK(stopped);
+
+    async::task_mgr::service_tasks<0>();
+    CHECK(var == 1);
+    CHECK(async::task_mgr::is_idle());
+}
+
+TEST_CASE("spawn_when_available advertises set_stopped",
+          "[spawn_when_available]") {
+    using Name = decltype([] {});
+    auto s = async::spawn_when_available<Name>(
+        async::fixed_priority_scheduler<0>::schedule());
+    static_assert(async::sender_of<decltype(s), async::set_stopped_t()>);
+}
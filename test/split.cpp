@@ -3,16 +3,23 @@
 #include <async/concepts.hpp>
 #include <async/just.hpp>
 #include <async/schedulers/inline_scheduler.hpp>
+#include <async/sequence.hpp>
 #include <async/split.hpp>
 #include <async/start_on.hpp>
 #include <async/tags.hpp>
 #include <async/then.hpp>
 
 #include <stdx/concepts.hpp>
+#include <stdx/functional.hpp>
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <array>
 #include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
 #include <utility>
 
 TEST_CASE("split", "[split]") {
@@ -54,6 +61,28 @@ TEST_CASE("split error", "[split]") {
     CHECK(recvd2);
 }
 
+namespace {
+enum struct bus_error : std::uint8_t { nack = 1, timeout };
+} // namespace
+
+TEST_CASE("split error code", "[split]") {
+    bus_error recvd1{};
+    bus_error recvd2{};
+    auto s = async::inline_scheduler::schedule<
+                 async::inline_scheduler::singleshot>() |
+             async::seq(async::just_error(bus_error::nack));
+    auto spl = async::split(std::move(s));
+
+    auto op1 = async::connect(
+        spl, error_receiver{[&](bus_error e) { recvd1 = e; }});
+    auto op2 = async::connect(
+        spl, error_receiver{[&](bus_error e) { recvd2 = e; }});
+    async::start(op1);
+    async::start(op2);
+    CHECK(recvd1 == bus_error::nack);
+    CHECK(recvd2 == bus_error::nack);
+}
+
 TEST_CASE("split advertises what it sends", "[split]") {
     auto s = async::just(move_only{42});
     auto spl = async::split(std::move(s));
@@ -180,3 +209,134 @@ TEST_CASE("split sender environment", "[split]") {
     auto spl = async::split(std::move(s));
     CHECK(get_fwd(async::get_env(spl)) == 42);
 }
+
+namespace {
+struct deferred_sender {
+    using is_sender = void;
+    using completion_signatures =
+        async::completion_signatures<async::set_value_t(int)>;
+
+    static inline std::function<void()> pending{};
+
+    template <typename R> struct op_state {
+        R r;
+
+      private:
+        template <stdx::same_as_unqualified<op_state> O>
+        friend constexpr auto tag_invoke(async::start_t, O &&o) -> void {
+            pending = [&o] { async::set_value(std::move(o.r), 42); };
+        }
+    };
+
+    template <typename R>
+    [[nodiscard]] friend constexpr auto tag_invoke(async::connect_t,
+                                                   deferred_sender &&, R &&r)
+        -> op_state<std::remove_cvref_t<R>> {
+        return {std::forward<R>(r)};
+    }
+};
+} // namespace
+
+TEST_CASE("split notifies many subscribers", "[split]") {
+    int sum{};
+    auto spl = async::split(deferred_sender{});
+    auto const f = [&](int i) { sum += i; };
+    using op_t = decltype(async::connect(spl, receiver{f}));
+
+    std::array<std::optional<op_t>, 64> ops{};
+    for (auto &op : ops) {
+        op.emplace(stdx::with_result_of{
+            [&] { return async::connect(spl, receiver{f}); }});
+        async::start(*op);
+    }
+    CHECK(sum == 0);
+
+    deferred_sender::pending();
+    CHECK(sum == 42 * 64);
+
+    auto late = async::connect(spl, receiver{f});
+    async::start(late);
+    CHECK(sum == 42 * 65);
+}
+
+TEST_CASE("split_allocated", "[split]") {
+    bool recvd1{};
+    bool recvd2{};
+    auto s = async::inline_scheduler::schedule<
+        async::inline_scheduler::singleshot>();
+    auto spl = async::split_allocated(std::move(s));
+    static_assert(async::multishot_sender<decltype(spl), universal_receiver>);
+
+    auto op1 = async::connect(spl, receiver{[&] { recvd1 = true; }});
+    auto op2 = async::connect(spl, receiver{[&] { recvd2 = true; }});
+    async::start(op1);
+    CHECK(recvd1);
+
+    CHECK(not recvd2);
+    async::start(op2);
+    CHECK(recvd2);
+}
+
+TEST_CASE("split_allocated advertises what it sends", "[split]") {
+    auto s = async::just(move_only{42});
+    auto spl = async::split_allocated(std::move(s));
+    static_assert(
+        async::sender_of<decltype(spl), async::set_value_t(move_only<int>)>);
+    static_assert(async::sender_of<decltype(spl), async::set_stopped_t()>);
+}
+
+namespace {
+struct split_domain;
+struct split_multi_domain;
+} // namespace
+
+template <>
+constexpr inline auto async::static_allocation_stats_enabled<split_domain> =
+    true;
+template <>
+constexpr inline auto async::static_allocation_limit<split_multi_domain> =
+    std::size_t{2};
+
+TEST_CASE("split_allocated releases its state with the last reference",
+          "[split]") {
+    int value{};
+    {
+        auto spl = async::inline_scheduler::schedule<
+                       async::inline_scheduler::singleshot>() |
+                   async::then([] { return 42; }) |
+                   async::split_allocated<split_domain>();
+        CHECK(async::static_allocation_stats<split_domain>().current == 1);
+
+        auto op = async::connect(spl, receiver{[&](int i) { value = i; }});
+        async::start(op);
+        CHECK(value == 42);
+        CHECK(async::static_allocation_stats<split_domain>().current == 1);
+    }
+    CHECK(async::static_allocation_stats<split_domain>().current == 0);
+}
+
+TEST_CASE("split_allocated allows concurrent instances", "[split]") {
+    int value1{};
+    int value2{};
+    int stopped{};
+    auto make_split = [](int v) {
+        return async::inline_scheduler::schedule<
+                   async::inline_scheduler::singleshot>() |
+               async::then([=] { return v; }) |
+               async::split_allocated<split_multi_domain>();
+    };
+
+    auto spl1 = make_split(42);
+    auto spl2 = make_split(17);
+    auto spl3 = make_split(0);
+
+    auto op1 = async::connect(spl1, receiver{[&](int i) { value1 = i; }});
+    auto op2 = async::connect(spl2, receiver{[&](int i) { value2 = i; }});
+    auto op3 = async::connect(spl3, stopped_receiver{[&] { ++stopped; }});
+    async::start(op1);
+    async::start(op2);
+    async::start(op3);
+    CHECK(value1 == 42);
+    CHECK(value2 == 17);
+    CHECK(stopped == 1);
+}
@@ -102,3 +102,111 @@ TEST_CASE("start_detached_unstoppable has no cancellation",
     async::task_mgr::service_tasks<0>();
     CHECK(var == 42);
 }
+
+TEST_CASE("start_detached_recycling runs the operation", "[start_detached]") {
+    int var{};
+    auto s = async::just_result_of([&] { var = 42; });
+    CHECK(async::start_detached_recycling(s));
+    CHECK(var == 42);
+}
+
+TEST_CASE("start_detached_recycling relaunches in place",
+          "[start_detached]") {
+    int var{};
+    using S = async::fixed_priority_scheduler<0>;
+    auto s = S::schedule() | async::then([&] { ++var; });
+
+    auto const r1 = async::start_detached_recycling<struct recycle>(s);
+    REQUIRE(r1);
+    async::task_mgr::service_tasks<0>();
+    CHECK(var == 1);
+
+    auto const r2 = async::start_detached_recycling<struct recycle>(s);
+    REQUIRE(r2);
+    CHECK(*r2 == *r1);
+    async::task_mgr::service_tasks<0>();
+    CHECK(var == 2);
+}
+
+TEST_CASE("start_detached_recycling queues one restart while running",
+          "[start_detached]") {
+    int var{};
+    using S = async::fixed_priority_scheduler<0>;
+    auto s = S::schedule() | async::then([&] { ++var; });
+
+    CHECK(async::start_detached_recycling<struct queue>(s));
+    CHECK(async::start_detached_recycling<struct queue>(s));
+    CHECK(not async::start_detached_recycling<struct queue>(s));
+
+    async::task_mgr::service_tasks<0>();
+    CHECK(var == 1);
+    async::task_mgr::service_tasks<0>();
+    CHECK(var == 2);
+    async::task_mgr::service_tasks<0>();
+    CHECK(var == 2);
+    CHECK(async::task_mgr::is_idle());
+}
+
+TEST_CASE("a queued restart runs the sender passed to its launch",
+          "[start_detached]") {
+    int var{};
+    using S = async::fixed_priority_scheduler<0>;
+    auto const make = [&](int v) {
+        return S::schedule() | async::then([&var, v] { var = v; });
+    };
+
+    CHECK(async::start_detached_recycling<struct queue_latest>(make(1)));
+    CHECK(async::start_detached_recycling<struct queue_latest>(make(2)));
+
+    async::task_mgr::service_tasks<0>();
+    CHECK(var == 1);
+    async::task_mgr::service_tasks<0>();
+    CHECK(var == 2);
+    CHECK(async::task_mgr::is_idle());
+}
+
+TEST_CASE("start_detached_recycling can be cancelled", "[start_detached]") {
+    int var{};
+    using S = async::fixed_priority_scheduler<0>;
+    auto s = S::schedule() | async::then([&] { ++var; });
+
+    auto const r = async::start_detached_recycling<struct cancel>(s);
+    REQUIRE(r);
+    (*r)->request_stop();
+    async::task_mgr::service_tasks<0>();
+    CHECK(var == 0);
+    CHECK(async::start_detached_recycling<struct cancel>(s));
+    async::task_mgr::service_tasks<0>();
+    CHECK(var == 1);
+}
+
+namespace {
+int sync_runs{};
+
+// completes synchronously, after relaunching its own call site
+struct relaunch {
+    auto operator()() const -> void;
+};
+
+auto launch_relaunching() {
+    return async::start_detached_recycling<struct sync_restart>(
+        async::just_result_of(relaunch{}));
+}
+
+auto relaunch::operator()() const -> void {
+    if (++sync_runs < 10'000) {
+        CHECK(launch_relaunching());
+    }
+}
+} // namespace
+
+TEST_CASE("a restart of a synchronous sender runs after it completes",
+          "[start_detached]") {
+    sync_runs = 0;
+    CHECK(launch_relaunching());
+    CHECK(sync_runs == 10'000);
+
+    sync_runs = 9'999;
+    CHECK(launch_relaunching());
+    CHECK(sync_runs == 10'000);
+}
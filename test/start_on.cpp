@@ -4,13 +4,17 @@
 #include <async/concepts.hpp>
 #include <async/env.hpp>
 #include <async/just.hpp>
+#include <async/op_state_size.hpp>
 #include <async/schedulers/inline_scheduler.hpp>
+#include <async/sequence.hpp>
 #include <async/start_on.hpp>
 #include <async/tags.hpp>
 #include <async/when_all.hpp>
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <array>
+
 TEST_CASE("start_on", "[start_on]") {
     int value{};
 
@@ -74,3 +78,14 @@ TEST_CASE("start_on advertises what it sends according to the receiver",
     static_assert(async::sender_of<decltype(s), async::set_stopped_t(),
                                    async::env_of_t<decltype(r)>>);
 }
+
+TEST_CASE("start_on keeps the child sender in the schedule stage",
+          "[start_on]") {
+    auto const payload = std::array<int, 8>{};
+    using S = decltype(async::start_on(async::inline_scheduler{},
+                                       async::just(payload)));
+    using seq_t = decltype(async::inline_scheduler{}.schedule() |
+                           async::seq(async::just(payload)));
+    STATIC_REQUIRE(async::op_state_size_of_v<S> <
+                   async::op_state_size_of_v<seq_t>);
+}
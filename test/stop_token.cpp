@@ -4,7 +4,25 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <array>
 #include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace {
+struct test_concurrency_policy {
+    static inline int critical_sections{};
+
+    template <typename = void, typename F, typename... Pred>
+    static auto call_in_critical_section(F &&f, Pred &&...) -> decltype(auto) {
+        ++critical_sections;
+        return std::forward<F>(f)();
+    }
+};
+} // namespace
+
+template <> inline auto conc::injected_policy<> = test_concurrency_policy{};
 
 TEST_CASE("concepts", "[stop_token]") {
     static_assert(async::stoppable_token<async::inplace_stop_token>);
@@ -98,3 +116,110 @@ TEST_CASE("stop callback can register another callback", "[stop_token]") {
     CHECK(s.request_stop());
     CHECK(stopped == 0);
 }
+
+TEST_CASE("a lone destroyed stop callback is not called", "[stop_token]") {
+    auto s = async::inplace_stop_source{};
+    auto const t = s.get_token();
+
+    auto stopped = false;
+    auto l = [&] { stopped = true; };
+    {
+        auto cb = async::inplace_stop_callback{t, l};
+    }
+    CHECK(s.request_stop());
+    CHECK(not stopped);
+}
+
+TEST_CASE("stop callback can unregister a pending callback", "[stop_token]") {
+    auto s = async::inplace_stop_source{};
+    auto const t = s.get_token();
+
+    auto stopped = 0;
+    auto l = [&] { ++stopped; };
+    using cb_t = async::inplace_stop_callback<decltype(l)>;
+
+    auto cb2 = std::unique_ptr<cb_t>{};
+    auto cb1 = async::inplace_stop_callback{t, [&] {
+                                                ++stopped;
+                                                cb2.reset();
+                                            }};
+    cb2 = std::make_unique<cb_t>(t, l);
+    CHECK(s.request_stop());
+    CHECK(stopped == 1);
+}
+
+TEST_CASE("single_inplace_stop_token concepts", "[stop_token]") {
+    static_assert(async::stoppable_token<async::single_inplace_stop_token>);
+    static_assert(not async::unstoppable_token<async::single_inplace_stop_token>);
+    static_assert(
+        sizeof(async::single_inplace_stop_source) == sizeof(void *));
+}
+
+TEST_CASE("single stop callback is called on request_stop", "[stop_token]") {
+    auto s = async::single_inplace_stop_source{};
+    auto const t = s.get_token();
+
+    auto stopped = 0;
+    {
+        auto cb = async::single_inplace_stop_callback{t, [&] { ++stopped; }};
+    }
+    auto cb = async::single_inplace_stop_callback{t, [&] { ++stopped; }};
+    CHECK(not t.stop_requested());
+    CHECK(s.request_stop());
+    CHECK(t.stop_requested());
+    CHECK(stopped == 1);
+    CHECK(not s.request_stop());
+    CHECK(stopped == 1);
+}
+
+TEST_CASE("single stop callback runs on construction after request_stop",
+          "[stop_token]") {
+    auto s = async::single_inplace_stop_source{};
+    auto const t = s.get_token();
+    CHECK(s.request_stop());
+
+    auto stopped = false;
+    auto cb = async::single_inplace_stop_callback{t, [&] { stopped = true; }};
+    CHECK(stopped);
+}
+
+TEST_CASE("stop callback storage for an unstoppable token is empty",
+          "[stop_token]") {
+    auto l = [] {};
+    using never_cb_t =
+        async::optional_stop_callback_t<async::never_stop_token,
+                                        decltype(l)>;
+    static_assert(std::is_empty_v<never_cb_t>);
+
+    using inplace_cb_t =
+        async::optional_stop_callback_t<async::inplace_stop_token,
+                                        decltype(l)>;
+    static_assert(
+        std::is_same_v<inplace_cb_t, std::optional<async::inplace_stop_callback<
+                                         decltype(l)>>>);
+}
+
+TEST_CASE("request_stop takes one critical section for all callbacks",
+          "[stop_token]") {
+    auto s = async::inplace_stop_source{};
+    auto const t = s.get_token();
+
+    auto stopped = 0;
+    auto l = [&] { ++stopped; };
+    using cb_t = async::inplace_stop_callback<decltype(l)>;
+    auto cbs = std::array<std::optional<cb_t>, 64>{};
+    for (auto &cb : cbs) {
+        cb.emplace(t, l);
+    }
+
+    test_concurrency_policy::critical_sections = 0;
+    CHECK(s.request_stop());
+    CHECK(stopped == 64);
+    CHECK(test_concurrency_policy::critical_sections == 1);
+
+    test_concurrency_policy::critical_sections = 0;
+    for (auto &cb : cbs) {
+        cb.reset();
+    }
+    CHECK(test_concurrency_policy::critical_sections == 0);
+}
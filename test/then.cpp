@@ -9,6 +9,9 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <concepts>
+#include <type_traits>
+
 TEST_CASE("then", "[then]") {
     int value{};
 
@@ -256,3 +259,40 @@ TEST_CASE("then can handle a reference", "[then]") {
                        }});
     async::start(op);
 }
+
+TEST_CASE("a chain of thens is fused into one sender", "[then]") {
+    int value{};
+    auto const j = async::just(42);
+    auto s = j | async::then([](int i) { return i + 1; }) |
+             async::then([](int i) { return i * 2; }) |
+             async::then([](int i) { return i - 3; });
+    static_assert(std::same_as<decltype(s.s), std::remove_cvref_t<decltype(j)>>);
+    static_assert(async::sender_of<decltype(s), async::set_value_t(int)>);
+    auto op = async::connect(s, receiver{[&](int i) { value = i; }});
+    async::start(op);
+    CHECK(value == 83);
+}
+
+TEST_CASE("a fused chain of thens can pass through void", "[then]") {
+    int value{};
+    int calls{};
+    auto s = async::just(42) | async::then([&](int) { ++calls; }) |
+             async::then([] { return 17; });
+    static_assert(async::sender_of<decltype(s), async::set_value_t(int)>);
+    auto op = async::connect(s, receiver{[&](int i) { value = i; }});
+    async::start(op);
+    CHECK(calls == 1);
+    CHECK(value == 17);
+}
+
+TEST_CASE("a fused chain of thens can be adaptor-composed", "[then]") {
+    int value{};
+    auto const a = async::then([](int i) { return i + 1; }) |
+                   async::then([](int i) { return i * 2; });
+    auto const j = async::just(42);
+    auto s = j | a;
+    static_assert(std::same_as<decltype(s.s), std::remove_cvref_t<decltype(j)>>);
+    auto op = async::connect(s, receiver{[&](int i) { value = i; }});
+    async::start(op);
+    CHECK(value == 86);
+}
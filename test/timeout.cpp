@@ -0,0 +1,127 @@
+#include "detail/common.hpp"
+
+#include <async/just.hpp>
+#include <async/just_error.hpp>
+#include <async/schedulers/time_scheduler.hpp>
+#include <async/schedulers/timer_manager.hpp>
+#include <async/sequence.hpp>
+#include <async/then.hpp>
+#include <async/timeout.hpp>
+#include <async/when_any.hpp>
+
+#include <stdx/functional.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <functional>
+#include <optional>
+
+using namespace std::chrono_literals;
+
+namespace {
+using time_point_t = std::chrono::steady_clock::time_point;
+auto current_time = time_point_t{};
+
+struct hal {
+    using time_point_t = std::chrono::steady_clock::time_point;
+    using task_t = async::timer_task<time_point_t>;
+
+    static auto enable() -> void {}
+    static auto disable() -> void {}
+    static auto set_event_time(time_point_t) -> void {}
+    static auto now() -> time_point_t { return current_time; }
+};
+
+using timer_manager_t = async::generic_timer_manager<hal>;
+} // namespace
+
+template <typename Rep, typename Period>
+struct async::timer_mgr::time_point_for<std::chrono::duration<Rep, Period>> {
+    using type = std::chrono::steady_clock::time_point;
+};
+
+template <>
+[[maybe_unused]] inline auto async::injected_timer_manager<> =
+    timer_manager_t{};
+
+TEST_CASE("timeout advertises a timed_out_t error", "[timeout]") {
+    auto s = async::just(42) | async::timeout(async::time_scheduler{10ms});
+    static_assert(async::sender_of<decltype(s), async::set_value_t(int)>);
+    static_assert(
+        async::sender_of<decltype(s), async::set_error_t(async::timed_out_t)>);
+}
+
+TEST_CASE("work that completes in time cancels the timer", "[timeout]") {
+    int value{};
+    auto s = async::just(42) | async::timeout(async::time_scheduler{10ms});
+    auto op = async::connect(s, receiver{[&](int i) { value = i; }});
+    async::start(op);
+    CHECK(value == 42);
+    CHECK(async::timer_mgr::is_idle());
+}
+
+TEST_CASE("work that is still running at the timeout completes with an error",
+          "[timeout]") {
+    int value{};
+    auto s = async::time_scheduler{100ms}.schedule() |
+             async::then([&] { value = 42; }) |
+             async::timeout(async::time_scheduler{10ms});
+    auto op = async::connect(
+        s, error_receiver{[&](async::timed_out_t) { value = 17; }});
+    async::start(op);
+    CHECK(value == 0);
+
+    current_time += 10ms;
+    async::timer_mgr::service_task();
+    CHECK(value == 17);
+    CHECK(async::timer_mgr::is_idle());
+}
+
+TEST_CASE("a stop request from downstream is forwarded", "[timeout]") {
+    int value{};
+    auto r = stoppable_receiver{[&] { value = 17; }};
+    auto s = async::timeout(async::time_scheduler{100ms}.schedule(),
+                            async::time_scheduler{10ms});
+    auto op = async::connect(s, r);
+    async::start(op);
+    r.request_stop();
+    CHECK(value == 17);
+    CHECK(async::timer_mgr::is_idle());
+}
+
+TEST_CASE("timeout is smaller than racing against a timer", "[timeout]") {
+    auto const sched = async::time_scheduler{10ms};
+    auto timed = async::just(42) | async::timeout(sched);
+    auto raced = async::when_any(
+        async::just(42),
+        sched.schedule() | async::seq(async::just_error(async::timed_out_t{})));
+    using R = universal_receiver;
+    static_assert(sizeof(async::connect_result_t<decltype(timed), R>) <
+                  sizeof(async::connect_result_t<decltype(raced), R>));
+}
+
+TEST_CASE("the receiver may destroy the op state when the timeout fires",
+          "[timeout]") {
+    int value{};
+    auto s = async::time_scheduler{100ms}.schedule() |
+             async::timeout(async::time_scheduler{10ms});
+    using op_t = async::connect_result_t<
+        decltype(s), error_receiver<std::function<void(async::timed_out_t)>>>;
+    std::optional<op_t> op{};
+    op.emplace(stdx::with_result_of{[&] {
+        return async::connect(
+            s, error_receiver<std::function<void(async::timed_out_t)>>{
+                   [&](async::timed_out_t) {
+                       value = 17;
+                       op.reset();
+                   }});
+    }});
+    async::start(*op);
+
+    current_time += 10ms;
+    async::timer_mgr::service_task();
+    CHECK(value == 17);
+    CHECK(not op);
+    CHECK(async::timer_mgr::is_idle());
+}
@@ -0,0 +1,180 @@
+#include "detail/common.hpp"
+
+#include <async/env.hpp>
+#include <async/just.hpp>
+#include <async/schedulers/inline_scheduler.hpp>
+#include <async/then.hpp>
+#include <async/trace.hpp>
+#include <async/when_all.hpp>
+
+#include <stdx/concepts.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <concepts>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace {
+using buffer_t = async::trace_buffer<8>;
+
+template <typename F> struct traced_receiver : F {
+    using is_receiver = void;
+    buffer_t *buffer;
+
+  private:
+    template <stdx::same_as_unqualified<traced_receiver> R, typename... Args>
+    friend constexpr auto tag_invoke(async::set_value_t, R &&r, Args &&...args)
+        -> void {
+        std::forward<R>(r)(std::forward<Args>(args)...);
+    }
+    friend constexpr auto tag_invoke(async::channel_tag auto,
+                                     traced_receiver const &, auto &&...)
+        -> void {}
+
+    [[nodiscard]] friend constexpr auto tag_invoke(async::get_env_t,
+                                                   traced_receiver const &r) {
+        return async::singleton_env<async::get_tracer_t>(
+            r.buffer->get_tracer());
+    }
+};
+template <typename F> traced_receiver(F, buffer_t *) -> traced_receiver<F>;
+
+struct event {
+    async::trace_kind_id kind;
+    async::trace_event e;
+
+    friend auto operator==(event const &, event const &) -> bool = default;
+};
+
+template <typename B> auto events(B const &b) -> std::vector<event> {
+    std::vector<event> v{};
+    b.for_each([&](async::trace_record const &r) {
+        v.push_back({r.kind, r.event});
+    });
+    return v;
+}
+} // namespace
+
+TEST_CASE("the default tracer is the null tracer", "[trace]") {
+    static_assert(std::same_as<async::tracer_of_t<async::empty_env>,
+                               async::null_tracer>);
+}
+
+TEST_CASE("then traces its completion", "[trace]") {
+    buffer_t buffer{};
+    int value{};
+    auto s = async::just(42) | async::then([](int i) { return i + 1; });
+    auto op = async::connect(
+        s, traced_receiver{[&](int i) { value = i; }, &buffer});
+    async::start(op);
+    CHECK(value == 43);
+    CHECK(events(buffer) == std::vector<event>{{async::trace_kind_id::then,
+                                                async::trace_event::value}});
+}
+
+TEST_CASE("when_all traces its start and completion", "[trace]") {
+    buffer_t buffer{};
+    int value{};
+    auto s = async::when_all(async::just(1), async::just(2));
+    auto op = async::connect(
+        s, traced_receiver{[&](int i, int j) { value = i + j; }, &buffer});
+    async::start(op);
+    CHECK(value == 3);
+    CHECK(events(buffer) ==
+          std::vector<event>{
+              {async::trace_kind_id::when_all, async::trace_event::start},
+              {async::trace_kind_id::when_all, async::trace_event::value}});
+}
+
+TEST_CASE("schedulers trace their start and completion", "[trace]") {
+    buffer_t buffer{};
+    int value{};
+    auto s = async::inline_scheduler{}.schedule();
+    auto op = async::connect(s, traced_receiver{[&] { value = 42; }, &buffer});
+    async::start(op);
+    CHECK(value == 42);
+    CHECK(events(buffer) ==
+          std::vector<event>{
+              {async::trace_kind_id::inline_scheduler,
+               async::trace_event::start},
+              {async::trace_kind_id::inline_scheduler,
+               async::trace_event::value}});
+}
+
+TEST_CASE("trace records identify the operation", "[trace]") {
+    buffer_t buffer{};
+    auto s = async::inline_scheduler{}.schedule();
+    auto op = async::connect(s, traced_receiver{[] {}, &buffer});
+    async::start(op);
+
+    std::vector<std::uintptr_t> ops{};
+    buffer.for_each(
+        [&](async::trace_record const &r) { ops.push_back(r.op); });
+    REQUIRE(ops.size() == 2);
+    CHECK(ops[0] == ops[1]);
+}
+
+TEST_CASE("trace buffer keeps the most recent events", "[trace]") {
+    buffer_t buffer{};
+    for (auto i = 0; i < 10; ++i) {
+        buffer.record(async::trace_kind_id::then, async::trace_event::value,
+                      nullptr);
+    }
+    CHECK(buffer.size() == 8);
+
+    std::vector<std::uint32_t> seqs{};
+    buffer.for_each(
+        [&](async::trace_record const &r) { seqs.push_back(r.seq); });
+    CHECK(seqs == std::vector<std::uint32_t>{2, 3, 4, 5, 6, 7, 8, 9});
+}
+
+namespace {
+struct test_clock {
+    static inline std::uint32_t time{};
+    static auto now() -> std::uint32_t { return time; }
+};
+} // namespace
+
+TEST_CASE("trace buffer timestamps records with its clock", "[trace]") {
+    async::trace_buffer<4, test_clock> buffer{};
+    test_clock::time = 100;
+    buffer.record(async::trace_kind_id::then, async::trace_event::start,
+                  nullptr);
+    test_clock::time = 250;
+    buffer.record(async::trace_kind_id::then, async::trace_event::value,
+                  nullptr);
+
+    std::vector<std::uint32_t> timestamps{};
+    buffer.for_each([&](async::trace_record const &r) {
+        timestamps.push_back(r.timestamp);
+    });
+    CHECK(timestamps == std::vector<std::uint32_t>{100, 250});
+}
+
+TEST_CASE("trace buffer records the priority of a kind", "[trace]") {
+    buffer_t buffer{};
+    int x{};
+    auto t = buffer.get_tracer();
+    t(async::trace_kind::priority_scheduler<3>{}, async::start_t{}, &x);
+    t(async::trace_kind::then{}, async::set_value_t{}, &x);
+
+    std::vector<std::uint8_t> priorities{};
+    buffer.for_each([&](async::trace_record const &r) {
+        priorities.push_back(r.priority);
+    });
+    CHECK(priorities ==
+          std::vector<std::uint8_t>{3, async::no_trace_priority});
+}
+
+TEST_CASE("unused trace buffer slots are recognizable", "[trace]") {
+    buffer_t buffer{};
+    buffer.record(async::trace_kind_id::then, async::trace_event::value,
+                  nullptr);
+    auto const &raw = buffer.raw();
+    CHECK(raw[0].event == async::trace_event::value);
+    for (auto i = 1u; i < raw.size(); ++i) {
+        CHECK(static_cast<int>(raw[i].event) == 0);
+    }
+}
@@ -168,6 +168,20 @@ TEST_CASE("queryable completion signatures dependent on environment",
                      async::completion_signatures<async::set_value_t(int)>>);
 }
 
+TEST_CASE("completion signatures do not depend on qualification",
+          "[type_traits]") {
+    using sigs =
+        async::completion_signatures_of_t<queryable_sender3, dependent_env<int>>;
+    static_assert(std::same_as<
+                  async::completion_signatures_of_t<queryable_sender3 &&,
+                                                    dependent_env<int> const &>,
+                  sigs>);
+    static_assert(std::same_as<
+                  async::completion_signatures_of_t<queryable_sender3 const &,
+                                                    dependent_env<int> &>,
+                  sigs>);
+}
+
 TEST_CASE("types by channel (exposed types)", "[type_traits]") {
     static_assert(
         std::same_as<variant<tuple<int>>,
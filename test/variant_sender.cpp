@@ -7,6 +7,7 @@
 #include <catch2/catch_test_macros.hpp>
 
 #include <type_traits>
+#include <utility>
 
 TEST_CASE("match with predicate", "[variant_sender]") {
     auto const m =
@@ -155,3 +156,30 @@ TEST_CASE("make_variant_sender (simplified binary choice)"
     async::start(op);
     CHECK(value == 42);
 }
+
+TEST_CASE("select_sender chooses by runtime index", "[variant_sender]") {
+    auto const s = async::select_sender(1, async::just(17), async::just(42),
+                                        async::just_error(3));
+
+    static_assert(
+        std::is_same_v<async::completion_signatures_of_t<decltype(s)>,
+                       async::completion_signatures<async::set_value_t(int),
+                                                    async::set_error_t(int),
+                                                    async::set_stopped_t()>>);
+
+    int value{};
+    auto op = async::connect(s, receiver{[&](auto v) { value = v; }});
+    async::start(op);
+    CHECK(value == 42);
+}
+
+TEST_CASE("select_sender with out-of-range index completes with stopped",
+          "[variant_sender]") {
+    auto s = async::select_sender(2, async::just(17), async::just(42));
+
+    bool stopped{};
+    auto op = async::connect(std::move(s),
+                             stopped_receiver{[&] { stopped = true; }});
+    async::start(op);
+    CHECK(stopped);
+}
@@ -0,0 +1,102 @@
+#include "detail/common.hpp"
+
+#include <async/concepts.hpp>
+#include <async/then.hpp>
+#include <async/type_traits.hpp>
+#include <async/wait_for_interrupt.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <concepts>
+
+namespace {
+struct uart_irq;
+struct timer_irq;
+} // namespace
+
+TEST_CASE("wait_for_interrupt is a sender", "[wait_for_interrupt]") {
+    static_assert(async::sender<async::interrupt_sender<uart_irq>>);
+}
+
+TEST_CASE("wait_for_interrupt advertises set_stopped only when stoppable",
+          "[wait_for_interrupt]") {
+    auto s = async::wait_for_interrupt<uart_irq>();
+    static_assert(
+        std::same_as<async::completion_signatures_of_t<decltype(s)>,
+                     async::completion_signatures<async::set_value_t()>>);
+
+    [[maybe_unused]] auto r = stoppable_receiver([] {});
+    static_assert(
+        std::same_as<async::completion_signatures_of_t<
+                         decltype(s), async::env_of_t<decltype(r)>>,
+                     async::completion_signatures<async::set_value_t(),
+                                                  async::set_stopped_t()>>);
+}
+
+TEST_CASE("completes when the interrupt is signalled",
+          "[wait_for_interrupt]") {
+    int value{};
+    auto s = async::wait_for_interrupt<uart_irq>() |
+             async::then([] { return 42; });
+    auto op = async::connect(s, receiver{[&](int i) { value = i; }});
+    async::start(op);
+    CHECK(value == 0);
+    CHECK(async::signal_interrupt<uart_irq>() == 1);
+    CHECK(value == 42);
+    CHECK(async::signal_interrupt<uart_irq>() == 0);
+}
+
+TEST_CASE("every waiting operation completes", "[wait_for_interrupt]") {
+    int count{};
+    auto s = async::wait_for_interrupt<uart_irq>();
+    auto op1 = async::connect(s, receiver{[&] { ++count; }});
+    auto op2 = async::connect(s, receiver{[&] { ++count; }});
+    async::start(op1);
+    async::start(op2);
+    CHECK(async::signal_interrupt<uart_irq>() == 2);
+    CHECK(count == 2);
+}
+
+TEST_CASE("interrupts are independent", "[wait_for_interrupt]") {
+    int value{};
+    auto op = async::connect(async::wait_for_interrupt<uart_irq>(),
+                             receiver{[&] { value = 42; }});
+    async::start(op);
+    CHECK(async::signal_interrupt<timer_irq>() == 0);
+    CHECK(value == 0);
+    CHECK(async::signal_interrupt<uart_irq>() == 1);
+    CHECK(value == 42);
+}
+
+TEST_CASE("stopping unlinks the operation", "[wait_for_interrupt]") {
+    int value{};
+    auto r = stoppable_receiver{[&] { value = 17; }};
+    auto op = async::connect(async::wait_for_interrupt<uart_irq>(), r);
+    async::start(op);
+    r.request_stop();
+    CHECK(value == 17);
+    CHECK(async::signal_interrupt<uart_irq>() == 0);
+}
+
+TEST_CASE("an operation that is already stopped does not wait",
+          "[wait_for_interrupt]") {
+    int value{};
+    auto r = stoppable_receiver{[&] { value = 17; }};
+    r.request_stop();
+    auto op = async::connect(async::wait_for_interrupt<uart_irq>(), r);
+    async::start(op);
+    CHECK(value == 17);
+    CHECK(async::signal_interrupt<uart_irq>() == 0);
+}
+
+TEST_CASE("an operation completed by the interrupt no longer listens for stop",
+          "[wait_for_interrupt]") {
+    int count{};
+    auto r = stoppable_receiver{[&] { ++count; }};
+    auto op = async::connect(async::wait_for_interrupt<uart_irq>(), r);
+    async::start(op);
+    CHECK(async::signal_interrupt<uart_irq>() == 1);
+    CHECK(count == 1);
+    r.request_stop();
+    CHECK(count == 1);
+}
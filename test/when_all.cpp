@@ -18,10 +18,13 @@
 #include <array>
 #include <chrono>
 #include <condition_variable>
+#include <cstdint>
 #include <functional>
 #include <iterator>
 #include <mutex>
 #include <random>
+#include <span>
+#include <string>
 #include <thread>
 #include <utility>
 
@@ -99,6 +102,20 @@ TEST_CASE("move-only value", "[when_all]") {
     CHECK(value == 42);
 }
 
+TEST_CASE("values with and without trivial destructors", "[when_all]") {
+    int value{};
+    auto s1 = async::just(42);
+    auto s2 = async::just(std::string{"hello"});
+    auto w = async::when_all(s1, s2);
+
+    auto op = async::connect(w, receiver{[&](int i, std::string str) {
+                                 CHECK(str == "hello");
+                                 value = i;
+                             }});
+    async::start(op);
+    CHECK(value == 42);
+}
+
 TEST_CASE("copy sender", "[when_all]") {
     int value{};
     auto const s = async::just(42);
@@ -142,6 +159,18 @@ TEST_CASE("when_all propagates error (order 2)", "[when_all]") {
     CHECK(value == 17);
 }
 
+TEST_CASE("when_all propagates an error code", "[when_all]") {
+    enum struct bus_error : std::uint8_t { nack = 1 };
+    auto value = bus_error{};
+    auto w = async::when_all(async::just(42),
+                             async::just_error(bus_error::nack));
+
+    auto op = async::connect(
+        w, error_receiver{[&](bus_error e) { value = e; }});
+    async::start(op);
+    CHECK(value == bus_error::nack);
+}
+
 TEST_CASE("when_all does not send values after error", "[when_all]") {
     int value{};
     auto s1 = async::just_error(17);
@@ -239,3 +268,60 @@ TEST_CASE("when_all nests", "[when_all]") {
     [[maybe_unused]] auto w = async::when_all(async::when_all());
     [[maybe_unused]] auto op = async::connect(w, receiver{[] {}});
 }
+
+TEST_CASE("when_all_range delivers results into an array", "[when_all]") {
+    std::array sndrs{async::just(1), async::just(2), async::just(3)};
+    std::array<int, 3> results{};
+    auto w = async::when_all_range<4>(std::span{sndrs}, std::span{results});
+    static_assert(
+        async::sender_of<decltype(w), async::set_value_t(std::span<int>)>);
+
+    std::size_t count{};
+    auto op = async::connect(
+        w, receiver{[&](std::span<int> rs) { count = std::size(rs); }});
+    async::start(op);
+    CHECK(count == 3);
+    CHECK(results == std::array{1, 2, 3});
+}
+
+TEST_CASE("when_all_range with void senders", "[when_all]") {
+    int value{};
+    std::array sndrs{async::just(), async::just()};
+    auto w = async::when_all_range<2>(std::span{sndrs});
+
+    auto op = async::connect(w, receiver{[&] { value = 42; }});
+    async::start(op);
+    CHECK(value == 42);
+}
+
+TEST_CASE("when_all_range over an empty range", "[when_all]") {
+    int value{};
+    std::array<decltype(async::just()), 0> sndrs{};
+    auto w = async::when_all_range<2>(std::span{sndrs});
+
+    auto op = async::connect(w, receiver{[&] { value = 42; }});
+    async::start(op);
+    CHECK(value == 42);
+}
+
+TEST_CASE("when_all_range propagates error", "[when_all]") {
+    int value{};
+    std::array sndrs{async::just_error(17), async::just_error(42)};
+    auto w = async::when_all_range<2>(std::span{sndrs});
+
+    auto op = async::connect(w, error_receiver{[&](auto i) { value = i; }});
+    async::start(op);
+    CHECK(value == 17);
+}
+
+TEST_CASE("when_all_range runs senders concurrently", "[when_all]") {
+    auto const make = [](int i) {
+        return async::thread_scheduler::schedule() |
+               async::then([=] { return i * i; });
+    };
+    std::array sndrs{make(1), make(2), make(3), make(4)};
+    std::array<int, 4> results{};
+    auto w = async::when_all_range<4>(std::span{sndrs}, std::span{results});
+    CHECK(async::sync_wait(w).has_value());
+    CHECK(results == std::array{1, 4, 9, 16});
+}
@@ -19,6 +19,7 @@
 #include <iterator>
 #include <mutex>
 #include <random>
+#include <span>
 #include <thread>
 #include <utility>
 
@@ -171,6 +172,20 @@ TEST_CASE("first_successful policy", "[when_any]") {
     CHECK(value == 17);
 }
 
+TEST_CASE("first_successful policy prefers error to stopped", "[when_any]") {
+    int value{};
+    auto s1 = async::just_stopped();
+    auto s2 = async::just_error(17);
+    auto w = async::first_successful(s1, s2);
+
+    auto op = async::connect(w, error_receiver{[&](auto i) {
+                                 CHECK(value == 0);
+                                 value = i;
+                             }});
+    async::start(op);
+    CHECK(value == 17);
+}
+
 TEST_CASE("first_complete policy", "[when_any]") {
     int value{};
     auto s1 = async::just_stopped();
@@ -297,3 +312,69 @@ TEST_CASE("when_any nests", "[when_any]") {
     [[maybe_unused]] auto w = async::when_any(async::when_any());
     [[maybe_unused]] auto op = async::connect(w, receiver{[] {}});
 }
+
+TEST_CASE("when_any with an unstoppable receiver keeps no stop callback",
+          "[when_any]") {
+    auto s = async::when_any(async::just(42), async::just(17));
+    auto unstoppable_op = async::connect(s, receiver{[](auto) {}});
+    auto stoppable_op = async::connect(s, stoppable_receiver{[] {}});
+    static_assert(sizeof(unstoppable_op) < sizeof(stoppable_op));
+}
+
+TEST_CASE("when_any_range completes with the first success", "[when_any]") {
+    int value{};
+    std::array sndrs{async::just(42), async::just(17)};
+    auto w = async::when_any_range<4>(std::span{sndrs});
+    static_assert(async::sender_of<decltype(w), async::set_value_t(int)>);
+
+    auto op = async::connect(w, receiver{[&](auto i) { value = i; }});
+    async::start(op);
+    CHECK(value == 42);
+}
+
+TEST_CASE("when_any_range completes with the first error", "[when_any]") {
+    int value{};
+    std::array sndrs{async::just_error(42), async::just_error(17)};
+    auto w = async::when_any_range<2>(std::span{sndrs});
+
+    auto op = async::connect(w, error_receiver{[&](auto i) { value = i; }});
+    async::start(op);
+    CHECK(value == 42);
+}
+
+TEST_CASE("when_any_range over an empty range is stopped", "[when_any]") {
+    int value{};
+    std::array<decltype(async::just(42)), 0> sndrs{};
+    auto w = async::when_any_range<2>(std::span{sndrs});
+
+    auto op = async::connect(w, stopped_receiver{[&] { value = 42; }});
+    async::start(op);
+    CHECK(value == 42);
+}
+
+TEST_CASE("when_any_range cancellation (during operation)", "[when_any]") {
+    int value{};
+    std::array sndrs{async::when_any(), async::when_any(), async::when_any()};
+    auto w = async::when_any_range<4>(std::span{sndrs});
+    auto r = stoppable_receiver{[&] { value = 42; }};
+
+    auto op = async::connect(w, r);
+    async::start(op);
+    CHECK(value == 0);
+    r.request_stop();
+    CHECK(value == 42);
+}
+
+TEST_CASE("when_any_range with thread scheduler", "[when_any]") {
+    auto const make = [](int i) {
+        return async::thread_scheduler::schedule() |
+               async::then([=] { return i; });
+    };
+    std::array sndrs{make(1), make(2), make(3), make(4)};
+    auto w = async::when_any_range<4>(std::span{sndrs});
+    auto const result = async::sync_wait(w);
+    REQUIRE(result.has_value());
+    auto const [i] = *result;
+    CHECK(i >= 1);
+    CHECK(i <= 4);
+}
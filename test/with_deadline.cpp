@@ -0,0 +1,142 @@
+#include "detail/common.hpp"
+
+#include <async/just.hpp>
+#include <async/read_env.hpp>
+#include <async/schedulers/time_scheduler.hpp>
+#include <async/schedulers/timer_manager.hpp>
+#include <async/then.hpp>
+#include <async/with_deadline.hpp>
+
+#include <stdx/functional.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <concepts>
+#include <functional>
+#include <optional>
+
+using namespace std::chrono_literals;
+
+namespace {
+using time_point_t = std::chrono::steady_clock::time_point;
+auto current_time = time_point_t{};
+
+struct hal {
+    using time_point_t = std::chrono::steady_clock::time_point;
+    using task_t = async::timer_task<time_point_t>;
+
+    static auto enable() -> void {}
+    static auto disable() -> void {}
+    static auto set_event_time(time_point_t) -> void {}
+    static auto now() -> time_point_t { return current_time; }
+};
+
+using timer_manager_t = async::generic_timer_manager<hal>;
+} // namespace
+
+template <typename Rep, typename Period>
+struct async::timer_mgr::time_point_for<std::chrono::duration<Rep, Period>> {
+    using type = std::chrono::steady_clock::time_point;
+};
+
+template <>
+[[maybe_unused]] inline auto async::injected_timer_manager<> =
+    timer_manager_t{};
+
+TEST_CASE("with_deadline advertises set_stopped", "[with_deadline]") {
+    auto s = async::just(42) | async::with_deadline(current_time + 10ms);
+    static_assert(async::sender_of<decltype(s), async::set_value_t(int)>);
+    static_assert(async::sender_of<decltype(s), async::set_stopped_t()>);
+}
+
+TEST_CASE("the deadline is available from the environment",
+          "[with_deadline]") {
+    auto const deadline = current_time + 10ms;
+    time_point_t value{};
+    auto s = async::read_env(async::get_deadline_t{}) |
+             async::then([&](time_point_t tp) { value = tp; }) |
+             async::with_deadline(deadline);
+    auto op = async::connect(s, receiver{[] {}});
+    async::start(op);
+    CHECK(value == deadline);
+    CHECK(async::timer_mgr::is_idle());
+}
+
+TEST_CASE("outside with_deadline there is no deadline", "[with_deadline]") {
+    static_assert(std::same_as<async::deadline_of_t<async::empty_env>,
+                               async::no_deadline>);
+}
+
+TEST_CASE("an earlier enclosing deadline still applies", "[with_deadline]") {
+    auto const deadline = current_time + 10ms;
+    time_point_t value{};
+    auto s = async::read_env(async::get_deadline_t{}) |
+             async::then([&](time_point_t tp) { value = tp; }) |
+             async::with_deadline(deadline + 10ms) |
+             async::with_deadline(deadline);
+    auto op = async::connect(s, receiver{[] {}});
+    async::start(op);
+    CHECK(value == deadline);
+}
+
+TEST_CASE("work that completes in time cancels the deadline timer",
+          "[with_deadline]") {
+    int value{};
+    auto s = async::just(42) | async::with_deadline(current_time + 10ms);
+    auto op = async::connect(s, receiver{[&](int i) { value = i; }});
+    async::start(op);
+    CHECK(value == 42);
+    CHECK(async::timer_mgr::is_idle());
+}
+
+TEST_CASE("work that is still running at the deadline is stopped",
+          "[with_deadline]") {
+    int value{};
+    auto s = async::time_scheduler{100ms}.schedule() |
+             async::then([&] { value = 42; }) |
+             async::with_deadline(current_time + 10ms);
+    auto op = async::connect(s, stopped_receiver{[&] { value = 17; }});
+    async::start(op);
+    CHECK(value == 0);
+
+    current_time += 10ms;
+    async::timer_mgr::service_task();
+    CHECK(value == 17);
+    CHECK(async::timer_mgr::is_idle());
+}
+
+TEST_CASE("a stop request from downstream is forwarded", "[with_deadline]") {
+    int value{};
+    auto r = stoppable_receiver{[&] { value = 17; }};
+    auto s = async::time_scheduler{100ms}.schedule() |
+             async::with_deadline(current_time + 10ms);
+    auto op = async::connect(s, r);
+    async::start(op);
+    r.request_stop();
+    CHECK(value == 17);
+    CHECK(async::timer_mgr::is_idle());
+}
+
+TEST_CASE("the receiver may destroy the op state when the deadline passes",
+          "[with_deadline]") {
+    int value{};
+    auto s = async::time_scheduler{100ms}.schedule() |
+             async::with_deadline(current_time + 10ms);
+    using rcvr_t = stopped_receiver<std::function<void()>>;
+    using op_t = async::connect_result_t<decltype(s), rcvr_t>;
+    std::optional<op_t> op{};
+    op.emplace(stdx::with_result_of{[&] {
+        return async::connect(s, rcvr_t{[&] {
+                                  value = 17;
+                                  op.reset();
+                              }});
+    }});
+    async::start(*op);
+
+    current_time += 10ms;
+    async::timer_mgr::service_task();
+    CHECK(value == 17);
+    CHECK(not op);
+    CHECK(async::timer_mgr::is_idle());
+}
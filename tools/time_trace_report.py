@@ -0,0 +1,93 @@
+#!/usr/bin/env python3
+"""Summarize the template instantiation cost recorded by clang -ftime-trace.
+
+For each object file, clang writes a Chrome trace (JSON) next to it. This
+script reads those traces and reports, for each one, the total time spent in
+instantiation and the templates that took the longest. Time is attributed to a
+template's name without its arguments, so that (for instance) every
+instantiation of mp_unique is counted together.
+"""
+
+import argparse
+import collections
+import json
+import os
+import re
+import sys
+
+INSTANTIATION_EVENTS = ("InstantiateClass", "InstantiateFunction")
+
+
+def trace_file(obj):
+    base, _ = os.path.splitext(obj)
+    return base + ".json"
+
+
+def template_name(detail):
+    depth = 0
+    name = []
+    for c in detail:
+        if c == "<":
+            depth += 1
+        elif c == ">":
+            depth -= 1
+        elif depth == 0:
+            name.append(c)
+    return re.sub(r"\s+", " ", "".join(name)).strip()
+
+
+def summarize(path, top):
+    with open(path) as f:
+        events = json.load(f)["traceEvents"]
+
+    total = collections.Counter()
+    by_name = collections.Counter()
+    count = collections.Counter()
+    for e in events:
+        if e.get("ph") != "X":
+            continue
+        name = e.get("name")
+        if name in ("Frontend", "Backend"):
+            total[name] += e["dur"]
+        if name in INSTANTIATION_EVENTS:
+            t = template_name(e["args"]["detail"])
+            by_name[t] += e["dur"]
+            count[t] += 1
+
+    print(f"{path}:")
+    for phase in ("Frontend", "Backend"):
+        print(f"  {phase:<12} {total[phase] / 1000:10.1f} ms")
+    # nested instantiations are included in their parents' times
+    for t, dur in by_name.most_common(top):
+        print(f"  {dur / 1000:10.1f} ms {count[t]:6} x {t}")
+    print()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument(
+        "--objects",
+        required=True,
+        help="file listing the object files compiled with -ftime-trace",
+    )
+    parser.add_argument(
+        "--top",
+        type=int,
+        default=20,
+        help="number of templates to report for each object",
+    )
+    args = parser.parse_args()
+
+    with open(args.objects) as f:
+        objects = [line.strip() for line in f if line.strip()]
+    for obj in objects:
+        path = trace_file(obj)
+        if not os.path.exists(path):
+            print(f"no time trace for {obj}", file=sys.stderr)
+            return 1
+        summarize(path, args.top)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,146 @@
+#!/usr/bin/env python3
+"""Decode a dumped async::trace_buffer into a Chrome trace (JSON) timeline.
+
+The input is the raw memory of the buffer's records (trace_buffer::raw()), for
+instance as dumped by a debugger. The output can be opened in
+https://ui.perfetto.dev or chrome://tracing.
+
+Each operation appears as an async slice from its start to its completion.
+Operations on a priority scheduler are laid out by priority; every other kind
+of operation has a track of its own, so that timer firings (time_scheduler
+completions) appear together.
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+# These must match async::trace_kind_id and async::trace_event.
+KINDS = [
+    "then",
+    "let",
+    "when_all",
+    "start_detached",
+    "inline_scheduler",
+    "thread_scheduler",
+    "runloop_scheduler",
+    "priority_scheduler",
+    "time_scheduler",
+]
+EVENTS = {1: "start", 2: "value", 3: "error", 4: "stopped"}
+NO_PRIORITY = 0xFF
+
+
+def record_format(pointer_size, endian):
+    ptr = {4: "I", 8: "Q"}[pointer_size]
+    # seq, timestamp, op, kind, event, priority, padded to pointer alignment
+    fmt = f"{endian}II{ptr}BBB"
+    size = struct.calcsize(fmt)
+    padding = -size % pointer_size
+    return fmt + "x" * padding
+
+
+def decode(data, pointer_size, endian):
+    fmt = record_format(pointer_size, endian)
+    size = struct.calcsize(fmt)
+    records = []
+    for offset in range(0, len(data) - size + 1, size):
+        seq, ts, op, kind, event, priority = struct.unpack_from(fmt, data, offset)
+        if event in EVENTS:
+            records.append(
+                {
+                    "seq": seq,
+                    "timestamp": ts,
+                    "op": op,
+                    "kind_id": kind,
+                    "kind": KINDS[kind] if kind < len(KINDS) else f"kind {kind}",
+                    "event": EVENTS[event],
+                    "priority": priority,
+                }
+            )
+    return sorted(records, key=lambda r: r["seq"])
+
+
+def track_of(record):
+    if record["priority"] != NO_PRIORITY:
+        return record["priority"], f"priority {record['priority']}"
+    return NO_PRIORITY + 1 + record["kind_id"], record["kind"]
+
+
+def to_chrome(records, ticks_per_us):
+    events = []
+    tracks = {}
+    open_ops = set()
+    for r in records:
+        tid, track_name = track_of(r)
+        tracks[tid] = track_name
+        common = {
+            "name": r["kind"],
+            "cat": r["kind"],
+            "id": hex(r["op"]),
+            "ts": r["timestamp"] / ticks_per_us,
+            "pid": 0,
+            "tid": tid,
+        }
+        key = (r["kind"], r["op"])
+        if r["event"] == "start":
+            open_ops.add(key)
+            events.append({**common, "ph": "b"})
+        elif key in open_ops:
+            open_ops.discard(key)
+            events.append({**common, "ph": "e", "args": {"channel": r["event"]}})
+        else:
+            events.append(
+                {**common, "ph": "i", "s": "t", "args": {"channel": r["event"]}}
+            )
+
+    for tid, name in tracks.items():
+        events.append(
+            {
+                "name": "thread_name",
+                "ph": "M",
+                "pid": 0,
+                "tid": tid,
+                "args": {"name": name},
+            }
+        )
+    return {"traceEvents": events, "displayTimeUnit": "ns"}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("dump", help="raw dump of the trace_buffer records")
+    parser.add_argument("-o", "--output", help="output file (default: stdout)")
+    parser.add_argument(
+        "--pointer-size",
+        type=int,
+        choices=[4, 8],
+        default=4,
+        help="size of a pointer on the target (default: 4)",
+    )
+    parser.add_argument(
+        "--big-endian", action="store_true", help="the target is big-endian"
+    )
+    parser.add_argument(
+        "--ticks-per-us",
+        type=float,
+        default=1.0,
+        help="timestamp ticks per microsecond (default: 1)",
+    )
+    args = parser.parse_args()
+
+    with open(args.dump, "rb") as f:
+        data = f.read()
+    records = decode(data, args.pointer_size, ">" if args.big_endian else "<")
+    trace = to_chrome(records, args.ticks_per_us)
+
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump(trace, f, indent=1)
+    else:
+        json.dump(trace, sys.stdout, indent=1)
+
+
+if __name__ == "__main__":
+    main()